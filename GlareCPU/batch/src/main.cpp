@@ -0,0 +1,908 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : main.cpp
+// Desc : Glare Batch Tool.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareImageFile.h>
+#include <glareMapFile.h>
+#include <glareThreadPool.h>
+#include <glareGaussBlur.h>
+#include <glareLensGhost.h>
+#include <glareStar.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif//WIN32_LEAN_AND_MEAN
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif//NOMINMAX
+    #include <Windows.h>
+#else
+    #include <dirent.h>
+#endif
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const char* DEFAULT_CONFIG_PATH     = "glare_batch.cfg";
+const int   MAX_CASCADE_LEVEL_COUNT = 8;        //!< cascade エフェクトの最大段数です.
+const int   BLUR_DOWNSAMPLE_FACTOR  = 4;        //!< blur / cascade エフェクトの縮小率です(サンプルと同じ).
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// EFFECT_TYPE enum
+/////////////////////////////////////////////////////////////////////////////////////////////
+enum EFFECT_TYPE
+{
+    EFFECT_TYPE_BLUR = 0,       //!< SingleGaussBlur サンプル相当の1段ブラーを加算します.
+    EFFECT_TYPE_CASCADE,        //!< MultipleGaussBlur サンプル相当の多段ブラーを加算します.
+    EFFECT_TYPE_STAR,           //!< Star サンプル相当の光芒を加算します.
+    EFFECT_TYPE_GHOST,          //!< LensGhost サンプル相当のゴーストを合成します.
+    NUM_EFFECT_TYPE
+};
+
+// エフェクト名.
+const char* EFFECT_NAMES[NUM_EFFECT_TYPE] = {
+    "blur",
+    "cascade",
+    "star",
+    "ghost",
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Config structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct Config
+{
+    std::vector<EFFECT_TYPE>    Effects;            //!< 適用順に並べたエフェクトです.
+    std::string                 Input;              //!< 入力ディレクトリ，または printf 形式の連番パターンです.
+    std::string                 Output;             //!< 出力ディレクトリ，または printf 形式の連番パターンです.
+    std::string                 OutputFormat;       //!< 出力がディレクトリの場合の拡張子(map, ppm, pfm)です.
+    int                         First;              //!< 連番の開始番号です.
+    int                         Last;               //!< 連番の終了番号です. 負の場合はファイルが無くなるまで処理します.
+    int                         DecodeThreads;      //!< デコードのスレッド数です.
+    int                         ProcessThreads;     //!< エフェクト処理のスレッドプールのスレッド数です.
+    int                         EncodeThreads;      //!< エンコードのスレッド数です.
+    int                         QueueDepth;         //!< ステージ間のキューに溜められるフレーム数です.
+    float                       BlurDeviation;      //!< blur の標準偏差です.
+    float                       CascadeDeviation;   //!< cascade の各段の標準偏差です.
+    int                         CascadeLevels;      //!< cascade の段数です.
+    glare::StarParam            Star;               //!< star のパラメータです.
+    std::string                 GhostMask;          //!< ghost のマスク画像です.
+    float                       GhostDeviation;     //!< ghost のブラーの標準偏差です.
+    glare::LENS_GHOST_MODE      GhostMode;          //!< ghost の描画方法です.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// FrameItem structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct FrameItem
+{
+    std::string     InputPath;      //!< 入力ファイルです.
+    std::string     OutputPath;     //!< 出力ファイルです.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Frame structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct Frame
+{
+    const FrameItem*                Item;       //!< 処理対象です.
+    std::unique_ptr<glare::Image>   Image;      //!< デコードした画像です.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// BoundedQueue class
+/////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class BoundedQueue
+{
+public:
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //!
+    //! @param [in]     capacity    溜められる要素数です. 満杯の場合 Push() は空くまで待機します.
+    //---------------------------------------------------------------------------------------
+    explicit BoundedQueue( size_t capacity )
+    : m_Capacity( ( capacity > 0 ) ? capacity : 1 )
+    , m_Closed  ( false )
+    { /* DO_NOTHING */ }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      要素を追加します.
+    //!
+    //! @retval true    追加に成功.
+    //! @retval false   閉じられている場合は失敗.
+    //---------------------------------------------------------------------------------------
+    bool Push( T&& value )
+    {
+        std::unique_lock<std::mutex> lock( m_Mutex );
+        m_NotFull.wait( lock, [this]() { return m_Closed || m_Items.size() < m_Capacity; } );
+        if (m_Closed)
+        { return false; }
+
+        m_Items.push_back( std::move( value ) );
+        m_NotEmpty.notify_one();
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      要素を取り出します.
+    //!
+    //! @retval true    取り出しに成功.
+    //! @retval false   閉じられていて，かつ空の場合は失敗.
+    //---------------------------------------------------------------------------------------
+    bool Pop( T& value )
+    {
+        std::unique_lock<std::mutex> lock( m_Mutex );
+        m_NotEmpty.wait( lock, [this]() { return m_Closed || !m_Items.empty(); } );
+        if (m_Items.empty())
+        { return false; }
+
+        value = std::move( m_Items.front() );
+        m_Items.pop_front();
+        m_NotFull.notify_one();
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      キューを閉じます. 残っている要素は Pop() で取り出せます.
+    //---------------------------------------------------------------------------------------
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        m_Closed = true;
+        m_NotEmpty.notify_all();
+        m_NotFull.notify_all();
+    }
+
+private:
+    size_t                      m_Capacity;     //!< 溜められる要素数です.
+    bool                        m_Closed;       //!< 閉じられたかどうか.
+    std::deque<T>               m_Items;        //!< 要素です.
+    std::mutex                  m_Mutex;        //!< 排他制御用ミューテックスです.
+    std::condition_variable     m_NotEmpty;     //!< 要素の追加を通知します.
+    std::condition_variable     m_NotFull;      //!< 空きができたことを通知します.
+
+    BoundedQueue    ( const BoundedQueue& );    // アクセス禁止.
+    void operator = ( const BoundedQueue& );    // アクセス禁止.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// EffectChain class
+/////////////////////////////////////////////////////////////////////////////////////////////
+class EffectChain
+{
+public:
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------
+    EffectChain( const Config& config, const glare::Image& mask, glare::ThreadPool* pPool )
+    : m_Config  ( config )
+    , m_Mask    ( mask )
+    , m_pPool   ( pPool )
+    , m_Width   ( 0 )
+    , m_Height  ( 0 )
+    { /* DO_NOTHING */ }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      エフェクトを順に適用します. 結果は image に上書きします.
+    //!
+    //! @retval true    処理に成功.
+    //! @retval false   処理に失敗.
+    //! @note       フレームのサイズが変わった場合は作業バッファを作り直します.
+    //---------------------------------------------------------------------------------------
+    bool Execute( glare::Image& image )
+    {
+        if (!Resize( image.GetWidth(), image.GetHeight() ))
+        { return false; }
+
+        for(size_t i=0; i<m_Config.Effects.size(); ++i)
+        {
+            auto success = false;
+            switch(m_Config.Effects[i])
+            {
+            case EFFECT_TYPE_BLUR:      success = ExecuteBlur( image );     break;
+            case EFFECT_TYPE_CASCADE:   success = ExecuteCascade( image );  break;
+            case EFFECT_TYPE_STAR:      success = ExecuteStar( image );     break;
+            case EFFECT_TYPE_GHOST:     success = ExecuteGhost( image );    break;
+            default:                                                        break;
+            }
+
+            if (!success)
+            { return false; }
+        }
+
+        return true;
+    }
+
+private:
+    const Config&       m_Config;                               //!< 設定です.
+    const glare::Image& m_Mask;                                 //!< ゴーストのマスク画像です.
+    glare::ThreadPool*  m_pPool;                                //!< スレッドプールです.
+    int                 m_Width;                                //!< 作業バッファの基準となる横幅です.
+    int                 m_Height;                               //!< 作業バッファの基準となる縦幅です.
+    glare::Image        m_Downsample;                           //!< 1/4 縮小バッファです.
+    glare::Image        m_Level[MAX_CASCADE_LEVEL_COUNT][2];    //!< ブラーの作業バッファ(横, 縦)です.
+    glare::Image        m_Result;                               //!< star / ghost の出力バッファです.
+    glare::StarStreak   m_Star;                                 //!< 光芒です.
+    glare::LensGhost    m_Ghost;                                //!< レンズゴーストです.
+
+    EffectChain     ( const EffectChain& );     // アクセス禁止.
+    void operator = ( const EffectChain& );     // アクセス禁止.
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      使用するエフェクトの作業バッファを生成します.
+    //---------------------------------------------------------------------------------------
+    bool Resize( int width, int height )
+    {
+        if (width == m_Width && height == m_Height)
+        { return true; }
+
+        m_Width  = 0;
+        m_Height = 0;
+
+        auto w = std::max( width  / BLUR_DOWNSAMPLE_FACTOR, 1 );
+        auto h = std::max( height / BLUR_DOWNSAMPLE_FACTOR, 1 );
+        for(auto i=0; i<MAX_CASCADE_LEVEL_COUNT; ++i)
+        {
+            if (!m_Level[i][0].Create( w, h ) || !m_Level[i][1].Create( w, h ))
+            { return false; }
+
+            w = std::max( w >> 1, 1 );
+            h = std::max( h >> 1, 1 );
+        }
+
+        if (!m_Result.Create( width, height ))
+        { return false; }
+
+        for(size_t i=0; i<m_Config.Effects.size(); ++i)
+        {
+            if (m_Config.Effects[i] == EFFECT_TYPE_STAR)
+            {
+                m_Star.Term();
+                if (!m_Star.Init( width, height, m_pPool ))
+                { return false; }
+            }
+            else if (m_Config.Effects[i] == EFFECT_TYPE_GHOST)
+            {
+                m_Ghost.Term();
+                if (!m_Ghost.Init( width, height, m_pPool ))
+                { return false; }
+
+                m_Ghost.SetDeviation( m_Config.GhostDeviation );
+                m_Ghost.SetMode( m_Config.GhostMode );
+            }
+        }
+
+        m_Width  = width;
+        m_Height = height;
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      縮小バッファに横方向，縦方向の順にブラーを掛けます.
+    //---------------------------------------------------------------------------------------
+    void Blur( const glare::Image& src, int level, float deviation, float multiply )
+    {
+        auto& tmp = m_Level[level][0];
+        auto& dst = m_Level[level][1];
+        auto w = tmp.GetWidth();
+        auto h = tmp.GetHeight();
+
+        glare::GaussBlur( src, glare::CalcBlurParam( w, h, glare::Vector2( 1.0f, 0.0f ), deviation, multiply ), tmp, m_pPool );
+        glare::GaussBlur( tmp, glare::CalcBlurParam( w, h, glare::Vector2( 0.0f, 1.0f ), deviation, multiply ), dst, m_pPool );
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ブラー結果を拡大して加算します. アルファは1.0になります.
+    //---------------------------------------------------------------------------------------
+    void Composite( glare::Image& image, int levelCount )
+    {
+        auto w = image.GetWidth();
+        auto h = image.GetHeight();
+
+        glare::ParallelFor( m_pPool, h, 8, [&](int begin, int end)
+        {
+            glare::RowSampler sampler[MAX_CASCADE_LEVEL_COUNT];
+            for(auto y=begin; y<end; ++y)
+            {
+                auto v = ( float(y) + 0.5f ) / float(h);
+                for(auto i=0; i<levelCount; ++i)
+                { sampler[i].Setup( m_Level[i][1], v ); }
+
+                auto pRow = image.GetRow( y );
+                for(auto x=0; x<w; ++x)
+                {
+                    auto u     = ( float(x) + 0.5f ) / float(w);
+                    auto color = glare::Load4( pRow + x * 4 );
+                    for(auto i=0; i<levelCount; ++i)
+                    { color = glare::Add( color, sampler[i].Sample( u ) ); }
+
+                    glare::Store4( pRow + x * 4, color );
+                    pRow[x * 4 + 3] = 1.0f;
+                }
+            }
+        });
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      1段ブラーを加算します.
+    //---------------------------------------------------------------------------------------
+    bool ExecuteBlur( glare::Image& image )
+    {
+        if (!glare::Downsample( image, BLUR_DOWNSAMPLE_FACTOR, m_Downsample, m_pPool ))
+        { return false; }
+
+        Blur( m_Downsample, 0, m_Config.BlurDeviation, 1.0f );
+        Composite( image, 1 );
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      多段ブラーを加算します.
+    //---------------------------------------------------------------------------------------
+    bool ExecuteCascade( glare::Image& image )
+    {
+        if (!glare::Downsample( image, BLUR_DOWNSAMPLE_FACTOR, m_Downsample, m_pPool ))
+        { return false; }
+
+        // 2段目以降は前段のブラー結果を半分のサイズでサンプリングする(サンプルと同じ).
+        auto multiply = 1.0f;
+        for(auto i=0; i<m_Config.CascadeLevels; ++i)
+        {
+            Blur( ( i == 0 ) ? m_Downsample : m_Level[i - 1][1], i, m_Config.CascadeDeviation, multiply );
+            multiply *= 2.0f;
+        }
+
+        Composite( image, m_Config.CascadeLevels );
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      光芒を加算します.
+    //---------------------------------------------------------------------------------------
+    bool ExecuteStar( glare::Image& image )
+    {
+        if (!m_Star.Execute( image, m_Config.Star, m_Result ))
+        { return false; }
+
+        auto count = int( size_t(image.GetWidth()) * size_t(image.GetHeight()) );
+        auto pSrc  = m_Result.GetPixels();
+        auto pDst  = image.GetPixels();
+        glare::ParallelFor( m_pPool, count, 4096, [&](int begin, int end)
+        {
+            for(auto i=begin; i<end; ++i)
+            {
+                pDst[i * 4 + 0] += pSrc[i * 4 + 0];
+                pDst[i * 4 + 1] += pSrc[i * 4 + 1];
+                pDst[i * 4 + 2] += pSrc[i * 4 + 2];
+            }
+        });
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      レンズゴーストを合成します. 出力は入力を含みます.
+    //---------------------------------------------------------------------------------------
+    bool ExecuteGhost( glare::Image& image )
+    {
+        m_Ghost.Execute( image, m_Mask, m_Result );
+
+        auto count = size_t(image.GetWidth()) * size_t(image.GetHeight()) * 4;
+        memcpy( image.GetPixels(), m_Result.GetPixels(), count * sizeof(float) );
+        return true;
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------
+//      現在時刻をミリ秒で取得します.
+//-------------------------------------------------------------------------------------------
+double GetTimeMsec()
+{
+    auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
+    return std::chrono::duration<double, std::milli>( now ).count();
+}
+
+//-------------------------------------------------------------------------------------------
+//      前後の空白を取り除きます.
+//-------------------------------------------------------------------------------------------
+std::string Trim( const std::string& value )
+{
+    auto begin = value.find_first_not_of( " \t\r\n" );
+    if (begin == std::string::npos)
+    { return std::string(); }
+
+    auto end = value.find_last_not_of( " \t\r\n" );
+    return value.substr( begin, end - begin + 1 );
+}
+
+//-------------------------------------------------------------------------------------------
+//      既定の設定を取得します.
+//-------------------------------------------------------------------------------------------
+Config GetDefaultConfig()
+{
+    Config result;
+    result.Effects.push_back( EFFECT_TYPE_STAR );
+    result.Effects.push_back( EFFECT_TYPE_GHOST );
+    result.OutputFormat     = "pfm";
+    result.First            = 0;
+    result.Last             = -1;
+    result.DecodeThreads    = 1;
+    result.ProcessThreads   = 0;
+    result.EncodeThreads    = 1;
+    result.QueueDepth       = 4;
+    result.BlurDeviation    = 2.5f;
+    result.CascadeDeviation = 2.5f;
+    result.CascadeLevels    = 5;
+    result.Star             = glare::GetDefaultStarParam();
+    result.GhostDeviation   = 5.0f;
+    result.GhostMode        = glare::LENS_GHOST_MODE_FUSED;
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      エフェクトの並びを解釈します.
+//-------------------------------------------------------------------------------------------
+bool ParseEffects( const std::string& value, std::vector<EFFECT_TYPE>& effects )
+{
+    effects.clear();
+
+    size_t begin = 0;
+    while(begin <= value.size())
+    {
+        auto end = value.find( ',', begin );
+        if (end == std::string::npos)
+        { end = value.size(); }
+
+        auto name = Trim( value.substr( begin, end - begin ) );
+        if (!name.empty())
+        {
+            auto found = false;
+            for(auto i=0; i<NUM_EFFECT_TYPE; ++i)
+            {
+                if (name == EFFECT_NAMES[i])
+                {
+                    effects.push_back( EFFECT_TYPE(i) );
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+            { return false; }
+        }
+
+        begin = end + 1;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      1行分の設定を反映します.
+//-------------------------------------------------------------------------------------------
+bool ApplyConfig( const std::string& key, const std::string& value, Config& config )
+{
+    auto text = value.c_str();
+    auto i    = atoi( text );
+    auto f    = float( atof( text ) );
+
+    if      (key == "effects")              { return ParseEffects( value, config.Effects ); }
+    else if (key == "input")                { config.Input              = value; }
+    else if (key == "output")               { config.Output             = value; }
+    else if (key == "format")               { config.OutputFormat       = value; }
+    else if (key == "first")                { config.First              = i; }
+    else if (key == "last")                 { config.Last               = i; }
+    else if (key == "decode_threads")       { config.DecodeThreads      = i; }
+    else if (key == "process_threads")      { config.ProcessThreads     = i; }
+    else if (key == "encode_threads")       { config.EncodeThreads      = i; }
+    else if (key == "queue_depth")          { config.QueueDepth         = i; }
+    else if (key == "blur.deviation")       { config.BlurDeviation      = f; }
+    else if (key == "cascade.deviation")    { config.CascadeDeviation   = f; }
+    else if (key == "cascade.levels")       { config.CascadeLevels      = i; }
+    else if (key == "star.directions")      { config.Star.DirectionCount    = i; }
+    else if (key == "star.rotation")        { config.Star.Rotation          = f * glare::F_PI / 180.0f; }
+    else if (key == "star.attenuation")     { config.Star.Attenuation       = f; }
+    else if (key == "star.passes")          { config.Star.PassCount         = i; }
+    else if (key == "star.downsample")      { config.Star.DownsampleFactor  = i; }
+    else if (key == "star.threshold")       { config.Star.Threshold         = f; }
+    else if (key == "star.saturate")        { config.Star.SaturatePass      = ( i != 0 ); }
+    else if (key == "ghost.mask")           { config.GhostMask          = value; }
+    else if (key == "ghost.deviation")      { config.GhostDeviation     = f; }
+    else if (key == "ghost.mode")
+    {
+        if      (value == "multi_pass") { config.GhostMode = glare::LENS_GHOST_MODE_MULTI_PASS; }
+        else if (value == "fused")      { config.GhostMode = glare::LENS_GHOST_MODE_FUSED; }
+        else if (value == "chain")      { config.GhostMode = glare::LENS_GHOST_MODE_CHAIN; }
+        else                            { return false; }
+    }
+    else
+    { return false; }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      設定ファイルを読み込みます.
+//-------------------------------------------------------------------------------------------
+bool LoadConfig( const char* filename, Config& config )
+{
+    FILE* pFile = fopen( filename, "r" );
+    if (pFile == nullptr)
+    {
+        fprintf( stderr, "Error : File Open Failed. path = %s\n", filename );
+        return false;
+    }
+
+    auto success = true;
+    auto lineNo  = 0;
+    char buffer[1024];
+    while(fgets( buffer, sizeof(buffer), pFile ) != nullptr)
+    {
+        lineNo++;
+
+        std::string line = buffer;
+        auto comment = line.find( '#' );
+        if (comment != std::string::npos)
+        { line.erase( comment ); }
+
+        line = Trim( line );
+        if (line.empty())
+        { continue; }
+
+        auto pos = line.find( '=' );
+        if (pos == std::string::npos
+         || !ApplyConfig( Trim( line.substr( 0, pos ) ), Trim( line.substr( pos + 1 ) ), config ))
+        {
+            fprintf( stderr, "Error : Invalid Config. path = %s(%d) : %s\n", filename, lineNo, line.c_str() );
+            success = false;
+        }
+    }
+
+    fclose( pFile );
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      設定の値を検証します.
+//-------------------------------------------------------------------------------------------
+bool ValidateConfig( Config& config )
+{
+    if (config.Effects.empty() || config.Input.empty() || config.Output.empty())
+    {
+        fprintf( stderr, "Error : effects, input and output are required.\n" );
+        return false;
+    }
+
+    if (config.CascadeLevels < 1 || config.CascadeLevels > MAX_CASCADE_LEVEL_COUNT)
+    {
+        fprintf( stderr, "Error : cascade.levels must be in [1, %d].\n", MAX_CASCADE_LEVEL_COUNT );
+        return false;
+    }
+
+    auto hasGhost = std::find( config.Effects.begin(), config.Effects.end(), EFFECT_TYPE_GHOST ) != config.Effects.end();
+    if (hasGhost && config.GhostMask.empty())
+    {
+        fprintf( stderr, "Error : ghost.mask is required for ghost effect.\n" );
+        return false;
+    }
+
+    std::string ext = "." + config.OutputFormat;
+    if (config.Output.find( '%' ) == std::string::npos
+     && glare::GetImageFileType( ext.c_str() ) == glare::IMAGE_FILE_TYPE_UNKNOWN)
+    {
+        fprintf( stderr, "Error : Unsupported format. format = %s\n", config.OutputFormat.c_str() );
+        return false;
+    }
+
+    config.DecodeThreads = std::max( config.DecodeThreads, 1 );
+    config.EncodeThreads = std::max( config.EncodeThreads, 1 );
+    config.QueueDepth    = std::max( config.QueueDepth, 1 );
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ディレクトリ内のファイル名を列挙します.
+//-------------------------------------------------------------------------------------------
+bool ListFiles( const std::string& directory, std::vector<std::string>& names )
+{
+#if defined(_WIN32)
+    WIN32_FIND_DATAA data;
+    auto handle = FindFirstFileA( ( directory + "\\*" ).c_str(), &data );
+    if (handle == INVALID_HANDLE_VALUE)
+    { return false; }
+
+    do
+    {
+        if (( data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) == 0)
+        { names.push_back( data.cFileName ); }
+    }
+    while(FindNextFileA( handle, &data ));
+
+    FindClose( handle );
+#else
+    auto pDir = opendir( directory.c_str() );
+    if (pDir == nullptr)
+    { return false; }
+
+    while(auto pEntry = readdir( pDir ))
+    {
+        if (pEntry->d_name[0] != '.')
+        { names.push_back( pEntry->d_name ); }
+    }
+
+    closedir( pDir );
+#endif
+
+    std::sort( names.begin(), names.end() );
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      連番パターンにフレーム番号を埋め込みます.
+//-------------------------------------------------------------------------------------------
+std::string FormatPath( const std::string& pattern, int index )
+{
+    char buffer[1024];
+    snprintf( buffer, sizeof(buffer), pattern.c_str(), index );
+    return buffer;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ファイルが存在するかどうか.
+//-------------------------------------------------------------------------------------------
+bool IsFileExist( const std::string& path )
+{
+    FILE* pFile = fopen( path.c_str(), "rb" );
+    if (pFile == nullptr)
+    { return false; }
+
+    fclose( pFile );
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      処理するフレームを列挙します.
+//-------------------------------------------------------------------------------------------
+bool BuildFrameList( const Config& config, std::vector<FrameItem>& items )
+{
+    auto sequence = ( config.Output.find( '%' ) != std::string::npos );
+
+    // 入力が連番パターンの場合.
+    if (config.Input.find( '%' ) != std::string::npos)
+    {
+        for(auto i=config.First; config.Last < 0 || i <= config.Last; ++i)
+        {
+            FrameItem item;
+            item.InputPath = FormatPath( config.Input, i );
+            if (config.Last < 0 && !IsFileExist( item.InputPath ))
+            { break; }
+
+            if (sequence)
+            { item.OutputPath = FormatPath( config.Output, i ); }
+            else
+            {
+                auto name = FormatPath( "frame_%06d.", i ) + config.OutputFormat;
+                item.OutputPath = config.Output + "/" + name;
+            }
+
+            items.push_back( item );
+        }
+
+        return true;
+    }
+
+    // 入力がディレクトリの場合.
+    std::vector<std::string> names;
+    if (!ListFiles( config.Input, names ))
+    {
+        fprintf( stderr, "Error : Directory Open Failed. path = %s\n", config.Input.c_str() );
+        return false;
+    }
+
+    auto index = config.First;
+    for(size_t i=0; i<names.size(); ++i)
+    {
+        if (glare::GetImageFileType( names[i].c_str() ) == glare::IMAGE_FILE_TYPE_UNKNOWN)
+        { continue; }
+
+        FrameItem item;
+        item.InputPath = config.Input + "/" + names[i];
+
+        if (sequence)
+        { item.OutputPath = FormatPath( config.Output, index ); }
+        else
+        {
+            auto base = names[i].substr( 0, names[i].rfind( '.' ) );
+            item.OutputPath = config.Output + "/" + base + "." + config.OutputFormat;
+        }
+
+        items.push_back( item );
+        index++;
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    auto configPath = ( argc > 1 ) ? argv[1] : DEFAULT_CONFIG_PATH;
+
+    auto config = GetDefaultConfig();
+    if (!LoadConfig( configPath, config ) || !ValidateConfig( config ))
+    { return -1; }
+
+    std::vector<FrameItem> items;
+    if (!BuildFrameList( config, items ))
+    { return -1; }
+
+    if (items.empty())
+    {
+        fprintf( stderr, "Error : No input frames. input = %s\n", config.Input.c_str() );
+        return -1;
+    }
+
+    glare::Image mask;
+    if (!config.GhostMask.empty() && !glare::LoadImageFile( config.GhostMask.c_str(), mask ))
+    {
+        fprintf( stderr, "Error : LoadImageFile() Failed. path = %s\n", config.GhostMask.c_str() );
+        return -1;
+    }
+
+    glare::ThreadPool pool;
+    if (!pool.Init( config.ProcessThreads ))
+    {
+        fprintf( stderr, "Error : ThreadPool::Init() Failed.\n" );
+        return -1;
+    }
+
+    BoundedQueue<Frame> decoded( size_t(config.QueueDepth) );
+    BoundedQueue<Frame> processed( size_t(config.QueueDepth) );
+    std::atomic<size_t> nextItem( 0 );
+    std::atomic<int>    activeDecoders( config.DecodeThreads );
+    std::atomic<int>    errorCount( 0 );
+    std::atomic<int>    writeCount( 0 );
+
+    auto begin = GetTimeMsec();
+
+    // デコード. 全スレッドが終わったら後段のキューを閉じる.
+    std::vector<std::thread> decoders;
+    for(auto i=0; i<config.DecodeThreads; ++i)
+    {
+        decoders.emplace_back( [&]()
+        {
+            for(;;)
+            {
+                auto index = nextItem.fetch_add( 1 );
+                if (index >= items.size())
+                { break; }
+
+                Frame frame;
+                frame.Item = &items[index];
+                frame.Image.reset( new glare::Image() );
+                if (!glare::LoadImageFile( frame.Item->InputPath.c_str(), *frame.Image ))
+                {
+                    fprintf( stderr, "Error : LoadImageFile() Failed. path = %s\n", frame.Item->InputPath.c_str() );
+                    errorCount++;
+                    continue;
+                }
+
+                if (!decoded.Push( std::move( frame ) ))
+                { break; }
+            }
+
+            if (activeDecoders.fetch_sub( 1 ) == 1)
+            { decoded.Close(); }
+        });
+    }
+
+    // エフェクト処理. スレッドプールとエフェクトはこのスレッドだけが使う.
+    std::thread processor( [&]()
+    {
+        EffectChain chain( config, mask, &pool );
+
+        Frame frame;
+        while(decoded.Pop( frame ))
+        {
+            if (!chain.Execute( *frame.Image ))
+            {
+                fprintf( stderr, "Error : Effect Failed. path = %s\n", frame.Item->InputPath.c_str() );
+                errorCount++;
+                continue;
+            }
+
+            if (!processed.Push( std::move( frame ) ))
+            { break; }
+        }
+
+        processed.Close();
+    });
+
+    // エンコード.
+    std::vector<std::thread> encoders;
+    for(auto i=0; i<config.EncodeThreads; ++i)
+    {
+        encoders.emplace_back( [&]()
+        {
+            Frame frame;
+            while(processed.Pop( frame ))
+            {
+                if (!glare::SaveImageFile( frame.Item->OutputPath.c_str(), *frame.Image ))
+                {
+                    fprintf( stderr, "Error : SaveImageFile() Failed. path = %s\n", frame.Item->OutputPath.c_str() );
+                    errorCount++;
+                    continue;
+                }
+
+                writeCount++;
+            }
+        });
+    }
+
+    for(size_t i=0; i<decoders.size(); ++i)
+    { decoders[i].join(); }
+
+    processor.join();
+
+    for(size_t i=0; i<encoders.size(); ++i)
+    { encoders[i].join(); }
+
+    auto end = GetTimeMsec();
+
+    // エフェクト処理のスレッドはスレッドプールの1本目を兼ねる.
+    auto cores   = config.DecodeThreads + pool.GetThreadCount() + config.EncodeThreads;
+    auto msec    = end - begin;
+    auto fps     = ( msec > 0.0 ) ? double(writeCount) * 1000.0 / msec : 0.0;
+
+    printf( "Glare Batch : effects =" );
+    for(size_t i=0; i<config.Effects.size(); ++i)
+    { printf( " %s", EFFECT_NAMES[config.Effects[i]] ); }
+    printf( "\n" );
+
+    printf( "Glare Batch : threads = %d (decode %d, process %d, encode %d), queue depth = %d\n",
+        cores, config.DecodeThreads, pool.GetThreadCount(), config.EncodeThreads, config.QueueDepth );
+
+    printf( "Glare Batch : frames = %d / %d, %10.3f msec, %8.3f frames/sec, %8.3f frames/sec/core\n",
+        int(writeCount), int(items.size()), msec, fps, fps / double(cores) );
+
+    pool.Term();
+
+    return ( errorCount == 0 ) ? 0 : -1;
+}
@@ -0,0 +1,2009 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : main.cpp
+// Desc : Glare Micro Benchmark.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareThreadPool.h>
+#include <glareGaussBlur.h>
+#include <glareSeparableBlur.h>
+#include <glareLinearTap.h>
+#include <glareBoxBlur.h>
+#include <glareFftBloom.h>
+#include <glareMapFile.h>
+#include <glareMapWriter.h>
+#include <glareStar.h>
+#include <glareTiledBloom.h>
+#include <glareTiledBlur.h>
+#include <glarePyramid.h>
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   BENCHMARK_COUNT = 10;
+const float DEVIATION       = 2.5f;
+const float TOLERANCE       = 1e-4f;
+const int   VALIDATE_WIDTH  = 123;
+const int   VALIDATE_HEIGHT = 77;
+const int   SUBTEXEL_STEPS  = 256;      //!< D3D11 のテクスチャフィルタが保証する小数部の分解能(8bit)です.
+
+const char* FORMAT_NAMES[glare::NUM_PIXEL_FORMAT] = {
+    "rgba8 srgb",
+    "rgba16f",
+    "rgba32f",
+};
+
+// スカラー実装との許容誤差. 量子化の境界で1段階ずれるのは許容する.
+const float FORMAT_TOLERANCES[glare::NUM_PIXEL_FORMAT] = {
+    1.0f / 255.0f + 1e-6f,
+    1.0f / 1024.0f,
+    1e-5f,
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Resolution structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct Resolution
+{
+    int         Width;      //!< 横幅です.
+    int         Height;     //!< 縦幅です.
+};
+
+const Resolution RESOLUTIONS[] = {
+    { 1920, 1080 },
+    { 3840, 2160 },
+};
+
+// 箱型フィルタで計測する標準偏差(テクセル).
+const float BOX_BLUR_DEVIATIONS[] = { 2.0f, 5.0f, 16.0f, 64.0f };
+
+// FFTで畳み込むガウスカーネルの標準偏差(テクセル)と，回折カーネルのサイズ.
+const float FFT_BLOOM_DEVIATIONS[]  = { 16.0f, 64.0f };
+const int   DIFFRACTION_SIZES[]     = { 256, 512 };
+
+// 光芒の本数と縮小率.
+const int   STAR_DIRECTION_COUNTS[]     = { 4, 6, 8, 16 };
+const int   STAR_DOWNSAMPLE_FACTORS[]   = { 1, 2, 4 };
+
+// 縮小解像度の光芒と等倍の光芒の許容誤差.
+const float STAR_ENERGY_TOLERANCE   = 0.01f;    //!< 総エネルギーの相対誤差です.
+const float STAR_LENGTH_TOLERANCE   = 0.05f;    //!< 光源からの平均距離の相対誤差です.
+const float STAR_BLURRED_TOLERANCE  = 0.15f;    //!< 縮小率の2倍の標準偏差でぼかした後の相対RMS誤差です.
+
+const char* DEFAULT_MASK_PATH = "../../LensGhost/sample/res/texture/mask.map";
+const int   MAP_OPEN_COUNT    = 1000;   //!< MAPファイルを開く回数です.
+
+const char* MAP_WRITE_PATH          = "glare_map_writer_test.map";  //!< 書き出しの検証に使う一時ファイルです.
+const float MAP_UNORM_TOLERANCE     = 1.0f / 255.0f + 1e-5f;        //!< 非圧縮フォーマットの最大誤差です.
+const float MAP_BC_RMS_TOLERANCE    = 0.02f;                        //!< BCフォーマットの平均二乗誤差の平方根です.
+const int   MAP_WRITE_COUNT         = 3;                            //!< 書き出しの計測回数です.
+
+const float HDR_SCALE               = 64.0f;                        //!< HDRの検証画像の最大輝度です.
+const float HALF_TOLERANCE          = 1.0f / 2048.0f;               //!< 半精度浮動小数の相対誤差です.
+const float RGB9E5_TOLERANCE        = 1.0f / 512.0f;                //!< RGB9E5の最大成分に対する相対誤差です.
+const int   HALF_CONVERT_COUNT      = 10;                           //!< 半精度変換の計測回数です.
+
+const char*  TILED_SOURCE_PATH      = "glare_tiled_bloom_src.map";  //!< タイル処理の入力に使う一時ファイルです.
+const char*  TILED_OUTPUT_PATH      = "glare_tiled_bloom_dst.map";  //!< タイル処理の出力に使う一時ファイルです.
+const size_t TILED_VALIDATE_BUDGET  = 512 * 1024;                   //!< 検証で小さなタイルに分割させる作業メモリです.
+const int    TILED_BENCH_WIDTH      = 8192;                         //!< 計測に使う画像の横幅です.
+const int    TILED_BENCH_HEIGHT     = 4096;                         //!< 計測に使う画像の縦幅です.
+const size_t TILED_BENCH_BUDGETS[]  = {                             //!< 計測する作業メモリの上限です.
+    16 * 1024 * 1024,
+    64 * 1024 * 1024,
+    256 * 1024 * 1024,
+};
+
+// コンピュートシェーダのタイル分割を再現したブラーの半径(テクセル).
+const int   TILED_BLUR_RADII[] = { 7, 31, 64 };
+
+const int   PYRAMID_FACTOR      = 4;    //!< 縮小バッファの1段目の縮小率です(MultipleGaussBlur サンプルと同じ).
+const int   PYRAMID_LEVEL_COUNT = 5;    //!< 縮小バッファの段数です(MultipleGaussBlur サンプルと同じ).
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Buffer structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct Buffer
+{
+    std::vector<uint8_t>    Pixels;     //!< ピクセルデータです.
+    glare::Surface          Surface;    //!< サーフェイスです.
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      バッファを生成します.
+    //---------------------------------------------------------------------------------------
+    void Create( int width, int height, glare::PIXEL_FORMAT format )
+    {
+        auto pitch = glare::GetPixelSize( format ) * size_t(width);
+        Pixels.resize( pitch * size_t(height) );
+        Surface.pPixels = Pixels.data();
+        Surface.Width   = width;
+        Surface.Height  = height;
+        Surface.Pitch   = pitch;
+        Surface.Format  = format;
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------
+//      現在時刻をミリ秒で取得します.
+//-------------------------------------------------------------------------------------------
+double GetTimeMsec()
+{
+    auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
+    return std::chrono::duration<double, std::milli>( now ).count();
+}
+
+//-------------------------------------------------------------------------------------------
+//      テスト用の画像を生成します.
+//-------------------------------------------------------------------------------------------
+bool CreateTestImage( int width, int height, glare::Image& image )
+{
+    if (!image.Create( width, height ))
+    { return false; }
+
+    uint32_t seed = 12345;
+    auto pixels = image.GetPixels();
+    auto count  = size_t(width) * size_t(height) * 4;
+    for(size_t i=0; i<count; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        pixels[i] = float(seed >> 8) / float(1 << 24);
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      サーフェイスのフォーマットを変換します.
+//-------------------------------------------------------------------------------------------
+bool Convert( const glare::Surface& src, const glare::Surface& dst )
+{
+    // 恒等カーネルで書き込めばフォーマット変換になる.
+    glare::BlurKernel identityH = {};
+    glare::BlurKernel identityV = {};
+    identityH.Weight[0] = 1.0f;
+    identityV.Weight[0] = 1.0f;
+    identityV.Vertical  = true;
+
+    glare::SeparableBlur blur;
+    if (!blur.Init( src.Width, src.Height, glare::SIMD_ISA_SCALAR ))
+    { return false; }
+
+    return blur.Execute( src, identityH, identityV, dst );
+}
+
+//-------------------------------------------------------------------------------------------
+//      2つのバッファの最大誤差を求めます.
+//-------------------------------------------------------------------------------------------
+float CalcMaxError( const Buffer& a, const Buffer& b )
+{
+    // sRGBは量子化した値で比較する.
+    if (a.Surface.Format == glare::PIXEL_FORMAT_R8G8B8A8_SRGB)
+    {
+        auto result = 0;
+        for(size_t i=0; i<a.Pixels.size(); ++i)
+        {
+            auto diff = abs( int(a.Pixels[i]) - int(b.Pixels[i]) );
+            if (diff > result)
+            { result = diff; }
+        }
+        return float(result) / 255.0f;
+    }
+
+    glare::Image imageA;
+    glare::Image imageB;
+    if (!imageA.Create( a.Surface.Width, a.Surface.Height )
+     || !imageB.Create( b.Surface.Width, b.Surface.Height )
+     || !Convert( a.Surface, glare::GetSurface( imageA ) )
+     || !Convert( b.Surface, glare::GetSurface( imageB ) ))
+    { return 1e+30f; }
+
+    auto count = size_t(a.Surface.Width) * size_t(a.Surface.Height) * 4;
+    auto pA = imageA.GetPixels();
+    auto pB = imageB.GetPixels();
+
+    auto result = 0.0f;
+    for(size_t i=0; i<count; ++i)
+    {
+        auto diff = fabsf( pA[i] - pB[i] );
+        if (diff > result)
+        { result = diff; }
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      2つの画像のRGBの最大誤差を求めます.
+//-------------------------------------------------------------------------------------------
+float CalcMaxError( const glare::Image& a, const glare::Image& b )
+{
+    auto result = 0.0f;
+    for(auto y=0; y<a.GetHeight(); ++y)
+    {
+        for(auto x=0; x<a.GetWidth(); ++x)
+        {
+            for(auto c=0; c<3; ++c)
+            {
+                auto diff = fabsf( a.GetRow( y )[x * 4 + c] - b.GetRow( y )[x * 4 + c] );
+                if (diff > result)
+                { result = diff; }
+            }
+        }
+    }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      既存の GaussBlur() と結果を比較します.
+//-------------------------------------------------------------------------------------------
+bool Validate( glare::SIMD_ISA isa, int paramScale )
+{
+    auto w = VALIDATE_WIDTH;
+    auto h = VALIDATE_HEIGHT;
+
+    glare::Image src;
+    glare::Image temp;
+    glare::Image expected;
+    glare::Image result;
+    if (!CreateTestImage( w, h, src )
+     || !temp.Create( w, h )
+     || !expected.Create( w, h )
+     || !result.Create( w, h ))
+    { return false; }
+
+    // paramScale > 1 の場合はテクセルの間を指すオフセットになる.
+    auto paramH = glare::CalcBlurParam( w * paramScale, h * paramScale, glare::Vector2(1.0f, 0.0f), DEVIATION );
+    auto paramV = glare::CalcBlurParam( w * paramScale, h * paramScale, glare::Vector2(0.0f, 1.0f), DEVIATION );
+    glare::GaussBlur( src,  paramH, temp );
+    glare::GaussBlur( temp, paramV, expected );
+
+    glare::SeparableBlur blur;
+    if (!blur.Init( w, h, isa ))
+    { return false; }
+
+    if (!blur.Execute( glare::GetSurface( src ), paramH, paramV, glare::GetSurface( result ) ))
+    { return false; }
+
+    auto error = CalcMaxError( expected, result );
+
+    printf( "SeparableBlur : validate %-6s scale %d : max error = %e\n",
+        glare::GetSimdIsaName( isa ), paramScale, error );
+
+    return ( error <= TOLERANCE );
+}
+
+//-------------------------------------------------------------------------------------------
+//      命令セット，フォーマットごとに処理時間を計測します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkSeparableBlur( glare::ThreadPool& pool, int width, int height )
+{
+    glare::Image source;
+    if (!CreateTestImage( width, height, source ))
+    { return false; }
+
+    auto paramH = glare::CalcBlurParam( width, height, glare::Vector2(1.0f, 0.0f), DEVIATION );
+    auto paramV = glare::CalcBlurParam( width, height, glare::Vector2(0.0f, 1.0f), DEVIATION );
+
+    glare::BlurKernel kernelH;
+    glare::BlurKernel kernelV;
+    if (!glare::MakeBlurKernel( paramH, width, height, kernelH )
+     || !glare::MakeBlurKernel( paramV, width, height, kernelV ))
+    { return false; }
+
+    for(auto f=0; f<glare::NUM_PIXEL_FORMAT; ++f)
+    {
+        auto format = glare::PIXEL_FORMAT(f);
+
+        Buffer src;
+        Buffer dst;
+        Buffer reference;
+        src.Create( width, height, format );
+        dst.Create( width, height, format );
+        reference.Create( width, height, format );
+        if (!Convert( glare::GetSurface( source ), src.Surface ))
+        { return false; }
+
+        for(auto i=0; i<glare::NUM_SIMD_ISA; ++i)
+        {
+            auto isa = glare::SIMD_ISA(i);
+            if (!glare::IsSimdIsaSupported( isa ))
+            { continue; }
+
+            glare::SeparableBlur blur;
+            if (!blur.Init( width, height, isa ))
+            { return false; }
+
+            auto& result = ( isa == glare::SIMD_ISA_SCALAR ) ? reference : dst;
+            blur.Execute( src.Surface, kernelH, kernelV, result.Surface, &pool );
+
+            // スカラー実装との差. FMA の有無で丸めが異なるので完全には一致しない.
+            auto error = CalcMaxError( reference, result );
+
+            double msec[2];
+            for(auto t=0; t<2; ++t)
+            {
+                auto pPool = ( t == 0 ) ? nullptr : &pool;
+                auto begin = GetTimeMsec();
+                for(auto j=0; j<BENCHMARK_COUNT; ++j)
+                { blur.Execute( src.Surface, kernelH, kernelV, dst.Surface, pPool ); }
+                msec[t] = ( GetTimeMsec() - begin ) / double(BENCHMARK_COUNT);
+            }
+
+            // 読み込みと書き込みのバイト数で帯域を求める.
+            auto bytes = double(src.Pixels.size()) * 2.0;
+            printf( "SeparableBlur : %d x %d, %-10s, %-6s : 1 thread %8.3f msec (%6.2f GB/s), %d threads %8.3f msec (%6.2f GB/s), max error = %e\n",
+                width, height, FORMAT_NAMES[f], glare::GetSimdIsaName( isa ),
+                msec[0], bytes / ( msec[0] * 1e+6 ),
+                pool.GetThreadCount(),
+                msec[1], bytes / ( msec[1] * 1e+6 ),
+                error );
+
+            if (error > FORMAT_TOLERANCES[f])
+            { return false; }
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      タップテーブルのオフセットをテクスチャフィルタの分解能に丸めます.
+//-------------------------------------------------------------------------------------------
+void QuantizeTapTable( int width, int height, glare::TapTable& table )
+{
+    for(auto i=0; i<table.Count; ++i)
+    {
+        auto& tap = table.Offset[i];
+        tap.x = roundf( tap.x * float(width  * SUBTEXEL_STEPS) ) / float(width  * SUBTEXEL_STEPS);
+        tap.y = roundf( tap.y * float(height * SUBTEXEL_STEPS) ) / float(height * SUBTEXEL_STEPS);
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      整数タップとリニアサンプリングでまとめたタップの結果と処理時間を比較します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkLinearTap( glare::ThreadPool& pool, int width, int height )
+{
+    glare::Image src;
+    glare::Image temp;
+    glare::Image expected;
+    glare::Image result;
+    if (!CreateTestImage( width, height, src )
+     || !temp.Create( width, height )
+     || !expected.Create( width, height )
+     || !result.Create( width, height ))
+    { return false; }
+
+    auto success = true;
+
+    for(auto i=0; i<glare::LINEAR_TAP_VARIANT_COUNT; ++i)
+    {
+        auto tapCount = glare::LINEAR_TAP_VARIANTS[i];
+
+        // カーネルの端が 3σ になるようにする.
+        auto deviation = float(tapCount - 1) / 6.0f;
+
+        glare::BlurKernel kernelH;
+        glare::BlurKernel kernelV;
+        if (!glare::MakeGaussKernel( tapCount, deviation, false, kernelH )
+         || !glare::MakeGaussKernel( tapCount, deviation, true,  kernelV ))
+        { return false; }
+
+        glare::TapTable integerH, integerV;
+        glare::TapTable linearH,  linearV;
+        if (!glare::MakeIntegerTapTable( kernelH, width, height, integerH )
+         || !glare::MakeIntegerTapTable( kernelV, width, height, integerV )
+         || !glare::MakeLinearTapTable ( kernelH, width, height, linearH )
+         || !glare::MakeLinearTapTable ( kernelV, width, height, linearV ))
+        { return false; }
+
+        auto begin = GetTimeMsec();
+        glare::TapBlur( src,  integerH, temp,     &pool );
+        glare::TapBlur( temp, integerV, expected, &pool );
+        auto integerMsec = GetTimeMsec() - begin;
+
+        begin = GetTimeMsec();
+        glare::TapBlur( src,  linearH, temp,   &pool );
+        glare::TapBlur( temp, linearV, result, &pool );
+        auto linearMsec = GetTimeMsec() - begin;
+
+        auto error = CalcMaxError( expected, result );
+
+        // GPUのフィルタ精度で丸めた場合の誤差(参考値).
+        QuantizeTapTable( width, height, linearH );
+        QuantizeTapTable( width, height, linearV );
+        glare::TapBlur( src,  linearH, temp,   &pool );
+        glare::TapBlur( temp, linearV, result, &pool );
+        auto quantizedError = CalcMaxError( expected, result );
+
+        printf( "LinearTap : %d x %d, %2d taps : fetches %2d -> %2d, %8.3f msec -> %8.3f msec, max error = %e (8bit subtexel : %e)\n",
+            width, height, tapCount, integerH.Count, linearH.Count,
+            integerMsec, linearMsec, error, quantizedError );
+
+        success &= ( linearH.Count == glare::GetLinearFetchCount( tapCount ) );
+        success &= ( error <= TOLERANCE );
+    }
+
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      箱型フィルタの反復によるブラーの処理時間と，ガウスブラーとの差を計測します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkBoxBlur( glare::ThreadPool& pool, int width, int height )
+{
+    glare::Image src;
+    glare::Image result;
+    glare::Image expected;
+    if (!CreateTestImage( width, height, src )
+     || !result.Create( width, height )
+     || !expected.Create( width, height ))
+    { return false; }
+
+    glare::SeparableBlur reference;
+    if (!reference.Init( width, height ))
+    { return false; }
+
+    auto count = int(sizeof(BOX_BLUR_DEVIATIONS) / sizeof(BOX_BLUR_DEVIATIONS[0]));
+    for(auto i=0; i<count; ++i)
+    {
+        auto deviation = BOX_BLUR_DEVIATIONS[i];
+
+        glare::BoxBlurParam param;
+        if (!glare::CalcBoxBlurParam( deviation, glare::DEFAULT_BOX_PASS_COUNT, param ))
+        { return false; }
+
+        auto begin = GetTimeMsec();
+        for(auto j=0; j<BENCHMARK_COUNT; ++j)
+        {
+            if (!glare::BoxGaussBlur( src, param, result, &pool ))
+            { return false; }
+        }
+        auto msec = ( GetTimeMsec() - begin ) / double(BENCHMARK_COUNT);
+
+        printf( "BoxBlur : %d x %d, sigma %5.1f (actual %6.2f), radius %2d %2d %2d : %8.3f msec",
+            width, height, deviation, glare::GetBoxBlurDeviation( param ),
+            param.Radius[0], param.Radius[1], param.Radius[2], msec );
+
+        // 3σ まで取れる場合は整数タップのガウスブラーと比較.
+        auto tapCount = int( ceilf( deviation * 3.0f ) ) * 2 + 1;
+        glare::BlurKernel kernelH;
+        glare::BlurKernel kernelV;
+        if (glare::MakeGaussKernel( tapCount, deviation, false, kernelH )
+         && glare::MakeGaussKernel( tapCount, deviation, true,  kernelV ))
+        {
+            begin = GetTimeMsec();
+            reference.Execute( glare::GetSurface( src ), kernelH, kernelV, glare::GetSurface( expected ), &pool );
+            auto referenceMsec = GetTimeMsec() - begin;
+
+            printf( ", gauss %3d taps %8.3f msec, max error = %e",
+                tapCount, referenceMsec, CalcMaxError( expected, result ) );
+        }
+
+        printf( "\n" );
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      チャンネルごとの和が1になる乱数のカーネルを生成します.
+//-------------------------------------------------------------------------------------------
+bool CreateTestKernel( int width, int height, glare::Image& kernel )
+{
+    if (!CreateTestImage( width, height, kernel ))
+    { return false; }
+
+    double sum[4] = {};
+    auto pixels = kernel.GetPixels();
+    auto count  = size_t(width) * size_t(height);
+    for(size_t i=0; i<count * 4; ++i)
+    { sum[i & 3] += pixels[i]; }
+
+    for(size_t i=0; i<count * 4; ++i)
+    { pixels[i] = float( pixels[i] / sum[i & 3] ); }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ガウス分布のカーネル画像を生成します.
+//-------------------------------------------------------------------------------------------
+bool CreateGaussKernel( float deviation, glare::Image& kernel )
+{
+    auto radius = int( ceilf( deviation * 3.0f ) );
+    auto size   = radius * 2 + 1;
+    if (!kernel.Create( size, size ))
+    { return false; }
+
+    // 縦横の1次元カーネルの積なので，SeparableBlur と同じ重みになる.
+    std::vector<double> weight( size );
+    auto sum = 0.0;
+    for(auto i=0; i<size; ++i)
+    {
+        auto d = double(i - radius);
+        weight[i] = exp( -0.5 * d * d / ( double(deviation) * double(deviation) ) );
+        sum += weight[i];
+    }
+
+    for(auto y=0; y<size; ++y)
+    {
+        for(auto x=0; x<size; ++x)
+        {
+            auto value = float( weight[x] * weight[y] / ( sum * sum ) );
+            kernel.Store( x, y, glare::Set4( value, value, value, 1.0f ) );
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      FFTによる畳み込みを直接の畳み込みと比較します.
+//-------------------------------------------------------------------------------------------
+bool ValidateFftBloom()
+{
+    auto w  = VALIDATE_WIDTH;
+    auto h  = VALIDATE_HEIGHT;
+    auto kw = 21;
+    auto kh = 14;
+
+    glare::Image src;
+    glare::Image kernel;
+    glare::Image result;
+    if (!CreateTestImage( w, h, src )
+     || !CreateTestKernel( kw, kh, kernel )
+     || !result.Create( w, h ))
+    { return false; }
+
+    glare::FftBloom bloom;
+    if (!bloom.Init( w, h, kw, kh )
+     || !bloom.SetKernel( kernel )
+     || !bloom.Execute( src, result ))
+    { return false; }
+
+    // 画像の外は0として直接畳み込む.
+    auto error = 0.0f;
+    for(auto y=0; y<h; ++y)
+    {
+        for(auto x=0; x<w; ++x)
+        {
+            for(auto c=0; c<3; ++c)
+            {
+                auto sum = 0.0;
+                for(auto j=0; j<kh; ++j)
+                {
+                    auto sy = y - ( j - kh / 2 );
+                    if (sy < 0 || sy >= h)
+                    { continue; }
+
+                    for(auto i=0; i<kw; ++i)
+                    {
+                        auto sx = x - ( i - kw / 2 );
+                        if (sx < 0 || sx >= w)
+                        { continue; }
+
+                        sum += double(kernel.GetRow( j )[i * 4 + c]) * double(src.GetRow( sy )[sx * 4 + c]);
+                    }
+                }
+
+                auto diff = fabsf( float(sum) - result.GetRow( y )[x * 4 + c] );
+                if (diff > error)
+                { error = diff; }
+            }
+        }
+    }
+
+    printf( "FftBloom : validate %d x %d, kernel %d x %d : max error = %e\n", w, h, kw, kh, error );
+
+    return ( error <= TOLERANCE );
+}
+
+//-------------------------------------------------------------------------------------------
+//      FFTによる畳み込みの処理時間を，同じ広がりの既存のブラーと比較します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkFftBloom( glare::ThreadPool& pool, int width, int height, const char* maskPath )
+{
+    glare::Image src;
+    glare::Image result;
+    glare::Image expected;
+    if (!CreateTestImage( width, height, src )
+     || !result.Create( width, height )
+     || !expected.Create( width, height ))
+    { return false; }
+
+    glare::SeparableBlur reference;
+    if (!reference.Init( width, height ))
+    { return false; }
+
+    auto count = int(sizeof(FFT_BLOOM_DEVIATIONS) / sizeof(FFT_BLOOM_DEVIATIONS[0]));
+    for(auto i=0; i<count; ++i)
+    {
+        auto deviation = FFT_BLOOM_DEVIATIONS[i];
+
+        glare::Image kernel;
+        if (!CreateGaussKernel( deviation, kernel ))
+        { return false; }
+
+        glare::FftBloom bloom;
+        if (!bloom.Init( width, height, kernel.GetWidth(), kernel.GetHeight() ))
+        { return false; }
+
+        // カーネルのスペクトルは1度だけ求めればよい.
+        auto begin = GetTimeMsec();
+        if (!bloom.SetKernel( kernel, &pool ))
+        { return false; }
+        auto kernelMsec = GetTimeMsec() - begin;
+
+        begin = GetTimeMsec();
+        for(auto j=0; j<BENCHMARK_COUNT; ++j)
+        {
+            if (!bloom.Execute( src, result, &pool ))
+            { return false; }
+        }
+        auto msec = ( GetTimeMsec() - begin ) / double(BENCHMARK_COUNT);
+
+        glare::BoxBlurParam boxParam;
+        if (!glare::CalcBoxBlurParam( deviation, glare::DEFAULT_BOX_PASS_COUNT, boxParam ))
+        { return false; }
+
+        begin = GetTimeMsec();
+        if (!glare::BoxGaussBlur( src, boxParam, expected, &pool ))
+        { return false; }
+        auto boxMsec = GetTimeMsec() - begin;
+
+        printf( "FftBloom : %d x %d (fft %d x %d), gauss sigma %5.1f : kernel %8.3f msec, frame %8.3f msec, box blur %8.3f msec",
+            width, height, bloom.GetFftWidth(), bloom.GetFftHeight(), deviation, kernelMsec, msec, boxMsec );
+
+        // 端の扱いが異なるので，3σ より内側だけを比較する.
+        glare::BlurKernel kernelH;
+        glare::BlurKernel kernelV;
+        if (glare::MakeGaussKernel( kernel.GetWidth(), deviation, false, kernelH )
+         && glare::MakeGaussKernel( kernel.GetWidth(), deviation, true,  kernelV ))
+        {
+            begin = GetTimeMsec();
+            reference.Execute( glare::GetSurface( src ), kernelH, kernelV, glare::GetSurface( expected ), &pool );
+            auto referenceMsec = GetTimeMsec() - begin;
+
+            auto border = kernel.GetWidth() / 2;
+            auto error  = 0.0f;
+            for(auto y=border; y<height - border; ++y)
+            {
+                for(auto x=border * 4; x<( width - border ) * 4; ++x)
+                {
+                    if (( x & 3 ) == 3)
+                    { continue; }
+
+                    auto diff = fabsf( expected.GetRow( y )[x] - result.GetRow( y )[x] );
+                    if (diff > error)
+                    { error = diff; }
+                }
+            }
+
+            printf( ", separable %3d taps %8.3f msec, max error = %e", kernel.GetWidth(), referenceMsec, error );
+        }
+
+        printf( "\n" );
+    }
+
+    // 絞りの回折像. カーネルが大きくても1フレームの処理時間はFFTのサイズだけで決まる.
+    glare::Image mask;
+    if (!glare::LoadMapFile( maskPath, mask ))
+    {
+        printf( "FftBloom : skip diffraction kernel, LoadMapFile() Failed. path = %s\n", maskPath );
+        return true;
+    }
+
+    count = int(sizeof(DIFFRACTION_SIZES) / sizeof(DIFFRACTION_SIZES[0]));
+    for(auto i=0; i<count; ++i)
+    {
+        auto size = DIFFRACTION_SIZES[i];
+
+        glare::Image kernel;
+        auto begin = GetTimeMsec();
+        if (!glare::MakeDiffractionKernel( mask, size, kernel, &pool ))
+        { return false; }
+        auto makeMsec = GetTimeMsec() - begin;
+
+        glare::FftBloom bloom;
+        if (!bloom.Init( width, height, size, size ))
+        { return false; }
+
+        begin = GetTimeMsec();
+        if (!bloom.SetKernel( kernel, &pool ))
+        { return false; }
+        auto kernelMsec = GetTimeMsec() - begin;
+
+        begin = GetTimeMsec();
+        for(auto j=0; j<BENCHMARK_COUNT; ++j)
+        {
+            if (!bloom.Execute( src, result, &pool ))
+            { return false; }
+        }
+        auto msec = ( GetTimeMsec() - begin ) / double(BENCHMARK_COUNT);
+
+        printf( "FftBloom : %d x %d (fft %d x %d), diffraction %3d x %3d : generate %8.3f msec, kernel %8.3f msec, frame %8.3f msec\n",
+            width, height, bloom.GetFftWidth(), bloom.GetFftHeight(), size, size, makeMsec, kernelMsec, msec );
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      MAPファイルを読み込んでサーフェイスごとにコピーする場合と，マップする場合を比較します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkMapView( const char* path )
+{
+    glare::MapView view;
+    if (!view.Open( path ))
+    {
+        printf( "MapView : skip, Open() Failed. path = %s\n", path );
+        return true;
+    }
+
+    auto fileSize = view.GetSize();
+    auto mipCount = int(view.GetMipCount());
+    view.Close();
+
+    // ファイル全体を読み込み，サーフェイスごとのバッファにコピーする.
+    std::vector<std::vector<uint8_t>> surfaces( mipCount );
+    auto begin = GetTimeMsec();
+    for(auto j=0; j<MAP_OPEN_COUNT; ++j)
+    {
+        auto pFile = fopen( path, "rb" );
+        if (pFile == nullptr)
+        { return false; }
+
+        std::vector<uint8_t> data( fileSize );
+        auto size = fread( data.data(), 1, data.size(), pFile );
+        fclose( pFile );
+        if (size != data.size())
+        { return false; }
+
+        auto offset = sizeof(glare::MAP_FILE_HEADER) + sizeof(glare::MAP_TEXTURE_INFO);
+        for(auto i=0; i<mipCount; ++i)
+        {
+            glare::MAP_SURFACE_INFO info;
+            memcpy( &info, data.data() + offset, sizeof(info) );
+            offset += sizeof(info);
+
+            surfaces[i].assign( data.data() + offset, data.data() + offset + info.SlicePitch );
+            offset += info.SlicePitch;
+        }
+    }
+    auto readMsec = ( GetTimeMsec() - begin ) / double(MAP_OPEN_COUNT);
+
+    // マップしてサーフェイスを直接参照する. 最初の1回だけコピーした内容と比較する.
+    auto match = true;
+    auto touch = 0u;
+    begin = GetTimeMsec();
+    for(auto j=0; j<MAP_OPEN_COUNT; ++j)
+    {
+        glare::MapView map;
+        if (!map.Open( path ))
+        { return false; }
+
+        for(auto i=0; i<mipCount; ++i)
+        {
+            glare::MapSurface surface;
+            if (!map.GetSurface( 0, i, surface ))
+            { return false; }
+
+            touch += surface.pData[surface.SlicePitch - 1];
+
+            if (j == 0)
+            {
+                match &= ( surface.SlicePitch == surfaces[i].size() )
+                      && ( memcmp( surface.pData, surfaces[i].data(), surface.SlicePitch ) == 0 );
+            }
+        }
+    }
+    auto mapMsec = ( GetTimeMsec() - begin ) / double(MAP_OPEN_COUNT);
+
+    printf( "MapView : %d bytes, %2d mips : read + copy %7.4f msec, map %7.4f msec, match = %s (%u)\n",
+        int(fileSize), mipCount, readMsec, mapMsec, ( match ) ? "yes" : "no", touch & 0xff );
+
+    return match;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ブロック圧縮で評価できる滑らかなテスト画像を生成します.
+//-------------------------------------------------------------------------------------------
+bool CreateSmoothImage( int width, int height, glare::Image& image )
+{
+    if (!image.Create( width, height ))
+    { return false; }
+
+    for(auto y=0; y<height; ++y)
+    {
+        auto v = float(y) / float(height);
+        for(auto x=0; x<width; ++x)
+        {
+            auto u = float(x) / float(width);
+            image.Store( x, y, glare::Set4(
+                u,
+                v,
+                0.5f + 0.5f * sinf( 6.0f * u + 4.0f * v ),
+                0.5f + 0.5f * cosf( 5.0f * v - 3.0f * u ) ) );
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      MAPファイルに書き出して読み戻し，元の画像と比較します.
+//-------------------------------------------------------------------------------------------
+bool ValidateMapWriter( glare::ThreadPool& pool )
+{
+    const int WIDTH  = 70;
+    const int HEIGHT = 45;
+
+    // BC1 は半透明を表現できないので，不透明にした画像でも比較する.
+    glare::Image src;
+    glare::Image opaque;
+    glare::Image even;
+    if (!CreateSmoothImage( WIDTH, HEIGHT, src )
+     || !CreateSmoothImage( WIDTH, HEIGHT, opaque )
+     || !CreateSmoothImage( WIDTH & ~1, HEIGHT & ~1, even ))
+    { return false; }
+
+    for(auto y=0; y<HEIGHT; ++y)
+    {
+        for(auto x=0; x<WIDTH; ++x)
+        { opaque.GetRow( y )[x * 4 + 3] = 1.0f; }
+    }
+
+    // 縦横が偶数の場合，箱型フィルタは2x2の平均と一致する.
+    glare::Image half;
+    if (!glare::GenerateMip( even, glare::MIP_FILTER_BOX, half, &pool ))
+    { return false; }
+
+    auto boxError = 0.0f;
+    for(auto y=0; y<half.GetHeight(); ++y)
+    {
+        for(auto x=0; x<half.GetWidth(); ++x)
+        {
+            auto a = even.Fetch( x * 2 + 0, y * 2 + 0 );
+            auto b = even.Fetch( x * 2 + 1, y * 2 + 0 );
+            auto c = even.Fetch( x * 2 + 0, y * 2 + 1 );
+            auto d = even.Fetch( x * 2 + 1, y * 2 + 1 );
+            auto expected = glare::Mul( glare::Add( glare::Add( a, b ), glare::Add( c, d ) ), glare::Splat4( 0.25f ) );
+            auto actual   = half.Fetch( x, y );
+            for(auto c4=0; c4<4; ++c4)
+            { boxError = std::max( boxError, fabsf( glare::GetElement( actual, c4 ) - glare::GetElement( expected, c4 ) ) ); }
+        }
+    }
+
+    auto success = ( boxError <= TOLERANCE );
+    printf( "MapWriter : box mip error = %e, %s\n", boxError, ( boxError <= TOLERANCE ) ? "OK" : "NG" );
+
+    const char* names[glare::NUM_MAP_FORMAT] = { "A8", "L8", "RGBA8", "BC1", "BC2", "BC3", "RGBA16F", "RGB9E5" };
+    for(auto f=0; f<glare::NUM_MAP_FORMAT; ++f)
+    {
+        auto desc = glare::GetDefaultMapWriteDesc();
+        desc.Format    = glare::MAP_FORMAT(f);
+        desc.MipFilter = glare::MIP_FILTER_KAISER;
+        desc.SRGB      = false;
+
+        auto& input = ( f == glare::MAP_FORMAT_BC1 ) ? opaque : src;
+        if (!glare::SaveMapFile( MAP_WRITE_PATH, &input, 1, desc, &pool ))
+        {
+            printf( "MapWriter : %-7s : SaveMapFile() Failed.\n", names[f] );
+            success = false;
+            continue;
+        }
+
+        // ミップ数とサイズ, 最上位レベルの誤差を確認する.
+        glare::MapView view;
+        auto match = view.Open( MAP_WRITE_PATH )
+                  && view.GetFormat() == glare::MAP_FORMAT(f)
+                  && int(view.GetMipCount()) == glare::CalcMipCount( WIDTH, HEIGHT );
+
+        for(auto i=0; match && i<int(view.GetMipCount()); ++i)
+        {
+            glare::MapSurface surface;
+            match &= view.GetSurface( 0, i, surface )
+                  && int(surface.Width)  == std::max( WIDTH  >> i, 1 )
+                  && int(surface.Height) == std::max( HEIGHT >> i, 1 );
+        }
+
+        glare::Image decoded;
+        glare::MapSurface top;
+        match = match && view.GetSurface( 0, 0, top ) && glare::DecodeMapSurface( top, decoded );
+        view.Close();
+
+        auto maxError = 0.0f;
+        auto sumError = 0.0;
+        auto count    = 0;
+        for(auto y=0; match && y<HEIGHT; ++y)
+        {
+            for(auto x=0; x<WIDTH; ++x)
+            {
+                float expected[4];
+                float actual  [4];
+                glare::Store4( expected, input.Fetch( x, y ) );
+                glare::Store4( actual,   decoded.Fetch( x, y ) );
+
+                auto first = 0;
+                auto last  = 4;
+                if (f == glare::MAP_FORMAT_A8)
+                { first = 3; }
+                else if (f == glare::MAP_FORMAT_L8)
+                {
+                    expected[0] = 0.2126f * expected[0] + 0.7152f * expected[1] + 0.0722f * expected[2];
+                    last = 1;
+                }
+                else if (f == glare::MAP_FORMAT_R9G9B9E5)
+                { last = 3; }
+
+                for(auto c=first; c<last; ++c)
+                {
+                    auto diff = fabsf( actual[c] - expected[c] );
+                    maxError  = std::max( maxError, diff );
+                    sumError += diff * diff;
+                    count++;
+                }
+            }
+        }
+
+        auto rms = ( count > 0 ) ? float( sqrt( sumError / count ) ) : 0.0f;
+        auto ok  = match && ( ( glare::IsBlockCompressed( glare::MAP_FORMAT(f) ) )
+            ? ( rms <= MAP_BC_RMS_TOLERANCE )
+            : ( maxError <= MAP_UNORM_TOLERANCE ) );
+
+        printf( "MapWriter : %-7s : layout = %s, max error = %f, rms = %f, %s\n",
+            names[f], ( match ) ? "yes" : "no", maxError, rms, ( ok ) ? "OK" : "NG" );
+        success &= ok;
+    }
+
+    remove( MAP_WRITE_PATH );
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      4K画像をミップ付きでMAPファイルに書き出す時間を計測します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkMapWriter( glare::ThreadPool& pool, int width, int height )
+{
+    glare::Image src;
+    if (!CreateSmoothImage( width, height, src ))
+    { return false; }
+
+    const glare::MAP_FORMAT formats[] = { glare::MAP_FORMAT_R8G8B8A8, glare::MAP_FORMAT_BC1, glare::MAP_FORMAT_BC3 };
+    const char*             names  [] = { "RGBA8", "BC1", "BC3" };
+
+    for(auto i=0; i<3; ++i)
+    {
+        for(auto f=0; f<glare::NUM_MIP_FILTER; ++f)
+        {
+            auto desc = glare::GetDefaultMapWriteDesc();
+            desc.Format    = formats[i];
+            desc.MipFilter = glare::MIP_FILTER(f);
+
+            double msec[2];
+            for(auto p=0; p<2; ++p)
+            {
+                auto begin = GetTimeMsec();
+                for(auto j=0; j<MAP_WRITE_COUNT; ++j)
+                {
+                    if (!glare::SaveMapFile( MAP_WRITE_PATH, &src, 1, desc, ( p == 0 ) ? nullptr : &pool ))
+                    {
+                        remove( MAP_WRITE_PATH );
+                        return false;
+                    }
+                }
+                msec[p] = ( GetTimeMsec() - begin ) / double(MAP_WRITE_COUNT);
+            }
+
+            printf( "MapWriter : %d x %d, %-5s, %-6s : single %9.3f msec, pool %9.3f msec (x%.2f)\n",
+                width, height, names[i], ( f == glare::MIP_FILTER_BOX ) ? "box" : "kaiser",
+                msec[0], msec[1], msec[0] / msec[1] );
+        }
+    }
+
+    remove( MAP_WRITE_PATH );
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      1.0を超える値を含むHDRのテスト画像を生成します.
+//-------------------------------------------------------------------------------------------
+bool CreateHdrImage( int width, int height, glare::Image& image )
+{
+    if (!CreateSmoothImage( width, height, image ))
+    { return false; }
+
+    // 指数的に明るくなる勾配に，中央の高輝度の光源を加える.
+    for(auto y=0; y<height; ++y)
+    {
+        auto pRow = image.GetRow( y );
+        for(auto x=0; x<width; ++x)
+        {
+            auto gain = powf( HDR_SCALE, float(x) / float(width - 1) );
+            auto dx   = float(x - width  / 2);
+            auto dy   = float(y - height / 2);
+            auto spot = ( dx * dx + dy * dy < 16.0f ) ? HDR_SCALE * 4.0f : 0.0f;
+            for(auto c=0; c<3; ++c)
+            { pRow[x * 4 + c] = pRow[x * 4 + c] * gain + spot; }
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      HDRのMAPファイル，半精度変換，光芒が1.0で飽和しないことを検証します.
+//-------------------------------------------------------------------------------------------
+bool ValidateHdr( glare::ThreadPool& pool )
+{
+    auto success = true;
+
+    // NaN 以外の全ての半精度浮動小数が往復で一致すること.
+    {
+        std::vector<uint16_t> halves( 65536 );
+        std::vector<float>    floats( 65536 );
+        std::vector<uint16_t> result( 65536 );
+        for(size_t i=0; i<halves.size(); ++i)
+        { halves[i] = uint16_t(i); }
+
+        glare::ConvertHalfToFloat( halves.data(), halves.size(), floats.data() );
+        glare::ConvertFloatToHalf( floats.data(), floats.size(), result.data() );
+
+        auto mismatch = 0;
+        for(size_t i=0; i<halves.size(); ++i)
+        {
+            auto isNaN = ( ( i & 0x7c00 ) == 0x7c00 ) && ( ( i & 0x03ff ) != 0 );
+            if (!isNaN && result[i] != halves[i])
+            { mismatch++; }
+        }
+
+        printf( "Hdr : half round trip : mismatch = %d, %s\n", mismatch, ( mismatch == 0 ) ? "OK" : "NG" );
+        success &= ( mismatch == 0 );
+    }
+
+    const int WIDTH  = 96;
+    const int HEIGHT = 64;
+
+    glare::Image src;
+    if (!CreateHdrImage( WIDTH, HEIGHT, src ))
+    { return false; }
+
+    // 浮動小数フォーマットのMAPファイルは1.0を超える値をミップまで保持すること.
+    const glare::MAP_FORMAT formats[] = { glare::MAP_FORMAT_R16G16B16A16_FLOAT, glare::MAP_FORMAT_R9G9B9E5 };
+    const char*             names  [] = { "RGBA16F", "RGB9E5" };
+    for(auto i=0; i<2; ++i)
+    {
+        auto desc = glare::GetDefaultMapWriteDesc();
+        desc.Format = formats[i];
+
+        glare::Image top;
+        glare::Image mip;
+        glare::Image expectedMip;
+        if (!glare::SaveMapFile( MAP_WRITE_PATH, &src, 1, desc, &pool )
+         || !glare::LoadMapFile( MAP_WRITE_PATH, top, 0 )
+         || !glare::LoadMapFile( MAP_WRITE_PATH, mip, 1 )
+         || !glare::GenerateMip( src, desc.MipFilter, expectedMip, &pool ))
+        {
+            printf( "Hdr : %-7s : SaveMapFile() / LoadMapFile() Failed.\n", names[i] );
+            success = false;
+            continue;
+        }
+
+        // 半精度は成分ごと，RGB9E5 は最大成分に対する相対誤差で比較する.
+        auto error = 0.0f;
+        auto peak  = 0.0f;
+        for(auto level=0; level<2; ++level)
+        {
+            auto& expected = ( level == 0 ) ? src : expectedMip;
+            auto& actual   = ( level == 0 ) ? top : mip;
+            for(auto y=0; y<expected.GetHeight(); ++y)
+            {
+                for(auto x=0; x<expected.GetWidth(); ++x)
+                {
+                    auto pE = expected.GetRow( y ) + x * 4;
+                    auto pA = actual  .GetRow( y ) + x * 4;
+                    auto maxE = std::max( pE[0], std::max( pE[1], pE[2] ) );
+                    for(auto c=0; c<3; ++c)
+                    {
+                        auto base = ( i == 0 ) ? std::max( fabsf( pE[c] ), 1e-3f ) : std::max( maxE, 1e-3f );
+                        error = std::max( error, fabsf( pA[c] - pE[c] ) / base );
+                        peak  = std::max( peak, pA[c] );
+                    }
+                }
+            }
+        }
+
+        auto tolerance = ( i == 0 ) ? HALF_TOLERANCE : RGB9E5_TOLERANCE;
+        auto ok = ( error <= tolerance ) && ( peak > 1.0f );
+        printf( "Hdr : %-7s : max relative error = %e, peak = %f, %s\n", names[i], error, peak, ( ok ) ? "OK" : "NG" );
+        success &= ok;
+    }
+    remove( MAP_WRITE_PATH );
+
+    // 半精度の作業バッファを経由した光芒は単精度の結果と一致し，8bitでは高輝度部が失われること.
+    {
+        glare::StarStreak star;
+        glare::Image      expected;
+        glare::Image      loaded;
+        glare::Image      result;
+        Buffer            half;
+        Buffer            half2;
+        Buffer            ldr;
+        half .Create( WIDTH, HEIGHT, glare::PIXEL_FORMAT_R16G16B16A16_FLOAT );
+        half2.Create( WIDTH, HEIGHT, glare::PIXEL_FORMAT_R16G16B16A16_FLOAT );
+        ldr  .Create( WIDTH, HEIGHT, glare::PIXEL_FORMAT_R8G8B8A8_SRGB );
+
+        auto param = glare::GetDefaultStarParam();
+        if (!star.Init( WIDTH, HEIGHT, &pool )
+         || !expected.Create( WIDTH, HEIGHT )
+         || !result.Create( WIDTH, HEIGHT )
+         || !star.Execute( src, param, expected ))
+        { return false; }
+
+        auto energy = [&]( glare::Image& image )
+        {
+            auto sum = 0.0;
+            for(auto y=0; y<HEIGHT; ++y)
+            {
+                for(auto x=0; x<WIDTH * 4; ++x)
+                { sum += ( ( x & 3 ) != 3 ) ? image.GetRow( y )[x] : 0.0f; }
+            }
+            return sum;
+        };
+
+        // 半精度.
+        if (!glare::StoreSurface( src, half.Surface, &pool )
+         || !glare::LoadSurface( half.Surface, loaded, &pool )
+         || !star.Execute( loaded, param, result )
+         || !glare::StoreSurface( result, half2.Surface, &pool )
+         || !glare::LoadSurface( half2.Surface, result, &pool ))
+        { return false; }
+
+        auto error = 0.0f;
+        for(auto y=0; y<HEIGHT; ++y)
+        {
+            for(auto x=0; x<WIDTH * 4; ++x)
+            {
+                auto a = expected.GetRow( y )[x];
+                auto b = result  .GetRow( y )[x];
+                error = std::max( error, fabsf( a - b ) / std::max( fabsf( a ), 1.0f ) );
+            }
+        }
+        auto halfEnergy = energy( result ) / energy( expected );
+
+        // 8bit sRGB.
+        if (!glare::StoreSurface( src, ldr.Surface, &pool )
+         || !glare::LoadSurface( ldr.Surface, loaded, &pool )
+         || !star.Execute( loaded, param, result ))
+        { return false; }
+        auto ldrEnergy = energy( result ) / energy( expected );
+
+        // 8bit の作業バッファで各パスが飽和する場合.
+        param.SaturatePass = true;
+        if (!star.Execute( loaded, param, result ))
+        { return false; }
+        auto unormEnergy = energy( result ) / energy( expected );
+
+        // 入力と出力の2回の丸めが光芒の各パスで足し合わされるので，許容誤差は広げる.
+        auto ok = ( error <= HALF_TOLERANCE * 4.0f );
+        printf( "Hdr : star : rgba16f max relative error = %e, energy rgba16f = %.4f, rgba8 srgb = %.4f, rgba8 srgb saturate = %.4f, %s\n",
+            error, halfEnergy, ldrEnergy, unormEnergy, ( ok ) ? "OK" : "NG" );
+        success &= ok;
+    }
+
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      半精度浮動小数の一括変換の速度を計測します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkHalfConvert( int width, int height )
+{
+    auto count = size_t(width) * size_t(height) * 4;
+    std::vector<float>    floats( count );
+    std::vector<uint16_t> halves( count );
+    for(size_t i=0; i<count; ++i)
+    { floats[i] = float( i % 4096 ) / 64.0f; }
+
+    double msec[2];
+    for(auto p=0; p<2; ++p)
+    {
+        auto begin = GetTimeMsec();
+        for(auto i=0; i<HALF_CONVERT_COUNT; ++i)
+        {
+            if (p == 0)
+            { glare::ConvertFloatToHalf( floats.data(), count, halves.data() ); }
+            else
+            { glare::ConvertHalfToFloat( halves.data(), count, floats.data() ); }
+        }
+        msec[p] = ( GetTimeMsec() - begin ) / double(HALF_CONVERT_COUNT);
+    }
+
+    // 読み書きの合計バイト数.
+    auto bytes = double( count ) * double( sizeof(float) + sizeof(uint16_t) );
+    printf( "HalfConvert : %d x %d, %s : f32 -> f16 %7.3f msec (%5.2f GB/s), f16 -> f32 %7.3f msec (%5.2f GB/s)\n",
+        width, height, glare::GetSimdIsaName( glare::GetBestSimdIsa() ),
+        msec[0], bytes / ( msec[0] * 1e6 ), msec[1], bytes / ( msec[1] * 1e6 ) );
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      常駐メモリ(peak が true の場合はピーク)をバイトで取得します. 取得できない環境では0を返却します.
+//-------------------------------------------------------------------------------------------
+size_t GetResidentBytes( bool peak )
+{
+    size_t result = 0;
+#if defined(__linux__)
+    FILE* pFile = fopen( "/proc/self/status", "r" );
+    if (pFile == nullptr)
+    { return 0; }
+
+    auto key = ( peak ) ? "VmHWM:" : "VmRSS:";
+    char line[256];
+    while(fgets( line, sizeof(line), pFile ) != nullptr)
+    {
+        if (strncmp( line, key, strlen( key ) ) == 0)
+        {
+            result = size_t( strtoull( line + strlen( key ), nullptr, 10 ) ) * 1024;
+            break;
+        }
+    }
+
+    fclose( pFile );
+#else
+    (void)peak;
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ピークの常駐メモリを現在の値に戻します.
+//-------------------------------------------------------------------------------------------
+void ResetPeakResident()
+{
+#if defined(__linux__)
+    FILE* pFile = fopen( "/proc/self/clear_refs", "w" );
+    if (pFile != nullptr)
+    {
+        fputs( "5", pFile );
+        fclose( pFile );
+    }
+#endif
+}
+
+//-------------------------------------------------------------------------------------------
+//      HDRのテスト画像を RGBA16F のMAPファイルに書き出します.
+//-------------------------------------------------------------------------------------------
+bool CreateHdrMapFile( const char* path, int width, int height, glare::ThreadPool& pool )
+{
+    glare::Image src;
+    if (!CreateHdrImage( width, height, src ))
+    { return false; }
+
+    auto desc = glare::GetDefaultMapWriteDesc();
+    desc.Format   = glare::MAP_FORMAT_R16G16B16A16_FLOAT;
+    desc.MipCount = 1;
+    return glare::SaveMapFile( path, &src, 1, desc, &pool );
+}
+
+//-------------------------------------------------------------------------------------------
+//      タイル単位のブルームがメモリ上の基準実装と一致することを検証します.
+//-------------------------------------------------------------------------------------------
+bool ValidateTiledBloom( glare::ThreadPool& pool )
+{
+    // 4 の倍数でないサイズで，端のタイルと端数の縮小を含める.
+    const int WIDTH  = 203;
+    const int HEIGHT = 141;
+
+    glare::Image src;
+    if (!CreateHdrMapFile( TILED_SOURCE_PATH, WIDTH, HEIGHT, pool )
+     || !glare::LoadMapFile( TILED_SOURCE_PATH, src ))
+    { return false; }
+
+    auto success = true;
+
+    const glare::MAP_FORMAT formats[] = { glare::MAP_FORMAT_R16G16B16A16_FLOAT, glare::MAP_FORMAT_R9G9B9E5 };
+    const char*             names  [] = { "RGBA16F", "RGB9E5" };
+    const size_t            budgets[] = { TILED_VALIDATE_BUDGET, TILED_BENCH_BUDGETS[2] };
+    for(auto i=0; i<2; ++i)
+    {
+        auto desc = glare::GetDefaultTiledBloomDesc();
+        desc.OutputFormat = formats[i];
+
+        glare::Image expected;
+        if (!glare::ApplyBloom( src, desc, expected, &pool ))
+        {
+            printf( "TiledBloom : ApplyBloom() Failed.\n" );
+            success = false;
+            continue;
+        }
+
+        for(auto b=0; b<2; ++b)
+        {
+            desc.MemoryBudget = budgets[b];
+
+            glare::TiledBloomStats stats;
+            glare::Image           actual;
+            if (!glare::ApplyBloomTiled( TILED_SOURCE_PATH, TILED_OUTPUT_PATH, desc, &pool, &stats )
+             || !glare::LoadMapFile( TILED_OUTPUT_PATH, actual ))
+            {
+                printf( "TiledBloom : %-7s : ApplyBloomTiled() Failed.\n", names[i] );
+                success = false;
+                continue;
+            }
+
+            // 出力フォーマットの量子化誤差の範囲で一致すること.
+            auto error = 0.0f;
+            for(auto y=0; y<HEIGHT; ++y)
+            {
+                for(auto x=0; x<WIDTH; ++x)
+                {
+                    auto pE = expected.GetRow( y ) + x * 4;
+                    auto pA = actual  .GetRow( y ) + x * 4;
+                    auto maxE = std::max( pE[0], std::max( pE[1], pE[2] ) );
+                    for(auto c=0; c<3; ++c)
+                    {
+                        auto base = ( i == 0 ) ? std::max( fabsf( pE[c] ), 1e-3f ) : std::max( maxE, 1e-3f );
+                        error = std::max( error, fabsf( pA[c] - pE[c] ) / base );
+                    }
+                }
+            }
+
+            auto tolerance = ( i == 0 ) ? HALF_TOLERANCE : RGB9E5_TOLERANCE;
+            auto ok = ( error <= tolerance );
+            printf( "TiledBloom : %d x %d, %-7s, tile = %4d, tiles = %4d : max relative error = %e, %s\n",
+                WIDTH, HEIGHT, names[i], stats.TileSize[0], stats.TileCount, error, ( ok ) ? "OK" : "NG" );
+            success &= ok;
+        }
+    }
+
+    // 作業メモリが足りない場合は失敗すること.
+    {
+        auto desc = glare::GetDefaultTiledBloomDesc();
+        desc.MemoryBudget = 1024;
+
+        auto ok = !glare::ApplyBloomTiled( TILED_SOURCE_PATH, TILED_OUTPUT_PATH, desc, &pool );
+        printf( "TiledBloom : budget = %d bytes : rejected, %s\n", int(desc.MemoryBudget), ( ok ) ? "OK" : "NG" );
+        success &= ok;
+    }
+
+    remove( TILED_SOURCE_PATH );
+    remove( TILED_OUTPUT_PATH );
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      作業メモリの上限ごとにタイル単位のブルームの速度とピーク常駐メモリを計測します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkTiledBloom( glare::ThreadPool& pool, int width, int height )
+{
+    if (!CreateHdrMapFile( TILED_SOURCE_PATH, width, height, pool ))
+    { return false; }
+
+    auto success = true;
+    auto count   = int(sizeof(TILED_BENCH_BUDGETS) / sizeof(TILED_BENCH_BUDGETS[0]));
+    for(auto i=0; i<count; ++i)
+    {
+        auto desc = glare::GetDefaultTiledBloomDesc();
+        desc.MemoryBudget = TILED_BENCH_BUDGETS[i];
+
+        // 入力ファイルのページキャッシュは常駐メモリに含まれないが，マップして触れたページは含まれる.
+        ResetPeakResident();
+        auto base = GetResidentBytes( false );
+
+        glare::TiledBloomStats stats;
+        auto begin = GetTimeMsec();
+        if (!glare::ApplyBloomTiled( TILED_SOURCE_PATH, TILED_OUTPUT_PATH, desc, &pool, &stats ))
+        {
+            success = false;
+            break;
+        }
+        auto msec = GetTimeMsec() - begin;
+        auto peak = GetResidentBytes( true );
+
+        printf( "TiledBloom : %d x %d, budget = %4d MB, tile = %4d / %4d, estimated = %7.2f MB, peak RSS = %7.2f MB (+%7.2f MB), %9.3f msec, %7.2f Mpixel/s\n",
+            width, height, int( desc.MemoryBudget >> 20 ), stats.TileSize[0], stats.TileSize[desc.LevelCount],
+            double(stats.WorkingSet) / ( 1024.0 * 1024.0 ),
+            double(peak) / ( 1024.0 * 1024.0 ), double( ( peak > base ) ? peak - base : 0 ) / ( 1024.0 * 1024.0 ),
+            msec, double(width) * double(height) / ( msec * 1e3 ) );
+    }
+
+    remove( TILED_SOURCE_PATH );
+    remove( TILED_OUTPUT_PATH );
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      光芒の描画を Star サンプルを書き下した実装と比較します.
+//-------------------------------------------------------------------------------------------
+bool ValidateStar( glare::ThreadPool& pool )
+{
+    auto w = VALIDATE_WIDTH;
+    auto h = VALIDATE_HEIGHT;
+
+    glare::Image src;
+    glare::Image expected;
+    glare::Image result;
+    if (!CreateTestImage( w, h, src )
+     || !expected.Create( w, h )
+     || !result.Create( w, h ))
+    { return false; }
+
+    glare::StarStreak star;
+    if (!star.Init( w, h, &pool ))
+    { return false; }
+
+    glare::StarParam params[7];
+    params[0] = glare::GetDefaultStarParam();
+
+    params[1] = params[0];
+    params[1].DirectionCount = 6;
+    params[1].Rotation       = 0.1f;
+    params[1].Attenuation    = 0.95f;
+
+    params[2] = params[0];
+    params[2].DirectionCount = glare::MAX_STAR_DIRECTION_COUNT;
+    params[2].PassCount      = glare::MAX_STAR_PASS_COUNT;
+
+    params[3] = params[0];
+    params[3].DownsampleFactor = 2;
+    params[3].Threshold        = 0.25f;
+
+    params[4] = params[1];
+    params[4].DownsampleFactor = glare::MAX_STAR_DOWNSAMPLE_FACTOR;
+
+    // UNORM の作業バッファを再現する場合.
+    params[5] = params[0];
+    params[5].SaturatePass = true;
+
+    params[6] = params[3];
+    params[6].SaturatePass = true;
+
+    auto success = true;
+    for(auto i=0; i<7; ++i)
+    {
+        if (!star.ExecuteReference( src, params[i], expected )
+         || !star.Execute( src, params[i], result ))
+        { return false; }
+
+        // 重みを正規化しないので値が大きくなる. 相対誤差で比較する.
+        auto error = 0.0f;
+        for(auto y=0; y<h; ++y)
+        {
+            for(auto x=0; x<w * 4; ++x)
+            {
+                auto a    = expected.GetRow( y )[x];
+                auto b    = result  .GetRow( y )[x];
+                auto diff = fabsf( a - b ) / std::max( fabsf( a ), 1.0f );
+                if (diff > error)
+                { error = diff; }
+            }
+        }
+
+        printf( "StarStreak : validate %2d directions, %d passes, 1/%d%s : max relative error = %e\n",
+            params[i].DirectionCount, params[i].PassCount, params[i].DownsampleFactor,
+            ( params[i].SaturatePass ) ? ", saturate" : "", error );
+
+        success &= ( error <= TOLERANCE );
+    }
+
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      縮小解像度で描画した光芒が等倍の光芒と同じ長さと明るさになるか比較します.
+//-------------------------------------------------------------------------------------------
+bool CompareStarDownsample( glare::ThreadPool& pool, int width, int height )
+{
+    // 光芒が画像の外に出ない位置に点光源を置く.
+    const int LIGHT_COUNT = 3;
+    const int lightX[LIGHT_COUNT] = { width * 5 / 16, width / 2, width * 11 / 16 + 1 };
+    const int lightY[LIGHT_COUNT] = { height * 7 / 16, height / 2 + 1, height * 9 / 16 };
+
+    glare::Image src;
+    glare::Image expected;
+    glare::Image result;
+    if (!src.Create( width, height )
+     || !expected.Create( width, height )
+     || !result.Create( width, height ))
+    { return false; }
+
+    src.Clear( 0.0f, 0.0f, 0.0f, 1.0f );
+    for(auto i=0; i<LIGHT_COUNT; ++i)
+    { src.Store( lightX[i], lightY[i], glare::Set4( 4.0f, 3.0f, 2.0f, 1.0f ) ); }
+
+    glare::StarStreak star;
+    if (!star.Init( width, height, &pool ))
+    { return false; }
+
+    auto param = glare::GetDefaultStarParam();
+    if (!star.Execute( src, param, expected ))
+    { return false; }
+
+    auto success = true;
+    auto count   = int(sizeof(STAR_DOWNSAMPLE_FACTORS) / sizeof(STAR_DOWNSAMPLE_FACTORS[0]));
+    for(auto i=1; i<count; ++i)
+    {
+        param.DownsampleFactor = STAR_DOWNSAMPLE_FACTORS[i];
+        if (!star.Execute( src, param, result ))
+        { return false; }
+
+        // 総エネルギーと，最も近い光源からの距離の平均(光芒の長さの目安).
+        double energy[2]   = {};
+        double distance[2] = {};
+        for(auto y=0; y<height; ++y)
+        {
+            for(auto x=0; x<width; ++x)
+            {
+                auto nearest = double(width + height);
+                for(auto j=0; j<LIGHT_COUNT; ++j)
+                { nearest = std::min( nearest, hypot( double(x - lightX[j]), double(y - lightY[j]) ) ); }
+
+                double value[2] = { expected.GetRow( y )[x * 4], result.GetRow( y )[x * 4] };
+                for(auto j=0; j<2; ++j)
+                {
+                    energy  [j] += value[j];
+                    distance[j] += value[j] * nearest;
+                }
+            }
+        }
+
+        auto energyError = float( fabs( energy[1] / energy[0] - 1.0 ) );
+        auto lengthError = float( fabs( ( distance[1] / energy[1] ) / ( distance[0] / energy[0] ) - 1.0 ) );
+
+        // 縮小による位置の丸めを許容するため，両方をぼかしてから比較する.
+        glare::BoxBlurParam blurParam;
+        if (!glare::CalcBoxBlurParam( 2.0f * float(param.DownsampleFactor), glare::DEFAULT_BOX_PASS_COUNT, blurParam )
+         || !glare::BoxGaussBlur( expected, blurParam, expected, &pool )
+         || !glare::BoxGaussBlur( result,   blurParam, result,   &pool ))
+        { return false; }
+
+        auto numerator   = 0.0;
+        auto denominator = 0.0;
+        for(auto y=0; y<height; ++y)
+        {
+            for(auto x=0; x<width * 4; ++x)
+            {
+                if (( x & 3 ) == 3)
+                { continue; }
+
+                auto a = double(expected.GetRow( y )[x]);
+                auto b = double(result  .GetRow( y )[x]);
+                numerator   += ( a - b ) * ( a - b );
+                denominator += a * a;
+            }
+        }
+        auto blurredError = float( sqrt( numerator / denominator ) );
+
+        printf( "StarStreak : 1/%d vs full : energy error = %e, length error = %e, blurred rms error = %e\n",
+            param.DownsampleFactor, energyError, lengthError, blurredError );
+
+        success &= ( energyError  <= STAR_ENERGY_TOLERANCE )
+                && ( lengthError  <= STAR_LENGTH_TOLERANCE )
+                && ( blurredError <= STAR_BLURRED_TOLERANCE );
+
+        // 次の比較のために等倍の結果を描き直す.
+        param.DownsampleFactor = 1;
+        if (!star.Execute( src, param, expected ))
+        { return false; }
+    }
+
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      光芒の本数と縮小率ごとに処理時間を計測します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkStar( glare::ThreadPool& pool, int width, int height )
+{
+    glare::Image src;
+    glare::Image result;
+    if (!CreateTestImage( width, height, src )
+     || !result.Create( width, height ))
+    { return false; }
+
+    glare::StarStreak star;
+    if (!star.Init( width, height, &pool ))
+    { return false; }
+
+    auto count       = int(sizeof(STAR_DIRECTION_COUNTS)   / sizeof(STAR_DIRECTION_COUNTS[0]));
+    auto factorCount = int(sizeof(STAR_DOWNSAMPLE_FACTORS) / sizeof(STAR_DOWNSAMPLE_FACTORS[0]));
+    for(auto i=0; i<count; ++i)
+    {
+        auto fullMsec = 0.0;
+        for(auto k=0; k<factorCount; ++k)
+        {
+            auto param = glare::GetDefaultStarParam();
+            param.DirectionCount   = STAR_DIRECTION_COUNTS[i];
+            param.DownsampleFactor = STAR_DOWNSAMPLE_FACTORS[k];
+
+            auto begin = GetTimeMsec();
+            for(auto j=0; j<BENCHMARK_COUNT; ++j)
+            {
+                if (!star.Execute( src, param, result ))
+                { return false; }
+            }
+            auto msec = ( GetTimeMsec() - begin ) / double(BENCHMARK_COUNT);
+
+            if (k == 0)
+            { fullMsec = msec; }
+
+            printf( "StarStreak : %d x %d, %2d directions, 1/%d : %8.3f msec (%6.3f msec / direction, x%5.2f)\n",
+                width, height, param.DirectionCount, param.DownsampleFactor,
+                msec, msec / double(param.DirectionCount), fullMsec / msec );
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------------
+//      タイル分割したブラーを SeparableBlur のスカラー実装と比較します.
+//-------------------------------------------------------------------------------------------
+bool ValidateTiledBlur( glare::ThreadPool& pool )
+{
+    // 端数のグループと，ハローが画像より大きい場合を含める.
+    const Resolution sizes[] = {
+        { VALIDATE_WIDTH, VALIDATE_HEIGHT },
+        { 301, 259 },
+    };
+
+    auto success = true;
+    for(auto s=0; s<2; ++s)
+    {
+        auto w = sizes[s].Width;
+        auto h = sizes[s].Height;
+
+        glare::Image src;
+        glare::Image temp;
+        glare::Image expected;
+        glare::Image result;
+        if (!CreateTestImage( w, h, src )
+         || !temp.Create( w, h )
+         || !expected.Create( w, h )
+         || !result.Create( w, h ))
+        { return false; }
+
+        glare::SeparableBlur blur;
+        if (!blur.Init( w, h, glare::SIMD_ISA_SCALAR ))
+        { return false; }
+
+        for(auto r=0; r<int(sizeof(TILED_BLUR_RADII) / sizeof(TILED_BLUR_RADII[0])); ++r)
+        {
+            auto radius    = TILED_BLUR_RADII[r];
+            auto deviation = float(radius) / 2.8f;
+
+            glare::BlurKernel kernelH;
+            glare::BlurKernel kernelV;
+            if (!glare::MakeGaussKernel( radius * 2 + 1, deviation, false, kernelH )
+             || !glare::MakeGaussKernel( radius * 2 + 1, deviation, true,  kernelV ))
+            { return false; }
+
+            if (!blur.Execute( glare::GetSurface( src ), kernelH, kernelV, glare::GetSurface( expected ) ))
+            { return false; }
+
+            glare::TiledBlurStats stats;
+            if (!glare::TiledBlur( src, kernelH, kernelV, temp, result, &stats, &pool ))
+            {
+                printf( "TiledBlur : %d x %d, radius %2d : TiledBlur() Failed.\n", w, h, radius );
+                success = false;
+                continue;
+            }
+
+            auto error = CalcMaxError( expected, result );
+            auto ok    = ( error <= TOLERANCE );
+            printf( "TiledBlur : validate %d x %d, radius %2d : groups = %5d, max error = %e, %s\n",
+                w, h, radius, int(stats.GroupCount), error, ( ok ) ? "OK" : "NG" );
+            success &= ok;
+        }
+    }
+
+    // 共有メモリに収まらない半径は失敗すること.
+    {
+        glare::Image src;
+        glare::Image dst;
+        glare::BlurKernel kernel = {};
+        kernel.Radius = glare::TILED_BLUR_MAX_RADIUS + 1;
+        if (!src.Create( 16, 16 ) || !dst.Create( 16, 16 ))
+        { return false; }
+
+        auto ok = !glare::TiledBlurPass( src, kernel, dst );
+        printf( "TiledBlur : radius %d : rejected, %s\n", kernel.Radius, ( ok ) ? "OK" : "NG" );
+        success &= ok;
+    }
+
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      半径ごとにテクスチャの読み込み回数と処理時間を SeparableBlur と比較します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkTiledBlur( glare::ThreadPool& pool, int width, int height )
+{
+    glare::Image src;
+    glare::Image temp;
+    glare::Image dst;
+    if (!CreateTestImage( width, height, src )
+     || !temp.Create( width, height )
+     || !dst.Create( width, height ))
+    { return false; }
+
+    glare::SeparableBlur blur;
+    if (!blur.Init( width, height ))
+    { return false; }
+
+    for(auto r=0; r<int(sizeof(TILED_BLUR_RADII) / sizeof(TILED_BLUR_RADII[0])); ++r)
+    {
+        auto radius = TILED_BLUR_RADII[r];
+
+        glare::BlurKernel kernelH;
+        glare::BlurKernel kernelV;
+        if (!glare::MakeGaussKernel( radius * 2 + 1, float(radius) / 2.8f, false, kernelH )
+         || !glare::MakeGaussKernel( radius * 2 + 1, float(radius) / 2.8f, true,  kernelV ))
+        { return false; }
+
+        glare::TiledBlurStats stats;
+        double msec[2];
+        for(auto t=0; t<2; ++t)
+        {
+            auto begin = GetTimeMsec();
+            for(auto j=0; j<BENCHMARK_COUNT; ++j)
+            {
+                if ( t == 0 )
+                { blur.Execute( glare::GetSurface( src ), kernelH, kernelV, glare::GetSurface( dst ), &pool ); }
+                else if (!glare::TiledBlur( src, kernelH, kernelV, temp, dst, &stats, &pool ))
+                { return false; }
+            }
+            msec[t] = ( GetTimeMsec() - begin ) / double(BENCHMARK_COUNT);
+        }
+
+        // ピクセルシェーダ版は全ピクセルが全タップをテクスチャから読み込む.
+        auto pixelFetches = double(width) * double(height) * double(radius * 2 + 1) * 2.0;
+        printf( "TiledBlur : %d x %d, radius %2d : texture fetches %8.2f M -> %6.2f M (x%5.1f less), SeparableBlur %8.3f msec, TiledBlur %8.3f msec\n",
+            width, height, radius,
+            pixelFetches * 1e-6, double(stats.TextureFetchCount) * 1e-6,
+            pixelFetches / double(stats.TextureFetchCount),
+            msec[0], msec[1] );
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      Downsample() を段数分繰り返して縮小バッファを生成します.
+//-------------------------------------------------------------------------------------------
+bool BuildPyramidSerial( const glare::Image& src, int factor, int levelCount, glare::Image* pLevels, glare::ThreadPool* pPool )
+{
+    for(auto l=0; l<levelCount; ++l)
+    {
+        if (!glare::Downsample( ( l == 0 ) ? src : pLevels[l - 1], ( l == 0 ) ? factor : 2, pLevels[l], pPool ))
+        { return false; }
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      1回の走査で作った縮小バッファを Downsample() の繰り返しと比較します.
+//-------------------------------------------------------------------------------------------
+bool ValidatePyramid( glare::ThreadPool& pool )
+{
+    // 端数のタイルと，途中の段で1に切り上がる場合を含める.
+    const Resolution sizes[] = {
+        { VALIDATE_WIDTH, VALIDATE_HEIGHT },
+        { 1000, 37 },
+        { RESOLUTIONS[0].Width, RESOLUTIONS[0].Height },
+    };
+
+    auto success = true;
+    for(auto s=0; s<int(sizeof(sizes) / sizeof(sizes[0])); ++s)
+    {
+        auto w = sizes[s].Width;
+        auto h = sizes[s].Height;
+
+        glare::Image src;
+        glare::Image expected[glare::MAX_PYRAMID_LEVEL_COUNT];
+        glare::Image result  [glare::MAX_PYRAMID_LEVEL_COUNT];
+        if (!CreateTestImage( w, h, src )
+         || !BuildPyramidSerial( src, PYRAMID_FACTOR, glare::MAX_PYRAMID_LEVEL_COUNT, expected, nullptr ))
+        { return false; }
+
+        if (!glare::BuildPyramid( src, PYRAMID_FACTOR, glare::MAX_PYRAMID_LEVEL_COUNT, result, &pool ))
+        {
+            printf( "Pyramid : %d x %d : BuildPyramid() Failed.\n", w, h );
+            success = false;
+            continue;
+        }
+
+        for(auto l=0; l<glare::MAX_PYRAMID_LEVEL_COUNT; ++l)
+        {
+            auto sizeOk = ( expected[l].GetWidth()  == result[l].GetWidth() )
+                       && ( expected[l].GetHeight() == result[l].GetHeight() );
+            auto error  = ( sizeOk ) ? CalcMaxError( expected[l], result[l] ) : 1.0f;
+            auto ok     = ( error == 0.0f );
+            printf( "Pyramid : validate %4d x %4d, level %d (%3d x %3d) : max error = %e, %s\n",
+                w, h, l, result[l].GetWidth(), result[l].GetHeight(), error, ( ok ) ? "OK" : "NG" );
+            success &= ok;
+        }
+    }
+
+    // 1タイルに収まらない段数は失敗すること.
+    {
+        glare::Image src;
+        glare::Image levels[glare::MAX_PYRAMID_LEVEL_COUNT + 1];
+        if (!src.Create( 64, 64 ))
+        { return false; }
+
+        auto ok = !glare::BuildPyramid( src, 2, glare::MAX_PYRAMID_LEVEL_COUNT + 1, levels );
+        printf( "Pyramid : level count %d : rejected, %s\n", glare::MAX_PYRAMID_LEVEL_COUNT + 1, ( ok ) ? "OK" : "NG" );
+        success &= ok;
+    }
+
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      縮小バッファの生成時間を Downsample() の繰り返しと比較します.
+//-------------------------------------------------------------------------------------------
+bool BenchmarkPyramid( glare::ThreadPool& pool, int width, int height )
+{
+    glare::Image src;
+    glare::Image levels[PYRAMID_LEVEL_COUNT];
+    if (!CreateTestImage( width, height, src ))
+    { return false; }
+
+    double msec[2];
+    for(auto t=0; t<2; ++t)
+    {
+        auto begin = GetTimeMsec();
+        for(auto j=0; j<BENCHMARK_COUNT; ++j)
+        {
+            auto ok = ( t == 0 )
+                ? BuildPyramidSerial( src, PYRAMID_FACTOR, PYRAMID_LEVEL_COUNT, levels, &pool )
+                : glare::BuildPyramid( src, PYRAMID_FACTOR, PYRAMID_LEVEL_COUNT, levels, &pool );
+            if (!ok)
+            { return false; }
+        }
+        msec[t] = ( GetTimeMsec() - begin ) / double(BENCHMARK_COUNT);
+    }
+
+    printf( "Pyramid : %d x %d, 1/%d, %d levels : passes %d -> 1, Downsample x %d %8.3f msec, BuildPyramid %8.3f msec (x%5.2f)\n",
+        width, height, PYRAMID_FACTOR, PYRAMID_LEVEL_COUNT, PYRAMID_LEVEL_COUNT, PYRAMID_LEVEL_COUNT,
+        msec[0], msec[1], msec[0] / msec[1] );
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    auto maskPath = ( argc > 1 ) ? argv[1] : DEFAULT_MASK_PATH;
+
+    glare::ThreadPool pool;
+    pool.Init();
+    printf( "Benchmark : threads = %d, best isa = %s\n",
+        pool.GetThreadCount(), glare::GetSimdIsaName( glare::GetBestSimdIsa() ) );
+
+    auto success = true;
+
+    for(auto i=0; i<glare::NUM_SIMD_ISA; ++i)
+    {
+        auto isa = glare::SIMD_ISA(i);
+        if (!glare::IsSimdIsaSupported( isa ))
+        { continue; }
+
+        success &= Validate( isa, 1 );
+        success &= Validate( isa, 4 );
+    }
+
+    // リニアサンプリングによるタップ数の削減.
+    if (!BenchmarkLinearTap( pool, RESOLUTIONS[0].Width / 4, RESOLUTIONS[0].Height / 4 ))
+    {
+        fprintf( stderr, "Error : BenchmarkLinearTap() Failed.\n" );
+        success = false;
+    }
+
+    // 標準偏差に依存しないブラー.
+    if (!BenchmarkBoxBlur( pool, RESOLUTIONS[0].Width, RESOLUTIONS[0].Height ))
+    {
+        fprintf( stderr, "Error : BenchmarkBoxBlur() Failed.\n" );
+        success = false;
+    }
+
+    // 周波数空間での畳み込み.
+    success &= ValidateFftBloom();
+    if (!BenchmarkFftBloom( pool, RESOLUTIONS[0].Width, RESOLUTIONS[0].Height, maskPath ))
+    {
+        fprintf( stderr, "Error : BenchmarkFftBloom() Failed.\n" );
+        success = false;
+    }
+
+    // MAPファイルの読み込み.
+    success &= BenchmarkMapView( maskPath );
+
+    // MAPファイルの書き出し.
+    success &= ValidateMapWriter( pool );
+    if (!BenchmarkMapWriter( pool, RESOLUTIONS[1].Width, RESOLUTIONS[1].Height ))
+    {
+        fprintf( stderr, "Error : BenchmarkMapWriter() Failed.\n" );
+        success = false;
+    }
+
+    // HDR.
+    success &= ValidateHdr( pool );
+    BenchmarkHalfConvert( RESOLUTIONS[1].Width, RESOLUTIONS[1].Height );
+
+    // 作業メモリを制限したタイル処理.
+    success &= ValidateTiledBloom( pool );
+    if (!BenchmarkTiledBloom( pool, TILED_BENCH_WIDTH, TILED_BENCH_HEIGHT ))
+    {
+        fprintf( stderr, "Error : BenchmarkTiledBloom() Failed.\n" );
+        success = false;
+    }
+
+    // 光芒.
+    success &= ValidateStar( pool );
+    success &= CompareStarDownsample( pool, RESOLUTIONS[0].Width / 2, RESOLUTIONS[0].Height / 2 );
+    if (!BenchmarkStar( pool, RESOLUTIONS[0].Width / 2, RESOLUTIONS[0].Height / 2 ))
+    {
+        fprintf( stderr, "Error : BenchmarkStar() Failed.\n" );
+        success = false;
+    }
+
+    // コンピュートシェーダのタイル分割.
+    success &= ValidateTiledBlur( pool );
+    if (!BenchmarkTiledBlur( pool, RESOLUTIONS[0].Width, RESOLUTIONS[0].Height ))
+    {
+        fprintf( stderr, "Error : BenchmarkTiledBlur() Failed.\n" );
+        success = false;
+    }
+
+    // 1回の走査での縮小バッファの生成.
+    success &= ValidatePyramid( pool );
+    for(auto i=0; i<int(sizeof(RESOLUTIONS) / sizeof(RESOLUTIONS[0])); ++i)
+    {
+        if (!BenchmarkPyramid( pool, RESOLUTIONS[i].Width, RESOLUTIONS[i].Height ))
+        {
+            fprintf( stderr, "Error : BenchmarkPyramid() Failed.\n" );
+            success = false;
+        }
+    }
+
+    auto count = int(sizeof(RESOLUTIONS) / sizeof(RESOLUTIONS[0]));
+    for(auto i=0; i<count; ++i)
+    {
+        if (!BenchmarkSeparableBlur( pool, RESOLUTIONS[i].Width, RESOLUTIONS[i].Height ))
+        {
+            fprintf( stderr, "Error : BenchmarkSeparableBlur() Failed.\n" );
+            success = false;
+        }
+    }
+
+    pool.Term();
+
+    return ( success ) ? 0 : -1;
+}
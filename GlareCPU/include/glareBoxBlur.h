@@ -0,0 +1,74 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareBoxBlur.h
+// Desc : Iterated Box Blur Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_BOX_BLUR_H__
+#define __GLARE_BOX_BLUR_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   MAX_BOX_PASS_COUNT      = 5;    //!< 箱型フィルタの最大反復回数です.
+const int   DEFAULT_BOX_PASS_COUNT  = 3;    //!< 箱型フィルタの既定の反復回数です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// BoxBlurParam structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct BoxBlurParam
+{
+    int     PassCount;                      //!< 反復回数です.
+    int     Radius[MAX_BOX_PASS_COUNT];     //!< 各反復の半径(テクセル)です.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      ガウス分布を近似する箱型フィルタの半径を計算します.
+//!
+//! @param [in]     deviation   標準偏差(テクセル)です.
+//! @param [in]     passCount   反復回数です. 1 以上 MAX_BOX_PASS_COUNT 以下を指定します.
+//! @param [out]    param       計算したパラメータです.
+//! @retval true    計算に成功.
+//! @retval false   引数が範囲外の場合は失敗.
+//! @note       奇数幅の箱を2種類組み合わせて，分散が最も近くなるようにします.
+//-------------------------------------------------------------------------------------------
+bool CalcBoxBlurParam( float deviation, int passCount, BoxBlurParam& param );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      箱型フィルタを反復した結果の標準偏差を求めます.
+//-------------------------------------------------------------------------------------------
+float GetBoxBlurDeviation( const BoxBlurParam& param );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      箱型フィルタを縦横に反復してガウスブラーを近似します.
+//!
+//! @param [in]     src         入力画像です.
+//! @param [in]     param       CalcBoxBlurParam() で求めたパラメータです.
+//! @param [out]    dst         出力画像です. 入力画像と同じサイズで生成済みである必要があります.
+//!                             入力画像と同じでも構いません.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    処理に成功.
+//! @retval false   サイズやパラメータが正しくない場合は失敗.
+//! @note       各反復は移動和で求めるので，1ピクセルあたりの処理量は半径に依存しません.
+//!             画像の外は入力画像をクランプした値として扱います. アルファも同じくブラーを掛けます.
+//!             横方向は行ごと，縦方向は列の帯ごとに独立して処理します.
+//!             MultipleGaussBlur の BoxBlurCS.hlsl は1グループに1ラインを割り当て，累積和の差で同じ箱を求めますが，
+//!             延長せずに反復ごとに端をクランプします. このため端から半径の合計以内のテクセルは一致しません
+//!             (1920 テクセルの乱数のラインで値域の最大 9% 程度). それより内側は float の累積和の丸め誤差
+//!             (値域の 1e-5 程度)の差になります.
+//-------------------------------------------------------------------------------------------
+bool BoxGaussBlur( const Image& src, const BoxBlurParam& param, Image& dst, ThreadPool* pPool = nullptr );
+
+} // namespace glare
+
+#endif//__GLARE_BOX_BLUR_H__
@@ -0,0 +1,47 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareCpuInfo.h
+// Desc : CPU Information Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_CPU_INFO_H__
+#define __GLARE_CPU_INFO_H__
+
+
+namespace glare {
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// SIMD_ISA enum
+/////////////////////////////////////////////////////////////////////////////////////////////
+enum SIMD_ISA
+{
+    SIMD_ISA_SCALAR = 0,        //!< SIMD命令を使いません.
+    SIMD_ISA_SSE2,              //!< SSE2です.
+    SIMD_ISA_AVX2,              //!< AVX2 + FMA3 + F16Cです.
+    SIMD_ISA_NEON,              //!< NEONです.
+    NUM_SIMD_ISA,
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      命令セットが実行環境で使えるかどうかを判定します.
+//!
+//! @param [in]     isa         判定する命令セットです.
+//! @retval true    ビルドに含まれており，CPUとOSが対応しています.
+//! @retval false   使えません.
+//-------------------------------------------------------------------------------------------
+bool IsSimdIsaSupported( SIMD_ISA isa );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      実行環境で使える最も高速な命令セットを取得します.
+//-------------------------------------------------------------------------------------------
+SIMD_ISA GetBestSimdIsa();
+
+//-------------------------------------------------------------------------------------------
+//! @brief      命令セットの名前を取得します.
+//-------------------------------------------------------------------------------------------
+const char* GetSimdIsaName( SIMD_ISA isa );
+
+} // namespace glare
+
+#endif//__GLARE_CPU_INFO_H__
@@ -0,0 +1,150 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareFftBloom.h
+// Desc : FFT Convolution Bloom Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_FFT_BLOOM_H__
+#define __GLARE_FFT_BLOOM_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <vector>
+
+
+namespace glare {
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// FftBloom class
+/////////////////////////////////////////////////////////////////////////////////////////////
+class FftBloom
+{
+    //=======================================================================================
+    // list of friend classes and methods.
+    //=======================================================================================
+    /* NOTHING */
+
+public:
+    //=======================================================================================
+    // public variables.
+    //=======================================================================================
+    /* NOTHING */
+
+    //=======================================================================================
+    // public methods.
+    //=======================================================================================
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------
+    FftBloom();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------
+    ~FftBloom();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      初期化処理です.
+    //!
+    //! @param [in]     width           画像の横幅です.
+    //! @param [in]     height          画像の縦幅です.
+    //! @param [in]     kernelWidth     カーネル画像の横幅です.
+    //! @param [in]     kernelHeight    カーネル画像の縦幅です.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //! @note       画像とカーネルが循環して重ならない最小の2の累乗サイズで変換します.
+    //---------------------------------------------------------------------------------------
+    bool Init( int width, int height, int kernelWidth, int kernelHeight );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      終了処理です.
+    //---------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      カーネルを設定し，スペクトルを計算して保持します.
+    //!
+    //! @param [in]     kernel      カーネル画像です. 中心は (width / 2, height / 2) です.
+    //! @param [in]     pPool       スレッドプールです.
+    //! @retval true    設定に成功.
+    //! @retval false   サイズが初期化時と異なる場合は失敗.
+    //! @note       カーネルのRGBをそのままチャンネルごとの重みとして畳み込みます(正規化は行いません).
+    //!             カーネルを変えない限り，フレームごとに呼び出す必要はありません.
+    //---------------------------------------------------------------------------------------
+    bool SetKernel( const Image& kernel, ThreadPool* pPool = nullptr );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      設定したカーネルを畳み込みます.
+    //!
+    //! @param [in]     src         入力画像です.
+    //! @param [out]    dst         出力画像です. 入力画像と同じサイズで生成済みである必要があります.
+    //!                             入力画像と同じでも構いません.
+    //! @param [in]     pPool       スレッドプールです.
+    //! @retval true    処理に成功.
+    //! @retval false   サイズが初期化時と異なる場合や，カーネルが未設定の場合は失敗.
+    //! @note       画像の外は0として扱います. 出力のアルファは1になります.
+    //---------------------------------------------------------------------------------------
+    bool Execute( const Image& src, Image& dst, ThreadPool* pPool = nullptr );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      変換に使う横幅を取得します.
+    //---------------------------------------------------------------------------------------
+    int GetFftWidth() const
+    { return m_FftWidth; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      変換に使う縦幅を取得します.
+    //---------------------------------------------------------------------------------------
+    int GetFftHeight() const
+    { return m_FftHeight; }
+
+private:
+    //=======================================================================================
+    // private variables.
+    //=======================================================================================
+    int                 m_Width;            //!< 画像の横幅です.
+    int                 m_Height;           //!< 画像の縦幅です.
+    int                 m_KernelWidth;      //!< カーネルの横幅です.
+    int                 m_KernelHeight;     //!< カーネルの縦幅です.
+    int                 m_FftWidth;         //!< 変換の横幅です.
+    int                 m_FftHeight;        //!< 変換の縦幅です.
+    bool                m_HasKernel;        //!< カーネルを設定済みかどうか.
+    std::vector<float>  m_RowTable;         //!< 行方向(横幅の半分)の複素FFTの回転因子です.
+    std::vector<float>  m_ColumnTable;      //!< 列方向の複素FFTの回転因子です.
+    std::vector<float>  m_RealTable;        //!< 実数FFTの分離に使う回転因子です.
+    std::vector<int>    m_RowReverse;       //!< 行方向のビット反転テーブルです.
+    std::vector<int>    m_ColumnReverse;    //!< 列方向のビット反転テーブルです.
+    std::vector<float>  m_Spectrum;         //!< 画像のスペクトル(行優先)です.
+    std::vector<float>  m_KernelSpectrum;   //!< カーネルのスペクトル(列優先)です.
+
+    //=======================================================================================
+    // private methods.
+    //=======================================================================================
+    FftBloom        ( const FftBloom& );    // アクセス禁止.
+    void operator = ( const FftBloom& );    // アクセス禁止.
+
+    void ForwardRows( const Image& image, bool wrap, ThreadPool* pPool );
+    void InverseRows( Image& image, ThreadPool* pPool );
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      絞りの形状から回折によるグレアのカーネルを生成します.
+//!
+//! @param [in]     aperture    絞りの透過率を赤チャンネルに持つ画像です(mask.map など).
+//! @param [in]     size        生成するカーネルの幅です. 2の累乗である必要があります.
+//! @param [out]    kernel      生成したカーネルです. チャンネルごとの和が1になるように正規化します.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    生成に成功.
+//! @retval false   生成に失敗.
+//! @note       フラウンホーファー回折として絞りのパワースペクトルを求めます.
+//!             RGBは波長 650nm, 550nm, 450nm に比例して広がりを変えます.
+//-------------------------------------------------------------------------------------------
+bool MakeDiffractionKernel( const Image& aperture, int size, Image& kernel, ThreadPool* pPool = nullptr );
+
+} // namespace glare
+
+#endif//__GLARE_FFT_BLOOM_H__
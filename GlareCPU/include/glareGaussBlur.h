@@ -0,0 +1,60 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareGaussBlur.h
+// Desc : Gauss Blur Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_GAUSS_BLUR_H__
+#define __GLARE_GAUSS_BLUR_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareMath.h>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   GAUSS_BLUR_TAP_COUNT = 15;      //!< GaussBlurPS.hlsl のタップ数です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// GaussBlurParam structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct GaussBlurParam
+{
+    Vector4     Offset[GAUSS_BLUR_TAP_COUNT];   //!< オフセット(xy)と重み(z)です.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      ブラーパラメータを計算します.
+//!
+//! @param [in]     width       オフセットの基準となる横幅です.
+//! @param [in]     height      オフセットの基準となる縦幅です.
+//! @param [in]     dir         ブラー方向です.
+//! @param [in]     deviation   標準偏差です.
+//! @param [in]     multiply    重みに掛ける係数です.
+//! @return     サンプルの CalcBlurParam() と同じレイアウトのパラメータを返却します.
+//-------------------------------------------------------------------------------------------
+GaussBlurParam CalcBlurParam( int width, int height, const Vector2& dir, float deviation, float multiply = 1.0f );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      GaussBlurPS.hlsl と同じ規則でブラーを掛けます.
+//!
+//! @param [in]     src         入力画像です.
+//! @param [in]     param       ブラーパラメータです.
+//! @param [out]    dst         出力画像です. 生成済みのサイズで描画します.
+//! @param [in]     pPool       スレッドプールです.
+//! @note       オフセットはテクスチャ座標単位で解釈し，リニアサンプラー(クランプ)でフェッチします.
+//!             出力のアルファは1.0になります.
+//-------------------------------------------------------------------------------------------
+void GaussBlur( const Image& src, const GaussBlurParam& param, Image& dst, ThreadPool* pPool = nullptr );
+
+} // namespace glare
+
+#endif//__GLARE_GAUSS_BLUR_H__
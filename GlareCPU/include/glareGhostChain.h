@@ -0,0 +1,96 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareGhostChain.h
+// Desc : Ghost Chain Compiler Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_GHOST_CHAIN_H__
+#define __GLARE_GHOST_CHAIN_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareMath.h>
+#include <vector>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Forward Declarations
+//-------------------------------------------------------------------------------------------
+struct LensGhostParam;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// GhostChainTerm structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct GhostChainTerm
+{
+    Vector4     InnerColor;         //!< 1段目の乗算カラー(xyz)です.
+    Vector4     OuterColor;         //!< 2段目の乗算カラー(xyz)です.
+    float       OuterScale;         //!< 2段目のテクスチャスケールです.
+    float       InnerScale;         //!< 1段目のテクスチャスケールです.
+    int         Group;              //!< 展開元の2段目のゴーストの番号です.
+    int         MinX;               //!< 寄与し得る画面範囲の左端(ピクセル, 含む)です.
+    int         MinY;               //!< 寄与し得る画面範囲の上端(ピクセル, 含む)です.
+    int         MaxX;               //!< 寄与し得る画面範囲の右端(ピクセル, 含む)です.
+    int         MaxY;               //!< 寄与し得る画面範囲の下端(ピクセル, 含む)です.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      2段のゴーストを1段分の項のリストに展開します.
+//!
+//! @param [in]     pRound0     1段目のゴーストパラメータです.
+//! @param [in]     count0      1段目のゴーストパラメータ数です.
+//! @param [in]     pRound1     2段目のゴーストパラメータです.
+//! @param [in]     count1      2段目のゴーストパラメータ数です.
+//! @param [in]     mask        マスク画像です(R成分を使用).
+//! @param [in]     width       出力画像の横幅です.
+//! @param [in]     height      出力画像の縦幅です.
+//! @param [in]     threshold   2段分の乗算カラーの積の最大成分がこの値未満の項を捨てます.
+//! @param [out]    terms       展開した項です. 同じ2段目のゴーストから展開した項は連続して並びます.
+//! @retval true    展開に成功.
+//! @retval false   展開に失敗.
+//! @note       各項はブラー済み画像(WorkBuffer[3])から直接評価できる形になります.
+//!             マスクが0になる範囲から各項の画面範囲を求め，画面外になる項も捨てます.
+//!             threshold が 0 より大きい場合は項を捨てる分だけ2パスの結果からずれる近似になります.
+//-------------------------------------------------------------------------------------------
+bool CompileGhostChain
+(
+    const LensGhostParam*           pRound0,
+    int                             count0,
+    const LensGhostParam*           pRound1,
+    int                             count1,
+    const Image&                    mask,
+    int                             width,
+    int                             height,
+    float                           threshold,
+    std::vector<GhostChainTerm>&    terms
+);
+
+//-------------------------------------------------------------------------------------------
+//! @brief      展開した項を加算合成してゴーストを描画します.
+//!
+//! @param [in]     src         ブラー済み画像です.
+//! @param [in]     mask        マスク画像です(R成分を使用).
+//! @param [in]     terms       CompileGhostChain() で展開した項です.
+//! @param [out]    dst         出力画像です. 生成済みのサイズで描画します.
+//! @param [in]     pPool       スレッドプールです.
+//! @note       1段目の描画結果(WorkBuffer[0])の飽和を再現するため，同じ2段目のゴーストから
+//!             展開した項の和を飽和させてから2段目の乗算カラーとマスクを掛けます.
+//-------------------------------------------------------------------------------------------
+void DrawGhostChain
+(
+    const Image&                        src,
+    const Image&                        mask,
+    const std::vector<GhostChainTerm>&  terms,
+    Image&                              dst,
+    ThreadPool*                         pPool = nullptr
+);
+
+} // namespace glare
+
+#endif//__GLARE_GHOST_CHAIN_H__
@@ -0,0 +1,265 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareImage.h
+// Desc : Image Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_IMAGE_H__
+#define __GLARE_IMAGE_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareSimd.h>
+#include <vector>
+#include <cmath>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Forward Declarations
+//-------------------------------------------------------------------------------------------
+class ThreadPool;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Image class
+/////////////////////////////////////////////////////////////////////////////////////////////
+class Image
+{
+    //=======================================================================================
+    // list of friend classes and methods.
+    //=======================================================================================
+    /* NOTHING */
+
+public:
+    //=======================================================================================
+    // public variables.
+    //=======================================================================================
+    /* NOTHING */
+
+    //=======================================================================================
+    // public methods.
+    //=======================================================================================
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------
+    Image();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------
+    ~Image();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      RGBA32F画像を生成します.
+    //!
+    //! @param [in]     width       横幅です.
+    //! @param [in]     height      縦幅です.
+    //! @retval true    生成に成功.
+    //! @retval false   生成に失敗.
+    //---------------------------------------------------------------------------------------
+    bool Create( int width, int height );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      メモリ解放処理です.
+    //---------------------------------------------------------------------------------------
+    void Release();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      全ピクセルを指定色で塗りつぶします.
+    //---------------------------------------------------------------------------------------
+    void Clear( float r, float g, float b, float a );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      横幅を取得します.
+    //---------------------------------------------------------------------------------------
+    int GetWidth() const
+    { return m_Width; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      縦幅を取得します.
+    //---------------------------------------------------------------------------------------
+    int GetHeight() const
+    { return m_Height; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      1行あたりのfloat数を取得します.
+    //---------------------------------------------------------------------------------------
+    int GetPitch() const
+    { return m_Width * 4; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ピクセルデータを取得します.
+    //---------------------------------------------------------------------------------------
+    float* GetPixels()
+    { return m_Pixels.data(); }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ピクセルデータを取得します.
+    //---------------------------------------------------------------------------------------
+    const float* GetPixels() const
+    { return m_Pixels.data(); }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      指定行の先頭ピクセルを取得します.
+    //---------------------------------------------------------------------------------------
+    float* GetRow( int y )
+    { return m_Pixels.data() + size_t(y) * size_t(m_Width) * 4; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      指定行の先頭ピクセルを取得します.
+    //---------------------------------------------------------------------------------------
+    const float* GetRow( int y ) const
+    { return m_Pixels.data() + size_t(y) * size_t(m_Width) * 4; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ピクセルを読み込みます.
+    //---------------------------------------------------------------------------------------
+    Float4 Fetch( int x, int y ) const
+    { return Load4( GetRow( y ) + x * 4 ); }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ピクセルを書き込みます.
+    //---------------------------------------------------------------------------------------
+    void Store( int x, int y, const Float4& value )
+    { Store4( GetRow( y ) + x * 4, value ); }
+
+private:
+    //=======================================================================================
+    // private variables.
+    //=======================================================================================
+    int                 m_Width;        //!< 横幅です.
+    int                 m_Height;       //!< 縦幅です.
+    std::vector<float>  m_Pixels;       //!< ピクセルデータ(RGBA32F)です.
+
+    //=======================================================================================
+    // private methods.
+    //=======================================================================================
+    Image           ( const Image& );   // アクセス禁止.
+    void operator = ( const Image& );   // アクセス禁止.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      リニアサンプラー(クランプ)でサンプリングします.
+//!
+//! @param [in]     image       サンプリングする画像です.
+//! @param [in]     u           テクスチャ座標です.
+//! @param [in]     v           テクスチャ座標です.
+//! @return     D3D11_FILTER_MIN_MAG_MIP_LINEAR + CLAMP と同じ規則でフィルタした値を返却します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 SampleLinearClamp( const Image& image, float u, float v )
+{
+    auto w = image.GetWidth();
+    auto h = image.GetHeight();
+
+    auto fx = u * float(w) - 0.5f;
+    auto fy = v * float(h) - 0.5f;
+    auto bx = floorf( fx );
+    auto by = floorf( fy );
+    auto tx = fx - bx;
+    auto ty = fy - by;
+
+    auto x0 = int(bx);
+    auto y0 = int(by);
+    auto x1 = x0 + 1;
+    auto y1 = y0 + 1;
+
+    x0 = ( x0 < 0 ) ? 0 : ( x0 >= w ) ? w - 1 : x0;
+    x1 = ( x1 < 0 ) ? 0 : ( x1 >= w ) ? w - 1 : x1;
+    y0 = ( y0 < 0 ) ? 0 : ( y0 >= h ) ? h - 1 : y0;
+    y1 = ( y1 < 0 ) ? 0 : ( y1 >= h ) ? h - 1 : y1;
+
+    auto top    = Lerp( image.Fetch( x0, y0 ), image.Fetch( x1, y0 ), Splat4( tx ) );
+    auto bottom = Lerp( image.Fetch( x0, y1 ), image.Fetch( x1, y1 ), Splat4( tx ) );
+    return Lerp( top, bottom, Splat4( ty ) );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// RowSampler structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct RowSampler
+{
+    const float*    pRow0;      //!< 上側の行です.
+    const float*    pRow1;      //!< 下側の行です.
+    Float4          Weight;     //!< 縦方向の補間係数です.
+    int             Width;      //!< 横幅です.
+    float           ScaleU;     //!< テクスチャ座標からテクセル座標への変換係数です.
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      縦方向のテクスチャ座標を固定して設定します.
+    //---------------------------------------------------------------------------------------
+    GLARE_INLINE void Setup( const Image& image, float v )
+    { Setup( image.GetPixels(), image.GetWidth(), image.GetHeight(), v ); }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      RGBA32Fの行が隙間なく並んだメモリに対して，縦方向のテクスチャ座標を固定して設定します.
+    //!
+    //! @note       メモリマップしたファイルなど，Image 以外に置いた画像をサンプリングする場合に使います.
+    //---------------------------------------------------------------------------------------
+    GLARE_INLINE void Setup( const float* pPixels, int width, int height, float v )
+    {
+        auto fy = v * float(height) - 0.5f;
+        auto y0 = GetRowIndex( height, v );
+        auto ty = fy - float(y0);
+        auto y1 = y0 + 1;
+        y0 = ( y0 < 0 ) ? 0 : ( y0 >= height ) ? height - 1 : y0;
+        y1 = ( y1 < 0 ) ? 0 : ( y1 >= height ) ? height - 1 : y1;
+
+        pRow0  = pPixels + size_t(y0) * size_t(width) * 4;
+        pRow1  = pPixels + size_t(y1) * size_t(width) * 4;
+        Weight = Splat4( ty );
+        Width  = width;
+        ScaleU = float(Width);
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      縦方向のテクスチャ座標から上側の行番号(クランプ前)を求めます.
+    //---------------------------------------------------------------------------------------
+    static GLARE_INLINE int GetRowIndex( int height, float v )
+    {
+        auto fy = v * float(height) - 0.5f;
+        auto y0 = int(fy);
+        if (fy < float(y0)) { y0--; }
+        return y0;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      設定した行でリニアサンプリングします.
+    //---------------------------------------------------------------------------------------
+    GLARE_INLINE Float4 Sample( float u ) const
+    {
+        auto fx = u * ScaleU - 0.5f;
+        auto x0 = int(fx);
+        if (fx < float(x0)) { x0--; }
+
+        auto tx = Splat4( fx - float(x0) );
+        auto x1 = x0 + 1;
+        x0 = ( x0 < 0 ) ? 0 : ( x0 >= Width ) ? Width - 1 : x0;
+        x1 = ( x1 < 0 ) ? 0 : ( x1 >= Width ) ? Width - 1 : x1;
+
+        auto top    = Lerp( Load4( pRow0 + x0 * 4 ), Load4( pRow0 + x1 * 4 ), tx );
+        auto bottom = Lerp( Load4( pRow1 + x0 * 4 ), Load4( pRow1 + x1 * 4 ), tx );
+        return Lerp( top, bottom, Weight );
+    }
+};
+
+//-------------------------------------------------------------------------------------------
+//! @brief      ボックスフィルタで縮小します.
+//!
+//! @param [in]     src         入力画像です.
+//! @param [in]     factor      縮小率です(2ならば1/2).
+//! @param [out]    dst         出力画像です.
+//! @param [in]     pPool       スレッドプールです(nullptrの場合は呼び出しスレッドで処理).
+//! @retval true    縮小に成功.
+//! @retval false   縮小に失敗.
+//! @note       factorが2の累乗の場合は2x2ボックスフィルタのミップを log2(factor) 段下げた結果と一致します.
+//-------------------------------------------------------------------------------------------
+bool Downsample( const Image& src, int factor, Image& dst, ThreadPool* pPool = nullptr );
+
+} // namespace glare
+
+#endif//__GLARE_IMAGE_H__
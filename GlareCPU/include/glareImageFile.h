@@ -0,0 +1,67 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareImageFile.h
+// Desc : Image File Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_IMAGE_FILE_H__
+#define __GLARE_IMAGE_FILE_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+
+
+namespace glare {
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// IMAGE_FILE_TYPE enum
+//////////////////////////////////////////////////////////////////////////////////////////////
+enum IMAGE_FILE_TYPE
+{
+    IMAGE_FILE_TYPE_UNKNOWN = -1,   //!< 対応していない形式です.
+    IMAGE_FILE_TYPE_MAP = 0,        //!< MAPファイル(.map)です.
+    IMAGE_FILE_TYPE_PPM,            //!< Portable Pixmap(.ppm, P6)です.
+    IMAGE_FILE_TYPE_PFM,            //!< Portable Float Map(.pfm)です.
+
+    NUM_IMAGE_FILE_TYPE             //!< 形式の数です.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      拡張子からファイル形式を判定します.
+//!
+//! @param [in]     filename    ファイル名です. 拡張子の大文字・小文字は区別しません.
+//! @return     ファイル形式を返却します.
+//-------------------------------------------------------------------------------------------
+IMAGE_FILE_TYPE GetImageFileType( const char* filename );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      画像ファイルを読み込み，RGBA32F画像にデコードします.
+//!
+//! @param [in]     filename    ファイル名です. 形式は拡張子で判定します.
+//! @param [out]    image       デコードした画像の格納先です.
+//! @retval true    読み込みに成功.
+//! @retval false   読み込みに失敗.
+//! @note       PPM は LoadMapFile() と同じく最大値で[0, 1]に正規化し，sRGBデコードは行いません.
+//!             PFM は値をそのまま読み込みます. アルファを持たない形式は1.0になります.
+//-------------------------------------------------------------------------------------------
+bool LoadImageFile( const char* filename, Image& image );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      RGBA32F画像を画像ファイルに書き出します.
+//!
+//! @param [in]     filename    ファイル名です. 形式は拡張子で判定します.
+//! @param [in]     image       書き出す画像です.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    書き出しに成功.
+//! @retval false   書き出しに失敗.
+//! @note       PPM は8bitに飽和させ，PFM はRGBをそのまま書き出します.
+//!             MAP は1.0を超える値を保持できるよう，ミップ無しの R16G16B16A16_FLOAT で書き出します.
+//-------------------------------------------------------------------------------------------
+bool SaveImageFile( const char* filename, const Image& image, ThreadPool* pPool = nullptr );
+
+} // namespace glare
+
+#endif//__GLARE_IMAGE_FILE_H__
@@ -0,0 +1,189 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareLensGhost.h
+// Desc : Lens Ghost Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_LENS_GHOST_H__
+#define __GLARE_LENS_GHOST_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareMath.h>
+#include <glareGhostChain.h>
+#include <vector>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   LENS_GHOST_ROUND_COUNT = 2;     //!< ゴースト生成の段数です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// LENS_GHOST_MODE enum
+/////////////////////////////////////////////////////////////////////////////////////////////
+enum LENS_GHOST_MODE
+{
+    LENS_GHOST_MODE_MULTI_PASS = 0,     //!< ゴースト1枚ごとに全画面を加算合成します(GPU版の従来パス相当).
+    LENS_GHOST_MODE_FUSED,              //!< 1ピクセルで全ゴーストを累積し，1回だけ書き込みます.
+    LENS_GHOST_MODE_CHAIN,              //!< 2段分のゴーストを展開し，ブラー済み画像から直接描画します.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// LensGhostParam structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct LensGhostParam
+{
+    Vector4     MultiplyColor;      //!< 乗算カラー(xyz)とテクスチャスケール(w)です.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// LensGhost class
+/////////////////////////////////////////////////////////////////////////////////////////////
+class LensGhost
+{
+    //=======================================================================================
+    // list of friend classes and methods.
+    //=======================================================================================
+    /* NOTHING */
+
+public:
+    //=======================================================================================
+    // public variables.
+    //=======================================================================================
+    /* NOTHING */
+
+    //=======================================================================================
+    // public methods.
+    //=======================================================================================
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------
+    LensGhost();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------
+    ~LensGhost();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      初期化処理です.
+    //!
+    //! @param [in]     width       出力画像の横幅です.
+    //! @param [in]     height      出力画像の縦幅です.
+    //! @param [in]     pPool       スレッドプールです(nullptrの場合は逐次実行).
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //! @note       ゴーストパラメータは LensGhost サンプルと同じ値で初期化されます.
+    //---------------------------------------------------------------------------------------
+    bool Init( int width, int height, ThreadPool* pPool );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      終了処理です.
+    //---------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ゴーストパラメータを設定します.
+    //!
+    //! @param [in]     round       ゴースト生成の段番号です.
+    //! @param [in]     pParams     パラメータです.
+    //! @param [in]     count       パラメータ数です.
+    //---------------------------------------------------------------------------------------
+    void SetGhostParams( int round, const LensGhostParam* pParams, int count );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ブラーの標準偏差を設定します.
+    //---------------------------------------------------------------------------------------
+    void SetDeviation( float deviation );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ゴーストの描画方法を設定します.
+    //!
+    //! @param [in]     mode        描画方法です. 既定値は LENS_GHOST_MODE_FUSED です.
+    //---------------------------------------------------------------------------------------
+    void SetMode( LENS_GHOST_MODE mode );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ゴーストの描画方法を取得します.
+    //---------------------------------------------------------------------------------------
+    LENS_GHOST_MODE GetMode() const;
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      LENS_GHOST_MODE_CHAIN で項を捨てる閾値を設定します.
+    //!
+    //! @param [in]     threshold   乗算カラーの積の最大成分がこの値未満の項を捨てます.
+    //! @note       既定値は 0 で，2パスの結果と中間バッファの再サンプリング分の誤差を除いて一致します.
+    //!             0 より大きい値は項を捨てる分だけ暗くなる近似です.
+    //---------------------------------------------------------------------------------------
+    void SetChainThreshold( float threshold );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      直前の LENS_GHOST_MODE_CHAIN の描画で評価した項数を取得します.
+    //---------------------------------------------------------------------------------------
+    int GetChainTermCount() const;
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      レンズゴーストを適用します.
+    //!
+    //! @param [in]     input       入力画像です.
+    //! @param [in]     mask        マスク画像です(R成分を使用).
+    //! @param [out]    output      出力画像です.
+    //! @note       行タイル単位でスレッドプールに分配し，SIMDで処理します.
+    //---------------------------------------------------------------------------------------
+    void Execute( const Image& input, const Image& mask, Image& output );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      検証用のスカラー実装でレンズゴーストを適用します.
+    //!
+    //! @param [in]     input       入力画像です.
+    //! @param [in]     mask        マスク画像です(R成分を使用).
+    //! @param [out]    output      出力画像です.
+    //! @note       シェーダをそのまま書き下した単一スレッドの実装です.
+    //---------------------------------------------------------------------------------------
+    void ExecuteReference( const Image& input, const Image& mask, Image& output );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      作業バッファを取得します.
+    //!
+    //! @param [in]     index       LensGhost サンプルの m_WorkBuffer と同じ番号です.
+    //---------------------------------------------------------------------------------------
+    const Image& GetWorkBuffer( int index ) const;
+
+private:
+    //=======================================================================================
+    // private variables.
+    //=======================================================================================
+    ThreadPool*                     m_pPool;                                //!< スレッドプールです.
+    int                             m_Width;                                //!< 出力画像の横幅です.
+    int                             m_Height;                               //!< 出力画像の縦幅です.
+    float                           m_Deviation;                            //!< ブラーの標準偏差です.
+    LENS_GHOST_MODE                 m_Mode;                                 //!< ゴーストの描画方法です.
+    float                           m_ChainThreshold;                       //!< 展開した項を捨てる閾値です.
+    std::vector<GhostChainTerm>     m_ChainTerms;                           //!< 展開した項です.
+    Image                           m_Downsample;                           //!< 1/4縮小した入力画像です.
+    Image                           m_WorkBuffer[4];                        //!< 作業バッファです.
+    std::vector<LensGhostParam>     m_Ghosts[LENS_GHOST_ROUND_COUNT];       //!< ゴーストパラメータです.
+
+    //=======================================================================================
+    // private methods.
+    //=======================================================================================
+    LensGhost       ( const LensGhost& );   // アクセス禁止.
+    void operator = ( const LensGhost& );   // アクセス禁止.
+
+    void DrawGhosts( const Image& src, const Image& mask, const std::vector<LensGhostParam>& ghosts, Image& dst );
+    void DrawGhostsMultiPass( const Image& src, const Image& mask, const std::vector<LensGhostParam>& ghosts, Image& dst );
+    void DrawGhostsFused( const Image& src, const Image& mask, const std::vector<LensGhostParam>& ghosts, Image& dst );
+};
+
+} // namespace glare
+
+#endif//__GLARE_LENS_GHOST_H__
@@ -0,0 +1,85 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareLinearTap.h
+// Desc : Linear Sampling Tap Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_LINEAR_TAP_H__
+#define __GLARE_LINEAR_TAP_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareSeparableBlur.h>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   MAX_TAP_TABLE_SIZE       = MAX_BLUR_RADIUS * 2 + 1;    //!< タップテーブルの最大エントリ数です.
+const int   LINEAR_TAP_VARIANT_COUNT = 5;                          //!< シェーダバリエーション数です.
+
+// GaussBlurLinear*PS.hlsl のタップ数(統合前の整数タップ数)です.
+const int   LINEAR_TAP_VARIANTS[LINEAR_TAP_VARIANT_COUNT] = { 7, 9, 15, 31, 63 };
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// TapTable structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct TapTable
+{
+    int         Count;                          //!< 有効なエントリ数(フェッチ数)です.
+    Vector4     Offset[MAX_TAP_TABLE_SIZE];     //!< オフセット(xy)と重み(z)です. GaussBlurParam と同じレイアウトです.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      整数タップ数に対応するリニアサンプリングのフェッチ数を取得します.
+//!
+//! @param [in]     tapCount    整数タップ数(奇数)です.
+//! @return     中心は単独，両側は隣り合う2タップを1フェッチにまとめた数を返却します.
+//-------------------------------------------------------------------------------------------
+int GetLinearFetchCount( int tapCount );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      カーネルを1タップ1フェッチのテーブルに変換します.
+//!
+//! @param [in]     kernel      カーネルです.
+//! @param [in]     width       フェッチするテクスチャの横幅です.
+//! @param [in]     height      フェッチするテクスチャの縦幅です.
+//! @param [out]    table       変換したテーブルです. 重みが0のタップは含みません.
+//! @retval true    変換に成功.
+//! @retval false   変換に失敗.
+//-------------------------------------------------------------------------------------------
+bool MakeIntegerTapTable( const BlurKernel& kernel, int width, int height, TapTable& table );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      隣り合うタップをリニアサンプリングの1フェッチにまとめたテーブルに変換します.
+//!
+//! @param [in]     kernel      カーネルです.
+//! @param [in]     width       フェッチするテクスチャの横幅です.
+//! @param [in]     height      フェッチするテクスチャの縦幅です.
+//! @param [out]    table       変換したテーブルです.
+//! @retval true    変換に成功.
+//! @retval false   変換に失敗.
+//! @note       中心から外側に向かって (1, 2), (3, 4), ... の組を重み付きの位置の1フェッチにします.
+//!             重みの符号が異なる組はまとめられないので，2フェッチのまま出力します.
+//-------------------------------------------------------------------------------------------
+bool MakeLinearTapTable( const BlurKernel& kernel, int width, int height, TapTable& table );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      タップテーブルでブラーを掛けます.
+//!
+//! @param [in]     src         入力画像です.
+//! @param [in]     table       タップテーブルです.
+//! @param [out]    dst         出力画像です. 生成済みのサイズで描画します.
+//! @param [in]     pPool       スレッドプールです.
+//! @note       GaussBlurLinear*PS.hlsl と同じ規則で描画します. 出力のアルファは1.0になります.
+//-------------------------------------------------------------------------------------------
+void TapBlur( const Image& src, const TapTable& table, Image& dst, ThreadPool* pPool = nullptr );
+
+} // namespace glare
+
+#endif//__GLARE_LINEAR_TAP_H__
@@ -0,0 +1,45 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareMapFile.h
+// Desc : MAP File Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_MAP_FILE_H__
+#define __GLARE_MAP_FILE_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareMapView.h>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//! @brief      MAPファイルを読み込み，RGBA32F画像にデコードします.
+//!
+//! @param [in]     filename    ファイル名です.
+//! @param [out]    image       デコードした画像の格納先です.
+//! @param [in]     mipLevel    読み込むミップレベルです.
+//! @retval true    読み込みに成功.
+//! @retval false   読み込みに失敗.
+//! @note       テクセル値はUNORMとしてそのまま[0, 1]に正規化します(sRGBデコードは行いません).
+//!             浮動小数フォーマットは値をそのまま展開するので，1.0を超える値も保持されます.
+//!             ファイルはメモリにマップし，目的のミップレベルだけを直接デコードします.
+//-------------------------------------------------------------------------------------------
+bool LoadMapFile( const char* filename, Image& image, int mipLevel = 0 );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      MAPファイルのサーフェイスをRGBA32F画像にデコードします.
+//!
+//! @param [in]     surface     デコードするサーフェイスです.
+//! @param [out]    image       デコードした画像の格納先です.
+//! @retval true    デコードに成功.
+//! @retval false   フォーマットが正しくない場合は失敗.
+//-------------------------------------------------------------------------------------------
+bool DecodeMapSurface( const MapSurface& surface, Image& image );
+
+} // namespace glare
+
+#endif//__GLARE_MAP_FILE_H__
@@ -0,0 +1,482 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareMapView.h
+// Desc : Memory Mapped MAP File View Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_MAP_VIEW_H__
+#define __GLARE_MAP_VIEW_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif//WIN32_LEAN_AND_MEAN
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif//NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+namespace glare {
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// MAP_FORMAT enum
+//////////////////////////////////////////////////////////////////////////////////////////////
+enum MAP_FORMAT
+{
+    MAP_FORMAT_INVALID = -1,    //!< 無効なフォーマットです.
+    MAP_FORMAT_A8 = 0,          //!< A8 フォーマットです.
+    MAP_FORMAT_L8,              //!< L8 フォーマットです.
+    MAP_FORMAT_R8G8B8A8,        //!< RGBA(8,8,8,8) フォーマットです.
+    MAP_FORMAT_BC1,             //!< BC1フォーマットです.
+    MAP_FORMAT_BC2,             //!< BC2フォーマットです.
+    MAP_FORMAT_BC3,             //!< BC3フォーマットです.
+    MAP_FORMAT_R16G16B16A16_FLOAT,  //!< RGBA(16,16,16,16) 半精度浮動小数フォーマットです.
+    MAP_FORMAT_R9G9B9E5,        //!< RGB(9,9,9) 共有指数(5) フォーマットです. アルファは持ちません.
+
+    NUM_MAP_FORMAT              //!< フォーマット数です.
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// MAP_FILE_HEADER structure
+//////////////////////////////////////////////////////////////////////////////////////////////
+struct MAP_FILE_HEADER
+{
+    uint8_t     Magic[4];       //!< マジック("MAP\0")です.
+    uint32_t    Version;        //!< バージョンです.
+    uint32_t    HeaderSize;     //!< このヘッダのサイズです.
+    uint32_t    Width;          //!< 横幅です.
+    uint32_t    Height;         //!< 縦幅です.
+    uint32_t    Depth;          //!< 奥行です.
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// MAP_TEXTURE_INFO structure
+//////////////////////////////////////////////////////////////////////////////////////////////
+struct MAP_TEXTURE_INFO
+{
+    uint32_t    Format;         //!< フォーマットです.
+    uint32_t    MipCount;       //!< ミップレベル数です.
+    uint32_t    SurfaceCount;   //!< サーフェイス数です.
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// MAP_SURFACE_INFO structure
+//////////////////////////////////////////////////////////////////////////////////////////////
+struct MAP_SURFACE_INFO
+{
+    uint32_t    Width;          //!< 横幅です.
+    uint32_t    Height;         //!< 縦幅です.
+    uint32_t    Pitch;          //!< 1行(ブロック圧縮の場合はブロック行)あたりのバイト数です.
+    uint32_t    SlicePitch;     //!< データサイズです.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      フォーマットがブロック圧縮かどうか判定します.
+//-------------------------------------------------------------------------------------------
+inline bool IsBlockCompressed( MAP_FORMAT format )
+{ return format == MAP_FORMAT_BC1 || format == MAP_FORMAT_BC2 || format == MAP_FORMAT_BC3; }
+
+//-------------------------------------------------------------------------------------------
+//! @brief      フォーマットが浮動小数(HDR)かどうか判定します.
+//-------------------------------------------------------------------------------------------
+inline bool IsFloatFormat( MAP_FORMAT format )
+{ return format == MAP_FORMAT_R16G16B16A16_FLOAT || format == MAP_FORMAT_R9G9B9E5; }
+
+//-------------------------------------------------------------------------------------------
+//! @brief      1要素(ブロック圧縮の場合は4x4ブロック)あたりのバイト数を取得します.
+//-------------------------------------------------------------------------------------------
+inline uint32_t GetMapElementSize( MAP_FORMAT format )
+{
+    switch(format)
+    {
+    case MAP_FORMAT_A8:
+    case MAP_FORMAT_L8:
+        return 1;
+
+    case MAP_FORMAT_R8G8B8A8:
+    case MAP_FORMAT_R9G9B9E5:
+        return 4;
+
+    case MAP_FORMAT_R16G16B16A16_FLOAT:
+        return 8;
+
+    case MAP_FORMAT_BC1:
+        return 8;
+
+    case MAP_FORMAT_BC2:
+    case MAP_FORMAT_BC3:
+        return 16;
+
+    default:
+        return 0;
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// MapSurface structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct MapSurface
+{
+    const uint8_t*  pData;          //!< ファイル上のテクセルデータの先頭です.
+    uint32_t        Width;          //!< 横幅です.
+    uint32_t        Height;         //!< 縦幅です.
+    uint32_t        Pitch;          //!< 1行(ブロック圧縮の場合はブロック行)あたりのバイト数です.
+    uint32_t        SlicePitch;     //!< データサイズです.
+    MAP_FORMAT      Format;         //!< フォーマットです.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// MapView class
+/////////////////////////////////////////////////////////////////////////////////////////////
+class MapView
+{
+    //=======================================================================================
+    // list of friend classes and methods.
+    //=======================================================================================
+    /* NOTHING */
+
+public:
+    //=======================================================================================
+    // public variables.
+    //=======================================================================================
+    /* NOTHING */
+
+    //=======================================================================================
+    // public methods.
+    //=======================================================================================
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------
+    MapView()
+    : m_pData       ( nullptr )
+    , m_Size        ( 0 )
+    , m_Mapped      ( false )
+    , m_Format      ( MAP_FORMAT_INVALID )
+    , m_Width       ( 0 )
+    , m_Height      ( 0 )
+    , m_Depth       ( 0 )
+    , m_MipCount    ( 0 )
+    , m_SurfaceCount( 0 )
+    , m_Offsets     ()
+    { /* DO_NOTHING */ }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------
+    ~MapView()
+    { Close(); }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      MAPファイルをメモリにマップして開きます.
+    //!
+    //! @param [in]     filename    ファイル名です.
+    //! @retval true    オープンに成功.
+    //! @retval false   ファイルが開けない場合や，ヘッダが正しくない場合は失敗.
+    //! @note       テクセルデータは読み込まず，アクセスしたページだけがOSによって読み込まれます.
+    //---------------------------------------------------------------------------------------
+    bool Open( const char* filename )
+    {
+        Close();
+
+        if (filename == nullptr)
+        { return false; }
+
+        const void* pData = nullptr;
+        size_t      size  = 0;
+
+    #if defined(_WIN32)
+        auto hFile = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+        if (hFile == INVALID_HANDLE_VALUE)
+        { return false; }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx( hFile, &fileSize ) || fileSize.QuadPart <= 0)
+        {
+            CloseHandle( hFile );
+            return false;
+        }
+
+        // ビューがマッピングを参照し続けるので，ハンドルはすぐに閉じてよい.
+        auto hMapping = CreateFileMappingA( hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        CloseHandle( hFile );
+        if (hMapping == nullptr)
+        { return false; }
+
+        pData = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+        CloseHandle( hMapping );
+        if (pData == nullptr)
+        { return false; }
+
+        size = size_t(fileSize.QuadPart);
+    #else
+        auto fd = open( filename, O_RDONLY );
+        if (fd < 0)
+        { return false; }
+
+        struct stat st;
+        if (fstat( fd, &st ) != 0 || st.st_size <= 0)
+        {
+            close( fd );
+            return false;
+        }
+
+        // マップは記述子を閉じても有効.
+        auto pMapped = mmap( nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0 );
+        close( fd );
+        if (pMapped == MAP_FAILED)
+        { return false; }
+
+        pData = pMapped;
+        size  = size_t(st.st_size);
+    #endif
+
+        m_pData  = static_cast<const uint8_t*>(pData);
+        m_Size   = size;
+        m_Mapped = true;
+
+        if (!Parse())
+        {
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      メモリ上のMAPファイルを開きます.
+    //!
+    //! @param [in]     pData       ファイルの内容です. 閉じるまで有効である必要があります.
+    //! @param [in]     size        ファイルのバイトサイズです.
+    //! @retval true    オープンに成功.
+    //! @retval false   ヘッダが正しくない場合は失敗.
+    //---------------------------------------------------------------------------------------
+    bool Attach( const void* pData, size_t size )
+    {
+        Close();
+
+        if (pData == nullptr || size == 0)
+        { return false; }
+
+        m_pData = static_cast<const uint8_t*>(pData);
+        m_Size  = size;
+
+        if (!Parse())
+        {
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ファイルを閉じます. 取得済みのサーフェイスは無効になります.
+    //---------------------------------------------------------------------------------------
+    void Close()
+    {
+        if (m_Mapped && m_pData != nullptr)
+        {
+        #if defined(_WIN32)
+            UnmapViewOfFile( m_pData );
+        #else
+            munmap( const_cast<uint8_t*>(m_pData), m_Size );
+        #endif
+        }
+
+        m_pData         = nullptr;
+        m_Size          = 0;
+        m_Mapped        = false;
+        m_Format        = MAP_FORMAT_INVALID;
+        m_Width         = 0;
+        m_Height        = 0;
+        m_Depth         = 0;
+        m_MipCount      = 0;
+        m_SurfaceCount  = 0;
+        m_Offsets.clear();
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      サーフェイスを取得します.
+    //!
+    //! @param [in]     surface     サーフェイス番号です.
+    //! @param [in]     mipLevel    ミップレベルです.
+    //! @param [out]    result      ファイル上のデータを直接指すサーフェイスです.
+    //! @retval true    取得に成功.
+    //! @retval false   番号が範囲外の場合は失敗.
+    //---------------------------------------------------------------------------------------
+    bool GetSurface( int surface, int mipLevel, MapSurface& result ) const
+    {
+        if (surface < 0 || uint32_t(surface) >= m_SurfaceCount
+         || mipLevel < 0 || uint32_t(mipLevel) >= m_MipCount)
+        { return false; }
+
+        auto offset = m_Offsets[size_t(surface) * m_MipCount + size_t(mipLevel)];
+
+        MAP_SURFACE_INFO info;
+        memcpy( &info, m_pData + offset, sizeof(info) );
+
+        result.pData      = m_pData + offset + sizeof(info);
+        result.Width      = info.Width;
+        result.Height     = info.Height;
+        result.Pitch      = info.Pitch;
+        result.SlicePitch = info.SlicePitch;
+        result.Format     = m_Format;
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      開いているかどうか判定します.
+    //---------------------------------------------------------------------------------------
+    bool IsOpen() const
+    { return m_pData != nullptr; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      フォーマットを取得します.
+    //---------------------------------------------------------------------------------------
+    MAP_FORMAT GetFormat() const
+    { return m_Format; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      横幅を取得します.
+    //---------------------------------------------------------------------------------------
+    uint32_t GetWidth() const
+    { return m_Width; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      縦幅を取得します.
+    //---------------------------------------------------------------------------------------
+    uint32_t GetHeight() const
+    { return m_Height; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      奥行を取得します.
+    //---------------------------------------------------------------------------------------
+    uint32_t GetDepth() const
+    { return m_Depth; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ミップレベル数を取得します.
+    //---------------------------------------------------------------------------------------
+    uint32_t GetMipCount() const
+    { return m_MipCount; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      サーフェイス数を取得します.
+    //---------------------------------------------------------------------------------------
+    uint32_t GetSurfaceCount() const
+    { return m_SurfaceCount; }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ファイルのバイトサイズを取得します.
+    //---------------------------------------------------------------------------------------
+    size_t GetSize() const
+    { return m_Size; }
+
+private:
+    //=======================================================================================
+    // private variables.
+    //=======================================================================================
+    const uint8_t*      m_pData;            //!< ファイルの先頭です.
+    size_t              m_Size;             //!< ファイルのバイトサイズです.
+    bool                m_Mapped;           //!< 自身でマップしたかどうか.
+    MAP_FORMAT          m_Format;           //!< フォーマットです.
+    uint32_t            m_Width;            //!< 横幅です.
+    uint32_t            m_Height;           //!< 縦幅です.
+    uint32_t            m_Depth;            //!< 奥行です.
+    uint32_t            m_MipCount;         //!< ミップレベル数です.
+    uint32_t            m_SurfaceCount;     //!< サーフェイス数です.
+    std::vector<size_t> m_Offsets;          //!< サーフェイス情報のファイル上の位置です(サーフェイス x ミップ).
+
+    //=======================================================================================
+    // private methods.
+    //=======================================================================================
+    MapView         ( const MapView& );     // アクセス禁止.
+    void operator = ( const MapView& );     // アクセス禁止.
+
+    //---------------------------------------------------------------------------------------
+    //      ヘッダを検証し，各サーフェイスの位置を記録します.
+    //---------------------------------------------------------------------------------------
+    bool Parse()
+    {
+        MAP_FILE_HEADER  header;
+        MAP_TEXTURE_INFO texInfo;
+        if (m_Size < sizeof(header) + sizeof(texInfo))
+        { return false; }
+
+        memcpy( &header,  m_pData,                  sizeof(header) );
+        memcpy( &texInfo, m_pData + sizeof(header), sizeof(texInfo) );
+
+        if (memcmp( header.Magic, "MAP\0", 4 ) != 0
+         || header.HeaderSize != sizeof(MAP_FILE_HEADER)
+         || texInfo.Format >= uint32_t(NUM_MAP_FORMAT)
+         || texInfo.MipCount == 0
+         || texInfo.SurfaceCount == 0)
+        { return false; }
+
+        auto format      = MAP_FORMAT(texInfo.Format);
+        auto elementSize = GetMapElementSize( format );
+        auto compressed  = IsBlockCompressed( format );
+
+        // サーフェイスごとに全ミップが続くので，先頭から辿って範囲を検証する.
+        auto count = size_t(texInfo.SurfaceCount) * texInfo.MipCount;
+        if (count > ( m_Size - sizeof(header) - sizeof(texInfo) ) / sizeof(MAP_SURFACE_INFO))
+        { return false; }
+
+        m_Offsets.resize( count );
+
+        auto offset = sizeof(header) + sizeof(texInfo);
+        for(size_t i=0; i<count; ++i)
+        {
+            MAP_SURFACE_INFO info;
+            if (m_Size - offset < sizeof(info))
+            { return false; }
+
+            memcpy( &info, m_pData + offset, sizeof(info) );
+
+            // 1行分とデータ全体がファイルに収まっているか確認する.
+            auto columns = ( compressed ) ? ( uint64_t(info.Width)  + 3 ) / 4 : uint64_t(info.Width);
+            auto rows    = ( compressed ) ? ( uint64_t(info.Height) + 3 ) / 4 : uint64_t(info.Height);
+            if (info.Width == 0 || info.Height == 0
+             || uint64_t(info.Pitch) < columns * elementSize
+             || uint64_t(info.SlicePitch) < uint64_t(info.Pitch) * rows
+             || uint64_t(m_Size - offset - sizeof(info)) < info.SlicePitch)
+            { return false; }
+
+            m_Offsets[i] = offset;
+            offset += sizeof(info) + info.SlicePitch;
+        }
+
+        m_Format       = format;
+        m_Width        = header.Width;
+        m_Height       = header.Height;
+        m_Depth        = header.Depth;
+        m_MipCount     = texInfo.MipCount;
+        m_SurfaceCount = texInfo.SurfaceCount;
+        return true;
+    }
+};
+
+} // namespace glare
+
+#endif//__GLARE_MAP_VIEW_H__
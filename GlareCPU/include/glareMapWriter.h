@@ -0,0 +1,138 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareMapWriter.h
+// Desc : MAP File Writer Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_MAP_WRITER_H__
+#define __GLARE_MAP_WRITER_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareMapView.h>
+
+
+namespace glare {
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// MIP_FILTER enum
+//////////////////////////////////////////////////////////////////////////////////////////////
+enum MIP_FILTER
+{
+    MIP_FILTER_BOX = 0,         //!< 2x2 の箱型フィルタです.
+    MIP_FILTER_KAISER,          //!< カイザー窓を掛けたsincフィルタ(8タップ)です.
+
+    NUM_MIP_FILTER              //!< フィルタ数です.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// MapWriteDesc structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct MapWriteDesc
+{
+    MAP_FORMAT  Format;         //!< 出力フォーマットです.
+    int         MipCount;       //!< ミップレベル数です. 0 の場合は 1x1 までの全レベルを生成します.
+    MIP_FILTER  MipFilter;      //!< ミップの縮小フィルタです.
+    bool        SRGB;           //!< 入力をsRGBとして扱い，線形空間で縮小するかどうか. 浮動小数フォーマットでは無視します.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      既定の書き出し設定を取得します.
+//!
+//! @return     RGBA8, 全ミップ, 箱型フィルタ, sRGB の設定を返却します.
+//-------------------------------------------------------------------------------------------
+MapWriteDesc GetDefaultMapWriteDesc();
+
+//-------------------------------------------------------------------------------------------
+//! @brief      ミップレベル数を計算します.
+//!
+//! @param [in]     width       横幅です.
+//! @param [in]     height      縦幅です.
+//! @return     1x1 までのミップレベル数を返却します.
+//-------------------------------------------------------------------------------------------
+int CalcMipCount( int width, int height );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      画像をMAPファイルに書き出します.
+//!
+//! @param [in]     filename        ファイル名です.
+//! @param [in]     pSurfaces       サーフェイスの配列です. 全て同じサイズである必要があります.
+//! @param [in]     surfaceCount    サーフェイス数です.
+//! @param [in]     desc            書き出し設定です.
+//! @param [in]     pPool           スレッドプールです.
+//! @retval true    書き出しに成功.
+//! @retval false   引数が正しくない場合や，書き込みに失敗した場合は失敗.
+//! @note       テクセル値は LoadMapFile() と同じく[0, 1]のUNORMとして量子化します.
+//!             浮動小数フォーマットは飽和させずに変換するので，HDRの値をそのまま保存できます.
+//!             ミップは各サーフェイスで1つ上のレベルから行単位で並列に縮小し，
+//!             4MB程度の(ブロック)行ずつ並列にエンコードしては，ファイルの先頭から順に書き込みます.
+//!             ファイル全体のバッファは作らず，保持するのは直前の2レベルのミップと1チャンク分だけです.
+//!             入力は Image なので，最上位レベルは呼び出し側が全体をメモリに持つ必要があります.
+//-------------------------------------------------------------------------------------------
+bool SaveMapFile
+(
+    const char*         filename,
+    const Image*        pSurfaces,
+    int                 surfaceCount,
+    const MapWriteDesc& desc,
+    ThreadPool*         pPool = nullptr
+);
+
+//-------------------------------------------------------------------------------------------
+//! @brief      1サーフェイス・ミップ無しのMAPファイルのレイアウトを求めます.
+//!
+//! @param [in]     format      フォーマットです.
+//! @param [in]     width       横幅です.
+//! @param [in]     height      縦幅です.
+//! @param [out]    info        サーフェイス情報です.
+//! @param [out]    pDataOffset ファイル先頭からテクセルデータまでのバイト数の格納先です. nullptr でも構いません.
+//! @retval true    計算に成功.
+//! @retval false   引数が正しくない場合や，サーフェイスが4GB以上になる場合は失敗.
+//! @note       ファイルサイズは *pDataOffset + info.SlicePitch です.
+//-------------------------------------------------------------------------------------------
+bool CalcMapLayout( MAP_FORMAT format, int width, int height, MAP_SURFACE_INFO& info, size_t* pDataOffset );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      1サーフェイス・ミップ無しのMAPファイルのヘッダを書き込みます.
+//!
+//! @param [in]     format      フォーマットです.
+//! @param [in]     info        CalcMapLayout() で求めたサーフェイス情報です.
+//! @param [out]    pDst        ファイル先頭の書き込み先です.
+//! @return     書き込んだバイト数(テクセルデータの位置)を返却します.
+//! @note       テクセルデータを EncodeMapTexels() で直接書き込む場合に使います.
+//-------------------------------------------------------------------------------------------
+size_t WriteMapHeader( MAP_FORMAT format, const MAP_SURFACE_INFO& info, void* pDst );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      線形のテクセル列を非圧縮フォーマットにエンコードします.
+//!
+//! @param [in]     format      フォーマットです. ブロック圧縮フォーマットは指定できません.
+//! @param [in]     pSrc        RGBA32Fのテクセル列です.
+//! @param [in]     count       テクセル数です.
+//! @param [out]    pDst        書き込み先です.
+//! @retval true    エンコードに成功.
+//! @retval false   フォーマットが正しくない場合は失敗.
+//! @note       SaveMapFile() の最上位レベルと同じ値になります(sRGB変換は行いません).
+//-------------------------------------------------------------------------------------------
+bool EncodeMapTexels( MAP_FORMAT format, const float* pSrc, int count, void* pDst );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      1つ上のレベルからミップを生成します.
+//!
+//! @param [in]     src         縮小元の画像です.
+//! @param [in]     filter      縮小フィルタです.
+//! @param [out]    dst         出力画像です. 縦横を半分(最小1)にしたサイズで生成します.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    生成に成功.
+//! @retval false   生成に失敗.
+//! @note       入力は線形空間の値である必要があります.
+//-------------------------------------------------------------------------------------------
+bool GenerateMip( const Image& src, MIP_FILTER filter, Image& dst, ThreadPool* pPool = nullptr );
+
+} // namespace glare
+
+#endif//__GLARE_MAP_WRITER_H__
@@ -0,0 +1,62 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareMath.h
+// Desc : Math Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_MATH_H__
+#define __GLARE_MATH_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <cmath>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const float     F_PI        = 3.1415926535897932384626433832795f;     //!< πです.
+const float     F_2PI       = 6.283185307179586476925286766559f;      //!< 2πです.
+const float     F_PIDIV4    = 0.78539816339744830961566084581988f;    //!< π/4です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Vector2 structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct Vector2
+{
+    float x;    //!< X成分です.
+    float y;    //!< Y成分です.
+
+    Vector2()
+    { /* DO_NOTHING */ }
+
+    Vector2( float nx, float ny )
+    : x( nx ), y( ny )
+    { /* DO_NOTHING */ }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Vector4 structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct Vector4
+{
+    float x;    //!< X成分です.
+    float y;    //!< Y成分です.
+    float z;    //!< Z成分です.
+    float w;    //!< W成分です.
+
+    Vector4()
+    { /* DO_NOTHING */ }
+
+    Vector4( float nx, float ny, float nz, float nw )
+    : x( nx ), y( ny ), z( nz ), w( nw )
+    { /* DO_NOTHING */ }
+};
+
+} // namespace glare
+
+#endif//__GLARE_MATH_H__
@@ -0,0 +1,51 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glarePyramid.h
+// Desc : Single Pass Downsample Pyramid Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_PYRAMID_H__
+#define __GLARE_PYRAMID_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   PYRAMID_TILE_SIZE         = 32;     //!< 1タイルが担当する1段目のテクセル数(一辺)です(DownsamplePyramidCS.hlsl と同じ).
+const int   MAX_PYRAMID_LEVEL_COUNT   = 6;      //!< 1タイルの中で作れる最大段数です(32 -> 1).
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      縮小バッファの全段を1回の走査で生成します.
+//!
+//! @param [in]     src         入力画像です.
+//! @param [in]     factor      1段目の縮小率です(4ならば1/4). 2段目以降は前段の1/2です.
+//! @param [in]     levelCount  段数です. 1 以上 MAX_PYRAMID_LEVEL_COUNT 以下を指定します.
+//! @param [out]    pLevels     levelCount 個の出力画像です. 各段のサイズで生成します.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    生成に成功.
+//! @retval false   生成に失敗.
+//! @note       1段目を PYRAMID_TILE_SIZE 行ずつに分け，その行の1段目を作ってから，
+//!             キャッシュに載っている間に同じ範囲の2段目以降を続けて作ります.
+//!             入力を行単位で連続して読むように，コンピュートシェーダの横一列のグループをまとめて処理します.
+//!             Downsample() を段数分繰り返した結果と一致します.
+//-------------------------------------------------------------------------------------------
+bool BuildPyramid
+(
+    const Image&    src,
+    int             factor,
+    int             levelCount,
+    Image*          pLevels,
+    ThreadPool*     pPool = nullptr
+);
+
+} // namespace glare
+
+#endif//__GLARE_PYRAMID_H__
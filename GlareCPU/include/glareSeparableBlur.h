@@ -0,0 +1,258 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareSeparableBlur.h
+// Desc : Separable Blur Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_SEPARABLE_BLUR_H__
+#define __GLARE_SEPARABLE_BLUR_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareGaussBlur.h>
+#include <glareCpuInfo.h>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   MAX_BLUR_RADIUS = 64;       //!< ブラーカーネルの最大半径(テクセル)です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// PIXEL_FORMAT enum
+/////////////////////////////////////////////////////////////////////////////////////////////
+enum PIXEL_FORMAT
+{
+    PIXEL_FORMAT_R8G8B8A8_SRGB = 0,         //!< RGBはsRGB, Aは線形のUNORMです.
+    PIXEL_FORMAT_R16G16B16A16_FLOAT,        //!< 半精度浮動小数です.
+    PIXEL_FORMAT_R32G32B32A32_FLOAT,        //!< 単精度浮動小数です.
+    NUM_PIXEL_FORMAT,
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Surface structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct Surface
+{
+    void*           pPixels;        //!< 先頭ピクセルです.
+    int             Width;          //!< 横幅です.
+    int             Height;         //!< 縦幅です.
+    size_t          Pitch;          //!< 1行あたりのバイト数です.
+    PIXEL_FORMAT    Format;         //!< ピクセルフォーマットです.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// BlurKernel structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct BlurKernel
+{
+    int     Radius;                                 //!< 半径(テクセル)です.
+    bool    Vertical;                               //!< 縦方向のカーネルかどうか.
+    float   Weight[MAX_BLUR_RADIUS * 2 + 1];        //!< オフセット -Radius から +Radius までの重みです.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      ピクセルフォーマットの1ピクセルあたりのバイト数を取得します.
+//-------------------------------------------------------------------------------------------
+size_t GetPixelSize( PIXEL_FORMAT format );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      RGBA32F画像を参照するサーフェイスを取得します.
+//-------------------------------------------------------------------------------------------
+Surface GetSurface( Image& image );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      半精度浮動小数の配列を単精度浮動小数に一括変換します.
+//!
+//! @param [in]     pSrc        変換元の配列です.
+//! @param [in]     count       要素数です.
+//! @param [out]    pDst        変換結果の格納先です.
+//! @note       実行環境で使える最速の命令セット(F16C / NEON)で変換します.
+//-------------------------------------------------------------------------------------------
+void ConvertHalfToFloat( const uint16_t* pSrc, size_t count, float* pDst );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      単精度浮動小数の配列を半精度浮動小数に一括変換します(最近接偶数丸め).
+//!
+//! @param [in]     pSrc        変換元の配列です.
+//! @param [in]     count       要素数です.
+//! @param [out]    pDst        変換結果の格納先です.
+//! @note       半精度で表現できない大きな値は無限大になります.
+//-------------------------------------------------------------------------------------------
+void ConvertFloatToHalf( const float* pSrc, size_t count, uint16_t* pDst );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      サーフェイスをRGBA32F画像に展開します.
+//!
+//! @param [in]     src         入力サーフェイスです.
+//! @param [out]    dst         出力画像です. 入力と同じサイズで生成します.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    展開に成功.
+//! @retval false   展開に失敗.
+//! @note       半精度浮動小数の作業バッファを LensGhost や StarStreak に渡す場合に使います.
+//-------------------------------------------------------------------------------------------
+bool LoadSurface( const Surface& src, Image& dst, ThreadPool* pPool = nullptr );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      RGBA32F画像をサーフェイスのフォーマットに変換して書き込みます.
+//!
+//! @param [in]     src         入力画像です.
+//! @param [in]     dst         出力サーフェイスです. 入力と同じサイズである必要があります.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    書き込みに成功.
+//! @retval false   サイズが異なる場合は失敗.
+//! @note       PIXEL_FORMAT_R8G8B8A8_SRGB は[0, 1]に飽和しますが，浮動小数フォーマットは飽和しません.
+//-------------------------------------------------------------------------------------------
+bool StoreSurface( const Image& src, const Surface& dst, ThreadPool* pPool = nullptr );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      ブラーパラメータを整数オフセットのカーネルに変換します.
+//!
+//! @param [in]     param       CalcBlurParam() で求めたパラメータです.
+//! @param [in]     width       ブラーを掛ける画像の横幅です.
+//! @param [in]     height      ブラーを掛ける画像の縦幅です.
+//! @param [out]    kernel      変換したカーネルです.
+//! @retval true    変換に成功.
+//! @retval false   縦横両方のオフセットを含む場合や，半径が大きすぎる場合は失敗.
+//! @note       テクセルの間を指すオフセットは，リニアサンプリングと同じ比率で両隣のテクセルに分配します.
+//-------------------------------------------------------------------------------------------
+bool MakeBlurKernel( const GaussBlurParam& param, int width, int height, BlurKernel& kernel );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      テクセル単位のガウスカーネルを生成します.
+//!
+//! @param [in]     tapCount    タップ数です. 3 以上 MAX_BLUR_RADIUS * 2 + 1 以下の奇数を指定します.
+//! @param [in]     deviation   標準偏差(テクセル)です.
+//! @param [in]     vertical    縦方向のカーネルかどうか.
+//! @param [out]    kernel      生成したカーネルです. 重みの合計は1になります.
+//! @retval true    生成に成功.
+//! @retval false   タップ数が範囲外の場合は失敗.
+//-------------------------------------------------------------------------------------------
+bool MakeGaussKernel( int tapCount, float deviation, bool vertical, BlurKernel& kernel );
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// SeparableBlur class
+/////////////////////////////////////////////////////////////////////////////////////////////
+class SeparableBlur
+{
+    //=======================================================================================
+    // list of friend classes and methods.
+    //=======================================================================================
+    /* NOTHING */
+
+public:
+    //=======================================================================================
+    // public variables.
+    //=======================================================================================
+    /* NOTHING */
+
+    //=======================================================================================
+    // public methods.
+    //=======================================================================================
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------
+    SeparableBlur();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------
+    ~SeparableBlur();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      初期化処理です.
+    //!
+    //! @param [in]     width       画像の横幅です.
+    //! @param [in]     height      画像の縦幅です.
+    //! @param [in]     isa         使用する命令セットです.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗. 実行環境で使えない命令セットを指定した場合も失敗します.
+    //---------------------------------------------------------------------------------------
+    bool Init( int width, int height, SIMD_ISA isa = GetBestSimdIsa() );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      終了処理です.
+    //---------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      横方向，縦方向の順にブラーを掛けます.
+    //!
+    //! @param [in]     src             入力画像です.
+    //! @param [in]     horizontal      横方向のブラーパラメータです.
+    //! @param [in]     vertical        縦方向のブラーパラメータです.
+    //! @param [in]     dst             出力画像です. 入力画像と同じでも構いません.
+    //! @param [in]     pPool           スレッドプールです.
+    //! @retval true    処理に成功.
+    //! @retval false   サイズが初期化時と異なる場合や，パラメータの方向が正しくない場合は失敗.
+    //! @note       RGBは GaussBlurPS.hlsl を同じサイズの画像に2回適用した結果と一致します.
+    //!             アルファも同じカーネルでブラーを掛けます.
+    //---------------------------------------------------------------------------------------
+    bool Execute
+    (
+        const Surface&          src,
+        const GaussBlurParam&   horizontal,
+        const GaussBlurParam&   vertical,
+        const Surface&          dst,
+        ThreadPool*             pPool = nullptr
+    );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      横方向，縦方向の順にカーネルを適用します.
+    //!
+    //! @param [in]     src             入力画像です.
+    //! @param [in]     horizontal      横方向のカーネルです.
+    //! @param [in]     vertical        縦方向のカーネルです.
+    //! @param [in]     dst             出力画像です. 入力画像と同じでも構いません.
+    //! @param [in]     pPool           スレッドプールです.
+    //! @retval true    処理に成功.
+    //! @retval false   処理に失敗.
+    //! @note       横方向のパスの結果は縦方向のカーネルの直径分の行だけを保持し，
+    //!             縦方向のパスも行のまま連続したメモリを処理します.
+    //---------------------------------------------------------------------------------------
+    bool Execute
+    (
+        const Surface&          src,
+        const BlurKernel&       horizontal,
+        const BlurKernel&       vertical,
+        const Surface&          dst,
+        ThreadPool*             pPool = nullptr
+    );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      使用している命令セットを取得します.
+    //---------------------------------------------------------------------------------------
+    SIMD_ISA GetIsa() const;
+
+private:
+    //=======================================================================================
+    // private variables.
+    //=======================================================================================
+    SIMD_ISA            m_Isa;          //!< 使用する命令セットです.
+    int                 m_Width;        //!< 画像の横幅です.
+    int                 m_Height;       //!< 画像の縦幅です.
+    std::vector<uint8_t> m_Boundary;    //!< 入力と出力が同じ場合に，帯の境界付近の入力行を退避するバッファです.
+
+    //=======================================================================================
+    // private methods.
+    //=======================================================================================
+    SeparableBlur   ( const SeparableBlur& );   // アクセス禁止.
+    void operator = ( const SeparableBlur& );   // アクセス禁止.
+};
+
+} // namespace glare
+
+#endif//__GLARE_SEPARABLE_BLUR_H__
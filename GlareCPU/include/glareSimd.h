@@ -0,0 +1,268 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareSimd.h
+// Desc : SIMD Wrapper Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_SIMD_H__
+#define __GLARE_SIMD_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #ifndef GLARE_SIMD_SSE2
+    #define GLARE_SIMD_SSE2     (1)
+    #endif//GLARE_SIMD_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #ifndef GLARE_SIMD_NEON
+    #define GLARE_SIMD_NEON     (1)
+    #endif//GLARE_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+
+#ifndef GLARE_INLINE
+    #ifdef  _MSC_VER
+        #define GLARE_INLINE    __forceinline
+    #else
+        #define GLARE_INLINE    inline __attribute__((always_inline))
+    #endif//_MSC_VER
+#endif//GLARE_INLINE
+
+
+namespace glare {
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Float4 structure
+///////////////////////////////////////////////////////////////////////////////////////////
+struct Float4
+{
+#if GLARE_SIMD_SSE2
+    __m128          v;          //!< レジスタです.
+#elif GLARE_SIMD_NEON
+    float32x4_t     v;          //!< レジスタです.
+#else
+    float           v[4];       //!< 要素です.
+#endif
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      アラインされていないメモリから4要素を読み込みます.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Load4( const float* p )
+{
+    Float4 result;
+#if GLARE_SIMD_SSE2
+    result.v = _mm_loadu_ps( p );
+#elif GLARE_SIMD_NEON
+    result.v = vld1q_f32( p );
+#else
+    result.v[0] = p[0]; result.v[1] = p[1]; result.v[2] = p[2]; result.v[3] = p[3];
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      アラインされていないメモリに4要素を書き込みます.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE void Store4( float* p, const Float4& a )
+{
+#if GLARE_SIMD_SSE2
+    _mm_storeu_ps( p, a.v );
+#elif GLARE_SIMD_NEON
+    vst1q_f32( p, a.v );
+#else
+    p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3];
+#endif
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      全要素に同じ値を設定します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Splat4( float s )
+{
+    Float4 result;
+#if GLARE_SIMD_SSE2
+    result.v = _mm_set1_ps( s );
+#elif GLARE_SIMD_NEON
+    result.v = vdupq_n_f32( s );
+#else
+    result.v[0] = result.v[1] = result.v[2] = result.v[3] = s;
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      各要素を設定します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Set4( float x, float y, float z, float w )
+{
+    Float4 result;
+#if GLARE_SIMD_SSE2
+    result.v = _mm_setr_ps( x, y, z, w );
+#elif GLARE_SIMD_NEON
+    const float tmp[4] = { x, y, z, w };
+    result.v = vld1q_f32( tmp );
+#else
+    result.v[0] = x; result.v[1] = y; result.v[2] = z; result.v[3] = w;
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      ゼロベクトルを返却します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Zero4()
+{
+#if GLARE_SIMD_SSE2
+    Float4 result;
+    result.v = _mm_setzero_ps();
+    return result;
+#else
+    return Splat4( 0.0f );
+#endif
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      加算します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Add( const Float4& a, const Float4& b )
+{
+    Float4 result;
+#if GLARE_SIMD_SSE2
+    result.v = _mm_add_ps( a.v, b.v );
+#elif GLARE_SIMD_NEON
+    result.v = vaddq_f32( a.v, b.v );
+#else
+    for(auto i=0; i<4; ++i)
+    { result.v[i] = a.v[i] + b.v[i]; }
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      減算します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Sub( const Float4& a, const Float4& b )
+{
+    Float4 result;
+#if GLARE_SIMD_SSE2
+    result.v = _mm_sub_ps( a.v, b.v );
+#elif GLARE_SIMD_NEON
+    result.v = vsubq_f32( a.v, b.v );
+#else
+    for(auto i=0; i<4; ++i)
+    { result.v[i] = a.v[i] - b.v[i]; }
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      乗算します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Mul( const Float4& a, const Float4& b )
+{
+    Float4 result;
+#if GLARE_SIMD_SSE2
+    result.v = _mm_mul_ps( a.v, b.v );
+#elif GLARE_SIMD_NEON
+    result.v = vmulq_f32( a.v, b.v );
+#else
+    for(auto i=0; i<4; ++i)
+    { result.v[i] = a.v[i] * b.v[i]; }
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      a * b + c を計算します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Madd( const Float4& a, const Float4& b, const Float4& c )
+{
+#if GLARE_SIMD_NEON
+    Float4 result;
+    result.v = vmlaq_f32( c.v, a.v, b.v );
+    return result;
+#else
+    return Add( Mul( a, b ), c );
+#endif
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      最小値を求めます.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Min( const Float4& a, const Float4& b )
+{
+    Float4 result;
+#if GLARE_SIMD_SSE2
+    result.v = _mm_min_ps( a.v, b.v );
+#elif GLARE_SIMD_NEON
+    result.v = vminq_f32( a.v, b.v );
+#else
+    for(auto i=0; i<4; ++i)
+    { result.v[i] = ( a.v[i] < b.v[i] ) ? a.v[i] : b.v[i]; }
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      最大値を求めます.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Max( const Float4& a, const Float4& b )
+{
+    Float4 result;
+#if GLARE_SIMD_SSE2
+    result.v = _mm_max_ps( a.v, b.v );
+#elif GLARE_SIMD_NEON
+    result.v = vmaxq_f32( a.v, b.v );
+#else
+    for(auto i=0; i<4; ++i)
+    { result.v[i] = ( a.v[i] > b.v[i] ) ? a.v[i] : b.v[i]; }
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      線形補間します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Lerp( const Float4& a, const Float4& b, const Float4& t )
+{ return Madd( Sub( b, a ), t, a ); }
+
+//-------------------------------------------------------------------------------------------
+//! @brief      [0, 1]の範囲にクランプします.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 Saturate( const Float4& a )
+{ return Min( Max( a, Zero4() ), Splat4( 1.0f ) ); }
+
+//-------------------------------------------------------------------------------------------
+//! @brief      X成分を全要素に複製します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE Float4 SplatX( const Float4& a )
+{
+    Float4 result;
+#if GLARE_SIMD_SSE2
+    result.v = _mm_shuffle_ps( a.v, a.v, _MM_SHUFFLE(0, 0, 0, 0) );
+#elif GLARE_SIMD_NEON
+    result.v = vdupq_laneq_f32( a.v, 0 );
+#else
+    result.v[0] = result.v[1] = result.v[2] = result.v[3] = a.v[0];
+#endif
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! @brief      指定要素を取得します.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE float GetElement( const Float4& a, int index )
+{
+    float tmp[4];
+    Store4( tmp, a );
+    return tmp[index];
+}
+
+} // namespace glare
+
+#endif//__GLARE_SIMD_H__
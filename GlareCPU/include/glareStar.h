@@ -0,0 +1,155 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareStar.h
+// Desc : Star Streak Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_STAR_H__
+#define __GLARE_STAR_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <vector>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   MIN_STAR_DIRECTION_COUNT    = 2;    //!< 光芒の最小本数です.
+const int   MAX_STAR_DIRECTION_COUNT    = 16;   //!< 光芒の最大本数です.
+const int   MAX_STAR_PASS_COUNT         = 4;    //!< 1方向あたりの最大パス数です.
+const int   STAR_TAP_COUNT              = 16;   //!< 1パスあたりのタップ数です(StarPS.hlsl と同じ).
+const int   MAX_STAR_DOWNSAMPLE_FACTOR  = 4;    //!< 光芒を描画する解像度の最大縮小率です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// StarParam structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct StarParam
+{
+    int     DirectionCount;     //!< 光芒の本数です. 全周を等分した方向に伸ばします.
+    float   Rotation;           //!< 最初の光芒の角度(ラジアン)です.
+    float   Attenuation;        //!< 減衰率です. [0.9, 0.95] 程度を指定します.
+    int     PassCount;          //!< 1方向あたりのパス数です. i 番目のパスは 4^i テクセル間隔でサンプリングします.
+    int     DownsampleFactor;   //!< 光芒を描画する解像度の縮小率です. 1, 2, 4 のいずれかを指定します.
+    float   Threshold;          //!< 縮小時に差し引く輝度の閾値です. DownsampleFactor が1の場合は使いません.
+    bool    SaturatePass;       //!< 各パスの結果を [0, 1] に飽和させるかどうか. UNORM の作業バッファを再現します.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      Star サンプルと同じ既定のパラメータを取得します.
+//!
+//! @return     4方向, 45度回転, 減衰率 0.925, 3パス, 等倍, 飽和無しのパラメータを返却します.
+//-------------------------------------------------------------------------------------------
+StarParam GetDefaultStarParam();
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// StarStreak class
+/////////////////////////////////////////////////////////////////////////////////////////////
+class StarStreak
+{
+    //=======================================================================================
+    // list of friend classes and methods.
+    //=======================================================================================
+    /* NOTHING */
+
+public:
+    //=======================================================================================
+    // public variables.
+    //=======================================================================================
+    /* NOTHING */
+
+    //=======================================================================================
+    // public methods.
+    //=======================================================================================
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------
+    StarStreak();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------
+    ~StarStreak();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      初期化処理です.
+    //!
+    //! @param [in]     width       画像の横幅です.
+    //! @param [in]     height      画像の縦幅です.
+    //! @param [in]     pPool       スレッドプールです(nullptrの場合は逐次実行).
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //! @note       同時に処理する方向の数(スレッド数と最大本数の小さい方)だけ作業バッファを2枚ずつ確保します.
+    //---------------------------------------------------------------------------------------
+    bool Init( int width, int height, ThreadPool* pPool );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      終了処理です.
+    //---------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      光芒を描画します.
+    //!
+    //! @param [in]     src         入力画像です.
+    //! @param [in]     param       パラメータです.
+    //! @param [out]    dst         出力画像です. 入力画像と同じサイズで生成済みである必要があります.
+    //! @retval true    描画に成功.
+    //! @retval false   サイズやパラメータが正しくない場合は失敗.
+    //! @note       複数の方向を同時に進め，各パスは (方向, 行) の組をスレッドに分配します.
+    //!             最後のパスで全方向の結果を行ごとに足し合わせるので，加算合成を方向の数だけ繰り返しません.
+    //!             SaturatePass が false の場合は，浮動小数(R16G16B16A16_FLOAT)の作業バッファを使う
+    //!             Star サンプルの m_WorkBuffer[3] と丸め誤差を除いて同じ結果になります.
+    //!             SaturatePass が true の場合は，各パスと加算合成の結果を飽和させて
+    //!             UNORM(R8G8B8A8_UNORM_SRGB)の作業バッファを使う場合の結果を再現します.
+    //!             DownsampleFactor が2以上の場合は，閾値を引いた縮小画像を1度だけ作って全方向で共有し，
+    //!             テクスチャ座標で同じ長さの光芒を縮小解像度で描画してから出力へ1度だけ拡大します.
+    //---------------------------------------------------------------------------------------
+    bool Execute( const Image& src, const StarParam& param, Image& dst );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      検証用のスカラー実装で光芒を描画します.
+    //!
+    //! @param [in]     src         入力画像です.
+    //! @param [in]     param       パラメータです.
+    //! @param [out]    dst         出力画像です. 入力画像と同じサイズで生成済みである必要があります.
+    //! @retval true    描画に成功.
+    //! @retval false   サイズやパラメータが正しくない場合は失敗.
+    //! @note       Star サンプルの描画をそのまま書き下した単一スレッドの実装です.
+    //---------------------------------------------------------------------------------------
+    bool ExecuteReference( const Image& src, const StarParam& param, Image& dst );
+
+private:
+    //=======================================================================================
+    // private variables.
+    //=======================================================================================
+    ThreadPool*     m_pPool;                                           //!< スレッドプールです.
+    int             m_Width;                                           //!< 画像の横幅です.
+    int             m_Height;                                          //!< 画像の縦幅です.
+    int             m_SlotCount;                                       //!< 同時に処理する方向の数です.
+    Image           m_WorkBuffer[MAX_STAR_DIRECTION_COUNT][2];         //!< 方向ごとのピンポンバッファです.
+    Image           m_ReducedBuffer[MAX_STAR_DIRECTION_COUNT][2];      //!< 縮小解像度のピンポンバッファです.
+    Image           m_ReducedSource;                                   //!< 閾値を引いた縮小画像です.
+    Image           m_ReducedResult;                                   //!< 縮小解像度の描画結果です.
+
+    //=======================================================================================
+    // private methods.
+    //=======================================================================================
+    StarStreak      ( const StarStreak& );  // アクセス禁止.
+    void operator = ( const StarStreak& );  // アクセス禁止.
+
+    bool IsValid( const Image& src, const StarParam& param, const Image& dst ) const;
+    void DrawStreaks( const Image& src, const StarParam& param, Image (&work)[MAX_STAR_DIRECTION_COUNT][2], Image& dst );
+};
+
+} // namespace glare
+
+#endif//__GLARE_STAR_H__
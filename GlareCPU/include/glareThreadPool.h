@@ -0,0 +1,129 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareThreadPool.h
+// Desc : Thread Pool Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_THREAD_POOL_H__
+#define __GLARE_THREAD_POOL_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+
+namespace glare {
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// ThreadPool class
+/////////////////////////////////////////////////////////////////////////////////////////////
+class ThreadPool
+{
+    //=======================================================================================
+    // list of friend classes and methods.
+    //=======================================================================================
+    /* NOTHING */
+
+public:
+    //=======================================================================================
+    // public variables.
+    //=======================================================================================
+    /* NOTHING */
+
+    //=======================================================================================
+    // public methods.
+    //=======================================================================================
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------
+    ThreadPool();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------
+    ~ThreadPool();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      初期化処理です.
+    //!
+    //! @param [in]     threadCount     呼び出しスレッドを含むスレッド数です(0ならハードウェアスレッド数).
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //---------------------------------------------------------------------------------------
+    bool Init( int threadCount = 0 );
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      終了処理です.
+    //---------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      呼び出しスレッドを含むスレッド数を取得します.
+    //---------------------------------------------------------------------------------------
+    int GetThreadCount() const;
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      [0, count)の範囲を grain 単位に分割して並列実行します.
+    //!
+    //! @param [in]     count       処理数です.
+    //! @param [in]     grain       1回のタスクで処理する数です.
+    //! @param [in]     func        処理関数です. 引数は処理範囲 [begin, end) です.
+    //! @note       呼び出しスレッドも処理に参加し，全範囲の処理が完了するまで戻りません.
+    //!             ワーカースレッドからの入れ子呼び出しは呼び出しスレッドで逐次実行されます.
+    //---------------------------------------------------------------------------------------
+    void ParallelFor( int count, int grain, const std::function<void(int begin, int end)>& func );
+
+private:
+    //=======================================================================================
+    // private variables.
+    //=======================================================================================
+    std::vector<std::thread>                        m_Threads;      //!< ワーカースレッドです.
+    std::mutex                                      m_Mutex;        //!< ミューテックスです.
+    std::mutex                                      m_SubmitMutex;  //!< 投入用ミューテックスです.
+    std::condition_variable                         m_WakeCond;     //!< 起床用条件変数です.
+    std::condition_variable                         m_DoneCond;     //!< 完了通知用条件変数です.
+    const std::function<void(int, int)>*            m_pFunc;        //!< 実行中の処理関数です.
+    std::atomic<int>                                m_Next;         //!< 次に処理する位置です.
+    int                                             m_Count;        //!< 処理数です.
+    int                                             m_Grain;        //!< 分割単位です.
+    int                                             m_Busy;         //!< 処理中のワーカー数です.
+    unsigned int                                    m_Generation;   //!< ジョブ世代番号です.
+    bool                                            m_Quit;         //!< 終了フラグです.
+
+    //=======================================================================================
+    // private methods.
+    //=======================================================================================
+    ThreadPool      ( const ThreadPool& );      // アクセス禁止.
+    void operator = ( const ThreadPool& );      // アクセス禁止.
+
+    void Worker();
+    void Drain();
+};
+
+//-------------------------------------------------------------------------------------------
+//! @brief      スレッドプールがあれば並列に，なければ逐次に実行します.
+//-------------------------------------------------------------------------------------------
+inline void ParallelFor
+(
+    ThreadPool*                                     pPool,
+    int                                             count,
+    int                                             grain,
+    const std::function<void(int begin, int end)>&  func
+)
+{
+    if (pPool != nullptr)
+    { pPool->ParallelFor( count, grain, func ); }
+    else if (count > 0)
+    { func( 0, count ); }
+}
+
+} // namespace glare
+
+#endif//__GLARE_THREAD_POOL_H__
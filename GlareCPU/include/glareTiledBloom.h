@@ -0,0 +1,100 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareTiledBloom.h
+// Desc : Tiled Bloom Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_TILED_BLOOM_H__
+#define __GLARE_TILED_BLOOM_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareMapView.h>
+#include <cstddef>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   MAX_BLOOM_LEVEL_COUNT   = 8;    //!< 縮小バッファの最大段数です.
+const int   BLOOM_DOWNSAMPLE_FACTOR = 4;    //!< 1段目の縮小率です(MultipleGaussBlur サンプルと同じ).
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// TiledBloomDesc structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct TiledBloomDesc
+{
+    int         LevelCount;     //!< 縮小バッファの段数です. 1 以上 MAX_BLOOM_LEVEL_COUNT 以下を指定します.
+    float       Deviation;      //!< 各段のブラーの標準偏差(各段のテクセル)です.
+    size_t      MemoryBudget;   //!< 作業メモリの上限(バイト)です. タイルの大きさはこの値から決めます.
+    MAP_FORMAT  OutputFormat;   //!< 出力フォーマットです. 非圧縮フォーマットを指定します.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// TiledBloomStats structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct TiledBloomStats
+{
+    int         TileSize[MAX_BLOOM_LEVEL_COUNT + 1];    //!< パスごとのタイルの一辺です(各段のブラー, 最後が合成).
+    int         TileCount;                              //!< 処理したタイルの総数です.
+    size_t      WorkingSet;                             //!< 見積もった作業メモリの最大値(バイト)です.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      既定の設定を取得します.
+//!
+//! @return     5段, 標準偏差2.5, 作業メモリ256MB, R16G16B16A16_FLOAT の設定を返却します.
+//-------------------------------------------------------------------------------------------
+TiledBloomDesc GetDefaultTiledBloomDesc();
+
+//-------------------------------------------------------------------------------------------
+//! @brief      メモリ上の画像に多段ブラーのブルームを適用します.
+//!
+//! @param [in]     src         入力画像です.
+//! @param [in]     desc        設定です. MemoryBudget と OutputFormat は使いません.
+//! @param [out]    dst         出力画像です. 入力と同じサイズで生成します.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    処理に成功.
+//! @retval false   処理に失敗.
+//! @note       1段目は入力を1/4に，以降は前段のブラー結果を1/2に縮小し，
+//!             各段に GAUSS_BLUR_TAP_COUNT タップのガウスブラーを縦横に掛けます.
+//!             出力は入力に全段をリニアサンプリングで拡大して加算した値で，アルファは1.0になります.
+//!             ApplyBloomTiled() の検証用の基準実装です.
+//-------------------------------------------------------------------------------------------
+bool ApplyBloom( const Image& src, const TiledBloomDesc& desc, Image& dst, ThreadPool* pPool = nullptr );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      MAPファイルの画像にタイル単位でブルームを適用し，MAPファイルに書き出します.
+//!
+//! @param [in]     srcPath     入力ファイルです. 最上位ミップの1枚目のサーフェイスを使います.
+//! @param [in]     dstPath     出力ファイルです. ミップ無しで書き出します.
+//! @param [in]     desc        設定です.
+//! @param [in]     pPool       スレッドプールです.
+//! @param [out]    pStats      統計情報の格納先です. nullptr でも構いません.
+//! @retval true    処理に成功.
+//! @retval false   作業メモリが足りない場合や，ファイルの入出力に失敗した場合は失敗.
+//! @note       入力と出力，各段の中間結果(一時ファイル)はメモリにマップし，上から帯状に処理します.
+//!             各段のタイルはブラー半径分の糊代を付けて読み込むので，結果は ApplyBloom() と一致します.
+//!             処理を終えた帯のページはすぐに手放すので，常駐するのは処理中の帯とタイルの作業バッファだけです.
+//!             R16G16B16A16_FLOAT では 32768 x 16384 が1サーフェイスの上限(4GB)を超えるため，
+//!             R9G9B9E5 を指定してください.
+//-------------------------------------------------------------------------------------------
+bool ApplyBloomTiled
+(
+    const char*             srcPath,
+    const char*             dstPath,
+    const TiledBloomDesc&   desc,
+    ThreadPool*             pPool  = nullptr,
+    TiledBloomStats*        pStats = nullptr
+);
+
+} // namespace glare
+
+#endif//__GLARE_TILED_BLOOM_H__
@@ -0,0 +1,96 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareTiledBlur.h
+// Desc : Compute Shader Tiled Blur Emulation Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_TILED_BLUR_H__
+#define __GLARE_TILED_BLUR_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareSeparableBlur.h>
+#include <cstdint>
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   TILED_BLUR_THREAD_COUNT = 128;  //!< 1グループのスレッド数です(GaussBlurTiled.hlsli と同じ).
+const int   TILED_BLUR_MAX_RADIUS   = 64;   //!< 共有メモリに収まる最大半径です(GaussBlurTiled.hlsli と同じ).
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// TiledBlurStats structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct TiledBlurStats
+{
+    uint64_t    GroupCount;         //!< ディスパッチしたグループ数です.
+    uint64_t    TextureFetchCount;  //!< テクスチャからの読み込み回数です.
+    uint64_t    SharedReadCount;    //!< 共有メモリからの読み込み回数です.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//! @brief      1グループが共有メモリに読み込むテクセル数を取得します.
+//!
+//! @param [in]     radius      カーネルの半径(テクセル)です.
+//! @return     タイルの両側にカーネルの半径分のハローを加えたテクセル数を返却します.
+//-------------------------------------------------------------------------------------------
+int GetTiledBlurCacheSize( int radius );
+
+//-------------------------------------------------------------------------------------------
+//! @brief      1方向のブラーをコンピュートシェーダと同じタイル分割で処理します.
+//!
+//! @param [in]     src         入力画像です.
+//! @param [in]     kernel      カーネルです. 半径は TILED_BLUR_MAX_RADIUS 以下である必要があります.
+//! @param [out]    dst         出力画像です. 入力画像と同じサイズで生成済みである必要があります.
+//! @param [out]    pStats      統計情報の加算先です. nullptr の場合は集計しません.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    処理に成功.
+//! @retval false   サイズが異なる場合や，半径が大きすぎる場合は失敗.
+//! @note       1グループはブラー方向の TILED_BLUR_THREAD_COUNT テクセルを担当し，
+//!             ハローを含むテクセルを端でクランプして共有メモリに1度だけ読み込んでから，
+//!             共有メモリ上で畳み込みます. SeparableBlur と同じ順序で加算します.
+//!             入力画像と出力画像に同じ画像は指定できません.
+//-------------------------------------------------------------------------------------------
+bool TiledBlurPass
+(
+    const Image&        src,
+    const BlurKernel&   kernel,
+    Image&              dst,
+    TiledBlurStats*     pStats = nullptr,
+    ThreadPool*         pPool  = nullptr
+);
+
+//-------------------------------------------------------------------------------------------
+//! @brief      横方向，縦方向の順にタイル分割したブラーを掛けます.
+//!
+//! @param [in]     src         入力画像です.
+//! @param [in]     horizontal  横方向のカーネルです.
+//! @param [in]     vertical    縦方向のカーネルです.
+//! @param [out]    temp        横方向の結果を保持する作業画像です. 入力画像と同じサイズで生成済みである必要があります.
+//! @param [out]    dst         出力画像です. 入力画像と同じサイズで生成済みである必要があります.
+//! @param [out]    pStats      統計情報の格納先です. nullptr の場合は集計しません.
+//! @param [in]     pPool       スレッドプールです.
+//! @retval true    処理に成功.
+//! @retval false   処理に失敗.
+//-------------------------------------------------------------------------------------------
+bool TiledBlur
+(
+    const Image&        src,
+    const BlurKernel&   horizontal,
+    const BlurKernel&   vertical,
+    Image&              temp,
+    Image&              dst,
+    TiledBlurStats*     pStats = nullptr,
+    ThreadPool*         pPool  = nullptr
+);
+
+} // namespace glare
+
+#endif//__GLARE_TILED_BLUR_H__
@@ -0,0 +1,220 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : main.cpp
+// Desc : Headless Glare Sample.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareMapFile.h>
+#include <glareThreadPool.h>
+#include <glareLensGhost.h>
+#include <cstdio>
+#include <chrono>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const char* DEFAULT_INPUT_PATH  = "../../LensGhost/sample/res/texture/input.map";
+const char* DEFAULT_MASK_PATH   = "../../LensGhost/sample/res/texture/mask.map";
+const int   BENCHMARK_COUNT     = 20;
+const float TOLERANCE           = 1.0f / 255.0f;
+const float CHAIN_TOLERANCE     = 0.03f;            // 飽和した中間バッファのリニアサンプリングは展開では再現できない.
+const float NO_TOLERANCE        = -1.0f;
+const int   UHD_WIDTH           = 3840;
+const int   UHD_HEIGHT          = 2160;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// BenchmarkCase structure
+//////////////////////////////////////////////////////////////////////////////////////////////
+struct BenchmarkCase
+{
+    glare::LENS_GHOST_MODE  Mode;           //!< ゴーストの描画方法です.
+    float                   Threshold;      //!< LENS_GHOST_MODE_CHAIN で項を捨てる閾値です.
+    float                   Tolerance;      //!< 許容誤差です. 負の場合は項を捨てる近似なので判定に使いません.
+    const char*             Name;           //!< 表示名です.
+};
+
+// 計測するゴースト描画方法.
+const BenchmarkCase BENCHMARK_CASES[] = {
+    { glare::LENS_GHOST_MODE_MULTI_PASS,    0.0f,   TOLERANCE,          "multi pass" },
+    { glare::LENS_GHOST_MODE_FUSED,         0.0f,   TOLERANCE,          "fused" },
+    { glare::LENS_GHOST_MODE_CHAIN,         0.0f,   CHAIN_TOLERANCE,    "chain" },
+    { glare::LENS_GHOST_MODE_CHAIN,         0.5f,   NO_TOLERANCE,       "chain 0.5" },
+    { glare::LENS_GHOST_MODE_CHAIN,         0.75f,  NO_TOLERANCE,       "chain 0.75" },
+};
+
+
+//-------------------------------------------------------------------------------------------
+//      2つの画像の最大誤差を求めます.
+//-------------------------------------------------------------------------------------------
+float CalcMaxError( const glare::Image& a, const glare::Image& b )
+{
+    if (a.GetWidth() != b.GetWidth() || a.GetHeight() != b.GetHeight())
+    { return 1e+30f; }
+
+    auto count = size_t(a.GetWidth()) * size_t(a.GetHeight()) * 4;
+    auto pA = a.GetPixels();
+    auto pB = b.GetPixels();
+
+    auto result = 0.0f;
+    for(size_t i=0; i<count; ++i)
+    {
+        auto diff = fabsf( pA[i] - pB[i] );
+        if (diff > result)
+        { result = diff; }
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      現在時刻をミリ秒で取得します.
+//-------------------------------------------------------------------------------------------
+double GetTimeMsec()
+{
+    auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
+    return std::chrono::duration<double, std::milli>( now ).count();
+}
+
+//-------------------------------------------------------------------------------------------
+//      リニアサンプリングで拡大します.
+//-------------------------------------------------------------------------------------------
+bool Resize( const glare::Image& src, int width, int height, glare::Image& dst )
+{
+    if (!dst.Create( width, height ))
+    { return false; }
+
+    for(auto y=0; y<height; ++y)
+    {
+        auto v = ( float(y) + 0.5f ) / float(height);
+        for(auto x=0; x<width; ++x)
+        {
+            auto u = ( float(x) + 0.5f ) / float(width);
+            dst.Store( x, y, glare::SampleLinearClamp( src, u, v ) );
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ゴースト描画方法ごとに処理時間を計測します.
+//-------------------------------------------------------------------------------------------
+bool Benchmark
+(
+    glare::ThreadPool&  pool,
+    const glare::Image& input,
+    const glare::Image& mask,
+    bool                useReference,
+    bool*               pPassed
+)
+{
+    glare::LensGhost lensGhost;
+    if (!lensGhost.Init( input.GetWidth(), input.GetHeight(), &pool ))
+    {
+        fprintf( stderr, "Error : LensGhost::Init() Failed.\n" );
+        return false;
+    }
+
+    glare::Image reference;
+    glare::Image output;
+
+    // 検証用のスカラー実装と比較. 無い場合は最初の描画方法の結果を基準にする.
+    if (useReference)
+    { lensGhost.ExecuteReference( input, mask, reference ); }
+
+    auto count = int(sizeof(BENCHMARK_CASES) / sizeof(BENCHMARK_CASES[0]));
+    for(auto i=0; i<count; ++i)
+    {
+        auto& item = BENCHMARK_CASES[i];
+        lensGhost.SetMode( item.Mode );
+        lensGhost.SetChainThreshold( item.Threshold );
+
+        auto& result = ( !useReference && i == 0 ) ? reference : output;
+        lensGhost.Execute( input, mask, result );
+
+        auto error = CalcMaxError( reference, result );
+        if (item.Tolerance >= 0.0f && error > item.Tolerance)
+        { *pPassed = false; }
+
+        // 計測.
+        auto begin = GetTimeMsec();
+        for(auto j=0; j<BENCHMARK_COUNT; ++j)
+        { lensGhost.Execute( input, mask, output ); }
+        auto end = GetTimeMsec();
+
+        printf( "LensGhost : %d x %d, %-10s : %8.3f msec/frame, max error = %e",
+            input.GetWidth(), input.GetHeight(), item.Name,
+            ( end - begin ) / double(BENCHMARK_COUNT), error );
+
+        if (item.Mode == glare::LENS_GHOST_MODE_CHAIN)
+        { printf( ", terms = %d", lensGhost.GetChainTermCount() ); }
+
+        if (item.Tolerance < 0.0f)
+        { printf( " (approximate)" ); }
+        else if (error > item.Tolerance)
+        { printf( " (NG)" ); }
+
+        printf( "\n" );
+    }
+
+    lensGhost.Term();
+    return true;
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    auto inputPath = ( argc > 1 ) ? argv[1] : DEFAULT_INPUT_PATH;
+    auto maskPath  = ( argc > 2 ) ? argv[2] : DEFAULT_MASK_PATH;
+
+    glare::Image input;
+    glare::Image mask;
+    if (!glare::LoadMapFile( inputPath, input ))
+    {
+        fprintf( stderr, "Error : LoadMapFile() Failed. path = %s\n", inputPath );
+        return -1;
+    }
+
+    if (!glare::LoadMapFile( maskPath, mask ))
+    {
+        fprintf( stderr, "Error : LoadMapFile() Failed. path = %s\n", maskPath );
+        return -1;
+    }
+
+    glare::ThreadPool pool;
+    pool.Init();
+    printf( "LensGhost : threads = %d\n", pool.GetThreadCount() );
+
+    auto passed = true;
+
+    // 入力画像の解像度(1920 x 1080).
+    if (!Benchmark( pool, input, mask, true, &passed ))
+    { return -1; }
+
+    // 4K.
+    {
+        glare::Image uhd;
+        if (!Resize( input, UHD_WIDTH, UHD_HEIGHT, uhd ))
+        { return -1; }
+
+        if (!Benchmark( pool, uhd, mask, false, &passed ))
+        { return -1; }
+    }
+
+    pool.Term();
+
+    return ( passed ) ? 0 : -1;
+}
@@ -0,0 +1,223 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareBoxBlur.cpp
+// Desc : Iterated Box Blur Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareBoxBlur.h>
+#include <glareThreadPool.h>
+#include <vector>
+#include <cstring>
+#include <cmath>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   STRIP_WIDTH = 16;       //!< 縦方向のパスでまとめて処理する列数です.
+
+
+//-------------------------------------------------------------------------------------------
+//      1ライン分の移動和を求めます.
+//
+//      pSrc, pDst は count 個の要素を stride floats 間隔で持ち，各要素は channels 個の
+//      連続した float です. 誤差が蓄積しないように和は倍精度で保持します.
+//-------------------------------------------------------------------------------------------
+void BoxFilterLine
+(
+    const float*    pSrc,
+    float*          pDst,
+    int             count,
+    size_t          stride,
+    int             channels,
+    int             radius,
+    double*         pSum
+)
+{
+    auto scale = 1.0 / double(radius * 2 + 1);
+    auto last  = count - 1;
+
+    for(auto c=0; c<channels; ++c)
+    { pSum[c] = 0.0; }
+
+    for(auto i=-radius; i<=radius; ++i)
+    {
+        auto p = pSrc + size_t( ( i < 0 ) ? 0 : ( i > last ) ? last : i ) * stride;
+        for(auto c=0; c<channels; ++c)
+        { pSum[c] += p[c]; }
+    }
+
+    for(auto i=0; i<count; ++i)
+    {
+        auto d = pDst + size_t(i) * stride;
+        for(auto c=0; c<channels; ++c)
+        { d[c] = float( pSum[c] * scale ); }
+
+        auto add = i + radius + 1;
+        auto sub = i - radius;
+        auto pAdd = pSrc + size_t( ( add > last ) ? last : add ) * stride;
+        auto pSub = pSrc + size_t( ( sub < 0 ) ? 0 : sub ) * stride;
+        for(auto c=0; c<channels; ++c)
+        { pSum[c] += double(pAdd[c]) - double(pSub[c]); }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      ラインの両端を端の要素で埋めます.
+//
+//      pLine は前後に pad 要素ずつの余白を持つ count + pad * 2 要素のラインです.
+//-------------------------------------------------------------------------------------------
+void PadLine( float* pLine, int count, int pad, int channels )
+{
+    auto pFirst = pLine + size_t(pad) * channels;
+    auto pLast  = pLine + size_t(pad + count - 1) * channels;
+    for(auto i=0; i<pad; ++i)
+    {
+        memcpy( pLine + size_t(i) * channels,     pFirst, sizeof(float) * channels );
+        memcpy( pLast + size_t(i + 1) * channels, pLast,  sizeof(float) * channels );
+    }
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      箱型フィルタの半径を計算します.
+//-------------------------------------------------------------------------------------------
+bool CalcBoxBlurParam( float deviation, int passCount, BoxBlurParam& param )
+{
+    if (passCount < 1 || passCount > MAX_BOX_PASS_COUNT || deviation < 0.0f)
+    { return false; }
+
+    // 幅 w の箱の分散は (w^2 - 1) / 12 なので，n 回で分散 σ^2 になる幅を求め，
+    // 前後の奇数幅 wl, wl + 2 を m 回と n - m 回ずつ使う.
+    auto n        = float(passCount);
+    auto variance = deviation * deviation;
+    auto ideal    = sqrtf( 12.0f * variance / n + 1.0f );
+
+    auto wl = int( floorf( ideal ) );
+    if (( wl & 1 ) == 0)
+    { wl--; }
+    if (wl < 1)
+    { wl = 1; }
+
+    auto fwl = float(wl);
+    auto m   = int( roundf( ( 12.0f * variance - n * fwl * fwl - 4.0f * n * fwl - 3.0f * n ) / ( -4.0f * fwl - 4.0f ) ) );
+    m = ( m < 0 ) ? 0 : ( m > passCount ) ? passCount : m;
+
+    param.PassCount = passCount;
+    for(auto i=0; i<MAX_BOX_PASS_COUNT; ++i)
+    {
+        auto width = ( i < m ) ? wl : wl + 2;
+        param.Radius[i] = ( i < passCount ) ? ( width - 1 ) / 2 : 0;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      箱型フィルタを反復した結果の標準偏差を求めます.
+//-------------------------------------------------------------------------------------------
+float GetBoxBlurDeviation( const BoxBlurParam& param )
+{
+    auto variance = 0.0f;
+    for(auto i=0; i<param.PassCount; ++i)
+    {
+        auto width = float(param.Radius[i] * 2 + 1);
+        variance += ( width * width - 1.0f ) / 12.0f;
+    }
+    return sqrtf( variance );
+}
+
+//-------------------------------------------------------------------------------------------
+//      箱型フィルタを縦横に反復します.
+//-------------------------------------------------------------------------------------------
+bool BoxGaussBlur( const Image& src, const BoxBlurParam& param, Image& dst, ThreadPool* pPool )
+{
+    auto w = src.GetWidth();
+    auto h = src.GetHeight();
+    if (w <= 0 || h <= 0 || dst.GetWidth() != w || dst.GetHeight() != h)
+    { return false; }
+
+    if (param.PassCount < 1 || param.PassCount > MAX_BOX_PASS_COUNT)
+    { return false; }
+
+    for(auto i=0; i<param.PassCount; ++i)
+    {
+        if (param.Radius[i] < 0)
+        { return false; }
+    }
+
+    // 反復の途中でクランプするとガウスブラーと端の結果が変わるので，
+    // 半径の合計だけ端を複製して延長したラインに反復を掛ける.
+    auto pad = 0;
+    for(auto i=0; i<param.PassCount; ++i)
+    { pad += param.Radius[i]; }
+
+    // 横方向. 行ごとに全反復を終えてから書き込むので，入力と出力が同じでもよい.
+    ParallelFor( pPool, h, 8, [&](int begin, int end)
+    {
+        auto length = w + pad * 2;
+        std::vector<float> buffer[2];
+        buffer[0].resize( size_t(length) * 4 );
+        buffer[1].resize( size_t(length) * 4 );
+        double sum[4];
+
+        for(auto y=begin; y<end; ++y)
+        {
+            memcpy( buffer[0].data() + pad * 4, src.GetRow( y ), sizeof(float) * 4 * size_t(w) );
+            PadLine( buffer[0].data(), w, pad, 4 );
+
+            for(auto i=0; i<param.PassCount; ++i)
+            {
+                BoxFilterLine( buffer[i & 1].data(), buffer[( i + 1 ) & 1].data(), length, 4, 4, param.Radius[i], sum );
+            }
+
+            memcpy( dst.GetRow( y ), buffer[param.PassCount & 1].data() + pad * 4, sizeof(float) * 4 * size_t(w) );
+        }
+    });
+
+    // 縦方向. STRIP_WIDTH 列の帯を取り出し，帯の中で全反復を行う.
+    auto strips = ( w + STRIP_WIDTH - 1 ) / STRIP_WIDTH;
+    ParallelFor( pPool, strips, 1, [&](int begin, int end)
+    {
+        auto length = h + pad * 2;
+        std::vector<float> buffer[2];
+        buffer[0].resize( size_t(length) * STRIP_WIDTH * 4 );
+        buffer[1].resize( size_t(length) * STRIP_WIDTH * 4 );
+        double sum[STRIP_WIDTH * 4];
+
+        for(auto strip=begin; strip<end; ++strip)
+        {
+            auto x0       = strip * STRIP_WIDTH;
+            auto n        = ( w - x0 < STRIP_WIDTH ) ? w - x0 : STRIP_WIDTH;
+            auto channels = n * 4;
+            auto stride   = size_t(channels);
+
+            for(auto y=0; y<h; ++y)
+            { memcpy( buffer[0].data() + size_t(y + pad) * stride, dst.GetRow( y ) + x0 * 4, sizeof(float) * stride ); }
+            PadLine( buffer[0].data(), h, pad, channels );
+
+            // 帯の1行をまとめて1要素として扱い，行方向に移動和を取る.
+            for(auto i=0; i<param.PassCount; ++i)
+            {
+                BoxFilterLine( buffer[i & 1].data(), buffer[( i + 1 ) & 1].data(), length, stride, channels, param.Radius[i], sum );
+            }
+
+            auto& result = buffer[param.PassCount & 1];
+            for(auto y=0; y<h; ++y)
+            { memcpy( dst.GetRow( y ) + x0 * 4, result.data() + size_t(y + pad) * stride, sizeof(float) * stride ); }
+        }
+    });
+
+    return true;
+}
+
+} // namespace glare
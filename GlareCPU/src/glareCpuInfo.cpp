@@ -0,0 +1,151 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareCpuInfo.cpp
+// Desc : CPU Information Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareCpuInfo.h>
+#include <glareSimd.h>
+
+#if GLARE_SIMD_SSE2
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #include <immintrin.h>
+    #else
+        #include <cpuid.h>
+    #endif//_MSC_VER
+#endif//GLARE_SIMD_SSE2
+
+
+namespace {
+
+#if GLARE_SIMD_SSE2
+//-------------------------------------------------------------------------------------------
+//      CPUID命令を実行します.
+//-------------------------------------------------------------------------------------------
+void CpuId( unsigned int leaf, unsigned int subLeaf, unsigned int regs[4] )
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex( info, int(leaf), int(subLeaf) );
+    for(auto i=0; i<4; ++i)
+    { regs[i] = (unsigned int)(info[i]); }
+#else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    __get_cpuid_count( leaf, subLeaf, &regs[0], &regs[1], &regs[2], &regs[3] );
+#endif
+}
+
+//-------------------------------------------------------------------------------------------
+//      OSが保存するレジスタの状態を取得します.
+//-------------------------------------------------------------------------------------------
+unsigned long long GetXCR0()
+{
+#ifdef _MSC_VER
+    return _xgetbv( 0 );
+#else
+    unsigned int eax, edx;
+    __asm__ __volatile__ ( "xgetbv" : "=a"(eax), "=d"(edx) : "c"(0) );
+    return ( (unsigned long long)(edx) << 32 ) | eax;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------
+//      AVX2が使えるかどうかを判定します.
+//-------------------------------------------------------------------------------------------
+bool DetectAVX2()
+{
+    unsigned int regs[4];
+    CpuId( 0, 0, regs );
+    if (regs[0] < 7)
+    { return false; }
+
+    CpuId( 1, 0, regs );
+    auto hasFMA     = ( regs[2] & ( 1u << 12 ) ) != 0;
+    auto hasOSXSAVE = ( regs[2] & ( 1u << 27 ) ) != 0;
+    auto hasAVX     = ( regs[2] & ( 1u << 28 ) ) != 0;
+    auto hasF16C    = ( regs[2] & ( 1u << 29 ) ) != 0;
+    if (!hasFMA || !hasOSXSAVE || !hasAVX || !hasF16C)
+    { return false; }
+
+    // OSがXMM/YMMレジスタを退避するかどうか.
+    if (( GetXCR0() & 0x6 ) != 0x6)
+    { return false; }
+
+    CpuId( 7, 0, regs );
+    return ( regs[1] & ( 1u << 5 ) ) != 0;
+}
+#endif//GLARE_SIMD_SSE2
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      命令セットが実行環境で使えるかどうかを判定します.
+//-------------------------------------------------------------------------------------------
+bool IsSimdIsaSupported( SIMD_ISA isa )
+{
+    switch(isa)
+    {
+    case SIMD_ISA_SCALAR:
+        return true;
+
+#if GLARE_SIMD_SSE2
+    case SIMD_ISA_SSE2:
+        return true;
+
+    case SIMD_ISA_AVX2:
+        {
+            static const bool supported = DetectAVX2();
+            return supported;
+        }
+#endif//GLARE_SIMD_SSE2
+
+#if GLARE_SIMD_NEON
+    case SIMD_ISA_NEON:
+        return true;
+#endif//GLARE_SIMD_NEON
+
+    default:
+        return false;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      実行環境で使える最も高速な命令セットを取得します.
+//-------------------------------------------------------------------------------------------
+SIMD_ISA GetBestSimdIsa()
+{
+    if (IsSimdIsaSupported( SIMD_ISA_AVX2 ))
+    { return SIMD_ISA_AVX2; }
+
+    if (IsSimdIsaSupported( SIMD_ISA_SSE2 ))
+    { return SIMD_ISA_SSE2; }
+
+    if (IsSimdIsaSupported( SIMD_ISA_NEON ))
+    { return SIMD_ISA_NEON; }
+
+    return SIMD_ISA_SCALAR;
+}
+
+//-------------------------------------------------------------------------------------------
+//      命令セットの名前を取得します.
+//-------------------------------------------------------------------------------------------
+const char* GetSimdIsaName( SIMD_ISA isa )
+{
+    switch(isa)
+    {
+    case SIMD_ISA_SCALAR:   return "Scalar";
+    case SIMD_ISA_SSE2:     return "SSE2";
+    case SIMD_ISA_AVX2:     return "AVX2";
+    case SIMD_ISA_NEON:     return "NEON";
+    default:                return "Unknown";
+    }
+}
+
+} // namespace glare
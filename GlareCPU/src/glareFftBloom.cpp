@@ -0,0 +1,639 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareFftBloom.cpp
+// Desc : FFT Convolution Bloom Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareFftBloom.h>
+#include <glareThreadPool.h>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const double    PI              = 3.14159265358979323846;
+const int       COLUMN_BLOCK    = 4;        //!< 列方向のパスでまとめて取り出す列数です(1行あたり128byte).
+const int       APERTURE_RATIO  = 8;        //!< 回折カーネルの格子に対する絞りの大きさの比です.
+
+// 回折カーネルのRGBの波長(nm)です. 緑を基準に広がりを変える.
+const float     WAVELENGTHS[3]  = { 650.0f, 550.0f, 450.0f };
+
+
+//-------------------------------------------------------------------------------------------
+//      2の累乗に切り上げます.
+//-------------------------------------------------------------------------------------------
+int NextPow2( int value )
+{
+    auto result = 1;
+    while (result < value)
+    { result <<= 1; }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      複素FFTの回転因子とビット反転テーブルを生成します.
+//
+//      回転因子は cos, sin の順に n / 2 個格納します.
+//-------------------------------------------------------------------------------------------
+void MakeFftTable( int n, std::vector<float>& table, std::vector<int>& reverse )
+{
+    table.resize( size_t(n) );
+    for(auto k=0; k<n / 2; ++k)
+    {
+        auto angle = 2.0 * PI * double(k) / double(n);
+        table[k * 2 + 0] = float( cos( angle ) );
+        table[k * 2 + 1] = float( sin( angle ) );
+    }
+
+    auto bits = 0;
+    while ((1 << bits) < n)
+    { bits++; }
+
+    reverse.resize( size_t(n) );
+    for(auto i=0; i<n; ++i)
+    {
+        auto r = 0;
+        for(auto b=0; b<bits; ++b)
+        { r |= ( ( i >> b ) & 1 ) << ( bits - 1 - b ); }
+        reverse[i] = r;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      4チャンネルを独立に複素FFTします.
+//
+//      pRe, pIm はそれぞれ n 要素の Float4 で，各レーンが別々の信号です.
+//      順変換は exp(-2πi/n)，逆変換は exp(+2πi/n) を回転因子とし，スケールは掛けません.
+//-------------------------------------------------------------------------------------------
+void Fft
+(
+    float*          pRe,
+    float*          pIm,
+    int             n,
+    const int*      pReverse,
+    const float*    pTable,
+    bool            inverse
+)
+{
+    using namespace glare;
+
+    for(auto i=0; i<n; ++i)
+    {
+        auto j = pReverse[i];
+        if (i < j)
+        {
+            auto re = Load4( pRe + i * 4 );
+            auto im = Load4( pIm + i * 4 );
+            Store4( pRe + i * 4, Load4( pRe + j * 4 ) );
+            Store4( pIm + i * 4, Load4( pIm + j * 4 ) );
+            Store4( pRe + j * 4, re );
+            Store4( pIm + j * 4, im );
+        }
+    }
+
+    auto sign = ( inverse ) ? 1.0f : -1.0f;
+
+    for(auto half=1; half<n; half<<=1)
+    {
+        auto step = n / ( half * 2 );
+        for(auto j=0; j<half; ++j)
+        {
+            auto wr = Splat4( pTable[j * step * 2 + 0] );
+            auto wi = Splat4( pTable[j * step * 2 + 1] * sign );
+
+            for(auto i=j; i<n; i+=half * 2)
+            {
+                auto pAr = pRe + i * 4;
+                auto pAi = pIm + i * 4;
+                auto pBr = pAr + half * 4;
+                auto pBi = pAi + half * 4;
+
+                auto br = Load4( pBr );
+                auto bi = Load4( pBi );
+                auto tr = Sub( Mul( br, wr ), Mul( bi, wi ) );
+                auto ti = Madd( br, wi, Mul( bi, wr ) );
+
+                auto ar = Load4( pAr );
+                auto ai = Load4( pAi );
+                Store4( pAr, Add( ar, tr ) );
+                Store4( pAi, Add( ai, ti ) );
+                Store4( pBr, Sub( ar, tr ) );
+                Store4( pBi, Sub( ai, ti ) );
+            }
+        }
+    }
+}
+
+} // namespace
+
+
+namespace glare {
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// FftBloom class
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------
+FftBloom::FftBloom()
+: m_Width       ( 0 )
+, m_Height      ( 0 )
+, m_KernelWidth ( 0 )
+, m_KernelHeight( 0 )
+, m_FftWidth    ( 0 )
+, m_FftHeight   ( 0 )
+, m_HasKernel   ( false )
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------
+FftBloom::~FftBloom()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------
+//      初期化処理です.
+//-------------------------------------------------------------------------------------------
+bool FftBloom::Init( int width, int height, int kernelWidth, int kernelHeight )
+{
+    if (width <= 0 || height <= 0 || kernelWidth <= 0 || kernelHeight <= 0)
+    { return false; }
+
+    Term();
+
+    m_Width        = width;
+    m_Height       = height;
+    m_KernelWidth  = kernelWidth;
+    m_KernelHeight = kernelHeight;
+
+    // 中心から左右(上下)へ広がる分だけ余白を取れば，循環した寄与は画像の外に落ちる.
+    auto cx = kernelWidth  / 2;
+    auto cy = kernelHeight / 2;
+    m_FftWidth  = NextPow2( width  + std::max( cx, kernelWidth  - 1 - cx ) );
+    m_FftHeight = NextPow2( height + std::max( cy, kernelHeight - 1 - cy ) );
+
+    // 実数の行は半分の長さの複素FFTで変換する.
+    if (m_FftWidth < 2)
+    { m_FftWidth = 2; }
+
+    auto half = m_FftWidth / 2;
+    MakeFftTable( half, m_RowTable, m_RowReverse );
+    MakeFftTable( m_FftHeight, m_ColumnTable, m_ColumnReverse );
+
+    m_RealTable.resize( size_t(half + 1) * 2 );
+    for(auto k=0; k<=half; ++k)
+    {
+        auto angle = 2.0 * PI * double(k) / double(m_FftWidth);
+        m_RealTable[k * 2 + 0] = float( cos( angle ) );
+        m_RealTable[k * 2 + 1] = float( sin( angle ) );
+    }
+
+    // 1要素は実部4チャンネル, 虚部4チャンネルの8floatです.
+    auto count = size_t(half + 1) * size_t(m_FftHeight) * 8;
+    m_Spectrum      .resize( count );
+    m_KernelSpectrum.resize( count );
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      終了処理です.
+//-------------------------------------------------------------------------------------------
+void FftBloom::Term()
+{
+    m_RowTable      .clear();
+    m_ColumnTable   .clear();
+    m_RealTable     .clear();
+    m_RowReverse    .clear();
+    m_ColumnReverse .clear();
+    m_Spectrum      .clear();
+    m_KernelSpectrum.clear();
+
+    m_RowTable      .shrink_to_fit();
+    m_ColumnTable   .shrink_to_fit();
+    m_RealTable     .shrink_to_fit();
+    m_RowReverse    .shrink_to_fit();
+    m_ColumnReverse .shrink_to_fit();
+    m_Spectrum      .shrink_to_fit();
+    m_KernelSpectrum.shrink_to_fit();
+
+    m_Width        = 0;
+    m_Height       = 0;
+    m_KernelWidth  = 0;
+    m_KernelHeight = 0;
+    m_FftWidth     = 0;
+    m_FftHeight    = 0;
+    m_HasKernel    = false;
+}
+
+//-------------------------------------------------------------------------------------------
+//      行ごとに実数FFTを行い，スペクトルに書き込みます.
+//
+//      長さ N の実数列を z[n] = x[2n] + i x[2n + 1] として N / 2 の複素FFTに掛け，
+//      偶数と奇数の成分に分離してから合成して 0 〜 N / 2 の周波数成分を求めます.
+//      wrap が true の場合はカーネルとして中心が原点に来るように循環させて配置します.
+//-------------------------------------------------------------------------------------------
+void FftBloom::ForwardRows( const Image& image, bool wrap, ThreadPool* pPool )
+{
+    auto half     = m_FftWidth / 2;
+    auto bins     = half + 1;
+    auto w        = image.GetWidth();
+    auto h        = image.GetHeight();
+    auto cx       = w / 2;
+    auto cy       = h / 2;
+    auto rowCount = ( wrap ) ? m_FftHeight : h;
+
+    ParallelFor( pPool, rowCount, 8, [&](int begin, int end)
+    {
+        std::vector<float> line( size_t(m_FftWidth) * 4 );
+        std::vector<float> re  ( size_t(half) * 4 );
+        std::vector<float> im  ( size_t(half) * 4 );
+        auto half4 = Splat4( 0.5f );
+
+        for(auto y=begin; y<end; ++y)
+        {
+            std::fill( line.begin(), line.end(), 0.0f );
+
+            if (!wrap)
+            { memcpy( line.data(), image.GetRow( y ), sizeof(float) * 4 * size_t(w) ); }
+            else
+            {
+                auto ky = ( y + cy ) % m_FftHeight;
+                if (ky < h)
+                {
+                    auto pRow = image.GetRow( ky );
+                    for(auto kx=0; kx<w; ++kx)
+                    {
+                        auto x = ( kx - cx + m_FftWidth ) % m_FftWidth;
+                        memcpy( line.data() + size_t(x) * 4, pRow + kx * 4, sizeof(float) * 4 );
+                    }
+                }
+            }
+
+            for(auto n=0; n<half; ++n)
+            {
+                Store4( re.data() + n * 4, Load4( line.data() + n * 8 + 0 ) );
+                Store4( im.data() + n * 4, Load4( line.data() + n * 8 + 4 ) );
+            }
+
+            Fft( re.data(), im.data(), half, m_RowReverse.data(), m_RowTable.data(), false );
+
+            auto pDst = m_Spectrum.data() + size_t(y) * size_t(bins) * 8;
+            for(auto k=0; k<=half; ++k)
+            {
+                auto i = ( k == half ) ? 0 : k;
+                auto j = ( k == 0 ) ? 0 : half - k;
+
+                // E = (Z[k] + conj(Z[M-k])) / 2, O = (Z[k] - conj(Z[M-k])) / 2i
+                auto ar = Load4( re.data() + i * 4 );
+                auto ai = Load4( im.data() + i * 4 );
+                auto br = Load4( re.data() + j * 4 );
+                auto bi = Load4( im.data() + j * 4 );
+
+                auto er = Mul( Add( ar, br ), half4 );
+                auto ei = Mul( Sub( ai, bi ), half4 );
+                auto or_ = Mul( Add( ai, bi ), half4 );
+                auto oi = Mul( Sub( br, ar ), half4 );
+
+                // X[k] = E + exp(-2πik/N) O
+                auto c = Splat4( m_RealTable[k * 2 + 0] );
+                auto s = Splat4( m_RealTable[k * 2 + 1] );
+                Store4( pDst + k * 8 + 0, Add( er, Madd( c, or_, Mul( s, oi ) ) ) );
+                Store4( pDst + k * 8 + 4, Add( ei, Sub( Mul( c, oi ), Mul( s, or_ ) ) ) );
+            }
+        }
+    });
+}
+
+//-------------------------------------------------------------------------------------------
+//      行ごとに逆実数FFTを行い，画像に書き込みます.
+//
+//      ForwardRows() の分離を逆にたどって z[n] を復元します. スケールは
+//      カーネルのスペクトルに含めてあります.
+//-------------------------------------------------------------------------------------------
+void FftBloom::InverseRows( Image& image, ThreadPool* pPool )
+{
+    auto half = m_FftWidth / 2;
+    auto bins = half + 1;
+    auto w    = m_Width;
+
+    ParallelFor( pPool, m_Height, 8, [&](int begin, int end)
+    {
+        std::vector<float> re( size_t(half) * 4 );
+        std::vector<float> im( size_t(half) * 4 );
+
+        for(auto y=begin; y<end; ++y)
+        {
+            auto pSrc = m_Spectrum.data() + size_t(y) * size_t(bins) * 8;
+            for(auto k=0; k<half; ++k)
+            {
+                auto ar = Load4( pSrc + k * 8 + 0 );
+                auto ai = Load4( pSrc + k * 8 + 4 );
+                auto br = Load4( pSrc + ( half - k ) * 8 + 0 );
+                auto bi = Load4( pSrc + ( half - k ) * 8 + 4 );
+
+                // 2E = X[k] + conj(X[M-k]), 2O = (X[k] - conj(X[M-k])) exp(2πik/N)
+                auto er = Add( ar, br );
+                auto ei = Sub( ai, bi );
+                auto dr = Sub( ar, br );
+                auto di = Add( ai, bi );
+
+                auto c  = Splat4( m_RealTable[k * 2 + 0] );
+                auto s  = Splat4( m_RealTable[k * 2 + 1] );
+                auto or_ = Sub( Mul( c, dr ), Mul( s, di ) );
+                auto oi  = Madd( c, di, Mul( s, dr ) );
+
+                // Z = E + iO
+                Store4( re.data() + k * 4, Sub( er, oi ) );
+                Store4( im.data() + k * 4, Add( ei, or_ ) );
+            }
+
+            Fft( re.data(), im.data(), half, m_RowReverse.data(), m_RowTable.data(), true );
+
+            auto pDst = image.GetRow( y );
+            auto one  = Set4( 0.0f, 0.0f, 0.0f, 1.0f );
+            auto mask = Set4( 1.0f, 1.0f, 1.0f, 0.0f );
+            for(auto x=0; x<w; ++x)
+            {
+                auto n     = x >> 1;
+                auto value = ( x & 1 ) ? Load4( im.data() + n * 4 ) : Load4( re.data() + n * 4 );
+                Store4( pDst + x * 4, Madd( value, mask, one ) );
+            }
+        }
+    });
+}
+
+//-------------------------------------------------------------------------------------------
+//      カーネルを設定し，スペクトルを計算して保持します.
+//-------------------------------------------------------------------------------------------
+bool FftBloom::SetKernel( const Image& kernel, ThreadPool* pPool )
+{
+    if (kernel.GetWidth() != m_KernelWidth || kernel.GetHeight() != m_KernelHeight || m_FftWidth == 0)
+    { return false; }
+
+    ForwardRows( kernel, true, pPool );
+
+    // 逆変換のスケール 1 / (N/2 * M) と InverseRows() で省いた 1/2 をまとめて掛ける.
+    // アルファは畳み込まない.
+    auto n     = m_FftHeight;
+    auto bins  = m_FftWidth / 2 + 1;
+    auto s     = 1.0f / ( float(m_FftWidth) * float(m_FftHeight) );
+    auto scale = Set4( s, s, s, 0.0f );
+
+    auto blocks = ( bins + COLUMN_BLOCK - 1 ) / COLUMN_BLOCK;
+    ParallelFor( pPool, blocks, 1, [&](int begin, int end)
+    {
+        std::vector<float> re( size_t(n) * 4 * COLUMN_BLOCK );
+        std::vector<float> im( size_t(n) * 4 * COLUMN_BLOCK );
+
+        for(auto block=begin; block<end; ++block)
+        {
+            auto k0    = block * COLUMN_BLOCK;
+            auto count = std::min( COLUMN_BLOCK, bins - k0 );
+
+            for(auto y=0; y<n; ++y)
+            {
+                auto pSrc = m_Spectrum.data() + ( size_t(y) * size_t(bins) + k0 ) * 8;
+                for(auto b=0; b<count; ++b)
+                {
+                    Store4( re.data() + ( size_t(b) * n + y ) * 4, Load4( pSrc + b * 8 + 0 ) );
+                    Store4( im.data() + ( size_t(b) * n + y ) * 4, Load4( pSrc + b * 8 + 4 ) );
+                }
+            }
+
+            for(auto b=0; b<count; ++b)
+            {
+                auto pRe = re.data() + size_t(b) * n * 4;
+                auto pIm = im.data() + size_t(b) * n * 4;
+                Fft( pRe, pIm, n, m_ColumnReverse.data(), m_ColumnTable.data(), false );
+
+                // 畳み込みでは列ごとに連続して読むので列優先で保持する.
+                auto pDst = m_KernelSpectrum.data() + size_t(k0 + b) * n * 8;
+                for(auto y=0; y<n; ++y)
+                {
+                    Store4( pDst + y * 8 + 0, Mul( Load4( pRe + y * 4 ), scale ) );
+                    Store4( pDst + y * 8 + 4, Mul( Load4( pIm + y * 4 ), scale ) );
+                }
+            }
+        }
+    });
+
+    m_HasKernel = true;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      設定したカーネルを畳み込みます.
+//-------------------------------------------------------------------------------------------
+bool FftBloom::Execute( const Image& src, Image& dst, ThreadPool* pPool )
+{
+    if (!m_HasKernel)
+    { return false; }
+
+    if (src.GetWidth() != m_Width || src.GetHeight() != m_Height
+     || dst.GetWidth() != m_Width || dst.GetHeight() != m_Height)
+    { return false; }
+
+    ForwardRows( src, false, pPool );
+
+    // 列ごとに順変換，カーネルとの積，逆変換をキャッシュ上でまとめて行う.
+    // 画像の外の行は0なので，読み書きするのは画像の高さの分だけでよい.
+    auto n     = m_FftHeight;
+    auto h     = m_Height;
+    auto bins  = m_FftWidth / 2 + 1;
+
+    auto blocks = ( bins + COLUMN_BLOCK - 1 ) / COLUMN_BLOCK;
+    ParallelFor( pPool, blocks, 1, [&](int begin, int end)
+    {
+        std::vector<float> re( size_t(n) * 4 * COLUMN_BLOCK );
+        std::vector<float> im( size_t(n) * 4 * COLUMN_BLOCK );
+
+        for(auto block=begin; block<end; ++block)
+        {
+            auto k0    = block * COLUMN_BLOCK;
+            auto count = std::min( COLUMN_BLOCK, bins - k0 );
+
+            std::fill( re.begin(), re.end(), 0.0f );
+            std::fill( im.begin(), im.end(), 0.0f );
+
+            for(auto y=0; y<h; ++y)
+            {
+                auto pSrc = m_Spectrum.data() + ( size_t(y) * size_t(bins) + k0 ) * 8;
+                for(auto b=0; b<count; ++b)
+                {
+                    Store4( re.data() + ( size_t(b) * n + y ) * 4, Load4( pSrc + b * 8 + 0 ) );
+                    Store4( im.data() + ( size_t(b) * n + y ) * 4, Load4( pSrc + b * 8 + 4 ) );
+                }
+            }
+
+            for(auto b=0; b<count; ++b)
+            {
+                auto pRe = re.data() + size_t(b) * n * 4;
+                auto pIm = im.data() + size_t(b) * n * 4;
+                Fft( pRe, pIm, n, m_ColumnReverse.data(), m_ColumnTable.data(), false );
+
+                auto pKernel = m_KernelSpectrum.data() + size_t(k0 + b) * n * 8;
+                for(auto y=0; y<n; ++y)
+                {
+                    auto ar = Load4( pRe + y * 4 );
+                    auto ai = Load4( pIm + y * 4 );
+                    auto kr = Load4( pKernel + y * 8 + 0 );
+                    auto ki = Load4( pKernel + y * 8 + 4 );
+                    Store4( pRe + y * 4, Sub( Mul( ar, kr ), Mul( ai, ki ) ) );
+                    Store4( pIm + y * 4, Madd( ar, ki, Mul( ai, kr ) ) );
+                }
+
+                Fft( pRe, pIm, n, m_ColumnReverse.data(), m_ColumnTable.data(), true );
+            }
+
+            for(auto y=0; y<h; ++y)
+            {
+                auto pDst = m_Spectrum.data() + ( size_t(y) * size_t(bins) + k0 ) * 8;
+                for(auto b=0; b<count; ++b)
+                {
+                    Store4( pDst + b * 8 + 0, Load4( re.data() + ( size_t(b) * n + y ) * 4 ) );
+                    Store4( pDst + b * 8 + 4, Load4( im.data() + ( size_t(b) * n + y ) * 4 ) );
+                }
+            }
+        }
+    });
+
+    InverseRows( dst, pPool );
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      絞りの形状から回折によるグレアのカーネルを生成します.
+//-------------------------------------------------------------------------------------------
+bool MakeDiffractionKernel( const Image& aperture, int size, Image& kernel, ThreadPool* pPool )
+{
+    if (size < APERTURE_RATIO || ( size & ( size - 1 ) ) != 0)
+    { return false; }
+
+    if (aperture.GetWidth() <= 0 || aperture.GetHeight() <= 0)
+    { return false; }
+
+    std::vector<float> table;
+    std::vector<int>   reverse;
+    MakeFftTable( size, table, reverse );
+
+    // 絞りを格子の中央に 1 / APERTURE_RATIO の大きさで置いてから2次元FFTする.
+    auto count = size_t(size) * size_t(size) * 4;
+    std::vector<float> re( count, 0.0f );
+    std::vector<float> im( count, 0.0f );
+
+    auto apertureSize = size / APERTURE_RATIO;
+    auto offset       = ( size - apertureSize ) / 2;
+
+    ParallelFor( pPool, size, 8, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto pRe = re.data() + size_t(y) * size * 4;
+            auto pIm = im.data() + size_t(y) * size * 4;
+
+            if (y >= offset && y < offset + apertureSize)
+            {
+                auto v = ( float(y - offset) + 0.5f ) / float(apertureSize);
+                for(auto x=0; x<apertureSize; ++x)
+                {
+                    auto u = ( float(x) + 0.5f ) / float(apertureSize);
+                    auto t = GetElement( SampleLinearClamp( aperture, u, v ), 0 );
+                    Store4( pRe + ( offset + x ) * 4, Splat4( t ) );
+                }
+            }
+
+            Fft( pRe, pIm, size, reverse.data(), table.data(), false );
+        }
+    });
+
+    // 列は1本ずつ取り出して変換し，パワースペクトルを中心に移しながら書き戻す.
+    Image power;
+    if (!power.Create( size, size ))
+    { return false; }
+
+    ParallelFor( pPool, size, 8, [&](int begin, int end)
+    {
+        std::vector<float> columnRe( size_t(size) * 4 );
+        std::vector<float> columnIm( size_t(size) * 4 );
+
+        for(auto x=begin; x<end; ++x)
+        {
+            for(auto y=0; y<size; ++y)
+            {
+                Store4( columnRe.data() + y * 4, Load4( re.data() + ( size_t(y) * size + x ) * 4 ) );
+                Store4( columnIm.data() + y * 4, Load4( im.data() + ( size_t(y) * size + x ) * 4 ) );
+            }
+
+            Fft( columnRe.data(), columnIm.data(), size, reverse.data(), table.data(), false );
+
+            auto dx = ( x + size / 2 ) % size;
+            for(auto y=0; y<size; ++y)
+            {
+                auto r  = Load4( columnRe.data() + y * 4 );
+                auto i  = Load4( columnIm.data() + y * 4 );
+                auto dy = ( y + size / 2 ) % size;
+                power.Store( dx, dy, Madd( r, r, Mul( i, i ) ) );
+            }
+        }
+    });
+
+    if (!kernel.Create( size, size ))
+    { return false; }
+
+    // 回折像の広がりは波長に比例するので，緑を基準に拡大縮小して各チャンネルを求める.
+    auto center = float(size / 2);
+    ParallelFor( pPool, size, 8, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            for(auto x=0; x<size; ++x)
+            {
+                float rgb[3];
+                for(auto c=0; c<3; ++c)
+                {
+                    auto scale = WAVELENGTHS[1] / WAVELENGTHS[c];
+                    auto u = ( center + ( float(x) - center ) * scale + 0.5f ) / float(size);
+                    auto v = ( center + ( float(y) - center ) * scale + 0.5f ) / float(size);
+                    rgb[c] = GetElement( SampleLinearClamp( power, u, v ), c ) * scale * scale;
+                }
+                kernel.Store( x, y, Set4( rgb[0], rgb[1], rgb[2], 1.0f ) );
+            }
+        }
+    });
+
+    double sum[3] = { 0.0, 0.0, 0.0 };
+    for(auto y=0; y<size; ++y)
+    {
+        auto pRow = kernel.GetRow( y );
+        for(auto x=0; x<size; ++x)
+        {
+            for(auto c=0; c<3; ++c)
+            { sum[c] += pRow[x * 4 + c]; }
+        }
+    }
+
+    if (sum[0] <= 0.0 || sum[1] <= 0.0 || sum[2] <= 0.0)
+    { return false; }
+
+    auto scale = Set4( float( 1.0 / sum[0] ), float( 1.0 / sum[1] ), float( 1.0 / sum[2] ), 1.0f );
+    for(auto y=0; y<size; ++y)
+    {
+        for(auto x=0; x<size; ++x)
+        { kernel.Store( x, y, Mul( kernel.Fetch( x, y ), scale ) ); }
+    }
+
+    return true;
+}
+
+} // namespace glare
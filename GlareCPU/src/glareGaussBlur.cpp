@@ -0,0 +1,104 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareGaussBlur.cpp
+// Desc : Gauss Blur Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareGaussBlur.h>
+#include <glareThreadPool.h>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+//      ガウスの重みを計算します.
+//-------------------------------------------------------------------------------------------
+inline float GaussianDistribution( const glare::Vector2& pos, float rho )
+{ return exp( -( pos.x * pos.x + pos.y * pos.y ) / (2.0f * rho * rho )); }
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      ブラーパラメータを計算します.
+//-------------------------------------------------------------------------------------------
+GaussBlurParam CalcBlurParam( int width, int height, const Vector2& dir, float deviation, float multiply )
+{
+    GaussBlurParam result;
+    auto tu = 1.0f / float(width);
+    auto tv = 1.0f / float(height);
+
+    result.Offset[0].z = GaussianDistribution(Vector2(0.0f, 0.0f), deviation) * multiply;
+    auto total_weight = result.Offset[0].z;
+
+    result.Offset[0].x = 0.0f;
+    result.Offset[0].y = 0.0f;
+    result.Offset[0].w = 0.0f;
+
+    for(auto i=1; i<8; ++i)
+    {
+        result.Offset[i].x = dir.x * i * tu;
+        result.Offset[i].y = dir.y * i * tv;
+        result.Offset[i].z = GaussianDistribution( Vector2(dir.x * float(i), dir.y * float(i)), deviation ) * multiply;
+        result.Offset[i].w = 0.0f;
+        total_weight += result.Offset[i].z * 2.0f;
+    }
+
+    for(auto i=0; i<8; ++i)
+    {
+        result.Offset[i].z /= total_weight;
+    }
+    for(auto i=8; i<15; ++i)
+    {
+        result.Offset[i].x = -result.Offset[i - 7].x;
+        result.Offset[i].y = -result.Offset[i - 7].y;
+        result.Offset[i].z =  result.Offset[i - 7].z;
+        result.Offset[i].w = 0.0f;
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ブラーを掛けます.
+//-------------------------------------------------------------------------------------------
+void GaussBlur( const Image& src, const GaussBlurParam& param, Image& dst, ThreadPool* pPool )
+{
+    auto w = dst.GetWidth();
+    auto h = dst.GetHeight();
+    auto inv_w = 1.0f / float(w);
+    auto inv_h = 1.0f / float(h);
+    auto alpha = Set4( 0.0f, 0.0f, 0.0f, 1.0f );
+    auto mask  = Set4( 1.0f, 1.0f, 1.0f, 0.0f );
+
+    ParallelFor( pPool, h, 16, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto v = ( float(y) + 0.5f ) * inv_h;
+            auto dstRow = dst.GetRow( y );
+
+            for(auto x=0; x<w; ++x)
+            {
+                auto u = ( float(x) + 0.5f ) * inv_w;
+                auto result = Zero4();
+
+                for(auto i=0; i<GAUSS_BLUR_TAP_COUNT; ++i)
+                {
+                    auto& tap = param.Offset[i];
+                    result = Madd( Splat4( tap.z ), SampleLinearClamp( src, u + tap.x, v + tap.y ), result );
+                }
+
+                // result.w = 1.0f
+                Store4( dstRow + x * 4, Madd( result, mask, alpha ) );
+            }
+        }
+    });
+}
+
+} // namespace glare
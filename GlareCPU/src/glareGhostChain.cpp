@@ -0,0 +1,371 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareGhostChain.cpp
+// Desc : Ghost Chain Compiler Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareGhostChain.h>
+#include <glareLensGhost.h>
+#include <glareThreadPool.h>
+#include <cmath>
+#include <limits>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   ROW_TILE_SIZE   = 16;                                       //!< 1タスクで処理する行数です.
+const float F_INF           = std::numeric_limits<float>::infinity();   //!< 無限大です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Interval structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct Interval
+{
+    float   Min;        //!< 下限(含む)です.
+    float   Max;        //!< 上限(含む)です.
+
+    Interval()
+    : Min( F_INF ), Max( -F_INF )
+    { /* DO_NOTHING */ }
+
+    Interval( float min, float max )
+    : Min( min ), Max( max )
+    { /* DO_NOTHING */ }
+
+    bool IsEmpty() const
+    { return Min > Max; }
+};
+
+//-------------------------------------------------------------------------------------------
+//      2つの区間の共通部分を求めます.
+//-------------------------------------------------------------------------------------------
+Interval Intersect( const Interval& a, const Interval& b )
+{
+    return Interval(
+        ( a.Min > b.Min ) ? a.Min : b.Min,
+        ( a.Max < b.Max ) ? a.Max : b.Max );
+}
+
+//-------------------------------------------------------------------------------------------
+//      (t - 0.5) * scale + 0.5 が区間に入る t の範囲を求めます.
+//-------------------------------------------------------------------------------------------
+Interval InverseScale( const Interval& range, float scale )
+{
+    if (range.IsEmpty())
+    { return Interval(); }
+
+    if (scale == 0.0f)
+    {
+        return ( range.Min <= 0.5f && 0.5f <= range.Max )
+            ? Interval( -F_INF, F_INF )
+            : Interval();
+    }
+
+    auto a = ( range.Min - 0.5f ) / scale + 0.5f;
+    auto b = ( range.Max - 0.5f ) / scale + 0.5f;
+    return ( scale > 0.0f ) ? Interval( a, b ) : Interval( b, a );
+}
+
+//-------------------------------------------------------------------------------------------
+//      クランプ後の値が区間に入る範囲を求めます.
+//-------------------------------------------------------------------------------------------
+Interval InverseClamp( const Interval& range, float lo, float hi )
+{
+    auto result = Intersect( range, Interval( lo, hi ) );
+    if (result.IsEmpty())
+    { return result; }
+
+    // 端に届く場合はクランプで外側全体が同じ値になる.
+    if (result.Min <= lo) { result.Min = -F_INF; }
+    if (result.Max >= hi) { result.Max =  F_INF; }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      マスクが0でない値を返し得るテクスチャ座標の範囲を求めます.
+//-------------------------------------------------------------------------------------------
+bool FindMaskSupport( const glare::Image& mask, Interval& u, Interval& v )
+{
+    auto w = mask.GetWidth();
+    auto h = mask.GetHeight();
+    auto x0 = w, x1 = -1;
+    auto y0 = h, y1 = -1;
+
+    for(auto y=0; y<h; ++y)
+    {
+        auto pRow = mask.GetRow( y );
+        for(auto x=0; x<w; ++x)
+        {
+            if (pRow[x * 4] <= 0.0f)
+            { continue; }
+
+            if (x < x0) { x0 = x; }
+            if (x > x1) { x1 = x; }
+            if (y < y0) { y0 = y; }
+            if (y > y1) { y1 = y; }
+        }
+    }
+
+    if (x1 < 0)
+    { return false; }
+
+    // リニアサンプリングで隣接テクセルの重みが0でなくなる範囲まで広げる.
+    // 端のテクセルが0でなければ，クランプにより外側全体が範囲になる.
+    u.Min = ( x0 == 0 )     ? -F_INF : ( float(x0) - 0.5f ) / float(w);
+    u.Max = ( x1 == w - 1 ) ?  F_INF : ( float(x1) + 1.5f ) / float(w);
+    v.Min = ( y0 == 0 )     ? -F_INF : ( float(y0) - 0.5f ) / float(h);
+    v.Max = ( y1 == h - 1 ) ?  F_INF : ( float(y1) + 1.5f ) / float(h);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      項が寄与し得るピクセル範囲を1軸分求めます.
+//-------------------------------------------------------------------------------------------
+bool CalcPixelRange
+(
+    const Interval& support,
+    float           outerScale,
+    float           innerScale,
+    int             size,
+    int&            minPixel,
+    int&            maxPixel
+)
+{
+    // 1段目の描画結果はクランプでサンプリングされるので，テクセル中心の範囲に収める.
+    auto texelHalf = 0.5f / float(size);
+    auto inner = InverseClamp( InverseScale( support, innerScale ), texelHalf, 1.0f - texelHalf );
+
+    // 2段目のマスクと1段目のマスクが共に0でない範囲.
+    auto range = Intersect( support, inner );
+
+    // 画面上の範囲に戻す.
+    auto screen = Intersect( InverseScale( range, outerScale ), Interval( 0.0f, 1.0f ) );
+    if (screen.IsEmpty())
+    { return false; }
+
+    // 丸め誤差を考慮して1ピクセル広げる.
+    auto x0 = int(ceilf ( screen.Min * float(size) - 0.5f )) - 1;
+    auto x1 = int(floorf( screen.Max * float(size) - 0.5f )) + 1;
+    minPixel = ( x0 < 0 ) ? 0 : x0;
+    maxPixel = ( x1 >= size ) ? size - 1 : x1;
+
+    return minPixel <= maxPixel;
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      2段のゴーストを1段分の項のリストに展開します.
+//-------------------------------------------------------------------------------------------
+bool CompileGhostChain
+(
+    const LensGhostParam*           pRound0,
+    int                             count0,
+    const LensGhostParam*           pRound1,
+    int                             count1,
+    const Image&                    mask,
+    int                             width,
+    int                             height,
+    float                           threshold,
+    std::vector<GhostChainTerm>&    terms
+)
+{
+    terms.clear();
+
+    if (width <= 0 || height <= 0)
+    { return false; }
+
+    if (pRound0 == nullptr || pRound1 == nullptr || count0 <= 0 || count1 <= 0)
+    { return true; }
+
+    // マスクが全て0の場合は何も描画されない.
+    Interval supportU;
+    Interval supportV;
+    if (!FindMaskSupport( mask, supportU, supportV ))
+    { return true; }
+
+    terms.reserve( size_t(count0) * size_t(count1) );
+
+    for(auto j=0; j<count1; ++j)
+    {
+        auto& outer = pRound1[j].MultiplyColor;
+
+        for(auto i=0; i<count0; ++i)
+        {
+            auto& inner = pRound0[i].MultiplyColor;
+
+            GhostChainTerm term;
+            term.InnerColor = Vector4( inner.x, inner.y, inner.z, 0.0f );
+            term.OuterColor = Vector4( outer.x, outer.y, outer.z, 0.0f );
+            term.OuterScale = outer.w;
+            term.InnerScale = inner.w;
+            term.Group      = j;
+
+            // 寄与が小さい項を捨てる.
+            auto weight = inner.x * outer.x;
+            if (inner.y * outer.y > weight) { weight = inner.y * outer.y; }
+            if (inner.z * outer.z > weight) { weight = inner.z * outer.z; }
+            if (weight <= 0.0f || weight < threshold)
+            { continue; }
+
+            // 画面外になる項を捨てる.
+            if (!CalcPixelRange( supportU, term.OuterScale, term.InnerScale, width,  term.MinX, term.MaxX )
+             || !CalcPixelRange( supportV, term.OuterScale, term.InnerScale, height, term.MinY, term.MaxY ))
+            { continue; }
+
+            terms.push_back( term );
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      展開した項を加算合成してゴーストを描画します.
+//-------------------------------------------------------------------------------------------
+void DrawGhostChain
+(
+    const Image&                        src,
+    const Image&                        mask,
+    const std::vector<GhostChainTerm>&  terms,
+    Image&                              dst,
+    ThreadPool*                         pPool
+)
+{
+    auto w = dst.GetWidth();
+    auto h = dst.GetHeight();
+    auto count = int(terms.size());
+
+    // 1段目の描画結果をクランプでサンプリングした場合と同じ範囲に収める.
+    auto minU = 0.5f / float(w);
+    auto maxU = 1.0f - minU;
+    auto minV = 0.5f / float(h);
+    auto maxV = 1.0f - minV;
+
+    ParallelFor( pPool, h, ROW_TILE_SIZE, [&](int begin, int end)
+    {
+        auto alpha = Set4( 0.0f, 0.0f, 0.0f, 1.0f );
+
+        // 2段目のマスクと1段目の和は同じ2段目のゴーストから展開した項で共有する.
+        std::vector<float> outerMask( w );
+        std::vector<float> inner( size_t(w) * 4 );
+
+        for(auto y=begin; y<end; ++y)
+        {
+            auto tv   = ( float(y) + 0.5f ) / float(h);
+            auto pDst = dst.GetRow( y );
+
+            for(auto x=0; x<w; ++x)
+            { Store4( pDst + x * 4, Zero4() ); }
+
+            auto first = 0;
+            while (first < count)
+            {
+                // 同じ2段目のゴーストから展開した項の範囲.
+                auto last = first + 1;
+                while (last < count && terms[last].Group == terms[first].Group)
+                { last++; }
+
+                auto minX = w;
+                auto maxX = -1;
+                for(auto k=first; k<last; ++k)
+                {
+                    if (y < terms[k].MinY || y > terms[k].MaxY)
+                    { continue; }
+
+                    if (terms[k].MinX < minX) { minX = terms[k].MinX; }
+                    if (terms[k].MaxX > maxX) { maxX = terms[k].MaxX; }
+                }
+
+                if (minX > maxX)
+                {
+                    first = last;
+                    continue;
+                }
+
+                // 2段目の座標.
+                auto outerScale = terms[first].OuterScale;
+                auto v  = ( tv - 0.5f ) * outerScale + 0.5f;
+                auto du = outerScale / float(w);
+                auto u0 = ( 0.5f / float(w) - 0.5f ) * outerScale + 0.5f;
+
+                {
+                    RowSampler outerMaskRow;
+                    outerMaskRow.Setup( mask, v );
+
+                    for(auto x=minX; x<=maxX; ++x)
+                    {
+                        outerMask[x] = GetElement( outerMaskRow.Sample( u0 + float(x) * du ), 0 );
+                        Store4( &inner[x * 4], Zero4() );
+                    }
+                }
+
+                // 1段目の座標.
+                auto q = ( v < minV ) ? minV : ( v > maxV ) ? maxV : v;
+
+                for(auto k=first; k<last; ++k)
+                {
+                    auto& term = terms[k];
+                    if (y < term.MinY || y > term.MaxY)
+                    { continue; }
+
+                    auto color = Set4( term.InnerColor.x, term.InnerColor.y, term.InnerColor.z, 0.0f );
+                    auto vi    = ( q - 0.5f ) * term.InnerScale + 0.5f;
+
+                    RowSampler innerMaskRow;
+                    RowSampler colorRow;
+                    innerMaskRow.Setup( mask, vi );
+                    colorRow    .Setup( src,  vi );
+
+                    for(auto x=term.MinX; x<=term.MaxX; ++x)
+                    {
+                        if (outerMask[x] <= 0.0f)
+                        { continue; }
+
+                        auto u  = u0 + float(x) * du;
+                        auto p  = ( u < minU ) ? minU : ( u > maxU ) ? maxU : u;
+                        auto ui = ( p - 0.5f ) * term.InnerScale + 0.5f;
+
+                        auto factor = SplatX( innerMaskRow.Sample( ui ) );
+                        auto texel  = colorRow.Sample( ui );
+                        auto accum  = Load4( &inner[x * 4] );
+                        Store4( &inner[x * 4], Madd( Mul( texel, color ), factor, accum ) );
+                    }
+                }
+
+                // 1段目の描画結果はUNORMターゲットへの加算合成で飽和しているので，
+                // 飽和させてから2段目の乗算カラーとマスクを掛ける.
+                auto& outer = terms[first].OuterColor;
+                auto color = Set4( outer.x, outer.y, outer.z, 0.0f );
+                for(auto x=minX; x<=maxX; ++x)
+                {
+                    if (outerMask[x] <= 0.0f)
+                    { continue; }
+
+                    auto texel = Saturate( Load4( &inner[x * 4] ) );
+                    auto accum = Load4( pDst + x * 4 );
+                    Store4( pDst + x * 4, Madd( Mul( texel, color ), Splat4( outerMask[x] ), accum ) );
+                }
+
+                first = last;
+            }
+
+            // UNORMターゲットへの加算合成は飽和する.
+            for(auto x=0; x<w; ++x)
+            { Store4( pDst + x * 4, Add( Saturate( Load4( pDst + x * 4 ) ), alpha ) ); }
+        }
+    });
+}
+
+} // namespace glare
@@ -0,0 +1,129 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareImage.cpp
+// Desc : Image Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareThreadPool.h>
+
+
+namespace glare {
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Image class
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------
+Image::Image()
+: m_Width   ( 0 )
+, m_Height  ( 0 )
+, m_Pixels  ()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------
+Image::~Image()
+{ Release(); }
+
+//-------------------------------------------------------------------------------------------
+//      画像を生成します.
+//-------------------------------------------------------------------------------------------
+bool Image::Create( int width, int height )
+{
+    if (width <= 0 || height <= 0)
+    { return false; }
+
+    // サイズが同じであれば再確保しない.
+    if (width == m_Width && height == m_Height)
+    { return true; }
+
+    m_Pixels.assign( size_t(width) * size_t(height) * 4, 0.0f );
+    m_Width  = width;
+    m_Height = height;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      メモリ解放処理です.
+//-------------------------------------------------------------------------------------------
+void Image::Release()
+{
+    m_Pixels.clear();
+    m_Pixels.shrink_to_fit();
+    m_Width  = 0;
+    m_Height = 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//      指定色で塗りつぶします.
+//-------------------------------------------------------------------------------------------
+void Image::Clear( float r, float g, float b, float a )
+{
+    auto color = Set4( r, g, b, a );
+    auto count = size_t(m_Width) * size_t(m_Height);
+    auto ptr   = m_Pixels.data();
+
+    for(size_t i=0; i<count; ++i)
+    { Store4( ptr + i * 4, color ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      ボックスフィルタで縮小します.
+//-------------------------------------------------------------------------------------------
+bool Downsample( const Image& src, int factor, Image& dst, ThreadPool* pPool )
+{
+    if (factor <= 0)
+    { return false; }
+
+    auto w = src.GetWidth()  / factor;
+    auto h = src.GetHeight() / factor;
+    if (w <= 0) { w = 1; }
+    if (h <= 0) { h = 1; }
+
+    if (!dst.Create( w, h ))
+    { return false; }
+
+    auto sw = src.GetWidth();
+    auto sh = src.GetHeight();
+    auto weight = Splat4( 1.0f / float(factor * factor) );
+
+    ParallelFor( pPool, h, 8, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto dstRow = dst.GetRow( y );
+
+            for(auto x=0; x<w; ++x)
+            {
+                auto sum = Zero4();
+                for(auto j=0; j<factor; ++j)
+                {
+                    auto sy = y * factor + j;
+                    if (sy >= sh) { sy = sh - 1; }
+
+                    auto srcRow = src.GetRow( sy );
+                    for(auto i=0; i<factor; ++i)
+                    {
+                        auto sx = x * factor + i;
+                        if (sx >= sw) { sx = sw - 1; }
+                        sum = Add( sum, Load4( srcRow + sx * 4 ) );
+                    }
+                }
+
+                Store4( dstRow + x * 4, Mul( sum, weight ) );
+            }
+        }
+    });
+
+    return true;
+}
+
+} // namespace glare
@@ -0,0 +1,381 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareImageFile.cpp
+// Desc : Image File Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImageFile.h>
+#include <glareMapFile.h>
+#include <glareMapWriter.h>
+#include <glareThreadPool.h>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   MAX_IMAGE_SIZE  = 65536;        //!< 受け付ける縦横の最大サイズです.
+
+
+//-------------------------------------------------------------------------------------------
+//      ファイル全体を読み込みます.
+//-------------------------------------------------------------------------------------------
+bool ReadFile( const char* filename, std::vector<uint8_t>& data )
+{
+    FILE* pFile = fopen( filename, "rb" );
+    if (pFile == nullptr)
+    { return false; }
+
+    auto success = ( fseek( pFile, 0, SEEK_END ) == 0 );
+    auto size    = ( success ) ? ftell( pFile ) : -1L;
+    success = success && ( size >= 0 ) && ( fseek( pFile, 0, SEEK_SET ) == 0 );
+
+    if (success)
+    {
+        data.resize( size_t(size) );
+        success = ( size == 0 ) || ( fread( data.data(), 1, data.size(), pFile ) == data.size() );
+    }
+
+    fclose( pFile );
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ファイル全体を1回で書き込みます.
+//-------------------------------------------------------------------------------------------
+bool WriteFile( const char* filename, const std::vector<uint8_t>& data )
+{
+    FILE* pFile = fopen( filename, "wb" );
+    if (pFile == nullptr)
+    { return false; }
+
+    auto success = ( fwrite( data.data(), 1, data.size(), pFile ) == data.size() );
+    success &= ( fclose( pFile ) == 0 );
+    return success;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// HeaderReader structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct HeaderReader
+{
+    const uint8_t*  pCur;       //!< 現在位置です.
+    const uint8_t*  pEnd;       //!< 終端です.
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      空白とコメントを読み飛ばして，次のトークンを取得します.
+    //---------------------------------------------------------------------------------------
+    bool Next( char* pToken, size_t size )
+    {
+        for(;;)
+        {
+            while(pCur < pEnd && isspace( *pCur ))
+            { pCur++; }
+
+            if (pCur < pEnd && *pCur == '#')
+            {
+                while(pCur < pEnd && *pCur != '\n')
+                { pCur++; }
+                continue;
+            }
+            break;
+        }
+
+        size_t n = 0;
+        while(pCur < pEnd && !isspace( *pCur ) && n + 1 < size)
+        { pToken[n++] = char(*pCur++); }
+        pToken[n] = '\0';
+
+        return n > 0;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      次のトークンを整数として取得します.
+    //---------------------------------------------------------------------------------------
+    bool NextInt( int& value )
+    {
+        char token[32];
+        if (!Next( token, sizeof(token) ))
+        { return false; }
+
+        char* pEnd = nullptr;
+        auto  v    = strtol( token, &pEnd, 10 );
+        if (*pEnd != '\0' || v <= 0 || v > MAX_IMAGE_SIZE)
+        { return false; }
+
+        value = int(v);
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ヘッダ終端の空白1文字を読み飛ばします.
+    //---------------------------------------------------------------------------------------
+    bool SkipSeparator()
+    {
+        if (pCur >= pEnd || !isspace( *pCur ))
+        { return false; }
+
+        pCur++;
+        return true;
+    }
+};
+
+//-------------------------------------------------------------------------------------------
+//      PPM(P6)をデコードします.
+//-------------------------------------------------------------------------------------------
+bool LoadPPM( const std::vector<uint8_t>& data, glare::Image& image )
+{
+    HeaderReader reader = { data.data(), data.data() + data.size() };
+
+    char magic[4];
+    int  width, height, maxValue;
+    if (!reader.Next( magic, sizeof(magic) ) || strcmp( magic, "P6" ) != 0
+     || !reader.NextInt( width ) || !reader.NextInt( height ) || !reader.NextInt( maxValue )
+     || !reader.SkipSeparator())
+    { return false; }
+
+    // 最大値が256以上の場合は16bitビッグエンディアン.
+    auto wide  = ( maxValue > 255 );
+    auto bytes = size_t(width) * size_t(height) * 3 * ( ( wide ) ? 2 : 1 );
+    if (maxValue > 65535 || size_t(reader.pEnd - reader.pCur) < bytes)
+    { return false; }
+
+    if (!image.Create( width, height ))
+    { return false; }
+
+    auto scale = 1.0f / float(maxValue);
+    auto pSrc  = reader.pCur;
+    for(auto y=0; y<height; ++y)
+    {
+        auto pDst = image.GetRow( y );
+        for(auto x=0; x<width; ++x)
+        {
+            for(auto c=0; c<3; ++c)
+            {
+                auto value = ( wide ) ? ( ( pSrc[0] << 8 ) | pSrc[1] ) : pSrc[0];
+                pSrc += ( wide ) ? 2 : 1;
+                pDst[x * 4 + c] = float(value) * scale;
+            }
+            pDst[x * 4 + 3] = 1.0f;
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      PFMをデコードします.
+//-------------------------------------------------------------------------------------------
+bool LoadPFM( const std::vector<uint8_t>& data, glare::Image& image )
+{
+    HeaderReader reader = { data.data(), data.data() + data.size() };
+
+    char magic[4];
+    char scaleText[32];
+    int  width, height;
+    if (!reader.Next( magic, sizeof(magic) )
+     || ( strcmp( magic, "PF" ) != 0 && strcmp( magic, "Pf" ) != 0 )
+     || !reader.NextInt( width ) || !reader.NextInt( height )
+     || !reader.Next( scaleText, sizeof(scaleText) )
+     || !reader.SkipSeparator())
+    { return false; }
+
+    // スケールの符号が負ならリトルエンディアン.
+    auto channels = ( magic[1] == 'F' ) ? 3 : 1;
+    auto little   = ( atof( scaleText ) < 0.0 );
+    auto bytes    = size_t(width) * size_t(height) * size_t(channels) * sizeof(float);
+    if (size_t(reader.pEnd - reader.pCur) < bytes)
+    { return false; }
+
+    if (!image.Create( width, height ))
+    { return false; }
+
+    // 行は下から上に並んでいる.
+    auto pSrc = reader.pCur;
+    for(auto y=height - 1; y>=0; --y)
+    {
+        auto pDst = image.GetRow( y );
+        for(auto x=0; x<width; ++x)
+        {
+            float texel[3];
+            for(auto c=0; c<channels; ++c)
+            {
+                uint32_t bits = ( little )
+                    ? ( uint32_t(pSrc[0]) | ( uint32_t(pSrc[1]) << 8 ) | ( uint32_t(pSrc[2]) << 16 ) | ( uint32_t(pSrc[3]) << 24 ) )
+                    : ( uint32_t(pSrc[3]) | ( uint32_t(pSrc[2]) << 8 ) | ( uint32_t(pSrc[1]) << 16 ) | ( uint32_t(pSrc[0]) << 24 ) );
+                memcpy( &texel[c], &bits, sizeof(float) );
+                pSrc += 4;
+            }
+
+            pDst[x * 4 + 0] = texel[0];
+            pDst[x * 4 + 1] = texel[( channels == 3 ) ? 1 : 0];
+            pDst[x * 4 + 2] = texel[( channels == 3 ) ? 2 : 0];
+            pDst[x * 4 + 3] = 1.0f;
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ヘッダ文字列を書き込みます.
+//-------------------------------------------------------------------------------------------
+size_t WriteHeader( std::vector<uint8_t>& data, const char* format, int width, int height, const char* last )
+{
+    char header[64];
+    auto length = snprintf( header, sizeof(header), format, width, height, last );
+    data.assign( header, header + length );
+    return size_t(length);
+}
+
+//-------------------------------------------------------------------------------------------
+//      PPM(P6, 8bit)にエンコードします.
+//-------------------------------------------------------------------------------------------
+void EncodePPM( const glare::Image& image, std::vector<uint8_t>& data, glare::ThreadPool* pPool )
+{
+    auto w      = image.GetWidth();
+    auto h      = image.GetHeight();
+    auto offset = WriteHeader( data, "P6\n%d %d\n%s\n", w, h, "255" );
+    data.resize( offset + size_t(w) * size_t(h) * 3 );
+
+    glare::ParallelFor( pPool, h, 16, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto pSrc = image.GetRow( y );
+            auto pDst = data.data() + offset + size_t(y) * size_t(w) * 3;
+            for(auto x=0; x<w; ++x)
+            {
+                for(auto c=0; c<3; ++c)
+                {
+                    auto v = pSrc[x * 4 + c];
+                    v = ( v > 0.0f ) ? ( ( v < 1.0f ) ? v : 1.0f ) : 0.0f;
+                    pDst[x * 3 + c] = uint8_t( v * 255.0f + 0.5f );
+                }
+            }
+        }
+    });
+}
+
+//-------------------------------------------------------------------------------------------
+//      PFM(PF, リトルエンディアン)にエンコードします.
+//-------------------------------------------------------------------------------------------
+void EncodePFM( const glare::Image& image, std::vector<uint8_t>& data, glare::ThreadPool* pPool )
+{
+    auto w      = image.GetWidth();
+    auto h      = image.GetHeight();
+    auto offset = WriteHeader( data, "PF\n%d %d\n%s\n", w, h, "-1.0" );
+    data.resize( offset + size_t(w) * size_t(h) * 3 * sizeof(float) );
+
+    glare::ParallelFor( pPool, h, 16, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto pSrc = image.GetRow( y );
+            auto pDst = data.data() + offset + size_t(h - 1 - y) * size_t(w) * 3 * sizeof(float);
+            for(auto x=0; x<w; ++x)
+            {
+                for(auto c=0; c<3; ++c)
+                {
+                    uint32_t bits;
+                    memcpy( &bits, &pSrc[x * 4 + c], sizeof(bits) );
+                    pDst[0] = uint8_t( bits >>  0 );
+                    pDst[1] = uint8_t( bits >>  8 );
+                    pDst[2] = uint8_t( bits >> 16 );
+                    pDst[3] = uint8_t( bits >> 24 );
+                    pDst += 4;
+                }
+            }
+        }
+    });
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      拡張子からファイル形式を判定します.
+//-------------------------------------------------------------------------------------------
+IMAGE_FILE_TYPE GetImageFileType( const char* filename )
+{
+    if (filename == nullptr)
+    { return IMAGE_FILE_TYPE_UNKNOWN; }
+
+    auto pExt = strrchr( filename, '.' );
+    if (pExt == nullptr || strlen( pExt ) != 4)
+    { return IMAGE_FILE_TYPE_UNKNOWN; }
+
+    char ext[4];
+    for(auto i=0; i<3; ++i)
+    { ext[i] = char( tolower( pExt[i + 1] ) ); }
+    ext[3] = '\0';
+
+    if (strcmp( ext, "map" ) == 0) { return IMAGE_FILE_TYPE_MAP; }
+    if (strcmp( ext, "ppm" ) == 0) { return IMAGE_FILE_TYPE_PPM; }
+    if (strcmp( ext, "pfm" ) == 0) { return IMAGE_FILE_TYPE_PFM; }
+
+    return IMAGE_FILE_TYPE_UNKNOWN;
+}
+
+//-------------------------------------------------------------------------------------------
+//      画像ファイルを読み込みます.
+//-------------------------------------------------------------------------------------------
+bool LoadImageFile( const char* filename, Image& image )
+{
+    auto type = GetImageFileType( filename );
+    if (type == IMAGE_FILE_TYPE_MAP)
+    { return LoadMapFile( filename, image ); }
+
+    if (type == IMAGE_FILE_TYPE_UNKNOWN)
+    { return false; }
+
+    std::vector<uint8_t> data;
+    if (!ReadFile( filename, data ))
+    { return false; }
+
+    return ( type == IMAGE_FILE_TYPE_PPM )
+        ? LoadPPM( data, image )
+        : LoadPFM( data, image );
+}
+
+//-------------------------------------------------------------------------------------------
+//      画像ファイルに書き出します.
+//-------------------------------------------------------------------------------------------
+bool SaveImageFile( const char* filename, const Image& image, ThreadPool* pPool )
+{
+    if (image.GetWidth() <= 0 || image.GetHeight() <= 0)
+    { return false; }
+
+    auto type = GetImageFileType( filename );
+    if (type == IMAGE_FILE_TYPE_MAP)
+    {
+        auto desc = GetDefaultMapWriteDesc();
+        desc.Format   = MAP_FORMAT_R16G16B16A16_FLOAT;
+        desc.MipCount = 1;
+        return SaveMapFile( filename, &image, 1, desc, pPool );
+    }
+
+    if (type == IMAGE_FILE_TYPE_UNKNOWN)
+    { return false; }
+
+    std::vector<uint8_t> data;
+    if (type == IMAGE_FILE_TYPE_PPM)
+    { EncodePPM( image, data, pPool ); }
+    else
+    { EncodePFM( image, data, pPool ); }
+
+    return WriteFile( filename, data );
+}
+
+} // namespace glare
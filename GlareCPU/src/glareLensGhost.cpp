@@ -0,0 +1,571 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareLensGhost.cpp
+// Desc : Lens Ghost Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareLensGhost.h>
+#include <glareGaussBlur.h>
+#include <glareThreadPool.h>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   DOWNSAMPLE_FACTOR   = 4;        //!< ブラーを掛ける解像度の縮小率です.
+const int   ROW_TILE_SIZE       = 16;       //!< 1タスクで処理する行数です.
+const int   FUSED_BATCH_SIZE    = 16;       //!< 融合描画で1度に累積するゴースト数です.
+
+// 乗算カラー / テクスチャスケール(1段目).
+const glare::LensGhostParam DEFAULT_GHOSTS0[] = {
+    { glare::Vector4(1.0f,  0.5f,  0.6f, -1.2f) },
+    { glare::Vector4(0.3f,  1.0f,  0.6f, -1.2f) },
+    { glare::Vector4(0.6f,  0.35f, 1.0f, -1.5f) },
+    { glare::Vector4(1.0f,  0.6f,  0.3f, -1.75f) },
+    { glare::Vector4(0.25f, 1.0f,  0.7f, 1.2f) },
+    { glare::Vector4(0.5f,  0.9f,  1.0f, 1.35f) },
+    { glare::Vector4(0.3f,  1.0f,  0.5f, 1.5f) },
+    { glare::Vector4(0.7f,  0.5f,  1.0f, 2.0f) },
+};
+
+// 乗算カラー / テクスチャスケール(2段目).
+const glare::LensGhostParam DEFAULT_GHOSTS1[] = {
+    { glare::Vector4(0.1f, 0.7f, 1.0f, 1.0f) },
+    { glare::Vector4(1.0f, 0.3f, 0.6f, 2.5f) },
+    { glare::Vector4(0.3f, 0.8f, 0.8f, 2.3f) },
+    { glare::Vector4(0.8f, 0.2f, 0.7f, 3.95f) },
+    { glare::Vector4(0.2f, 0.1f, 0.9f, -1.5f) },
+    { glare::Vector4(0.9f, 0.1f, 0.2f, -1.7f) },
+    { glare::Vector4(0.1f, 0.8f, 0.3f, -2.25f) },
+    { glare::Vector4(0.9f, 0.2f, 0.1f, -3.35f) },
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// GhostTerm structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct GhostTerm
+{
+    float   Color[4];       //!< 乗算カラーです(w = 0).
+    float   Scale;          //!< テクスチャスケールです.
+    float   U0;             //!< 行頭のテクスチャ座標(u)です.
+    float   DU;             //!< 1ピクセルあたりのテクスチャ座標(u)の増分です.
+};
+
+//-------------------------------------------------------------------------------------------
+//      ゴーストパラメータから行によらない値を求めます.
+//-------------------------------------------------------------------------------------------
+GhostTerm MakeGhostTerm( const glare::LensGhostParam& ghost, int width )
+{
+    GhostTerm result;
+    result.Color[0] = ghost.MultiplyColor.x;
+    result.Color[1] = ghost.MultiplyColor.y;
+    result.Color[2] = ghost.MultiplyColor.z;
+    result.Color[3] = 0.0f;
+    result.Scale    = ghost.MultiplyColor.w;
+
+    // uv = (uv - 0.5) * Scale + 0.5 は x について線形なので行頭と増分から求める.
+    result.DU = result.Scale / float(width);
+    result.U0 = ( 0.5f / float(width) - 0.5f ) * result.Scale + 0.5f;
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      スカラー実装のリニアサンプリングです.
+//-------------------------------------------------------------------------------------------
+void SampleReference( const glare::Image& image, float u, float v, float* pResult )
+{
+    auto w = image.GetWidth();
+    auto h = image.GetHeight();
+
+    auto fx = u * float(w) - 0.5f;
+    auto fy = v * float(h) - 0.5f;
+    auto x0 = int(floorf( fx ));
+    auto y0 = int(floorf( fy ));
+    auto tx = fx - floorf( fx );
+    auto ty = fy - floorf( fy );
+
+    int xs[2] = { x0, x0 + 1 };
+    int ys[2] = { y0, y0 + 1 };
+    for(auto i=0; i<2; ++i)
+    {
+        if (xs[i] < 0)  { xs[i] = 0; }
+        if (xs[i] >= w) { xs[i] = w - 1; }
+        if (ys[i] < 0)  { ys[i] = 0; }
+        if (ys[i] >= h) { ys[i] = h - 1; }
+    }
+
+    auto p00 = image.GetRow( ys[0] ) + xs[0] * 4;
+    auto p10 = image.GetRow( ys[0] ) + xs[1] * 4;
+    auto p01 = image.GetRow( ys[1] ) + xs[0] * 4;
+    auto p11 = image.GetRow( ys[1] ) + xs[1] * 4;
+
+    for(auto c=0; c<4; ++c)
+    {
+        auto top    = p00[c] + ( p10[c] - p00[c] ) * tx;
+        auto bottom = p01[c] + ( p11[c] - p01[c] ) * tx;
+        pResult[c]  = top + ( bottom - top ) * ty;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      スカラー実装のガウスブラーです.
+//-------------------------------------------------------------------------------------------
+void GaussBlurReference( const glare::Image& src, const glare::GaussBlurParam& param, glare::Image& dst )
+{
+    for(auto y=0; y<dst.GetHeight(); ++y)
+    {
+        for(auto x=0; x<dst.GetWidth(); ++x)
+        {
+            auto u = ( float(x) + 0.5f ) / float(dst.GetWidth());
+            auto v = ( float(y) + 0.5f ) / float(dst.GetHeight());
+
+            float result[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for(auto i=0; i<glare::GAUSS_BLUR_TAP_COUNT; ++i)
+            {
+                float color[4];
+                SampleReference( src, u + param.Offset[i].x, v + param.Offset[i].y, color );
+                for(auto c=0; c<4; ++c)
+                { result[c] += param.Offset[i].z * color[c]; }
+            }
+            result[3] = 1.0f;
+
+            dst.Store( x, y, glare::Load4( result ) );
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      スカラー実装のゴースト描画です.
+//-------------------------------------------------------------------------------------------
+void DrawGhostsReference
+(
+    const glare::Image&                         src,
+    const glare::Image&                         mask,
+    const std::vector<glare::LensGhostParam>&   ghosts,
+    glare::Image&                               dst
+)
+{
+    for(auto y=0; y<dst.GetHeight(); ++y)
+    {
+        for(auto x=0; x<dst.GetWidth(); ++x)
+        {
+            auto tu = ( float(x) + 0.5f ) / float(dst.GetWidth());
+            auto tv = ( float(y) + 0.5f ) / float(dst.GetHeight());
+
+            // クリアカラー(0, 0, 0, 1)に加算合成.
+            float result[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            for(auto& ghost : ghosts)
+            {
+                auto scale = ghost.MultiplyColor.w;
+                auto u = ( tu - 0.5f ) * scale + 0.5f;
+                auto v = ( tv - 0.5f ) * scale + 0.5f;
+
+                float color[4];
+                float factor[4];
+                SampleReference( src,  u, v, color );
+                SampleReference( mask, u, v, factor );
+
+                result[0] += color[0] * ghost.MultiplyColor.x * factor[0];
+                result[1] += color[1] * ghost.MultiplyColor.y * factor[0];
+                result[2] += color[2] * ghost.MultiplyColor.z * factor[0];
+            }
+
+            // UNORMターゲットへの加算合成は飽和する.
+            for(auto c=0; c<3; ++c)
+            { result[c] = ( result[c] > 1.0f ) ? 1.0f : result[c]; }
+
+            dst.Store( x, y, glare::Load4( result ) );
+        }
+    }
+}
+
+} // namespace
+
+
+namespace glare {
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// LensGhost class
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------
+LensGhost::LensGhost()
+: m_pPool           ( nullptr )
+, m_Width           ( 0 )
+, m_Height          ( 0 )
+, m_Deviation       ( 5.0f )
+, m_Mode            ( LENS_GHOST_MODE_FUSED )
+, m_ChainThreshold  ( 0.0f )
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------
+LensGhost::~LensGhost()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------
+//      初期化処理です.
+//-------------------------------------------------------------------------------------------
+bool LensGhost::Init( int width, int height, ThreadPool* pPool )
+{
+    if (width < DOWNSAMPLE_FACTOR || height < DOWNSAMPLE_FACTOR)
+    { return false; }
+
+    m_pPool  = pPool;
+    m_Width  = width;
+    m_Height = height;
+
+    for(auto i=0; i<2; i++)
+    {
+        if (!m_WorkBuffer[i].Create( width, height ))
+        { return false; }
+    }
+
+    for(auto i=2; i<4; i++)
+    {
+        if (!m_WorkBuffer[i].Create( width / DOWNSAMPLE_FACTOR, height / DOWNSAMPLE_FACTOR ))
+        { return false; }
+    }
+
+    SetGhostParams( 0, DEFAULT_GHOSTS0, int(sizeof(DEFAULT_GHOSTS0) / sizeof(DEFAULT_GHOSTS0[0])) );
+    SetGhostParams( 1, DEFAULT_GHOSTS1, int(sizeof(DEFAULT_GHOSTS1) / sizeof(DEFAULT_GHOSTS1[0])) );
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      終了処理です.
+//-------------------------------------------------------------------------------------------
+void LensGhost::Term()
+{
+    for(auto i=0; i<4; i++)
+    { m_WorkBuffer[i].Release(); }
+
+    m_Downsample.Release();
+
+    for(auto i=0; i<LENS_GHOST_ROUND_COUNT; ++i)
+    { m_Ghosts[i].clear(); }
+
+    m_ChainTerms.clear();
+
+    m_pPool  = nullptr;
+    m_Width  = 0;
+    m_Height = 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ゴーストパラメータを設定します.
+//-------------------------------------------------------------------------------------------
+void LensGhost::SetGhostParams( int round, const LensGhostParam* pParams, int count )
+{
+    if (round < 0 || round >= LENS_GHOST_ROUND_COUNT)
+    { return; }
+
+    if (pParams == nullptr || count <= 0)
+    {
+        m_Ghosts[round].clear();
+        return;
+    }
+
+    m_Ghosts[round].assign( pParams, pParams + count );
+}
+
+//-------------------------------------------------------------------------------------------
+//      ブラーの標準偏差を設定します.
+//-------------------------------------------------------------------------------------------
+void LensGhost::SetDeviation( float deviation )
+{ m_Deviation = deviation; }
+
+//-------------------------------------------------------------------------------------------
+//      ゴーストの描画方法を設定します.
+//-------------------------------------------------------------------------------------------
+void LensGhost::SetMode( LENS_GHOST_MODE mode )
+{ m_Mode = mode; }
+
+//-------------------------------------------------------------------------------------------
+//      ゴーストの描画方法を取得します.
+//-------------------------------------------------------------------------------------------
+LENS_GHOST_MODE LensGhost::GetMode() const
+{ return m_Mode; }
+
+//-------------------------------------------------------------------------------------------
+//      LENS_GHOST_MODE_CHAIN で項を捨てる閾値を設定します.
+//-------------------------------------------------------------------------------------------
+void LensGhost::SetChainThreshold( float threshold )
+{ m_ChainThreshold = threshold; }
+
+//-------------------------------------------------------------------------------------------
+//      直前の LENS_GHOST_MODE_CHAIN の描画で評価した項数を取得します.
+//-------------------------------------------------------------------------------------------
+int LensGhost::GetChainTermCount() const
+{ return int(m_ChainTerms.size()); }
+
+//-------------------------------------------------------------------------------------------
+//      作業バッファを取得します.
+//-------------------------------------------------------------------------------------------
+const Image& LensGhost::GetWorkBuffer( int index ) const
+{ return m_WorkBuffer[index]; }
+
+//-------------------------------------------------------------------------------------------
+//      レンズゴーストを適用します.
+//-------------------------------------------------------------------------------------------
+void LensGhost::Execute( const Image& input, const Image& mask, Image& output )
+{
+    auto w = m_Width;
+    auto h = m_Height;
+
+    // 入力画像にガウスブラーを掛ける.
+    // GPU版は1/4ビューポートへの描画でミップレベル2がフェッチされるので，同じ解像度に縮小してから処理.
+    {
+        Downsample( input, DOWNSAMPLE_FACTOR, m_Downsample, m_pPool );
+
+        auto param = CalcBlurParam( w, h, Vector2(1.0f, 0.0f), m_Deviation );
+        GaussBlur( m_Downsample, param, m_WorkBuffer[2], m_pPool );
+
+        param = CalcBlurParam( w, h, Vector2(0.0f, 1.0f), m_Deviation );
+        GaussBlur( m_WorkBuffer[2], param, m_WorkBuffer[3], m_pPool );
+    }
+
+    if (m_Mode == LENS_GHOST_MODE_CHAIN)
+    {
+        // 2段分のゴーストを展開し，WorkBuffer[3]から直接生成.
+        CompileGhostChain(
+            m_Ghosts[0].data(), int(m_Ghosts[0].size()),
+            m_Ghosts[1].data(), int(m_Ghosts[1].size()),
+            mask, w, h, m_ChainThreshold, m_ChainTerms );
+
+        DrawGhostChain( m_WorkBuffer[3], mask, m_ChainTerms, m_WorkBuffer[1], m_pPool );
+    }
+    else
+    {
+        // ゴーストを生成.
+        DrawGhosts( m_WorkBuffer[3], mask, m_Ghosts[0], m_WorkBuffer[0] );
+
+        // WorkBuffer[0]を元にゴーストを生成.
+        DrawGhosts( m_WorkBuffer[0], mask, m_Ghosts[1], m_WorkBuffer[1] );
+    }
+
+    // コンポジット.
+    {
+        if (!output.Create( w, h ))
+        { return; }
+
+        auto alpha   = Set4( 0.0f, 0.0f, 0.0f, 1.0f );
+        auto rgbMask = Set4( 1.0f, 1.0f, 1.0f, 0.0f );
+        auto same    = ( input.GetWidth() == w && input.GetHeight() == h );
+
+        ParallelFor( m_pPool, h, ROW_TILE_SIZE, [&](int begin, int end)
+        {
+            for(auto y=begin; y<end; ++y)
+            {
+                auto pGhost = m_WorkBuffer[1].GetRow( y );
+                auto pDst   = output.GetRow( y );
+                auto v      = ( float(y) + 0.5f ) / float(h);
+
+                for(auto x=0; x<w; ++x)
+                {
+                    auto color = ( same )
+                        ? input.Fetch( x, y )
+                        : SampleLinearClamp( input, ( float(x) + 0.5f ) / float(w), v );
+
+                    auto result = Add( color, Load4( pGhost + x * 4 ) );
+                    result = Madd( Saturate( result ), rgbMask, alpha );
+                    Store4( pDst + x * 4, result );
+                }
+            }
+        });
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      検証用のスカラー実装でレンズゴーストを適用します.
+//-------------------------------------------------------------------------------------------
+void LensGhost::ExecuteReference( const Image& input, const Image& mask, Image& output )
+{
+    auto w = m_Width;
+    auto h = m_Height;
+
+    Downsample( input, DOWNSAMPLE_FACTOR, m_Downsample );
+    GaussBlurReference( m_Downsample, CalcBlurParam( w, h, Vector2(1.0f, 0.0f), m_Deviation ), m_WorkBuffer[2] );
+    GaussBlurReference( m_WorkBuffer[2], CalcBlurParam( w, h, Vector2(0.0f, 1.0f), m_Deviation ), m_WorkBuffer[3] );
+
+    DrawGhostsReference( m_WorkBuffer[3], mask, m_Ghosts[0], m_WorkBuffer[0] );
+    DrawGhostsReference( m_WorkBuffer[0], mask, m_Ghosts[1], m_WorkBuffer[1] );
+
+    if (!output.Create( w, h ))
+    { return; }
+
+    for(auto y=0; y<h; ++y)
+    {
+        for(auto x=0; x<w; ++x)
+        {
+            float color[4];
+            float ghost[4];
+            SampleReference( input, ( float(x) + 0.5f ) / float(w), ( float(y) + 0.5f ) / float(h), color );
+            SampleReference( m_WorkBuffer[1], ( float(x) + 0.5f ) / float(w), ( float(y) + 0.5f ) / float(h), ghost );
+
+            float result[4];
+            for(auto c=0; c<3; ++c)
+            {
+                auto value = color[c] + ghost[c];
+                result[c] = ( value < 0.0f ) ? 0.0f : ( value > 1.0f ) ? 1.0f : value;
+            }
+            result[3] = 1.0f;
+
+            output.Store( x, y, Load4( result ) );
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      ゴーストを描画します.
+//-------------------------------------------------------------------------------------------
+void LensGhost::DrawGhosts
+(
+    const Image&                        src,
+    const Image&                        mask,
+    const std::vector<LensGhostParam>&  ghosts,
+    Image&                              dst
+)
+{
+    if (m_Mode == LENS_GHOST_MODE_MULTI_PASS)
+    { DrawGhostsMultiPass( src, mask, ghosts, dst ); }
+    else
+    { DrawGhostsFused( src, mask, ghosts, dst ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      ゴースト1枚ごとに全画面を加算合成します.
+//-------------------------------------------------------------------------------------------
+void LensGhost::DrawGhostsMultiPass
+(
+    const Image&                        src,
+    const Image&                        mask,
+    const std::vector<LensGhostParam>&  ghosts,
+    Image&                              dst
+)
+{
+    auto w = dst.GetWidth();
+    auto h = dst.GetHeight();
+
+    // クリアカラーは(0, 0, 0, 1).
+    dst.Clear( 0.0f, 0.0f, 0.0f, 1.0f );
+
+    // GPU版と同じく1枚ずつ全画面に加算合成する.
+    for(auto& ghost : ghosts)
+    {
+        auto term  = MakeGhostTerm( ghost, w );
+        auto color = Load4( term.Color );
+
+        ParallelFor( m_pPool, h, ROW_TILE_SIZE, [&](int begin, int end)
+        {
+            for(auto y=begin; y<end; ++y)
+            {
+                auto v    = ( ( float(y) + 0.5f ) / float(h) - 0.5f ) * term.Scale + 0.5f;
+                auto pDst = dst.GetRow( y );
+
+                RowSampler colorRow;
+                RowSampler maskRow;
+                colorRow.Setup( src,  v );
+                maskRow .Setup( mask, v );
+
+                for(auto x=0; x<w; ++x)
+                {
+                    auto u      = term.U0 + float(x) * term.DU;
+                    auto texel  = colorRow.Sample( u );
+                    auto factor = SplatX( maskRow.Sample( u ) );
+                    auto accum  = Load4( pDst + x * 4 );
+
+                    // UNORMターゲットへの加算合成は飽和する.
+                    Store4( pDst + x * 4, Saturate( Madd( Mul( texel, color ), factor, accum ) ) );
+                }
+            }
+        });
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      全ゴーストを1パスで描画します.
+//-------------------------------------------------------------------------------------------
+void LensGhost::DrawGhostsFused
+(
+    const Image&                        src,
+    const Image&                        mask,
+    const std::vector<LensGhostParam>&  ghosts,
+    Image&                              dst
+)
+{
+    auto w = dst.GetWidth();
+    auto h = dst.GetHeight();
+    auto count = int(ghosts.size());
+
+    // 行によらない値は先に求めておく.
+    std::vector<GhostTerm> terms( ghosts.size() );
+    for(auto i=0; i<count; ++i)
+    { terms[i] = MakeGhostTerm( ghosts[i], w ); }
+
+    ParallelFor( m_pPool, h, ROW_TILE_SIZE, [&](int begin, int end)
+    {
+        auto alpha = Set4( 0.0f, 0.0f, 0.0f, 1.0f );
+
+        RowSampler colorRows[FUSED_BATCH_SIZE];
+        RowSampler maskRows [FUSED_BATCH_SIZE];
+
+        for(auto y=begin; y<end; ++y)
+        {
+            auto tv   = ( float(y) + 0.5f ) / float(h);
+            auto pDst = dst.GetRow( y );
+
+            // ゴースト数が多い場合はバッチに分けて累積.
+            // 全項が非負なので，飽和は最後に1回行えば1枚ずつの加算合成と一致する.
+            auto first = 0;
+            do
+            {
+                auto batch = count - first;
+                if (batch > FUSED_BATCH_SIZE)
+                { batch = FUSED_BATCH_SIZE; }
+
+                for(auto i=0; i<batch; ++i)
+                {
+                    auto v = ( tv - 0.5f ) * terms[first + i].Scale + 0.5f;
+                    colorRows[i].Setup( src,  v );
+                    maskRows [i].Setup( mask, v );
+                }
+
+                auto last = ( first + batch >= count );
+                auto pTerms = terms.data() + first;
+
+                for(auto x=0; x<w; ++x)
+                {
+                    auto accum = ( first == 0 ) ? Zero4() : Load4( pDst + x * 4 );
+
+                    for(auto i=0; i<batch; ++i)
+                    {
+                        auto u      = pTerms[i].U0 + float(x) * pTerms[i].DU;
+                        auto texel  = colorRows[i].Sample( u );
+                        auto factor = SplatX( maskRows[i].Sample( u ) );
+                        accum = Madd( Mul( texel, Load4( pTerms[i].Color ) ), factor, accum );
+                    }
+
+                    // クリアカラー(0, 0, 0, 1)に加算した結果と同じになるようにアルファを設定.
+                    Store4( pDst + x * 4, ( last ) ? Add( Saturate( accum ), alpha ) : accum );
+                }
+
+                first += batch;
+            }
+            while (first < count);
+        }
+    });
+}
+
+} // namespace glare
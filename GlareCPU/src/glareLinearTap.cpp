@@ -0,0 +1,178 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareLinearTap.cpp
+// Desc : Linear Sampling Tap Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareLinearTap.h>
+#include <glareThreadPool.h>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+//      テーブルにエントリを追加します.
+//-------------------------------------------------------------------------------------------
+bool AddTap( const glare::BlurKernel& kernel, float offset, float weight, float texel, glare::TapTable& table )
+{
+    if (table.Count >= glare::MAX_TAP_TABLE_SIZE)
+    { return false; }
+
+    auto& tap = table.Offset[table.Count++];
+    tap.x = ( kernel.Vertical ) ? 0.0f : offset * texel;
+    tap.y = ( kernel.Vertical ) ? offset * texel : 0.0f;
+    tap.z = weight;
+    tap.w = 0.0f;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      オフセットの重みを取得します.
+//-------------------------------------------------------------------------------------------
+inline float GetWeight( const glare::BlurKernel& kernel, int offset )
+{
+    auto r = ( offset < 0 ) ? -offset : offset;
+    return ( r <= kernel.Radius ) ? kernel.Weight[offset + kernel.Radius] : 0.0f;
+}
+
+//-------------------------------------------------------------------------------------------
+//      カーネルが正しいかどうかチェックします.
+//-------------------------------------------------------------------------------------------
+inline bool IsValid( const glare::BlurKernel& kernel, int width, int height )
+{
+    return kernel.Radius >= 0
+        && kernel.Radius <= glare::MAX_BLUR_RADIUS
+        && width  > 0
+        && height > 0;
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      リニアサンプリングのフェッチ数を取得します.
+//-------------------------------------------------------------------------------------------
+int GetLinearFetchCount( int tapCount )
+{
+    auto radius = tapCount / 2;
+    return 1 + ( ( radius + 1 ) / 2 ) * 2;
+}
+
+//-------------------------------------------------------------------------------------------
+//      1タップ1フェッチのテーブルに変換します.
+//-------------------------------------------------------------------------------------------
+bool MakeIntegerTapTable( const BlurKernel& kernel, int width, int height, TapTable& table )
+{
+    if (!IsValid( kernel, width, height ))
+    { return false; }
+
+    auto texel = 1.0f / float( ( kernel.Vertical ) ? height : width );
+    table.Count = 0;
+
+    // CalcBlurParam() と同じく，中心，正方向，負方向の順に並べる.
+    if (!AddTap( kernel, 0.0f, GetWeight( kernel, 0 ), texel, table ))
+    { return false; }
+
+    for(auto sign=1; sign>=-1; sign-=2)
+    {
+        for(auto i=1; i<=kernel.Radius; ++i)
+        {
+            auto weight = GetWeight( kernel, i * sign );
+            if (weight == 0.0f)
+            { continue; }
+
+            if (!AddTap( kernel, float(i * sign), weight, texel, table ))
+            { return false; }
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      リニアサンプリングでまとめたテーブルに変換します.
+//-------------------------------------------------------------------------------------------
+bool MakeLinearTapTable( const BlurKernel& kernel, int width, int height, TapTable& table )
+{
+    if (!IsValid( kernel, width, height ))
+    { return false; }
+
+    auto texel = 1.0f / float( ( kernel.Vertical ) ? height : width );
+    table.Count = 0;
+
+    if (!AddTap( kernel, 0.0f, GetWeight( kernel, 0 ), texel, table ))
+    { return false; }
+
+    for(auto sign=1; sign>=-1; sign-=2)
+    {
+        for(auto i=1; i<=kernel.Radius; i+=2)
+        {
+            auto w0  = GetWeight( kernel, i * sign );
+            auto w1  = GetWeight( kernel, ( i + 1 ) * sign );
+            auto sum = w0 + w1;
+
+            if (w0 == 0.0f && w1 == 0.0f)
+            { continue; }
+
+            // 補間係数が [0, 1] に収まる場合だけ1フェッチにできる.
+            if (sum != 0.0f && w0 * w1 >= 0.0f)
+            {
+                auto offset = float(i) + w1 / sum;
+                if (!AddTap( kernel, offset * float(sign), sum, texel, table ))
+                { return false; }
+            }
+            else
+            {
+                if (!AddTap( kernel, float(i * sign), w0, texel, table )
+                 || !AddTap( kernel, float(( i + 1 ) * sign), w1, texel, table ))
+                { return false; }
+            }
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      タップテーブルでブラーを掛けます.
+//-------------------------------------------------------------------------------------------
+void TapBlur( const Image& src, const TapTable& table, Image& dst, ThreadPool* pPool )
+{
+    auto w = dst.GetWidth();
+    auto h = dst.GetHeight();
+    auto inv_w = 1.0f / float(w);
+    auto inv_h = 1.0f / float(h);
+    auto alpha = Set4( 0.0f, 0.0f, 0.0f, 1.0f );
+    auto mask  = Set4( 1.0f, 1.0f, 1.0f, 0.0f );
+
+    ParallelFor( pPool, h, 16, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto v = ( float(y) + 0.5f ) * inv_h;
+            auto dstRow = dst.GetRow( y );
+
+            for(auto x=0; x<w; ++x)
+            {
+                auto u = ( float(x) + 0.5f ) * inv_w;
+                auto result = Zero4();
+
+                for(auto i=0; i<table.Count; ++i)
+                {
+                    auto& tap = table.Offset[i];
+                    result = Madd( Splat4( tap.z ), SampleLinearClamp( src, u + tap.x, v + tap.y ), result );
+                }
+
+                // result.w = 1.0f
+                Store4( dstRow + x * 4, Madd( result, mask, alpha ) );
+            }
+        }
+    });
+}
+
+} // namespace glare
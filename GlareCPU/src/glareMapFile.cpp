@@ -0,0 +1,291 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareMapFile.cpp
+// Desc : MAP File Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareMapFile.h>
+#include <glareSeparableBlur.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const float     INV_255 = 1.0f / 255.0f;
+
+
+//-------------------------------------------------------------------------------------------
+//      RGB565を展開します.
+//-------------------------------------------------------------------------------------------
+inline void DecodeRGB565( uint16_t value, float* pResult )
+{
+    pResult[0] = float( ( value >> 11 ) & 0x1f ) / 31.0f;
+    pResult[1] = float( ( value >>  5 ) & 0x3f ) / 63.0f;
+    pResult[2] = float( ( value >>  0 ) & 0x1f ) / 31.0f;
+    pResult[3] = 1.0f;
+}
+
+//-------------------------------------------------------------------------------------------
+//      RGB9E5を展開します.
+//-------------------------------------------------------------------------------------------
+inline glare::Float4 DecodeRGB9E5( uint32_t value )
+{
+    // 仮数は9bitの固定小数, 指数のバイアスは15.
+    auto scale = ldexpf( 1.0f, int( value >> 27 ) - 15 - 9 );
+    return glare::Set4(
+        float( ( value >>  0 ) & 0x1ff ) * scale,
+        float( ( value >>  9 ) & 0x1ff ) * scale,
+        float( ( value >> 18 ) & 0x1ff ) * scale,
+        1.0f );
+}
+
+//-------------------------------------------------------------------------------------------
+//      BC1カラーブロックをデコードします.
+//-------------------------------------------------------------------------------------------
+void DecodeColorBlock( const uint8_t* pBlock, bool allowPunchThrough, float pResult[16][4] )
+{
+    uint16_t c0, c1;
+    uint32_t indices;
+    memcpy( &c0,      pBlock + 0, sizeof(c0) );
+    memcpy( &c1,      pBlock + 2, sizeof(c1) );
+    memcpy( &indices, pBlock + 4, sizeof(indices) );
+
+    float palette[4][4];
+    DecodeRGB565( c0, palette[0] );
+    DecodeRGB565( c1, palette[1] );
+
+    if (c0 > c1 || !allowPunchThrough)
+    {
+        for(auto i=0; i<3; ++i)
+        {
+            palette[2][i] = ( 2.0f * palette[0][i] + palette[1][i] ) / 3.0f;
+            palette[3][i] = ( palette[0][i] + 2.0f * palette[1][i] ) / 3.0f;
+        }
+        palette[2][3] = 1.0f;
+        palette[3][3] = 1.0f;
+    }
+    else
+    {
+        for(auto i=0; i<3; ++i)
+        {
+            palette[2][i] = ( palette[0][i] + palette[1][i] ) * 0.5f;
+            palette[3][i] = 0.0f;
+        }
+        palette[2][3] = 1.0f;
+        palette[3][3] = 0.0f;
+    }
+
+    for(auto i=0; i<16; ++i)
+    {
+        auto idx = ( indices >> ( i * 2 ) ) & 0x3;
+        memcpy( pResult[i], palette[idx], sizeof(float) * 4 );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      BC3アルファブロックをデコードします.
+//-------------------------------------------------------------------------------------------
+void DecodeAlphaBlock( const uint8_t* pBlock, float pResult[16][4] )
+{
+    float palette[8];
+    palette[0] = float(pBlock[0]) * INV_255;
+    palette[1] = float(pBlock[1]) * INV_255;
+
+    if (pBlock[0] > pBlock[1])
+    {
+        for(auto i=1; i<7; ++i)
+        { palette[i + 1] = ( float(7 - i) * palette[0] + float(i) * palette[1] ) / 7.0f; }
+    }
+    else
+    {
+        for(auto i=1; i<5; ++i)
+        { palette[i + 1] = ( float(5 - i) * palette[0] + float(i) * palette[1] ) / 5.0f; }
+        palette[6] = 0.0f;
+        palette[7] = 1.0f;
+    }
+
+    uint64_t indices = 0;
+    for(auto i=0; i<6; ++i)
+    { indices |= uint64_t(pBlock[2 + i]) << ( 8 * i ); }
+
+    for(auto i=0; i<16; ++i)
+    { pResult[i][3] = palette[( indices >> ( i * 3 ) ) & 0x7]; }
+}
+
+//-------------------------------------------------------------------------------------------
+//      BC2アルファブロックをデコードします.
+//-------------------------------------------------------------------------------------------
+void DecodeExplicitAlphaBlock( const uint8_t* pBlock, float pResult[16][4] )
+{
+    for(auto i=0; i<16; ++i)
+    {
+        auto bits = ( pBlock[i / 2] >> ( ( i & 1 ) * 4 ) ) & 0xf;
+        pResult[i][3] = float(bits) / 15.0f;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      ブロック圧縮データをデコードします.
+//-------------------------------------------------------------------------------------------
+void DecodeBlockCompressed( const glare::MapSurface& info, glare::Image& image )
+{
+    auto format    = info.Format;
+    auto pSrc      = info.pData;
+    auto blockSize = ( format == glare::MAP_FORMAT_BC1 ) ? 8 : 16;
+    auto blockW    = ( int(info.Width)  + 3 ) / 4;
+    auto blockH    = ( int(info.Height) + 3 ) / 4;
+
+    for(auto by=0; by<blockH; ++by)
+    {
+        auto pRow = pSrc + size_t(by) * info.Pitch;
+
+        for(auto bx=0; bx<blockW; ++bx)
+        {
+            auto pBlock = pRow + bx * blockSize;
+            float texels[16][4];
+
+            switch(format)
+            {
+            case glare::MAP_FORMAT_BC1:
+                DecodeColorBlock( pBlock, true, texels );
+                break;
+
+            case glare::MAP_FORMAT_BC2:
+                DecodeColorBlock( pBlock + 8, false, texels );
+                DecodeExplicitAlphaBlock( pBlock, texels );
+                break;
+
+            default:
+                DecodeColorBlock( pBlock + 8, false, texels );
+                DecodeAlphaBlock( pBlock, texels );
+                break;
+            }
+
+            for(auto j=0; j<4; ++j)
+            {
+                auto y = by * 4 + j;
+                if (y >= int(info.Height))
+                { break; }
+
+                for(auto i=0; i<4; ++i)
+                {
+                    auto x = bx * 4 + i;
+                    if (x >= int(info.Width))
+                    { break; }
+
+                    image.Store( x, y, glare::Load4( texels[j * 4 + i] ) );
+                }
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      非圧縮データをデコードします.
+//-------------------------------------------------------------------------------------------
+void DecodeUncompressed( const glare::MapSurface& info, glare::Image& image )
+{
+    auto format = info.Format;
+    auto pSrc   = info.pData;
+
+    for(auto y=0; y<int(info.Height); ++y)
+    {
+        auto pRow = pSrc + size_t(y) * info.Pitch;
+
+        // 半精度浮動小数は行単位でまとめて変換する.
+        if (format == glare::MAP_FORMAT_R16G16B16A16_FLOAT)
+        {
+            glare::ConvertHalfToFloat( reinterpret_cast<const uint16_t*>( pRow ), size_t(info.Width) * 4, image.GetRow( y ) );
+            continue;
+        }
+
+        for(auto x=0; x<int(info.Width); ++x)
+        {
+            glare::Float4 texel;
+
+            switch(format)
+            {
+            case glare::MAP_FORMAT_A8:
+                texel = glare::Set4( 0.0f, 0.0f, 0.0f, float(pRow[x]) * INV_255 );
+                break;
+
+            case glare::MAP_FORMAT_L8:
+                {
+                    auto l = float(pRow[x]) * INV_255;
+                    texel = glare::Set4( l, l, l, 1.0f );
+                }
+                break;
+
+            case glare::MAP_FORMAT_R9G9B9E5:
+                {
+                    uint32_t value;
+                    memcpy( &value, pRow + x * 4, sizeof(value) );
+                    texel = DecodeRGB9E5( value );
+                }
+                break;
+
+            default:
+                texel = glare::Set4(
+                    float(pRow[x * 4 + 0]) * INV_255,
+                    float(pRow[x * 4 + 1]) * INV_255,
+                    float(pRow[x * 4 + 2]) * INV_255,
+                    float(pRow[x * 4 + 3]) * INV_255 );
+                break;
+            }
+
+            image.Store( x, y, texel );
+        }
+    }
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      MAPファイルを読み込みます.
+//-------------------------------------------------------------------------------------------
+bool LoadMapFile( const char* filename, Image& image, int mipLevel )
+{
+    if (filename == nullptr || mipLevel < 0)
+    { return false; }
+
+    // 目的のミップレベルだけをマップから直接デコードする.
+    MapView view;
+    MapSurface surface;
+    if (!view.Open( filename )
+     || !view.GetSurface( 0, mipLevel, surface ))
+    { return false; }
+
+    return DecodeMapSurface( surface, image );
+}
+
+//-------------------------------------------------------------------------------------------
+//      MAPファイルのサーフェイスをデコードします.
+//-------------------------------------------------------------------------------------------
+bool DecodeMapSurface( const MapSurface& surface, Image& image )
+{
+    if (surface.pData == nullptr || surface.Format <= MAP_FORMAT_INVALID || surface.Format >= NUM_MAP_FORMAT)
+    { return false; }
+
+    if (!image.Create( int(surface.Width), int(surface.Height) ))
+    { return false; }
+
+    if (IsBlockCompressed( surface.Format ))
+    { DecodeBlockCompressed( surface, image ); }
+    else
+    { DecodeUncompressed( surface, image ); }
+
+    return true;
+}
+
+} // namespace glare
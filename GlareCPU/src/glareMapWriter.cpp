@@ -0,0 +1,936 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareMapWriter.cpp
+// Desc : MAP File Writer Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareMapWriter.h>
+#include <glareSeparableBlur.h>
+#include <glareThreadPool.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const uint32_t  MAP_VERSION         = 2;                    //!< 書き出すファイルのバージョンです.
+const size_t    WRITE_CHUNK_SIZE    = 4 * 1024 * 1024;      //!< 1回にエンコードして書き込むサイズの目安です.
+const float     KAISER_RADIUS       = 4.0f;                 //!< カイザーフィルタの半径(縮小元テクセル)です.
+const float     KAISER_ALPHA        = 4.0f;                 //!< カイザー窓の形状パラメータです.
+const float     PI                  = 3.14159265358979323846f;
+const int       MAX_TAP_COUNT       = 16;                   //!< 1次元のタップ数の上限です(カイザーは最大9タップ).
+const int       SRGB_TABLE_SIZE     = 4096;                 //!< sRGBから線形への変換テーブルの分割数です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// TapTable structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct TapTable
+{
+    std::vector<int>    Start;      //!< 出力位置ごとのタップの開始位置です(出力数 + 1 個).
+    std::vector<int>    Index;      //!< 縮小元の位置です(端はクランプ済み).
+    std::vector<float>  Weight;     //!< 正規化した重みです.
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// SrgbTable structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct SrgbTable
+{
+    float   Linear   [SRGB_TABLE_SIZE + 1];     //!< sRGBを等分割した点の線形値です.
+    float   Threshold[255];                     //!< sRGBの8bit値 k + 1 に切り上がる線形値の境界です.
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// EncodeJob structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct EncodeJob
+{
+    const glare::Image* pImage;     //!< エンコードする画像です.
+    const SrgbTable*    pSrgb;      //!< 線形からsRGBに変換する場合のテーブルです. 変換しない場合は nullptr です.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//      第1種変形ベッセル関数 I0 を求めます.
+//-------------------------------------------------------------------------------------------
+float BesselI0( float x )
+{
+    auto sum  = 1.0f;
+    auto term = 1.0f;
+    auto half = x * 0.5f;
+    for(auto k=1; k<32; ++k)
+    {
+        term *= ( half / float(k) ) * ( half / float(k) );
+        sum  += term;
+        if (term < sum * 1e-8f)
+        { break; }
+    }
+    return sum;
+}
+
+//-------------------------------------------------------------------------------------------
+//      フィルタの重みを求めます. u は縮小元テクセル単位の距離を2倍縮小相当に正規化した値です.
+//-------------------------------------------------------------------------------------------
+float FilterWeight( glare::MIP_FILTER filter, float u )
+{
+    if (filter == glare::MIP_FILTER_BOX)
+    { return ( fabsf( u ) < 1.0f ) ? 1.0f : 0.0f; }
+
+    if (fabsf( u ) >= KAISER_RADIUS)
+    { return 0.0f; }
+
+    // 2倍縮小のローパス sinc(u / 2) にカイザー窓を掛ける.
+    auto x    = u * 0.5f * PI;
+    auto sinc = ( fabsf( x ) < 1e-6f ) ? 1.0f : sinf( x ) / x;
+    auto r    = u / KAISER_RADIUS;
+    auto win  = BesselI0( KAISER_ALPHA * sqrtf( 1.0f - r * r ) ) / BesselI0( KAISER_ALPHA );
+    return sinc * win;
+}
+
+//-------------------------------------------------------------------------------------------
+//      1次元の縮小に使うタップを求めます.
+//-------------------------------------------------------------------------------------------
+void BuildTapTable( int srcSize, int dstSize, glare::MIP_FILTER filter, TapTable& table )
+{
+    auto scale  = float(srcSize) / float(dstSize);
+    auto half   = scale * 0.5f;
+    auto radius = ( filter == glare::MIP_FILTER_BOX ) ? 1.0f : KAISER_RADIUS;
+
+    table.Start .clear();
+    table.Index .clear();
+    table.Weight.clear();
+
+    for(auto i=0; i<dstSize; ++i)
+    {
+        table.Start.push_back( int(table.Index.size()) );
+
+        auto center = ( float(i) + 0.5f ) * scale - 0.5f;
+        auto first  = int( floorf( center - radius * half ) );
+        auto last   = int( ceilf ( center + radius * half ) );
+        auto begin  = table.Weight.size();
+        auto total  = 0.0f;
+
+        for(auto j=first; j<=last; ++j)
+        {
+            auto w = FilterWeight( filter, ( float(j) - center ) / half );
+            if (w == 0.0f)
+            { continue; }
+
+            table.Index .push_back( std::min( std::max( j, 0 ), srcSize - 1 ) );
+            table.Weight.push_back( w );
+            total += w;
+        }
+
+        // 縮小元が1テクセルの場合などで重みが無い場合は最も近いテクセルを使う.
+        if (table.Weight.size() == begin)
+        {
+            table.Index .push_back( std::min( std::max( int( floorf( center + 0.5f ) ), 0 ), srcSize - 1 ) );
+            table.Weight.push_back( 1.0f );
+            total = 1.0f;
+        }
+
+        for(auto j=begin; j<table.Weight.size(); ++j)
+        { table.Weight[j] /= total; }
+    }
+
+    table.Start.push_back( int(table.Index.size()) );
+}
+
+//-------------------------------------------------------------------------------------------
+//      sRGBから線形に変換します.
+//-------------------------------------------------------------------------------------------
+inline float SrgbToLinear( float value )
+{
+    return ( value <= 0.04045f )
+        ? value / 12.92f
+        : powf( ( value + 0.055f ) / 1.055f, 2.4f );
+}
+
+//-------------------------------------------------------------------------------------------
+//      sRGB変換のテーブルを取得します.
+//-------------------------------------------------------------------------------------------
+const SrgbTable& GetSrgbTable()
+{
+    struct Builder
+    {
+        SrgbTable Table;
+
+        Builder()
+        {
+            for(auto i=0; i<=SRGB_TABLE_SIZE; ++i)
+            { Table.Linear[i] = SrgbToLinear( float(i) / float(SRGB_TABLE_SIZE) ); }
+
+            for(auto k=0; k<255; ++k)
+            { Table.Threshold[k] = SrgbToLinear( ( float(k) + 0.5f ) / 255.0f ); }
+        }
+    };
+
+    static const Builder builder;
+    return builder.Table;
+}
+
+//-------------------------------------------------------------------------------------------
+//      テーブルを補間してsRGBから線形に変換します.
+//-------------------------------------------------------------------------------------------
+inline float DecodeSrgb( const SrgbTable& table, float value )
+{
+    if (!( value > 0.0f && value < 1.0f ))
+    { return SrgbToLinear( value ); }
+
+    auto pos  = value * float(SRGB_TABLE_SIZE);
+    auto idx  = int(pos);
+    auto frac = pos - float(idx);
+    return table.Linear[idx] + ( table.Linear[idx + 1] - table.Linear[idx] ) * frac;
+}
+
+//-------------------------------------------------------------------------------------------
+//      線形の値をsRGBの8bitに量子化します. 境界値を二分探索するので powf を使いません.
+//-------------------------------------------------------------------------------------------
+inline uint8_t EncodeSrgb8( const SrgbTable& table, float value )
+{
+    auto itr = std::upper_bound( table.Threshold, table.Threshold + 255, value );
+    return uint8_t( itr - table.Threshold );
+}
+
+//-------------------------------------------------------------------------------------------
+//      [0, 1] の値を8bitに量子化します.
+//-------------------------------------------------------------------------------------------
+inline uint8_t ToUnorm8( float value )
+{
+    value = ( value < 0.0f ) ? 0.0f : ( value > 1.0f ) ? 1.0f : value;
+    return uint8_t( value * 255.0f + 0.5f );
+}
+
+//-------------------------------------------------------------------------------------------
+//      テクセルを8bitに量子化します. 必要に応じてRGBをsRGBに変換します.
+//-------------------------------------------------------------------------------------------
+inline void QuantizeTexel( const float* pTexel, const SrgbTable* pSrgb, uint8_t* pResult )
+{
+    for(auto c=0; c<3; ++c)
+    { pResult[c] = ( pSrgb != nullptr ) ? EncodeSrgb8( *pSrgb, pTexel[c] ) : ToUnorm8( pTexel[c] ); }
+    pResult[3] = ToUnorm8( pTexel[3] );
+}
+
+//-------------------------------------------------------------------------------------------
+//      RGB565に量子化します.
+//-------------------------------------------------------------------------------------------
+inline uint16_t PackRGB565( const float* pColor )
+{
+    auto r = int( pColor[0] * 31.0f / 255.0f + 0.5f );
+    auto g = int( pColor[1] * 63.0f / 255.0f + 0.5f );
+    auto b = int( pColor[2] * 31.0f / 255.0f + 0.5f );
+    r = std::min( std::max( r, 0 ), 31 );
+    g = std::min( std::max( g, 0 ), 63 );
+    b = std::min( std::max( b, 0 ), 31 );
+    return uint16_t( ( r << 11 ) | ( g << 5 ) | b );
+}
+
+//-------------------------------------------------------------------------------------------
+//      RGB565を [0, 255] に展開します. デコーダと同じ値になるようにします.
+//-------------------------------------------------------------------------------------------
+inline void UnpackRGB565( uint16_t value, float* pResult )
+{
+    pResult[0] = float( ( value >> 11 ) & 0x1f ) / 31.0f * 255.0f;
+    pResult[1] = float( ( value >>  5 ) & 0x3f ) / 63.0f * 255.0f;
+    pResult[2] = float( ( value >>  0 ) & 0x1f ) / 31.0f * 255.0f;
+}
+
+//-------------------------------------------------------------------------------------------
+//      RGB9E5に量子化します. 負の値とNaNは0, 表現できない大きな値は最大値に飽和します.
+//-------------------------------------------------------------------------------------------
+inline uint32_t PackRGB9E5( const float* pColor )
+{
+    const float MAX_VALUE = float(0x1ff) / 512.0f * 65536.0f;
+
+    float rgb[3];
+    for(auto c=0; c<3; ++c)
+    { rgb[c] = ( pColor[c] > 0.0f ) ? std::min( pColor[c], MAX_VALUE ) : 0.0f; }
+
+    auto maxValue = std::max( rgb[0], std::max( rgb[1], rgb[2] ) );
+    if (maxValue <= 0.0f)
+    { return 0; }
+
+    // 最大成分が9bitの仮数に収まる共有指数(バイアス15)を求める.
+    int exponent;
+    frexpf( maxValue, &exponent );
+    auto shared = std::max( exponent, -15 ) + 15;
+    auto scale  = ldexpf( 1.0f, 9 - ( shared - 15 ) );
+
+    if (int( maxValue * scale + 0.5f ) == 512)
+    {
+        shared++;
+        scale *= 0.5f;
+    }
+
+    uint32_t result = uint32_t(shared) << 27;
+    for(auto c=0; c<3; ++c)
+    { result |= uint32_t( std::min( int( rgb[c] * scale + 0.5f ), 511 ) ) << ( c * 9 ); }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      BC1カラーブロックをエンコードします.
+//
+//      主成分の方向に投影した両端を端点とし，各テクセルに最も近いパレットを選びます.
+//      allowPunchThrough が true の場合は，アルファが半分未満のテクセルを透明として3色モードを使います.
+//-------------------------------------------------------------------------------------------
+void EncodeColorBlock( const uint8_t texels[16][4], bool allowPunchThrough, uint8_t* pBlock )
+{
+    auto transparent = false;
+    if (allowPunchThrough)
+    {
+        for(auto i=0; i<16; ++i)
+        { transparent |= ( texels[i][3] < 128 ); }
+    }
+
+    // 平均と共分散.
+    float mean[3] = {};
+    auto  count   = 0;
+    for(auto i=0; i<16; ++i)
+    {
+        if (transparent && texels[i][3] < 128)
+        { continue; }
+
+        for(auto c=0; c<3; ++c)
+        { mean[c] += texels[i][c]; }
+        count++;
+    }
+
+    uint16_t c0 = 0;
+    uint16_t c1 = 0;
+    if (count > 0)
+    {
+        for(auto c=0; c<3; ++c)
+        { mean[c] /= float(count); }
+
+        float cov[6] = {};
+        for(auto i=0; i<16; ++i)
+        {
+            if (transparent && texels[i][3] < 128)
+            { continue; }
+
+            auto r = texels[i][0] - mean[0];
+            auto g = texels[i][1] - mean[1];
+            auto b = texels[i][2] - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+            cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+        }
+
+        // べき乗法で主軸を求める.
+        float axis[3] = { 1.0f, 1.0f, 1.0f };
+        for(auto k=0; k<8; ++k)
+        {
+            float next[3] = {
+                cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+                cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+                cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2],
+            };
+            auto len = sqrtf( next[0] * next[0] + next[1] * next[1] + next[2] * next[2] );
+            if (len < 1e-6f)
+            { break; }
+
+            for(auto c=0; c<3; ++c)
+            { axis[c] = next[c] / len; }
+        }
+
+        auto tmin =  1e30f;
+        auto tmax = -1e30f;
+        for(auto i=0; i<16; ++i)
+        {
+            if (transparent && texels[i][3] < 128)
+            { continue; }
+
+            auto t = ( texels[i][0] - mean[0] ) * axis[0]
+                   + ( texels[i][1] - mean[1] ) * axis[1]
+                   + ( texels[i][2] - mean[2] ) * axis[2];
+            tmin = std::min( tmin, t );
+            tmax = std::max( tmax, t );
+        }
+
+        float e0[3];
+        float e1[3];
+        for(auto c=0; c<3; ++c)
+        {
+            e0[c] = std::min( std::max( mean[c] + axis[c] * tmax, 0.0f ), 255.0f );
+            e1[c] = std::min( std::max( mean[c] + axis[c] * tmin, 0.0f ), 255.0f );
+        }
+        c0 = PackRGB565( e0 );
+        c1 = PackRGB565( e1 );
+    }
+
+    // 3色モードは c0 <= c1, 4色モードは c0 > c1 で区別される.
+    if (transparent ? ( c0 > c1 ) : ( c0 < c1 ))
+    { std::swap( c0, c1 ); }
+
+    float palette[4][3];
+    UnpackRGB565( c0, palette[0] );
+    UnpackRGB565( c1, palette[1] );
+
+    auto fourColor = !allowPunchThrough || c0 > c1;
+    for(auto c=0; c<3; ++c)
+    {
+        if (fourColor)
+        {
+            palette[2][c] = ( 2.0f * palette[0][c] + palette[1][c] ) / 3.0f;
+            palette[3][c] = ( palette[0][c] + 2.0f * palette[1][c] ) / 3.0f;
+        }
+        else
+        {
+            palette[2][c] = ( palette[0][c] + palette[1][c] ) * 0.5f;
+            palette[3][c] = 0.0f;
+        }
+    }
+
+    uint32_t indices = 0;
+    for(auto i=0; i<16; ++i)
+    {
+        uint32_t best = 0;
+        if (transparent && texels[i][3] < 128)
+        { best = 3; }
+        else
+        {
+            auto bestDist = 1e30f;
+            auto entries  = ( fourColor ) ? 4u : 3u;
+            for(uint32_t j=0; j<entries; ++j)
+            {
+                auto dr = texels[i][0] - palette[j][0];
+                auto dg = texels[i][1] - palette[j][1];
+                auto db = texels[i][2] - palette[j][2];
+                auto d  = dr * dr + dg * dg + db * db;
+                if (d < bestDist)
+                {
+                    bestDist = d;
+                    best     = j;
+                }
+            }
+        }
+        indices |= best << ( i * 2 );
+    }
+
+    memcpy( pBlock + 0, &c0,      sizeof(c0) );
+    memcpy( pBlock + 2, &c1,      sizeof(c1) );
+    memcpy( pBlock + 4, &indices, sizeof(indices) );
+}
+
+//-------------------------------------------------------------------------------------------
+//      BC3アルファブロックをエンコードします.
+//-------------------------------------------------------------------------------------------
+void EncodeAlphaBlock( const uint8_t texels[16][4], uint8_t* pBlock )
+{
+    uint8_t amin = 255;
+    uint8_t amax = 0;
+    for(auto i=0; i<16; ++i)
+    {
+        amin = std::min( amin, texels[i][3] );
+        amax = std::max( amax, texels[i][3] );
+    }
+
+    // 8段階モード(a0 > a1)を使う. 全て同じ値ならインデックスは全て0になる.
+    pBlock[0] = amax;
+    pBlock[1] = amin;
+
+    float palette[8];
+    palette[0] = float(amax);
+    palette[1] = float(amin);
+    for(auto i=1; i<7; ++i)
+    { palette[i + 1] = ( float(7 - i) * palette[0] + float(i) * palette[1] ) / 7.0f; }
+
+    uint64_t indices = 0;
+    if (amax > amin)
+    {
+        for(auto i=0; i<16; ++i)
+        {
+            uint64_t best     = 0;
+            auto     bestDist = 1e30f;
+            for(auto j=0; j<8; ++j)
+            {
+                auto d = fabsf( float(texels[i][3]) - palette[j] );
+                if (d < bestDist)
+                {
+                    bestDist = d;
+                    best     = uint64_t(j);
+                }
+            }
+            indices |= best << ( i * 3 );
+        }
+    }
+
+    for(auto i=0; i<6; ++i)
+    { pBlock[2 + i] = uint8_t( indices >> ( 8 * i ) ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      BC2アルファブロックをエンコードします.
+//-------------------------------------------------------------------------------------------
+void EncodeExplicitAlphaBlock( const uint8_t texels[16][4], uint8_t* pBlock )
+{
+    memset( pBlock, 0, 8 );
+    for(auto i=0; i<16; ++i)
+    {
+        auto bits = uint8_t( ( texels[i][3] * 15 + 127 ) / 255 );
+        pBlock[i / 2] |= uint8_t( bits << ( ( i & 1 ) * 4 ) );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      ブロック行をエンコードします.
+//-------------------------------------------------------------------------------------------
+void EncodeBlockRow( glare::MAP_FORMAT format, const EncodeJob& job, int blockY, uint8_t* pRow )
+{
+    auto& image     = *job.pImage;
+    auto  w         = image.GetWidth();
+    auto  h         = image.GetHeight();
+    auto  blockW    = ( w + 3 ) / 4;
+    auto  blockSize = int( glare::GetMapElementSize( format ) );
+
+    for(auto bx=0; bx<blockW; ++bx)
+    {
+        // 画像の外は端のテクセルで埋める.
+        uint8_t texels[16][4];
+        for(auto j=0; j<4; ++j)
+        {
+            auto y    = std::min( blockY * 4 + j, h - 1 );
+            auto pSrc = image.GetRow( y );
+            for(auto i=0; i<4; ++i)
+            {
+                auto x = std::min( bx * 4 + i, w - 1 );
+                QuantizeTexel( pSrc + x * 4, job.pSrgb, texels[j * 4 + i] );
+            }
+        }
+
+        auto pBlock = pRow + bx * blockSize;
+        switch(format)
+        {
+        case glare::MAP_FORMAT_BC1:
+            EncodeColorBlock( texels, true, pBlock );
+            break;
+
+        case glare::MAP_FORMAT_BC2:
+            EncodeExplicitAlphaBlock( texels, pBlock );
+            EncodeColorBlock( texels, false, pBlock + 8 );
+            break;
+
+        default:
+            EncodeAlphaBlock( texels, pBlock );
+            EncodeColorBlock( texels, false, pBlock + 8 );
+            break;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      非圧縮のテクセル列をエンコードします.
+//-------------------------------------------------------------------------------------------
+void EncodeTexels( glare::MAP_FORMAT format, const float* pSrc, int count, const SrgbTable* pSrgb, uint8_t* pDst )
+{
+    // 浮動小数フォーマットは量子化せずに変換する.
+    if (format == glare::MAP_FORMAT_R16G16B16A16_FLOAT)
+    {
+        glare::ConvertFloatToHalf( pSrc, size_t(count) * 4, reinterpret_cast<uint16_t*>( pDst ) );
+        return;
+    }
+
+    if (format == glare::MAP_FORMAT_R9G9B9E5)
+    {
+        for(auto x=0; x<count; ++x)
+        {
+            auto value = PackRGB9E5( pSrc + x * 4 );
+            memcpy( pDst + x * 4, &value, sizeof(value) );
+        }
+        return;
+    }
+
+    for(auto x=0; x<count; ++x)
+    {
+        uint8_t texel[4];
+        QuantizeTexel( pSrc + x * 4, pSrgb, texel );
+
+        switch(format)
+        {
+        case glare::MAP_FORMAT_A8:
+            pDst[x] = texel[3];
+            break;
+
+        case glare::MAP_FORMAT_L8:
+            {
+                // Rec.709 の輝度.
+                auto l = 0.2126f * texel[0] + 0.7152f * texel[1] + 0.0722f * texel[2];
+                pDst[x] = uint8_t( std::min( l + 0.5f, 255.0f ) );
+            }
+            break;
+
+        default:
+            memcpy( pDst + x * 4, texel, 4 );
+            break;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      非圧縮の1行をエンコードします.
+//-------------------------------------------------------------------------------------------
+void EncodeRow( glare::MAP_FORMAT format, const EncodeJob& job, int y, uint8_t* pRow )
+{
+    auto& image = *job.pImage;
+    EncodeTexels( format, image.GetRow( y ), image.GetWidth(), job.pSrgb, pRow );
+}
+
+//-------------------------------------------------------------------------------------------
+//      1レベルのサーフェイス情報とテクセルを書き込みます.
+//      WRITE_CHUNK_SIZE 程度の(ブロック)行ずつ並列にエンコードしては書き込みます.
+//-------------------------------------------------------------------------------------------
+bool WriteLevel
+(
+    FILE*                           pFile,
+    glare::MAP_FORMAT               format,
+    const glare::MAP_SURFACE_INFO&  info,
+    const EncodeJob&                job,
+    std::vector<uint8_t>&           chunk,
+    glare::ThreadPool*              pPool
+)
+{
+    if (fwrite( &info, sizeof(info), 1, pFile ) != 1)
+    { return false; }
+
+    auto compressed   = glare::IsBlockCompressed( format );
+    auto rows         = int( ( compressed ) ? ( info.Height + 3 ) / 4 : info.Height );
+    auto pitch        = size_t(info.Pitch);
+    auto chunkRows    = std::min( std::max( int( WRITE_CHUNK_SIZE / pitch ), 1 ), rows );
+    if (chunk.size() < size_t(chunkRows) * pitch)
+    { chunk.resize( size_t(chunkRows) * pitch ); }
+
+    for(auto first=0; first<rows; first+=chunkRows)
+    {
+        auto count = std::min( chunkRows, rows - first );
+        glare::ParallelFor( pPool, count, 4, [&](int begin, int end)
+        {
+            for(auto row=begin; row<end; ++row)
+            {
+                auto pRow = chunk.data() + size_t(row) * pitch;
+                if (compressed)
+                { EncodeBlockRow( format, job, first + row, pRow ); }
+                else
+                { EncodeRow( format, job, first + row, pRow ); }
+            }
+        });
+
+        auto size = size_t(count) * pitch;
+        if (fwrite( chunk.data(), 1, size, pFile ) != size)
+        { return false; }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ファイルヘッダとテクスチャ情報を書き込みます.
+//-------------------------------------------------------------------------------------------
+size_t WriteFileHeader( glare::MAP_FORMAT format, int width, int height, int mipCount, int surfaceCount, uint8_t* pDst )
+{
+    glare::MAP_FILE_HEADER header = {};
+    memcpy( header.Magic, "MAP\0", 4 );
+    header.Version    = MAP_VERSION;
+    header.HeaderSize = sizeof(glare::MAP_FILE_HEADER);
+    header.Width      = uint32_t(width);
+    header.Height     = uint32_t(height);
+    header.Depth      = 0;
+
+    glare::MAP_TEXTURE_INFO texInfo = {};
+    texInfo.Format       = uint32_t(format);
+    texInfo.MipCount     = uint32_t(mipCount);
+    texInfo.SurfaceCount = uint32_t(surfaceCount);
+
+    memcpy( pDst,                  &header,  sizeof(header) );
+    memcpy( pDst + sizeof(header), &texInfo, sizeof(texInfo) );
+    return sizeof(header) + sizeof(texInfo);
+}
+
+//-------------------------------------------------------------------------------------------
+//      縦横を半分に縮小します. pDecode を指定した場合は，行ごとにsRGBから線形に変換しながら縮小します.
+//-------------------------------------------------------------------------------------------
+bool Downscale
+(
+    const glare::Image&     src,
+    glare::MIP_FILTER       filter,
+    const SrgbTable*        pDecode,
+    glare::Image&           dst,
+    glare::ThreadPool*      pPool
+)
+{
+    using namespace glare;
+
+    auto sw = src.GetWidth();
+    auto sh = src.GetHeight();
+    if (sw <= 0 || sh <= 0 || filter < 0 || filter >= NUM_MIP_FILTER)
+    { return false; }
+
+    auto dw = std::max( sw >> 1, 1 );
+    auto dh = std::max( sh >> 1, 1 );
+
+    TapTable tapX;
+    TapTable tapY;
+    BuildTapTable( sw, dw, filter, tapX );
+    BuildTapTable( sh, dh, filter, tapY );
+
+    Image temp;
+    if (!temp.Create( dw, sh ) || !dst.Create( dw, dh ))
+    { return false; }
+
+    // 横方向. 線形の画像全体を作らずに済むよう，変換は1行ずつ行う.
+    ParallelFor( pPool, sh, 16, [&](int begin, int end)
+    {
+        std::vector<float> row( ( pDecode != nullptr ) ? size_t(sw) * 4 : 0 );
+
+        for(auto y=begin; y<end; ++y)
+        {
+            auto pSrc = src.GetRow( y );
+            if (pDecode != nullptr)
+            {
+                for(auto x=0; x<sw * 4; x+=4)
+                {
+                    row[x + 0] = DecodeSrgb( *pDecode, pSrc[x + 0] );
+                    row[x + 1] = DecodeSrgb( *pDecode, pSrc[x + 1] );
+                    row[x + 2] = DecodeSrgb( *pDecode, pSrc[x + 2] );
+                    row[x + 3] = pSrc[x + 3];
+                }
+                pSrc = row.data();
+            }
+
+            auto pDst = temp.GetRow( y );
+            for(auto x=0; x<dw; ++x)
+            {
+                auto sum = Zero4();
+                for(auto k=tapX.Start[x]; k<tapX.Start[x + 1]; ++k)
+                { sum = Madd( Load4( pSrc + tapX.Index[k] * 4 ), Splat4( tapX.Weight[k] ), sum ); }
+                Store4( pDst + x * 4, sum );
+            }
+        }
+    });
+
+    // 縦方向.
+    ParallelFor( pPool, dh, 8, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            const float* pRows  [MAX_TAP_COUNT];
+            Float4       weights[MAX_TAP_COUNT];
+            auto         count = tapY.Start[y + 1] - tapY.Start[y];
+            for(auto k=0; k<count; ++k)
+            {
+                pRows  [k] = temp.GetRow( tapY.Index[tapY.Start[y] + k] );
+                weights[k] = Splat4( tapY.Weight[tapY.Start[y] + k] );
+            }
+
+            auto pDst = dst.GetRow( y );
+            for(auto x=0; x<dw * 4; x+=4)
+            {
+                auto sum = Zero4();
+                for(auto k=0; k<count; ++k)
+                { sum = Madd( Load4( pRows[k] + x ), weights[k], sum ); }
+                Store4( pDst + x, sum );
+            }
+        }
+    });
+
+    return true;
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      既定の書き出し設定を取得します.
+//-------------------------------------------------------------------------------------------
+MapWriteDesc GetDefaultMapWriteDesc()
+{
+    MapWriteDesc result;
+    result.Format    = MAP_FORMAT_R8G8B8A8;
+    result.MipCount  = 0;
+    result.MipFilter = MIP_FILTER_BOX;
+    result.SRGB      = true;
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ミップレベル数を計算します.
+//-------------------------------------------------------------------------------------------
+int CalcMipCount( int width, int height )
+{
+    auto size  = std::max( width, height );
+    auto count = 1;
+    while(size > 1)
+    {
+        size >>= 1;
+        count++;
+    }
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------
+//      1つ上のレベルからミップを生成します.
+//-------------------------------------------------------------------------------------------
+bool GenerateMip( const Image& src, MIP_FILTER filter, Image& dst, ThreadPool* pPool )
+{ return Downscale( src, filter, nullptr, dst, pPool ); }
+
+//-------------------------------------------------------------------------------------------
+//      1サーフェイス・ミップ無しのMAPファイルのレイアウトを求めます.
+//-------------------------------------------------------------------------------------------
+bool CalcMapLayout( MAP_FORMAT format, int width, int height, MAP_SURFACE_INFO& info, size_t* pDataOffset )
+{
+    if (format <= MAP_FORMAT_INVALID || format >= NUM_MAP_FORMAT || width <= 0 || height <= 0)
+    { return false; }
+
+    auto compressed = IsBlockCompressed( format );
+    auto columns    = ( compressed ) ? ( uint64_t(width)  + 3 ) / 4 : uint64_t(width);
+    auto rows       = ( compressed ) ? ( uint64_t(height) + 3 ) / 4 : uint64_t(height);
+    auto pitch      = columns * GetMapElementSize( format );
+    auto slicePitch = pitch * rows;
+
+    // サーフェイス情報は32bitなので，4GB以上のサーフェイスは表現できない.
+    if (slicePitch > UINT32_MAX)
+    { return false; }
+
+    info.Width      = uint32_t(width);
+    info.Height     = uint32_t(height);
+    info.Pitch      = uint32_t(pitch);
+    info.SlicePitch = uint32_t(slicePitch);
+
+    if (pDataOffset != nullptr)
+    { *pDataOffset = sizeof(MAP_FILE_HEADER) + sizeof(MAP_TEXTURE_INFO) + sizeof(MAP_SURFACE_INFO); }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      1サーフェイス・ミップ無しのMAPファイルのヘッダを書き込みます.
+//-------------------------------------------------------------------------------------------
+size_t WriteMapHeader( MAP_FORMAT format, const MAP_SURFACE_INFO& info, void* pDst )
+{
+    auto pBytes = static_cast<uint8_t*>( pDst );
+    auto offset = WriteFileHeader( format, int(info.Width), int(info.Height), 1, 1, pBytes );
+    memcpy( pBytes + offset, &info, sizeof(info) );
+    return offset + sizeof(info);
+}
+
+//-------------------------------------------------------------------------------------------
+//      線形のテクセル列を非圧縮フォーマットにエンコードします.
+//-------------------------------------------------------------------------------------------
+bool EncodeMapTexels( MAP_FORMAT format, const float* pSrc, int count, void* pDst )
+{
+    if (format <= MAP_FORMAT_INVALID || format >= NUM_MAP_FORMAT || IsBlockCompressed( format ))
+    { return false; }
+
+    EncodeTexels( format, pSrc, count, nullptr, static_cast<uint8_t*>( pDst ) );
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      画像をMAPファイルに書き出します.
+//-------------------------------------------------------------------------------------------
+bool SaveMapFile
+(
+    const char*         filename,
+    const Image*        pSurfaces,
+    int                 surfaceCount,
+    const MapWriteDesc& desc,
+    ThreadPool*         pPool
+)
+{
+    if (filename == nullptr || pSurfaces == nullptr || surfaceCount <= 0
+     || desc.Format <= MAP_FORMAT_INVALID || desc.Format >= NUM_MAP_FORMAT
+     || desc.MipFilter < 0 || desc.MipFilter >= NUM_MIP_FILTER
+     || desc.MipCount < 0)
+    { return false; }
+
+    auto width  = pSurfaces[0].GetWidth();
+    auto height = pSurfaces[0].GetHeight();
+    if (width <= 0 || height <= 0)
+    { return false; }
+
+    for(auto i=1; i<surfaceCount; ++i)
+    {
+        if (pSurfaces[i].GetWidth() != width || pSurfaces[i].GetHeight() != height)
+        { return false; }
+    }
+
+    auto maxMipCount = CalcMipCount( width, height );
+    auto mipCount    = ( desc.MipCount == 0 ) ? maxMipCount : std::min( desc.MipCount, maxMipCount );
+    auto compressed  = IsBlockCompressed( desc.Format );
+    auto elementSize = GetMapElementSize( desc.Format );
+    auto isSRGB      = desc.SRGB && !IsFloatFormat( desc.Format );
+
+    // レベルごとのサイズとファイル全体のレイアウトを求める.
+    std::vector<MAP_SURFACE_INFO> infos( mipCount );
+    for(auto i=0; i<mipCount; ++i)
+    {
+        auto w = std::max( width  >> i, 1 );
+        auto h = std::max( height >> i, 1 );
+        auto columns = ( compressed ) ? ( w + 3 ) / 4 : w;
+        auto rows    = ( compressed ) ? ( h + 3 ) / 4 : h;
+
+        infos[i].Width      = uint32_t(w);
+        infos[i].Height     = uint32_t(h);
+        infos[i].Pitch      = uint32_t(columns) * elementSize;
+        infos[i].SlicePitch = infos[i].Pitch * uint32_t(rows);
+    }
+
+    FILE* pFile = fopen( filename, "wb" );
+    if (pFile == nullptr)
+    { return false; }
+
+    uint8_t header[sizeof(MAP_FILE_HEADER) + sizeof(MAP_TEXTURE_INFO)];
+    WriteFileHeader( desc.Format, width, height, mipCount, surfaceCount, header );
+    auto success = ( fwrite( header, 1, sizeof(header), pFile ) == sizeof(header) );
+
+    // ファイルの先頭から順にエンコードしては書き込む. ミップは直前のレベルだけを保持する.
+    // 縮小は線形空間で行い，エンコード時にsRGBに戻す.
+    auto& srgb = GetSrgbTable();
+    Image                levels[2];
+    std::vector<uint8_t> chunk;
+
+    for(auto s=0; s<surfaceCount && success; ++s)
+    {
+        for(auto i=0; i<mipCount && success; ++i)
+        {
+            auto& level = levels[i & 1];
+            if (i > 0)
+            {
+                // 最初の縮小だけは入力のsRGBを線形に変換しながら行う.
+                success = ( i == 1 )
+                    ? Downscale( pSurfaces[s], desc.MipFilter, ( isSRGB ) ? &srgb : nullptr, level, pPool )
+                    : Downscale( levels[( i - 1 ) & 1], desc.MipFilter, nullptr, level, pPool );
+                if (!success)
+                { break; }
+            }
+
+            // 最上位レベルは入力をそのまま量子化する.
+            EncodeJob job;
+            job.pImage = ( i == 0 ) ? &pSurfaces[s] : &level;
+            job.pSrgb  = ( i > 0 && isSRGB ) ? &srgb : nullptr;
+            success = WriteLevel( pFile, desc.Format, infos[i], job, chunk, pPool );
+        }
+    }
+
+    success &= ( fclose( pFile ) == 0 );
+
+    // 書きかけのファイルは残さない.
+    if (!success)
+    { remove( filename ); }
+
+    return success;
+}
+
+} // namespace glare
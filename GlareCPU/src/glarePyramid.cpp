@@ -0,0 +1,134 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glarePyramid.cpp
+// Desc : Single Pass Downsample Pyramid Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glarePyramid.h>
+#include <glareThreadPool.h>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+//      矩形をボックスフィルタで縮小します. glare::Downsample() と同じ順序で加算します.
+//-------------------------------------------------------------------------------------------
+void DownsampleRect
+(
+    const glare::Image& src,
+    int                 factor,
+    int                 x0,
+    int                 y0,
+    int                 x1,
+    int                 y1,
+    glare::Image&       dst
+)
+{
+    using namespace glare;
+
+    auto sw = src.GetWidth();
+    auto sh = src.GetHeight();
+    auto weight = Splat4( 1.0f / float(factor * factor) );
+
+    for(auto y=y0; y<y1; ++y)
+    {
+        auto dstRow = dst.GetRow( y );
+
+        for(auto x=x0; x<x1; ++x)
+        {
+            auto sum = Zero4();
+            for(auto j=0; j<factor; ++j)
+            {
+                auto sy = y * factor + j;
+                if (sy >= sh) { sy = sh - 1; }
+
+                auto srcRow = src.GetRow( sy );
+                for(auto i=0; i<factor; ++i)
+                {
+                    auto sx = x * factor + i;
+                    if (sx >= sw) { sx = sw - 1; }
+                    sum = Add( sum, Load4( srcRow + sx * 4 ) );
+                }
+            }
+
+            Store4( dstRow + x * 4, Mul( sum, weight ) );
+        }
+    }
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      縮小バッファの全段を1回の走査で生成します.
+//-------------------------------------------------------------------------------------------
+bool BuildPyramid
+(
+    const Image&    src,
+    int             factor,
+    int             levelCount,
+    Image*          pLevels,
+    ThreadPool*     pPool
+)
+{
+    if (factor <= 0 || levelCount < 1 || levelCount > MAX_PYRAMID_LEVEL_COUNT || pLevels == nullptr)
+    { return false; }
+
+    if (src.GetWidth() <= 0 || src.GetHeight() <= 0)
+    { return false; }
+
+    // 各段のサイズは Downsample() と同じく切り捨てて，最小1にする.
+    auto w = src.GetWidth()  / factor;
+    auto h = src.GetHeight() / factor;
+    for(auto l=0; l<levelCount; ++l)
+    {
+        if (w <= 0) { w = 1; }
+        if (h <= 0) { h = 1; }
+
+        if (&pLevels[l] == &src || !pLevels[l].Create( w, h ))
+        { return false; }
+
+        w /= 2;
+        h /= 2;
+    }
+
+    auto tilesY = ( pLevels[0].GetHeight() + PYRAMID_TILE_SIZE - 1 ) / PYRAMID_TILE_SIZE;
+
+    // 段 l の行 y は段 l-1 の行 2y, 2y+1 だけから決まるので，
+    // 担当する行の範囲を段ごとに半分にしていけば他の帯の結果を待たずに済む.
+    ParallelFor( pPool, tilesY, 1, [&](int begin, int end)
+    {
+        for(auto i=begin; i<end; ++i)
+        {
+            auto size = PYRAMID_TILE_SIZE;
+            auto y0   = i * PYRAMID_TILE_SIZE;
+
+            for(auto l=0; l<levelCount; ++l)
+            {
+                auto& level = pLevels[l];
+                auto y1 = ( y0 + size < level.GetHeight() ) ? y0 + size : level.GetHeight();
+
+                // 最小1に切り上げた段は先頭の帯だけが担当する.
+                if (y0 < y1)
+                {
+                    DownsampleRect(
+                        ( l == 0 ) ? src : pLevels[l - 1],
+                        ( l == 0 ) ? factor : 2,
+                        0, y0, level.GetWidth(), y1, level );
+                }
+
+                y0   /= 2;
+                size /= 2;
+            }
+        }
+    });
+
+    return true;
+}
+
+} // namespace glare
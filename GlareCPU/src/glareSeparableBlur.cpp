@@ -0,0 +1,771 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareSeparableBlur.cpp
+// Desc : Separable Blur Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareSeparableBlur.h>
+#include <glareThreadPool.h>
+#include "glareSeparableBlurImpl.h"
+#include <cstring>
+#include <cmath>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const float FRACTION_EPSILON = 1e-4f;       //!< 整数オフセットとみなす端数です.
+const int   STRIPS_PER_THREAD = 4;          //!< スレッドあたりの帯の数です.
+const int   MIN_STRIP_HEIGHT = 64;          //!< 帯の最小の高さです.
+const int   SRGB_TABLE_SIZE = glare::detail::SRGB_TABLE_SIZE;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// SrgbTable structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct SrgbTable
+{
+    float       Decode[256];                    //!< sRGBから線形値への変換テーブルです.
+    uint8_t     Encode[SRGB_TABLE_SIZE + 4];    //!< 線形値からsRGBへの変換テーブルです. 末尾は4byte単位で読むための余白です.
+
+    SrgbTable()
+    {
+        for(auto i=0; i<256; ++i)
+        {
+            auto c = float(i) / 255.0f;
+            Decode[i] = ( c <= 0.04045f ) ? c / 12.92f : powf( ( c + 0.055f ) / 1.055f, 2.4f );
+        }
+
+        for(auto i=0; i<SRGB_TABLE_SIZE; ++i)
+        {
+            auto l = float(i) / float(SRGB_TABLE_SIZE - 1);
+            auto c = ( l <= 0.0031308f ) ? l * 12.92f : 1.055f * powf( l, 1.0f / 2.4f ) - 0.055f;
+            Encode[i] = uint8_t( c * 255.0f + 0.5f );
+        }
+
+        for(auto i=0; i<4; ++i)
+        { Encode[SRGB_TABLE_SIZE + i] = 0; }
+    }
+};
+
+//-------------------------------------------------------------------------------------------
+//      sRGB変換テーブルを取得します.
+//-------------------------------------------------------------------------------------------
+const SrgbTable& GetSrgbTable()
+{
+    static const SrgbTable table;
+    return table;
+}
+
+//-------------------------------------------------------------------------------------------
+//      [0, 1]に収めます. NaN は0にします.
+//-------------------------------------------------------------------------------------------
+inline float Clamp01( float value )
+{ return ( value > 0.0f ) ? ( ( value < 1.0f ) ? value : 1.0f ) : 0.0f; }
+
+//-------------------------------------------------------------------------------------------
+//      ピクセルをRGBA32Fに展開します.
+//-------------------------------------------------------------------------------------------
+void DecodePixels
+(
+    glare::PIXEL_FORMAT                 format,
+    const void*                         pSrc,
+    int                                 count,
+    float*                              pDst,
+    const glare::detail::BlurFuncTable& table
+)
+{
+    switch(format)
+    {
+    case glare::PIXEL_FORMAT_R8G8B8A8_SRGB:
+        table.DecodeSrgb( static_cast<const uint8_t*>( pSrc ), count, pDst );
+        break;
+
+    case glare::PIXEL_FORMAT_R16G16B16A16_FLOAT:
+        table.DecodeHalf( static_cast<const uint16_t*>( pSrc ), count * 4, pDst );
+        break;
+
+    default:
+        memcpy( pDst, pSrc, sizeof(float) * 4 * size_t(count) );
+        break;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      RGBA32Fからピクセルフォーマットに変換します.
+//-------------------------------------------------------------------------------------------
+void EncodePixels
+(
+    glare::PIXEL_FORMAT                 format,
+    const float*                        pSrc,
+    int                                 count,
+    void*                               pDst,
+    const glare::detail::BlurFuncTable& table
+)
+{
+    switch(format)
+    {
+    case glare::PIXEL_FORMAT_R8G8B8A8_SRGB:
+        table.EncodeSrgb( pSrc, count, static_cast<uint8_t*>( pDst ) );
+        break;
+
+    case glare::PIXEL_FORMAT_R16G16B16A16_FLOAT:
+        table.EncodeHalf( pSrc, count * 4, static_cast<uint16_t*>( pDst ) );
+        break;
+
+    default:
+        memcpy( pDst, pSrc, sizeof(float) * 4 * size_t(count) );
+        break;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      行の両端を端のピクセルで埋めます.
+//-------------------------------------------------------------------------------------------
+void PadEdges( float* pRow, int radius, int count )
+{
+    auto pFirst = pRow + radius * 4;
+    auto pLast  = pRow + ( radius + count - 1 ) * 4;
+    for(auto i=0; i<radius; ++i)
+    {
+        memcpy( pRow   + i * 4,                  pFirst, sizeof(float) * 4 );
+        memcpy( pLast  + ( i + 1 ) * 4,          pLast,  sizeof(float) * 4 );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      命令セットの関数テーブルを取得します.
+//-------------------------------------------------------------------------------------------
+bool GetBlurFuncTable( glare::SIMD_ISA isa, glare::detail::BlurFuncTable& table )
+{
+    switch(isa)
+    {
+    case glare::SIMD_ISA_SCALAR:    return glare::detail::GetBlurFuncTableScalar( table );
+    case glare::SIMD_ISA_SSE2:      return glare::detail::GetBlurFuncTableSSE2( table );
+    case glare::SIMD_ISA_AVX2:      return glare::detail::GetBlurFuncTableAVX2( table );
+    case glare::SIMD_ISA_NEON:      return glare::detail::GetBlurFuncTableNEON( table );
+    default:                        return false;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      実行環境で最速の命令セットの関数テーブルを取得します.
+//-------------------------------------------------------------------------------------------
+const glare::detail::BlurFuncTable& GetBestBlurFuncTable()
+{
+    struct Builder
+    {
+        glare::detail::BlurFuncTable Table;
+
+        Builder()
+        {
+            if (!GetBlurFuncTable( glare::GetBestSimdIsa(), Table ))
+            { glare::detail::GetBlurFuncTableScalar( Table ); }
+        }
+    };
+
+    static const Builder builder;
+    return builder.Table;
+}
+
+//-------------------------------------------------------------------------------------------
+//      スカラー実装の畳み込みです.
+//-------------------------------------------------------------------------------------------
+void ConvolveRowScalar( const float* pSrc, const float* pWeight, int tapCount, int count, float* pDst )
+{
+    for(auto x=0; x<count; ++x)
+    {
+        float result[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for(auto t=0; t<tapCount; ++t)
+        {
+            auto p = pSrc + ( x + t ) * 4;
+            for(auto c=0; c<4; ++c)
+            { result[c] += pWeight[t] * p[c]; }
+        }
+        memcpy( pDst + x * 4, result, sizeof(result) );
+    }
+}
+
+} // namespace
+
+
+namespace glare {
+namespace detail {
+
+//-------------------------------------------------------------------------------------------
+//      スカラー実装の縦方向の畳み込みです.
+//-------------------------------------------------------------------------------------------
+void ConvolveColumnScalar( const float* const* ppRows, const float* pWeight, int tapCount, int count, float* pDst )
+{
+    for(auto i=0; i<count; ++i)
+    {
+        auto result = 0.0f;
+        for(auto t=0; t<tapCount; ++t)
+        { result += pWeight[t] * ppRows[t][i]; }
+        pDst[i] = result;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      sRGBのRGBA8を線形値に変換します.
+//-------------------------------------------------------------------------------------------
+void DecodeSrgbScalar( const uint8_t* pSrc, int count, float* pDst )
+{
+    auto& srgb = GetSrgbTable();
+    for(auto i=0; i<count; ++i)
+    {
+        pDst[i * 4 + 0] = srgb.Decode[pSrc[i * 4 + 0]];
+        pDst[i * 4 + 1] = srgb.Decode[pSrc[i * 4 + 1]];
+        pDst[i * 4 + 2] = srgb.Decode[pSrc[i * 4 + 2]];
+        pDst[i * 4 + 3] = float(pSrc[i * 4 + 3]) / 255.0f;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      線形値をsRGBのRGBA8に変換します.
+//-------------------------------------------------------------------------------------------
+void EncodeSrgbScalar( const float* pSrc, int count, uint8_t* pDst )
+{
+    auto& srgb = GetSrgbTable();
+    for(auto i=0; i<count; ++i)
+    {
+        for(auto c=0; c<3; ++c)
+        { pDst[i * 4 + c] = srgb.Encode[int( Clamp01( pSrc[i * 4 + c] ) * float(SRGB_TABLE_SIZE - 1) + 0.5f )]; }
+        pDst[i * 4 + 3] = uint8_t( Clamp01( pSrc[i * 4 + 3] ) * 255.0f + 0.5f );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      sRGBから線形値への変換テーブルを取得します.
+//-------------------------------------------------------------------------------------------
+const float* GetSrgbDecodeTable()
+{ return GetSrgbTable().Decode; }
+
+//-------------------------------------------------------------------------------------------
+//      線形値からsRGBへの変換テーブルを取得します.
+//-------------------------------------------------------------------------------------------
+const uint8_t* GetSrgbEncodeTable()
+{ return GetSrgbTable().Encode; }
+
+//-------------------------------------------------------------------------------------------
+//      半精度浮動小数から単精度浮動小数に変換します.
+//-------------------------------------------------------------------------------------------
+void DecodeHalfScalar( const uint16_t* pSrc, int count, float* pDst )
+{
+    const uint32_t shiftedExp = 0x7c00u << 13;
+    const uint32_t magicBits  = 113u << 23;
+    float magic;
+    memcpy( &magic, &magicBits, sizeof(magic) );
+
+    for(auto i=0; i<count; ++i)
+    {
+        auto h = uint32_t(pSrc[i]);
+        auto o = ( h & 0x7fffu ) << 13;
+        auto e = o & shiftedExp;
+        o += ( 127u - 15u ) << 23;
+
+        if (e == shiftedExp)
+        {
+            // Inf / NaN.
+            o += ( 128u - 16u ) << 23;
+        }
+        else if (e == 0)
+        {
+            // 非正規化数.
+            o += 1u << 23;
+            float f;
+            memcpy( &f, &o, sizeof(f) );
+            f -= magic;
+            memcpy( &o, &f, sizeof(o) );
+        }
+
+        o |= ( h & 0x8000u ) << 16;
+        memcpy( &pDst[i], &o, sizeof(float) );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      単精度浮動小数から半精度浮動小数に変換します(最近接偶数丸め).
+//-------------------------------------------------------------------------------------------
+void EncodeHalfScalar( const float* pSrc, int count, uint16_t* pDst )
+{
+    const uint32_t infBits    = 255u << 23;
+    const uint32_t maxBits    = ( 127u + 16u ) << 23;
+    const uint32_t denormBits = ( ( 127u - 15u ) + ( 23u - 10u ) + 1u ) << 23;
+    float denormMagic;
+    memcpy( &denormMagic, &denormBits, sizeof(denormMagic) );
+
+    for(auto i=0; i<count; ++i)
+    {
+        uint32_t f;
+        memcpy( &f, &pSrc[i], sizeof(f) );
+
+        auto sign = f & 0x80000000u;
+        f ^= sign;
+
+        uint32_t o;
+        if (f >= maxBits)
+        {
+            // オーバーフローは Inf，NaN は Quiet NaN.
+            o = ( f > infBits ) ? 0x7e00u : 0x7c00u;
+        }
+        else if (f < ( 113u << 23 ))
+        {
+            // 非正規化数.
+            float v;
+            memcpy( &v, &f, sizeof(v) );
+            v += denormMagic;
+            memcpy( &o, &v, sizeof(o) );
+            o -= denormBits;
+        }
+        else
+        {
+            auto odd = ( f >> 13 ) & 1u;
+            f += ( uint32_t( 15 - 127 ) << 23 ) + 0xfffu;
+            f += odd;
+            o = f >> 13;
+        }
+
+        pDst[i] = uint16_t( o | ( sign >> 16 ) );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      スカラー実装の関数テーブルを取得します.
+//-------------------------------------------------------------------------------------------
+bool GetBlurFuncTableScalar( BlurFuncTable& table )
+{
+    table.ConvolveRow    = ConvolveRowScalar;
+    table.ConvolveColumn = ConvolveColumnScalar;
+    table.DecodeHalf     = DecodeHalfScalar;
+    table.EncodeHalf     = EncodeHalfScalar;
+    table.DecodeSrgb     = DecodeSrgbScalar;
+    table.EncodeSrgb     = EncodeSrgbScalar;
+    return true;
+}
+
+} // namespace detail
+
+
+//-------------------------------------------------------------------------------------------
+//      ピクセルフォーマットの1ピクセルあたりのバイト数を取得します.
+//-------------------------------------------------------------------------------------------
+size_t GetPixelSize( PIXEL_FORMAT format )
+{
+    switch(format)
+    {
+    case PIXEL_FORMAT_R8G8B8A8_SRGB:        return 4;
+    case PIXEL_FORMAT_R16G16B16A16_FLOAT:   return 8;
+    case PIXEL_FORMAT_R32G32B32A32_FLOAT:   return 16;
+    default:                                return 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      RGBA32F画像を参照するサーフェイスを取得します.
+//-------------------------------------------------------------------------------------------
+Surface GetSurface( Image& image )
+{
+    Surface result;
+    result.pPixels = image.GetPixels();
+    result.Width   = image.GetWidth();
+    result.Height  = image.GetHeight();
+    result.Pitch   = sizeof(float) * size_t(image.GetPitch());
+    result.Format  = PIXEL_FORMAT_R32G32B32A32_FLOAT;
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      半精度浮動小数の配列を単精度浮動小数に一括変換します.
+//-------------------------------------------------------------------------------------------
+void ConvertHalfToFloat( const uint16_t* pSrc, size_t count, float* pDst )
+{
+    auto& table = GetBestBlurFuncTable();
+
+    // 関数テーブルの要素数は int なので分割して渡す.
+    const size_t CHUNK = size_t(1) << 24;
+    for(size_t i=0; i<count; i+=CHUNK)
+    {
+        auto n = ( count - i < CHUNK ) ? count - i : CHUNK;
+        table.DecodeHalf( pSrc + i, int(n), pDst + i );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      単精度浮動小数の配列を半精度浮動小数に一括変換します.
+//-------------------------------------------------------------------------------------------
+void ConvertFloatToHalf( const float* pSrc, size_t count, uint16_t* pDst )
+{
+    auto& table = GetBestBlurFuncTable();
+
+    const size_t CHUNK = size_t(1) << 24;
+    for(size_t i=0; i<count; i+=CHUNK)
+    {
+        auto n = ( count - i < CHUNK ) ? count - i : CHUNK;
+        table.EncodeHalf( pSrc + i, int(n), pDst + i );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      サーフェイスをRGBA32F画像に展開します.
+//-------------------------------------------------------------------------------------------
+bool LoadSurface( const Surface& src, Image& dst, ThreadPool* pPool )
+{
+    if (src.pPixels == nullptr || src.Width <= 0 || src.Height <= 0 || GetPixelSize( src.Format ) == 0)
+    { return false; }
+
+    if (!dst.Create( src.Width, src.Height ))
+    { return false; }
+
+    auto& table = GetBestBlurFuncTable();
+    ParallelFor( pPool, src.Height, 16, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto pRow = static_cast<const uint8_t*>( src.pPixels ) + size_t(y) * src.Pitch;
+            DecodePixels( src.Format, pRow, src.Width, dst.GetRow( y ), table );
+        }
+    });
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      RGBA32F画像をサーフェイスのフォーマットに変換して書き込みます.
+//-------------------------------------------------------------------------------------------
+bool StoreSurface( const Image& src, const Surface& dst, ThreadPool* pPool )
+{
+    if (dst.pPixels == nullptr || GetPixelSize( dst.Format ) == 0
+     || src.GetWidth() != dst.Width || src.GetHeight() != dst.Height)
+    { return false; }
+
+    auto& table = GetBestBlurFuncTable();
+    ParallelFor( pPool, dst.Height, 16, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto pRow = static_cast<uint8_t*>( dst.pPixels ) + size_t(y) * dst.Pitch;
+            EncodePixels( dst.Format, src.GetRow( y ), dst.Width, pRow, table );
+        }
+    });
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ブラーパラメータを整数オフセットのカーネルに変換します.
+//-------------------------------------------------------------------------------------------
+bool MakeBlurKernel( const GaussBlurParam& param, int width, int height, BlurKernel& kernel )
+{
+    auto hasX = false;
+    auto hasY = false;
+    for(auto i=0; i<GAUSS_BLUR_TAP_COUNT; ++i)
+    {
+        hasX |= ( param.Offset[i].x != 0.0f );
+        hasY |= ( param.Offset[i].y != 0.0f );
+    }
+
+    // 斜め方向は分離できない.
+    if (hasX && hasY)
+    { return false; }
+
+    auto size = ( hasY ) ? height : width;
+    if (size <= 0)
+    { return false; }
+
+    // 中心を MAX_BLUR_RADIUS に置いて集計する.
+    float weights[MAX_BLUR_RADIUS * 2 + 1] = {};
+
+    for(auto i=0; i<GAUSS_BLUR_TAP_COUNT; ++i)
+    {
+        auto offset = ( ( hasY ) ? param.Offset[i].y : param.Offset[i].x ) * float(size);
+        auto weight = param.Offset[i].z;
+
+        auto base     = floorf( offset );
+        auto fraction = offset - base;
+        if (fraction < FRACTION_EPSILON)
+        { fraction = 0.0f; }
+        else if (fraction > 1.0f - FRACTION_EPSILON)
+        {
+            base    += 1.0f;
+            fraction = 0.0f;
+        }
+
+        auto index = int(base);
+        if (index < -MAX_BLUR_RADIUS || index + 1 > MAX_BLUR_RADIUS)
+        { return false; }
+
+        weights[index + MAX_BLUR_RADIUS] += weight * ( 1.0f - fraction );
+        if (fraction > 0.0f)
+        { weights[index + 1 + MAX_BLUR_RADIUS] += weight * fraction; }
+    }
+
+    auto radius = 0;
+    for(auto i=-MAX_BLUR_RADIUS; i<=MAX_BLUR_RADIUS; ++i)
+    {
+        if (weights[i + MAX_BLUR_RADIUS] != 0.0f)
+        {
+            auto r = ( i < 0 ) ? -i : i;
+            if (r > radius) { radius = r; }
+        }
+    }
+
+    kernel.Radius   = radius;
+    kernel.Vertical = hasY;
+    memset( kernel.Weight, 0, sizeof(kernel.Weight) );
+    for(auto i=-radius; i<=radius; ++i)
+    { kernel.Weight[i + radius] = weights[i + MAX_BLUR_RADIUS]; }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      テクセル単位のガウスカーネルを生成します.
+//-------------------------------------------------------------------------------------------
+bool MakeGaussKernel( int tapCount, float deviation, bool vertical, BlurKernel& kernel )
+{
+    if (tapCount < 3 || tapCount > MAX_BLUR_RADIUS * 2 + 1 || ( tapCount & 1 ) == 0 || deviation <= 0.0f)
+    { return false; }
+
+    auto radius = tapCount / 2;
+    auto total  = 0.0f;
+
+    memset( kernel.Weight, 0, sizeof(kernel.Weight) );
+    for(auto i=-radius; i<=radius; ++i)
+    {
+        auto weight = expf( -float(i * i) / ( 2.0f * deviation * deviation ) );
+        kernel.Weight[i + radius] = weight;
+        total += weight;
+    }
+
+    for(auto i=0; i<tapCount; ++i)
+    { kernel.Weight[i] /= total; }
+
+    kernel.Radius   = radius;
+    kernel.Vertical = vertical;
+
+    return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// SeparableBlur class
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------
+SeparableBlur::SeparableBlur()
+: m_Isa         ( SIMD_ISA_SCALAR )
+, m_Width       ( 0 )
+, m_Height      ( 0 )
+, m_Boundary    ()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------
+SeparableBlur::~SeparableBlur()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------
+//      初期化処理です.
+//-------------------------------------------------------------------------------------------
+bool SeparableBlur::Init( int width, int height, SIMD_ISA isa )
+{
+    if (width <= 0 || height <= 0)
+    { return false; }
+
+    if (!IsSimdIsaSupported( isa ))
+    { return false; }
+
+    detail::BlurFuncTable table;
+    if (!GetBlurFuncTable( isa, table ))
+    { return false; }
+
+    m_Isa    = isa;
+    m_Width  = width;
+    m_Height = height;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      終了処理です.
+//-------------------------------------------------------------------------------------------
+void SeparableBlur::Term()
+{
+    m_Boundary.clear();
+    m_Boundary.shrink_to_fit();
+    m_Width  = 0;
+    m_Height = 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//      使用している命令セットを取得します.
+//-------------------------------------------------------------------------------------------
+SIMD_ISA SeparableBlur::GetIsa() const
+{ return m_Isa; }
+
+//-------------------------------------------------------------------------------------------
+//      横方向，縦方向の順にブラーを掛けます.
+//-------------------------------------------------------------------------------------------
+bool SeparableBlur::Execute
+(
+    const Surface&          src,
+    const GaussBlurParam&   horizontal,
+    const GaussBlurParam&   vertical,
+    const Surface&          dst,
+    ThreadPool*             pPool
+)
+{
+    BlurKernel kernelH;
+    BlurKernel kernelV;
+    if (!MakeBlurKernel( horizontal, src.Width, src.Height, kernelH )
+     || !MakeBlurKernel( vertical,   src.Width, src.Height, kernelV ))
+    { return false; }
+
+    // 中心だけのカーネルは方向が決まらないので，引数の位置で判定する.
+    kernelH.Vertical = false;
+    if (kernelV.Radius == 0)
+    { kernelV.Vertical = true; }
+
+    return Execute( src, kernelH, kernelV, dst, pPool );
+}
+
+//-------------------------------------------------------------------------------------------
+//      横方向，縦方向の順にカーネルを適用します.
+//-------------------------------------------------------------------------------------------
+bool SeparableBlur::Execute
+(
+    const Surface&          src,
+    const BlurKernel&       horizontal,
+    const BlurKernel&       vertical,
+    const Surface&          dst,
+    ThreadPool*             pPool
+)
+{
+    if (m_Width == 0
+     || src.Width  != m_Width || src.Height != m_Height
+     || dst.Width  != m_Width || dst.Height != m_Height
+     || src.pPixels == nullptr || dst.pPixels == nullptr
+     || GetPixelSize( src.Format ) == 0 || GetPixelSize( dst.Format ) == 0)
+    { return false; }
+
+    if (horizontal.Vertical || !vertical.Vertical
+     || horizontal.Radius < 0 || horizontal.Radius > MAX_BLUR_RADIUS
+     || vertical.Radius   < 0 || vertical.Radius   > MAX_BLUR_RADIUS)
+    { return false; }
+
+    detail::BlurFuncTable table;
+    if (!GetBlurFuncTable( m_Isa, table ))
+    { return false; }
+
+    auto w       = m_Width;
+    auto h       = m_Height;
+    auto radiusH = horizontal.Radius;
+    auto radiusV = vertical.Radius;
+    auto tapV    = radiusV * 2 + 1;
+    auto rowSize = GetPixelSize( src.Format ) * size_t(w);
+    auto pSrc    = static_cast<const uint8_t*>( src.pPixels );
+
+    // 行を上から順に処理する帯に分ける. 帯の境界では縦方向の半径分の行を重複して横方向に処理するので,
+    // 半径に対して十分な高さにする.
+    auto stripHeight = h;
+    if (pPool != nullptr && pPool->GetThreadCount() > 1)
+    {
+        auto count = pPool->GetThreadCount() * STRIPS_PER_THREAD;
+        stripHeight = ( h + count - 1 ) / count;
+        if (stripHeight < MIN_STRIP_HEIGHT) { stripHeight = MIN_STRIP_HEIGHT; }
+        if (stripHeight < radiusV * 4)      { stripHeight = radiusV * 4; }
+        if (stripHeight > h)                { stripHeight = h; }
+    }
+    auto stripCount = ( h + stripHeight - 1 ) / stripHeight;
+
+    // 入力と出力が同じ場合は，隣の帯が先に書き換える境界付近の入力行を退避しておく.
+    // 境界 s の前後 radiusV 行を (s - 1) * boundaryRows 行目から格納する.
+    auto inPlace      = ( src.pPixels == dst.pPixels ) && ( stripCount > 1 );
+    auto boundaryRows = radiusV * 2;
+    if (inPlace)
+    {
+        m_Boundary.resize( size_t(stripCount - 1) * size_t(boundaryRows) * rowSize );
+        for(auto s=1; s<stripCount; ++s)
+        {
+            for(auto r=0; r<boundaryRows; ++r)
+            {
+                auto y = s * stripHeight - radiusV + r;
+                if (y < 0 || y >= h)
+                { continue; }
+
+                memcpy( m_Boundary.data() + ( size_t(s - 1) * boundaryRows + r ) * rowSize, pSrc + size_t(y) * src.Pitch, rowSize );
+            }
+        }
+    }
+
+    // 帯の入力行を取得します. 端の外側は端の行を複製します.
+    auto getSourceRow = [&]( int strip, int y ) -> const uint8_t*
+    {
+        y = ( y < 0 ) ? 0 : ( y >= h ) ? h - 1 : y;
+
+        auto y0 = strip * stripHeight;
+        if (inPlace && ( y < y0 || y >= y0 + stripHeight ))
+        {
+            auto s = ( y < y0 ) ? strip : strip + 1;
+            auto r = y - ( s * stripHeight - radiusV );
+            return m_Boundary.data() + ( size_t(s - 1) * boundaryRows + r ) * rowSize;
+        }
+
+        return pSrc + size_t(y) * src.Pitch;
+    };
+
+    // 横方向のパスの結果は縦方向の直径分の行だけをリングバッファに保持し，
+    // 縦方向のパスは行のまま畳み込む. 画像全体の中間バッファや転置は不要になる.
+    ParallelFor( pPool, stripCount, 1, [&](int begin, int end)
+    {
+        std::vector<float>          padded( size_t(w + radiusH * 2) * 4 );
+        std::vector<float>          ring  ( size_t(tapV) * size_t(w) * 4 );
+        std::vector<float>          result( size_t(w) * 4 );
+        std::vector<const float*>   rows  ( tapV );
+
+        for(auto strip=begin; strip<end; ++strip)
+        {
+            auto y0 = strip * stripHeight;
+            auto y1 = ( y0 + stripHeight < h ) ? y0 + stripHeight : h;
+
+            // 行 y の横方向のパスの結果は (y - y0 + radiusV) % tapV 番目に置く.
+            auto blurRow = [&]( int y )
+            {
+                auto slot = ( y - y0 + radiusV ) % tapV;
+                DecodePixels( src.Format, getSourceRow( strip, y ), w, padded.data() + radiusH * 4, table );
+                PadEdges( padded.data(), radiusH, w );
+                table.ConvolveRow( padded.data(), horizontal.Weight, radiusH * 2 + 1, w, ring.data() + size_t(slot) * w * 4 );
+            };
+
+            for(auto y=y0 - radiusV; y<y0 + radiusV; ++y)
+            { blurRow( y ); }
+
+            for(auto y=y0; y<y1; ++y)
+            {
+                // y + radiusV 行目までの入力を読み終えてから y 行目を書き込むので，入力と出力が同じでもよい.
+                blurRow( y + radiusV );
+
+                for(auto t=0; t<tapV; ++t)
+                { rows[t] = ring.data() + size_t( ( y - y0 + t ) % tapV ) * w * 4; }
+
+                table.ConvolveColumn( rows.data(), vertical.Weight, tapV, w * 4, result.data() );
+
+                auto pRow = static_cast<uint8_t*>( dst.pPixels ) + size_t(y) * dst.Pitch;
+                EncodePixels( dst.Format, result.data(), w, pRow, table );
+            }
+        }
+    });
+
+    return true;
+}
+
+} // namespace glare
@@ -0,0 +1,245 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareSeparableBlurAVX2.cpp
+// Desc : Separable Blur Module (AVX2).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareSimd.h>
+#include "glareSeparableBlurImpl.h"
+
+#if GLARE_SIMD_SSE2
+    #include <immintrin.h>
+#endif//GLARE_SIMD_SSE2
+
+
+// このファイルは実行時に AVX2 が確認された場合にのみ呼ばれるため，
+// ビルドオプションではなく関数単位で命令セットを有効にします.
+#if defined(_MSC_VER) || !GLARE_SIMD_SSE2
+    #define GLARE_TARGET_AVX2
+#else
+    #define GLARE_TARGET_AVX2   __attribute__((target("avx2,fma,f16c")))
+#endif
+
+
+#if GLARE_SIMD_SSE2
+namespace {
+
+//-------------------------------------------------------------------------------------------
+//      AVX2実装の畳み込みです. 積和の待ち時間を隠すため8ピクセルずつ処理します.
+//-------------------------------------------------------------------------------------------
+GLARE_TARGET_AVX2
+void ConvolveRowAVX2( const float* pSrc, const float* pWeight, int tapCount, int count, float* pDst )
+{
+    auto x = 0;
+    for(; x + 8 <= count; x += 8)
+    {
+        auto acc0 = _mm256_setzero_ps();
+        auto acc1 = _mm256_setzero_ps();
+        auto acc2 = _mm256_setzero_ps();
+        auto acc3 = _mm256_setzero_ps();
+        auto p    = pSrc + x * 4;
+        for(auto t=0; t<tapCount; ++t, p += 4)
+        {
+            auto w = _mm256_broadcast_ss( pWeight + t );
+            acc0 = _mm256_fmadd_ps( w, _mm256_loadu_ps( p      ), acc0 );
+            acc1 = _mm256_fmadd_ps( w, _mm256_loadu_ps( p + 8  ), acc1 );
+            acc2 = _mm256_fmadd_ps( w, _mm256_loadu_ps( p + 16 ), acc2 );
+            acc3 = _mm256_fmadd_ps( w, _mm256_loadu_ps( p + 24 ), acc3 );
+        }
+        _mm256_storeu_ps( pDst + x * 4,      acc0 );
+        _mm256_storeu_ps( pDst + x * 4 + 8,  acc1 );
+        _mm256_storeu_ps( pDst + x * 4 + 16, acc2 );
+        _mm256_storeu_ps( pDst + x * 4 + 24, acc3 );
+    }
+
+    for(; x + 2 <= count; x += 2)
+    {
+        auto acc = _mm256_setzero_ps();
+        auto p   = pSrc + x * 4;
+        for(auto t=0; t<tapCount; ++t, p += 4)
+        { acc = _mm256_fmadd_ps( _mm256_broadcast_ss( pWeight + t ), _mm256_loadu_ps( p ), acc ); }
+        _mm256_storeu_ps( pDst + x * 4, acc );
+    }
+
+    for(; x < count; ++x)
+    {
+        auto acc = _mm_setzero_ps();
+        auto p   = pSrc + x * 4;
+        for(auto t=0; t<tapCount; ++t, p += 4)
+        { acc = _mm_fmadd_ps( _mm_broadcast_ss( pWeight + t ), _mm_loadu_ps( p ), acc ); }
+        _mm_storeu_ps( pDst + x * 4, acc );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      AVX2実装の縦方向の畳み込みです. 32要素ずつ処理します.
+//-------------------------------------------------------------------------------------------
+GLARE_TARGET_AVX2
+void ConvolveColumnAVX2( const float* const* ppRows, const float* pWeight, int tapCount, int count, float* pDst )
+{
+    auto i = 0;
+    for(; i + 32 <= count; i += 32)
+    {
+        auto acc0 = _mm256_setzero_ps();
+        auto acc1 = _mm256_setzero_ps();
+        auto acc2 = _mm256_setzero_ps();
+        auto acc3 = _mm256_setzero_ps();
+        for(auto t=0; t<tapCount; ++t)
+        {
+            auto w = _mm256_broadcast_ss( pWeight + t );
+            auto p = ppRows[t] + i;
+            acc0 = _mm256_fmadd_ps( w, _mm256_loadu_ps( p      ), acc0 );
+            acc1 = _mm256_fmadd_ps( w, _mm256_loadu_ps( p + 8  ), acc1 );
+            acc2 = _mm256_fmadd_ps( w, _mm256_loadu_ps( p + 16 ), acc2 );
+            acc3 = _mm256_fmadd_ps( w, _mm256_loadu_ps( p + 24 ), acc3 );
+        }
+        _mm256_storeu_ps( pDst + i,      acc0 );
+        _mm256_storeu_ps( pDst + i + 8,  acc1 );
+        _mm256_storeu_ps( pDst + i + 16, acc2 );
+        _mm256_storeu_ps( pDst + i + 24, acc3 );
+    }
+
+    for(; i + 8 <= count; i += 8)
+    {
+        auto acc = _mm256_setzero_ps();
+        for(auto t=0; t<tapCount; ++t)
+        { acc = _mm256_fmadd_ps( _mm256_broadcast_ss( pWeight + t ), _mm256_loadu_ps( ppRows[t] + i ), acc ); }
+        _mm256_storeu_ps( pDst + i, acc );
+    }
+
+    for(; i < count; i += 4)
+    {
+        auto acc = _mm_setzero_ps();
+        for(auto t=0; t<tapCount; ++t)
+        { acc = _mm_fmadd_ps( _mm_broadcast_ss( pWeight + t ), _mm_loadu_ps( ppRows[t] + i ), acc ); }
+        _mm_storeu_ps( pDst + i, acc );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      F16C命令で半精度浮動小数から単精度浮動小数に変換します.
+//-------------------------------------------------------------------------------------------
+GLARE_TARGET_AVX2
+void DecodeHalfF16C( const uint16_t* pSrc, int count, float* pDst )
+{
+    auto i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        auto h = _mm_loadu_si128( reinterpret_cast<const __m128i*>( pSrc + i ) );
+        _mm256_storeu_ps( pDst + i, _mm256_cvtph_ps( h ) );
+    }
+
+    if (i < count)
+    { glare::detail::DecodeHalfScalar( pSrc + i, count - i, pDst + i ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      F16C命令で単精度浮動小数から半精度浮動小数に変換します.
+//-------------------------------------------------------------------------------------------
+GLARE_TARGET_AVX2
+void EncodeHalfF16C( const float* pSrc, int count, uint16_t* pDst )
+{
+    auto i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        auto h = _mm256_cvtps_ph( _mm256_loadu_ps( pSrc + i ), _MM_FROUND_TO_NEAREST_INT );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( pDst + i ), h );
+    }
+
+    if (i < count)
+    { glare::detail::EncodeHalfScalar( pSrc + i, count - i, pDst + i ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      ギャザー命令でsRGBのRGBA8を線形値に変換します. 2ピクセルずつ処理します.
+//-------------------------------------------------------------------------------------------
+GLARE_TARGET_AVX2
+void DecodeSrgbAVX2( const uint8_t* pSrc, int count, float* pDst )
+{
+    const auto pTable = glare::detail::GetSrgbDecodeTable();
+    const auto scale  = _mm256_set1_ps( 255.0f );
+
+    auto i = 0;
+    for(; i + 2 <= count; i += 2)
+    {
+        auto index = _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( pSrc + i * 4 ) ) );
+        auto color = _mm256_i32gather_ps( pTable, index, 4 );
+        auto alpha = _mm256_div_ps( _mm256_cvtepi32_ps( index ), scale );
+        _mm256_storeu_ps( pDst + i * 4, _mm256_blend_ps( color, alpha, 0x88 ) );
+    }
+
+    if (i < count)
+    { glare::detail::DecodeSrgbScalar( pSrc + i * 4, count - i, pDst + i * 4 ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      ギャザー命令で線形値をsRGBのRGBA8に変換します. 8ピクセルずつ処理します.
+//-------------------------------------------------------------------------------------------
+GLARE_TARGET_AVX2
+void EncodeSrgbAVX2( const float* pSrc, int count, uint8_t* pDst )
+{
+    // テーブルは4byte単位で読むので，末尾に余白を持たせてあります.
+    const auto pTable = reinterpret_cast<const int*>( glare::detail::GetSrgbEncodeTable() );
+    const auto zero   = _mm256_setzero_ps();
+    const auto one    = _mm256_set1_ps( 1.0f );
+    const auto half   = _mm256_set1_ps( 0.5f );
+    const auto c      = float(glare::detail::SRGB_TABLE_SIZE - 1);
+    const auto scale  = _mm256_setr_ps( c, c, c, 255.0f, c, c, c, 255.0f );
+    const auto byte   = _mm256_set1_epi32( 0xff );
+    const auto order  = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+
+    auto i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m256i result[4];
+        for(auto j=0; j<4; ++j)
+        {
+            // NaN は _mm256_max_ps が2番目のオペランドを返すので0になる.
+            auto v     = _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( pSrc + ( i + j * 2 ) * 4 ), zero ), one );
+            auto index = _mm256_cvttps_epi32( _mm256_add_ps( _mm256_mul_ps( v, scale ), half ) );
+            auto color = _mm256_and_si256( _mm256_i32gather_epi32( pTable, index, 1 ), byte );
+            result[j] = _mm256_blend_epi32( color, index, 0x88 );
+        }
+
+        // パックはレーンごとに行われるので，最後にピクセルの順番を戻す.
+        auto lo = _mm256_packs_epi32( result[0], result[1] );
+        auto hi = _mm256_packs_epi32( result[2], result[3] );
+        auto packed = _mm256_permutevar8x32_epi32( _mm256_packus_epi16( lo, hi ), order );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( pDst + i * 4 ), packed );
+    }
+
+    if (i < count)
+    { glare::detail::EncodeSrgbScalar( pSrc + i * 4, count - i, pDst + i * 4 ); }
+}
+
+} // namespace
+#endif//GLARE_SIMD_SSE2
+
+
+namespace glare {
+namespace detail {
+
+//-------------------------------------------------------------------------------------------
+//      AVX2実装の関数テーブルを取得します.
+//-------------------------------------------------------------------------------------------
+bool GetBlurFuncTableAVX2( BlurFuncTable& table )
+{
+#if GLARE_SIMD_SSE2
+    table.ConvolveRow    = ConvolveRowAVX2;
+    table.ConvolveColumn = ConvolveColumnAVX2;
+    table.DecodeHalf     = DecodeHalfF16C;
+    table.EncodeHalf     = EncodeHalfF16C;
+    table.DecodeSrgb     = DecodeSrgbAVX2;
+    table.EncodeSrgb     = EncodeSrgbAVX2;
+    return true;
+#else
+    (void)table;
+    return false;
+#endif
+}
+
+} // namespace detail
+} // namespace glare
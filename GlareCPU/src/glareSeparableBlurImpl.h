@@ -0,0 +1,88 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareSeparableBlurImpl.h
+// Desc : Separable Blur Implementation Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+#ifndef __GLARE_SEPARABLE_BLUR_IMPL_H__
+#define __GLARE_SEPARABLE_BLUR_IMPL_H__
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <cstdint>
+
+
+namespace glare {
+namespace detail {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   SRGB_TABLE_SIZE = 65536;        //!< 線形値からsRGBへの変換テーブルのサイズです.
+
+
+//-------------------------------------------------------------------------------------------
+// Type Definitions
+//-------------------------------------------------------------------------------------------
+
+// pDst[x] = Σ pWeight[t] * pSrc[x + t] (t = 0 ... tapCount - 1) を RGBA の4成分について求めます.
+// pSrc は端を複製した行の先頭(オフセット -Radius の位置)を指します.
+typedef void (*ConvolveRowFunc)( const float* pSrc, const float* pWeight, int tapCount, int count, float* pDst );
+
+// pDst[i] = Σ pWeight[t] * ppRows[t][i] (t = 0 ... tapCount - 1) を count 個の要素について求めます.
+// ppRows は縦方向に並んだ行の先頭(オフセット -Radius の行から順)を指します. count は4の倍数です.
+typedef void (*ConvolveColumnFunc)( const float* const* ppRows, const float* pWeight, int tapCount, int count, float* pDst );
+
+// 半精度浮動小数を count 個変換します.
+typedef void (*DecodeHalfFunc)( const uint16_t* pSrc, int count, float* pDst );
+typedef void (*EncodeHalfFunc)( const float* pSrc, int count, uint16_t* pDst );
+
+// RGBがsRGB, Aが線形の RGBA8 を count ピクセル変換します. 書き込み時は[0, 1]に飽和し, NaN は0にします.
+typedef void (*DecodeSrgbFunc)( const uint8_t* pSrc, int count, float* pDst );
+typedef void (*EncodeSrgbFunc)( const float* pSrc, int count, uint8_t* pDst );
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// BlurFuncTable structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct BlurFuncTable
+{
+    ConvolveRowFunc     ConvolveRow;    //!< 1行分の畳み込みです.
+    ConvolveColumnFunc  ConvolveColumn; //!< 縦方向に並んだ行の畳み込みです.
+    DecodeHalfFunc      DecodeHalf;     //!< 半精度浮動小数から単精度浮動小数への変換です.
+    EncodeHalfFunc      EncodeHalf;     //!< 単精度浮動小数から半精度浮動小数への変換です.
+    DecodeSrgbFunc      DecodeSrgb;     //!< sRGBから線形値への変換です.
+    EncodeSrgbFunc      EncodeSrgb;     //!< 線形値からsRGBへの変換です.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//      スカラー実装の変換です. SIMD実装の端数の処理にも使います.
+//-------------------------------------------------------------------------------------------
+void ConvolveColumnScalar( const float* const* ppRows, const float* pWeight, int tapCount, int count, float* pDst );
+void DecodeHalfScalar( const uint16_t* pSrc, int count, float* pDst );
+void EncodeHalfScalar( const float* pSrc, int count, uint16_t* pDst );
+void DecodeSrgbScalar( const uint8_t* pSrc, int count, float* pDst );
+void EncodeSrgbScalar( const float* pSrc, int count, uint8_t* pDst );
+
+//-------------------------------------------------------------------------------------------
+//      sRGB変換テーブルを取得します.
+//      デコードは256要素, エンコードは SRGB_TABLE_SIZE 要素で, 4byte単位で読めるように末尾を埋めています.
+//-------------------------------------------------------------------------------------------
+const float*   GetSrgbDecodeTable();
+const uint8_t* GetSrgbEncodeTable();
+
+//-------------------------------------------------------------------------------------------
+//      命令セットごとの関数テーブルを取得します.
+//      ビルドに含まれていない場合は false を返却します.
+//-------------------------------------------------------------------------------------------
+bool GetBlurFuncTableScalar( BlurFuncTable& table );
+bool GetBlurFuncTableSSE2  ( BlurFuncTable& table );
+bool GetBlurFuncTableAVX2  ( BlurFuncTable& table );
+bool GetBlurFuncTableNEON  ( BlurFuncTable& table );
+
+} // namespace detail
+} // namespace glare
+
+#endif//__GLARE_SEPARABLE_BLUR_IMPL_H__
@@ -0,0 +1,156 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareSeparableBlurNEON.cpp
+// Desc : Separable Blur Module (NEON).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareSimd.h>
+#include "glareSeparableBlurImpl.h"
+
+
+#if GLARE_SIMD_NEON
+namespace {
+
+//-------------------------------------------------------------------------------------------
+//      積和演算です.
+//-------------------------------------------------------------------------------------------
+GLARE_INLINE float32x4_t MulAdd( float32x4_t acc, float32x4_t a, float32x4_t b )
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vfmaq_f32( acc, a, b );
+#else
+    return vmlaq_f32( acc, a, b );
+#endif
+}
+
+//-------------------------------------------------------------------------------------------
+//      NEON実装の畳み込みです. 2ピクセルずつ処理します.
+//-------------------------------------------------------------------------------------------
+void ConvolveRowNEON( const float* pSrc, const float* pWeight, int tapCount, int count, float* pDst )
+{
+    auto x = 0;
+    for(; x + 2 <= count; x += 2)
+    {
+        auto acc0 = vdupq_n_f32( 0.0f );
+        auto acc1 = vdupq_n_f32( 0.0f );
+        auto p    = pSrc + x * 4;
+        for(auto t=0; t<tapCount; ++t, p += 4)
+        {
+            auto w = vdupq_n_f32( pWeight[t] );
+            acc0 = MulAdd( acc0, w, vld1q_f32( p     ) );
+            acc1 = MulAdd( acc1, w, vld1q_f32( p + 4 ) );
+        }
+        vst1q_f32( pDst + x * 4,     acc0 );
+        vst1q_f32( pDst + x * 4 + 4, acc1 );
+    }
+
+    for(; x < count; ++x)
+    {
+        auto acc = vdupq_n_f32( 0.0f );
+        auto p   = pSrc + x * 4;
+        for(auto t=0; t<tapCount; ++t, p += 4)
+        { acc = MulAdd( acc, vdupq_n_f32( pWeight[t] ), vld1q_f32( p ) ); }
+        vst1q_f32( pDst + x * 4, acc );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      NEON実装の縦方向の畳み込みです. 16要素ずつ処理します.
+//-------------------------------------------------------------------------------------------
+void ConvolveColumnNEON( const float* const* ppRows, const float* pWeight, int tapCount, int count, float* pDst )
+{
+    auto i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        auto acc0 = vdupq_n_f32( 0.0f );
+        auto acc1 = vdupq_n_f32( 0.0f );
+        auto acc2 = vdupq_n_f32( 0.0f );
+        auto acc3 = vdupq_n_f32( 0.0f );
+        for(auto t=0; t<tapCount; ++t)
+        {
+            auto w = vdupq_n_f32( pWeight[t] );
+            auto p = ppRows[t] + i;
+            acc0 = MulAdd( acc0, w, vld1q_f32( p      ) );
+            acc1 = MulAdd( acc1, w, vld1q_f32( p + 4  ) );
+            acc2 = MulAdd( acc2, w, vld1q_f32( p + 8  ) );
+            acc3 = MulAdd( acc3, w, vld1q_f32( p + 12 ) );
+        }
+        vst1q_f32( pDst + i,      acc0 );
+        vst1q_f32( pDst + i + 4,  acc1 );
+        vst1q_f32( pDst + i + 8,  acc2 );
+        vst1q_f32( pDst + i + 12, acc3 );
+    }
+
+    for(; i < count; i += 4)
+    {
+        auto acc = vdupq_n_f32( 0.0f );
+        for(auto t=0; t<tapCount; ++t)
+        { acc = MulAdd( acc, vdupq_n_f32( pWeight[t] ), vld1q_f32( ppRows[t] + i ) ); }
+        vst1q_f32( pDst + i, acc );
+    }
+}
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+//-------------------------------------------------------------------------------------------
+//      半精度浮動小数から単精度浮動小数に変換します.
+//-------------------------------------------------------------------------------------------
+void DecodeHalfNEON( const uint16_t* pSrc, int count, float* pDst )
+{
+    auto i = 0;
+    for(; i + 4 <= count; i += 4)
+    { vst1q_f32( pDst + i, vcvt_f32_f16( vreinterpret_f16_u16( vld1_u16( pSrc + i ) ) ) ); }
+
+    if (i < count)
+    { glare::detail::DecodeHalfScalar( pSrc + i, count - i, pDst + i ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      単精度浮動小数から半精度浮動小数に変換します.
+//-------------------------------------------------------------------------------------------
+void EncodeHalfNEON( const float* pSrc, int count, uint16_t* pDst )
+{
+    auto i = 0;
+    for(; i + 4 <= count; i += 4)
+    { vst1_u16( pDst + i, vreinterpret_u16_f16( vcvt_f16_f32( vld1q_f32( pSrc + i ) ) ) ); }
+
+    if (i < count)
+    { glare::detail::EncodeHalfScalar( pSrc + i, count - i, pDst + i ); }
+}
+#endif
+
+} // namespace
+#endif//GLARE_SIMD_NEON
+
+
+namespace glare {
+namespace detail {
+
+//-------------------------------------------------------------------------------------------
+//      NEON実装の関数テーブルを取得します.
+//-------------------------------------------------------------------------------------------
+bool GetBlurFuncTableNEON( BlurFuncTable& table )
+{
+#if GLARE_SIMD_NEON
+    table.ConvolveRow    = ConvolveRowNEON;
+    table.ConvolveColumn = ConvolveColumnNEON;
+    table.DecodeSrgb     = DecodeSrgbScalar;
+    table.EncodeSrgb     = EncodeSrgbScalar;
+  #if defined(__aarch64__) || defined(_M_ARM64)
+    table.DecodeHalf     = DecodeHalfNEON;
+    table.EncodeHalf     = EncodeHalfNEON;
+  #else
+    table.DecodeHalf     = DecodeHalfScalar;
+    table.EncodeHalf     = EncodeHalfScalar;
+  #endif
+    return true;
+#else
+    (void)table;
+    return false;
+#endif
+}
+
+} // namespace detail
+} // namespace glare
@@ -0,0 +1,259 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareSeparableBlurSSE2.cpp
+// Desc : Separable Blur Module (SSE2).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareSimd.h>
+#include "glareSeparableBlurImpl.h"
+
+
+#if GLARE_SIMD_SSE2
+namespace {
+
+//-------------------------------------------------------------------------------------------
+//      SSE2実装の畳み込みです. 加算の待ち時間を隠すため4ピクセルずつ処理します.
+//-------------------------------------------------------------------------------------------
+void ConvolveRowSSE2( const float* pSrc, const float* pWeight, int tapCount, int count, float* pDst )
+{
+    auto x = 0;
+    for(; x + 4 <= count; x += 4)
+    {
+        auto acc0 = _mm_setzero_ps();
+        auto acc1 = _mm_setzero_ps();
+        auto acc2 = _mm_setzero_ps();
+        auto acc3 = _mm_setzero_ps();
+        auto p    = pSrc + x * 4;
+        for(auto t=0; t<tapCount; ++t, p += 4)
+        {
+            auto w = _mm_set1_ps( pWeight[t] );
+            acc0 = _mm_add_ps( acc0, _mm_mul_ps( w, _mm_loadu_ps( p      ) ) );
+            acc1 = _mm_add_ps( acc1, _mm_mul_ps( w, _mm_loadu_ps( p + 4  ) ) );
+            acc2 = _mm_add_ps( acc2, _mm_mul_ps( w, _mm_loadu_ps( p + 8  ) ) );
+            acc3 = _mm_add_ps( acc3, _mm_mul_ps( w, _mm_loadu_ps( p + 12 ) ) );
+        }
+        _mm_storeu_ps( pDst + x * 4,      acc0 );
+        _mm_storeu_ps( pDst + x * 4 + 4,  acc1 );
+        _mm_storeu_ps( pDst + x * 4 + 8,  acc2 );
+        _mm_storeu_ps( pDst + x * 4 + 12, acc3 );
+    }
+
+    for(; x < count; ++x)
+    {
+        auto acc = _mm_setzero_ps();
+        auto p   = pSrc + x * 4;
+        for(auto t=0; t<tapCount; ++t, p += 4)
+        { acc = _mm_add_ps( acc, _mm_mul_ps( _mm_set1_ps( pWeight[t] ), _mm_loadu_ps( p ) ) ); }
+        _mm_storeu_ps( pDst + x * 4, acc );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      SSE2実装の縦方向の畳み込みです. 16要素ずつ処理します.
+//-------------------------------------------------------------------------------------------
+void ConvolveColumnSSE2( const float* const* ppRows, const float* pWeight, int tapCount, int count, float* pDst )
+{
+    auto i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        auto acc0 = _mm_setzero_ps();
+        auto acc1 = _mm_setzero_ps();
+        auto acc2 = _mm_setzero_ps();
+        auto acc3 = _mm_setzero_ps();
+        for(auto t=0; t<tapCount; ++t)
+        {
+            auto w = _mm_set1_ps( pWeight[t] );
+            auto p = ppRows[t] + i;
+            acc0 = _mm_add_ps( acc0, _mm_mul_ps( w, _mm_loadu_ps( p      ) ) );
+            acc1 = _mm_add_ps( acc1, _mm_mul_ps( w, _mm_loadu_ps( p + 4  ) ) );
+            acc2 = _mm_add_ps( acc2, _mm_mul_ps( w, _mm_loadu_ps( p + 8  ) ) );
+            acc3 = _mm_add_ps( acc3, _mm_mul_ps( w, _mm_loadu_ps( p + 12 ) ) );
+        }
+        _mm_storeu_ps( pDst + i,      acc0 );
+        _mm_storeu_ps( pDst + i + 4,  acc1 );
+        _mm_storeu_ps( pDst + i + 8,  acc2 );
+        _mm_storeu_ps( pDst + i + 12, acc3 );
+    }
+
+    for(; i < count; i += 4)
+    {
+        auto acc = _mm_setzero_ps();
+        for(auto t=0; t<tapCount; ++t)
+        { acc = _mm_add_ps( acc, _mm_mul_ps( _mm_set1_ps( pWeight[t] ), _mm_loadu_ps( ppRows[t] + i ) ) ); }
+        _mm_storeu_ps( pDst + i, acc );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      半精度浮動小数から単精度浮動小数に変換します. スカラー実装と同じ結果になります.
+//-------------------------------------------------------------------------------------------
+void DecodeHalfSSE2( const uint16_t* pSrc, int count, float* pDst )
+{
+    const auto maskNoSign = _mm_set1_epi32( 0x7fff );
+    const auto shiftedExp = _mm_set1_epi32( 0x7c00 << 13 );
+    const auto expAdjust  = _mm_set1_epi32( ( 127 - 15 ) << 23 );
+    const auto infAdjust  = _mm_set1_epi32( ( 128 - 16 ) << 23 );
+    const auto denormOne  = _mm_set1_epi32( 1 << 23 );
+    const auto magic      = _mm_castsi128_ps( _mm_set1_epi32( 113 << 23 ) );
+    const auto zero       = _mm_setzero_si128();
+
+    auto i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        auto h = _mm_unpacklo_epi16( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( pSrc + i ) ), zero );
+        auto o = _mm_slli_epi32( _mm_and_si128( h, maskNoSign ), 13 );
+        auto e = _mm_and_si128( o, shiftedExp );
+        o = _mm_add_epi32( o, expAdjust );
+
+        // Inf / NaN.
+        auto infMask = _mm_cmpeq_epi32( e, shiftedExp );
+        o = _mm_add_epi32( o, _mm_and_si128( infMask, infAdjust ) );
+
+        // 非正規化数.
+        auto denormMask = _mm_cmpeq_epi32( e, zero );
+        auto denorm     = _mm_castps_si128( _mm_sub_ps( _mm_castsi128_ps( _mm_add_epi32( o, denormOne ) ), magic ) );
+        o = _mm_or_si128( _mm_and_si128( denormMask, denorm ), _mm_andnot_si128( denormMask, o ) );
+
+        o = _mm_or_si128( o, _mm_slli_epi32( _mm_xor_si128( h, _mm_and_si128( h, maskNoSign ) ), 16 ) );
+        _mm_storeu_ps( pDst + i, _mm_castsi128_ps( o ) );
+    }
+
+    if (i < count)
+    { glare::detail::DecodeHalfScalar( pSrc + i, count - i, pDst + i ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      単精度浮動小数から半精度浮動小数に変換します(最近接偶数丸め). スカラー実装と同じ結果になります.
+//-------------------------------------------------------------------------------------------
+void EncodeHalfSSE2( const float* pSrc, int count, uint16_t* pDst )
+{
+    const auto signMask    = _mm_set1_epi32( int( 0x80000000u ) );
+    const auto infBits     = _mm_set1_epi32( 255 << 23 );
+    const auto maxBits     = _mm_set1_epi32( ( ( 127 + 16 ) << 23 ) - 1 );
+    const auto minNormal   = _mm_set1_epi32( 113 << 23 );
+    const auto denormBits  = _mm_set1_epi32( ( ( 127 - 15 ) + ( 23 - 10 ) + 1 ) << 23 );
+    const auto roundBias   = _mm_set1_epi32( int( ( uint32_t( 15 - 127 ) << 23 ) + 0xfffu ) );
+    const auto infHalf     = _mm_set1_epi32( 0x7c00 );
+    const auto nanHalf     = _mm_set1_epi32( 0x7e00 );
+    const auto one         = _mm_set1_epi32( 1 );
+
+    auto i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i result[2];
+        for(auto j=0; j<2; ++j)
+        {
+            auto f    = _mm_castps_si128( _mm_loadu_ps( pSrc + i + j * 4 ) );
+            auto sign = _mm_and_si128( f, signMask );
+            f = _mm_xor_si128( f, sign );
+
+            // オーバーフローは Inf，NaN は Quiet NaN.
+            auto overflowMask = _mm_cmpgt_epi32( f, maxBits );
+            auto nanMask      = _mm_cmpgt_epi32( f, infBits );
+            auto overflow     = _mm_or_si128( _mm_and_si128( nanMask, nanHalf ), _mm_andnot_si128( nanMask, infHalf ) );
+
+            // 非正規化数.
+            auto denormMask = _mm_cmplt_epi32( f, minNormal );
+            auto denorm     = _mm_sub_epi32( _mm_castps_si128( _mm_add_ps( _mm_castsi128_ps( f ), _mm_castsi128_ps( denormBits ) ) ), denormBits );
+
+            auto odd    = _mm_and_si128( _mm_srli_epi32( f, 13 ), one );
+            auto normal = _mm_srli_epi32( _mm_add_epi32( _mm_add_epi32( f, roundBias ), odd ), 13 );
+
+            auto o = _mm_or_si128( _mm_and_si128( denormMask, denorm ), _mm_andnot_si128( denormMask, normal ) );
+            o = _mm_or_si128( _mm_and_si128( overflowMask, overflow ), _mm_andnot_si128( overflowMask, o ) );
+
+            // 符号を算術シフトで埋めて，符号付きの飽和パックでも下位16bitを保つ.
+            result[j] = _mm_or_si128( o, _mm_srai_epi32( sign, 16 ) );
+        }
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( pDst + i ), _mm_packs_epi32( result[0], result[1] ) );
+    }
+
+    if (i < count)
+    { glare::detail::EncodeHalfScalar( pSrc + i, count - i, pDst + i ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      sRGBのRGBA8を線形値に変換します.
+//-------------------------------------------------------------------------------------------
+void DecodeSrgbSSE2( const uint8_t* pSrc, int count, float* pDst )
+{
+    const auto pTable = glare::detail::GetSrgbDecodeTable();
+    const auto scale  = _mm_setr_ps( 1.0f, 1.0f, 1.0f, 255.0f );
+
+    for(auto i=0; i<count; ++i)
+    {
+        auto p = pSrc + i * 4;
+        auto v = _mm_setr_ps( pTable[p[0]], pTable[p[1]], pTable[p[2]], float(p[3]) );
+        _mm_storeu_ps( pDst + i * 4, _mm_div_ps( v, scale ) );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      線形値をsRGBのRGBA8に変換します. テーブルの参照以外をベクトル化します.
+//-------------------------------------------------------------------------------------------
+void EncodeSrgbSSE2( const float* pSrc, int count, uint8_t* pDst )
+{
+    const auto pTable = glare::detail::GetSrgbEncodeTable();
+    const auto zero   = _mm_setzero_ps();
+    const auto one    = _mm_set1_ps( 1.0f );
+    const auto half   = _mm_set1_ps( 0.5f );
+    const auto scale  = _mm_setr_ps( float(glare::detail::SRGB_TABLE_SIZE - 1), float(glare::detail::SRGB_TABLE_SIZE - 1), float(glare::detail::SRGB_TABLE_SIZE - 1), 255.0f );
+
+    auto i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        // NaN は _mm_max_ps が2番目のオペランドを返すので0になる.
+        alignas(16) int32_t index[16];
+        for(auto j=0; j<4; ++j)
+        {
+            auto v = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( pSrc + ( i + j ) * 4 ), zero ), one );
+            _mm_store_si128( reinterpret_cast<__m128i*>( index + j * 4 ), _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( v, scale ), half ) ) );
+        }
+
+        for(auto j=0; j<4; ++j)
+        {
+            index[j * 4 + 0] = pTable[index[j * 4 + 0]];
+            index[j * 4 + 1] = pTable[index[j * 4 + 1]];
+            index[j * 4 + 2] = pTable[index[j * 4 + 2]];
+        }
+
+        auto lo = _mm_packs_epi32( _mm_load_si128( reinterpret_cast<const __m128i*>( index     ) ), _mm_load_si128( reinterpret_cast<const __m128i*>( index + 4  ) ) );
+        auto hi = _mm_packs_epi32( _mm_load_si128( reinterpret_cast<const __m128i*>( index + 8 ) ), _mm_load_si128( reinterpret_cast<const __m128i*>( index + 12 ) ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( pDst + i * 4 ), _mm_packus_epi16( lo, hi ) );
+    }
+
+    if (i < count)
+    { glare::detail::EncodeSrgbScalar( pSrc + i * 4, count - i, pDst + i * 4 ); }
+}
+
+} // namespace
+#endif//GLARE_SIMD_SSE2
+
+
+namespace glare {
+namespace detail {
+
+//-------------------------------------------------------------------------------------------
+//      SSE2実装の関数テーブルを取得します.
+//-------------------------------------------------------------------------------------------
+bool GetBlurFuncTableSSE2( BlurFuncTable& table )
+{
+#if GLARE_SIMD_SSE2
+    table.ConvolveRow    = ConvolveRowSSE2;
+    table.ConvolveColumn = ConvolveColumnSSE2;
+    table.DecodeHalf     = DecodeHalfSSE2;
+    table.EncodeHalf     = EncodeHalfSSE2;
+    table.DecodeSrgb     = DecodeSrgbSSE2;
+    table.EncodeSrgb     = EncodeSrgbSSE2;
+    return true;
+#else
+    (void)table;
+    return false;
+#endif
+}
+
+} // namespace detail
+} // namespace glare
@@ -0,0 +1,568 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareStar.cpp
+// Desc : Star Streak Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareStar.h>
+#include <glareMath.h>
+#include <glareThreadPool.h>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   ROW_GRAIN   = 8;        //!< 1タスクで処理する行数です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// StarTap structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct StarTap
+{
+    int     OffsetX;        //!< 横方向のオフセット(テクセル)です.
+    int     OffsetY;        //!< 縦方向のオフセット(テクセル)です.
+    float   Weight;         //!< 重みです.
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// StarPass structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct StarPass
+{
+    StarTap Taps[glare::STAR_TAP_COUNT];    //!< タップです.
+};
+
+
+//-------------------------------------------------------------------------------------------
+//      サンプリング方向を求めます.
+//-------------------------------------------------------------------------------------------
+glare::Vector2 GetDirection( const glare::StarParam& param, int index )
+{
+    auto angle = glare::F_2PI * float(index) / float(param.DirectionCount) + param.Rotation;
+    return glare::Vector2( cosf( angle ), sinf( angle ) );
+}
+
+//-------------------------------------------------------------------------------------------
+//      1パス分のタップを求めます.
+//
+//      ポイントサンプリングでは floor((x + 0.5) + d) = x + floor(0.5 + d) なので，
+//      StarPS.hlsl の各タップはピクセルによらない整数オフセットになる.
+//      オフセットは出力解像度のテクセル単位なので，縮小解像度では scaleX, scaleY を掛けて換算する.
+//-------------------------------------------------------------------------------------------
+void MakeStarPass
+(
+    const glare::Vector2&   dir,
+    float                   attenuation,
+    int                     pass,
+    float                   scaleX,
+    float                   scaleY,
+    StarPass&               result
+)
+{
+    auto b = powf( 4.0f, float(pass) );
+    for(auto s=0; s<glare::STAR_TAP_COUNT; ++s)
+    {
+        auto& tap = result.Taps[s];
+        tap.OffsetX = int( floorf( 0.5f + dir.x * ( b * s ) * scaleX ) );
+        tap.OffsetY = int( floorf( 0.5f + dir.y * ( b * s ) * scaleY ) );
+        tap.Weight  = powf( attenuation, b * s );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      1行分の値を [0, 1] に飽和させます.
+//-------------------------------------------------------------------------------------------
+void SaturateRow( int width, float* pRow )
+{
+    using namespace glare;
+
+    for(auto x=0; x<width; ++x)
+    { Store4( pRow + x * 4, Saturate( Load4( pRow + x * 4 ) ) ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      縮小してから閾値を差し引いた画像を作ります.
+//-------------------------------------------------------------------------------------------
+bool MakeBrightPass
+(
+    const glare::Image& src,
+    int                 factor,
+    float               threshold,
+    bool                saturate,
+    glare::Image&       dst,
+    glare::ThreadPool*  pPool
+)
+{
+    using namespace glare;
+
+    if (!Downsample( src, factor, dst, pPool ))
+    { return false; }
+
+    auto value = Set4( threshold, threshold, threshold, 0.0f );
+    ParallelFor( pPool, dst.GetHeight(), ROW_GRAIN, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto pRow = dst.GetRow( y );
+            for(auto x=0; x<dst.GetWidth(); ++x)
+            { Store4( pRow + x * 4, Max( Sub( Load4( pRow + x * 4 ), value ), Zero4() ) ); }
+
+            // UNORM の描画先は [0, 1] に飽和する.
+            if (saturate)
+            { SaturateRow( dst.GetWidth(), pRow ); }
+        }
+    });
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      縮小解像度の結果をリニアサンプリングで拡大します.
+//-------------------------------------------------------------------------------------------
+void Upsample( const glare::Image& src, glare::Image& dst, glare::ThreadPool* pPool )
+{
+    using namespace glare;
+
+    auto w = dst.GetWidth();
+    auto h = dst.GetHeight();
+
+    ParallelFor( pPool, h, ROW_GRAIN, [&](int begin, int end)
+    {
+        RowSampler sampler;
+        for(auto y=begin; y<end; ++y)
+        {
+            sampler.Setup( src, ( float(y) + 0.5f ) / float(h) );
+
+            auto pRow = dst.GetRow( y );
+            for(auto x=0; x<w; ++x)
+            { Store4( pRow + x * 4, sampler.Sample( ( float(x) + 0.5f ) / float(w) ) ); }
+        }
+    });
+}
+
+//-------------------------------------------------------------------------------------------
+//      1行分のタップを適用し，出力行に加算します.
+//
+//      画像の外はクランプするので，行を左端，内側，右端の3区間に分けて処理します.
+//-------------------------------------------------------------------------------------------
+void AccumulateRow( const glare::Image& src, const StarPass& pass, int y, float* pDst )
+{
+    using namespace glare;
+
+    auto w    = src.GetWidth();
+    auto last = src.GetHeight() - 1;
+
+    for(auto s=0; s<STAR_TAP_COUNT; ++s)
+    {
+        auto& tap  = pass.Taps[s];
+        auto  sy   = y + tap.OffsetY;
+        sy = ( sy < 0 ) ? 0 : ( sy > last ) ? last : sy;
+
+        auto pRow   = src.GetRow( sy );
+        auto weight = Splat4( tap.Weight );
+        auto begin  = std::min( std::max( -tap.OffsetX, 0 ), w );
+        auto end    = std::max( std::min( w - tap.OffsetX, w ), begin );
+
+        auto left = Mul( Load4( pRow ), weight );
+        for(auto x=0; x<begin; ++x)
+        { Store4( pDst + x * 4, Add( Load4( pDst + x * 4 ), left ) ); }
+
+        auto pSrc = pRow + tap.OffsetX * 4;
+        for(auto x=begin; x<end; ++x)
+        { Store4( pDst + x * 4, Madd( Load4( pSrc + x * 4 ), weight, Load4( pDst + x * 4 ) ) ); }
+
+        auto right = Mul( Load4( pRow + ( w - 1 ) * 4 ), weight );
+        for(auto x=end; x<w; ++x)
+        { Store4( pDst + x * 4, Add( Load4( pDst + x * 4 ), right ) ); }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      Star サンプルの描画を書き下して光芒を加算します.
+//
+//      invW, invH は出力解像度のテクセルサイズで，オフセットはこの単位で計算します.
+//-------------------------------------------------------------------------------------------
+bool DrawStreaksReference
+(
+    const glare::Image&     src,
+    const glare::StarParam& param,
+    float                   invW,
+    float                   invH,
+    glare::Image&           dst
+)
+{
+    using namespace glare;
+
+    auto w = src.GetWidth();
+    auto h = src.GetHeight();
+
+    Image work[2];
+    for(auto i=0; i<2; ++i)
+    {
+        if (!work[i].Create( w, h ))
+        { return false; }
+    }
+
+    dst.Clear( 0.0f, 0.0f, 0.0f, 1.0f );
+
+    for(auto j=0; j<param.DirectionCount; ++j)
+    {
+        // サンプリング方向.
+        auto dir = GetDirection( param, j );
+
+        const Image* pInput = &src;
+
+        // ピンポンブラー.
+        for(auto i=0; i<param.PassCount; ++i)
+        {
+            auto& output = work[i % 2];
+
+            float offsetX[STAR_TAP_COUNT];
+            float offsetY[STAR_TAP_COUNT];
+            float weight [STAR_TAP_COUNT];
+            for(auto s=0; s<STAR_TAP_COUNT; ++s)
+            {
+                auto b = powf( 4.0f, float(i) );
+                offsetX[s] = dir.x * ( b * s ) * invW;
+                offsetY[s] = dir.y * ( b * s ) * invH;
+                weight [s] = powf( param.Attenuation, ( b * s ) );
+            }
+
+            for(auto y=0; y<h; ++y)
+            {
+                auto v = ( float(y) + 0.5f ) / float(h);
+                for(auto x=0; x<w; ++x)
+                {
+                    auto u = ( float(x) + 0.5f ) / float(w);
+
+                    float result[4] = {};
+                    for(auto s=0; s<STAR_TAP_COUNT; ++s)
+                    {
+                        // ポイントサンプラー(クランプ).
+                        auto tx = int( floorf( ( u + offsetX[s] ) * float(w) ) );
+                        auto ty = int( floorf( ( v + offsetY[s] ) * float(h) ) );
+                        tx = ( tx < 0 ) ? 0 : ( tx >= w ) ? w - 1 : tx;
+                        ty = ( ty < 0 ) ? 0 : ( ty >= h ) ? h - 1 : ty;
+
+                        auto pTexel = pInput->GetRow( ty ) + tx * 4;
+                        for(auto c=0; c<4; ++c)
+                        { result[c] += weight[s] * pTexel[c]; }
+                    }
+
+                    // UNORM の描画先は [0, 1] に飽和する.
+                    if (param.SaturatePass)
+                    {
+                        for(auto c=0; c<4; ++c)
+                        { result[c] = ( result[c] < 0.0f ) ? 0.0f : ( result[c] > 1.0f ) ? 1.0f : result[c]; }
+                    }
+
+                    memcpy( output.GetRow( y ) + x * 4, result, sizeof(result) );
+                }
+            }
+
+            pInput = &output;
+        }
+
+        // 加算合成.
+        for(auto y=0; y<h; ++y)
+        {
+            auto pDst = dst.GetRow( y );
+            auto pSrc = pInput->GetRow( y );
+            for(auto x=0; x<w * 4; ++x)
+            {
+                pDst[x] += pSrc[x];
+                if (param.SaturatePass && pDst[x] > 1.0f)
+                { pDst[x] = 1.0f; }
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      Star サンプルと同じ既定のパラメータを取得します.
+//-------------------------------------------------------------------------------------------
+StarParam GetDefaultStarParam()
+{
+    StarParam result;
+    result.DirectionCount   = 4;
+    result.Rotation         = F_PIDIV4;
+    result.Attenuation      = 0.925f;
+    result.PassCount        = 3;
+    result.DownsampleFactor = 1;
+    result.Threshold        = 0.0f;
+    result.SaturatePass     = false;
+    return result;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// StarStreak class
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------
+StarStreak::StarStreak()
+: m_pPool       ( nullptr )
+, m_Width       ( 0 )
+, m_Height      ( 0 )
+, m_SlotCount   ( 0 )
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------
+StarStreak::~StarStreak()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------
+//      初期化処理です.
+//-------------------------------------------------------------------------------------------
+bool StarStreak::Init( int width, int height, ThreadPool* pPool )
+{
+    if (width <= 0 || height <= 0)
+    { return false; }
+
+    Term();
+
+    m_pPool  = pPool;
+    m_Width  = width;
+    m_Height = height;
+
+    // スレッド数より多くの方向を同時に進めても並列度は上がらないので，作業バッファはスレッド数分だけ持つ.
+    m_SlotCount = ( pPool != nullptr ) ? pPool->GetThreadCount() : 1;
+    m_SlotCount = std::min( std::max( m_SlotCount, 1 ), MAX_STAR_DIRECTION_COUNT );
+
+    for(auto i=0; i<m_SlotCount; ++i)
+    {
+        if (!m_WorkBuffer[i][0].Create( width, height )
+         || !m_WorkBuffer[i][1].Create( width, height ))
+        {
+            Term();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      終了処理です.
+//-------------------------------------------------------------------------------------------
+void StarStreak::Term()
+{
+    for(auto i=0; i<MAX_STAR_DIRECTION_COUNT; ++i)
+    {
+        m_WorkBuffer[i][0].Release();
+        m_WorkBuffer[i][1].Release();
+        m_ReducedBuffer[i][0].Release();
+        m_ReducedBuffer[i][1].Release();
+    }
+
+    m_ReducedSource.Release();
+    m_ReducedResult.Release();
+
+    m_pPool     = nullptr;
+    m_Width     = 0;
+    m_Height    = 0;
+    m_SlotCount = 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//      パラメータとサイズが正しいかチェックします.
+//-------------------------------------------------------------------------------------------
+bool StarStreak::IsValid( const Image& src, const StarParam& param, const Image& dst ) const
+{
+    if (param.DirectionCount < MIN_STAR_DIRECTION_COUNT || param.DirectionCount > MAX_STAR_DIRECTION_COUNT)
+    { return false; }
+
+    if (param.PassCount < 1 || param.PassCount > MAX_STAR_PASS_COUNT)
+    { return false; }
+
+    if (param.DownsampleFactor != 1 && param.DownsampleFactor != 2 && param.DownsampleFactor != MAX_STAR_DOWNSAMPLE_FACTOR)
+    { return false; }
+
+    if (m_SlotCount == 0)
+    { return false; }
+
+    return src.GetWidth()  == m_Width  && src.GetHeight() == m_Height
+        && dst.GetWidth()  == m_Width  && dst.GetHeight() == m_Height;
+}
+
+//-------------------------------------------------------------------------------------------
+//      全方向の光芒を描画して出力に足し合わせます.
+//
+//      src と dst は同じサイズで，オフセットは m_Width, m_Height を基準に換算します.
+//-------------------------------------------------------------------------------------------
+void StarStreak::DrawStreaks
+(
+    const Image&        src,
+    const StarParam&    param,
+    Image               (&work)[MAX_STAR_DIRECTION_COUNT][2],
+    Image&              dst
+)
+{
+    auto w = src.GetWidth();
+    auto h = src.GetHeight();
+
+    auto scaleX = float(w) / float(m_Width);
+    auto scaleY = float(h) / float(m_Height);
+
+    StarPass passes[MAX_STAR_DIRECTION_COUNT][MAX_STAR_PASS_COUNT];
+    for(auto d=0; d<param.DirectionCount; ++d)
+    {
+        auto dir = GetDirection( param, d );
+        for(auto i=0; i<param.PassCount; ++i)
+        { MakeStarPass( dir, param.Attenuation, i, scaleX, scaleY, passes[d][i] ); }
+    }
+
+    // Star サンプルの m_WorkBuffer[3] のクリアカラーです.
+    dst.Clear( 0.0f, 0.0f, 0.0f, 1.0f );
+
+    // m_SlotCount 方向ずつ同時に進める.
+    for(auto first=0; first<param.DirectionCount; first+=m_SlotCount)
+    {
+        auto group = std::min( m_SlotCount, param.DirectionCount - first );
+
+        const Image* pSrc[MAX_STAR_DIRECTION_COUNT];
+        for(auto g=0; g<group; ++g)
+        { pSrc[g] = &src; }
+
+        for(auto i=0; i<param.PassCount - 1; ++i)
+        {
+            // (方向, 行) の組を1つの範囲として分配する.
+            ParallelFor( m_pPool, group * h, ROW_GRAIN, [&](int begin, int end)
+            {
+                for(auto index=begin; index<end; ++index)
+                {
+                    auto g    = index / h;
+                    auto y    = index % h;
+                    auto pDst = work[g][i & 1].GetRow( y );
+
+                    memset( pDst, 0, sizeof(float) * 4 * size_t(w) );
+                    AccumulateRow( *pSrc[g], passes[first + g][i], y, pDst );
+
+                    if (param.SaturatePass)
+                    { SaturateRow( w, pDst ); }
+                }
+            });
+
+            for(auto g=0; g<group; ++g)
+            { pSrc[g] = &work[g][i & 1]; }
+        }
+
+        // 最後のパスは全方向の結果を行ごとに出力へ足し込む.
+        auto i = param.PassCount - 1;
+        ParallelFor( m_pPool, h, ROW_GRAIN, [&](int begin, int end)
+        {
+            // 飽和させる場合は方向ごとのパスの結果を飽和させてから足し込む.
+            std::vector<float> row( ( param.SaturatePass ) ? size_t(w) * 4 : 0 );
+
+            for(auto y=begin; y<end; ++y)
+            {
+                auto pDst = dst.GetRow( y );
+                for(auto g=0; g<group; ++g)
+                {
+                    if (!param.SaturatePass)
+                    {
+                        AccumulateRow( *pSrc[g], passes[first + g][i], y, pDst );
+                        continue;
+                    }
+
+                    memset( row.data(), 0, sizeof(float) * row.size() );
+                    AccumulateRow( *pSrc[g], passes[first + g][i], y, row.data() );
+                    SaturateRow( w, row.data() );
+
+                    for(auto x=0; x<w; ++x)
+                    { Store4( pDst + x * 4, Add( Load4( pDst + x * 4 ), Load4( row.data() + x * 4 ) ) ); }
+                }
+
+                if (param.SaturatePass)
+                { SaturateRow( w, pDst ); }
+            }
+        });
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      光芒を描画します.
+//-------------------------------------------------------------------------------------------
+bool StarStreak::Execute( const Image& src, const StarParam& param, Image& dst )
+{
+    if (!IsValid( src, param, dst ) || &src == &dst)
+    { return false; }
+
+    if (param.DownsampleFactor == 1)
+    {
+        DrawStreaks( src, param, m_WorkBuffer, dst );
+        return true;
+    }
+
+    // 全方向で共有する縮小画像を1度だけ作る.
+    if (!MakeBrightPass( src, param.DownsampleFactor, param.Threshold, param.SaturatePass, m_ReducedSource, m_pPool ))
+    { return false; }
+
+    auto w = m_ReducedSource.GetWidth();
+    auto h = m_ReducedSource.GetHeight();
+    if (!m_ReducedResult.Create( w, h ))
+    { return false; }
+
+    for(auto i=0; i<m_SlotCount; ++i)
+    {
+        if (!m_ReducedBuffer[i][0].Create( w, h )
+         || !m_ReducedBuffer[i][1].Create( w, h ))
+        { return false; }
+    }
+
+    DrawStreaks( m_ReducedSource, param, m_ReducedBuffer, m_ReducedResult );
+
+    // 合成時に1度だけ拡大する.
+    Upsample( m_ReducedResult, dst, m_pPool );
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      検証用のスカラー実装で光芒を描画します.
+//-------------------------------------------------------------------------------------------
+bool StarStreak::ExecuteReference( const Image& src, const StarParam& param, Image& dst )
+{
+    if (!IsValid( src, param, dst ) || &src == &dst)
+    { return false; }
+
+    // レンダーターゲットサイズの逆数.
+    auto invW = 1.0f / float(m_Width);
+    auto invH = 1.0f / float(m_Height);
+
+    if (param.DownsampleFactor == 1)
+    { return DrawStreaksReference( src, param, invW, invH, dst ); }
+
+    Image source;
+    Image result;
+    if (!MakeBrightPass( src, param.DownsampleFactor, param.Threshold, param.SaturatePass, source, nullptr )
+     || !result.Create( source.GetWidth(), source.GetHeight() )
+     || !DrawStreaksReference( source, param, invW, invH, result ))
+    { return false; }
+
+    Upsample( result, dst, nullptr );
+
+    return true;
+}
+
+} // namespace glare
@@ -0,0 +1,184 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareThreadPool.cpp
+// Desc : Thread Pool Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareThreadPool.h>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Global Varaibles.
+//-------------------------------------------------------------------------------------------
+thread_local bool   g_IsWorker = false;     //!< ワーカースレッド上で実行中かどうか.
+
+} // namespace
+
+
+namespace glare {
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// ThreadPool class
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool()
+: m_pFunc       ( nullptr )
+, m_Next        ( 0 )
+, m_Count       ( 0 )
+, m_Grain       ( 1 )
+, m_Busy        ( 0 )
+, m_Generation  ( 0 )
+, m_Quit        ( false )
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------
+//      初期化処理です.
+//-------------------------------------------------------------------------------------------
+bool ThreadPool::Init( int threadCount )
+{
+    Term();
+
+    if (threadCount <= 0)
+    { threadCount = int(std::thread::hardware_concurrency()); }
+
+    if (threadCount <= 0)
+    { threadCount = 1; }
+
+    m_Quit = false;
+
+    // 呼び出しスレッドも処理に参加するので1つ少なく生成.
+    for(auto i=1; i<threadCount; ++i)
+    { m_Threads.emplace_back( &ThreadPool::Worker, this ); }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      終了処理です.
+//-------------------------------------------------------------------------------------------
+void ThreadPool::Term()
+{
+    {
+        std::lock_guard<std::mutex> locker( m_Mutex );
+        m_Quit = true;
+    }
+    m_WakeCond.notify_all();
+
+    for(auto& itr : m_Threads)
+    { itr.join(); }
+
+    m_Threads.clear();
+}
+
+//-------------------------------------------------------------------------------------------
+//      スレッド数を取得します.
+//-------------------------------------------------------------------------------------------
+int ThreadPool::GetThreadCount() const
+{ return int(m_Threads.size()) + 1; }
+
+//-------------------------------------------------------------------------------------------
+//      並列実行します.
+//-------------------------------------------------------------------------------------------
+void ThreadPool::ParallelFor( int count, int grain, const std::function<void(int, int)>& func )
+{
+    if (count <= 0)
+    { return; }
+
+    if (grain <= 0)
+    { grain = 1; }
+
+    // 分割する意味が無い場合や入れ子呼び出しは逐次実行.
+    if (m_Threads.empty() || count <= grain || g_IsWorker)
+    {
+        func( 0, count );
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit( m_SubmitMutex );
+
+    {
+        std::lock_guard<std::mutex> locker( m_Mutex );
+        m_pFunc = &func;
+        m_Count = count;
+        m_Grain = grain;
+        m_Next.store( 0 );
+        m_Busy  = int(m_Threads.size());
+        m_Generation++;
+    }
+    m_WakeCond.notify_all();
+
+    // 呼び出しスレッドも処理.
+    g_IsWorker = true;
+    Drain();
+    g_IsWorker = false;
+
+    // 全ワーカーの完了を待機.
+    std::unique_lock<std::mutex> locker( m_Mutex );
+    m_DoneCond.wait( locker, [this] { return m_Busy == 0; } );
+    m_pFunc = nullptr;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ワーカースレッドの処理です.
+//-------------------------------------------------------------------------------------------
+void ThreadPool::Worker()
+{
+    g_IsWorker = true;
+    unsigned int generation = 0;
+
+    for(;;)
+    {
+        {
+            std::unique_lock<std::mutex> locker( m_Mutex );
+            m_WakeCond.wait( locker, [&] { return m_Quit || m_Generation != generation; } );
+
+            if (m_Quit)
+            { return; }
+
+            generation = m_Generation;
+        }
+
+        Drain();
+
+        {
+            std::lock_guard<std::mutex> locker( m_Mutex );
+            m_Busy--;
+        }
+        m_DoneCond.notify_one();
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      残っている範囲を処理します.
+//-------------------------------------------------------------------------------------------
+void ThreadPool::Drain()
+{
+    for(;;)
+    {
+        auto begin = m_Next.fetch_add( m_Grain );
+        if (begin >= m_Count)
+        { break; }
+
+        auto end = begin + m_Grain;
+        if (end > m_Count)
+        { end = m_Count; }
+
+        (*m_pFunc)( begin, end );
+    }
+}
+
+} // namespace glare
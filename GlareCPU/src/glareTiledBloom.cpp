@@ -0,0 +1,746 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareTiledBloom.cpp
+// Desc : Tiled Bloom Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareTiledBloom.h>
+#include <glareMapFile.h>
+#include <glareMapWriter.h>
+#include <glareSeparableBlur.h>
+#include <glareGaussBlur.h>
+#include <glareThreadPool.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int       MAX_TILE_SIZE   = 1024;                     //!< タイルの一辺の最大値です.
+const int       MIN_TILE_SIZE   = 16;                       //!< タイルの一辺の最小値です.
+const size_t    TEXEL_SIZE      = sizeof(float) * 4;        //!< RGBA32Fの1テクセルのバイト数です.
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// MappedFile class
+/////////////////////////////////////////////////////////////////////////////////////////////
+class MappedFile
+{
+public:
+    //---------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------
+    MappedFile()
+    : m_pData   ( nullptr )
+    , m_Size    ( 0 )
+#if defined(_WIN32)
+    , m_hFile   ( INVALID_HANDLE_VALUE )
+#endif
+    { /* DO_NOTHING */ }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------
+    ~MappedFile()
+    { Close(); }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      指定サイズのファイルを作成し，読み書き可能でマップします.
+    //!
+    //! @param [in]     filename    ファイル名です.
+    //! @param [in]     size        ファイルのバイトサイズです.
+    //! @param [in]     temporary   閉じた時にファイルを削除するかどうか.
+    //---------------------------------------------------------------------------------------
+    bool Create( const char* filename, size_t size, bool temporary )
+    {
+        Close();
+
+        if (filename == nullptr || size == 0)
+        { return false; }
+
+        void* pData = nullptr;
+
+    #if defined(_WIN32)
+        auto flags = ( temporary )
+            ? ( FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE )
+            : FILE_ATTRIBUTE_NORMAL;
+
+        // FILE_FLAG_DELETE_ON_CLOSE はハンドルを閉じた時に削除されるので，閉じるまで保持する.
+        m_hFile = CreateFileA( filename, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, flags, nullptr );
+        if (m_hFile == INVALID_HANDLE_VALUE)
+        { return false; }
+
+        LARGE_INTEGER fileSize;
+        fileSize.QuadPart = LONGLONG(size);
+
+        auto hMapping = CreateFileMappingA( m_hFile, nullptr, PAGE_READWRITE, DWORD(fileSize.HighPart), fileSize.LowPart, nullptr );
+        if (hMapping != nullptr)
+        {
+            pData = MapViewOfFile( hMapping, FILE_MAP_ALL_ACCESS, 0, 0, 0 );
+            CloseHandle( hMapping );
+        }
+
+        if (pData == nullptr)
+        {
+            Close();
+            return false;
+        }
+    #else
+        auto fd = open( filename, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+        if (fd < 0)
+        { return false; }
+
+        // 名前を消しても記述子とマップが残っている間は使える.
+        if (temporary)
+        { unlink( filename ); }
+
+        if (ftruncate( fd, off_t(size) ) != 0)
+        {
+            close( fd );
+            return false;
+        }
+
+        auto pMapped = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        close( fd );
+        if (pMapped == MAP_FAILED)
+        { return false; }
+
+        pData = pMapped;
+    #endif
+
+        m_pData = static_cast<uint8_t*>( pData );
+        m_Size  = size;
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      ファイルを閉じます.
+    //---------------------------------------------------------------------------------------
+    void Close()
+    {
+    #if defined(_WIN32)
+        if (m_pData != nullptr)
+        { UnmapViewOfFile( m_pData ); }
+
+        if (m_hFile != INVALID_HANDLE_VALUE)
+        { CloseHandle( m_hFile ); }
+
+        m_hFile = INVALID_HANDLE_VALUE;
+    #else
+        if (m_pData != nullptr)
+        { munmap( m_pData, m_Size ); }
+    #endif
+
+        m_pData = nullptr;
+        m_Size  = 0;
+    }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      先頭アドレスを取得します.
+    //---------------------------------------------------------------------------------------
+    uint8_t* GetData() const
+    { return m_pData; }
+
+private:
+    uint8_t*    m_pData;        //!< マップした先頭です.
+    size_t      m_Size;         //!< バイトサイズです.
+#if defined(_WIN32)
+    HANDLE      m_hFile;        //!< ファイルハンドルです.
+#endif
+
+    MappedFile      ( const MappedFile& );      // アクセス禁止.
+    void operator = ( const MappedFile& );      // アクセス禁止.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// LevelBuffer structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct LevelBuffer
+{
+    int         Width;      //!< 横幅です.
+    int         Height;     //!< 縦幅です.
+    MappedFile  File;       //!< RGBA32Fの行を隙間なく並べた一時ファイルです.
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      先頭ピクセルを取得します.
+    //---------------------------------------------------------------------------------------
+    float* GetPixels() const
+    { return reinterpret_cast<float*>( File.GetData() ); }
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      指定行の先頭ピクセルを取得します.
+    //---------------------------------------------------------------------------------------
+    float* GetRow( int y ) const
+    { return GetPixels() + size_t(y) * size_t(Width) * 4; }
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Region structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct Region
+{
+    const float*    pPixels;    //!< (OriginX, OriginY) のテクセルです.
+    size_t          Pitch;      //!< 1行あたりのfloat数です.
+    int             OriginX;    //!< 先頭テクセルの画像上の位置です.
+    int             OriginY;    //!< 先頭テクセルの画像上の位置です.
+
+    //---------------------------------------------------------------------------------------
+    //! @brief      画像上の位置のテクセルを取得します.
+    //---------------------------------------------------------------------------------------
+    const float* GetTexel( int x, int y ) const
+    { return pPixels + size_t(y - OriginY) * Pitch + size_t(x - OriginX) * 4; }
+};
+
+
+//-------------------------------------------------------------------------------------------
+//      ページをワーキングセットから外します. 内容はファイルに残ります.
+//-------------------------------------------------------------------------------------------
+void ReleasePages( const void* pData, size_t size )
+{
+    if (pData == nullptr || size == 0)
+    { return; }
+
+#if defined(_WIN32)
+    // ロックしていないページに対する VirtualUnlock はワーキングセットから外す.
+    VirtualUnlock( const_cast<void*>( pData ), size );
+#else
+    static const auto pageSize = uintptr_t( sysconf( _SC_PAGESIZE ) );
+
+    auto begin = reinterpret_cast<uintptr_t>( pData ) & ~( pageSize - 1 );
+    auto end   = reinterpret_cast<uintptr_t>( pData ) + size;
+    madvise( reinterpret_cast<void*>( begin ), size_t( end - begin ), MADV_DONTNEED );
+#endif
+}
+
+//-------------------------------------------------------------------------------------------
+//      MAPサーフェイスの行範囲をワーキングセットから外します.
+//-------------------------------------------------------------------------------------------
+void ReleaseSurfaceRows( const glare::MapSurface& surface, int begin, int end )
+{
+    // ブロック圧縮は全ての行を処理し終えたブロック行だけを外す.
+    if (glare::IsBlockCompressed( surface.Format ))
+    {
+        begin = begin / 4;
+        end   = ( end >= int(surface.Height) ) ? ( end + 3 ) / 4 : end / 4;
+    }
+
+    if (end > begin)
+    { ReleasePages( surface.pData + size_t(begin) * surface.Pitch, size_t(end - begin) * surface.Pitch ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      一時ファイルの行範囲をワーキングセットから外します.
+//-------------------------------------------------------------------------------------------
+void ReleaseLevelRows( const LevelBuffer& level, int begin, int end )
+{
+    if (end > begin)
+    { ReleasePages( level.GetRow( begin ), size_t(end - begin) * size_t(level.Width) * TEXEL_SIZE ); }
+}
+
+//-------------------------------------------------------------------------------------------
+//      画像を生成します. サイズが変わる場合は先に解放し，新旧のバッファが同時に存在しないようにします.
+//-------------------------------------------------------------------------------------------
+bool CreateImage( glare::Image& image, int width, int height )
+{
+    if (image.GetWidth() != width || image.GetHeight() != height)
+    { image.Release(); }
+
+    return image.Create( width, height );
+}
+
+//-------------------------------------------------------------------------------------------
+//      MAPサーフェイスの矩形をデコードします. 左上はブロック境界である必要があります.
+//-------------------------------------------------------------------------------------------
+bool DecodeRegion( const glare::MapSurface& surface, int x0, int y0, int x1, int y1, glare::Image& image )
+{
+    if (!CreateImage( image, x1 - x0, y1 - y0 ))
+    { return false; }
+
+    auto compressed  = glare::IsBlockCompressed( surface.Format );
+    auto elementSize = glare::GetMapElementSize( surface.Format );
+
+    glare::MapSurface region = surface;
+    if (compressed)
+    { region.pData += size_t(y0 / 4) * surface.Pitch + size_t(x0 / 4) * elementSize; }
+    else
+    { region.pData += size_t(y0) * surface.Pitch + size_t(x0) * elementSize; }
+
+    region.Width      = uint32_t(x1 - x0);
+    region.Height     = uint32_t(y1 - y0);
+    region.SlicePitch = surface.Pitch * ( ( compressed ) ? ( region.Height + 3 ) / 4 : region.Height );
+
+    return glare::DecodeMapSurface( region, image );
+}
+
+//-------------------------------------------------------------------------------------------
+//      矩形を縮小します. glare::Downsample() と同じ値になります.
+//-------------------------------------------------------------------------------------------
+void DownsampleRegion
+(
+    const Region&       src,
+    int                 srcWidth,
+    int                 srcHeight,
+    int                 factor,
+    int                 dstX,
+    int                 dstY,
+    glare::Image&       dst,
+    glare::ThreadPool*  pPool
+)
+{
+    auto w      = dst.GetWidth();
+    auto weight = glare::Splat4( 1.0f / float(factor * factor) );
+
+    glare::ParallelFor( pPool, dst.GetHeight(), 8, [&](int begin, int end)
+    {
+        for(auto y=begin; y<end; ++y)
+        {
+            auto pDst = dst.GetRow( y );
+
+            for(auto x=0; x<w; ++x)
+            {
+                auto sum = glare::Zero4();
+                for(auto j=0; j<factor; ++j)
+                {
+                    auto sy = ( dstY + y ) * factor + j;
+                    if (sy >= srcHeight) { sy = srcHeight - 1; }
+
+                    for(auto i=0; i<factor; ++i)
+                    {
+                        auto sx = ( dstX + x ) * factor + i;
+                        if (sx >= srcWidth) { sx = srcWidth - 1; }
+                        sum = glare::Add( sum, glare::Load4( src.GetTexel( sx, sy ) ) );
+                    }
+                }
+
+                glare::Store4( pDst + x * 4, glare::Mul( sum, weight ) );
+            }
+        }
+    });
+}
+
+//-------------------------------------------------------------------------------------------
+//      1行分の入力に全段を拡大して加算します. アルファは1.0になります.
+//-------------------------------------------------------------------------------------------
+void CompositeRow
+(
+    const float*                pSrc,
+    int                         x0,
+    int                         count,
+    int                         width,
+    const glare::RowSampler*    pSamplers,
+    int                         levelCount,
+    float*                      pDst
+)
+{
+    for(auto i=0; i<count; ++i)
+    {
+        auto u     = ( float(x0 + i) + 0.5f ) / float(width);
+        auto color = glare::Load4( pSrc + i * 4 );
+        for(auto l=0; l<levelCount; ++l)
+        { color = glare::Add( color, pSamplers[l].Sample( u ) ); }
+
+        glare::Store4( pDst + i * 4, color );
+        pDst[i * 4 + 3] = 1.0f;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      設定を検証し，ブラーカーネルを生成します.
+//-------------------------------------------------------------------------------------------
+bool MakeKernels( const glare::TiledBloomDesc& desc, glare::BlurKernel& horizontal, glare::BlurKernel& vertical )
+{
+    if (desc.LevelCount < 1 || desc.LevelCount > glare::MAX_BLOOM_LEVEL_COUNT)
+    { return false; }
+
+    return glare::MakeGaussKernel( glare::GAUSS_BLUR_TAP_COUNT, desc.Deviation, false, horizontal )
+        && glare::MakeGaussKernel( glare::GAUSS_BLUR_TAP_COUNT, desc.Deviation, true,  vertical );
+}
+
+//-------------------------------------------------------------------------------------------
+//      各段のサイズを求めます.
+//-------------------------------------------------------------------------------------------
+void CalcLevelSize( int width, int height, int levelCount, int* pWidths, int* pHeights )
+{
+    for(auto l=0; l<levelCount; ++l)
+    {
+        auto factor = ( l == 0 ) ? glare::BLOOM_DOWNSAMPLE_FACTOR : 2;
+        auto w      = ( l == 0 ) ? width  : pWidths [l - 1];
+        auto h      = ( l == 0 ) ? height : pHeights[l - 1];
+        pWidths [l] = std::max( w / factor, 1 );
+        pHeights[l] = std::max( h / factor, 1 );
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//      作業メモリに収まる最大のタイルサイズを選びます.
+//-------------------------------------------------------------------------------------------
+template<typename Estimate>
+int ChooseTileSize( size_t budget, Estimate estimate, size_t& workingSet )
+{
+    for(auto size=MAX_TILE_SIZE; size>=MIN_TILE_SIZE; size/=2)
+    {
+        auto bytes = estimate( size_t(size) );
+        if (bytes <= budget)
+        {
+            workingSet = std::max( workingSet, bytes );
+            return size;
+        }
+    }
+
+    return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// BlurPass structure
+/////////////////////////////////////////////////////////////////////////////////////////////
+struct BlurPass
+{
+    const glare::MapSurface*    pSurface;       //!< 入力ファイルから縮小する場合のサーフェイスです.
+    const LevelBuffer*          pLevel;         //!< 前段から縮小する場合の一時ファイルです.
+    int                         SrcWidth;       //!< 縮小元の横幅です.
+    int                         SrcHeight;      //!< 縮小元の縦幅です.
+    int                         Factor;         //!< 縮小率です.
+    int                         TileSize;       //!< タイルの一辺です.
+    const glare::BlurKernel*    pHorizontal;    //!< 横方向のカーネルです.
+    const glare::BlurKernel*    pVertical;      //!< 縦方向のカーネルです.
+};
+
+//-------------------------------------------------------------------------------------------
+//      1段分を縮小してブラーを掛け，一時ファイルに書き込みます.
+//-------------------------------------------------------------------------------------------
+bool ExecuteBlurPass( const BlurPass& pass, LevelBuffer& dst, glare::ThreadPool* pPool, int& tileCount )
+{
+    auto radius = std::max( pass.pHorizontal->Radius, pass.pVertical->Radius );
+    auto size   = pass.TileSize;
+    auto f      = pass.Factor;
+
+    glare::Image         decoded;
+    glare::Image         tile;
+    glare::SeparableBlur blur;
+
+    auto released = 0;
+    for(auto y0=0; y0<dst.Height; y0+=size)
+    {
+        auto y1  = std::min( y0 + size, dst.Height );
+        auto ey0 = std::max( y0 - radius, 0 );
+        auto ey1 = std::min( y1 + radius, dst.Height );
+
+        for(auto x0=0; x0<dst.Width; x0+=size)
+        {
+            auto x1  = std::min( x0 + size, dst.Width );
+            auto ex0 = std::max( x0 - radius, 0 );
+            auto ex1 = std::min( x1 + radius, dst.Width );
+
+            // 糊代を含めて縮小元を読み込む. 縮小元の端はクランプされるので画像内に収める.
+            Region region;
+            if (pass.pSurface != nullptr)
+            {
+                auto sx0 = ex0 * f;
+                auto sy0 = ey0 * f;
+                auto sx1 = std::min( ex1 * f, pass.SrcWidth );
+                auto sy1 = std::min( ey1 * f, pass.SrcHeight );
+                if (!DecodeRegion( *pass.pSurface, sx0, sy0, sx1, sy1, decoded ))
+                { return false; }
+
+                region.pPixels = decoded.GetPixels();
+                region.Pitch   = size_t(decoded.GetPitch());
+                region.OriginX = sx0;
+                region.OriginY = sy0;
+            }
+            else
+            {
+                region.pPixels = pass.pLevel->GetPixels();
+                region.Pitch   = size_t(pass.SrcWidth) * 4;
+                region.OriginX = 0;
+                region.OriginY = 0;
+            }
+
+            auto ew = ex1 - ex0;
+            auto eh = ey1 - ey0;
+            if (!CreateImage( tile, ew, eh ))
+            { return false; }
+
+            DownsampleRegion( region, pass.SrcWidth, pass.SrcHeight, f, ex0, ey0, tile, pPool );
+
+            // 糊代の外側は画像の端と同じくクランプされるが，内側のテクセルには影響しない.
+            auto surface = glare::GetSurface( tile );
+            if (!blur.Init( ew, eh )
+             || !blur.Execute( surface, *pass.pHorizontal, *pass.pVertical, surface, pPool ))
+            { return false; }
+
+            for(auto y=y0; y<y1; ++y)
+            { memcpy( dst.GetRow( y ) + x0 * 4, tile.GetRow( y - ey0 ) + ( x0 - ex0 ) * 4, size_t(x1 - x0) * TEXEL_SIZE ); }
+
+            tileCount++;
+        }
+
+        // 書き終えた行と，次の帯で使わない縮小元の行を手放す.
+        ReleaseLevelRows( dst, y0, y1 );
+
+        auto next = ( y1 < dst.Height ) ? std::min( std::max( y1 - radius, 0 ) * f, pass.SrcHeight ) : pass.SrcHeight;
+        if (pass.pSurface != nullptr)
+        { ReleaseSurfaceRows( *pass.pSurface, released, next ); }
+        else
+        { ReleaseLevelRows( *pass.pLevel, released, next ); }
+
+        released = std::max( released, next );
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      既定の設定を取得します.
+//-------------------------------------------------------------------------------------------
+TiledBloomDesc GetDefaultTiledBloomDesc()
+{
+    TiledBloomDesc result;
+    result.LevelCount   = 5;
+    result.Deviation    = 2.5f;
+    result.MemoryBudget = 256 * 1024 * 1024;
+    result.OutputFormat = MAP_FORMAT_R16G16B16A16_FLOAT;
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      メモリ上の画像に多段ブラーのブルームを適用します.
+//-------------------------------------------------------------------------------------------
+bool ApplyBloom( const Image& src, const TiledBloomDesc& desc, Image& dst, ThreadPool* pPool )
+{
+    BlurKernel horizontal;
+    BlurKernel vertical;
+    if (!MakeKernels( desc, horizontal, vertical ))
+    { return false; }
+
+    auto width  = src.GetWidth();
+    auto height = src.GetHeight();
+    if (width <= 0 || height <= 0 || &src == &dst)
+    { return false; }
+
+    Image         levels[MAX_BLOOM_LEVEL_COUNT];
+    SeparableBlur blur;
+    for(auto l=0; l<desc.LevelCount; ++l)
+    {
+        auto& level = levels[l];
+        if (!Downsample( ( l == 0 ) ? src : levels[l - 1], ( l == 0 ) ? BLOOM_DOWNSAMPLE_FACTOR : 2, level, pPool ))
+        { return false; }
+
+        auto surface = GetSurface( level );
+        if (!blur.Init( level.GetWidth(), level.GetHeight() )
+         || !blur.Execute( surface, horizontal, vertical, surface, pPool ))
+        { return false; }
+    }
+
+    if (!dst.Create( width, height ))
+    { return false; }
+
+    ParallelFor( pPool, height, 8, [&](int begin, int end)
+    {
+        RowSampler samplers[MAX_BLOOM_LEVEL_COUNT];
+        for(auto y=begin; y<end; ++y)
+        {
+            auto v = ( float(y) + 0.5f ) / float(height);
+            for(auto l=0; l<desc.LevelCount; ++l)
+            { samplers[l].Setup( levels[l], v ); }
+
+            CompositeRow( src.GetRow( y ), 0, width, width, samplers, desc.LevelCount, dst.GetRow( y ) );
+        }
+    });
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      MAPファイルの画像にタイル単位でブルームを適用し，MAPファイルに書き出します.
+//-------------------------------------------------------------------------------------------
+bool ApplyBloomTiled
+(
+    const char*             srcPath,
+    const char*             dstPath,
+    const TiledBloomDesc&   desc,
+    ThreadPool*             pPool,
+    TiledBloomStats*        pStats
+)
+{
+    BlurKernel horizontal;
+    BlurKernel vertical;
+    if (srcPath == nullptr || dstPath == nullptr
+     || IsBlockCompressed( desc.OutputFormat )
+     || !MakeKernels( desc, horizontal, vertical ))
+    { return false; }
+
+    MapView    view;
+    MapSurface src;
+    if (!view.Open( srcPath ) || !view.GetSurface( 0, 0, src ))
+    { return false; }
+
+    auto width  = int(src.Width);
+    auto height = int(src.Height);
+
+    MAP_SURFACE_INFO info;
+    size_t           dataOffset;
+    if (!CalcMapLayout( desc.OutputFormat, width, height, info, &dataOffset ))
+    { return false; }
+
+    int widths [MAX_BLOOM_LEVEL_COUNT];
+    int heights[MAX_BLOOM_LEVEL_COUNT];
+    CalcLevelSize( width, height, desc.LevelCount, widths, heights );
+
+    // 入力の1行あたりのバイト数. ブロック圧縮は4行分を1行とみなす.
+    auto srcRowBytes = ( IsBlockCompressed( src.Format ) ) ? ( size_t(src.Pitch) + 3 ) / 4 : size_t(src.Pitch);
+    auto dstRowBytes = size_t(info.Pitch);
+    auto radius      = size_t(std::max( horizontal.Radius, vertical.Radius ));
+
+    TiledBloomStats stats = {};
+
+    // パスごとに，タイルの作業バッファと常駐する帯(糊代込み)が予算に収まるタイルサイズを選ぶ.
+    for(auto l=0; l<desc.LevelCount; ++l)
+    {
+        auto factor   = size_t( ( l == 0 ) ? BLOOM_DOWNSAMPLE_FACTOR : 2 );
+        auto rowBytes = ( l == 0 ) ? srcRowBytes : size_t(widths[l - 1]) * TEXEL_SIZE;
+        auto dstWidth = size_t(widths[l]);
+
+        stats.TileSize[l] = ChooseTileSize( desc.MemoryBudget, [&](size_t size)
+        {
+            auto ext     = size + radius * 2;
+            auto srcRows = ext * factor;
+            auto threads = size_t( ( pPool != nullptr ) ? pPool->GetThreadCount() : 1 );
+            auto bytes   = ext * ext * TEXEL_SIZE;                      // タイル.
+            bytes += threads * ( radius * 2 + 1 ) * ext * TEXEL_SIZE;  // ブラーの行リングバッファ.
+            bytes += ext * ext * TEXEL_SIZE / 2;                        // 帯の境界の退避行(タイルの半分以下).
+            bytes += srcRows * rowBytes;                                // 縮小元の帯.
+            bytes += size * dstWidth * TEXEL_SIZE;                      // 書き込み中の帯.
+            if (l == 0)
+            { bytes += srcRows * srcRows * TEXEL_SIZE; }                // デコードした縮小元.
+            return bytes;
+        }, stats.WorkingSet );
+
+        if (stats.TileSize[l] == 0)
+        { return false; }
+    }
+
+    stats.TileSize[desc.LevelCount] = ChooseTileSize( desc.MemoryBudget, [&](size_t size)
+    {
+        auto bytes = size * size * TEXEL_SIZE;                          // デコードしたタイル.
+        bytes += size * ( srcRowBytes + dstRowBytes );                  // 入出力の帯.
+        for(auto l=0; l<desc.LevelCount; ++l)
+        { bytes += ( size * size_t(heights[l]) / size_t(height) + 3 ) * size_t(widths[l]) * TEXEL_SIZE; }
+        return bytes;
+    }, stats.WorkingSet );
+
+    if (stats.TileSize[desc.LevelCount] == 0)
+    { return false; }
+
+    // 中間結果は一時ファイルに置く.
+    LevelBuffer levels[MAX_BLOOM_LEVEL_COUNT];
+    for(auto l=0; l<desc.LevelCount; ++l)
+    {
+        char suffix[32];
+        snprintf( suffix, sizeof(suffix), ".level%d.tmp", l );
+
+        auto path = std::string( dstPath ) + suffix;
+        levels[l].Width  = widths[l];
+        levels[l].Height = heights[l];
+        if (!levels[l].File.Create( path.c_str(), size_t(widths[l]) * size_t(heights[l]) * TEXEL_SIZE, true ))
+        { return false; }
+    }
+
+    // 縮小とブラー.
+    for(auto l=0; l<desc.LevelCount; ++l)
+    {
+        BlurPass pass;
+        pass.pSurface    = ( l == 0 ) ? &src : nullptr;
+        pass.pLevel      = ( l == 0 ) ? nullptr : &levels[l - 1];
+        pass.SrcWidth    = ( l == 0 ) ? width  : widths [l - 1];
+        pass.SrcHeight   = ( l == 0 ) ? height : heights[l - 1];
+        pass.Factor      = ( l == 0 ) ? BLOOM_DOWNSAMPLE_FACTOR : 2;
+        pass.TileSize    = stats.TileSize[l];
+        pass.pHorizontal = &horizontal;
+        pass.pVertical   = &vertical;
+
+        if (!ExecuteBlurPass( pass, levels[l], pPool, stats.TileCount ))
+        { return false; }
+    }
+
+    // 合成して出力ファイルに直接エンコードする.
+    MappedFile output;
+    if (!output.Create( dstPath, dataOffset + info.SlicePitch, false ))
+    { return false; }
+
+    WriteMapHeader( desc.OutputFormat, info, output.GetData() );
+
+    auto pTexels     = output.GetData() + dataOffset;
+    auto elementSize = size_t(GetMapElementSize( desc.OutputFormat ));
+    auto size        = stats.TileSize[desc.LevelCount];
+
+    Image tile;
+    int   released[MAX_BLOOM_LEVEL_COUNT] = {};
+    for(auto y0=0; y0<height; y0+=size)
+    {
+        auto y1 = std::min( y0 + size, height );
+
+        for(auto x0=0; x0<width; x0+=size)
+        {
+            auto x1 = std::min( x0 + size, width );
+            if (!DecodeRegion( src, x0, y0, x1, y1, tile ))
+            { return false; }
+
+            ParallelFor( pPool, y1 - y0, 8, [&](int begin, int end)
+            {
+                RowSampler samplers[MAX_BLOOM_LEVEL_COUNT];
+                for(auto y=begin; y<end; ++y)
+                {
+                    auto v = ( float(y0 + y) + 0.5f ) / float(height);
+                    for(auto l=0; l<desc.LevelCount; ++l)
+                    { samplers[l].Setup( levels[l].GetPixels(), widths[l], heights[l], v ); }
+
+                    auto pRow = tile.GetRow( y );
+                    CompositeRow( pRow, x0, x1 - x0, width, samplers, desc.LevelCount, pRow );
+                    EncodeMapTexels( desc.OutputFormat, pRow, x1 - x0,
+                        pTexels + size_t(y0 + y) * info.Pitch + size_t(x0) * elementSize );
+                }
+            });
+
+            stats.TileCount++;
+        }
+
+        // 書き終えた行と，次の帯で参照しない行を手放す.
+        ReleaseSurfaceRows( src, y0, y1 );
+        ReleasePages( pTexels + size_t(y0) * info.Pitch, size_t(y1 - y0) * info.Pitch );
+
+        for(auto l=0; l<desc.LevelCount; ++l)
+        {
+            auto next = ( y1 < height )
+                ? std::min( std::max( RowSampler::GetRowIndex( heights[l], ( float(y1) + 0.5f ) / float(height) ), 0 ), heights[l] )
+                : heights[l];
+            ReleaseLevelRows( levels[l], released[l], next );
+            released[l] = std::max( released[l], next );
+        }
+    }
+
+    output.Close();
+
+    if (pStats != nullptr)
+    { *pStats = stats; }
+
+    return true;
+}
+
+} // namespace glare
@@ -0,0 +1,162 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : glareTiledBlur.cpp
+// Desc : Compute Shader Tiled Blur Emulation Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareTiledBlur.h>
+#include <glareThreadPool.h>
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+//      1グループ分のブラーを処理します.
+//
+//      GaussBlurTiled.hlsli の main() と同じく，ハローを含むテクセルをスレッド数おきに
+//      読み込んで共有メモリを埋め，同期した後に各スレッドが1テクセルずつ畳み込みます.
+//      pSrc, pDst は count 個のピクセルを stride floats 間隔で持つラインです.
+//-------------------------------------------------------------------------------------------
+void ProcessGroup
+(
+    const float*            pSrc,
+    float*                  pDst,
+    int                     count,
+    size_t                  stride,
+    int                     groupId,
+    const glare::BlurKernel& kernel,
+    glare::Float4*          pCache
+)
+{
+    using namespace glare;
+
+    auto radius    = kernel.Radius;
+    auto tapCount  = radius * 2 + 1;
+    auto cacheSize = GetTiledBlurCacheSize( radius );
+    auto origin    = groupId * TILED_BLUR_THREAD_COUNT - radius;
+    auto last      = count - 1;
+
+    // 共有メモリへの読み込み. 範囲外は端のテクセルを複製する.
+    for(auto t=0; t<TILED_BLUR_THREAD_COUNT; ++t)
+    {
+        for(auto i=t; i<cacheSize; i+=TILED_BLUR_THREAD_COUNT)
+        {
+            auto x = origin + i;
+            x = ( x < 0 ) ? 0 : ( x > last ) ? last : x;
+            pCache[i] = Load4( pSrc + size_t(x) * stride );
+        }
+    }
+
+    // GroupMemoryBarrierWithGroupSync()
+
+    // 共有メモリ上での畳み込み.
+    for(auto t=0; t<TILED_BLUR_THREAD_COUNT; ++t)
+    {
+        auto x = groupId * TILED_BLUR_THREAD_COUNT + t;
+        if ( x > last )
+        { break; }
+
+        auto result = Zero4();
+        for(auto k=0; k<tapCount; ++k)
+        { result = Madd( Splat4( kernel.Weight[k] ), pCache[t + k], result ); }
+
+        Store4( pDst + size_t(x) * stride, result );
+    }
+}
+
+} // namespace
+
+
+namespace glare {
+
+//-------------------------------------------------------------------------------------------
+//      1グループが共有メモリに読み込むテクセル数を取得します.
+//-------------------------------------------------------------------------------------------
+int GetTiledBlurCacheSize( int radius )
+{ return TILED_BLUR_THREAD_COUNT + radius * 2; }
+
+//-------------------------------------------------------------------------------------------
+//      1方向のブラーをコンピュートシェーダと同じタイル分割で処理します.
+//-------------------------------------------------------------------------------------------
+bool TiledBlurPass
+(
+    const Image&        src,
+    const BlurKernel&   kernel,
+    Image&              dst,
+    TiledBlurStats*     pStats,
+    ThreadPool*         pPool
+)
+{
+    auto w = src.GetWidth();
+    auto h = src.GetHeight();
+    if ( w <= 0 || h <= 0 || dst.GetWidth() != w || dst.GetHeight() != h || &src == &dst )
+    { return false; }
+
+    if ( kernel.Radius < 0 || kernel.Radius > TILED_BLUR_MAX_RADIUS )
+    { return false; }
+
+    // 縦方向は列をラインとして扱う.
+    auto count  = ( kernel.Vertical ) ? h : w;
+    auto lines  = ( kernel.Vertical ) ? w : h;
+    auto stride = ( kernel.Vertical ) ? size_t( src.GetPitch() ) : size_t(4);
+    auto step   = ( kernel.Vertical ) ? size_t(4) : size_t( src.GetPitch() );
+    auto groups = ( count + TILED_BLUR_THREAD_COUNT - 1 ) / TILED_BLUR_THREAD_COUNT;
+
+    auto pSrc = src.GetPixels();
+    auto pDst = dst.GetPixels();
+
+    ParallelFor( pPool, lines, 4, [&](int begin, int end)
+    {
+        std::vector<Float4> cache( GetTiledBlurCacheSize( kernel.Radius ) );
+        for(auto i=begin; i<end; ++i)
+        {
+            for(auto g=0; g<groups; ++g)
+            { ProcessGroup( pSrc + step * size_t(i), pDst + step * size_t(i), count, stride, g, kernel, cache.data() ); }
+        }
+    });
+
+    if ( pStats != nullptr )
+    {
+        // 端数のグループも全スレッドで共有メモリを埋める.
+        auto groupCount = uint64_t(groups) * uint64_t(lines);
+        pStats->GroupCount        += groupCount;
+        pStats->TextureFetchCount += groupCount * uint64_t( GetTiledBlurCacheSize( kernel.Radius ) );
+        pStats->SharedReadCount   += uint64_t(w) * uint64_t(h) * uint64_t( kernel.Radius * 2 + 1 );
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      横方向，縦方向の順にタイル分割したブラーを掛けます.
+//-------------------------------------------------------------------------------------------
+bool TiledBlur
+(
+    const Image&        src,
+    const BlurKernel&   horizontal,
+    const BlurKernel&   vertical,
+    Image&              temp,
+    Image&              dst,
+    TiledBlurStats*     pStats,
+    ThreadPool*         pPool
+)
+{
+    if ( horizontal.Vertical || !vertical.Vertical )
+    { return false; }
+
+    if ( pStats != nullptr )
+    {
+        pStats->GroupCount        = 0;
+        pStats->TextureFetchCount = 0;
+        pStats->SharedReadCount   = 0;
+    }
+
+    return TiledBlurPass( src,  horizontal, temp, pStats, pPool )
+        && TiledBlurPass( temp, vertical,   dst,  pStats, pPool );
+}
+
+} // namespace glare
@@ -0,0 +1,192 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : LensGhostTest.cpp
+// Desc : Lens Ghost Test.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareImage.h>
+#include <glareGaussBlur.h>
+#include <glareLensGhost.h>
+#include <glareThreadPool.h>
+#include <cmath>
+#include <cstdio>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Macros
+//-------------------------------------------------------------------------------------------
+#define CHECK( expr )                                                               \
+    do {                                                                            \
+        if ( !( expr ) )                                                            \
+        {                                                                           \
+            fprintf( stderr, "Error : %s(%d) : %s\n", __FILE__, __LINE__, #expr );  \
+            g_FailCount++;                                                          \
+        }                                                                           \
+    } while( 0 )
+
+
+//-------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------
+const int   WIDTH           = 256;
+const int   HEIGHT          = 144;
+const float TOLERANCE       = 1.0f / 255.0f;    // sample と同じ許容誤差.
+const float CHAIN_TOLERANCE = 0.03f;            // 飽和した中間バッファのリニアサンプリングは展開では再現できない.
+
+
+//-------------------------------------------------------------------------------------------
+// Global Variables
+//-------------------------------------------------------------------------------------------
+int g_FailCount = 0;
+
+
+//-------------------------------------------------------------------------------------------
+//      2つの画像の最大誤差を求めます.
+//-------------------------------------------------------------------------------------------
+float CalcMaxError( const glare::Image& a, const glare::Image& b )
+{
+    if (a.GetWidth() != b.GetWidth() || a.GetHeight() != b.GetHeight())
+    { return 1e+30f; }
+
+    auto count = size_t(a.GetWidth()) * size_t(a.GetHeight()) * 4;
+    auto pA = a.GetPixels();
+    auto pB = b.GetPixels();
+
+    auto result = 0.0f;
+    for(size_t i=0; i<count; ++i)
+    {
+        auto diff = fabsf( pA[i] - pB[i] );
+        if (diff > result)
+        { result = diff; }
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//      明るい点を散らした入力画像と周辺減光のマスクを生成します.
+//-------------------------------------------------------------------------------------------
+bool CreateInput( glare::Image& input, glare::Image& mask )
+{
+    if (!input.Create( WIDTH, HEIGHT ) || !mask.Create( WIDTH, HEIGHT ))
+    { return false; }
+
+    unsigned int seed = 12345;
+    for(auto y=0; y<HEIGHT; ++y)
+    {
+        for(auto x=0; x<WIDTH; ++x)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            auto bright = ( ( seed >> 24 ) < 4 ) ? 1.0f : 0.0f;
+            auto base   = float(x) / float(WIDTH) * 0.2f;
+            input.Store( x, y, glare::Set4( bright, base + bright * 0.5f, base, 1.0f ) );
+
+            auto u = ( float(x) + 0.5f ) / float(WIDTH)  * 2.0f - 1.0f;
+            auto v = ( float(y) + 0.5f ) / float(HEIGHT) * 2.0f - 1.0f;
+            auto m = 1.0f - 0.5f * ( u * u + v * v );
+            mask.Store( x, y, glare::Set4( m, m, m, 1.0f ) );
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      ブラーの重みと一様な画像の保存をテストします.
+//-------------------------------------------------------------------------------------------
+void TestGaussBlur( glare::ThreadPool* pPool )
+{
+    auto param = glare::CalcBlurParam( WIDTH, HEIGHT, glare::Vector2( 1.0f, 0.0f ), 5.0f );
+
+    auto total = 0.0f;
+    for(auto i=0; i<glare::GAUSS_BLUR_TAP_COUNT; ++i)
+    { total += param.Offset[i].z; }
+    CHECK( fabsf( total - 1.0f ) < 1e-5f );
+
+    glare::Image src;
+    glare::Image dst;
+    CHECK( src.Create( WIDTH, HEIGHT ) );
+    CHECK( dst.Create( WIDTH, HEIGHT ) );
+    src.Clear( 0.25f, 0.5f, 0.75f, 0.0f );
+
+    glare::GaussBlur( src, param, dst, pPool );
+
+    glare::Image expected;
+    CHECK( expected.Create( WIDTH, HEIGHT ) );
+    expected.Clear( 0.25f, 0.5f, 0.75f, 1.0f );
+    CHECK( CalcMaxError( dst, expected ) < 1e-5f );
+}
+
+//-------------------------------------------------------------------------------------------
+//      各描画方法の結果を検証用のスカラー実装と比較します.
+//-------------------------------------------------------------------------------------------
+void TestLensGhost( glare::ThreadPool* pPool )
+{
+    glare::Image input;
+    glare::Image mask;
+    CHECK( CreateInput( input, mask ) );
+
+    glare::LensGhost lensGhost;
+    CHECK( lensGhost.Init( WIDTH, HEIGHT, pPool ) );
+
+    glare::Image reference;
+    glare::Image output;
+    CHECK( reference.Create( WIDTH, HEIGHT ) );
+    CHECK( output.Create( WIDTH, HEIGHT ) );
+
+    lensGhost.ExecuteReference( input, mask, reference );
+    CHECK( CalcMaxError( reference, input ) > TOLERANCE );
+
+    lensGhost.SetMode( glare::LENS_GHOST_MODE_MULTI_PASS );
+    lensGhost.Execute( input, mask, output );
+    CHECK( CalcMaxError( output, reference ) <= TOLERANCE );
+
+    lensGhost.SetMode( glare::LENS_GHOST_MODE_FUSED );
+    lensGhost.Execute( input, mask, output );
+    CHECK( CalcMaxError( output, reference ) <= TOLERANCE );
+
+    lensGhost.SetMode( glare::LENS_GHOST_MODE_CHAIN );
+    lensGhost.SetChainThreshold( 0.0f );
+    lensGhost.Execute( input, mask, output );
+    CHECK( CalcMaxError( output, reference ) <= CHAIN_TOLERANCE );
+
+    lensGhost.Term();
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------------
+int main()
+{
+    glare::ThreadPool pool;
+    if (!pool.Init( 4 ))
+    {
+        fprintf( stderr, "Error : ThreadPool::Init() Failed.\n" );
+        return -1;
+    }
+
+    // 逐次実行とスレッドプールの両方で確認する.
+    TestGaussBlur( nullptr );
+    TestGaussBlur( &pool );
+    TestLensGhost( nullptr );
+    TestLensGhost( &pool );
+
+    pool.Term();
+
+    if ( g_FailCount != 0 )
+    {
+        fprintf( stderr, "LensGhostTest : %d check(s) failed.\n", g_FailCount );
+        return -1;
+    }
+
+    printf( "LensGhostTest : OK\n" );
+    return 0;
+}
@@ -0,0 +1,162 @@
+﻿//-------------------------------------------------------------------------------------------
+// File : ThreadPoolTest.cpp
+// Desc : Thread Pool Test.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------
+#include <glareThreadPool.h>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------
+// Macros
+//-------------------------------------------------------------------------------------------
+#define CHECK( expr )                                                               \
+    do {                                                                            \
+        if ( !( expr ) )                                                            \
+        {                                                                           \
+            fprintf( stderr, "Error : %s(%d) : %s\n", __FILE__, __LINE__, #expr );  \
+            g_FailCount++;                                                          \
+        }                                                                           \
+    } while( 0 )
+
+
+//-------------------------------------------------------------------------------------------
+// Global Variables
+//-------------------------------------------------------------------------------------------
+int g_FailCount = 0;
+
+
+//-------------------------------------------------------------------------------------------
+//      全ての要素がちょうど1回ずつ処理されたかチェックします.
+//-------------------------------------------------------------------------------------------
+bool IsCoveredOnce( const std::vector<std::atomic<int>>& visits )
+{
+    for(size_t i=0; i<visits.size(); ++i)
+    {
+        if (visits[i].load() != 1)
+        { return false; }
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//      範囲の分割と網羅をテストします.
+//-------------------------------------------------------------------------------------------
+void TestCoverage( int threadCount )
+{
+    glare::ThreadPool pool;
+    CHECK( pool.Init( threadCount ) );
+    CHECK( pool.GetThreadCount() == threadCount );
+
+    const int counts[] = { 1, 7, 64, 1000 };
+    const int grains[] = { 1, 3, 64, 4096 };
+    for(auto count : counts)
+    {
+        for(auto grain : grains)
+        {
+            std::vector<std::atomic<int>> visits( count );
+            for(auto& visit : visits)
+            { visit = 0; }
+
+            // ワーカーが無い場合や分割する意味が無い場合は全範囲を1回で処理するので，範囲の大きさは grain を超え得る.
+            std::atomic<int> badRange( 0 );
+            pool.ParallelFor( count, grain, [&]( int begin, int end )
+            {
+                if (begin < 0 || end > count || begin >= end)
+                { badRange++; }
+
+                for(auto i=begin; i<end; ++i)
+                { visits[i]++; }
+            });
+
+            CHECK( badRange == 0 );
+            CHECK( IsCoveredOnce( visits ) );
+        }
+    }
+
+    // 処理数が0なら呼び出さない.
+    auto called = false;
+    pool.ParallelFor( 0, 1, [&]( int, int ) { called = true; } );
+    CHECK( !called );
+
+    pool.Term();
+}
+
+//-------------------------------------------------------------------------------------------
+//      ワーカースレッドからの入れ子呼び出しをテストします.
+//-------------------------------------------------------------------------------------------
+void TestNested()
+{
+    glare::ThreadPool pool;
+    CHECK( pool.Init( 4 ) );
+
+    const int outer = 16;
+    const int inner = 32;
+    std::vector<std::atomic<int>> visits( outer * inner );
+    for(auto& visit : visits)
+    { visit = 0; }
+
+    pool.ParallelFor( outer, 1, [&]( int begin, int end )
+    {
+        for(auto i=begin; i<end; ++i)
+        {
+            pool.ParallelFor( inner, 4, [&]( int b, int e )
+            {
+                for(auto j=b; j<e; ++j)
+                { visits[i * inner + j]++; }
+            });
+        }
+    });
+
+    CHECK( IsCoveredOnce( visits ) );
+    pool.Term();
+}
+
+//-------------------------------------------------------------------------------------------
+//      スレッドプールが無い場合の逐次実行をテストします.
+//-------------------------------------------------------------------------------------------
+void TestSerial()
+{
+    auto calls = 0;
+    glare::ParallelFor( nullptr, 100, 8, [&]( int begin, int end )
+    {
+        CHECK( begin == 0 );
+        CHECK( end   == 100 );
+        calls++;
+    });
+    CHECK( calls == 1 );
+
+    glare::ParallelFor( nullptr, 0, 8, [&]( int, int ) { calls++; } );
+    CHECK( calls == 1 );
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------------
+int main()
+{
+    TestCoverage( 1 );
+    TestCoverage( 4 );
+    TestNested();
+    TestSerial();
+
+    if ( g_FailCount != 0 )
+    {
+        fprintf( stderr, "ThreadPoolTest : %d check(s) failed.\n", g_FailCount );
+        return -1;
+    }
+
+    printf( "ThreadPoolTest : OK\n" );
+    return 0;
+}
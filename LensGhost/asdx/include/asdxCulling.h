@@ -0,0 +1,264 @@
+﻿//-------------------------------------------------------------------------------------
+// File : asdxCulling.h
+// Desc : Culling Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------
+
+#ifndef __ASDX_CULLING_H__
+#define __ASDX_CULLING_H__
+
+//-------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------
+#include <asdxGeometry.h>
+#include <vector>
+#include <thread>
+#include <new>
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////
+// BoundsArray class
+///////////////////////////////////////////////////////////////////////////////////////
+class BoundsArray
+{
+    //=================================================================================
+    // list of friend classes and methods.
+    //=================================================================================
+    /* NOTHING */
+
+public:
+    //=================================================================================
+    // public variables.
+    //=================================================================================
+    static const u32 NUM_BATCH = 16;    //!< 1回のループで判定する要素数です. 容量はこの倍数に切り上げます.
+
+    //=================================================================================
+    // public methods.
+    //=================================================================================
+
+    //---------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------
+    BoundsArray();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------
+    virtual ~BoundsArray();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      初期化処理です.
+    //!
+    //! @param [in]     capacity    格納できる境界ボリュームの最大数です.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //---------------------------------------------------------------------------------
+    bool Init( u32 capacity );
+
+    //---------------------------------------------------------------------------------
+    //! @brief      終了処理です.
+    //---------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      格納した境界ボリュームを全て破棄します. 容量は変わりません.
+    //---------------------------------------------------------------------------------
+    void Clear();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      境界箱を末尾に追加します.
+    //!
+    //! @param [in]     value       追加する境界箱です.
+    //! @retval true    追加に成功.
+    //! @retval false   容量が足りない場合は失敗.
+    //---------------------------------------------------------------------------------
+    bool Add( const BoundingBox& value );
+
+    //---------------------------------------------------------------------------------
+    //! @brief      境界球を末尾に追加します.
+    //!
+    //! @param [in]     value       追加する境界球です.
+    //! @retval true    追加に成功.
+    //! @retval false   容量が足りない場合は失敗.
+    //---------------------------------------------------------------------------------
+    bool Add( const BoundingSphere& value );
+
+    //---------------------------------------------------------------------------------
+    //! @brief      境界箱を設定します.
+    //!
+    //! @param [in]     index       設定する要素番号です. 格納数未満である必要があります.
+    //! @param [in]     value       設定する境界箱です.
+    //! @note       外接球の半径には中心から頂点までの距離を設定します.
+    //---------------------------------------------------------------------------------
+    void SetAt( u32 index, const BoundingBox& value );
+
+    //---------------------------------------------------------------------------------
+    //! @brief      境界球を設定します.
+    //!
+    //! @param [in]     index       設定する要素番号です. 格納数未満である必要があります.
+    //! @param [in]     value       設定する境界球です.
+    //! @note       中心から面までの距離には半径を設定します.
+    //---------------------------------------------------------------------------------
+    void SetAt( u32 index, const BoundingSphere& value );
+
+    //---------------------------------------------------------------------------------
+    //! @brief      格納数を取得します.
+    //!
+    //! @return     格納されている境界ボリュームの数を返却します.
+    //---------------------------------------------------------------------------------
+    u32 GetCount() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      容量を取得します.
+    //!
+    //! @return     NUM_BATCH の倍数に切り上げた容量を返却します.
+    //---------------------------------------------------------------------------------
+    u32 GetCapacity() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      中心のX成分の配列を取得します.
+    //---------------------------------------------------------------------------------
+    const f32* GetCenterX() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      中心のY成分の配列を取得します.
+    //---------------------------------------------------------------------------------
+    const f32* GetCenterY() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      中心のZ成分の配列を取得します.
+    //---------------------------------------------------------------------------------
+    const f32* GetCenterZ() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      中心から面までのX方向の距離の配列を取得します.
+    //---------------------------------------------------------------------------------
+    const f32* GetExtentX() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      中心から面までのY方向の距離の配列を取得します.
+    //---------------------------------------------------------------------------------
+    const f32* GetExtentY() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      中心から面までのZ方向の距離の配列を取得します.
+    //---------------------------------------------------------------------------------
+    const f32* GetExtentZ() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      外接球の半径の配列を取得します.
+    //---------------------------------------------------------------------------------
+    const f32* GetRadius() const;
+
+protected:
+    //=================================================================================
+    // protected variables.
+    //=================================================================================
+    static const u32 NUM_STREAM = 7;    //!< 1要素当たりの成分数です.
+
+    f32*    m_pData;        //!< 全成分を格納するバッファです.
+    f32*    m_pCenterX;     //!< 中心のX成分です.
+    f32*    m_pCenterY;     //!< 中心のY成分です.
+    f32*    m_pCenterZ;     //!< 中心のZ成分です.
+    f32*    m_pExtentX;     //!< 中心から面までのX方向の距離です.
+    f32*    m_pExtentY;     //!< 中心から面までのY方向の距離です.
+    f32*    m_pExtentZ;     //!< 中心から面までのZ方向の距離です.
+    f32*    m_pRadius;      //!< 外接球の半径です.
+    u32     m_Count;        //!< 格納数です.
+    u32     m_Capacity;     //!< 容量です.
+
+    //=================================================================================
+    // protected methods.
+    //=================================================================================
+    /* NOTHING */
+
+private:
+    //=================================================================================
+    // private variables.
+    //=================================================================================
+    /* NOTHING */
+
+    //=================================================================================
+    // private methods.
+    //=================================================================================
+    BoundsArray     ( const BoundsArray& value );       // アクセス禁止.
+    void operator = ( const BoundsArray& value );       // アクセス禁止.
+};
+
+
+//-------------------------------------------------------------------------------------
+//! @brief      視錐台カリングを行い，可視な要素番号を詰めて出力します.
+//!
+//! @param [in]     frustum     視錐台です. 平面式は正規化されている必要があります.
+//! @param [in]     bounds      判定する境界ボリュームです.
+//! @param [in]     begin       判定を開始する要素番号です.
+//! @param [in]     end         判定を終了する要素番号です(この要素は含みません).
+//! @param [out]    pIndices    可視な要素番号の出力先です. end - begin 個分の領域が必要です.
+//! @return     出力した要素番号の数を返却します.
+//! @note       NUM_BATCH 個ずつ6平面と SIMD で判定します.
+//!             境界箱と外接球のうち，各平面の法線方向に投影した半径が小さい方で判定するので，
+//!             境界箱は BoundingFrustum::Intersects( const BoundingBox& ) と，
+//!             境界球は BoundingFrustum::Intersects( const BoundingSphere& ) と同じ判定になります.
+//!             要素番号は昇順に出力します.
+//-------------------------------------------------------------------------------------
+u32 FrustumCull
+(
+    const BoundingFrustum&  frustum,
+    const BoundsArray&      bounds,
+    u32                     begin,
+    u32                     end,
+    u32*                    pIndices
+);
+
+//-------------------------------------------------------------------------------------
+//! @brief      視錐台カリングを行い，可視な要素のビットを立てたマスクを出力します.
+//!
+//! @param [in]     frustum     視錐台です. 平面式は正規化されている必要があります.
+//! @param [in]     bounds      判定する境界ボリュームです.
+//! @param [in]     begin       判定を開始する要素番号です. 8の倍数である必要があります.
+//! @param [in]     end         判定を終了する要素番号です(この要素は含みません).
+//! @param [out]    pMask       マスクの出力先です. 要素 i は pMask[ i / 8 ] のビット ( i % 8 ) です.
+//! @note       begin から end までを含むバイトだけを書き込むので，
+//!             8の倍数で区切った範囲ごとに別のスレッドから同じマスクへ出力できます.
+//-------------------------------------------------------------------------------------
+void FrustumCullMask
+(
+    const BoundingFrustum&  frustum,
+    const BoundsArray&      bounds,
+    u32                     begin,
+    u32                     end,
+    u8*                     pMask
+);
+
+//-------------------------------------------------------------------------------------
+//! @brief      全要素を複数のスレッドに分割して視錐台カリングを行います.
+//!
+//! @param [in]     frustum     視錐台です. 平面式は正規化されている必要があります.
+//! @param [in]     bounds      判定する境界ボリュームです.
+//! @param [in]     threadCount 使用するスレッド数です(呼び出したスレッドを含みます).
+//! @param [out]    pIndices    可視な要素番号の出力先です. bounds.GetCount() 個分の領域が必要です.
+//! @return     出力した要素番号の数を返却します.
+//! @note       NUM_BATCH の倍数で区切った範囲ごとに FrustumCull() を呼び出し，
+//!             各範囲の結果を pIndices 内で詰め直します. 結果は FrustumCull() と一致します.
+//!             1スレッド当たりの要素数が少ない場合は使用するスレッド数を減らします.
+//-------------------------------------------------------------------------------------
+u32 FrustumCullParallel
+(
+    const BoundingFrustum&  frustum,
+    const BoundsArray&      bounds,
+    u32                     threadCount,
+    u32*                    pIndices
+);
+
+} // namespace asdx
+
+
+//-------------------------------------------------------------------------------------
+// Inline Files
+//-------------------------------------------------------------------------------------
+#include "asdxCulling.inl"
+
+
+#endif//__ASDX_CULLING_H__
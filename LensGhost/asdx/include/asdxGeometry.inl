@@ -10,6 +10,594 @@
 
 namespace asdx {
 
+///////////////////////////////////////////////////////////////////////////////////////
+// SIMD Functions
+///////////////////////////////////////////////////////////////////////////////////////
+namespace simd {
+
+#if defined(ASDX_USE_AVX2) && ASDX_USE_AVX2
+typedef __m256          f32x8;      // 8要素の値です.
+typedef __m256          mask8;      // 各要素の全ビットが立っていれば真です.
+
+ASDX_INLINE f32x8 Load8( const f32* p )                 { return _mm256_loadu_ps( p ); }
+ASDX_INLINE void  Store8( f32* p, f32x8 v )             { _mm256_storeu_ps( p, v ); }
+ASDX_INLINE f32x8 Splat8( f32 s )                       { return _mm256_set1_ps( s ); }
+ASDX_INLINE f32x8 Add( f32x8 a, f32x8 b )               { return _mm256_add_ps( a, b ); }
+ASDX_INLINE f32x8 Sub( f32x8 a, f32x8 b )               { return _mm256_sub_ps( a, b ); }
+ASDX_INLINE f32x8 Mul( f32x8 a, f32x8 b )               { return _mm256_mul_ps( a, b ); }
+ASDX_INLINE f32x8 Div( f32x8 a, f32x8 b )               { return _mm256_div_ps( a, b ); }
+ASDX_INLINE f32x8 Min( f32x8 a, f32x8 b )               { return _mm256_min_ps( a, b ); }
+ASDX_INLINE f32x8 Max( f32x8 a, f32x8 b )               { return _mm256_max_ps( a, b ); }
+ASDX_INLINE f32x8 Sqrt( f32x8 v )                       { return _mm256_sqrt_ps( v ); }
+ASDX_INLINE f32x8 Abs( f32x8 v )                        { return _mm256_andnot_ps( _mm256_set1_ps( -0.0f ), v ); }
+ASDX_INLINE f32x8 Neg( f32x8 v )                        { return _mm256_xor_ps( _mm256_set1_ps( -0.0f ), v ); }
+ASDX_INLINE mask8 CmpLt( f32x8 a, f32x8 b )             { return _mm256_cmp_ps( a, b, _CMP_LT_OQ ); }
+ASDX_INLINE mask8 CmpLe( f32x8 a, f32x8 b )             { return _mm256_cmp_ps( a, b, _CMP_LE_OQ ); }
+ASDX_INLINE mask8 CmpGt( f32x8 a, f32x8 b )             { return _mm256_cmp_ps( a, b, _CMP_GT_OQ ); }
+ASDX_INLINE mask8 CmpGe( f32x8 a, f32x8 b )             { return _mm256_cmp_ps( a, b, _CMP_GE_OQ ); }
+ASDX_INLINE mask8 And( mask8 a, mask8 b )               { return _mm256_and_ps( a, b ); }
+ASDX_INLINE mask8 Or( mask8 a, mask8 b )                { return _mm256_or_ps( a, b ); }
+ASDX_INLINE f32x8 Select( f32x8 a, f32x8 b, mask8 m )   { return _mm256_blendv_ps( a, b, m ); }
+ASDX_INLINE u32   ToBits( mask8 m )                     { return u32( _mm256_movemask_ps( m ) ); }
+
+//-------------------------------------------------------------------------------------
+//      ビットマスク(ビットiが要素i)を要素ごとのマスクに展開します.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+mask8 FromBits( u32 bits )
+{
+    const __m256i lane = _mm256_setr_epi32( 1, 2, 4, 8, 16, 32, 64, 128 );
+    __m256i v = _mm256_and_si256( _mm256_set1_epi32( s32( bits ) ), lane );
+    return _mm256_castsi256_ps( _mm256_cmpeq_epi32( v, lane ) );
+}
+
+//-------------------------------------------------------------------------------------
+//      連続した8個の3次元ベクトルを SoA に並べ替えて読み込みます.
+//
+//      Intel の "3D Vector Normalization Using 256-Bit Intel AVX" と同じ手順で，
+//      128bit ずつ読み込んでから3回のシャッフルで x, y, z に分けます.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+void LoadVector3x8( const Vector3* pValues, f32x8& x, f32x8& y, f32x8& z )
+{
+    const f32* p = &pValues[0].x;
+
+    f32x8 m03 = _mm256_castps128_ps256( _mm_loadu_ps( p +  0 ) );
+    f32x8 m14 = _mm256_castps128_ps256( _mm_loadu_ps( p +  4 ) );
+    f32x8 m25 = _mm256_castps128_ps256( _mm_loadu_ps( p +  8 ) );
+    m03 = _mm256_insertf128_ps( m03, _mm_loadu_ps( p + 12 ), 1 );
+    m14 = _mm256_insertf128_ps( m14, _mm_loadu_ps( p + 16 ), 1 );
+    m25 = _mm256_insertf128_ps( m25, _mm_loadu_ps( p + 20 ), 1 );
+
+    f32x8 xy = _mm256_shuffle_ps( m14, m25, _MM_SHUFFLE( 2, 1, 3, 2 ) );
+    f32x8 yz = _mm256_shuffle_ps( m03, m14, _MM_SHUFFLE( 1, 0, 2, 1 ) );
+    x = _mm256_shuffle_ps( m03, xy,  _MM_SHUFFLE( 2, 0, 3, 0 ) );
+    y = _mm256_shuffle_ps( yz,  xy,  _MM_SHUFFLE( 3, 1, 2, 0 ) );
+    z = _mm256_shuffle_ps( yz,  m25, _MM_SHUFFLE( 3, 0, 3, 1 ) );
+}
+
+//-------------------------------------------------------------------------------------
+//      SoA の8要素を連続した3次元ベクトルとして書き込みます.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+void StoreVector3x8( Vector3* pValues, f32x8 x, f32x8 y, f32x8 z )
+{
+    f32* p = &pValues[0].x;
+
+    f32x8 rxy = _mm256_shuffle_ps( x, y, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    f32x8 ryz = _mm256_shuffle_ps( y, z, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+    f32x8 rzx = _mm256_shuffle_ps( z, x, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+    f32x8 r03 = _mm256_shuffle_ps( rxy, rzx, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    f32x8 r14 = _mm256_shuffle_ps( ryz, rxy, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+    f32x8 r25 = _mm256_shuffle_ps( rzx, ryz, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+
+    _mm_storeu_ps( p +  0, _mm256_castps256_ps128( r03 ) );
+    _mm_storeu_ps( p +  4, _mm256_castps256_ps128( r14 ) );
+    _mm_storeu_ps( p +  8, _mm256_castps256_ps128( r25 ) );
+    _mm_storeu_ps( p + 12, _mm256_extractf128_ps( r03, 1 ) );
+    _mm_storeu_ps( p + 16, _mm256_extractf128_ps( r14, 1 ) );
+    _mm_storeu_ps( p + 20, _mm256_extractf128_ps( r25, 1 ) );
+}
+#elif defined(ASDX_USE_SSE) && ASDX_USE_SSE
+//-------------------------------------------------------------------------------------
+//      SSE2 の場合は4要素ずつ2回に分けて処理します.
+//-------------------------------------------------------------------------------------
+struct f32x8 { __m128 lo; __m128 hi; };
+typedef f32x8           mask8;      // 各要素の全ビットが立っていれば真です.
+
+#define ASDX_SIMD_HALVES( expr_lo, expr_hi )     f32x8 r; r.lo = expr_lo; r.hi = expr_hi; return r;
+
+ASDX_INLINE f32x8 Load8( const f32* p )                 { ASDX_SIMD_HALVES( _mm_loadu_ps( p ), _mm_loadu_ps( p + 4 ) ) }
+ASDX_INLINE void  Store8( f32* p, const f32x8& v )      { _mm_storeu_ps( p, v.lo ); _mm_storeu_ps( p + 4, v.hi ); }
+ASDX_INLINE f32x8 Splat8( f32 s )                       { ASDX_SIMD_HALVES( _mm_set1_ps( s ), _mm_set1_ps( s ) ) }
+ASDX_INLINE f32x8 Add( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_add_ps( a.lo, b.lo ), _mm_add_ps( a.hi, b.hi ) ) }
+ASDX_INLINE f32x8 Sub( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_sub_ps( a.lo, b.lo ), _mm_sub_ps( a.hi, b.hi ) ) }
+ASDX_INLINE f32x8 Mul( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_mul_ps( a.lo, b.lo ), _mm_mul_ps( a.hi, b.hi ) ) }
+ASDX_INLINE f32x8 Div( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_div_ps( a.lo, b.lo ), _mm_div_ps( a.hi, b.hi ) ) }
+ASDX_INLINE f32x8 Min( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_min_ps( a.lo, b.lo ), _mm_min_ps( a.hi, b.hi ) ) }
+ASDX_INLINE f32x8 Max( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_max_ps( a.lo, b.lo ), _mm_max_ps( a.hi, b.hi ) ) }
+ASDX_INLINE f32x8 Sqrt( const f32x8& v )                { ASDX_SIMD_HALVES( _mm_sqrt_ps( v.lo ), _mm_sqrt_ps( v.hi ) ) }
+ASDX_INLINE f32x8 Abs( const f32x8& v )                 { __m128 s = _mm_set1_ps( -0.0f ); ASDX_SIMD_HALVES( _mm_andnot_ps( s, v.lo ), _mm_andnot_ps( s, v.hi ) ) }
+ASDX_INLINE f32x8 Neg( const f32x8& v )                 { __m128 s = _mm_set1_ps( -0.0f ); ASDX_SIMD_HALVES( _mm_xor_ps( s, v.lo ), _mm_xor_ps( s, v.hi ) ) }
+ASDX_INLINE mask8 CmpLt( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_cmplt_ps( a.lo, b.lo ), _mm_cmplt_ps( a.hi, b.hi ) ) }
+ASDX_INLINE mask8 CmpLe( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_cmple_ps( a.lo, b.lo ), _mm_cmple_ps( a.hi, b.hi ) ) }
+ASDX_INLINE mask8 CmpGt( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_cmpgt_ps( a.lo, b.lo ), _mm_cmpgt_ps( a.hi, b.hi ) ) }
+ASDX_INLINE mask8 CmpGe( const f32x8& a, const f32x8& b ) { ASDX_SIMD_HALVES( _mm_cmpge_ps( a.lo, b.lo ), _mm_cmpge_ps( a.hi, b.hi ) ) }
+ASDX_INLINE mask8 And( const mask8& a, const mask8& b ) { ASDX_SIMD_HALVES( _mm_and_ps( a.lo, b.lo ), _mm_and_ps( a.hi, b.hi ) ) }
+ASDX_INLINE mask8 Or( const mask8& a, const mask8& b )  { ASDX_SIMD_HALVES( _mm_or_ps( a.lo, b.lo ), _mm_or_ps( a.hi, b.hi ) ) }
+ASDX_INLINE u32   ToBits( const mask8& m )              { return u32( _mm_movemask_ps( m.lo ) | ( _mm_movemask_ps( m.hi ) << 4 ) ); }
+
+ASDX_INLINE
+f32x8 Select( const f32x8& a, const f32x8& b, const mask8& m )
+{
+    ASDX_SIMD_HALVES(
+        _mm_or_ps( _mm_and_ps( m.lo, b.lo ), _mm_andnot_ps( m.lo, a.lo ) ),
+        _mm_or_ps( _mm_and_ps( m.hi, b.hi ), _mm_andnot_ps( m.hi, a.hi ) ) )
+}
+
+ASDX_INLINE
+mask8 FromBits( u32 bits )
+{
+    const __m128i laneLo = _mm_setr_epi32(  1,  2,  4,   8 );
+    const __m128i laneHi = _mm_setr_epi32( 16, 32, 64, 128 );
+    __m128i v = _mm_set1_epi32( s32( bits ) );
+    ASDX_SIMD_HALVES(
+        _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( v, laneLo ), laneLo ) ),
+        _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( v, laneHi ), laneHi ) ) )
+}
+
+#undef ASDX_SIMD_HALVES
+
+//-------------------------------------------------------------------------------------
+//      連続した4個の3次元ベクトルを SoA に並べ替えます. AVX2 版の128bit単位の処理と同じ手順です.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+void LoadVector3x4( const f32* p, __m128& x, __m128& y, __m128& z )
+{
+    __m128 m0 = _mm_loadu_ps( p + 0 );
+    __m128 m1 = _mm_loadu_ps( p + 4 );
+    __m128 m2 = _mm_loadu_ps( p + 8 );
+
+    __m128 xy = _mm_shuffle_ps( m1, m2, _MM_SHUFFLE( 2, 1, 3, 2 ) );
+    __m128 yz = _mm_shuffle_ps( m0, m1, _MM_SHUFFLE( 1, 0, 2, 1 ) );
+    x = _mm_shuffle_ps( m0, xy, _MM_SHUFFLE( 2, 0, 3, 0 ) );
+    y = _mm_shuffle_ps( yz, xy, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+    z = _mm_shuffle_ps( yz, m2, _MM_SHUFFLE( 3, 0, 3, 1 ) );
+}
+
+//-------------------------------------------------------------------------------------
+//      SoA の4要素を連続した3次元ベクトルとして書き込みます.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+void StoreVector3x4( f32* p, __m128 x, __m128 y, __m128 z )
+{
+    __m128 rxy = _mm_shuffle_ps( x, y, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    __m128 ryz = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+    __m128 rzx = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+
+    _mm_storeu_ps( p + 0, _mm_shuffle_ps( rxy, rzx, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+    _mm_storeu_ps( p + 4, _mm_shuffle_ps( ryz, rxy, _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+    _mm_storeu_ps( p + 8, _mm_shuffle_ps( rzx, ryz, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+}
+
+ASDX_INLINE
+void LoadVector3x8( const Vector3* pValues, f32x8& x, f32x8& y, f32x8& z )
+{
+    LoadVector3x4( &pValues[0].x, x.lo, y.lo, z.lo );
+    LoadVector3x4( &pValues[4].x, x.hi, y.hi, z.hi );
+}
+
+ASDX_INLINE
+void StoreVector3x8( Vector3* pValues, const f32x8& x, const f32x8& y, const f32x8& z )
+{
+    StoreVector3x4( &pValues[0].x, x.lo, y.lo, z.lo );
+    StoreVector3x4( &pValues[4].x, x.hi, y.hi, z.hi );
+}
+#else
+//-------------------------------------------------------------------------------------
+//      それ以外の場合は8要素のループで処理します.
+//      単純なループなので，NEON などではコンパイラがベクトル命令にまとめます.
+//-------------------------------------------------------------------------------------
+struct f32x8 { f32 v[8]; };
+typedef u32 mask8;          // ビットiが要素iです.
+
+#define ASDX_SIMD_LANES( expr )     for( u32 i=0; i<8; ++i ) { expr; }
+
+ASDX_INLINE f32x8 Load8( const f32* p )                 { f32x8 r; ASDX_SIMD_LANES( r.v[i] = p[i] ) return r; }
+ASDX_INLINE void  Store8( f32* p, const f32x8& v )      { ASDX_SIMD_LANES( p[i] = v.v[i] ) }
+ASDX_INLINE f32x8 Splat8( f32 s )                       { f32x8 r; ASDX_SIMD_LANES( r.v[i] = s ) return r; }
+ASDX_INLINE f32x8 Add( const f32x8& a, const f32x8& b ) { f32x8 r; ASDX_SIMD_LANES( r.v[i] = a.v[i] + b.v[i] ) return r; }
+ASDX_INLINE f32x8 Sub( const f32x8& a, const f32x8& b ) { f32x8 r; ASDX_SIMD_LANES( r.v[i] = a.v[i] - b.v[i] ) return r; }
+ASDX_INLINE f32x8 Mul( const f32x8& a, const f32x8& b ) { f32x8 r; ASDX_SIMD_LANES( r.v[i] = a.v[i] * b.v[i] ) return r; }
+ASDX_INLINE f32x8 Div( const f32x8& a, const f32x8& b ) { f32x8 r; ASDX_SIMD_LANES( r.v[i] = a.v[i] / b.v[i] ) return r; }
+ASDX_INLINE f32x8 Min( const f32x8& a, const f32x8& b ) { f32x8 r; ASDX_SIMD_LANES( r.v[i] = ( a.v[i] < b.v[i] ) ? a.v[i] : b.v[i] ) return r; }
+ASDX_INLINE f32x8 Max( const f32x8& a, const f32x8& b ) { f32x8 r; ASDX_SIMD_LANES( r.v[i] = ( a.v[i] > b.v[i] ) ? a.v[i] : b.v[i] ) return r; }
+ASDX_INLINE f32x8 Sqrt( const f32x8& v )                { f32x8 r; ASDX_SIMD_LANES( r.v[i] = sqrtf( v.v[i] ) ) return r; }
+ASDX_INLINE f32x8 Abs( const f32x8& v )                 { f32x8 r; ASDX_SIMD_LANES( r.v[i] = fabsf( v.v[i] ) ) return r; }
+ASDX_INLINE f32x8 Neg( const f32x8& v )                 { f32x8 r; ASDX_SIMD_LANES( r.v[i] = -v.v[i] ) return r; }
+ASDX_INLINE mask8 CmpLt( const f32x8& a, const f32x8& b ) { mask8 r = 0; ASDX_SIMD_LANES( r |= u32( a.v[i] <  b.v[i] ) << i ) return r; }
+ASDX_INLINE mask8 CmpLe( const f32x8& a, const f32x8& b ) { mask8 r = 0; ASDX_SIMD_LANES( r |= u32( a.v[i] <= b.v[i] ) << i ) return r; }
+ASDX_INLINE mask8 CmpGt( const f32x8& a, const f32x8& b ) { mask8 r = 0; ASDX_SIMD_LANES( r |= u32( a.v[i] >  b.v[i] ) << i ) return r; }
+ASDX_INLINE mask8 CmpGe( const f32x8& a, const f32x8& b ) { mask8 r = 0; ASDX_SIMD_LANES( r |= u32( a.v[i] >= b.v[i] ) << i ) return r; }
+ASDX_INLINE mask8 And( mask8 a, mask8 b )               { return a & b; }
+ASDX_INLINE mask8 Or( mask8 a, mask8 b )                { return a | b; }
+ASDX_INLINE f32x8 Select( const f32x8& a, const f32x8& b, mask8 m ) { f32x8 r; ASDX_SIMD_LANES( r.v[i] = ( m & ( 1u << i ) ) ? b.v[i] : a.v[i] ) return r; }
+ASDX_INLINE u32   ToBits( mask8 m )                     { return m; }
+ASDX_INLINE mask8 FromBits( u32 bits )                  { return bits & 0xff; }
+
+#undef ASDX_SIMD_LANES
+
+ASDX_INLINE
+void LoadVector3x8( const Vector3* pValues, f32x8& x, f32x8& y, f32x8& z )
+{
+    for( u32 i=0; i<8; ++i )
+    {
+        x.v[i] = pValues[i].x;
+        y.v[i] = pValues[i].y;
+        z.v[i] = pValues[i].z;
+    }
+}
+
+ASDX_INLINE
+void StoreVector3x8( Vector3* pValues, const f32x8& x, const f32x8& y, const f32x8& z )
+{
+    for( u32 i=0; i<8; ++i )
+    {
+        pValues[i].x = x.v[i];
+        pValues[i].y = y.v[i];
+        pValues[i].z = z.v[i];
+    }
+}
+#endif//ASDX_USE_AVX2
+
+//-------------------------------------------------------------------------------------
+//      8個の平面式との距離 ( n・p ) + d を求めます. Plane::DotCoordinate() と同じ順序で加算します.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+f32x8 DotCoordinate( const Plane& plane, const f32x8& x, const f32x8& y, const f32x8& z )
+{
+    f32x8 result = Mul( Splat8( plane.normal.x ), x );
+    result = Add( result, Mul( Splat8( plane.normal.y ), y ) );
+    result = Add( result, Mul( Splat8( plane.normal.z ), z ) );
+    return   Add( result, Splat8( plane.d ) );
+}
+
+} // namespace simd
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Float8 class
+///////////////////////////////////////////////////////////////////////////////////////
+
+///------------------------------------------------------------------------------------
+///<summary>コンストラクタです.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8::Float8()
+{ /* DO_NOTHING */ }
+
+///------------------------------------------------------------------------------------
+///<summary>引数付きコンストラクタです.</summary>
+///<param name="value">全要素に設定する値</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8::Float8( const f32 value )
+{ simd::Store8( v, simd::Splat8( value ) ); }
+
+///------------------------------------------------------------------------------------
+///<summary>引数付きコンストラクタです.</summary>
+///<param name="pValues">要素数8の配列です.</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8::Float8( const f32* pValues )
+{
+    assert( pValues != NULL );
+    simd::Store8( v, simd::Load8( pValues ) );
+}
+
+///------------------------------------------------------------------------------------
+///<summary>コピーコンストラクタです.</summary>
+///<param name="value">コピー元の値.</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8::Float8( const Float8& value )
+{ simd::Store8( v, simd::Load8( value.v ) ); }
+
+///------------------------------------------------------------------------------------
+///<summary>インデクサです.</summary>
+///<param name="index">取得する要素番号</param>
+///<return>指定された要素番号の値を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+f32& Float8::operator [] ( u32 index )
+{
+    assert( index < NUM_COUNT );
+    return v[ index ];
+}
+
+///------------------------------------------------------------------------------------
+///<summary>インデクサです(const版).</summary>
+///<param name="index">取得する要素番号</param>
+///<return>指定された要素番号の値を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 Float8::operator [] ( u32 index ) const
+{
+    assert( index < NUM_COUNT );
+    return v[ index ];
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに加算します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8& Float8::operator += ( const Float8& value )
+{
+    simd::Store8( v, simd::Add( simd::Load8( v ), simd::Load8( value.v ) ) );
+    return (*this);
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに減算します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8& Float8::operator -= ( const Float8& value )
+{
+    simd::Store8( v, simd::Sub( simd::Load8( v ), simd::Load8( value.v ) ) );
+    return (*this);
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに乗算します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8& Float8::operator *= ( const Float8& value )
+{
+    simd::Store8( v, simd::Mul( simd::Load8( v ), simd::Load8( value.v ) ) );
+    return (*this);
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに除算します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8& Float8::operator /= ( const Float8& value )
+{
+    simd::Store8( v, simd::Div( simd::Load8( v ), simd::Load8( value.v ) ) );
+    return (*this);
+}
+
+///------------------------------------------------------------------------------------
+///<summary>正符号演算子です.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::operator + () const
+{ return (*this); }
+
+///------------------------------------------------------------------------------------
+///<summary>負符号演算子です.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::operator - () const
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Neg( simd::Load8( v ) ) );
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとの加算結果を返却します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::operator + ( const Float8& value ) const
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Add( simd::Load8( v ), simd::Load8( value.v ) ) );
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとの減算結果を返却します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::operator - ( const Float8& value ) const
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Sub( simd::Load8( v ), simd::Load8( value.v ) ) );
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとの乗算結果を返却します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::operator * ( const Float8& value ) const
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Mul( simd::Load8( v ), simd::Load8( value.v ) ) );
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとの除算結果を返却します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::operator / ( const Float8& value ) const
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Div( simd::Load8( v ), simd::Load8( value.v ) ) );
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>代入演算子です.</summary>
+///<param name="value">代入する値</param>
+///<return>代入結果を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8& Float8::operator = ( const Float8& value )
+{
+    simd::Store8( v, simd::Load8( value.v ) );
+    return (*this);
+}
+
+///------------------------------------------------------------------------------------
+///<summary>等価比較演算子です.</summary>
+///<param name="value">比較する値</param>
+///<return>全要素が等価であればtrue, そうでなければfalseを返却します</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool Float8::operator == ( const Float8& value ) const
+{
+    for( u32 i=0; i<NUM_COUNT; ++i )
+    {
+        if ( v[ i ] != value.v[ i ] )
+        { return false; }
+    }
+
+    return true;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>非等価比較演算子です.</summary>
+///<param name="value">比較する値</param>
+///<return>非等価であればtrue, 全要素が等価であればfalseを返却します</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool Float8::operator != ( const Float8& value ) const
+{ return !( (*this) == value ); }
+
+///------------------------------------------------------------------------------------
+///<summary>全要素の最小値を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 Float8::ReduceMin() const
+{
+    f32 result = v[ 0 ];
+    for( u32 i=1; i<NUM_COUNT; ++i )
+    { result = asdx::Min< f32 >( result, v[ i ] ); }
+
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>全要素の最大値を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 Float8::ReduceMax() const
+{
+    f32 result = v[ 0 ];
+    for( u32 i=1; i<NUM_COUNT; ++i )
+    { result = asdx::Max< f32 >( result, v[ i ] ); }
+
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>全要素の合計を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 Float8::ReduceSum() const
+{
+    f32 result = v[ 0 ];
+    for( u32 i=1; i<NUM_COUNT; ++i )
+    { result += v[ i ]; }
+
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに小さい方の値を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::Min( const Float8& a, const Float8& b )
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Min( simd::Load8( a.v ), simd::Load8( b.v ) ) );
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに大きい方の値を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::Max( const Float8& a, const Float8& b )
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Max( simd::Load8( a.v ), simd::Load8( b.v ) ) );
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに絶対値を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::Abs( const Float8& value )
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Abs( simd::Load8( value.v ) ) );
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに平方根を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::Sqrt( const Float8& value )
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Sqrt( simd::Load8( value.v ) ) );
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに a < b を判定します.</summary>
+///<return>成り立つ要素のビットを立てたマスクを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Float8::Less( const Float8& a, const Float8& b )
+{ return simd::ToBits( simd::CmpLt( simd::Load8( a.v ), simd::Load8( b.v ) ) ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに a <= b を判定します.</summary>
+///<return>成り立つ要素のビットを立てたマスクを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Float8::LessEqual( const Float8& a, const Float8& b )
+{ return simd::ToBits( simd::CmpLe( simd::Load8( a.v ), simd::Load8( b.v ) ) ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに a > b を判定します.</summary>
+///<return>成り立つ要素のビットを立てたマスクを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Float8::Greater( const Float8& a, const Float8& b )
+{ return simd::ToBits( simd::CmpGt( simd::Load8( a.v ), simd::Load8( b.v ) ) ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに a >= b を判定します.</summary>
+///<return>成り立つ要素のビットを立てたマスクを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Float8::GreaterEqual( const Float8& a, const Float8& b )
+{ return simd::ToBits( simd::CmpGe( simd::Load8( a.v ), simd::Load8( b.v ) ) ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに値を選択します.</summary>
+///<param name="a">マスクのビットが立っていない要素に使う値</param>
+///<param name="b">マスクのビットが立っている要素に使う値</param>
+///<param name="mask">選択マスク(ビットiが要素i)</param>
+///<return>選択した結果を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8 Float8::Select( const Float8& a, const Float8& b, u32 mask )
+{
+    Float8 result;
+    simd::Store8( result.v, simd::Select( simd::Load8( a.v ), simd::Load8( b.v ), simd::FromBits( mask ) ) );
+    return result;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // Vector3x8 class
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -33,128 +621,272 @@ Vector3x8::Vector3x8()
 ///<param name="v7">8番目の点</param>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-Vector3x8::Vector3x8
-(
-    const Vector3& v0,
-    const Vector3& v1,
-    const Vector3& v2,
-    const Vector3& v3,
-    const Vector3& v4,
-    const Vector3& v5,
-    const Vector3& v6,
-    const Vector3& v7
-)
+Vector3x8::Vector3x8
+(
+    const Vector3& v0,
+    const Vector3& v1,
+    const Vector3& v2,
+    const Vector3& v3,
+    const Vector3& v4,
+    const Vector3& v5,
+    const Vector3& v6,
+    const Vector3& v7
+)
+{
+    SetAt( 0, v0 );
+    SetAt( 1, v1 );
+    SetAt( 2, v2 );
+    SetAt( 3, v3 );
+    SetAt( 4, v4 );
+    SetAt( 5, v5 );
+    SetAt( 6, v6 );
+    SetAt( 7, v7 );
+}
+
+///------------------------------------------------------------------------------------
+///<summary>引数付きコンストラクタです.</summary>
+///<param name="pValues">要素数8の3次元ベクトル配列です.</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8::Vector3x8( const Vector3* pValues )
+{ Gather( pValues, sizeof( Vector3 ), NUM_COUNT ); }
+
+///------------------------------------------------------------------------------------
+///<summary>引数付きコンストラクタです.</summary>
+///<param name="value">全要素に設定する3次元ベクトル</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8::Vector3x8( const Vector3& value )
+: x( value.x )
+, y( value.y )
+, z( value.z )
+{ /* DO_NOTHING */ }
+
+///------------------------------------------------------------------------------------
+///<summary>引数付きコンストラクタです.</summary>
+///<param name="nx">X成分</param>
+///<param name="ny">Y成分</param>
+///<param name="nz">Z成分</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8::Vector3x8( const Float8& nx, const Float8& ny, const Float8& nz )
+: x( nx )
+, y( ny )
+, z( nz )
+{ /* DO_NOTHING */ }
+
+///------------------------------------------------------------------------------------
+///<summary>コピーコンストラクタです.</summary>
+///<param name="value">コピー元の値.</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8::Vector3x8( const Vector3x8 &value )
+: x( value.x )
+, y( value.y )
+, z( value.z )
+{ /* DO_NOTHING */ }
+
+///------------------------------------------------------------------------------------
+///<summary>インデクサです.</summary>
+///<param name="index">取得する要素番号</param>
+///<return>指定された要素番号の3次元ベクトルを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3 Vector3x8::operator [] ( u32 index ) const
+{ return GetAt( index ); }
+
+///------------------------------------------------------------------------------------
+///<summary>サイズを取得します.</summary>
+///<return>常に8を返却します</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32     Vector3x8::GetSize() const 
+{ return NUM_COUNT; }
+
+///------------------------------------------------------------------------------------
+///<summary>指定された要素番号の3次元ベクトルの値を取得します.</summary>
+///<param name="index">取得する要素番号</param>
+///<return>指定された要素番号の3次元ベクトルを返却します</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3 Vector3x8::GetAt( u32 index ) const
 {
-    points[0] = v0;
-    points[1] = v1;
-    points[2] = v2;
-    points[3] = v3;
-    points[4] = v4;
-    points[5] = v5;
-    points[6] = v6;
-    points[7] = v7;
+    assert( index < NUM_COUNT );
+    return Vector3( x.v[ index ], y.v[ index ], z.v[ index ] );
 }
 
 ///------------------------------------------------------------------------------------
-///<summary>引数付きコンストラクタです.</summary>
-///<param name="pValues">要素数8の3次元ベクトル配列です.</param>
+///<summary>指定された要素番号の3次元ベクトルに値を設定します.</summary>
+///<param name="index">設定する要素番号</param>
+///<param name="value">設定する3次元ベクトルの値</param>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-Vector3x8::Vector3x8( Vector3* pValues )
+void    Vector3x8::SetAt( u32 index, const Vector3& value )
 {
-    for( u32 i=0; i<NUM_COUNT; ++i )
-    { points[ i ] = pValues[ i ]; }
+    assert( index < NUM_COUNT );
+    x.v[ index ] = value.x;
+    y.v[ index ] = value.y;
+    z.v[ index ] = value.z;
 }
 
 ///------------------------------------------------------------------------------------
-///<summary>コピーコンストラクタです.</summary>
-///<param name="value">コピー元の値.</param>
+///<summary>3次元ベクトルの配列から読み込みます.</summary>
+///<param name="pValues">読み込む配列の先頭</param>
+///<param name="stride">要素の間隔(バイト)</param>
+///<param name="count">読み込む要素数</param>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-Vector3x8::Vector3x8( const Vector3x8 &value )
+void    Vector3x8::Gather( const Vector3* pValues, u32 stride, u32 count )
 {
+    assert( pValues != NULL );
+    assert( count <= NUM_COUNT );
+
+    if ( stride == sizeof( Vector3 ) && count == NUM_COUNT )
+    {
+        simd::f32x8 vx, vy, vz;
+        simd::LoadVector3x8( pValues, vx, vy, vz );
+        simd::Store8( x.v, vx );
+        simd::Store8( y.v, vy );
+        simd::Store8( z.v, vz );
+        return;
+    }
+
+    const u8* pSrc = reinterpret_cast<const u8*>( pValues );
     for( u32 i=0; i<NUM_COUNT; ++i )
-    { points[ i ] = value.points[ i ]; }
+    {
+        if ( i < count )
+        { SetAt( i, *reinterpret_cast<const Vector3*>( pSrc + size_t( stride ) * i ) ); }
+        else
+        { SetAt( i, Vector3( 0.0f, 0.0f, 0.0f ) ); }
+    }
 }
 
 ///------------------------------------------------------------------------------------
-///<summary>デストラクタです.</summary>
+///<summary>3次元ベクトルの配列へ書き込みます.</summary>
+///<param name="pValues">書き込む配列の先頭</param>
+///<param name="stride">要素の間隔(バイト)</param>
+///<param name="count">書き込む要素数</param>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-Vector3x8::~Vector3x8()
-{ /* DO_NOTHING */ }
+void    Vector3x8::Scatter( Vector3* pValues, u32 stride, u32 count ) const
+{
+    assert( pValues != NULL );
+    assert( count <= NUM_COUNT );
+
+    if ( stride == sizeof( Vector3 ) && count == NUM_COUNT )
+    {
+        simd::StoreVector3x8( pValues, simd::Load8( x.v ), simd::Load8( y.v ), simd::Load8( z.v ) );
+        return;
+    }
+
+    u8* pDst = reinterpret_cast<u8*>( pValues );
+    for( u32 i=0; i<count; ++i )
+    { *reinterpret_cast<Vector3*>( pDst + size_t( stride ) * i ) = GetAt( i ); }
+}
 
 ///------------------------------------------------------------------------------------
-///<summary>Vector3*型へのキャストです.</summary>
-///<return>最初の要素へのポインタを返却します.</return>
+///<summary>全要素の成分ごとの最小値を求めます.</summary>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-Vector3x8::operator Vector3* ()
-{ return &points[0]; }
+Vector3 Vector3x8::ReduceMin() const
+{ return Vector3( x.ReduceMin(), y.ReduceMin(), z.ReduceMin() ); }
 
 ///------------------------------------------------------------------------------------
-///<summary>const Vector3*型へのキャストです.</summary>
-///<return>最初の要素へのポインタを返却します.</return>
+///<summary>全要素の成分ごとの最大値を求めます.</summary>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-Vector3x8::operator const Vector3* () const
-{ return &points[0]; }
+Vector3 Vector3x8::ReduceMax() const
+{ return Vector3( x.ReduceMax(), y.ReduceMax(), z.ReduceMax() ); }
 
 ///------------------------------------------------------------------------------------
-///<summary>インデクサです.</summary>
-///<param name="index">取得する要素番号</param>
-///<return>指定された要素番号の3次元ベクトルを返却します.</return>
+///<summary>要素ごとに加算します.</summary>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-Vector3& Vector3x8::operator [] ( u32 index )
+Vector3x8&  Vector3x8::operator += ( const Vector3x8& value )
 {
-    assert( index < NUM_COUNT );
-    return points[ index ];
+    x += value.x;
+    y += value.y;
+    z += value.z;
+    return (*this);
 }
 
 ///------------------------------------------------------------------------------------
-///<summary>インデクサです(const版).</summary>
-///<param name="index">取得する要素番号</param>
-///<return>指定された要素番号の3次元ベクトルを返却します.</return>
+///<summary>要素ごとに減算します.</summary>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-const Vector3& Vector3x8::operator [] ( u32 index ) const
+Vector3x8&  Vector3x8::operator -= ( const Vector3x8& value )
 {
-    assert( index < NUM_COUNT );
-    return points[ index ];
+    x -= value.x;
+    y -= value.y;
+    z -= value.z;
+    return (*this);
 }
 
 ///------------------------------------------------------------------------------------
-///<summary>サイズを取得します.</summary>
-///<return>常に8を返却します</return>
+///<summary>要素ごとにスカラー乗算します.</summary>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-u32     Vector3x8::GetSize() const 
-{ return NUM_COUNT; }
+Vector3x8&  Vector3x8::operator *= ( const Float8& scalar )
+{
+    x *= scalar;
+    y *= scalar;
+    z *= scalar;
+    return (*this);
+}
 
 ///------------------------------------------------------------------------------------
-///<summary>指定された要素番号の3次元ベクトルの値を取得します.</summary>
-///<param name="index">取得する要素番号</param>
-///<return>指定された要素番号の3次元ベクトルを返却します</return>
+///<summary>要素ごとにスカラー除算します.</summary>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-Vector3& Vector3x8::GetAt( u32 index ) 
+Vector3x8&  Vector3x8::operator /= ( const Float8& scalar )
 {
-    assert( index < NUM_COUNT );
-    return points[ index ];
+    x /= scalar;
+    y /= scalar;
+    z /= scalar;
+    return (*this);
 }
 
 ///------------------------------------------------------------------------------------
-///<summary>指定された要素番号の3次元ベクトルに値を設定します.</summary>
-///<param name="index">設定する要素番号</param>
-///<param name="value">設定する3次元ベクトルの値</param>
+///<summary>正符号演算子です.</summary>
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
-void    Vector3x8::SetAt( u32 index, const Vector3& value )
-{
-    assert( index < NUM_COUNT );
-    points[ index ] = value;
-}
+Vector3x8   Vector3x8::operator + () const
+{ return (*this); }
+
+///------------------------------------------------------------------------------------
+///<summary>負符号演算子です.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::operator - () const
+{ return Vector3x8( -x, -y, -z ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとの加算結果を返却します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::operator + ( const Vector3x8& value ) const
+{ return Vector3x8( x + value.x, y + value.y, z + value.z ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとの減算結果を返却します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::operator - ( const Vector3x8& value ) const
+{ return Vector3x8( x - value.x, y - value.y, z - value.z ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとのスカラー乗算結果を返却します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::operator * ( const Float8& scalar ) const
+{ return Vector3x8( x * scalar, y * scalar, z * scalar ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとのスカラー除算結果を返却します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::operator / ( const Float8& scalar ) const
+{ return Vector3x8( x / scalar, y / scalar, z / scalar ); }
 
 ///------------------------------------------------------------------------------------
 ///<summary>代入演算子です.</summary>
@@ -164,8 +896,9 @@ void    Vector3x8::SetAt( u32 index, const Vector3& value )
 ASDX_INLINE
 Vector3x8&  Vector3x8::operator = ( const Vector3x8& value )
 {
-    for( u32 i=0; i<NUM_COUNT; ++i )
-    { points[ i ] = value.points[ i ]; }
+    x = value.x;
+    y = value.y;
+    z = value.z;
     return (*this);
 }
 
@@ -176,12 +909,7 @@ Vector3x8&  Vector3x8::operator = ( const Vector3x8& value )
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
 bool    Vector3x8::operator == ( const Vector3x8& value ) const
-{
-    if ( this != (&value) )
-    { return true; }
-
-    return ( memcmp( points, value.points, sizeof( Vector3 ) * NUM_COUNT ) == 0 );
-}
+{ return ( x == value.x ) && ( y == value.y ) && ( z == value.z ); }
 
 ///------------------------------------------------------------------------------------
 ///<summary>非等価比較演算子です.</summary>
@@ -190,13 +918,79 @@ bool    Vector3x8::operator == ( const Vector3x8& value ) const
 ///------------------------------------------------------------------------------------
 ASDX_INLINE
 bool    Vector3x8::operator != ( const Vector3x8& value ) const
-{
-    if ( this == (&value) )
-    { return false; }
+{ return !( (*this) == value ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに内積を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8  Vector3x8::Dot( const Vector3x8& a, const Vector3x8& b )
+{ return ( a.x * b.x ) + ( a.y * b.y ) + ( a.z * b.z ); }
 
-    return ( memcmp( points, value.points, sizeof( Vector3 ) * NUM_COUNT ) != 0 );
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに外積を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::Cross( const Vector3x8& a, const Vector3x8& b )
+{
+    return Vector3x8(
+        ( a.y * b.z ) - ( a.z * b.y ),
+        ( a.z * b.x ) - ( a.x * b.z ),
+        ( a.x * b.y ) - ( a.y * b.x )
+    );
 }
 
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに長さを求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8  Vector3x8::Length( const Vector3x8& value )
+{ return Float8::Sqrt( Dot( value, value ) ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに長さの2乗を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Float8  Vector3x8::LengthSq( const Vector3x8& value )
+{ return Dot( value, value ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに正規化します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::Normalize( const Vector3x8& value )
+{ return value / Length( value ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに成分の小さい方の値を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::Min( const Vector3x8& a, const Vector3x8& b )
+{ return Vector3x8( Float8::Min( a.x, b.x ), Float8::Min( a.y, b.y ), Float8::Min( a.z, b.z ) ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに成分の大きい方の値を求めます.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::Max( const Vector3x8& a, const Vector3x8& b )
+{ return Vector3x8( Float8::Max( a.x, b.x ), Float8::Max( a.y, b.y ), Float8::Max( a.z, b.z ) ); }
+
+///------------------------------------------------------------------------------------
+///<summary>要素ごとに値を選択します.</summary>
+///<param name="a">マスクのビットが立っていない要素に使う値</param>
+///<param name="b">マスクのビットが立っている要素に使う値</param>
+///<param name="mask">選択マスク(ビットiが要素i)</param>
+///<return>選択した結果を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3x8   Vector3x8::Select( const Vector3x8& a, const Vector3x8& b, u32 mask )
+{
+    return Vector3x8(
+        Float8::Select( a.x, b.x, mask ),
+        Float8::Select( a.y, b.y, mask ),
+        Float8::Select( a.z, b.z, mask )
+    );
+}
 
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -458,8 +1252,7 @@ Plane&  Plane::Normalize()
     register f32 mag = sqrtf( 
         ( normal.x * normal.x ) 
       + ( normal.y * normal.y )
-      + ( normal.z * normal.z )
-      + ( d * d ) );
+      + ( normal.z * normal.z ) );
     assert( mag != 0.0f );
     register f32 invMag = 1.0f / mag;
     normal.x *= invMag;
@@ -477,7 +1270,7 @@ Plane&  Plane::Normalize()
 ASDX_INLINE
 Plane&  Plane::SafeNormalize( const Plane& set )
 {
-    register f32 mag = sqrtf( ( normal.x * normal.x ) + ( normal.y * normal.y ) + ( normal.z * normal.z ) + ( d * d ) );
+    register f32 mag = sqrtf( ( normal.x * normal.x ) + ( normal.y * normal.y ) + ( normal.z * normal.z ) );
     if ( mag != 0.0f )
     {
         register f32 invMag = 1.0f / mag;
@@ -711,8 +1504,7 @@ Plane   Plane::Normalize( const Plane& value )
     register f32 mag = sqrtf( 
         ( value.normal.x * value.normal.x )
       + ( value.normal.y * value.normal.y )
-      + ( value.normal.z * value.normal.z )
-      + ( value.d        * value.d ) );
+      + ( value.normal.z * value.normal.z ) );
     assert( mag != 0.0f );
     register f32 invMag = 1.0f / mag;
 
@@ -735,8 +1527,7 @@ void    Plane::Normalize( const Plane& value, Plane& result )
     register f32 mag = sqrtf( 
         ( value.normal.x * value.normal.x )
       + ( value.normal.y * value.normal.y )
-      + ( value.normal.z * value.normal.z )
-      + ( value.d        * value.d ) );
+      + ( value.normal.z * value.normal.z ) );
     assert( mag != 0.0f );
     register f32 invMag = 1.0f / mag;
 
@@ -758,8 +1549,7 @@ Plane   Plane::SafeNormalize( const Plane& value, const Plane& set )
     register f32 mag = sqrtf( 
         ( value.normal.x * value.normal.x )
       + ( value.normal.y * value.normal.y )
-      + ( value.normal.z * value.normal.z )
-      + ( value.d        * value.d ) );
+      + ( value.normal.z * value.normal.z ) );
 
     if ( mag != 0.0f )
     {
@@ -794,8 +1584,7 @@ void    Plane::SafeNormalize( const Plane& value, const Plane& set, Plane& resul
     register f32 mag = sqrtf( 
         ( value.normal.x * value.normal.x )
       + ( value.normal.y * value.normal.y )
-      + ( value.normal.z * value.normal.z )
-      + ( value.d        * value.d ) );
+      + ( value.normal.z * value.normal.z ) );
 
     if ( mag != 0.0f )
     {
@@ -924,7 +1713,7 @@ bool Ray::Intersects( const BoundingBox& value, f32& distance ) const
     // X成分.
     if ( fabs( direction.x ) < F32_EPSILON )
     {
-        if ( ( position.x < value.min.x ) || ( position.x > value.min.x ) )
+        if ( ( position.x < value.min.x ) || ( position.x > value.max.x ) )
         {
             distance = 0.0f;
             return false;
@@ -957,7 +1746,7 @@ bool Ray::Intersects( const BoundingBox& value, f32& distance ) const
     // Y成分.
     if ( fabs( direction.y ) < F32_EPSILON )
     {
-        if ( ( position.y < value.min.y ) || ( position.y > value.min.y ) )
+        if ( ( position.y < value.min.y ) || ( position.y > value.max.y ) )
         {
             distance = 0.0f;
             return false;
@@ -990,7 +1779,7 @@ bool Ray::Intersects( const BoundingBox& value, f32& distance ) const
     // Z成分.
     if ( fabs( direction.z ) < F32_EPSILON )
     {
-        if ( ( position.z < value.min.z ) || ( position.z > value.min.z ) )
+        if ( ( position.z < value.min.z ) || ( position.z > value.max.z ) )
         {
             distance = 0.0f;
             return false;
@@ -1246,6 +2035,52 @@ bool Ray::Intersects( const Vector3& p0, const Vector3& p1, const Vector3& p2, f
 }
 
 
+///------------------------------------------------------------------------------------
+///<summary>8個の境界箱との交差判定をまとめて行います.</summary>
+///<param name="mins">8個の境界箱の最小値</param>
+///<param name="maxs">8個の境界箱の最大値</param>
+///<param name="distance">境界箱ごとの交差点までの距離</param>
+///<return>交差している境界箱のビットを立てたマスクを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Ray::Intersects( const Vector3x8& mins, const Vector3x8& maxs, Float8& distance ) const
+{
+    const f32 pos[3] = { position.x,  position.y,  position.z  };
+    const f32 dir[3] = { direction.x, direction.y, direction.z };
+    const Float8* pMin[3] = { &mins.x, &mins.y, &mins.z };
+    const Float8* pMax[3] = { &maxs.x, &maxs.y, &maxs.z };
+
+    simd::f32x8 tmin = simd::Splat8( 0.0f );
+    simd::f32x8 tmax = simd::Splat8( F32_MAX );
+    simd::mask8 hit  = simd::FromBits( 0xff );
+
+    // レイの方向は全要素で共通なので，軸ごとの分岐はスカラー版と同じく1回で済む.
+    for( u32 i=0; i<3; ++i )
+    {
+        simd::f32x8 mini = simd::Load8( pMin[ i ]->v );
+        simd::f32x8 maxi = simd::Load8( pMax[ i ]->v );
+        simd::f32x8 p    = simd::Splat8( pos[ i ] );
+
+        if ( fabs( dir[ i ] ) < F32_EPSILON )
+        {
+            hit = simd::And( hit, simd::And( simd::CmpGe( p, mini ), simd::CmpLe( p, maxi ) ) );
+            continue;
+        }
+
+        simd::f32x8 inverse = simd::Splat8( 1.0f / dir[ i ] );
+        simd::f32x8 t1 = simd::Mul( simd::Sub( mini, p ), inverse );
+        simd::f32x8 t2 = simd::Mul( simd::Sub( maxi, p ), inverse );
+
+        tmin = simd::Max( simd::Min( t1, t2 ), tmin );
+        tmax = simd::Min( simd::Max( t1, t2 ), tmax );
+        hit  = simd::And( hit, simd::CmpLe( tmin, tmax ) );
+    }
+
+    simd::Store8( distance.v, simd::Select( simd::Splat8( 0.0f ), tmin, hit ) );
+    return simd::ToBits( hit );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // BoundingBox
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -1489,8 +2324,8 @@ bool    BoundingBox::Intersects( const BoundingBox& value ) const
 ASDX_INLINE
 bool    BoundingBox::Intersects( const BoundingSphere& value ) const
 {
-    Vector3 vec = Clamp( value.center, min, max );
-    register f32 dist = DistanceSq( value.center, vec );
+    Vector3 vec = Vector3::Clamp( value.center, min, max );
+    register f32 dist = Vector3::DistanceSq( value.center, vec );
     return ( dist <= ( value.radius * value.radius ) );
 }
 
@@ -1505,7 +2340,6 @@ bool    BoundingBox::Intersects( const BoundingFrustum& value ) const
     ContainmentType result;
     Vector3x8 corners = value.GetCorners();
     bool isContainsAny = false;
-    bool isContainsAll = true;
 
     for( u32 i=0; i<corners.GetSize(); ++i )
     {
@@ -1518,7 +2352,6 @@ bool    BoundingBox::Intersects( const BoundingFrustum& value ) const
             break;
 
         case ContainmentType::DISJOINT:
-            isContainsAll = false;
             break;
         }
     }
@@ -1549,12 +2382,12 @@ PlaneIntersectionType BoundingBox::Intersects( const Plane& value ) const
     mini.y = ( value.normal.y >= 0.0f ) ? max.y : min.y;
     mini.z = ( value.normal.z >= 0.0f ) ? max.z : min.z;
 
-    register f32 dist = Dot( value.normal, maxi );
+    register f32 dist = Vector3::Dot( value.normal, maxi );
 
     if ( dist + value.d > 0.0f )
     { return PlaneIntersectionType::FRONT; }
 
-    dist = Dot( value.normal, mini );
+    dist = Vector3::Dot( value.normal, mini );
 
     if ( dist + value.d < 0.0f )
     { return PlaneIntersectionType::BACK; }
@@ -1726,8 +2559,8 @@ ASDX_INLINE
 BoundingBox     BoundingBox::CreateMerged( const BoundingBox& a, const BoundingBox& b )
 {
     return BoundingBox(
-        Min( a.min, b.min ),
-        Max( a.max, b.max )
+        Vector3::Min( a.min, b.min ),
+        Vector3::Max( a.max, b.max )
     );
 }
 
@@ -1740,8 +2573,8 @@ BoundingBox     BoundingBox::CreateMerged( const BoundingBox& a, const BoundingB
 ASDX_INLINE
 void    BoundingBox::CreateMerged( const BoundingBox& a, const BoundingBox& b, BoundingBox& result )
 {
-    result.min = Min( a.min, b.min );
-    result.max = Max( a.max, b.max );
+    result.min = Vector3::Min( a.min, b.min );
+    result.max = Vector3::Max( a.max, b.max );
 }
 
 ///------------------------------------------------------------------------------------
@@ -1780,19 +2613,9 @@ void    BoundingBox::CreateFromSphere( const BoundingSphere& value, BoundingBox&
 ASDX_INLINE
 BoundingBox     BoundingBox::CreateFromPoints( const u32 numPoints, const Vector3* pPoints, const u32 offset )
 {
-    assert( pPoints != NULL );
-    assert( numPoints > 0 );
-
-    Vector3 mini = pPoints[ offset ];
-    Vector3 maxi = pPoints[ offset ];
-
-    for( u32 i=(offset+1); i<numPoints; ++i )
-    {
-        mini = Min( mini, pPoints[ i ] );
-        maxi = Max( maxi, pPoints[ i ] );
-    }
-
-    return BoundingBox( mini, maxi );
+    BoundingBox result;
+    CreateFromPoints( numPoints, pPoints, offset, result );
+    return result;
 }
 
 ///------------------------------------------------------------------------------------
@@ -1810,11 +2633,47 @@ void    BoundingBox::CreateFromPoints( const u32 numPoints, const Vector3* pPoin
 
     Vector3 mini = pPoints[ offset ];
     Vector3 maxi = pPoints[ offset ];
+    u32 i = offset + 1;
 
-    for( u32 i=(offset+1); i<numPoints; ++i )
+    // 8点ずつ SoA に並べ替えて，成分ごとの最小値・最大値を8要素まとめて更新する.
+    if ( i + Vector3x8::NUM_COUNT <= numPoints )
+    {
+        simd::f32x8 minX = simd::Splat8( mini.x );
+        simd::f32x8 minY = simd::Splat8( mini.y );
+        simd::f32x8 minZ = simd::Splat8( mini.z );
+        simd::f32x8 maxX = minX;
+        simd::f32x8 maxY = minY;
+        simd::f32x8 maxZ = minZ;
+
+        for( ; i + Vector3x8::NUM_COUNT <= numPoints; i += Vector3x8::NUM_COUNT )
+        {
+            simd::f32x8 x, y, z;
+            simd::LoadVector3x8( &pPoints[ i ], x, y, z );
+
+            minX = simd::Min( minX, x );
+            minY = simd::Min( minY, y );
+            minZ = simd::Min( minZ, z );
+            maxX = simd::Max( maxX, x );
+            maxY = simd::Max( maxY, y );
+            maxZ = simd::Max( maxZ, z );
+        }
+
+        Vector3x8 lanes;
+        simd::Store8( lanes.x.v, minX );
+        simd::Store8( lanes.y.v, minY );
+        simd::Store8( lanes.z.v, minZ );
+        mini = lanes.ReduceMin();
+
+        simd::Store8( lanes.x.v, maxX );
+        simd::Store8( lanes.y.v, maxY );
+        simd::Store8( lanes.z.v, maxZ );
+        maxi = lanes.ReduceMax();
+    }
+
+    for( ; i<numPoints; ++i )
     {
-        mini = Min( mini, pPoints[ i ] );
-        maxi = Max( maxi, pPoints[ i ] );
+        mini = Vector3::Min( mini, pPoints[ i ] );
+        maxi = Vector3::Max( maxi, pPoints[ i ] );
     }
 
     result.min = mini;
@@ -1906,7 +2765,7 @@ bool BoundingSphere::operator != ( const BoundingSphere& value ) const
 ASDX_INLINE
 ContainmentType BoundingSphere::Contains( const Vector3& value ) const
 {
-    if ( DistanceSq( value, center ) <= radius * radius )
+    if ( Vector3::DistanceSq( value, center ) <= radius * radius )
     { return ContainmentType::CONTAINS; }
 
     return ContainmentType::DISJOINT;
@@ -1920,8 +2779,8 @@ ContainmentType BoundingSphere::Contains( const Vector3& value ) const
 ASDX_INLINE
 ContainmentType BoundingSphere::Contains( const BoundingBox& value ) const
 {
-    Vector3 vec = Clamp( center, value.min, value.max );
-    register f32 dist = DistanceSq( center, vec );
+    Vector3 vec = Vector3::Clamp( center, value.min, value.max );
+    register f32 dist = Vector3::DistanceSq( center, vec );
     register f32 radiusSq = radius * radius;
 
     if ( dist <= radiusSq )
@@ -1994,7 +2853,7 @@ ContainmentType BoundingSphere::Contains( const BoundingBox& value ) const
 ASDX_INLINE
 ContainmentType BoundingSphere::Contains( const BoundingSphere& value ) const
 {
-    register f32 dist = Distance( center, value.center );
+    register f32 dist = Vector3::Distance( center, value.center );
 
     if ( radius + value.radius < dist )
     { return ContainmentType::DISJOINT; }
@@ -2027,6 +2886,9 @@ ContainmentType BoundingSphere::Contains( const BoundingFrustum& value ) const
         case PlaneIntersectionType::INTERSECTING:
             ret = PlaneIntersectionType::INTERSECTING;
             break;
+
+        default:
+            break;
         }
     }
 
@@ -2048,8 +2910,8 @@ ContainmentType BoundingSphere::Contains( const BoundingFrustum& value ) const
 ASDX_INLINE
 bool    BoundingSphere::Intersects( const BoundingBox& value ) const
 {
-    Vector3 vec = Clamp( center, value.min, value.max );
-    register f32 dist = DistanceSq( center, vec );
+    Vector3 vec = Vector3::Clamp( center, value.min, value.max );
+    register f32 dist = Vector3::DistanceSq( center, vec );
     return ( dist <= ( radius * radius ) );
 }
 
@@ -2061,7 +2923,7 @@ bool    BoundingSphere::Intersects( const BoundingBox& value ) const
 ASDX_INLINE
 bool    BoundingSphere::Intersects( const BoundingSphere& value ) const
 {
-    register f32 distSq = DistanceSq( center, value.center );
+    register f32 distSq = Vector3::DistanceSq( center, value.center );
     if ( ( (( radius * radius ) + ( ( 2.0f * radius ) * value.radius )) + ( value.radius * value.radius ) ) <= distSq )
     { return false; }
 
@@ -2076,21 +2938,11 @@ bool    BoundingSphere::Intersects( const BoundingSphere& value ) const
 ASDX_INLINE
 bool    BoundingSphere::Intersects( const BoundingFrustum& value ) const
 {
-    PlaneIntersectionType ret  = PlaneIntersectionType::FRONT;
-    PlaneIntersectionType pRet = PlaneIntersectionType::FRONT;
-
     for( u32 i=0; i<6; i++ )
     {
-        pRet = value.plane[ i ].Intersects( (*this) );
-        switch( pRet )
-        {
-        case PlaneIntersectionType::BACK:
-            return false;
-           
-        case PlaneIntersectionType::INTERSECTING:
-            ret = PlaneIntersectionType::INTERSECTING;
-            break;
-        }
+        // 1つでも平面の裏側にあれば交差しない.
+        if ( value.plane[ i ].Intersects( (*this) ) == PlaneIntersectionType::BACK )
+        { return false; }
     }
 
     return true;
@@ -2129,8 +2981,8 @@ bool    BoundingSphere::Intersects( const Ray& value, f32& distance ) const
         center.y - value.position.y,
         center.z - value.position.z );
 
-    register f32 b = Dot( v, value.direction );
-    register f32 c = Dot( v, v ) - ( radius * radius );
+    register f32 b = Vector3::Dot( v, value.direction );
+    register f32 c = Vector3::Dot( v, v ) - ( radius * radius );
     register f32 discrimiant = ( b * b ) - c;
     
     if ( discrimiant < 0.0f )
@@ -2300,11 +3152,11 @@ BoundingSphere  BoundingSphere::CreateFromPoints( const u32 numPoints, const Vec
 
     c /= static_cast<f32>( numPoints );
 
-    register f32 r = DistanceSq( c, pPoints[ offset ] );
+    register f32 r = Vector3::DistanceSq( c, pPoints[ offset ] );
 
     for( u32 i=(offset+1); i<numPoints; ++i )
     {
-        register f32 dist = DistanceSq( c, pPoints[ i ] );
+        register f32 dist = Vector3::DistanceSq( c, pPoints[ i ] );
         if ( dist > r )
         { r = dist; }
     }
@@ -2333,11 +3185,11 @@ void    BoundingSphere::CreateFromPoints( const u32 numPoints, const Vector3* pP
 
     c /= static_cast<f32>( numPoints );
 
-    register f32 r = DistanceSq( c, pPoints[ offset ] );
+    register f32 r = Vector3::DistanceSq( c, pPoints[ offset ] );
 
     for( u32 i=(offset+1); i<numPoints; ++i )
     {
-        register f32 dist = DistanceSq( c, pPoints[ i ] );
+        register f32 dist = Vector3::DistanceSq( c, pPoints[ i ] );
         if ( dist > r )
         { r = dist; }
     }
@@ -2524,6 +3376,9 @@ ContainmentType BoundingFrustum::Contains( const Vector3& value ) const
         case PlaneIntersectionType::INTERSECTING:
             ret = PlaneIntersectionType::INTERSECTING;
             break;
+
+        default:
+            break;
         }
     }
 
@@ -2545,36 +3400,26 @@ ContainmentType BoundingFrustum::Contains( const Vector3& value ) const
 ASDX_INLINE
 ContainmentType BoundingFrustum::Contains( const BoundingBox& value ) const
 {
-    ContainmentType result;
-    Vector3x8 corners = GetCorners();
-    bool isContainsAny = false;
-    bool isContainsAll = true;
+    // 中心と面までの距離に分けて，各平面の法線方向に投影した半径で判定する.
+    Vector3 center  = ( value.max + value.min ) * 0.5f;
+    Vector3 extents = ( value.max - value.min ) * 0.5f;
+    ContainmentType result = ContainmentType::CONTAINS;
 
-    for( u32 i=0; i<corners.GetSize(); ++i )
+    for( u32 i=0; i<6; ++i )
     {
-        result = value.Contains( corners.GetAt( i ) );
-        switch( result )
-        {
-        case ContainmentType::CONTAINS:
-        case ContainmentType::INTERSECTS:
-            isContainsAny = true;
-            break;
+        register f32 dist   = plane[ i ].DotCoordinate( center );
+        register f32 radius = ( fabs( plane[ i ].normal.x ) * extents.x )
+                            + ( fabs( plane[ i ].normal.y ) * extents.y )
+                            + ( fabs( plane[ i ].normal.z ) * extents.z );
 
-        case ContainmentType::DISJOINT:
-            isContainsAll = false;
-            break;
-        }
-    }
+        if ( dist < -radius )
+        { return ContainmentType::DISJOINT; }
 
-    if ( isContainsAny )
-    {
-        if ( isContainsAll )
-        { return ContainmentType::CONTAINS; }
-        else
-        { return ContainmentType::INTERSECTS; }
+        if ( dist <= radius )
+        { result = ContainmentType::INTERSECTS; }
     }
-    else
-    { return ContainmentType::DISJOINT; }
+
+    return result;
 }
 
 ///------------------------------------------------------------------------------------
@@ -2599,6 +3444,9 @@ ContainmentType BoundingFrustum::Contains( const BoundingSphere& value ) const
         case PlaneIntersectionType::INTERSECTING:
             ret = PlaneIntersectionType::INTERSECTING;
             break;
+
+        default:
+            break;
         }
     }
 
@@ -2776,13 +3624,13 @@ bool    BoundingFrustum::Intersects( const Ray& value, f32& distance ) const
 ASDX_INLINE
 Vector3 BoundingFrustum::IntersectionPoint( const Plane& a, const Plane& b, const Plane& c )
 {
-    register f32 f = -Dot( a.normal, Cross( b.normal, c.normal ) );
+    register f32 f = -Vector3::Dot( a.normal, Vector3::Cross( b.normal, c.normal ) );
     assert( f != 0.0f );
     register f32 invF = 1.0f / f;
 
-    Vector3 v1 = ( a.d * Cross( b.normal, c.normal ) );
-    Vector3 v2 = ( b.d * Cross( c.normal, a.normal ) );
-    Vector3 v3 = ( c.d * Cross( a.normal, b.normal ) );
+    Vector3 v1 = ( a.d * Vector3::Cross( b.normal, c.normal ) );
+    Vector3 v2 = ( b.d * Vector3::Cross( c.normal, a.normal ) );
+    Vector3 v3 = ( c.d * Vector3::Cross( a.normal, b.normal ) );
 
     return Vector3(
         ( v1.x + v2.x + v3.x ) * invF,
@@ -2829,6 +3677,87 @@ void    BoundingFrustum::GetCorners( Vector3x8& result ) const
 }
 
 
+///------------------------------------------------------------------------------------
+///<summary>8個の点との交差判定をまとめて行います.</summary>
+///<param name="points">判定する8個の点</param>
+///<return>境界錐台に含まれる点のビットを立てたマスクを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32     BoundingFrustum::Intersects( const Vector3x8& points ) const
+{
+    simd::f32x8 x = simd::Load8( points.x.v );
+    simd::f32x8 y = simd::Load8( points.y.v );
+    simd::f32x8 z = simd::Load8( points.z.v );
+    simd::f32x8 zero = simd::Splat8( 0.0f );
+    simd::mask8 outside = simd::FromBits( 0 );
+
+    for( u32 i=0; i<6; ++i )
+    {
+        simd::f32x8 dist = simd::DotCoordinate( plane[ i ], x, y, z );
+        outside = simd::Or( outside, simd::CmpLt( dist, zero ) );
+    }
+
+    return ( ~simd::ToBits( outside ) ) & 0xff;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>8個の境界球との交差判定をまとめて行います.</summary>
+///<param name="centers">8個の境界球の中心</param>
+///<param name="radius">8個の境界球の半径</param>
+///<return>交差している境界球のビットを立てたマスクを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32     BoundingFrustum::Intersects( const Vector3x8& centers, const Float8& radius ) const
+{
+    simd::f32x8 x = simd::Load8( centers.x.v );
+    simd::f32x8 y = simd::Load8( centers.y.v );
+    simd::f32x8 z = simd::Load8( centers.z.v );
+    simd::f32x8 r = simd::Neg( simd::Load8( radius.v ) );
+    simd::mask8 outside = simd::FromBits( 0 );
+
+    for( u32 i=0; i<6; ++i )
+    {
+        simd::f32x8 dist = simd::DotCoordinate( plane[ i ], x, y, z );
+        outside = simd::Or( outside, simd::CmpLt( dist, r ) );
+    }
+
+    return ( ~simd::ToBits( outside ) ) & 0xff;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>8個の境界箱との交差判定をまとめて行います.</summary>
+///<param name="centers">8個の境界箱の中心</param>
+///<param name="extents">8個の境界箱の中心から面までの距離</param>
+///<return>交差している境界箱のビットを立てたマスクを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32     BoundingFrustum::Intersects( const Vector3x8& centers, const Vector3x8& extents ) const
+{
+    simd::f32x8 x  = simd::Load8( centers.x.v );
+    simd::f32x8 y  = simd::Load8( centers.y.v );
+    simd::f32x8 z  = simd::Load8( centers.z.v );
+    simd::f32x8 ex = simd::Load8( extents.x.v );
+    simd::f32x8 ey = simd::Load8( extents.y.v );
+    simd::f32x8 ez = simd::Load8( extents.z.v );
+    simd::mask8 outside = simd::FromBits( 0 );
+
+    for( u32 i=0; i<6; ++i )
+    {
+        const Plane& p = plane[ i ];
+
+        // Contains( const BoundingBox& ) と同じ順序で投影した半径を求める.
+        simd::f32x8 r = simd::Mul( simd::Splat8( fabs( p.normal.x ) ), ex );
+        r = simd::Add( r, simd::Mul( simd::Splat8( fabs( p.normal.y ) ), ey ) );
+        r = simd::Add( r, simd::Mul( simd::Splat8( fabs( p.normal.z ) ), ez ) );
+
+        simd::f32x8 dist = simd::DotCoordinate( p, x, y, z );
+        outside = simd::Or( outside, simd::CmpLt( dist, simd::Neg( r ) ) );
+    }
+
+    return ( ~simd::ToBits( outside ) ) & 0xff;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // Functions
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -2928,9 +3857,9 @@ Vector2 ComputeCircumcircleCenter
    assert( S != 0.0f );
    register f32 inv16S2 = 1.0f / ( S * S * 16.0f );
 
-   register f32 len0 = DistanceSq( p1, p2 );
-   register f32 len1 = DistanceSq( p0, p2 );
-   register f32 len2 = DistanceSq( p0, p1 );
+   register f32 len0 = Vector2::DistanceSq( p1, p2 );
+   register f32 len1 = Vector2::DistanceSq( p0, p2 );
+   register f32 len2 = Vector2::DistanceSq( p0, p1 );
 
    register f32 term0 = inv16S2 * len0 * ( len1 + len2 - len0 );
    register f32 term1 = inv16S2 * len1 * ( len0 + len2 - len1 );
@@ -2962,9 +3891,9 @@ void ComputeCircumcircleCenter
    assert( S != 0.0f );
    register f32 inv16S2 = 1.0f / ( S * S * 16.0f );
 
-   register f32 len0 = DistanceSq( p1, p2 );
-   register f32 len1 = DistanceSq( p0, p2 );
-   register f32 len2 = DistanceSq( p0, p1 );
+   register f32 len0 = Vector2::DistanceSq( p1, p2 );
+   register f32 len1 = Vector2::DistanceSq( p0, p2 );
+   register f32 len2 = Vector2::DistanceSq( p0, p1 );
 
    register f32 term0 = inv16S2 * len0 * ( len1 + len2 - len0 );
    register f32 term1 = inv16S2 * len1 * ( len0 + len2 - len1 );
@@ -0,0 +1,105 @@
+﻿//------------------------------------------------------------------------------
+// File : GhostInstance.h
+// Desc : Lens Ghost Instance List.
+// Copyright(c) Project Asura. All right reserved.
+//------------------------------------------------------------------------------
+
+#ifndef __GHOST_INSTANCE_H__
+#define __GHOST_INSTANCE_H__
+
+//------------------------------------------------------------------------------
+// Include
+//------------------------------------------------------------------------------
+#include <asdxMath.h>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GhostInstance structure
+////////////////////////////////////////////////////////////////////////////////////////
+struct GhostInstance
+{
+    float   Color[3];   //!< 乗算カラーです.
+    float   Scale;      //!< テクスチャスケールです.
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GhostInstanceList class
+////////////////////////////////////////////////////////////////////////////////////////
+class GhostInstanceList
+{
+    //==================================================================================
+    // list of friend classes and methods.
+    //==================================================================================
+    /* NOTHING */
+
+public:
+    //==================================================================================
+    // public variables.
+    //==================================================================================
+    static const float  REPLICA_SPREAD;     //!< 複製したゴーストのスケールを広げる割合です.
+
+    //==================================================================================
+    // public methods.
+    //==================================================================================
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //----------------------------------------------------------------------------------
+    GhostInstanceList();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    ~GhostInstanceList();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      ゴーストのテーブルからインスタンスデータを構築します.
+    //!
+    //! @param [in]     pGhosts         乗算カラー(xyz)とテクスチャスケール(w)のテーブルです.
+    //! @param [in]     count           テーブルの要素数です.
+    //! @param [in]     replicaCount    1つのゴーストを分割するインスタンス数です. 0 の場合は 1 として扱います.
+    //! @return     内容が変化した場合に true を返却します.
+    //! @note       複製したインスタンスはスケールを REPLICA_SPREAD の範囲で広げ，
+    //!             カラーを replicaCount で割るので，加算合成した明るさの総和は変わりません.
+    //!             寄与の無いゴーストは除きます.
+    //----------------------------------------------------------------------------------
+    bool Build( const asdx::Vector4* pGhosts, u32 count, u32 replicaCount );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      インスタンスデータを取得します.
+    //----------------------------------------------------------------------------------
+    const GhostInstance* GetData() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      インスタンス数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetCount() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      前回の ClearDirty() 以降に内容が変化したかどうかチェックします.
+    //----------------------------------------------------------------------------------
+    bool IsDirty() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      変化したフラグを落とします. GPUに転送した後に呼び出します.
+    //----------------------------------------------------------------------------------
+    void ClearDirty();
+
+private:
+    //==================================================================================
+    // private variables.
+    //==================================================================================
+    std::vector<GhostInstance>  m_Instances;    //!< インスタンスデータです.
+    bool                        m_Dirty;        //!< 転送が必要かどうか.
+
+    //==================================================================================
+    // private methods.
+    //==================================================================================
+    GhostInstanceList   ( const GhostInstanceList& );   // アクセス禁止.
+    void operator =     ( const GhostInstanceList& );   // アクセス禁止.
+};
+
+
+#endif//__GHOST_INSTANCE_H__
@@ -0,0 +1,106 @@
+﻿//------------------------------------------------------------------------------
+// File : GhostInstanceBuffer.h
+// Desc : Lens Ghost Instance Buffer for D3D11.
+// Copyright(c) Project Asura. All right reserved.
+//------------------------------------------------------------------------------
+
+#ifndef __GHOST_INSTANCE_BUFFER_H__
+#define __GHOST_INSTANCE_BUFFER_H__
+
+//------------------------------------------------------------------------------
+// Include
+//------------------------------------------------------------------------------
+#include <d3d11.h>
+#include "GhostInstance.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GhostInstanceBuffer class
+////////////////////////////////////////////////////////////////////////////////////////
+class GhostInstanceBuffer
+{
+    //==================================================================================
+    // list of friend classes and methods.
+    //==================================================================================
+    /* NOTHING */
+
+public:
+    //==================================================================================
+    // public variables.
+    //==================================================================================
+    /* NOTHING */
+
+    //==================================================================================
+    // public methods.
+    //==================================================================================
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //----------------------------------------------------------------------------------
+    GhostInstanceBuffer();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    ~GhostInstanceBuffer();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      初期化処理を行います.
+    //!
+    //! @param [in]     pDevice     デバイスです.
+    //! @param [in]     maxCount    最大インスタンス数です.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //----------------------------------------------------------------------------------
+    bool Init( ID3D11Device* pDevice, u32 maxCount );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      終了処理を行います.
+    //----------------------------------------------------------------------------------
+    void Term();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      インスタンスデータが変化していれば転送します.
+    //!
+    //! @param [in]     pContext    デバイスコンテキストです.
+    //! @param [in]     list        インスタンスデータです. 転送後に変化したフラグを落とします.
+    //! @retval true    転送した.
+    //! @retval false   変化が無いので転送しなかった.
+    //! @note       最大インスタンス数を超えた分は転送しません.
+    //----------------------------------------------------------------------------------
+    bool Update( ID3D11DeviceContext* pContext, GhostInstanceList& list );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      シェーダリソースビューを取得します.
+    //----------------------------------------------------------------------------------
+    ID3D11ShaderResourceView* GetSRV() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      転送済みのインスタンス数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetCount() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      これまでに転送した回数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetUploadCount() const;
+
+private:
+    //==================================================================================
+    // private variables.
+    //==================================================================================
+    ID3D11Buffer*               m_pBuffer;      //!< 構造化バッファです.
+    ID3D11ShaderResourceView*   m_pSRV;         //!< シェーダリソースビューです.
+    u32                         m_MaxCount;     //!< 最大インスタンス数です.
+    u32                         m_Count;        //!< 転送済みのインスタンス数です.
+    u32                         m_UploadCount;  //!< 転送した回数です.
+
+    //==================================================================================
+    // private methods.
+    //==================================================================================
+    GhostInstanceBuffer ( const GhostInstanceBuffer& );     // アクセス禁止.
+    void operator =     ( const GhostInstanceBuffer& );     // アクセス禁止.
+};
+
+
+#endif//__GHOST_INSTANCE_BUFFER_H__
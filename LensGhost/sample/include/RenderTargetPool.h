@@ -0,0 +1,297 @@
+﻿//------------------------------------------------------------------------------
+// File : RenderTargetPool.h
+// Desc : Transient Render Target Pool.
+// Copyright(c) Project Asura. All right reserved.
+//------------------------------------------------------------------------------
+
+#ifndef __RENDER_TARGET_POOL_H__
+#define __RENDER_TARGET_POOL_H__
+
+//------------------------------------------------------------------------------
+// Include
+//------------------------------------------------------------------------------
+#include <asdxTypedef.h>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// RenderTargetDesc structure
+////////////////////////////////////////////////////////////////////////////////////////
+struct RenderTargetDesc
+{
+    u32     Width;      //!< 横幅です.
+    u32     Height;     //!< 縦幅です.
+    u32     Format;     //!< フォーマットです. D3D11 では DXGI_FORMAT の値を格納します.
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// IRenderTargetAllocator interface
+////////////////////////////////////////////////////////////////////////////////////////
+struct IRenderTargetAllocator
+{
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    virtual ~IRenderTargetAllocator()
+    { /* DO_NOTHING */ }
+
+    //----------------------------------------------------------------------------------
+    //! @brief      実体となるレンダーターゲットを生成します.
+    //!
+    //! @param [in]     desc        構成設定です.
+    //! @return     生成したレンダーターゲットを返却します. 失敗した場合は nullptr を返却します.
+    //----------------------------------------------------------------------------------
+    virtual void* Create( const RenderTargetDesc& desc ) = 0;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      Create() で生成したレンダーターゲットを破棄します.
+    //!
+    //! @param [in]     pTarget     破棄するレンダーターゲットです.
+    //----------------------------------------------------------------------------------
+    virtual void Dispose( void* pTarget ) = 0;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      レンダーターゲットのバイトサイズを見積もります.
+    //!
+    //! @param [in]     desc        構成設定です.
+    //! @return     バイトサイズを返却します.
+    //----------------------------------------------------------------------------------
+    virtual u64 GetSize( const RenderTargetDesc& desc ) const = 0;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// NullRenderTargetAllocator class
+////////////////////////////////////////////////////////////////////////////////////////
+class NullRenderTargetAllocator : public IRenderTargetAllocator
+{
+    //==================================================================================
+    // list of friend classes and methods.
+    //==================================================================================
+    /* NOTHING */
+
+public:
+    //==================================================================================
+    // public variables.
+    //==================================================================================
+    /* NOTHING */
+
+    //==================================================================================
+    // public methods.
+    //==================================================================================
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //!
+    //! @param [in]     bytesPerPixel   サイズの見積もりに使う1テクセルあたりのバイト数です.
+    //----------------------------------------------------------------------------------
+    explicit NullRenderTargetAllocator( u32 bytesPerPixel = 4 );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    ~NullRenderTargetAllocator();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      構成設定のコピーをレンダーターゲットの代わりに生成します.
+    //!
+    //! @param [in]     desc        構成設定です.
+    //! @return     生成した RenderTargetDesc を返却します.
+    //! @note       SetFailCount() で指定した回数だけ生成した後は nullptr を返却します.
+    //----------------------------------------------------------------------------------
+    void* Create( const RenderTargetDesc& desc );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      Create() で生成した構成設定を破棄します.
+    //----------------------------------------------------------------------------------
+    void Dispose( void* pTarget );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      レンダーターゲットのバイトサイズを見積もります.
+    //----------------------------------------------------------------------------------
+    u64 GetSize( const RenderTargetDesc& desc ) const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      生成に失敗させるまでの回数を設定します.
+    //!
+    //! @param [in]     count       生成に成功する回数です. 0xffffffff の場合は失敗させません.
+    //----------------------------------------------------------------------------------
+    void SetFailCount( u32 count );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      生成中のレンダーターゲット数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetLiveCount() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      これまでに生成したレンダーターゲットの総数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetCreateCount() const;
+
+private:
+    //==================================================================================
+    // private variables.
+    //==================================================================================
+    u32     m_BytesPerPixel;    //!< 1テクセルあたりのバイト数です.
+    u32     m_FailCount;        //!< 生成に成功する残りの回数です.
+    u32     m_LiveCount;        //!< 生成中のレンダーターゲット数です.
+    u32     m_CreateCount;      //!< 生成したレンダーターゲットの総数です.
+
+    //==================================================================================
+    // private methods.
+    //==================================================================================
+    NullRenderTargetAllocator   ( const NullRenderTargetAllocator& );   // アクセス禁止.
+    void operator =             ( const NullRenderTargetAllocator& );   // アクセス禁止.
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// RenderTargetPool class
+////////////////////////////////////////////////////////////////////////////////////////
+class RenderTargetPool
+{
+    //==================================================================================
+    // list of friend classes and methods.
+    //==================================================================================
+    /* NOTHING */
+
+public:
+    //==================================================================================
+    // public variables.
+    //==================================================================================
+    typedef u32 Handle;                                 //!< 仮想ターゲットのハンドルです.
+    static const Handle INVALID_HANDLE = 0xffffffff;    //!< 無効なハンドルです.
+
+    //==================================================================================
+    // public methods.
+    //==================================================================================
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //----------------------------------------------------------------------------------
+    RenderTargetPool();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    ~RenderTargetPool();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      初期化処理を行います.
+    //!
+    //! @param [in]     pAllocator  実体を生成するアロケータです. プールより長く生存する必要があります.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //----------------------------------------------------------------------------------
+    bool Init( IRenderTargetAllocator* pAllocator );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      全てのレンダーターゲットを破棄します.
+    //----------------------------------------------------------------------------------
+    void Term();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      パス列の宣言を開始します.
+    //!
+    //! @note       宣言済みの仮想ターゲットを破棄します. 実体は次の Compile() まで保持します.
+    //----------------------------------------------------------------------------------
+    void Begin();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      仮想ターゲットを宣言します.
+    //!
+    //! @param [in]     desc        構成設定です.
+    //! @param [in]     firstPass   最初に書き込むパスの番号です.
+    //! @param [in]     lastPass    最後に読み込むパスの番号です. firstPass 以上を指定します.
+    //! @return     仮想ターゲットのハンドルを返却します. 引数が不正な場合は INVALID_HANDLE を返却します.
+    //----------------------------------------------------------------------------------
+    Handle Request( const RenderTargetDesc& desc, u32 firstPass, u32 lastPass );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      仮想ターゲットに実体を割り当てます.
+    //!
+    //! @retval true    割り当てに成功.
+    //! @retval false   実体の生成に失敗.
+    //! @note       構成設定が同じで，使用するパスの区間が重ならない仮想ターゲットは1つの実体を共有します.
+    //!             前回の Compile() で生成した実体は構成設定が同じなら作り直さずに使い回し，
+    //!             使わなくなった実体は新しい実体を生成する前に破棄します.
+    //----------------------------------------------------------------------------------
+    bool Compile();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      仮想ターゲットに割り当てた実体を取得します.
+    //!
+    //! @param [in]     handle      ハンドルです.
+    //! @return     アロケータが生成した実体を返却します. 無効なハンドルや Compile() 前は nullptr を返却します.
+    //----------------------------------------------------------------------------------
+    void* GetTarget( Handle handle ) const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      仮想ターゲットに割り当てた実体の番号を取得します.
+    //!
+    //! @param [in]     handle      ハンドルです.
+    //! @return     実体の番号を返却します. 無効なハンドルや Compile() 前は INVALID_HANDLE を返却します.
+    //----------------------------------------------------------------------------------
+    u32 GetPhysicalIndex( Handle handle ) const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      宣言した仮想ターゲット数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetVirtualCount() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      生成済みの実体の数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetPhysicalCount() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      仮想ターゲットごとに実体を生成した場合のバイトサイズを取得します.
+    //----------------------------------------------------------------------------------
+    u64 GetRequestedSize() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      生成済みの実体のバイトサイズを取得します.
+    //----------------------------------------------------------------------------------
+    u64 GetAllocatedSize() const;
+
+private:
+    //==================================================================================
+    // Virtual structure
+    //==================================================================================
+    struct Virtual
+    {
+        RenderTargetDesc    Desc;           //!< 構成設定です.
+        u32                 FirstPass;      //!< 最初に書き込むパスの番号です.
+        u32                 LastPass;       //!< 最後に読み込むパスの番号です.
+        u32                 Physical;       //!< 割り当てた実体の番号です.
+    };
+
+    //==================================================================================
+    // Physical structure
+    //==================================================================================
+    struct Physical
+    {
+        RenderTargetDesc    Desc;           //!< 構成設定です.
+        void*               pTarget;        //!< アロケータが生成した実体です.
+        u32                 LastPass;       //!< 割り当て中の仮想ターゲットが最後に読み込むパスの番号です.
+        bool                Claimed;        //!< 今回の Compile() で割り当て済みかどうか.
+    };
+
+    //==================================================================================
+    // private variables.
+    //==================================================================================
+    IRenderTargetAllocator*     m_pAllocator;   //!< アロケータです.
+    std::vector<Virtual>        m_Virtuals;     //!< 仮想ターゲットです.
+    std::vector<Physical>       m_Physicals;    //!< 実体です.
+    bool                        m_Compiled;     //!< 割り当て済みかどうか.
+
+    //==================================================================================
+    // private methods.
+    //==================================================================================
+    RenderTargetPool    ( const RenderTargetPool& );    // アクセス禁止.
+    void operator =     ( const RenderTargetPool& );    // アクセス禁止.
+};
+
+
+#endif//__RENDER_TARGET_POOL_H__
@@ -19,6 +19,21 @@
 #include <asdxFont.h>
 #include <asdxConstantBuffer.h>
 #include <asdxTexture.h>
+#include "RenderTargetAllocator.h"
+#include "GhostInstanceBuffer.h"
+#include "ParamTableCache.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GHOST_MODE enum
+////////////////////////////////////////////////////////////////////////////////////////
+enum GHOST_MODE
+{
+    GHOST_MODE_MULTI_PASS = 0,      //!< ゴースト1枚ごとに加算合成します.
+    GHOST_MODE_FUSED,               //!< 1段分のゴーストを1パスで描画します.
+    GHOST_MODE_CHAIN,               //!< 2段分のゴーストを展開し，ブラー済み画像から1パスで描画します.
+    GHOST_MODE_INSTANCED,           //!< 1段分のゴーストを1回のインスタンス描画で加算合成します.
+    NUM_GHOST_MODE,
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // SampleApplication
@@ -37,11 +52,17 @@ private:
     asdx::Font                  m_Font;                         //!< フォントです.
     asdx::Texture2D             m_InputTexture;                 //!< 入力画像.
     asdx::Texture2D             m_MaskTexture;                  //!< マスク画像.
+    asdx::Vector4               m_MaskSupport;                  //!< マスクが0でないテクスチャ座標の範囲(xy:最小, zw:最大).
     ID3D11VertexShader*         m_pFullScreenVS  = nullptr;     //!< フルスクリーン三角形用頂点シェーダ.
     ID3D11PixelShader*          m_pCopyPS        = nullptr;     //!< シングルテクスチャフェッチシェーダ.
     ID3D11PixelShader*          m_pCompositePS   = nullptr;     //!< コンポジットシェーダ.
     ID3D11PixelShader*          m_pLensGhostPS   = nullptr;     //!< レンズゴーストシェーダ.
+    ID3D11PixelShader*          m_pLensGhostMultiPS = nullptr;  //!< 全ゴーストを1パスで描画するシェーダ.
+    ID3D11PixelShader*          m_pLensGhostChainPS = nullptr;  //!< 2段分のゴーストを1パスで描画するシェーダ.
+    ID3D11VertexShader*         m_pLensGhostInstancedVS = nullptr;  //!< インスタンスデータを読むゴーストの頂点シェーダ.
+    ID3D11PixelShader*          m_pLensGhostInstancedPS = nullptr;  //!< インスタンス描画用のゴーストシェーダ.
     ID3D11PixelShader*          m_pGaussBlurPS   = nullptr;     //!< ガウスブラーシェーダ.
+    ID3D11PixelShader*          m_pGaussBlurLinearPS[5] = {};   //!< リニアサンプリングでタップをまとめたガウスブラーシェーダ.
     ID3D11SamplerState*         m_pPointSampler  = nullptr;     //!< ポイントサンプラー.
     ID3D11SamplerState*         m_pLinearClamp   = nullptr;     //!< リニアサンプラー.
     ID3D11SamplerState*         m_pLinearWrap    = nullptr;
@@ -49,13 +70,34 @@ private:
     ID3D11BlendState*           m_pAdditiveBS    = nullptr;     //!< 加算.
     asdx::QuadRenderer          m_Quad;
     asdx::ConstantBuffer        m_LensGhostBuffer;
-    asdx::ConstantBuffer        m_GaussBlurBuffer;
-    asdx::RenderTarget2D        m_WorkBuffer[4];
+    asdx::ConstantBuffer        m_LensGhostMultiBuffer;
+    asdx::ConstantBuffer        m_LensGhostChainBuffer;
+    ParamTableCache             m_ParamTable;                   //!< IMMUTABLE な定数バッファのキャッシュ.
+    ParamTableCache::Handle     m_BlurTable[2];                 //!< 横・縦のブラーテーブル.
+    ParamTableCache::Handle     m_LinearBlurTable[5][2];        //!< タップ数ごとの横・縦のリニアサンプリング版のブラーテーブル.
+    RenderTargetAllocator       m_TargetAllocator;              //!< 作業バッファのアロケータ.
+    RenderTargetPool            m_TargetPool;                   //!< 作業バッファのプール.
+    RenderTargetPool::Handle    m_WorkTarget[4];                //!< 1段目・2段目のゴーストと縦横のブラー結果.
+    GhostInstanceList           m_GhostInstanceList[2];         //!< 1段目・2段目のゴーストのインスタンスデータ.
+    GhostInstanceBuffer         m_GhostInstanceBuffer[2];       //!< 1段目・2段目のゴーストの構造化バッファ.
+    u32                         m_GhostReplicaIndex = 0;        //!< 1つのゴーストを分割するインスタンス数の番号.
+    GHOST_MODE                  m_GhostMode      = GHOST_MODE_FUSED;    //!< ゴーストの描画方法.
+    u32                         m_ChainThresholdIndex = 0;      //!< 展開した項を捨てる閾値の番号.
+    u32                         m_ChainTermCount = 0;           //!< 展開後に描画した項数.
+    bool                        m_LinearBlur     = false;       //!< リニアサンプリング版のブラーを使うかどうか.
+    u32                         m_BlurTapIndex   = 2;           //!< リニアサンプリング版のタップ数の番号(15タップ).
+    u32                         m_WorkFormatIndex = 0;          //!< 作業バッファのフォーマットの番号.
 
     //==================================================================================
     // private methods.
     //==================================================================================
     void OnDrawText();
+    void DrawGhostsFused( const asdx::Vector4* pColors, u32 count );
+    void DrawGhostChain( float threshold );
+    void DrawGhostsInstanced( u32 round );
+    void BuildGhostInstances();
+    bool CreateWorkBuffers();
+    bool BuildParamTables();
 
 protected:
     //==================================================================================
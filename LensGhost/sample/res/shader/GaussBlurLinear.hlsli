@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------------------------
+// File : GaussBlurLinear.hlsli
+// Desc : Gauss Blur (Linear Sampling).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+#ifndef TAP_COUNT
+#error "TAP_COUNT is not defined."
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+
+// S͒PƁCׂ͗荇2^bvjATvO1tFb`ɂ܂Ƃ߂.
+// glare::GetLinearFetchCount() Ɠlł.
+#define FETCH_COUNT     (1 + ((TAP_COUNT / 2 + 1) / 2) * 2)
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// VSOutput structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct VSOutput
+{
+    float4 Position : SV_POSITION;
+    float2 TexCoord : TEXCOORD;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CBuffer structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+cbuffer CbBlur
+{
+    float4  Offset[FETCH_COUNT];    // ItZbg(xy)Əd(z).
+};
+
+//-------------------------------------------------------------------------------------------------
+// Textures and Samplers.
+//-------------------------------------------------------------------------------------------------
+Texture2D       ColorBuffer  : register(t0);
+SamplerState    ColorSampler : register(s0);
+
+//-------------------------------------------------------------------------------------------------
+//      CGg[|Cgł.
+//-------------------------------------------------------------------------------------------------
+float4 main(const VSOutput input) : SV_TARGET0
+{
+    float4 result = 0;
+
+    [unroll]
+    for(int i=0; i<FETCH_COUNT; ++i)
+    { result += Offset[i].z * ColorBuffer.Sample(ColorSampler, input.TexCoord + Offset[i].xy); }
+
+    result.w = 1.0f;
+
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+//-------------------------------------------------------------------------------------------------
+// File : GaussBlurLinear15PS.hlsl
+// Desc : Gauss Blur (Linear Sampling, 15 Taps).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+#define TAP_COUNT   15
+#include "GaussBlurLinear.hlsli"
\ No newline at end of file
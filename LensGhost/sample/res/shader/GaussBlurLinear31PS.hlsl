@@ -0,0 +1,8 @@
+//-------------------------------------------------------------------------------------------------
+// File : GaussBlurLinear31PS.hlsl
+// Desc : Gauss Blur (Linear Sampling, 31 Taps).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+#define TAP_COUNT   31
+#include "GaussBlurLinear.hlsli"
\ No newline at end of file
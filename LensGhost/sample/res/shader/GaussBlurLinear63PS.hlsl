@@ -0,0 +1,8 @@
+//-------------------------------------------------------------------------------------------------
+// File : GaussBlurLinear63PS.hlsl
+// Desc : Gauss Blur (Linear Sampling, 63 Taps).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+#define TAP_COUNT   63
+#include "GaussBlurLinear.hlsli"
\ No newline at end of file
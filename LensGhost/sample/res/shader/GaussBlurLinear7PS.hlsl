@@ -0,0 +1,8 @@
+//-------------------------------------------------------------------------------------------------
+// File : GaussBlurLinear7PS.hlsl
+// Desc : Gauss Blur (Linear Sampling, 7 Taps).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+#define TAP_COUNT   7
+#include "GaussBlurLinear.hlsli"
\ No newline at end of file
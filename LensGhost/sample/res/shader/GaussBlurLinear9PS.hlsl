@@ -0,0 +1,8 @@
+//-------------------------------------------------------------------------------------------------
+// File : GaussBlurLinear9PS.hlsl
+// Desc : Gauss Blur (Linear Sampling, 9 Taps).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+#define TAP_COUNT   9
+#include "GaussBlurLinear.hlsli"
\ No newline at end of file
@@ -0,0 +1,84 @@
+//-------------------------------------------------------------------------------------------------
+// File : LensGhostChainPS.hlsl
+// Desc : Lens Ghost Shader (Two rounds evaluated from the blurred image).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+static const float2 CENTER         = float2(0.5f, 0.5f);    // eNX`S.
+static const uint   MAX_TERM_COUNT = 64;                    // ő區.
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// VSOutput structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct VSOutput
+{
+    float4 Position : SV_POSITION;
+    float2 TexCoord : TEXCOORD;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CbLensGhostChain constant buffer.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+cbuffer CbLensGhostChain
+{
+    uint   TermCount                    : packoffset(c0.x);     // .
+    uint   SaturateInner                : packoffset(c0.y);     // 1iڂ̘aOa邩ǂ(UNORM̍ƃobt@).
+    float2 TexelHalf                    : packoffset(c0.z);     // 1iڂ̕`̔eNZTCY.
+    float4 Colors[MAX_TERM_COUNT]       : packoffset(c1);       // 1iڂ̏ZJ[(xyz).
+    float4 Scales[MAX_TERM_COUNT]       : packoffset(c65);      // 2iڂ̃XP[(x)1iڂ̃XP[(y), 2iڂ̃S[Xg̍Ō̍ǂ(z).
+    float4 OuterColors[MAX_TERM_COUNT]  : packoffset(c129);     // 2iڂ̏ZJ[(xyz).
+    float4 Rects[MAX_TERM_COUNT]        : packoffset(c193);     // ^ʏ͈̔(xy:ŏ, zw:ő).
+};
+
+//-------------------------------------------------------------------------------------------------
+// Textures and Samplers.
+//-------------------------------------------------------------------------------------------------
+Texture2D       ColorBuffer  : register(t0);    // u[ς݉摜.
+Texture2D       MaskBuffer   : register(t1);    // }XN摜.
+SamplerState    ColorSampler : register(s0);    // jATv[
+
+//-------------------------------------------------------------------------------------------------
+//      CGg[|Cgł.
+//-------------------------------------------------------------------------------------------------
+float4 main(const VSOutput input) : SV_TARGET0
+{
+    float3 result = 0;
+    float3 inner  = 0;
+    float2 pos    = input.TexCoord - CENTER;
+
+    // 2iڂ̃S[XgWJ͘Aĕł.
+    [loop]
+    for(uint i=0; i<TermCount; ++i)
+    {
+        // 2iڂ̍W.
+        float2 uv = pos * Scales[i].x + CENTER;
+
+        // }XN0ɂȂ͈͂ł̓tFb`Ȃ.
+        [branch]
+        if (all(input.TexCoord >= Rects[i].xy) && all(input.TexCoord <= Rects[i].zw))
+        {
+            // 1iڂ̕`挋ʂNvŃTvOꍇƓW.
+            float2 st = (clamp(uv, TexelHalf, 1.0f - TexelHalf) - CENTER) * Scales[i].y + CENTER;
+
+            float4 color = ColorBuffer.SampleLevel(ColorSampler, st, 0);
+            float  mask1 = MaskBuffer .SampleLevel(ColorSampler, st, 0).r;
+
+            inner += color.rgb * Colors[i].rgb * mask1;
+        }
+
+        [branch]
+        if (Scales[i].z != 0.0f)
+        {
+            // 1iڂ̕`挋ʂUNORM̏ꍇ͉ZŖOaĂ̂ŁCOaĂ2iڂ|.
+            float mask0 = MaskBuffer.SampleLevel(ColorSampler, uv, 0).r;
+            result += ((SaturateInner != 0) ? saturate(inner) : inner) * OuterColors[i].rgb * mask0;
+            inner = 0;
+        }
+    }
+
+    return float4(saturate(result), 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+//-------------------------------------------------------------------------------------------------
+// File : LensGhostInstancedPS.hlsl
+// Desc : Lens Ghost Pixel Shader (Instanced).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// VSOutput structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct VSOutput
+{
+    float4                  Position : SV_POSITION;
+    float2                  TexCoord : TEXCOORD0;
+    nointerpolation float3  Color    : COLOR;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Textures and Samplers.
+//-------------------------------------------------------------------------------------------------
+Texture2D       ColorBuffer  : register(t0);    // ͉摜.
+Texture2D       MaskBuffer   : register(t1);    // }XN摜.
+SamplerState    ColorSampler : register(s0);    // jATv[
+
+//-------------------------------------------------------------------------------------------------
+//      CGg[|Cgł.
+//-------------------------------------------------------------------------------------------------
+float4 main(const VSOutput input) : SV_TARGET0
+{
+    float4 color = ColorBuffer.SampleLevel(ColorSampler, input.TexCoord, 0);
+    float  mask  = MaskBuffer .SampleLevel(ColorSampler, input.TexCoord, 0).r;
+
+    return float4(color.rgb * input.Color * mask, 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+//-------------------------------------------------------------------------------------------------
+// File : LensGhostInstancedVS.hlsl
+// Desc : Lens Ghost Vertex Shader (Instanced).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+static const float2 CENTER = float2(0.5f, 0.5f);    // eNX`S.
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// GhostInstance structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct GhostInstance
+{
+    float3 Color;       // ZJ[.
+    float  Scale;       // eNX`XP[.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// VSOutput structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct VSOutput
+{
+    float4                  Position : SV_POSITION;
+    float2                  TexCoord : TEXCOORD0;
+    nointerpolation float3  Color    : COLOR;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Resources.
+//-------------------------------------------------------------------------------------------------
+StructuredBuffer<GhostInstance> Ghosts : register(t0);  // CX^Xf[^.
+
+//-------------------------------------------------------------------------------------------------
+//      CGg[|Cgł.
+//-------------------------------------------------------------------------------------------------
+VSOutput main(uint vertexId : SV_VertexID, uint instanceId : SV_InstanceID)
+{
+    // _obt@g킸ɉʂ𕢂Op`𐶐.
+    float2 uv = float2((vertexId << 1) & 2, vertexId & 2);
+
+    GhostInstance ghost = Ghosts[instanceId];
+
+    // XP[̓AtBϊȂ̂, _ŌvZĕԂĂʂ͕ςȂ.
+    VSOutput output;
+    output.Position = float4(uv * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f), 0.0f, 1.0f);
+    output.TexCoord = (uv - CENTER) * ghost.Scale + CENTER;
+    output.Color    = ghost.Color;
+
+    return output;
+}
\ No newline at end of file
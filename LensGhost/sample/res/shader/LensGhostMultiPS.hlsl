@@ -0,0 +1,59 @@
+//-------------------------------------------------------------------------------------------------
+// File : LensGhostMultiPS.hlsl
+// Desc : Lens Ghost Shader (All ghosts in one pass).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+static const float2 CENTER          = float2(0.5f, 0.5f);   // eNX`S.
+static const uint   MAX_GHOST_COUNT = 16;                   // őS[Xg.
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// VSOutput structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct VSOutput
+{
+    float4 Position : SV_POSITION;
+    float2 TexCoord : TEXCOORD;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CbLensGhostMulti constant buffer.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+cbuffer CbLensGhostMulti
+{
+    uint   GhostCount               : packoffset(c0);   // S[Xg.
+    float4 Ghosts[MAX_GHOST_COUNT]  : packoffset(c1);   // ZJ[(xyz)ƃeNX`XP[(w).
+};
+
+//-------------------------------------------------------------------------------------------------
+// Textures and Samplers.
+//-------------------------------------------------------------------------------------------------
+Texture2D       ColorBuffer  : register(t0);    // ͉摜.
+Texture2D       MaskBuffer   : register(t1);    // }XN摜.
+SamplerState    ColorSampler : register(s0);    // jATv[
+
+//-------------------------------------------------------------------------------------------------
+//      CGg[|Cgł.
+//-------------------------------------------------------------------------------------------------
+float4 main(const VSOutput input) : SV_TARGET0
+{
+    float3 result = 0;
+    float2 pos    = input.TexCoord - CENTER;
+
+    // Zuh̑ɃWX^ŗݐς, 1񂾂.
+    [loop]
+    for(uint i=0; i<GhostCount; ++i)
+    {
+        float2 uv    = pos * Ghosts[i].w + CENTER;
+        float4 color = ColorBuffer.SampleLevel(ColorSampler, uv, 0);
+        float  mask  = MaskBuffer .SampleLevel(ColorSampler, uv, 0).r;
+
+        result += color.rgb * Ghosts[i].rgb * mask;
+    }
+
+    return float4(saturate(result), 1.0f);
+}
\ No newline at end of file
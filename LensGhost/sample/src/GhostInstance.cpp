@@ -0,0 +1,99 @@
+﻿//---------------------------------------------------------------------------------------
+// File : GhostInstance.cpp
+// Desc : Lens Ghost Instance List.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "GhostInstance.h"
+#include <cstring>
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// GhostInstanceList class
+/////////////////////////////////////////////////////////////////////////////////////////
+
+const float GhostInstanceList::REPLICA_SPREAD = 0.25f;
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+GhostInstanceList::GhostInstanceList()
+: m_Instances   ()
+, m_Dirty       ( false )
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      デストラクタです.
+//---------------------------------------------------------------------------------------
+GhostInstanceList::~GhostInstanceList()
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      ゴーストのテーブルからインスタンスデータを構築します.
+//---------------------------------------------------------------------------------------
+bool GhostInstanceList::Build( const asdx::Vector4* pGhosts, u32 count, u32 replicaCount )
+{
+    if ( replicaCount == 0 )
+    { replicaCount = 1; }
+
+    std::vector<GhostInstance> instances;
+    if ( pGhosts != nullptr )
+    { instances.reserve( count * replicaCount ); }
+
+    auto weight = 1.0f / float(replicaCount);
+    for(u32 i=0; pGhosts != nullptr && i<count; ++i)
+    {
+        const auto& ghost = pGhosts[i];
+
+        // 寄与の無いゴーストは描画しても結果が変わらない.
+        if ( ghost.x <= 0.0f && ghost.y <= 0.0f && ghost.z <= 0.0f )
+        { continue; }
+
+        for(u32 j=0; j<replicaCount; ++j)
+        {
+            GhostInstance instance;
+            instance.Color[0] = ghost.x * weight;
+            instance.Color[1] = ghost.y * weight;
+            instance.Color[2] = ghost.z * weight;
+            instance.Scale    = ghost.w * ( 1.0f + REPLICA_SPREAD * float(j) * weight );
+            instances.push_back( instance );
+        }
+    }
+
+    // 同じ内容なら転送し直さない.
+    auto changed = ( instances.size() != m_Instances.size() )
+                || ( !instances.empty() && memcmp( instances.data(), m_Instances.data(), instances.size() * sizeof(GhostInstance) ) != 0 );
+    if ( !changed )
+    { return false; }
+
+    m_Instances.swap( instances );
+    m_Dirty = true;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      インスタンスデータを取得します.
+//---------------------------------------------------------------------------------------
+const GhostInstance* GhostInstanceList::GetData() const
+{ return m_Instances.data(); }
+
+//---------------------------------------------------------------------------------------
+//      インスタンス数を取得します.
+//---------------------------------------------------------------------------------------
+u32 GhostInstanceList::GetCount() const
+{ return u32( m_Instances.size() ); }
+
+//---------------------------------------------------------------------------------------
+//      前回の ClearDirty() 以降に内容が変化したかどうかチェックします.
+//---------------------------------------------------------------------------------------
+bool GhostInstanceList::IsDirty() const
+{ return m_Dirty; }
+
+//---------------------------------------------------------------------------------------
+//      変化したフラグを落とします.
+//---------------------------------------------------------------------------------------
+void GhostInstanceList::ClearDirty()
+{ m_Dirty = false; }
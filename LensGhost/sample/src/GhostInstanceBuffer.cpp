@@ -0,0 +1,143 @@
+﻿//---------------------------------------------------------------------------------------
+// File : GhostInstanceBuffer.cpp
+// Desc : Lens Ghost Instance Buffer for D3D11.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "GhostInstanceBuffer.h"
+#include <asdxLog.h>
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// GhostInstanceBuffer class
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+GhostInstanceBuffer::GhostInstanceBuffer()
+: m_pBuffer     ( nullptr )
+, m_pSRV        ( nullptr )
+, m_MaxCount    ( 0 )
+, m_Count       ( 0 )
+, m_UploadCount ( 0 )
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      デストラクタです.
+//---------------------------------------------------------------------------------------
+GhostInstanceBuffer::~GhostInstanceBuffer()
+{ Term(); }
+
+//---------------------------------------------------------------------------------------
+//      初期化処理を行います.
+//---------------------------------------------------------------------------------------
+bool GhostInstanceBuffer::Init( ID3D11Device* pDevice, u32 maxCount )
+{
+    if ( pDevice == nullptr || maxCount == 0 )
+    {
+        ELOG( "Error : Invalid Argument." );
+        return false;
+    }
+
+    Term();
+
+    // パラメータを変えたときだけ UpdateSubresource() で書き換えるので DEFAULT で生成する.
+    {
+        D3D11_BUFFER_DESC desc = {};
+        desc.ByteWidth           = UINT( sizeof(GhostInstance) * maxCount );
+        desc.Usage               = D3D11_USAGE_DEFAULT;
+        desc.BindFlags           = D3D11_BIND_SHADER_RESOURCE;
+        desc.MiscFlags           = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        desc.StructureByteStride = sizeof(GhostInstance);
+
+        auto hr = pDevice->CreateBuffer( &desc, nullptr, &m_pBuffer );
+        if ( FAILED( hr ) )
+        {
+            ELOG( "Error : ID3D11Device::CreateBuffer() Failed." );
+            return false;
+        }
+    }
+
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC desc = {};
+        desc.Format              = DXGI_FORMAT_UNKNOWN;
+        desc.ViewDimension       = D3D11_SRV_DIMENSION_BUFFER;
+        desc.Buffer.FirstElement = 0;
+        desc.Buffer.NumElements  = maxCount;
+
+        auto hr = pDevice->CreateShaderResourceView( m_pBuffer, &desc, &m_pSRV );
+        if ( FAILED( hr ) )
+        {
+            ELOG( "Error : ID3D11Device::CreateShaderResourceView() Failed." );
+            Term();
+            return false;
+        }
+    }
+
+    m_MaxCount = maxCount;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      終了処理を行います.
+//---------------------------------------------------------------------------------------
+void GhostInstanceBuffer::Term()
+{
+    ASDX_RELEASE( m_pSRV );
+    ASDX_RELEASE( m_pBuffer );
+
+    m_MaxCount    = 0;
+    m_Count       = 0;
+    m_UploadCount = 0;
+}
+
+//---------------------------------------------------------------------------------------
+//      インスタンスデータが変化していれば転送します.
+//---------------------------------------------------------------------------------------
+bool GhostInstanceBuffer::Update( ID3D11DeviceContext* pContext, GhostInstanceList& list )
+{
+    if ( pContext == nullptr || m_pBuffer == nullptr || !list.IsDirty() )
+    { return false; }
+
+    auto count = ( list.GetCount() < m_MaxCount ) ? list.GetCount() : m_MaxCount;
+    if ( count > 0 )
+    {
+        // 使う範囲だけを書き換える.
+        D3D11_BOX box = {};
+        box.left   = 0;
+        box.right  = UINT( sizeof(GhostInstance) * count );
+        box.top    = 0;
+        box.bottom = 1;
+        box.front  = 0;
+        box.back   = 1;
+
+        pContext->UpdateSubresource( m_pBuffer, 0, &box, list.GetData(), 0, 0 );
+    }
+
+    m_Count = count;
+    m_UploadCount++;
+    list.ClearDirty();
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      シェーダリソースビューを取得します.
+//---------------------------------------------------------------------------------------
+ID3D11ShaderResourceView* GhostInstanceBuffer::GetSRV() const
+{ return m_pSRV; }
+
+//---------------------------------------------------------------------------------------
+//      転送済みのインスタンス数を取得します.
+//---------------------------------------------------------------------------------------
+u32 GhostInstanceBuffer::GetCount() const
+{ return m_Count; }
+
+//---------------------------------------------------------------------------------------
+//      これまでに転送した回数を取得します.
+//---------------------------------------------------------------------------------------
+u32 GhostInstanceBuffer::GetUploadCount() const
+{ return m_UploadCount; }
@@ -0,0 +1,133 @@
+﻿//---------------------------------------------------------------------------------------
+// File : RenderTargetAllocator.cpp
+// Desc : Render Target Allocator for D3D11.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "RenderTargetAllocator.h"
+#include <asdxLog.h>
+
+
+namespace {
+
+//---------------------------------------------------------------------------------------
+//      1テクセルあたりのビット数を取得します.
+//---------------------------------------------------------------------------------------
+u32 GetBitsPerPixel( DXGI_FORMAT format )
+{
+    switch( format )
+    {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+        return 128;
+
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_UNORM:
+    case DXGI_FORMAT_R32G32_FLOAT:
+        return 64;
+
+    case DXGI_FORMAT_R16_FLOAT:
+        return 16;
+
+    case DXGI_FORMAT_R8_UNORM:
+        return 8;
+
+    default:
+        // R8G8B8A8, R10G10B10A2, R11G11B10 など.
+        return 32;
+    }
+}
+
+} // namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// RenderTargetAllocator class
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+RenderTargetAllocator::RenderTargetAllocator()
+: m_pDevice( nullptr )
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      デストラクタです.
+//---------------------------------------------------------------------------------------
+RenderTargetAllocator::~RenderTargetAllocator()
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      初期化処理を行います.
+//---------------------------------------------------------------------------------------
+bool RenderTargetAllocator::Init( ID3D11Device* pDevice )
+{
+    if ( pDevice == nullptr )
+    {
+        ELOG( "Error : Invalid Argument." );
+        return false;
+    }
+
+    m_pDevice = pDevice;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      asdx::RenderTarget2D を生成します.
+//---------------------------------------------------------------------------------------
+void* RenderTargetAllocator::Create( const RenderTargetDesc& desc )
+{
+    if ( m_pDevice == nullptr )
+    { return nullptr; }
+
+    asdx::RenderTarget2D::Description targetDesc;
+    targetDesc.Width                = desc.Width;
+    targetDesc.Height               = desc.Height;
+    targetDesc.MipLevels            = 1;
+    targetDesc.ArraySize            = 1;
+    targetDesc.Format               = DXGI_FORMAT( desc.Format );
+    targetDesc.SampleDesc.Count     = 1;
+    targetDesc.SampleDesc.Quality   = 0;
+
+    auto pTarget = new asdx::RenderTarget2D();
+    if ( !pTarget->Create( m_pDevice, targetDesc ) )
+    {
+        ELOG( "Error : RenderTarget2D::Create() Failed. size = %u x %u, format = %u", desc.Width, desc.Height, desc.Format );
+        delete pTarget;
+        return nullptr;
+    }
+
+    return pTarget;
+}
+
+//---------------------------------------------------------------------------------------
+//      Create() で生成した asdx::RenderTarget2D を破棄します.
+//---------------------------------------------------------------------------------------
+void RenderTargetAllocator::Dispose( void* pTarget )
+{
+    if ( pTarget == nullptr )
+    { return; }
+
+    auto pRenderTarget = static_cast<asdx::RenderTarget2D*>( pTarget );
+    pRenderTarget->Release();
+    delete pRenderTarget;
+}
+
+//---------------------------------------------------------------------------------------
+//      レンダーターゲットのバイトサイズを見積もります.
+//---------------------------------------------------------------------------------------
+u64 RenderTargetAllocator::GetSize( const RenderTargetDesc& desc ) const
+{ return u64( desc.Width ) * desc.Height * GetBitsPerPixel( DXGI_FORMAT( desc.Format ) ) / 8; }
+
+//---------------------------------------------------------------------------------------
+//      プールが割り当てたレンダーターゲットを取得します.
+//---------------------------------------------------------------------------------------
+asdx::RenderTarget2D* RenderTargetAllocator::GetTarget
+(
+    const RenderTargetPool&     pool,
+    RenderTargetPool::Handle    handle
+)
+{ return static_cast<asdx::RenderTarget2D*>( pool.GetTarget( handle ) ); }
@@ -11,6 +11,8 @@
 #include <asdxLog.h>
 #include <asdxShader.h>
 #include <asdxTimer.h>
+#include <cmath>
+#include <limits>
 
 
 namespace {
@@ -19,7 +21,69 @@ namespace {
 #include "../res/shader/Compiled/CopyPS.inc"
 #include "../res/shader/Compiled/CompositePS.inc"
 #include "../res/shader/Compiled/LensGhostPS.inc"
+#include "../res/shader/Compiled/LensGhostMultiPS.inc"
+#include "../res/shader/Compiled/LensGhostChainPS.inc"
+#include "../res/shader/Compiled/LensGhostInstancedVS.inc"
+#include "../res/shader/Compiled/LensGhostInstancedPS.inc"
 #include "../res/shader/Compiled/GaussBlurPS.inc"
+#include "../res/shader/Compiled/GaussBlurLinear7PS.inc"
+#include "../res/shader/Compiled/GaussBlurLinear9PS.inc"
+#include "../res/shader/Compiled/GaussBlurLinear15PS.inc"
+#include "../res/shader/Compiled/GaussBlurLinear31PS.inc"
+#include "../res/shader/Compiled/GaussBlurLinear63PS.inc"
+
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 MAX_GHOST_COUNT = 16;     //!< LensGhostMultiPS.hlsl で扱える最大ゴースト数です.
+static const u32 MAX_TERM_COUNT  = 64;     //!< LensGhostChainPS.hlsl で扱える最大項数です.
+static const float F_INF = std::numeric_limits<float>::infinity();     //!< 無限大です.
+
+// 1つのゴーストを分割するインスタンス数. 1段あたり 8 ～ 512 インスタンスになる.
+static const u32 GHOST_REPLICA_COUNTS[] = { 1, 8, 64 };
+static const u32 MAX_GHOST_INSTANCE_COUNT = 8 * 64;    //!< 1段あたりの最大インスタンス数です.
+
+static const u32 MAX_FETCH_COUNT = 33;     //!< GaussBlurLinear63PS.hlsl のフェッチ数です.
+
+// GaussBlurLinear*PS.hlsl のタップ数.
+static const u32 LINEAR_TAP_COUNTS[] = { 7, 9, 15, 31, 63 };
+
+static const float BLUR_DEVIATION = 5.0f;  //!< ガウスブラーの標準偏差です.
+
+// 2段分を展開した項を捨てる閾値. 0 より大きい値は項を捨てる分だけ2パスの結果からずれる近似です.
+static const float CHAIN_THRESHOLDS[] = { 0.0f, 0.5f, 0.75f };
+
+// 作業バッファのフォーマット. 浮動小数は1.0を超える高輝度部をゴーストまで保持する.
+static const DXGI_FORMAT WORK_BUFFER_FORMATS[] = {
+    DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+    DXGI_FORMAT_R16G16B16A16_FLOAT,
+};
+static const char* WORK_BUFFER_FORMAT_NAMES[] = { "R8G8B8A8_UNORM_SRGB", "R16G16B16A16_FLOAT" };
+
+// 乗算カラー / テクスチャスケール(1段目).
+const asdx::Vector4 GHOST_COLORS0[] = {
+    asdx::Vector4(1.0f,  0.5f,  0.6f, -1.2f),
+    asdx::Vector4(0.3f,  1.0f,  0.6f, -1.2f),
+    asdx::Vector4(0.6f,  0.35f, 1.0f, -1.5f),
+    asdx::Vector4(1.0f,  0.6f,  0.3f, -1.75f),
+    asdx::Vector4(0.25f, 1.0f,  0.7f, 1.2f),
+    asdx::Vector4(0.5f,  0.9f,  1.0f, 1.35f),
+    asdx::Vector4(0.3f,  1.0f,  0.5f, 1.5f),
+    asdx::Vector4(0.7f,  0.5f,  1.0f, 2.0f),
+};
+
+// 乗算カラー / テクスチャスケール(2段目).
+const asdx::Vector4 GHOST_COLORS1[] = {
+    asdx::Vector4(0.1f, 0.7f, 1.0f, 1.0f),
+    asdx::Vector4(1.0f, 0.3f, 0.6f, 2.5f),
+    asdx::Vector4(0.3f, 0.8f, 0.8f, 2.3f),
+    asdx::Vector4(0.8f, 0.2f, 0.7f, 3.95f),
+    asdx::Vector4(0.2f, 0.1f, 0.9f, -1.5f),
+    asdx::Vector4(0.9f, 0.1f, 0.2f, -1.7f),
+    asdx::Vector4(0.1f, 0.8f, 0.3f, -2.25f),
+    asdx::Vector4(0.9f, 0.2f, 0.1f, -3.35f),
+};
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -31,6 +95,52 @@ struct LensGhostParam
     asdx::Vector4   MultiplyColor;   //!< 乗算カラーです.
 };
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// LensGhostMultiParam structure
+//////////////////////////////////////////////////////////////////////////////////////////
+ASDX_ALIGN(16)
+struct LensGhostMultiParam
+{
+    u32             GhostCount;                     //!< ゴースト数です.
+    u32             Reserved[3];                    //!< 予約領域です.
+    asdx::Vector4   Ghosts[MAX_GHOST_COUNT];        //!< 乗算カラー(xyz)とテクスチャスケール(w)です.
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// LensGhostChainParam structure
+//////////////////////////////////////////////////////////////////////////////////////////
+ASDX_ALIGN(16)
+struct LensGhostChainParam
+{
+    u32             TermCount;                      //!< 項数です.
+    u32             SaturateInner;                  //!< 1段目の和を飽和させるかどうか(UNORMの作業バッファ)です.
+    asdx::Vector2   TexelHalf;                      //!< 1段目の描画先の半テクセルサイズです.
+    asdx::Vector4   Colors[MAX_TERM_COUNT];         //!< 1段目の乗算カラー(xyz)です.
+    asdx::Vector4   Scales[MAX_TERM_COUNT];         //!< 2段目のスケール(x)と1段目のスケール(y), 2段目のゴーストの最後の項かどうか(z)です.
+    asdx::Vector4   OuterColors[MAX_TERM_COUNT];    //!< 2段目の乗算カラー(xyz)です.
+    asdx::Vector4   Rects[MAX_TERM_COUNT];          //!< 項が寄与し得る画面上のテクスチャ座標の範囲(xy:最小, zw:最大)です.
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Interval structure
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Interval
+{
+    float   Min;        //!< 下限(含む)です.
+    float   Max;        //!< 上限(含む)です.
+
+    Interval()
+    : Min( F_INF ), Max( -F_INF )
+    { /* DO_NOTHING */ }
+
+    Interval( float min, float max )
+    : Min( min ), Max( max )
+    { /* DO_NOTHING */ }
+
+    bool IsEmpty() const
+    { return Min > Max; }
+};
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // GaussBlurParam structure
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -40,6 +150,28 @@ struct GaussBlurParam
     asdx::Vector4   Offset[15];    //!< オフセットです.
 };
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// GaussBlurLinearParam structure
+//////////////////////////////////////////////////////////////////////////////////////////
+ASDX_ALIGN(16)
+struct GaussBlurLinearParam
+{
+    asdx::Vector4   Offset[MAX_FETCH_COUNT];    //!< オフセット(xy)と重み(z)です.
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// BlurTableKey structure
+//////////////////////////////////////////////////////////////////////////////////////////
+struct BlurTableKey
+{
+    s32     Width;          //!< 入力画像の横幅です.
+    s32     Height;         //!< 入力画像の縦幅です.
+    float   DirX;           //!< ブラー方向のX成分です.
+    float   DirY;           //!< ブラー方向のY成分です.
+    float   Deviation;      //!< 標準偏差です.
+    u32     TapCount;       //!< リニアサンプリング版のタップ数です. 15タップのシェーダは0です.
+};
+
 //-------------------------------------------------------------------------------------------------
 //      ガウスの重みを計算します.
 //-------------------------------------------------------------------------------------------------
@@ -87,6 +219,328 @@ inline GaussBlurParam CalcBlurParam( int width, int height, asdx::Vector2 dir, f
     return result;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      リニアサンプリングのフェッチ数を取得します.
+//-------------------------------------------------------------------------------------------------
+inline u32 GetLinearFetchCount( u32 tapCount )
+{
+    auto radius = tapCount / 2;
+    return 1 + ( ( radius + 1 ) / 2 ) * 2;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      隣り合う2タップをリニアサンプリングの1フェッチにまとめたブラーパラメータを計算します.
+//-------------------------------------------------------------------------------------------------
+inline GaussBlurLinearParam CalcLinearBlurParam( int width, int height, asdx::Vector2 dir, float deviation, u32 tapCount )
+{
+    GaussBlurLinearParam result = {};
+    auto tu = 1.0f / float(width);
+    auto tv = 1.0f / float(height);
+
+    auto  radius = int(tapCount / 2);
+    float weights[MAX_FETCH_COUNT] = {};
+    auto  total_weight = 0.0f;
+    for(auto i=0; i<=radius; ++i)
+    {
+        weights[i] = GaussianDistribution( dir * float(i), deviation );
+        total_weight += ( i == 0 ) ? weights[i] : weights[i] * 2.0f;
+    }
+
+    result.Offset[0] = asdx::Vector4( 0.0f, 0.0f, weights[0] / total_weight, 0.0f );
+
+    // CalcBlurParam() と同じく，正方向を並べた後に負方向を並べる.
+    auto half = GetLinearFetchCount( tapCount ) / 2;
+    for(u32 j=0; j<half; ++j)
+    {
+        auto i   = int(j) * 2 + 1;
+        auto w0  = weights[i];
+        auto w1  = ( i + 1 <= radius ) ? weights[i + 1] : 0.0f;
+        auto sum = w0 + w1;
+
+        // 2タップの重み付きの位置をフェッチすれば，リニアサンプリングで同じ重みの和になる.
+        auto offset = float(i) + w1 / sum;
+        result.Offset[1 + j] = asdx::Vector4( dir.x * offset * tu, dir.y * offset * tv, sum / total_weight, 0.0f );
+        result.Offset[1 + j + half] = asdx::Vector4( -dir.x * offset * tu, -dir.y * offset * tv, sum / total_weight, 0.0f );
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      2つの区間の共通部分を求めます.
+//-------------------------------------------------------------------------------------------------
+inline Interval Intersect( const Interval& a, const Interval& b )
+{
+    return Interval(
+        ( a.Min > b.Min ) ? a.Min : b.Min,
+        ( a.Max < b.Max ) ? a.Max : b.Max );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      (t - 0.5) * scale + 0.5 が区間に入る t の範囲を求めます.
+//-------------------------------------------------------------------------------------------------
+inline Interval InverseScale( const Interval& range, float scale )
+{
+    if (range.IsEmpty())
+    { return Interval(); }
+
+    if (scale == 0.0f)
+    {
+        return ( range.Min <= 0.5f && 0.5f <= range.Max )
+            ? Interval( -F_INF, F_INF )
+            : Interval();
+    }
+
+    auto a = ( range.Min - 0.5f ) / scale + 0.5f;
+    auto b = ( range.Max - 0.5f ) / scale + 0.5f;
+    return ( scale > 0.0f ) ? Interval( a, b ) : Interval( b, a );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      クランプ後の値が区間に入る範囲を求めます.
+//-------------------------------------------------------------------------------------------------
+inline Interval InverseClamp( const Interval& range, float lo, float hi )
+{
+    auto result = Intersect( range, Interval( lo, hi ) );
+    if (result.IsEmpty())
+    { return result; }
+
+    // 端に届く場合はクランプで外側全体が同じ値になる.
+    if (result.Min <= lo) { result.Min = -F_INF; }
+    if (result.Max >= hi) { result.Max =  F_INF; }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      マスクが0でない値を返し得るテクスチャ座標の範囲を求めます.
+//-------------------------------------------------------------------------------------------------
+inline bool FindMaskSupport
+(
+    const u8*   pTexels,
+    u32         width,
+    u32         height,
+    u32         rowPitch,
+    u32         texelSize,
+    Interval&   u,
+    Interval&   v
+)
+{
+    auto x0 = width,  x1 = 0u;
+    auto y0 = height, y1 = 0u;
+    auto found = false;
+
+    for(u32 y=0; y<height; ++y)
+    {
+        auto pRow = pTexels + rowPitch * y;
+        for(u32 x=0; x<width; ++x)
+        {
+            if (pRow[x * texelSize] == 0)
+            { continue; }
+
+            if (x < x0) { x0 = x; }
+            if (x > x1) { x1 = x; }
+            if (y < y0) { y0 = y; }
+            if (y > y1) { y1 = y; }
+            found = true;
+        }
+    }
+
+    if (!found)
+    { return false; }
+
+    // リニアサンプリングで隣接テクセルの重みが0でなくなる範囲まで広げる.
+    // 端のテクセルが0でなければ，クランプにより外側全体が範囲になる.
+    u.Min = ( x0 == 0 )          ? -F_INF : ( float(x0) - 0.5f ) / float(width);
+    u.Max = ( x1 == width - 1 )  ?  F_INF : ( float(x1) + 1.5f ) / float(width);
+    v.Min = ( y0 == 0 )          ? -F_INF : ( float(y0) - 0.5f ) / float(height);
+    v.Max = ( y1 == height - 1 ) ?  F_INF : ( float(y1) + 1.5f ) / float(height);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      マスク画像をCPUに読み戻して，マスクが0でないテクスチャ座標の範囲を求めます.
+//-------------------------------------------------------------------------------------------------
+inline bool ReadMaskSupport
+(
+    ID3D11Device*           pDevice,
+    ID3D11DeviceContext*    pDeviceContext,
+    ID3D11Texture2D*        pTexture,
+    asdx::Vector4&          result
+)
+{
+    // 読み戻せないフォーマットの場合は全体を範囲とし，画面範囲による枝刈りを行わない.
+    result = asdx::Vector4( -F_INF, -F_INF, F_INF, F_INF );
+
+    D3D11_TEXTURE2D_DESC desc;
+    pTexture->GetDesc( &desc );
+
+    // シェーダが参照する R 成分の位置.
+    u32 offset    = 0;
+    u32 texelSize = 0;
+    switch( desc.Format )
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        { offset = 0; texelSize = 4; }
+        break;
+
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        { offset = 2; texelSize = 4; }
+        break;
+
+    case DXGI_FORMAT_R8_UNORM:
+        { offset = 0; texelSize = 1; }
+        break;
+
+    default:
+        return true;
+    }
+
+    desc.MipLevels      = 1;
+    desc.ArraySize      = 1;
+    desc.Usage          = D3D11_USAGE_STAGING;
+    desc.BindFlags      = 0;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    desc.MiscFlags      = 0;
+
+    ID3D11Texture2D* pStaging = nullptr;
+    auto hr = pDevice->CreateTexture2D( &desc, nullptr, &pStaging );
+    if ( FAILED( hr ) )
+    {
+        ELOG( "Error : ID3D11Device::CreateTexture2D() Failed." );
+        return false;
+    }
+
+    pDeviceContext->CopySubresourceRegion( pStaging, 0, 0, 0, 0, pTexture, 0, nullptr );
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    hr = pDeviceContext->Map( pStaging, 0, D3D11_MAP_READ, 0, &mapped );
+    if ( FAILED( hr ) )
+    {
+        ELOG( "Error : ID3D11DeviceContext::Map() Failed." );
+        ASDX_RELEASE( pStaging );
+        return false;
+    }
+
+    // マスクが全て0の場合は空の範囲になる.
+    Interval u;
+    Interval v;
+    if (!FindMaskSupport( static_cast<const u8*>( mapped.pData ) + offset, desc.Width, desc.Height, mapped.RowPitch, texelSize, u, v ))
+    {
+        u = Interval();
+        v = Interval();
+    }
+
+    pDeviceContext->Unmap( pStaging, 0 );
+    ASDX_RELEASE( pStaging );
+
+    result = asdx::Vector4( u.Min, v.Min, u.Max, v.Max );
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      項が寄与し得る画面上のテクスチャ座標の範囲を1軸分求めます.
+//-------------------------------------------------------------------------------------------------
+inline bool CalcScreenRange
+(
+    const Interval& support,
+    float           outerScale,
+    float           innerScale,
+    u32             size,
+    float&          minCoord,
+    float&          maxCoord
+)
+{
+    // 1段目の描画結果はクランプでサンプリングされるので，テクセル中心の範囲に収める.
+    auto texelHalf = 0.5f / float(size);
+    auto inner = InverseClamp( InverseScale( support, innerScale ), texelHalf, 1.0f - texelHalf );
+
+    // 2段目のマスクと1段目のマスクが共に0でない範囲.
+    auto range = Intersect( support, inner );
+
+    // 画面上の範囲に戻す.
+    auto screen = Intersect( InverseScale( range, outerScale ), Interval( 0.0f, 1.0f ) );
+    if (screen.IsEmpty())
+    { return false; }
+
+    // 丸め誤差を考慮して1ピクセル広げ，ピクセル境界に合わせる.
+    auto x0 = int(ceilf ( screen.Min * float(size) - 0.5f )) - 1;
+    auto x1 = int(floorf( screen.Max * float(size) - 0.5f )) + 1;
+    x0 = ( x0 < 0 ) ? 0 : x0;
+    x1 = ( x1 >= int(size) ) ? int(size) - 1 : x1;
+    if (x0 > x1)
+    { return false; }
+
+    // ピクセル中心が範囲に入るかどうかで判定できるように，ピクセルの端を返す.
+    minCoord = float(x0)     / float(size);
+    maxCoord = float(x1 + 1) / float(size);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      2段のゴーストを1段分の項のリストに展開します.
+//-------------------------------------------------------------------------------------------------
+inline u32 CompileGhostChain
+(
+    const asdx::Vector4*    pRound0,
+    u32                     count0,
+    const asdx::Vector4*    pRound1,
+    u32                     count1,
+    const asdx::Vector4&    support,
+    u32                     width,
+    u32                     height,
+    float                   threshold,
+    LensGhostChainParam&    result
+)
+{
+    Interval supportU( support.x, support.z );
+    Interval supportV( support.y, support.w );
+
+    // 2段目は1段目の結果を同じ規則でサンプリングするので，
+    // 座標は2段目の座標をクランプしてから1段目のスケールを掛けたものになる.
+    // 1段目の飽和を再現できるように，同じ2段目のゴーストから展開した項を続けて並べる.
+    u32 count = 0;
+    for(u32 j=0; j<count1; ++j)
+    {
+        auto first = count;
+
+        for(u32 i=0; i<count0; ++i)
+        {
+            auto r = pRound0[i].x * pRound1[j].x;
+            auto g = pRound0[i].y * pRound1[j].y;
+            auto b = pRound0[i].z * pRound1[j].z;
+
+            // 寄与が小さい項を捨てる.
+            auto weight = ( r > g ) ? r : g;
+            weight = ( weight > b ) ? weight : b;
+            if (weight <= 0.0f || weight < threshold || count >= MAX_TERM_COUNT)
+            { continue; }
+
+            // 画面外になる項を捨てる.
+            asdx::Vector4 rect;
+            if (supportU.IsEmpty() || supportV.IsEmpty()
+             || !CalcScreenRange( supportU, pRound1[j].w, pRound0[i].w, width,  rect.x, rect.z )
+             || !CalcScreenRange( supportV, pRound1[j].w, pRound0[i].w, height, rect.y, rect.w ))
+            { continue; }
+
+            result.Rects      [count] = rect;
+            result.Colors     [count] = asdx::Vector4( pRound0[i].x, pRound0[i].y, pRound0[i].z, 0.0f );
+            result.Scales     [count] = asdx::Vector4( pRound1[j].w, pRound0[i].w, 0.0f, 0.0f );
+            result.OuterColors[count] = asdx::Vector4( pRound1[j].x, pRound1[j].y, pRound1[j].z, 0.0f );
+            count++;
+        }
+
+        // 2段目のゴーストの最後の項で1段目の和に2段目を掛ける.
+        if (count > first)
+        { result.Scales[count - 1].z = 1.0f; }
+    }
+
+    result.TermCount = count;
+    return count;
+}
+
 } // namespace 
 
 
@@ -100,6 +554,7 @@ inline GaussBlurParam CalcBlurParam( int width, int height, asdx::Vector2 dir, f
 SampleApplication::SampleApplication()
 : Application   ( "Lens Ghost", 960, 540 )
 , m_Font        ()
+, m_MaskSupport ( 0.0f, 0.0f, 1.0f, 1.0f )
 {
 }
 
@@ -163,6 +618,42 @@ bool SampleApplication::OnInit()
     }
 
 
+    {
+        hr = m_pDevice->CreatePixelShader(LensGhostMultiPS, sizeof(LensGhostMultiPS), nullptr, &m_pLensGhostMultiPS);
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11CreatePixelShader() Failed." );
+            return false;
+        }
+    }
+
+    {
+        hr = m_pDevice->CreatePixelShader(LensGhostChainPS, sizeof(LensGhostChainPS), nullptr, &m_pLensGhostChainPS);
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11CreatePixelShader() Failed." );
+            return false;
+        }
+    }
+
+    {
+        hr = m_pDevice->CreateVertexShader(LensGhostInstancedVS, sizeof(LensGhostInstancedVS), nullptr, &m_pLensGhostInstancedVS);
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11Device::CreateVertexShader() Failed." );
+            return false;
+        }
+    }
+
+    {
+        hr = m_pDevice->CreatePixelShader(LensGhostInstancedPS, sizeof(LensGhostInstancedPS), nullptr, &m_pLensGhostInstancedPS);
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11CreatePixelShader() Failed." );
+            return false;
+        }
+    }
+
     {
         hr = m_pDevice->CreatePixelShader(GaussBlurPS, sizeof(GaussBlurPS), nullptr, &m_pGaussBlurPS);
         if ( FAILED(hr) )
@@ -172,6 +663,33 @@ bool SampleApplication::OnInit()
         }
     }
 
+    {
+        struct ShaderBinary
+        {
+            const BYTE* pCode;
+            size_t      Size;
+        };
+
+        const ShaderBinary binaries[] = {
+            { GaussBlurLinear7PS,  sizeof(GaussBlurLinear7PS)  },
+            { GaussBlurLinear9PS,  sizeof(GaussBlurLinear9PS)  },
+            { GaussBlurLinear15PS, sizeof(GaussBlurLinear15PS) },
+            { GaussBlurLinear31PS, sizeof(GaussBlurLinear31PS) },
+            { GaussBlurLinear63PS, sizeof(GaussBlurLinear63PS) },
+        };
+        static_assert( _countof(binaries) == _countof(LINEAR_TAP_COUNTS), "Shader Variant Count Not Matched." );
+
+        for(u32 i=0; i<_countof(binaries); ++i)
+        {
+            hr = m_pDevice->CreatePixelShader(binaries[i].pCode, binaries[i].Size, nullptr, &m_pGaussBlurLinearPS[i]);
+            if ( FAILED(hr) )
+            {
+                ELOG( "Error : ID3D11CreatePixelShader() Failed." );
+                return false;
+            }
+        }
+    }
+
     {
         if (!m_InputTexture.CreateFromFile( m_pDevice, "../res/texture/input.map"))
         {
@@ -186,6 +704,13 @@ bool SampleApplication::OnInit()
             ELOG( "Error : Texture::CreateFromFile() Failed." );
             return false;
         }
+
+        // 2段分を展開した項の画面範囲を求めるため，マスクが0でない範囲を1度だけ読み戻す.
+        if (!ReadMaskSupport( m_pDevice, m_pDeviceContext, m_MaskTexture.GetTexture(), m_MaskSupport ))
+        {
+            ELOG( "Error : ReadMaskSupport() Failed." );
+            return false;
+        }
     
     }
 
@@ -306,50 +831,133 @@ bool SampleApplication::OnInit()
    }
 
    {
-       if ( !m_GaussBlurBuffer.Create(m_pDevice, sizeof(GaussBlurParam)) )
+      if ( !m_LensGhostMultiBuffer.Create(m_pDevice, sizeof(LensGhostMultiParam)))
+      { return false; }
+   }
+
+   {
+      if ( !m_LensGhostChainBuffer.Create(m_pDevice, sizeof(LensGhostChainParam)))
+      { return false; }
+   }
+
+   {
+      for(u32 i=0; i<_countof(m_GhostInstanceBuffer); ++i)
+      {
+          if ( !m_GhostInstanceBuffer[i].Init(m_pDevice, MAX_GHOST_INSTANCE_COUNT) )
+          { return false; }
+      }
+
+      BuildGhostInstances();
+   }
+
+   {
+       if ( !BuildParamTables() )
        { return false; }
    }
 
    {
-       asdx::RenderTarget2D::Description desc;
-       desc.Width               = m_Width;
-       desc.Height              = m_Height;
-       desc.MipLevels           = 1;
-       desc.ArraySize           = 1;
-       desc.Format              = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
-       desc.SampleDesc.Count    = 1;
-       desc.SampleDesc.Quality  = 0;
-
-       for(auto i=0; i<2; i++)
-       {
-           if (!m_WorkBuffer[i].Create(m_pDevice, desc))
-           { return false; }
-       }
+       if ( !m_TargetAllocator.Init( m_pDevice ) )
+       { return false; }
 
-       desc.Width  = m_Width  / 4;
-       desc.Height = m_Height / 4;
-       for(auto i=2; i<4; i++)
-       {
-           if (!m_WorkBuffer[i].Create(m_pDevice, desc))
-           { return false; }
-       }
+       if ( !m_TargetPool.Init( &m_TargetAllocator ) )
+       { return false; }
+
+       if ( !CreateWorkBuffers() )
+       { return false; }
    }
 
     return true;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      選択中の描画方法とフォーマットで作業バッファを生成します.
+//-------------------------------------------------------------------------------------------------
+bool SampleApplication::CreateWorkBuffers()
+{
+    RenderTargetDesc full;
+    full.Width  = m_Width;
+    full.Height = m_Height;
+    full.Format = WORK_BUFFER_FORMATS[m_WorkFormatIndex];
+
+    RenderTargetDesc quarter = full;
+    quarter.Width  = m_Width  / 4;
+    quarter.Height = m_Height / 4;
+
+    // パスの番号は 0 : 横ブラー, 1 : 縦ブラー, 2 : 1段目のゴースト, 3 : 2段目のゴースト, 4 : コンポジット.
+    // 2段分を展開する場合は1段目のゴーストを描かないので WorkBuffer[0] を宣言しない.
+    // 各パスは直前のパスの結果を読みながら書き込むので区間が必ず重なり，実体は共有されない.
+    // プールは描画方法やフォーマットを切り替えた際の生成と破棄だけを受け持つ.
+    auto chain = ( m_GhostMode == GHOST_MODE_CHAIN );
+
+    m_TargetPool.Begin();
+    m_WorkTarget[2] = m_TargetPool.Request( quarter, 0, 1 );
+    m_WorkTarget[3] = m_TargetPool.Request( quarter, 1, ( chain ) ? 3 : 2 );
+    m_WorkTarget[0] = ( chain ) ? RenderTargetPool::INVALID_HANDLE : m_TargetPool.Request( full, 2, 3 );
+    m_WorkTarget[1] = m_TargetPool.Request( full, 3, 4 );
+
+    if ( !m_TargetPool.Compile() )
+    {
+        ELOG( "Error : RenderTargetPool::Compile() Failed. format = %s", WORK_BUFFER_FORMAT_NAMES[m_WorkFormatIndex] );
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ブラーのパラメータテーブルを生成します.
+//-------------------------------------------------------------------------------------------------
+bool SampleApplication::BuildParamTables()
+{
+    // 縦横と選択できる全てのタップ数のテーブルを作る. 以降のフレームでは定数バッファを設定するだけになる.
+    for(auto dir=0; dir<2; ++dir)
+    {
+        BlurTableKey key = {};
+        key.Width     = m_Width;
+        key.Height    = m_Height;
+        key.DirX      = ( dir == 0 ) ? 1.0f : 0.0f;
+        key.DirY      = ( dir == 0 ) ? 0.0f : 1.0f;
+        key.Deviation = BLUR_DEVIATION;
+        key.TapCount  = 0;
+
+        m_BlurTable[dir] = m_ParamTable.Acquire<GaussBlurParam>( m_pDevice, key, [&]()
+        { return CalcBlurParam( key.Width, key.Height, asdx::Vector2( key.DirX, key.DirY ), key.Deviation ); });
+
+        if ( m_BlurTable[dir] == ParamTableCache::INVALID_HANDLE )
+        { return false; }
+
+        // リニアサンプリング版は15タップで従来と同じになるよう，タップ数に比例して標準偏差を広げる.
+        for(u32 i=0; i<_countof(LINEAR_TAP_COUNTS); ++i)
+        {
+            key.TapCount  = LINEAR_TAP_COUNTS[i];
+            key.Deviation = BLUR_DEVIATION * float(key.TapCount - 1) / 14.0f;
+
+            m_LinearBlurTable[i][dir] = m_ParamTable.Acquire<GaussBlurLinearParam>( m_pDevice, key, [&]()
+            { return CalcLinearBlurParam( key.Width, key.Height, asdx::Vector2( key.DirX, key.DirY ), key.Deviation, key.TapCount ); });
+
+            if ( m_LinearBlurTable[i][dir] == ParamTableCache::INVALID_HANDLE )
+            { return false; }
+        }
+    }
+
+    return true;
+}
+
 //-------------------------------------------------------------------------------------------------
 //      終了時の処理です.
 //-------------------------------------------------------------------------------------------------
 void SampleApplication::OnTerm()
 {
-    for(auto i=0; i<2; i++)
-    { m_WorkBuffer[i].Release(); }
+    m_TargetPool.Term();
     m_Font.Term();
     m_InputTexture.Release();
     m_MaskTexture.Release();
     m_LensGhostBuffer.Release();
-    m_GaussBlurBuffer.Release();
+    m_LensGhostMultiBuffer.Release();
+    m_LensGhostChainBuffer.Release();
+    for(u32 i=0; i<_countof(m_GhostInstanceBuffer); ++i)
+    { m_GhostInstanceBuffer[i].Term(); }
+    m_ParamTable.Term();
     m_Quad.Term();
     ASDX_RELEASE( m_pOpequeBS );
     ASDX_RELEASE( m_pAdditiveBS );
@@ -357,10 +965,16 @@ void SampleApplication::OnTerm()
     ASDX_RELEASE( m_pLinearClamp );
     ASDX_RELEASE( m_pLinearWrap );
     ASDX_RELEASE( m_pLensGhostPS );
+    ASDX_RELEASE( m_pLensGhostMultiPS );
+    ASDX_RELEASE( m_pLensGhostChainPS );
+    ASDX_RELEASE( m_pLensGhostInstancedVS );
+    ASDX_RELEASE( m_pLensGhostInstancedPS );
     ASDX_RELEASE( m_pCopyPS );
     ASDX_RELEASE( m_pCompositePS );
     ASDX_RELEASE( m_pFullScreenVS );
     ASDX_RELEASE( m_pGaussBlurPS );
+    for(u32 i=0; i<_countof(m_pGaussBlurLinearPS); ++i)
+    { ASDX_RELEASE( m_pGaussBlurLinearPS[i] ); }
 }
 
 //---------------------------------------------------------------------------------------
@@ -379,10 +993,133 @@ void SampleApplication::OnDrawText()
     m_Font.Begin( m_pDeviceContext );
     {
         m_Font.DrawStringArg( 10, 10, "FPS : %.2f", GetFPS() );
+        static const char* modeNames[] = { "Multi Pass", "Fused", "Chain", "Instanced" };
+        m_Font.DrawStringArg( 10, 30, "Ghost : %s ([F] Key)", modeNames[m_GhostMode] );
+
+        if (m_LinearBlur)
+        {
+            auto tapCount = LINEAR_TAP_COUNTS[m_BlurTapIndex];
+            m_Font.DrawStringArg( 10, 50, "Blur : Linear %u Taps, %u Fetches ([L] [B] Key)",
+                tapCount, GetLinearFetchCount( tapCount ) );
+        }
+        else
+        { m_Font.DrawStringArg( 10, 50, "Blur : 15 Taps, 15 Fetches ([L] Key)" ); }
+
+        if (m_GhostMode == GHOST_MODE_CHAIN)
+        {
+            // 閾値が0より大きい場合は項を捨てるので2パスの結果と一致しない.
+            auto threshold = CHAIN_THRESHOLDS[m_ChainThresholdIndex];
+            m_Font.DrawStringArg( 10, 70, "Threshold : %.2f ([T] Key), Terms : %u%s",
+                threshold, m_ChainTermCount, ( threshold > 0.0f ) ? " (Approximate)" : "" );
+        }
+        else if (m_GhostMode == GHOST_MODE_INSTANCED)
+        {
+            m_Font.DrawStringArg( 10, 70, "Instances : %u + %u ([I] Key), Uploads : %u",
+                m_GhostInstanceBuffer[0].GetCount(), m_GhostInstanceBuffer[1].GetCount(),
+                m_GhostInstanceBuffer[0].GetUploadCount() + m_GhostInstanceBuffer[1].GetUploadCount() );
+        }
+
+        m_Font.DrawStringArg( 10, 90, "Format : %s ([H] Key)", WORK_BUFFER_FORMAT_NAMES[m_WorkFormatIndex] );
+        m_Font.DrawStringArg( 10, 110, "Targets : %u -> %u (%.1f MB -> %.1f MB)",
+            m_TargetPool.GetVirtualCount(), m_TargetPool.GetPhysicalCount(),
+            m_TargetPool.GetRequestedSize() / ( 1024.0 * 1024.0 ),
+            m_TargetPool.GetAllocatedSize() / ( 1024.0 * 1024.0 ) );
     }
     m_Font.End( m_pDeviceContext );
 }
 
+//---------------------------------------------------------------------------------------
+//      全ゴーストを1パスで描画します.
+//---------------------------------------------------------------------------------------
+void SampleApplication::DrawGhostsFused( const asdx::Vector4* pColors, u32 count )
+{
+    LensGhostMultiParam param = {};
+    param.GhostCount = ( count < MAX_GHOST_COUNT ) ? count : MAX_GHOST_COUNT;
+    for(u32 i=0; i<param.GhostCount; ++i)
+    { param.Ghosts[i] = pColors[i]; }
+
+    auto pCB = m_LensGhostMultiBuffer.GetBuffer();
+
+    // 定数バッファ更新.
+    m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &param, 0, 0 );
+
+    // 定数バッファ設定.
+    m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+
+    // 矩形描画.
+    m_Quad.Draw(m_pDeviceContext);
+}
+
+//---------------------------------------------------------------------------------------
+//      2段分のゴーストをブラー済み画像から1パスで描画します.
+//---------------------------------------------------------------------------------------
+void SampleApplication::DrawGhostChain( float threshold )
+{
+    LensGhostChainParam param = {};
+    param.TexelHalf = asdx::Vector2( 0.5f / float(m_Width), 0.5f / float(m_Height) );
+
+    // 2パスの場合 WorkBuffer[0] への加算合成はUNORMでのみ飽和する.
+    param.SaturateInner = ( WORK_BUFFER_FORMATS[m_WorkFormatIndex] == DXGI_FORMAT_R16G16B16A16_FLOAT ) ? 0 : 1;
+
+    m_ChainTermCount = CompileGhostChain(
+        GHOST_COLORS0, _countof(GHOST_COLORS0),
+        GHOST_COLORS1, _countof(GHOST_COLORS1),
+        m_MaskSupport, m_Width, m_Height,
+        threshold, param );
+
+    auto pCB = m_LensGhostChainBuffer.GetBuffer();
+
+    // 定数バッファ更新.
+    m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &param, 0, 0 );
+
+    // 定数バッファ設定.
+    m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+
+    // 矩形描画.
+    m_Quad.Draw(m_pDeviceContext);
+}
+
+//---------------------------------------------------------------------------------------
+//      ゴーストのインスタンスデータを構築します.
+//---------------------------------------------------------------------------------------
+void SampleApplication::BuildGhostInstances()
+{
+    // 転送は変化したときに DrawGhostsInstanced() で1度だけ行う.
+    auto replicaCount = GHOST_REPLICA_COUNTS[m_GhostReplicaIndex];
+    m_GhostInstanceList[0].Build( GHOST_COLORS0, _countof(GHOST_COLORS0), replicaCount );
+    m_GhostInstanceList[1].Build( GHOST_COLORS1, _countof(GHOST_COLORS1), replicaCount );
+}
+
+//---------------------------------------------------------------------------------------
+//      1段分のゴーストを1回のインスタンス描画で加算合成します.
+//---------------------------------------------------------------------------------------
+void SampleApplication::DrawGhostsInstanced( u32 round )
+{
+    auto& buffer = m_GhostInstanceBuffer[round];
+
+    // パラメータを変えたときだけ転送する.
+    buffer.Update( m_pDeviceContext, m_GhostInstanceList[round] );
+
+    auto pSRV = buffer.GetSRV();
+    m_pDeviceContext->VSSetShader( m_pLensGhostInstancedVS, nullptr, 0 );
+    m_pDeviceContext->VSSetShaderResources( 0, 1, &pSRV );
+    m_pDeviceContext->PSSetShader( m_pLensGhostInstancedPS, nullptr, 0 );
+
+    // 三角形は頂点シェーダで生成するので，頂点バッファと入力レイアウトは使わない.
+    D3D11_PRIMITIVE_TOPOLOGY topology;
+    m_pDeviceContext->IAGetPrimitiveTopology( &topology );
+    m_pDeviceContext->IASetInputLayout( nullptr );
+    m_pDeviceContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+
+    // 矩形描画.
+    m_pDeviceContext->DrawInstanced( 3, buffer.GetCount(), 0, 0 );
+
+    // m_Quad の描画に影響しないよう元に戻す.
+    ID3D11ShaderResourceView* pNullSRV = nullptr;
+    m_pDeviceContext->VSSetShaderResources( 0, 1, &pNullSRV );
+    m_pDeviceContext->IASetPrimitiveTopology( topology );
+}
+
 //---------------------------------------------------------------------------------------
 //      描画時の処理です.
 //---------------------------------------------------------------------------------------
@@ -394,6 +1131,11 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
     ID3D11ShaderResourceView*   pSrc = nullptr;
     ID3D11RenderTargetView*     pDst = nullptr;
 
+    // プールが割り当てた作業バッファ. 2段分を展開する場合 WorkBuffer[0] は nullptr になる.
+    asdx::RenderTarget2D* pWorkBuffer[4];
+    for(auto i=0; i<4; ++i)
+    { pWorkBuffer[i] = RenderTargetAllocator::GetTarget( m_TargetPool, m_WorkTarget[i] ); }
+
     auto pMask = m_MaskTexture.GetSRV();
 
     ID3D11ShaderResourceView* nullSRVs[2] = { nullptr, nullptr };
@@ -401,11 +1143,16 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
     UINT  sampleMask     = D3D11_DEFAULT_SAMPLE_MASK;
     float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
     float clearColor[4]  = { 0.0f, 0.0f, 0.0f, 1.0f };
-    auto deviation = 5.0f;
+
+    // 1枚ずつ描画する方法は描画先に加算合成する.
+    auto additive = (m_GhostMode == GHOST_MODE_MULTI_PASS) || (m_GhostMode == GHOST_MODE_INSTANCED);
+
+    auto pBlurPS    = (m_LinearBlur) ? m_pGaussBlurLinearPS[m_BlurTapIndex] : m_pGaussBlurPS;
+    auto pBlurTable = (m_LinearBlur) ? m_LinearBlurTable[m_BlurTapIndex] : m_BlurTable;
 
     // 入力画像にガウスブラーを掛ける,
     {
-        pDst = m_WorkBuffer[2].GetRTV();
+        pDst = pWorkBuffer[2]->GetRTV();
         pSrc = m_InputTexture.GetSRV();
 
         // クリア処理.
@@ -424,7 +1171,7 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
         m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
         m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
         m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->PSSetShader( m_pGaussBlurPS, nullptr, 0 );
+        m_pDeviceContext->PSSetShader( pBlurPS, nullptr, 0 );
 
         // シェーダリソースビューを設定.
         m_pDeviceContext->PSSetShaderResources( 0, 1, &pSrc );
@@ -441,16 +1188,14 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
 
         m_pDeviceContext->RSSetViewports( 1, &viewport );
 
-        auto pCB = m_GaussBlurBuffer.GetBuffer();
-        GaussBlurParam src = CalcBlurParam(w, h, asdx::Vector2(1.0f, 0.0f), deviation);
-        m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &src, 0, 0 );
-        m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+        auto pBlurCB = m_ParamTable.GetBuffer( pBlurTable[0] );
+        m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pBlurCB );
 
         // 描画.
         m_Quad.Draw(m_pDeviceContext);
  
-        pSrc = m_WorkBuffer[2].GetSRV();
-        pDst = m_WorkBuffer[3].GetRTV();
+        pSrc = pWorkBuffer[2]->GetSRV();
+        pDst = pWorkBuffer[3]->GetRTV();
 
        // クリア処理.
         m_pDeviceContext->ClearRenderTargetView( pDst, m_ClearColor );
@@ -462,9 +1207,8 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
         m_pDeviceContext->PSSetShaderResources( 0, 1, &pSrc );
         m_pDeviceContext->PSSetSamplers( 0, 1, &m_pLinearClamp );
 
-        src = CalcBlurParam(w, h, asdx::Vector2(0.0f, 1.0f), deviation);
-        m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &src, 0, 0 );
-        m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+        pBlurCB = m_ParamTable.GetBuffer( pBlurTable[1] );
+        m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pBlurCB );
 
         // ステートを設定.
         m_pDeviceContext->RSSetState( m_pRasterizerState );
@@ -480,30 +1224,23 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
     }
 
     // ゴーストを生成
+    // 2段分を展開する場合は WorkBuffer[0] を経由しない.
+    if (m_GhostMode != GHOST_MODE_CHAIN)
     {
-        // 乗算カラー / テクスチャスケール.
-        asdx::Vector4 colors[] = {
-            asdx::Vector4(1.0f,  0.5f,  0.6f, -1.2f),
-            asdx::Vector4(0.3f,  1.0f,  0.6f, -1.2f),
-            asdx::Vector4(0.6f,  0.35f, 1.0f, -1.5f),
-            asdx::Vector4(1.0f,  0.6f,  0.3f, -1.75f),
-            asdx::Vector4(0.25f, 1.0f,  0.7f, 1.2f),
-            asdx::Vector4(0.5f,  0.9f,  1.0f, 1.35f),
-            asdx::Vector4(0.3f,  1.0f,  0.5f, 1.5f),
-            asdx::Vector4(0.7f,  0.5f,  1.0f, 2.0f),
-        };
+        auto& colors = GHOST_COLORS0;
 
-        pSrc = m_WorkBuffer[3].GetSRV();
-        pDst = m_WorkBuffer[0].GetRTV();
+        pSrc = pWorkBuffer[3]->GetSRV();
+        pDst = pWorkBuffer[0]->GetRTV();
 
         auto pCB = m_LensGhostBuffer.GetBuffer();
 
         // レンダーターゲット設定.
-        m_pDeviceContext->ClearRenderTargetView( pDst, clearColor );
+        if (additive)
+        { m_pDeviceContext->ClearRenderTargetView( pDst, clearColor ); }
         m_pDeviceContext->OMSetRenderTargets( 1, &pDst, nullptr );
 
         // ブレンドステート設定.
-        m_pDeviceContext->OMSetBlendState( m_pAdditiveBS, blendFactor, sampleMask );
+        m_pDeviceContext->OMSetBlendState( (additive) ? m_pAdditiveBS : m_pOpequeBS, blendFactor, sampleMask );
 
         D3D11_VIEWPORT viewport;
         viewport.TopLeftX   = 0;
@@ -520,26 +1257,39 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
         m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
         m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
         m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->PSSetShader( m_pLensGhostPS, nullptr, 0 );
+        m_pDeviceContext->PSSetShader( (m_GhostMode == GHOST_MODE_FUSED) ? m_pLensGhostMultiPS : m_pLensGhostPS, nullptr, 0 );
  
         m_pDeviceContext->PSSetShaderResources( 0, 1, &pSrc );
         m_pDeviceContext->PSSetShaderResources( 1, 1, &pMask );
         m_pDeviceContext->PSSetSamplers( 0, 1, &m_pLinearClamp );
 
-        // ゴーストを描画.
-        for(auto i=0; i<8;++i)
+        if (m_GhostMode == GHOST_MODE_FUSED)
+        {
+            // 全ゴーストを1パスで描画.
+            DrawGhostsFused( colors, _countof(colors) );
+        }
+        else if (m_GhostMode == GHOST_MODE_INSTANCED)
         {
-            LensGhostParam param;
-            param.MultiplyColor = colors[i];
+            // 全ゴーストを1回で描画.
+            DrawGhostsInstanced( 0 );
+        }
+        else
+        {
+            // ゴーストを描画.
+            for(auto i=0; i<8;++i)
+            {
+                LensGhostParam param;
+                param.MultiplyColor = colors[i];
 
-            // 定数バッファ更新.
-            m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &param, 0, 0 );
+                // 定数バッファ更新.
+                m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &param, 0, 0 );
 
-            // 定数バッファ設定.
-            m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+                // 定数バッファ設定.
+                m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
 
-            // 矩形描画.
-            m_Quad.Draw(m_pDeviceContext);
+                // 矩形描画.
+                m_Quad.Draw(m_pDeviceContext);
+            }
         }
 
         // リソースを解除.
@@ -548,56 +1298,82 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
 
     // WorkBuffer[0]を元にゴーストを生成.
     {
-        // 乗算カラー / テクスチャスケール.
-        asdx::Vector4 colors[] = {
-            asdx::Vector4(0.1f, 0.7f, 1.0f, 1.0f),
-            asdx::Vector4(1.0f, 0.3f, 0.6f, 2.5f),
-            asdx::Vector4(0.3f, 0.8f, 0.8f, 2.3f),
-            asdx::Vector4(0.8f, 0.2f, 0.7f, 3.95f),
-            asdx::Vector4(0.2f, 0.1f, 0.9f, -1.5f),
-            asdx::Vector4(0.9f, 0.1f, 0.2f, -1.7f),
-            asdx::Vector4(0.1f, 0.8f, 0.3f, -2.25f),
-            asdx::Vector4(0.9f, 0.2f, 0.1f, -3.35f),
-        };
+        auto& colors = GHOST_COLORS1;
 
 
-        pSrc = m_WorkBuffer[0].GetSRV();
-        pDst = m_WorkBuffer[1].GetRTV();
+        pSrc = (m_GhostMode == GHOST_MODE_CHAIN) ? pWorkBuffer[3]->GetSRV() : pWorkBuffer[0]->GetSRV();
+        pDst = pWorkBuffer[1]->GetRTV();
 
         auto pCB = m_LensGhostBuffer.GetBuffer();
  
         // レンダーターゲット生成.
-        m_pDeviceContext->ClearRenderTargetView( pDst, clearColor );
+        if (additive)
+        { m_pDeviceContext->ClearRenderTargetView( pDst, clearColor ); }
         m_pDeviceContext->OMSetRenderTargets( 1, &pDst, nullptr );
 
         // ブレンドステート設定.
-        m_pDeviceContext->OMSetBlendState( m_pAdditiveBS, blendFactor, sampleMask );
+        m_pDeviceContext->OMSetBlendState( (additive) ? m_pAdditiveBS : m_pOpequeBS, blendFactor, sampleMask );
+
+        D3D11_VIEWPORT viewport;
+        viewport.TopLeftX   = 0;
+        viewport.TopLeftY   = 0;
+        viewport.Width      = float(w);
+        viewport.Height     = float(h);
+        viewport.MinDepth   = 0.0f;
+        viewport.MaxDepth   = 1.0f;
+
+        m_pDeviceContext->RSSetViewports( 1, &viewport );
+
+        ID3D11PixelShader* pShaders[NUM_GHOST_MODE] = {
+            m_pLensGhostPS,
+            m_pLensGhostMultiPS,
+            m_pLensGhostChainPS,
+            m_pLensGhostInstancedPS,
+        };
 
         // シェーダの設定.
         m_pDeviceContext->VSSetShader( m_pFullScreenVS, nullptr, 0 );
         m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
         m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
         m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->PSSetShader( m_pLensGhostPS, nullptr, 0 );
+        m_pDeviceContext->PSSetShader( pShaders[m_GhostMode], nullptr, 0 );
 
         m_pDeviceContext->PSSetShaderResources( 0, 1, &pSrc );
         m_pDeviceContext->PSSetShaderResources( 1, 1, &pMask );
         m_pDeviceContext->PSSetSamplers( 0, 1, &m_pLinearClamp );
 
-        // 8個描画.
-        for(auto i=0; i<8; ++i)
+        if (m_GhostMode == GHOST_MODE_CHAIN)
         {
-            LensGhostParam param;
-            param.MultiplyColor = colors[i];
+            // 2段分のゴーストを1パスで描画.
+            DrawGhostChain( CHAIN_THRESHOLDS[m_ChainThresholdIndex] );
+        }
+        else if (m_GhostMode == GHOST_MODE_FUSED)
+        {
+            // 全ゴーストを1パスで描画.
+            DrawGhostsFused( colors, _countof(colors) );
+        }
+        else if (m_GhostMode == GHOST_MODE_INSTANCED)
+        {
+            // 全ゴーストを1回で描画.
+            DrawGhostsInstanced( 1 );
+        }
+        else
+        {
+            // 8個描画.
+            for(auto i=0; i<8; ++i)
+            {
+                LensGhostParam param;
+                param.MultiplyColor = colors[i];
 
-            // 定数バッファ更新.
-            m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &param, 0, 0 );
+                // 定数バッファ更新.
+                m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &param, 0, 0 );
 
-            // 定数バッファ設定.
-            m_pDeviceContext->PSGetConstantBuffers( 0, 1, &pCB );
+                // 定数バッファ設定.
+                m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
 
-           // 矩形描画.
-            m_Quad.Draw(m_pDeviceContext);
+               // 矩形描画.
+                m_Quad.Draw(m_pDeviceContext);
+            }
         }
 
         // リソースを解除.
@@ -640,7 +1416,7 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
         // シェーダリソースビューを設定.
         ID3D11ShaderResourceView* pSRV[] = {
             m_InputTexture.GetSRV(),
-            m_WorkBuffer[1].GetSRV(),
+            pWorkBuffer[1]->GetSRV(),
         };
         m_pDeviceContext->PSSetShaderResources( 0, 2, pSRV );
         m_pDeviceContext->PSSetSamplers( 0, 1, &m_pLinearClamp );
@@ -672,6 +1448,42 @@ void SampleApplication::OnResize( const asdx::ResizeEventParam& param )
 //---------------------------------------------------------------------------------------
 void SampleApplication::OnKey( const asdx::KeyEventParam& param )
 {
+    if ( !param.IsKeyDown )
+    { return; }
+
+    if ( param.KeyCode == 'F' )
+    {
+        // 描画方法によって使う作業バッファが変わるので作り直す.
+        m_GhostMode = GHOST_MODE( ( m_GhostMode + 1 ) % NUM_GHOST_MODE );
+        CreateWorkBuffers();
+    }
+
+    if ( param.KeyCode == 'T' )
+    { m_ChainThresholdIndex = ( m_ChainThresholdIndex + 1 ) % _countof(CHAIN_THRESHOLDS); }
+
+    if ( param.KeyCode == 'L' )
+    { m_LinearBlur = !m_LinearBlur; }
+
+    if ( param.KeyCode == 'I' )
+    {
+        m_GhostReplicaIndex = ( m_GhostReplicaIndex + 1 ) % _countof(GHOST_REPLICA_COUNTS);
+        BuildGhostInstances();
+    }
+
+    if ( param.KeyCode == 'B' )
+    { m_BlurTapIndex = ( m_BlurTapIndex + 1 ) % _countof(LINEAR_TAP_COUNTS); }
+
+    if ( param.KeyCode == 'H' )
+    {
+        // 生成できないフォーマットの場合は元に戻す.
+        auto prev = m_WorkFormatIndex;
+        m_WorkFormatIndex = ( m_WorkFormatIndex + 1 ) % _countof(WORK_BUFFER_FORMATS);
+        if ( !CreateWorkBuffers() )
+        {
+            m_WorkFormatIndex = prev;
+            CreateWorkBuffers();
+        }
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -0,0 +1,256 @@
+﻿//---------------------------------------------------------------------------------------
+// File : GhostInstanceTest.cpp
+// Desc : Lens Ghost Instance List Test.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "GhostInstance.h"
+#include <cstdio>
+#include <cstddef>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+//---------------------------------------------------------------------------------------
+// Macros
+//---------------------------------------------------------------------------------------
+#define CHECK( expr )                                                           \
+    do {                                                                        \
+        if ( !( expr ) )                                                        \
+        {                                                                       \
+            fprintf( stderr, "Error : %s(%d) : %s\n", __FILE__, __LINE__, #expr );  \
+            g_FailCount++;                                                      \
+        }                                                                       \
+    } while( 0 )
+
+
+//---------------------------------------------------------------------------------------
+// Global Variables
+//---------------------------------------------------------------------------------------
+int g_FailCount = 0;
+
+const asdx::Vector4 GHOSTS[] = {
+    asdx::Vector4( 1.0f, 0.5f, 0.6f, -1.2f ),
+    asdx::Vector4( 0.0f, 0.0f, 0.0f,  2.0f ),   // 寄与が無い.
+    asdx::Vector4( 0.3f, 1.0f, 0.5f,  1.5f ),
+};
+const u32 GHOST_COUNT = sizeof(GHOSTS) / sizeof(GHOSTS[0]);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// ShaderMember structure
+////////////////////////////////////////////////////////////////////////////////////////
+struct ShaderMember
+{
+    std::string Name;       //!< メンバー名です.
+    u32         Offset;     //!< 構造体の先頭からのバイトオフセットです.
+    u32         Size;       //!< バイトサイズです.
+};
+
+//---------------------------------------------------------------------------------------
+//      シェーダの構造体宣言からストラクチャードバッファのレイアウトを求めます.
+//---------------------------------------------------------------------------------------
+bool ParseShaderStruct( const char* path, const char* name, std::vector<ShaderMember>& members )
+{
+    std::ifstream stream( path );
+    if ( !stream.is_open() )
+    { return false; }
+
+    // ストラクチャードバッファは16byte境界の規則が無く, 4byte単位で詰める.
+    const std::string header = std::string( "struct " ) + name;
+    std::string line;
+    bool inside = false;
+    u32 offset = 0;
+    while ( std::getline( stream, line ) )
+    {
+        if ( !inside )
+        {
+            if ( line.compare( 0, header.size(), header ) == 0 && line.size() <= header.size() + 1 )
+            { inside = true; }
+            continue;
+        }
+
+        if ( line.find( "};" ) != std::string::npos )
+        { return !members.empty(); }
+
+        std::istringstream tokens( line );
+        std::string type, member;
+        if ( !( tokens >> type >> member ) || type == "{" )
+        { continue; }
+
+        u32 count = 1;
+        if ( type == "float" || type == "uint" || type == "int" )
+        { count = 1; }
+        else if ( type.size() == 6 && type.compare( 0, 5, "float" ) == 0 && type[5] >= '2' && type[5] <= '4' )
+        { count = u32( type[5] - '0' ); }
+        else
+        { return false; }
+
+        if ( !member.empty() && member.back() == ';' )
+        { member.pop_back(); }
+
+        ShaderMember item;
+        item.Name   = member;
+        item.Offset = offset;
+        item.Size   = count * 4;
+        members.push_back( item );
+
+        offset += item.Size;
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------------------------------------
+//      インスタンスデータのレイアウトがシェーダの宣言と一致するかテストします.
+//---------------------------------------------------------------------------------------
+void TestLayout()
+{
+    std::vector<ShaderMember> members;
+    CHECK( ParseShaderStruct( GHOST_INSTANCE_SHADER_PATH, "GhostInstance", members ) );
+    CHECK( members.size() == 2 );
+    if ( members.size() != 2 )
+    { return; }
+
+    CHECK( members[0].Name   == "Color" );
+    CHECK( members[0].Offset == offsetof( GhostInstance, Color ) );
+    CHECK( members[0].Size   == sizeof( GhostInstance().Color ) );
+    CHECK( members[1].Name   == "Scale" );
+    CHECK( members[1].Offset == offsetof( GhostInstance, Scale ) );
+    CHECK( members[1].Size   == sizeof( GhostInstance().Scale ) );
+
+    // GhostInstanceBuffer は sizeof(GhostInstance) をストライドにする.
+    CHECK( members[1].Offset + members[1].Size == sizeof(GhostInstance) );
+    CHECK( sizeof(GhostInstance) == 16 );
+}
+
+//---------------------------------------------------------------------------------------
+//      インスタンスデータの構築をテストします.
+//---------------------------------------------------------------------------------------
+void TestBuild()
+{
+    GhostInstanceList list;
+    CHECK( list.GetCount() == 0 );
+    CHECK( !list.IsDirty() );
+
+    // 寄与の無いゴーストは除く.
+    CHECK( list.Build( GHOSTS, GHOST_COUNT, 1 ) );
+    CHECK( list.GetCount() == 2 );
+    CHECK( list.GetData()[0].Color[0] == 1.0f );
+    CHECK( list.GetData()[0].Color[1] == 0.5f );
+    CHECK( list.GetData()[0].Color[2] == 0.6f );
+    CHECK( list.GetData()[0].Scale    == -1.2f );
+    CHECK( list.GetData()[1].Scale    == 1.5f );
+
+    // 0 は 1 として扱う.
+    GhostInstanceList other;
+    CHECK( other.Build( GHOSTS, GHOST_COUNT, 0 ) );
+    CHECK( other.GetCount() == list.GetCount() );
+
+    // 複製しても明るさの総和は変わらず, スケールは REPLICA_SPREAD の範囲で広がる.
+    const u32 replicaCount = 64;
+    CHECK( list.Build( GHOSTS, GHOST_COUNT, replicaCount ) );
+    CHECK( list.GetCount() == 2 * replicaCount );
+
+    float sum[3] = {};
+    for(u32 i=0; i<replicaCount; ++i)
+    {
+        sum[0] += list.GetData()[i].Color[0];
+        sum[1] += list.GetData()[i].Color[1];
+        sum[2] += list.GetData()[i].Color[2];
+    }
+    CHECK( std::fabs( sum[0] - 1.0f ) < 1e-4f );
+    CHECK( std::fabs( sum[1] - 0.5f ) < 1e-4f );
+    CHECK( std::fabs( sum[2] - 0.6f ) < 1e-4f );
+    CHECK( list.GetData()[0].Scale == -1.2f );
+
+    auto last = list.GetData()[replicaCount - 1].Scale;
+    CHECK( last < -1.2f );
+    CHECK( last > -1.2f * ( 1.0f + GhostInstanceList::REPLICA_SPREAD ) );
+
+    CHECK( list.Build( nullptr, 0, 1 ) );
+    CHECK( list.GetCount() == 0 );
+}
+
+//---------------------------------------------------------------------------------------
+//      内容が変化した場合だけ転送が必要になるかテストします.
+//---------------------------------------------------------------------------------------
+void TestDirty()
+{
+    // GhostInstanceBuffer::Update() は IsDirty() の場合だけ転送して ClearDirty() を呼ぶ.
+    GhostInstanceList list;
+    u32 uploadCount = 0;
+    auto update = [&]()
+    {
+        if ( !list.IsDirty() )
+        { return; }
+
+        uploadCount++;
+        list.ClearDirty();
+    };
+
+    CHECK( list.Build( GHOSTS, GHOST_COUNT, 4 ) );
+    update();
+    CHECK( uploadCount == 1 );
+
+    // 毎フレーム同じ内容で構築しても転送しない.
+    for(u32 i=0; i<8; ++i)
+    {
+        CHECK( !list.Build( GHOSTS, GHOST_COUNT, 4 ) );
+        update();
+    }
+    CHECK( uploadCount == 1 );
+
+    // 複製数の変更.
+    CHECK( list.Build( GHOSTS, GHOST_COUNT, 8 ) );
+    update();
+    CHECK( uploadCount == 2 );
+
+    // 色だけの変更. インスタンス数は変わらない.
+    asdx::Vector4 ghosts[GHOST_COUNT];
+    for(u32 i=0; i<GHOST_COUNT; ++i)
+    { ghosts[i] = GHOSTS[i]; }
+    ghosts[2].y = 0.75f;
+
+    CHECK( list.Build( ghosts, GHOST_COUNT, 8 ) );
+    update();
+    CHECK( uploadCount == 3 );
+
+    // 転送前に同じ内容で構築し直しても, 保留中の転送は失わない.
+    CHECK( list.Build( GHOSTS, GHOST_COUNT, 8 ) );
+    CHECK( !list.Build( GHOSTS, GHOST_COUNT, 8 ) );
+    CHECK( list.IsDirty() );
+    update();
+    CHECK( uploadCount == 4 );
+    CHECK( !list.IsDirty() );
+}
+
+} // namespace
+
+
+//---------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//---------------------------------------------------------------------------------------
+int main()
+{
+    TestLayout();
+    TestBuild();
+    TestDirty();
+
+    if ( g_FailCount != 0 )
+    {
+        fprintf( stderr, "GhostInstanceTest : %d check(s) failed.\n", g_FailCount );
+        return -1;
+    }
+
+    printf( "GhostInstanceTest : OK\n" );
+    return 0;
+}
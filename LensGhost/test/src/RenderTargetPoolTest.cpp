@@ -0,0 +1,327 @@
+﻿//---------------------------------------------------------------------------------------
+// File : RenderTargetPoolTest.cpp
+// Desc : Render Target Pool Test.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "RenderTargetPool.h"
+#include <cstdio>
+
+
+namespace {
+
+//---------------------------------------------------------------------------------------
+// Macros
+//---------------------------------------------------------------------------------------
+#define CHECK( expr )                                                           \
+    do {                                                                        \
+        if ( !( expr ) )                                                        \
+        {                                                                       \
+            fprintf( stderr, "Error : %s(%d) : %s\n", __FILE__, __LINE__, #expr );  \
+            g_FailCount++;                                                      \
+        }                                                                       \
+    } while( 0 )
+
+
+//---------------------------------------------------------------------------------------
+// Global Variables
+//---------------------------------------------------------------------------------------
+int g_FailCount = 0;
+
+const u32 FORMAT_RGBA8 = 28;    // DXGI_FORMAT_R8G8B8A8_UNORM
+const u32 FORMAT_RGBA16F = 10;  // DXGI_FORMAT_R16G16B16A16_FLOAT
+
+const RenderTargetDesc FULL   = { 1920, 1080, FORMAT_RGBA8 };
+const RenderTargetDesc HALF   = {  960,  540, FORMAT_RGBA8 };
+const RenderTargetDesc FULL_F = { 1920, 1080, FORMAT_RGBA16F };
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// PeakRenderTargetAllocator class
+// 同時に生存したレンダーターゲットの最大数を記録します.
+////////////////////////////////////////////////////////////////////////////////////////
+class PeakRenderTargetAllocator : public IRenderTargetAllocator
+{
+public:
+    PeakRenderTargetAllocator()
+    : m_Inner       ( 4 )
+    , m_PeakCount   ( 0 )
+    { /* DO_NOTHING */ }
+
+    void* Create( const RenderTargetDesc& desc )
+    {
+        auto pTarget = m_Inner.Create( desc );
+        if ( m_Inner.GetLiveCount() > m_PeakCount )
+        { m_PeakCount = m_Inner.GetLiveCount(); }
+        return pTarget;
+    }
+
+    void Dispose( void* pTarget )
+    { m_Inner.Dispose( pTarget ); }
+
+    u64 GetSize( const RenderTargetDesc& desc ) const
+    { return m_Inner.GetSize( desc ); }
+
+    void ResetPeak()
+    { m_PeakCount = m_Inner.GetLiveCount(); }
+
+    u32 GetPeakCount() const
+    { return m_PeakCount; }
+
+    u32 GetLiveCount() const
+    { return m_Inner.GetLiveCount(); }
+
+private:
+    NullRenderTargetAllocator   m_Inner;        //!< 実際に生成するアロケータです.
+    u32                         m_PeakCount;    //!< 同時に生存した最大数です.
+
+    PeakRenderTargetAllocator   ( const PeakRenderTargetAllocator& );   // アクセス禁止.
+    void operator =             ( const PeakRenderTargetAllocator& );   // アクセス禁止.
+};
+
+//---------------------------------------------------------------------------------------
+//      区間が重ならない仮想ターゲットが実体を共有するかテストします.
+//---------------------------------------------------------------------------------------
+void TestAlias()
+{
+    NullRenderTargetAllocator allocator( 4 );
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    // ブラーの縮小, 横, 縦の作業バッファと最後まで使う合成先.
+    pool.Begin();
+    auto accum = pool.Request( FULL, 0, 5 );
+    auto work0 = pool.Request( FULL, 1, 2 );
+    auto work1 = pool.Request( FULL, 2, 3 );
+    auto work2 = pool.Request( FULL, 3, 4 );
+    CHECK( pool.Compile() );
+
+    CHECK( pool.GetVirtualCount() == 4 );
+    CHECK( pool.GetPhysicalCount() == 3 );
+    CHECK( pool.GetPhysicalIndex( work0 ) == pool.GetPhysicalIndex( work2 ) );
+    CHECK( pool.GetTarget( work0 ) == pool.GetTarget( work2 ) );
+    CHECK( pool.GetPhysicalIndex( work0 ) != pool.GetPhysicalIndex( work1 ) );
+    CHECK( pool.GetPhysicalIndex( accum ) != pool.GetPhysicalIndex( work0 ) );
+    CHECK( pool.GetPhysicalIndex( accum ) != pool.GetPhysicalIndex( work1 ) );
+    CHECK( pool.GetRequestedSize() == allocator.GetSize( FULL ) * 4 );
+    CHECK( pool.GetAllocatedSize() == allocator.GetSize( FULL ) * 3 );
+    CHECK( allocator.GetLiveCount() == 3 );
+
+    pool.Term();
+    CHECK( allocator.GetLiveCount() == 0 );
+}
+
+//---------------------------------------------------------------------------------------
+//      LensGhost の作業バッファの区間で割り当てをテストします.
+//---------------------------------------------------------------------------------------
+void TestLensGhost()
+{
+    NullRenderTargetAllocator allocator( 4 );
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    const RenderTargetDesc QUARTER = { 480, 270, FORMAT_RGBA8 };
+
+    // SampleApplication::CreateWorkBuffers() と同じ宣言.
+    // 各パスは直前のパスの結果を読みながら書き込むので，同じ構成設定の区間が必ず重なる.
+    pool.Begin();
+    auto blurX  = pool.Request( QUARTER, 0, 1 );
+    auto blurY  = pool.Request( QUARTER, 1, 2 );
+    auto ghost0 = pool.Request( FULL,    2, 3 );
+    auto ghost1 = pool.Request( FULL,    3, 4 );
+    CHECK( pool.Compile() );
+    CHECK( pool.GetPhysicalCount() == 4 );
+    CHECK( pool.GetPhysicalIndex( blurX  ) != pool.GetPhysicalIndex( blurY  ) );
+    CHECK( pool.GetPhysicalIndex( ghost0 ) != pool.GetPhysicalIndex( ghost1 ) );
+    CHECK( pool.GetAllocatedSize() == pool.GetRequestedSize() );
+
+    // 2段分を展開する場合は1段目のゴーストを描かず，縦ブラーの結果を2段目まで読む.
+    pool.Begin();
+    blurX  = pool.Request( QUARTER, 0, 1 );
+    blurY  = pool.Request( QUARTER, 1, 3 );
+    ghost1 = pool.Request( FULL,    3, 4 );
+    CHECK( pool.Compile() );
+    CHECK( pool.GetPhysicalCount() == 3 );
+    CHECK( pool.GetPhysicalIndex( blurX ) != pool.GetPhysicalIndex( blurY ) );
+    CHECK( pool.GetAllocatedSize() == pool.GetRequestedSize() );
+
+    // 描画方法を切り替えても使わなくなった実体を破棄するだけで作り直さない.
+    CHECK( allocator.GetCreateCount() == 4 );
+    CHECK( allocator.GetLiveCount() == 3 );
+
+    pool.Term();
+    CHECK( allocator.GetLiveCount() == 0 );
+}
+
+//---------------------------------------------------------------------------------------
+//      区間が重なるものや構成設定が異なるものは共有しないかテストします.
+//---------------------------------------------------------------------------------------
+void TestNoAlias()
+{
+    NullRenderTargetAllocator allocator( 4 );
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    // 同じパスで書き込みと読み込みが重なる.
+    pool.Begin();
+    auto a = pool.Request( FULL, 0, 2 );
+    auto b = pool.Request( FULL, 2, 4 );
+    CHECK( pool.Compile() );
+    CHECK( pool.GetPhysicalCount() == 2 );
+    CHECK( pool.GetPhysicalIndex( a ) != pool.GetPhysicalIndex( b ) );
+
+    // 区間は重ならないが, 横幅・縦幅・フォーマットのいずれかが異なる.
+    RenderTargetDesc wide = FULL;
+    wide.Width = 1280;
+
+    pool.Begin();
+    auto full  = pool.Request( FULL,   0, 0 );
+    auto half  = pool.Request( HALF,   1, 1 );
+    auto fmt   = pool.Request( FULL_F, 2, 2 );
+    auto width = pool.Request( wide,   3, 3 );
+    auto again = pool.Request( FULL,   4, 4 );
+    CHECK( pool.Compile() );
+    CHECK( pool.GetPhysicalCount() == 4 );
+    CHECK( pool.GetPhysicalIndex( full ) != pool.GetPhysicalIndex( half ) );
+    CHECK( pool.GetPhysicalIndex( full ) != pool.GetPhysicalIndex( fmt ) );
+    CHECK( pool.GetPhysicalIndex( full ) != pool.GetPhysicalIndex( width ) );
+    CHECK( pool.GetPhysicalIndex( full ) == pool.GetPhysicalIndex( again ) );
+
+    // 不正な区間.
+    CHECK( pool.Request( FULL, 3, 2 ) == RenderTargetPool::INVALID_HANDLE );
+    CHECK( pool.GetTarget( RenderTargetPool::INVALID_HANDLE ) == nullptr );
+
+    pool.Term();
+    CHECK( allocator.GetLiveCount() == 0 );
+}
+
+//---------------------------------------------------------------------------------------
+//      Compile() をまたいで実体を使い回すかテストします.
+//---------------------------------------------------------------------------------------
+void TestReuse()
+{
+    NullRenderTargetAllocator allocator( 4 );
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    pool.Begin();
+    auto a = pool.Request( FULL, 0, 1 );
+    auto b = pool.Request( HALF, 0, 1 );
+    CHECK( pool.Compile() );
+    auto pA = pool.GetTarget( a );
+    auto pB = pool.GetTarget( b );
+    auto createCount = allocator.GetCreateCount();
+
+    // 宣言の順番が変わっても構成設定が同じなら作り直さない.
+    pool.Begin();
+    b = pool.Request( HALF, 0, 3 );
+    a = pool.Request( FULL, 2, 3 );
+    CHECK( pool.Compile() );
+    CHECK( allocator.GetCreateCount() == createCount );
+    CHECK( allocator.GetLiveCount() == 2 );
+    CHECK( pool.GetTarget( a ) == pA );
+    CHECK( pool.GetTarget( b ) == pB );
+
+    // 使わなくなった実体だけを破棄する.
+    pool.Begin();
+    a = pool.Request( FULL, 0, 0 );
+    CHECK( pool.Compile() );
+    CHECK( allocator.GetCreateCount() == createCount );
+    CHECK( allocator.GetLiveCount() == 1 );
+    CHECK( pool.GetTarget( a ) == pA );
+
+    pool.Term();
+    CHECK( allocator.GetLiveCount() == 0 );
+}
+
+//---------------------------------------------------------------------------------------
+//      不要な実体を破棄してから生成するかテストします.
+//---------------------------------------------------------------------------------------
+void TestReleaseBeforeCreate()
+{
+    PeakRenderTargetAllocator allocator;
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    pool.Begin();
+    pool.Request( FULL, 0, 1 );
+    pool.Request( FULL, 0, 1 );
+    CHECK( pool.Compile() );
+    CHECK( allocator.GetPeakCount() == 2 );
+
+    // 作業フォーマットの切り替え. 古い実体が残ったまま生成すると4つ同時に生存する.
+    allocator.ResetPeak();
+    pool.Begin();
+    pool.Request( FULL_F, 0, 1 );
+    pool.Request( FULL_F, 0, 1 );
+    CHECK( pool.Compile() );
+    CHECK( allocator.GetPeakCount() == 2 );
+    CHECK( allocator.GetLiveCount() == 2 );
+
+    pool.Term();
+    CHECK( allocator.GetLiveCount() == 0 );
+}
+
+//---------------------------------------------------------------------------------------
+//      実体の生成に失敗した場合をテストします.
+//---------------------------------------------------------------------------------------
+void TestFailure()
+{
+    NullRenderTargetAllocator allocator( 4 );
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    allocator.SetFailCount( 1 );
+    pool.Begin();
+    auto a = pool.Request( FULL, 0, 1 );
+    auto b = pool.Request( FULL, 0, 1 );
+    CHECK( !pool.Compile() );
+    CHECK( allocator.GetLiveCount() == 1 );
+    CHECK( pool.GetTarget( a ) == nullptr );
+    CHECK( pool.GetTarget( b ) == nullptr );
+
+    // 生成済みの実体は保持し，失敗した実体だけを生成し直す.
+    allocator.SetFailCount( 0xffffffff );
+    CHECK( pool.Compile() );
+    CHECK( allocator.GetCreateCount() == 2 );
+    CHECK( allocator.GetLiveCount() == 2 );
+    CHECK( pool.GetTarget( a ) != nullptr );
+    CHECK( pool.GetTarget( b ) != nullptr );
+    CHECK( pool.GetTarget( a ) != pool.GetTarget( b ) );
+
+    // アロケータ未設定.
+    RenderTargetPool empty;
+    CHECK( !empty.Init( nullptr ) );
+    CHECK( !empty.Compile() );
+
+    pool.Term();
+    CHECK( allocator.GetLiveCount() == 0 );
+}
+
+} // namespace
+
+
+//---------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//---------------------------------------------------------------------------------------
+int main()
+{
+    TestAlias();
+    TestNoAlias();
+    TestLensGhost();
+    TestReuse();
+    TestReleaseBeforeCreate();
+    TestFailure();
+
+    if ( g_FailCount != 0 )
+    {
+        fprintf( stderr, "RenderTargetPoolTest : %d check(s) failed.\n", g_FailCount );
+        return -1;
+    }
+
+    printf( "RenderTargetPoolTest : OK\n" );
+    return 0;
+}
@@ -16,6 +16,47 @@
 #include <cassert>
 #include <cstring>
 
+// F16C 命令が使える場合は，配列の半精度変換を8要素ずつ行います.
+// GCC/Clang の -mavx2 は F16C を含まないので，__F16C__ を定義しない MSVC に限り /arch:AVX2 でも有効にします.
+#if !defined(ASDX_USE_F16C) && ( defined(__F16C__) || ( defined(_MSC_VER) && defined(__AVX2__) ) )
+#define ASDX_USE_F16C     (1)
+#endif//ASDX_USE_F16C
+
+#if defined(ASDX_USE_F16C) && ASDX_USE_F16C
+#include <immintrin.h>
+#endif//ASDX_USE_F16C
+
+// SSE2 または NEON が使える場合は，行列積・逆行列・ベクトル変換・四元数の積を4要素ずつ行います.
+// 0 を定義するとスカラー実装を使います.
+#if !defined(ASDX_USE_SSE) && ( defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && (_M_IX86_FP >= 2) ) )
+#define ASDX_USE_SSE      (1)
+#endif//ASDX_USE_SSE
+
+#if !defined(ASDX_USE_NEON) && ( defined(__ARM_NEON) || defined(_M_ARM64) )
+#define ASDX_USE_NEON     (1)
+#endif//ASDX_USE_NEON
+
+#if defined(ASDX_USE_SSE) && ASDX_USE_SSE
+#include <emmintrin.h>
+#define ASDX_USE_SIMD     (1)
+#elif defined(ASDX_USE_NEON) && ASDX_USE_NEON
+#include <arm_neon.h>
+#define ASDX_USE_SIMD     (1)
+#else
+#define ASDX_USE_SIMD     (0)
+#endif
+
+// AVX2 が使える場合は，ベクトルの配列の一括変換(Vector2/3/4 の *Stream())を256bitレジスタ1本につき2要素ずつ行います.
+// 演算の順序は1要素ずつの変換と同じなので，積和を FMA に縮約するビルド(-mfma 等)を除き結果は一致します.
+// 一括変換は入力と出力に同じ配列と間隔を指定すると，その場で変換できます.
+#if !defined(ASDX_USE_AVX2) && defined(__AVX2__) && ( defined(ASDX_USE_SSE) && ASDX_USE_SSE )
+#define ASDX_USE_AVX2     (1)
+#endif//ASDX_USE_AVX2
+
+#if defined(ASDX_USE_AVX2) && ASDX_USE_AVX2
+#include <immintrin.h>
+#endif//ASDX_USE_AVX2
+
 
 namespace asdx {
 
@@ -183,6 +224,26 @@ f16     F32ToF16( f32 value );
 //------------------------------------------------------------------------------
 f32     F16ToF32( f16 value );
 
+//------------------------------------------------------------------------------
+//! @brief      f32型の配列をf16型の配列に一括変換します.
+//!
+//! @param [in]     pSrc        変換元の配列.
+//! @param [out]    pDst        変換結果の格納先.
+//! @param [in]     count       要素数.
+//! @note       ASDX_USE_F16C が有効な場合は F16C 命令で変換します.
+//!             この場合，f16型で表現できない大きな値は無限大になります.
+//------------------------------------------------------------------------------
+void    F32ToF16Array( const f32* pSrc, f16* pDst, u32 count );
+
+//------------------------------------------------------------------------------
+//! @brief      f16型の配列をf32型の配列に一括変換します.
+//!
+//! @param [in]     pSrc        変換元の配列.
+//! @param [out]    pDst        変換結果の格納先.
+//! @param [in]     count       要素数.
+//------------------------------------------------------------------------------
+void    F16ToF32Array( const f16* pSrc, f32* pDst, u32 count );
+
 //------------------------------------------------------------------------------
 //! @brief      2つの値のうち，大きい方を返却します.
 //!
@@ -272,6 +333,13 @@ public:
     //--------------------------------------------------------------------------
     Vector2();
 
+    //--------------------------------------------------------------------------
+    //! @brief      コピーコンストラクタです.
+    //!
+    //! @param [in]     value       コピー元の値.
+    //--------------------------------------------------------------------------
+    Vector2( const Vector2& value );
+
     //--------------------------------------------------------------------------
     //! @brief      引数付きコンストラクタです.
     //!
@@ -832,6 +900,45 @@ public:
     //--------------------------------------------------------------------------
     static void    TransformCoord( const Vector2& coords, const Matrix& matrix, Vector2 &result );
 
+    //--------------------------------------------------------------------------
+    //! @brief      指定された行列を用いて，ベクトルの配列を一括変換します.
+    //!
+    //! @param [in]     pInput          入力ベクトルの配列.
+    //! @param [in]     inputStride     入力ベクトルの間隔(バイト).
+    //! @param [out]    pOutput         変換結果の格納先.
+    //! @param [in]     outputStride    変換結果の間隔(バイト).
+    //! @param [in]     count           要素数.
+    //! @param [in]     matrix          変換行列.
+    //! @note       各要素を Transform() で変換した結果と一致します.
+    //--------------------------------------------------------------------------
+    static void    TransformStream( const Vector2* pInput, u32 inputStride, Vector2* pOutput, u32 outputStride, u32 count, const Matrix& matrix );
+
+    //--------------------------------------------------------------------------
+    //! @brief      指定された行列を用いて，法線ベクトルの配列を一括変換します.
+    //!
+    //! @param [in]     pInput          入力ベクトルの配列.
+    //! @param [in]     inputStride     入力ベクトルの間隔(バイト).
+    //! @param [out]    pOutput         変換結果の格納先.
+    //! @param [in]     outputStride    変換結果の間隔(バイト).
+    //! @param [in]     count           要素数.
+    //! @param [in]     matrix          変換行列.
+    //! @note       各要素を TransformNormal() で変換した結果と一致します.
+    //--------------------------------------------------------------------------
+    static void    TransformNormalStream( const Vector2* pInput, u32 inputStride, Vector2* pOutput, u32 outputStride, u32 count, const Matrix& matrix );
+
+    //--------------------------------------------------------------------------
+    //! @brief      指定された行列を用いてベクトルの配列を一括変換し，変換結果をw=1に射影します.
+    //!
+    //! @param [in]     pInput          入力ベクトルの配列.
+    //! @param [in]     inputStride     入力ベクトルの間隔(バイト).
+    //! @param [out]    pOutput         変換結果の格納先.
+    //! @param [in]     outputStride    変換結果の間隔(バイト).
+    //! @param [in]     count           要素数.
+    //! @param [in]     matrix          変換行列.
+    //! @note       各要素を TransformCoord() で変換した結果と一致します.
+    //--------------------------------------------------------------------------
+    static void    TransformCoordStream( const Vector2* pInput, u32 inputStride, Vector2* pOutput, u32 outputStride, u32 count, const Matrix& matrix );
+
 } Vector2;
 
 
@@ -870,6 +977,13 @@ public:
     //--------------------------------------------------------------------------
     Vector3();
 
+    //--------------------------------------------------------------------------
+    //! @brief      コピーコンストラクタです.
+    //!
+    //! @param [in]     value       コピー元の値.
+    //--------------------------------------------------------------------------
+    Vector3( const Vector3& value );
+
     //--------------------------------------------------------------------------
     //! @brief      引数付きコンストラクタです.
     //!
@@ -1499,6 +1613,45 @@ public:
     //--------------------------------------------------------------------------
     static void    TransformCoord( const Vector3& coord, const Matrix& matrix, Vector3& result );
 
+    //--------------------------------------------------------------------------
+    //! @brief      指定された行列を用いて，ベクトルの配列を一括変換します.
+    //!
+    //! @param [in]     pInput          入力ベクトルの配列.
+    //! @param [in]     inputStride     入力ベクトルの間隔(バイト).
+    //! @param [out]    pOutput         変換結果の格納先.
+    //! @param [in]     outputStride    変換結果の間隔(バイト).
+    //! @param [in]     count           要素数.
+    //! @param [in]     matrix          変換行列.
+    //! @note       各要素を Transform() で変換した結果と一致します.
+    //--------------------------------------------------------------------------
+    static void    TransformStream( const Vector3* pInput, u32 inputStride, Vector3* pOutput, u32 outputStride, u32 count, const Matrix& matrix );
+
+    //--------------------------------------------------------------------------
+    //! @brief      指定された行列を用いて，法線ベクトルの配列を一括変換します.
+    //!
+    //! @param [in]     pInput          入力ベクトルの配列.
+    //! @param [in]     inputStride     入力ベクトルの間隔(バイト).
+    //! @param [out]    pOutput         変換結果の格納先.
+    //! @param [in]     outputStride    変換結果の間隔(バイト).
+    //! @param [in]     count           要素数.
+    //! @param [in]     matrix          変換行列.
+    //! @note       各要素を TransformNormal() で変換した結果と一致します.
+    //--------------------------------------------------------------------------
+    static void    TransformNormalStream( const Vector3* pInput, u32 inputStride, Vector3* pOutput, u32 outputStride, u32 count, const Matrix& matrix );
+
+    //--------------------------------------------------------------------------
+    //! @brief      指定された行列を用いてベクトルの配列を一括変換し，変換結果をw=1に射影します.
+    //!
+    //! @param [in]     pInput          入力ベクトルの配列.
+    //! @param [in]     inputStride     入力ベクトルの間隔(バイト).
+    //! @param [out]    pOutput         変換結果の格納先.
+    //! @param [in]     outputStride    変換結果の間隔(バイト).
+    //! @param [in]     count           要素数.
+    //! @param [in]     matrix          変換行列.
+    //! @note       各要素を TransformCoord() で変換した結果と一致します.
+    //--------------------------------------------------------------------------
+    static void    TransformCoordStream( const Vector3* pInput, u32 inputStride, Vector3* pOutput, u32 outputStride, u32 count, const Matrix& matrix );
+
     //---------------------------------------------------------------------------
     //! @brief      スカラー3重積を計算します.
     //!
@@ -1578,6 +1731,13 @@ public:
     //--------------------------------------------------------------------------
     Vector4();
 
+    //--------------------------------------------------------------------------
+    //! @brief      コピーコンストラクタです.
+    //!
+    //! @param [in]     value       コピー元の値.
+    //--------------------------------------------------------------------------
+    Vector4( const Vector4& value );
+
     //--------------------------------------------------------------------------
     //! @brief      引数付きコンストラクタです.
     //!
@@ -2083,6 +2243,19 @@ public:
     //--------------------------------------------------------------------------
     static void    Transform( const Vector4& position, const Matrix& matrix, Vector4 &result );
 
+    //--------------------------------------------------------------------------
+    //! @brief      指定された行列を用いて，ベクトルの配列を一括変換します.
+    //!
+    //! @param [in]     pInput          入力ベクトルの配列.
+    //! @param [in]     inputStride     入力ベクトルの間隔(バイト).
+    //! @param [out]    pOutput         変換結果の格納先.
+    //! @param [in]     outputStride    変換結果の間隔(バイト).
+    //! @param [in]     count           要素数.
+    //! @param [in]     matrix          変換行列.
+    //! @note       各要素を Transform() で変換した結果と一致します.
+    //--------------------------------------------------------------------------
+    static void    TransformStream( const Vector4* pInput, u32 inputStride, Vector4* pOutput, u32 outputStride, u32 count, const Matrix& matrix );
+
 } Vector4;
 
 
@@ -2130,6 +2303,13 @@ public:
     //--------------------------------------------------------------------------
     Matrix();
 
+    //--------------------------------------------------------------------------
+    //! @brief      コピーコンストラクタです.
+    //!
+    //! @param [in]     value       コピー元の値.
+    //--------------------------------------------------------------------------
+    Matrix( const Matrix& value );
+
     //--------------------------------------------------------------------------
     //! @brief      引数付きコンストラクタです.
     //!
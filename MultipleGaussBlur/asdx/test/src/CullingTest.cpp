@@ -0,0 +1,309 @@
+﻿//-------------------------------------------------------------------------------------
+// File : CullingTest.cpp
+// Desc : Culling Module Test.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------
+#include <asdxCulling.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------
+// Macros
+//-------------------------------------------------------------------------------------
+#define CHECK( expr )                                                           \
+    do {                                                                        \
+        if ( !( expr ) )                                                        \
+        {                                                                       \
+            fprintf( stderr, "Error : %s(%d) : %s\n", __FILE__, __LINE__, #expr );  \
+            g_FailCount++;                                                      \
+        }                                                                       \
+    } while( 0 )
+
+#if defined(ASDX_USE_AVX2) && ASDX_USE_AVX2
+#define TEST_USE_AVX2   (1)
+#else
+#define TEST_USE_AVX2   (0)
+#endif
+
+
+//-------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------
+const int   SKIP_CODE       = 77;       // CTest の SKIP_RETURN_CODE です.
+const u32   BOUNDS_COUNT    = 10007;    // 判定する境界ボリュームの数です. NUM_BATCH の倍数にしない.
+const u32   INVALID_INDEX   = 0xdeadbeef;
+const u8    INVALID_MASK    = 0xcc;
+
+
+//-------------------------------------------------------------------------------------
+// Global Variables
+//-------------------------------------------------------------------------------------
+int g_FailCount = 0;
+u32 g_Seed      = 1234567;
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Scene structure
+///////////////////////////////////////////////////////////////////////////////////////
+struct Scene
+{
+    std::vector<asdx::BoundingBox>      Boxes;      //!< 境界箱です.
+    std::vector<asdx::BoundingSphere>   Spheres;    //!< 境界球です.
+    std::vector<bool>                   IsBox;      //!< 境界箱なら true です.
+    asdx::BoundsArray                   Bounds;     //!< SoA に並べた境界ボリュームです.
+};
+
+
+//-------------------------------------------------------------------------------------
+//      [min, max) の乱数を取得します.
+//-------------------------------------------------------------------------------------
+f32 Rand( f32 min, f32 max )
+{
+    g_Seed = g_Seed * 1664525u + 1013904223u;
+    return min + ( max - min ) * f32( ( g_Seed >> 8 ) & 0xffff ) / 65536.0f;
+}
+
+//-------------------------------------------------------------------------------------
+//      境界箱と境界球を交互に並べたシーンを作成します.
+//-------------------------------------------------------------------------------------
+bool CreateScene( u32 count, Scene& scene )
+{
+    scene.Boxes  .resize( count );
+    scene.Spheres.resize( count );
+    scene.IsBox  .resize( count );
+
+    if ( !scene.Bounds.Init( count ) )
+    { return false; }
+
+    for(u32 i=0; i<count; ++i)
+    {
+        asdx::Vector3 center( Rand( -200.0f, 200.0f ), Rand( -200.0f, 200.0f ), Rand( -200.0f, 200.0f ) );
+        scene.IsBox[i] = ( i % 3 ) != 0;
+
+        if ( scene.IsBox[i] )
+        {
+            asdx::Vector3 extents( Rand( 0.1f, 8.0f ), Rand( 0.1f, 8.0f ), Rand( 0.1f, 8.0f ) );
+            scene.Boxes[i] = asdx::BoundingBox( center - extents, center + extents );
+            if ( !scene.Bounds.Add( scene.Boxes[i] ) )
+            { return false; }
+        }
+        else
+        {
+            scene.Spheres[i] = asdx::BoundingSphere( center, Rand( 0.1f, 8.0f ) );
+            if ( !scene.Bounds.Add( scene.Spheres[i] ) )
+            { return false; }
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+//      スカラー実装の視錐台で可視判定します.
+//-------------------------------------------------------------------------------------
+bool IsVisible( const asdx::BoundingFrustum& frustum, const Scene& scene, u32 index )
+{
+    return ( scene.IsBox[index] )
+        ? frustum.Intersects( scene.Boxes  [index] )
+        : frustum.Intersects( scene.Spheres[index] );
+}
+
+//-------------------------------------------------------------------------------------
+//      スカラー実装の視錐台で可視な要素番号を求めます.
+//-------------------------------------------------------------------------------------
+std::vector<u32> CullReference( const asdx::BoundingFrustum& frustum, const Scene& scene, u32 begin, u32 end )
+{
+    std::vector<u32> result;
+    for(u32 i=begin; i<end; ++i)
+    {
+        if ( IsVisible( frustum, scene, i ) )
+        { result.push_back( i ); }
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------
+//      テストに使う視錐台を作成します.
+//-------------------------------------------------------------------------------------
+asdx::BoundingFrustum CreateFrustum()
+{
+    auto view = asdx::Matrix::CreateLookAt(
+        asdx::Vector3( 10.0f, 20.0f, -30.0f ),
+        asdx::Vector3( 0.0f, 0.0f, 0.0f ),
+        asdx::Vector3( 0.0f, 1.0f, 0.0f ) );
+    auto proj = asdx::Matrix::CreatePerspectiveFieldOfView( asdx::F_PIDIV4, 16.0f / 9.0f, 1.0f, 250.0f );
+    return asdx::BoundingFrustum( view * proj );
+}
+
+//-------------------------------------------------------------------------------------
+//      境界ボリュームの配列の容量をテストします.
+//-------------------------------------------------------------------------------------
+void TestBoundsArray()
+{
+    asdx::BoundsArray bounds;
+    CHECK( !bounds.Init( 0 ) );
+
+    // 容量は NUM_BATCH の倍数に切り上げる.
+    CHECK( bounds.Init( asdx::BoundsArray::NUM_BATCH + 1 ) );
+    CHECK( bounds.GetCapacity() == asdx::BoundsArray::NUM_BATCH * 2 );
+    CHECK( bounds.GetCount() == 0 );
+
+    asdx::BoundingSphere sphere( asdx::Vector3( 1.0f, 2.0f, 3.0f ), 4.0f );
+    for(u32 i=0; i<bounds.GetCapacity(); ++i)
+    { CHECK( bounds.Add( sphere ) ); }
+
+    // 容量を超えた追加は失敗する.
+    CHECK( !bounds.Add( sphere ) );
+    CHECK( bounds.GetCount() == bounds.GetCapacity() );
+
+    bounds.Clear();
+    CHECK( bounds.GetCount() == 0 );
+    CHECK( bounds.GetCapacity() == asdx::BoundsArray::NUM_BATCH * 2 );
+
+    // 境界箱は中心と面までの距離で格納する.
+    CHECK( bounds.Add( asdx::BoundingBox( asdx::Vector3( -1.0f, 0.0f, 2.0f ), asdx::Vector3( 3.0f, 4.0f, 8.0f ) ) ) );
+    CHECK( bounds.GetCenterX()[0] == 1.0f && bounds.GetCenterY()[0] == 2.0f && bounds.GetCenterZ()[0] == 5.0f );
+    CHECK( bounds.GetExtentX()[0] == 2.0f && bounds.GetExtentY()[0] == 2.0f && bounds.GetExtentZ()[0] == 3.0f );
+
+    bounds.Term();
+    CHECK( bounds.GetCount() == 0 );
+}
+
+//-------------------------------------------------------------------------------------
+//      視錐台カリングをスカラー実装と比較します.
+//-------------------------------------------------------------------------------------
+void TestFrustumCull( const Scene& scene, const asdx::BoundingFrustum& frustum )
+{
+    const u32 count = BOUNDS_COUNT;
+
+    auto expected = CullReference( frustum, scene, 0, count );
+    CHECK( !expected.empty() );
+    CHECK( expected.size() < count );
+
+    // 全範囲. 出力は end - begin 個を超えない.
+    std::vector<u32> indices( count + 1, INVALID_INDEX );
+    auto visible = asdx::FrustumCull( frustum, scene.Bounds, 0, count, indices.data() );
+    CHECK( visible == expected.size() );
+    CHECK( std::equal( expected.begin(), expected.end(), indices.begin() ) );
+    CHECK( indices[count] == INVALID_INDEX );
+
+    // NUM_BATCH の境界をまたぐ部分範囲.
+    for(u32 i=0; i<200; ++i)
+    {
+        u32 begin = u32( Rand( 0.0f, f32( count ) ) );
+        u32 end   = begin + u32( Rand( 0.0f, 100.0f ) );
+        if ( end > count )
+        { end = count; }
+
+        auto sub = CullReference( frustum, scene, begin, end );
+
+        std::fill( indices.begin(), indices.end(), INVALID_INDEX );
+        auto n = asdx::FrustumCull( frustum, scene.Bounds, begin, end, indices.data() );
+        CHECK( n == sub.size() );
+        CHECK( std::equal( sub.begin(), sub.end(), indices.begin() ) );
+        CHECK( indices[end - begin] == INVALID_INDEX );
+    }
+
+    // 空の範囲.
+    indices[0] = INVALID_INDEX;
+    CHECK( asdx::FrustumCull( frustum, scene.Bounds, 100, 100, indices.data() ) == 0 );
+    CHECK( indices[0] == INVALID_INDEX );
+}
+
+//-------------------------------------------------------------------------------------
+//      マスクを出力する視錐台カリングをスカラー実装と比較します.
+//-------------------------------------------------------------------------------------
+void TestFrustumCullMask( const Scene& scene, const asdx::BoundingFrustum& frustum )
+{
+    const u32 count = BOUNDS_COUNT;
+    const u32 split = 8 * 1000;
+
+    // 8の倍数で区切った範囲ごとに出力しても，他の範囲のバイトを書き換えない.
+    std::vector<u8> mask( ( count + 7 ) / 8 + 1, INVALID_MASK );
+    asdx::FrustumCullMask( frustum, scene.Bounds, 0, split, mask.data() );
+    CHECK( mask[split / 8] == INVALID_MASK );
+    asdx::FrustumCullMask( frustum, scene.Bounds, split, count, mask.data() );
+
+    u32 mismatch = 0;
+    for(u32 i=0; i<count; ++i)
+    {
+        bool visible = ( ( mask[i >> 3] >> ( i & 0x7 ) ) & 0x1 ) != 0;
+        if ( visible != IsVisible( frustum, scene, i ) )
+        { mismatch++; }
+    }
+
+    CHECK( mismatch == 0 );
+    CHECK( mask[( count + 7 ) / 8] == INVALID_MASK );
+}
+
+//-------------------------------------------------------------------------------------
+//      並列の視錐台カリングをスカラー実装と比較します.
+//-------------------------------------------------------------------------------------
+void TestFrustumCullParallel( const Scene& scene, const asdx::BoundingFrustum& frustum )
+{
+    const u32 count = BOUNDS_COUNT;
+    const u32 THREAD_COUNTS[] = { 0, 1, 2, 3, 8, 64 };
+
+    auto expected = CullReference( frustum, scene, 0, count );
+
+    std::vector<u32> indices( count + 1 );
+    for(u32 i=0; i<sizeof(THREAD_COUNTS) / sizeof(THREAD_COUNTS[0]); ++i)
+    {
+        std::fill( indices.begin(), indices.end(), INVALID_INDEX );
+        auto visible = asdx::FrustumCullParallel( frustum, scene.Bounds, THREAD_COUNTS[i], indices.data() );
+        CHECK( visible == expected.size() );
+        CHECK( std::equal( expected.begin(), expected.end(), indices.begin() ) );
+        CHECK( indices[count] == INVALID_INDEX );
+    }
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------
+int main()
+{
+#if TEST_USE_AVX2 && ( defined(__GNUC__) || defined(__clang__) )
+    if ( !__builtin_cpu_supports( "avx2" ) )
+    {
+        printf( "CullingTest : AVX2 is not supported, skipped.\n" );
+        return SKIP_CODE;
+    }
+#endif
+
+    printf( "CullingTest : ASDX_USE_SIMD = %d, ASDX_USE_AVX2 = %d\n", ASDX_USE_SIMD, TEST_USE_AVX2 );
+
+    TestBoundsArray();
+
+    Scene scene;
+    if ( !CreateScene( BOUNDS_COUNT, scene ) )
+    {
+        fprintf( stderr, "CullingTest : CreateScene() Failed.\n" );
+        return -1;
+    }
+
+    auto frustum = CreateFrustum();
+    TestFrustumCull        ( scene, frustum );
+    TestFrustumCullMask    ( scene, frustum );
+    TestFrustumCullParallel( scene, frustum );
+
+    if ( g_FailCount != 0 )
+    {
+        fprintf( stderr, "CullingTest : %d check(s) failed.\n", g_FailCount );
+        return -1;
+    }
+
+    printf( "CullingTest : OK\n" );
+    return 0;
+}
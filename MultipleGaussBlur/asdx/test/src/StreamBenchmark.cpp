@@ -0,0 +1,195 @@
+﻿//-------------------------------------------------------------------------------------
+// File : StreamBenchmark.cpp
+// Desc : Stream Transform Benchmark.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------
+#include <asdxMath.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------
+const u32   DEFAULT_COUNT   = 1 << 16;  // 既定の要素数です. L2 に収まる大きさにします.
+const u32   REPEAT_COUNT    = 200;      // 計測の繰り返し回数です. 最短時間を採用します.
+
+
+//-------------------------------------------------------------------------------------
+// Global Variables
+//-------------------------------------------------------------------------------------
+u32 g_Seed = 1234567;
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Vertex structure
+///////////////////////////////////////////////////////////////////////////////////////
+struct Vertex
+{
+    asdx::Vector3   Position;   //!< 位置座標です.
+    asdx::Vector3   Normal;     //!< 法線ベクトルです.
+    asdx::Vector3   Tangent;    //!< 接線ベクトルです.
+    asdx::Vector2   TexCoord;   //!< テクスチャ座標です.
+};
+
+
+//-------------------------------------------------------------------------------------
+//      [-1, 1) の乱数を取得します.
+//-------------------------------------------------------------------------------------
+f32 Rand()
+{
+    g_Seed = g_Seed * 1664525u + 1013904223u;
+    return f32( ( g_Seed >> 8 ) & 0xffff ) / 32768.0f - 1.0f;
+}
+
+//-------------------------------------------------------------------------------------
+//      処理の最短時間をミリ秒で計測します.
+//-------------------------------------------------------------------------------------
+template< typename Func >
+double Measure( Func func )
+{
+    double best = 1e30;
+    for(u32 i=0; i<REPEAT_COUNT; ++i)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+
+        double msec = std::chrono::duration<double, std::milli>( end - begin ).count();
+        if ( msec < best )
+        { best = msec; }
+    }
+
+    return best;
+}
+
+//-------------------------------------------------------------------------------------
+//      1要素ずつの変換と一括変換の時間を表示します.
+//-------------------------------------------------------------------------------------
+void Print( const char* name, u32 count, double element, double stream )
+{
+    printf( "StreamBenchmark : %-38s : element %7.3f nsec, stream %7.3f nsec, x%.2f\n",
+        name,
+        element * 1e6 / count,
+        stream  * 1e6 / count,
+        element / stream );
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//
+//      StreamBenchmark [count] : count 個のベクトルを変換する時間を計測します.
+//-------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+#if defined(ASDX_USE_AVX2) && ASDX_USE_AVX2 && ( defined(__GNUC__) || defined(__clang__) )
+    if ( !__builtin_cpu_supports( "avx2" ) )
+    {
+        printf( "StreamBenchmark : AVX2 is not supported, skipped.\n" );
+        return 0;
+    }
+#endif
+
+    u32 count = DEFAULT_COUNT;
+    if ( argc > 1 )
+    { count = u32( strtoul( argv[1], nullptr, 10 ) ); }
+
+    if ( count == 0 )
+    {
+        fprintf( stderr, "StreamBenchmark : Invalid Argument.\n" );
+        return -1;
+    }
+
+#if defined(ASDX_USE_AVX2) && ASDX_USE_AVX2
+    const int useAVX2 = 1;
+#else
+    const int useAVX2 = 0;
+#endif
+    printf( "StreamBenchmark : ASDX_USE_SIMD = %d, ASDX_USE_AVX2 = %d, count = %u\n", ASDX_USE_SIMD, useAVX2, count );
+
+    asdx::Matrix m;
+    for(u32 i=0; i<16; ++i)
+    { m.m[i / 4][i % 4] = Rand(); }
+    m._44 += 4.0f;
+
+    std::vector<asdx::Vector3> src3( count );
+    std::vector<asdx::Vector3> dst3( count );
+    std::vector<asdx::Vector4> src4( count );
+    std::vector<asdx::Vector4> dst4( count );
+    std::vector<Vertex>        vertices( count );
+    for(u32 i=0; i<count; ++i)
+    {
+        src3[i] = asdx::Vector3( Rand(), Rand(), Rand() );
+        src4[i] = asdx::Vector4( Rand(), Rand(), Rand(), 1.0f );
+        vertices[i].Position = src3[i];
+        vertices[i].Normal   = asdx::Vector3( 0.0f, 1.0f, 0.0f );
+        vertices[i].Tangent  = asdx::Vector3( 1.0f, 0.0f, 0.0f );
+        vertices[i].TexCoord = asdx::Vector2( Rand(), Rand() );
+    }
+
+    // 詰めた配列の位置座標.
+    {
+        auto element = Measure( [&]() {
+            for(u32 i=0; i<count; ++i)
+            { asdx::Vector3::Transform( src3[i], m, dst3[i] ); }
+        } );
+        auto stream = Measure( [&]() {
+            asdx::Vector3::TransformStream( src3.data(), sizeof(asdx::Vector3), dst3.data(), sizeof(asdx::Vector3), count, m );
+        } );
+        Print( "Vector3::TransformStream", count, element, stream );
+    }
+
+    // 詰めた配列の射影.
+    {
+        auto element = Measure( [&]() {
+            for(u32 i=0; i<count; ++i)
+            { asdx::Vector3::TransformCoord( src3[i], m, dst3[i] ); }
+        } );
+        auto stream = Measure( [&]() {
+            asdx::Vector3::TransformCoordStream( src3.data(), sizeof(asdx::Vector3), dst3.data(), sizeof(asdx::Vector3), count, m );
+        } );
+        Print( "Vector3::TransformCoordStream", count, element, stream );
+    }
+
+    // 頂点の中の法線をその場で変換.
+    // 繰り返し変換しても非正規化数にならないように回転行列を使います.
+    {
+        auto rotation = asdx::Matrix::CreateRotationFromYawPitchRoll( 0.1f, 0.2f, 0.3f );
+        auto element = Measure( [&]() {
+            for(u32 i=0; i<count; ++i)
+            {
+                asdx::Vector3 normal = vertices[i].Normal;
+                asdx::Vector3::TransformNormal( normal, rotation, vertices[i].Normal );
+            }
+        } );
+        auto stream = Measure( [&]() {
+            asdx::Vector3::TransformNormalStream( &vertices[0].Normal, sizeof(Vertex), &vertices[0].Normal, sizeof(Vertex), count, rotation );
+        } );
+        Print( "Vector3::TransformNormalStream(Vertex)", count, element, stream );
+    }
+
+    // 詰めた配列の4次元ベクトル.
+    {
+        auto element = Measure( [&]() {
+            for(u32 i=0; i<count; ++i)
+            { asdx::Vector4::Transform( src4[i], m, dst4[i] ); }
+        } );
+        auto stream = Measure( [&]() {
+            asdx::Vector4::TransformStream( src4.data(), sizeof(asdx::Vector4), dst4.data(), sizeof(asdx::Vector4), count, m );
+        } );
+        Print( "Vector4::TransformStream", count, element, stream );
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+﻿//------------------------------------------------------------------------------
+// File : RenderTargetAllocator.h
+// Desc : Render Target Allocator for D3D11.
+// Copyright(c) Project Asura. All right reserved.
+//------------------------------------------------------------------------------
+
+#ifndef __RENDER_TARGET_ALLOCATOR_H__
+#define __RENDER_TARGET_ALLOCATOR_H__
+
+//------------------------------------------------------------------------------
+// Include
+//------------------------------------------------------------------------------
+#include <asdxRenderTarget.h>
+#include "RenderTargetPool.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// RenderTargetAllocator class
+////////////////////////////////////////////////////////////////////////////////////////
+class RenderTargetAllocator : public IRenderTargetAllocator
+{
+    //==================================================================================
+    // list of friend classes and methods.
+    //==================================================================================
+    /* NOTHING */
+
+public:
+    //==================================================================================
+    // public variables.
+    //==================================================================================
+    /* NOTHING */
+
+    //==================================================================================
+    // public methods.
+    //==================================================================================
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //----------------------------------------------------------------------------------
+    RenderTargetAllocator();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    ~RenderTargetAllocator();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      初期化処理を行います.
+    //!
+    //! @param [in]     pDevice     デバイスです.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //----------------------------------------------------------------------------------
+    bool Init( ID3D11Device* pDevice );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      asdx::RenderTarget2D を生成します.
+    //!
+    //! @param [in]     desc        構成設定です. ミップ無し, マルチサンプル無しで生成します.
+    //! @return     生成した asdx::RenderTarget2D を返却します. 失敗した場合は nullptr を返却します.
+    //----------------------------------------------------------------------------------
+    void* Create( const RenderTargetDesc& desc );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      Create() で生成した asdx::RenderTarget2D を破棄します.
+    //----------------------------------------------------------------------------------
+    void Dispose( void* pTarget );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      レンダーターゲットのバイトサイズを見積もります.
+    //----------------------------------------------------------------------------------
+    u64 GetSize( const RenderTargetDesc& desc ) const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      プールが割り当てたレンダーターゲットを取得します.
+    //!
+    //! @param [in]     pool        レンダーターゲットプールです.
+    //! @param [in]     handle      仮想ターゲットのハンドルです.
+    //! @return     レンダーターゲットを返却します. 割り当てられていない場合は nullptr を返却します.
+    //----------------------------------------------------------------------------------
+    static asdx::RenderTarget2D* GetTarget( const RenderTargetPool& pool, RenderTargetPool::Handle handle );
+
+private:
+    //==================================================================================
+    // private variables.
+    //==================================================================================
+    ID3D11Device*   m_pDevice;      //!< デバイスです.
+
+    //==================================================================================
+    // private methods.
+    //==================================================================================
+    RenderTargetAllocator   ( const RenderTargetAllocator& );   // アクセス禁止.
+    void operator =         ( const RenderTargetAllocator& );   // アクセス禁止.
+};
+
+
+#endif//__RENDER_TARGET_ALLOCATOR_H__
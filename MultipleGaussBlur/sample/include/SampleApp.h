@@ -19,6 +19,16 @@
 #include <asdxFont.h>
 #include <asdxConstantBuffer.h>
 #include <asdxTexture.h>
+#include "ParamTableCache.h"
+#include "RenderTargetAllocator.h"
+
+
+//-------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------
+static const u32 CASCADE_LEVEL_COUNT    = 5;        //!< 縮小バッファの段数です.
+static const u32 BOX_PASS_COUNT         = 3;        //!< 箱型フィルタの反復回数です.
+static const u32 BOX_DEVIATION_COUNT    = 3;        //!< [S]キーで切り替える箱型フィルタの標準偏差の数です.
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +43,18 @@ struct GaussBlurParam
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////
+// BLUR_MODE enum
+////////////////////////////////////////////////////////////////////////////////////////
+enum BLUR_MODE
+{
+    BLUR_MODE_CASCADE = 0,          //!< 縮小バッファごとに15タップのブラーを掛けて合成します.
+    BLUR_MODE_BOX,                  //!< フル解像度で箱型フィルタを反復します.
+    BLUR_MODE_PYRAMID,              //!< 縮小バッファを1回のディスパッチでまとめて作ってから，段ごとに15タップのブラーを掛けて合成します.
+    NUM_BLUR_MODE,
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // SampleApplication
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -56,13 +78,35 @@ private:
     ID3D11SamplerState*         m_pLinearSampler = nullptr;      //!< ポイントサンプラー.
     ID3D11BlendState*           m_pOpequeBS     = nullptr;
     asdx::QuadRenderer          m_Quad;
-    asdx::ConstantBuffer        m_BlurBuffer;
-    asdx::RenderTarget2D        m_PingPong[12];
+    ParamTableCache             m_ParamTable;                   //!< IMMUTABLE な定数バッファのキャッシュ.
+    ParamTableCache::Handle     m_BlurTable[CASCADE_LEVEL_COUNT][2];    //!< 縮小バッファごとの横・縦のブラーテーブル.
+    RenderTargetAllocator       m_TargetAllocator;              //!< 縮小バッファのアロケータ.
+    RenderTargetPool            m_TargetPool;                   //!< 縮小バッファのプール.
+    RenderTargetPool::Handle    m_CascadeTarget[CASCADE_LEVEL_COUNT][2];   //!< 縮小バッファごとの横・縦のブラー結果.
+    ID3D11ComputeShader*        m_pBoxBlurCS    = nullptr;      //!< 箱型フィルタのコンピュートシェーダ.
+    ID3D11Texture2D*            m_pBoxTexture[2] = {};          //!< 箱型フィルタの作業テクスチャ.
+    ID3D11ShaderResourceView*   m_pBoxSRV[2]     = {};          //!< 箱型フィルタの作業テクスチャのSRV.
+    ID3D11UnorderedAccessView*  m_pBoxUAV[2]     = {};          //!< 箱型フィルタの作業テクスチャのUAV.
+    ParamTableCache::Handle     m_BoxTable[BOX_DEVIATION_COUNT][2][BOX_PASS_COUNT]; //!< 箱型フィルタのテーブル.
+    BLUR_MODE                   m_BlurMode      = BLUR_MODE_CASCADE;    //!< ブラーの方法.
+    u32                         m_BoxDeviationIndex = 0;        //!< 箱型フィルタの標準偏差の番号.
+    ID3D11ComputeShader*        m_pPyramidCS    = nullptr;      //!< 縮小バッファを1パスで作るコンピュートシェーダ.
+    ID3D11Texture2D*            m_pPyramidTexture = nullptr;    //!< 縮小バッファの全段をミップとして持つテクスチャ.
+    ID3D11ShaderResourceView*   m_pPyramidSRV[CASCADE_LEVEL_COUNT] = {};    //!< 段ごとのSRV.
+    ID3D11UnorderedAccessView*  m_pPyramidUAV[CASCADE_LEVEL_COUNT] = {};    //!< 段ごとのUAV.
+    ParamTableCache::Handle     m_PyramidTable;                 //!< 縮小バッファのサイズのテーブル.
+    ParamTableCache::Handle     m_PyramidBlurTable[CASCADE_LEVEL_COUNT][2]; //!< ピラミッドの各段を直接ぼかす横・縦のブラーテーブル.
 
     //==================================================================================
     // private methods.
     //==================================================================================
     void OnDrawText();
+    bool BuildParamTables();
+    bool CreateCascadeBuffers();
+    asdx::RenderTarget2D* GetCascadeBuffer( u32 level, u32 dir ) const;
+    ID3D11ShaderResourceView* DrawBoxBlur( ID3D11ShaderResourceView* pSrcSRV, u32 deviationIndex );
+    bool CreatePyramidTexture();
+    void DispatchPyramid( ID3D11ShaderResourceView* pSrcSRV );
 
 protected:
     //==================================================================================
@@ -0,0 +1,91 @@
+//-------------------------------------------------------------------------------------------------
+// File : BoxBlurCS.hlsl
+// Desc : Box Blur (Prefix Sum).
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+#define THREAD_COUNT    128     // 1O[ṽXbhł. 1O[v1CS܂.
+#define RING_SIZE       1024    // ݐϘaێ郊Oobt@̗vfł. a (RING_SIZE - THREAD_COUNT) / 2 ɂ܂.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CBuffer structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+cbuffer CbBoxBlur
+{
+    int2    Size     : packoffset(c0);      // 摜TCY.
+    int     Radius   : packoffset(c0.z);    // ̔a.
+    int     Vertical : packoffset(c0.w);    // cȂ1.
+};
+
+//-------------------------------------------------------------------------------------------------
+// Textures.
+//-------------------------------------------------------------------------------------------------
+Texture2D<float4>       Input  : register(t0);
+RWTexture2D<float4>     Output : register(u0);
+
+//-------------------------------------------------------------------------------------------------
+// Shared Memory.
+//-------------------------------------------------------------------------------------------------
+groupshared float4  Scan[THREAD_COUNT];     // ԓ̗ݐϘa.
+groupshared float4  Ring[RING_SIZE];        // C̐擪̗ݐϘa.
+
+
+//-------------------------------------------------------------------------------------------------
+//      CGg[|Cgł.
+//-------------------------------------------------------------------------------------------------
+[numthreads(THREAD_COUNT, 1, 1)]
+void main
+(
+    uint3 groupId  : SV_GroupID,
+    uint  threadId : SV_GroupIndex
+)
+{
+    // [NvC̗ݐϘa S(p) ƂƁCo j  (S(j + 2r + 1) - S(j)) / (2r + 1) ɂȂ.
+    // O[v THREAD_COUNT vfݐϘa߂ăOobt@ɐς݁C2r + 1 vfO̒lƂ̍o.
+    // 1sNZ̃tFb`͔aɈˑȂ.
+    int count = (Vertical != 0) ? Size.y : Size.x;
+    int last  = count - 1;
+    int lag   = Radius * 2 + 1;
+    float scale = 1.0f / float(lag);
+
+    int2 origin = (Vertical != 0) ? int2(groupId.x, 0) : int2(0, groupId.x);
+    int2 step   = (Vertical != 0) ? int2(0, 1) : int2(1, 0);
+
+    if (threadId == 0)
+    { Ring[0] = 0; }
+
+    int length = count + Radius * 2;
+    for(int base=0; base<length; base+=THREAD_COUNT)
+    {
+        // ŐԂ̃Oobt@̓ǂݍ݂Î҂.
+        GroupMemoryBarrierWithGroupSync();
+
+        int p = base + int(threadId) + 1;
+        Scan[threadId] = Input.Load(int3(origin + step * clamp(p - Radius - 1, 0, last), 0));
+        GroupMemoryBarrierWithGroupSync();
+
+        [unroll]
+        for(uint offset=1; offset<THREAD_COUNT; offset<<=1)
+        {
+            float4 value = Scan[threadId];
+            if (threadId >= offset)
+            { value += Scan[threadId - offset]; }
+            GroupMemoryBarrierWithGroupSync();
+
+            Scan[threadId] = value;
+            GroupMemoryBarrierWithGroupSync();
+        }
+
+        // ŐԂ܂ł̍v𑫂ăOobt@ɐς.
+        float4 prefix = Ring[uint(base) % RING_SIZE] + Scan[threadId];
+        Ring[uint(p) % RING_SIZE] = prefix;
+        GroupMemoryBarrierWithGroupSync();
+
+        int j = p - lag;
+        if (0 <= j && j <= last)
+        { Output[origin + step * j] = (prefix - Ring[uint(j) % RING_SIZE]) * scale; }
+    }
+}
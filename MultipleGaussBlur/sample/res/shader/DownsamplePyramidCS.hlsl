@@ -0,0 +1,148 @@
+//-------------------------------------------------------------------------------------------------
+// File : DownsamplePyramidCS.hlsl
+// Desc : Single Pass Downsample Pyramid.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+#define TILE_SIZE       32      // 1O[vS1iڂ̃eNZ()ł(glarePyramid.h Ɠ).
+#define THREAD_SIZE     16      // 1O[ṽXbh()ł.
+#define LEVEL_COUNT     5       // kobt@̒ił.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CBuffer structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+cbuffer CbPyramid
+{
+    int2    SrcSize                 : packoffset(c0);   // ͉摜̃TCY.
+    int4    LevelSize[LEVEL_COUNT]  : packoffset(c1);   // eĩTCY(xy).
+};
+
+//-------------------------------------------------------------------------------------------------
+// Textures and Samplers.
+//-------------------------------------------------------------------------------------------------
+Texture2D               ColorBuffer  : register(t0);
+SamplerState            ColorSampler : register(s0);
+RWTexture2D<float4>     Level0       : register(u0);
+RWTexture2D<float4>     Level1       : register(u1);
+RWTexture2D<float4>     Level2       : register(u2);
+RWTexture2D<float4>     Level3       : register(u3);
+RWTexture2D<float4>     Level4       : register(u4);
+
+//-------------------------------------------------------------------------------------------------
+// Shared Memory.
+//-------------------------------------------------------------------------------------------------
+groupshared float4  Cache[THREAD_SIZE * THREAD_SIZE];
+
+
+//-------------------------------------------------------------------------------------------------
+//      1iڂ̃eNZ߂܂.
+//-------------------------------------------------------------------------------------------------
+float4 FetchLevel0(int2 pos)
+{
+    // 4x4 eNZ̕ςC2x2 eNZ̒S_jATvO4ŋ߂.
+    float2 invSize = 1.0f / float2(SrcSize);
+    float2 base    = float2(pos * 4);
+
+    float4 result = 0;
+    result += ColorBuffer.SampleLevel(ColorSampler, (base + float2(1.0f, 1.0f)) * invSize, 0);
+    result += ColorBuffer.SampleLevel(ColorSampler, (base + float2(3.0f, 1.0f)) * invSize, 0);
+    result += ColorBuffer.SampleLevel(ColorSampler, (base + float2(1.0f, 3.0f)) * invSize, 0);
+    result += ColorBuffer.SampleLevel(ColorSampler, (base + float2(3.0f, 3.0f)) * invSize, 0);
+    return result * 0.25f;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      Oi 2x2 eNZLǂݍŕς܂.
+//-------------------------------------------------------------------------------------------------
+float4 AverageCache(int2 t)
+{
+    int index = (t.y * 2) * THREAD_SIZE + (t.x * 2);
+
+    float4 result = 0;
+    result += Cache[index];
+    result += Cache[index + 1];
+    result += Cache[index + THREAD_SIZE];
+    result += Cache[index + THREAD_SIZE + 1];
+    return result * 0.25f;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      CGg[|Cgł.
+//-------------------------------------------------------------------------------------------------
+[numthreads(THREAD_SIZE, THREAD_SIZE, 1)]
+void main(uint3 groupId : SV_GroupID, uint3 threadId : SV_GroupThreadID)
+{
+    // i l ̈ʒu x ͒i l-1  2x, 2x+1 猈܂̂ŁC
+    // O[vőSi؂. ͈͊ÕeNZ͏܂ȂŌvZ͑.
+    int2 t     = int2(threadId.xy);
+    int2 group = int2(groupId.xy);
+    int  index = t.y * THREAD_SIZE + t.x;
+
+    // 1i. eXbh 2x2 eNZS.
+    float4 sum = 0;
+    [unroll]
+    for(int j=0; j<2; ++j)
+    {
+        [unroll]
+        for(int i=0; i<2; ++i)
+        {
+            int2   pos   = group * TILE_SIZE + t * 2 + int2(i, j);
+            float4 color = FetchLevel0(pos);
+            if (all(pos < LevelSize[0].xy))
+            { Level0[pos] = color; }
+            sum += color;
+        }
+    }
+
+    // 2i. 1iڂ̓WX^ɎcĂ̂ŋLȂ.
+    float4 color = sum * 0.25f;
+    int2   pos   = group * (TILE_SIZE / 2) + t;
+    if (all(pos < LevelSize[1].xy))
+    { Level1[pos] = color; }
+
+    Cache[index] = color;
+    GroupMemoryBarrierWithGroupSync();
+
+    // 3i.
+    bool active = all(t < THREAD_SIZE / 2);
+    if (active)
+    {
+        color = AverageCache(t);
+        pos   = group * (TILE_SIZE / 4) + t;
+        if (all(pos < LevelSize[2].xy))
+        { Level2[pos] = color; }
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+    if (active)
+    { Cache[index] = color; }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 4i.
+    active = all(t < THREAD_SIZE / 4);
+    if (active)
+    {
+        color = AverageCache(t);
+        pos   = group * (TILE_SIZE / 8) + t;
+        if (all(pos < LevelSize[3].xy))
+        { Level3[pos] = color; }
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+    if (active)
+    { Cache[index] = color; }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 5i.
+    active = all(t < THREAD_SIZE / 8);
+    if (active)
+    {
+        color = AverageCache(t);
+        pos   = group * (TILE_SIZE / 16) + t;
+        if (all(pos < LevelSize[4].xy))
+        { Level4[pos] = color; }
+    }
+}
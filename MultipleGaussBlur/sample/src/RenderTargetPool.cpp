@@ -0,0 +1,354 @@
+﻿//---------------------------------------------------------------------------------------
+// File : RenderTargetPool.cpp
+// Desc : Transient Render Target Pool.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "RenderTargetPool.h"
+#include <algorithm>
+
+
+namespace {
+
+//---------------------------------------------------------------------------------------
+//      構成設定が等しいかどうかチェックします.
+//---------------------------------------------------------------------------------------
+bool IsSameDesc( const RenderTargetDesc& a, const RenderTargetDesc& b )
+{
+    return a.Width  == b.Width
+        && a.Height == b.Height
+        && a.Format == b.Format;
+}
+
+} // namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// NullRenderTargetAllocator class
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+NullRenderTargetAllocator::NullRenderTargetAllocator( u32 bytesPerPixel )
+: m_BytesPerPixel   ( bytesPerPixel )
+, m_FailCount       ( 0xffffffff )
+, m_LiveCount       ( 0 )
+, m_CreateCount     ( 0 )
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      デストラクタです.
+//---------------------------------------------------------------------------------------
+NullRenderTargetAllocator::~NullRenderTargetAllocator()
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      構成設定のコピーをレンダーターゲットの代わりに生成します.
+//---------------------------------------------------------------------------------------
+void* NullRenderTargetAllocator::Create( const RenderTargetDesc& desc )
+{
+    if ( m_FailCount == 0 )
+    { return nullptr; }
+
+    if ( m_FailCount != 0xffffffff )
+    { m_FailCount--; }
+
+    m_LiveCount++;
+    m_CreateCount++;
+    return new RenderTargetDesc( desc );
+}
+
+//---------------------------------------------------------------------------------------
+//      Create() で生成した構成設定を破棄します.
+//---------------------------------------------------------------------------------------
+void NullRenderTargetAllocator::Dispose( void* pTarget )
+{
+    if ( pTarget == nullptr )
+    { return; }
+
+    m_LiveCount--;
+    delete static_cast<RenderTargetDesc*>( pTarget );
+}
+
+//---------------------------------------------------------------------------------------
+//      レンダーターゲットのバイトサイズを見積もります.
+//---------------------------------------------------------------------------------------
+u64 NullRenderTargetAllocator::GetSize( const RenderTargetDesc& desc ) const
+{ return u64( desc.Width ) * desc.Height * m_BytesPerPixel; }
+
+//---------------------------------------------------------------------------------------
+//      生成に失敗させるまでの回数を設定します.
+//---------------------------------------------------------------------------------------
+void NullRenderTargetAllocator::SetFailCount( u32 count )
+{ m_FailCount = count; }
+
+//---------------------------------------------------------------------------------------
+//      生成中のレンダーターゲット数を取得します.
+//---------------------------------------------------------------------------------------
+u32 NullRenderTargetAllocator::GetLiveCount() const
+{ return m_LiveCount; }
+
+//---------------------------------------------------------------------------------------
+//      これまでに生成したレンダーターゲットの総数を取得します.
+//---------------------------------------------------------------------------------------
+u32 NullRenderTargetAllocator::GetCreateCount() const
+{ return m_CreateCount; }
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// RenderTargetPool class
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+RenderTargetPool::RenderTargetPool()
+: m_pAllocator  ( nullptr )
+, m_Virtuals    ()
+, m_Physicals   ()
+, m_Compiled    ( false )
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      デストラクタです.
+//---------------------------------------------------------------------------------------
+RenderTargetPool::~RenderTargetPool()
+{ Term(); }
+
+//---------------------------------------------------------------------------------------
+//      初期化処理を行います.
+//---------------------------------------------------------------------------------------
+bool RenderTargetPool::Init( IRenderTargetAllocator* pAllocator )
+{
+    if ( pAllocator == nullptr )
+    { return false; }
+
+    Term();
+    m_pAllocator = pAllocator;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      全てのレンダーターゲットを破棄します.
+//---------------------------------------------------------------------------------------
+void RenderTargetPool::Term()
+{
+    if ( m_pAllocator != nullptr )
+    {
+        for(size_t i=0; i<m_Physicals.size(); ++i)
+        { m_pAllocator->Dispose( m_Physicals[i].pTarget ); }
+    }
+
+    m_Physicals.clear();
+    m_Virtuals .clear();
+    m_Compiled = false;
+}
+
+//---------------------------------------------------------------------------------------
+//      パス列の宣言を開始します.
+//---------------------------------------------------------------------------------------
+void RenderTargetPool::Begin()
+{
+    m_Virtuals.clear();
+    m_Compiled = false;
+}
+
+//---------------------------------------------------------------------------------------
+//      仮想ターゲットを宣言します.
+//---------------------------------------------------------------------------------------
+RenderTargetPool::Handle RenderTargetPool::Request
+(
+    const RenderTargetDesc& desc,
+    u32                     firstPass,
+    u32                     lastPass
+)
+{
+    if ( desc.Width == 0 || desc.Height == 0 || firstPass > lastPass )
+    { return INVALID_HANDLE; }
+
+    Virtual item;
+    item.Desc      = desc;
+    item.FirstPass = firstPass;
+    item.LastPass  = lastPass;
+    item.Physical  = INVALID_HANDLE;
+
+    m_Virtuals.push_back( item );
+    m_Compiled = false;
+
+    return Handle( m_Virtuals.size() - 1 );
+}
+
+//---------------------------------------------------------------------------------------
+//      仮想ターゲットに実体を割り当てます.
+//---------------------------------------------------------------------------------------
+bool RenderTargetPool::Compile()
+{
+    if ( m_pAllocator == nullptr )
+    { return false; }
+
+    for(size_t i=0; i<m_Physicals.size(); ++i)
+    { m_Physicals[i].Claimed = false; }
+
+    // 書き込み開始が早い順に割り当てると，区間グラフの彩色になるので実体の数が最小になる.
+    std::vector<u32> order( m_Virtuals.size() );
+    for(size_t i=0; i<order.size(); ++i)
+    { order[i] = u32( i ); }
+
+    std::stable_sort( order.begin(), order.end(), [&]( u32 lhs, u32 rhs )
+    { return m_Virtuals[lhs].FirstPass < m_Virtuals[rhs].FirstPass; });
+
+    for(size_t i=0; i<order.size(); ++i)
+    {
+        auto& item = m_Virtuals[order[i]];
+
+        // 今回割り当て済みで区間が重ならない実体を優先し，次に前回の実体を使い回す.
+        auto freeIndex = INVALID_HANDLE;
+        auto keepIndex = INVALID_HANDLE;
+        for(size_t j=0; j<m_Physicals.size(); ++j)
+        {
+            const auto& physical = m_Physicals[j];
+            if ( !IsSameDesc( physical.Desc, item.Desc ) )
+            { continue; }
+
+            if ( physical.Claimed && physical.LastPass < item.FirstPass )
+            {
+                freeIndex = u32( j );
+                break;
+            }
+
+            if ( !physical.Claimed && keepIndex == INVALID_HANDLE )
+            { keepIndex = u32( j ); }
+        }
+
+        auto index = ( freeIndex != INVALID_HANDLE ) ? freeIndex : keepIndex;
+        if ( index == INVALID_HANDLE )
+        {
+            // 実体の生成は不要な実体を破棄した後に行う.
+            Physical physical;
+            physical.Desc    = item.Desc;
+            physical.pTarget = nullptr;
+
+            index = u32( m_Physicals.size() );
+            m_Physicals.push_back( physical );
+        }
+
+        m_Physicals[index].Claimed  = true;
+        m_Physicals[index].LastPass = item.LastPass;
+        item.Physical = index;
+    }
+
+    // 使わなくなった実体を破棄して詰める.
+    std::vector<u32> remap( m_Physicals.size(), u32( INVALID_HANDLE ) );
+    size_t count = 0;
+    for(size_t i=0; i<m_Physicals.size(); ++i)
+    {
+        if ( !m_Physicals[i].Claimed )
+        {
+            m_pAllocator->Dispose( m_Physicals[i].pTarget );
+            continue;
+        }
+
+        remap[i] = u32( count );
+        m_Physicals[count++] = m_Physicals[i];
+    }
+    m_Physicals.resize( count );
+
+    for(size_t i=0; i<m_Virtuals.size(); ++i)
+    { m_Virtuals[i].Physical = remap[m_Virtuals[i].Physical]; }
+
+    // 新しく必要になった実体を生成.
+    for(size_t i=0; i<m_Physicals.size(); ++i)
+    {
+        auto& physical = m_Physicals[i];
+        if ( physical.pTarget != nullptr )
+        { continue; }
+
+        physical.pTarget = m_pAllocator->Create( physical.Desc );
+        if ( physical.pTarget == nullptr )
+        { return false; }
+    }
+
+    m_Compiled = true;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      仮想ターゲットに割り当てた実体を取得します.
+//---------------------------------------------------------------------------------------
+void* RenderTargetPool::GetTarget( Handle handle ) const
+{
+    auto index = GetPhysicalIndex( handle );
+    if ( index == INVALID_HANDLE )
+    { return nullptr; }
+
+    return m_Physicals[index].pTarget;
+}
+
+//---------------------------------------------------------------------------------------
+//      仮想ターゲットに割り当てた実体の番号を取得します.
+//---------------------------------------------------------------------------------------
+u32 RenderTargetPool::GetPhysicalIndex( Handle handle ) const
+{
+    if ( !m_Compiled || handle >= m_Virtuals.size() )
+    { return INVALID_HANDLE; }
+
+    return m_Virtuals[handle].Physical;
+}
+
+//---------------------------------------------------------------------------------------
+//      宣言した仮想ターゲット数を取得します.
+//---------------------------------------------------------------------------------------
+u32 RenderTargetPool::GetVirtualCount() const
+{ return u32( m_Virtuals.size() ); }
+
+//---------------------------------------------------------------------------------------
+//      生成済みの実体の数を取得します.
+//---------------------------------------------------------------------------------------
+u32 RenderTargetPool::GetPhysicalCount() const
+{
+    u32 count = 0;
+    for(size_t i=0; i<m_Physicals.size(); ++i)
+    {
+        if ( m_Physicals[i].pTarget != nullptr )
+        { count++; }
+    }
+
+    return count;
+}
+
+//---------------------------------------------------------------------------------------
+//      仮想ターゲットごとに実体を生成した場合のバイトサイズを取得します.
+//---------------------------------------------------------------------------------------
+u64 RenderTargetPool::GetRequestedSize() const
+{
+    if ( m_pAllocator == nullptr )
+    { return 0; }
+
+    u64 size = 0;
+    for(size_t i=0; i<m_Virtuals.size(); ++i)
+    { size += m_pAllocator->GetSize( m_Virtuals[i].Desc ); }
+
+    return size;
+}
+
+//---------------------------------------------------------------------------------------
+//      生成済みの実体のバイトサイズを取得します.
+//---------------------------------------------------------------------------------------
+u64 RenderTargetPool::GetAllocatedSize() const
+{
+    if ( m_pAllocator == nullptr )
+    { return 0; }
+
+    u64 size = 0;
+    for(size_t i=0; i<m_Physicals.size(); ++i)
+    {
+        if ( m_Physicals[i].pTarget != nullptr )
+        { size += m_pAllocator->GetSize( m_Physicals[i].Desc ); }
+    }
+
+    return size;
+}
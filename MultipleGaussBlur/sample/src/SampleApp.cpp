@@ -19,6 +19,57 @@ namespace {
 #include "../res/shader/Compiled/GaussBlurPS.inc"
 #include "../res/shader/Compiled/CopyPS.inc"
 #include "../res/shader/Compiled/CompositePS.inc"
+#include "../res/shader/Compiled/BoxBlurCS.inc"
+#include "../res/shader/Compiled/DownsamplePyramidCS.inc"
+
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const s32   BOX_BLUR_MAX_RADIUS    = 447;      //!< BoxBlurCS.hlsl のリングバッファで扱える最大半径です((RING_SIZE - THREAD_COUNT) / 2 未満).
+static const u32   PYRAMID_TILE_SIZE      = 32;       //!< DownsamplePyramidCS.hlsl の1グループが担当する1段目のテクセル数(一辺)です.
+static const float CASCADE_DEVIATION      = 2.5f;     //!< 縮小バッファごとのブラーの標準偏差です.
+
+// 箱型フィルタの標準偏差(フル解像度のテクセル).
+static const float BOX_DEVIATIONS[BOX_DEVIATION_COUNT] = { 5.0f, 16.0f, 64.0f };
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// BoxBlurParam structure
+//////////////////////////////////////////////////////////////////////////////////////////
+ASDX_ALIGN(16)
+struct BoxBlurParam
+{
+    s32     Width;          //!< 画像の横幅です.
+    s32     Height;         //!< 画像の縦幅です.
+    s32     Radius;         //!< 箱の半径です.
+    s32     Vertical;       //!< 縦方向なら1です.
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// PyramidParam structure
+//////////////////////////////////////////////////////////////////////////////////////////
+ASDX_ALIGN(16)
+struct PyramidParam
+{
+    s32     SrcWidth;                           //!< 入力画像の横幅です.
+    s32     SrcHeight;                          //!< 入力画像の縦幅です.
+    s32     Dummy[2];
+    s32     LevelSize[CASCADE_LEVEL_COUNT][4];  //!< 各段のサイズ(xy)です.
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// BlurTableKey structure
+//////////////////////////////////////////////////////////////////////////////////////////
+struct BlurTableKey
+{
+    s32     Width;          //!< レンダーターゲットの横幅です.
+    s32     Height;         //!< レンダーターゲットの縦幅です.
+    float   DirX;           //!< ブラー方向のX成分です.
+    float   DirY;           //!< ブラー方向のY成分です.
+    float   Deviation;      //!< 標準偏差です.
+    float   Multiply;       //!< 重みに掛ける係数です.
+};
 
 //-------------------------------------------------------------------------------------------------
 //      ガウスの重みを計算します.
@@ -66,6 +117,45 @@ inline GaussBlurParam CalcBlurParam( int width, int height, asdx::Vector2 dir, f
     return result;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      ガウス分布を近似する箱型フィルタの半径を計算します.
+//-------------------------------------------------------------------------------------------------
+inline void CalcBoxRadius( float deviation, s32* pRadius )
+{
+    // 幅 w の箱の分散は (w^2 - 1) / 12 なので，n 回で分散 σ^2 になる幅を求め，
+    // 前後の奇数幅 wl, wl + 2 を m 回と n - m 回ずつ使う.
+    auto n        = float(BOX_PASS_COUNT);
+    auto variance = deviation * deviation;
+    auto ideal    = sqrtf( 12.0f * variance / n + 1.0f );
+
+    auto wl = s32( floorf( ideal ) );
+    if ( ( wl & 1 ) == 0 )
+    { wl--; }
+    if ( wl < 1 )
+    { wl = 1; }
+
+    auto fwl = float(wl);
+    auto m   = s32( floorf( ( 12.0f * variance - n * fwl * fwl - 4.0f * n * fwl - 3.0f * n ) / ( -4.0f * fwl - 4.0f ) + 0.5f ) );
+
+    for(u32 i=0; i<BOX_PASS_COUNT; ++i)
+    { pRadius[i] = ( ( s32(i) < m ) ? wl : wl + 2 ) / 2; }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      縮小バッファの段を直接ぼかす場合の標準偏差を計算します.
+//-------------------------------------------------------------------------------------------------
+inline float CalcPyramidDeviation( u32 level )
+{
+    // カスケードは前段のブラー結果をさらにぼかすので，1段目のテクセル単位の分散は
+    // CASCADE_DEVIATION^2 * (1 + 4 + ... + 4^level) になる.
+    // ピラミッドの段は入力の 4 * 2^level テクセル四方の箱型平均なので，その分散を差し引いた残りをこの段のガウスで補う.
+    auto scale    = float( 1u << level );
+    auto cascade  = CASCADE_DEVIATION * CASCADE_DEVIATION * ( 4.0f * scale * scale - 1.0f ) / 3.0f;
+    auto width    = 4.0f * scale;
+    auto box      = ( width * width - 1.0f ) / ( 12.0f * 16.0f );
+    return sqrtf( cascade - box ) / scale;
+}
+
 
 } // namespace 
 
@@ -210,43 +300,286 @@ bool SampleApplication::OnInit()
    }
 
    {
-      if ( !m_BlurBuffer.Create(m_pDevice, sizeof(GaussBlurParam)))
-      { return false; }
+       if ( !m_TargetAllocator.Init( m_pDevice ) )
+       { return false; }
+
+       if ( !m_TargetPool.Init( &m_TargetAllocator ) )
+       { return false; }
+
+       if ( !CreateCascadeBuffers() )
+       { return false; }
    }
 
+    {
+        hr = m_pDevice->CreateComputeShader(BoxBlurCS, sizeof(BoxBlurCS), nullptr, &m_pBoxBlurCS);
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11Device::CreateComputeShader() Failed." );
+            return false;
+        }
+    }
+
    {
-       asdx::RenderTarget2D::Description desc;
-       desc.Width               = m_Width  / 4;
-       desc.Height              = m_Height / 4;
+       // 箱型フィルタはフル解像度で処理する.
+       D3D11_TEXTURE2D_DESC desc = {};
+       desc.Width               = m_Width;
+       desc.Height              = m_Height;
        desc.MipLevels           = 1;
        desc.ArraySize           = 1;
-       desc.Format              = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+       desc.Format              = DXGI_FORMAT_R16G16B16A16_FLOAT;
        desc.SampleDesc.Count    = 1;
        desc.SampleDesc.Quality  = 0;
+       desc.Usage               = D3D11_USAGE_DEFAULT;
+       desc.BindFlags           = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
 
-       for(auto i=0; i<12; i+=2)
+       for(auto i=0; i<2; ++i)
        {
-           if (!m_PingPong[i + 0].Create(m_pDevice, desc))
-           { return false; }
-
-           if (!m_PingPong[i + 1].Create(m_pDevice, desc))
-           { return false; }
-
-           desc.Width  >>= 1;
-           desc.Height >>= 1;
+           hr = m_pDevice->CreateTexture2D( &desc, nullptr, &m_pBoxTexture[i] );
+           if ( FAILED(hr) )
+           {
+               ELOG( "Error : ID3D11Device::CreateTexture2D() Failed." );
+               return false;
+           }
+
+           hr = m_pDevice->CreateShaderResourceView( m_pBoxTexture[i], nullptr, &m_pBoxSRV[i] );
+           if ( FAILED(hr) )
+           {
+               ELOG( "Error : ID3D11Device::CreateShaderResourceView() Failed." );
+               return false;
+           }
+
+           hr = m_pDevice->CreateUnorderedAccessView( m_pBoxTexture[i], nullptr, &m_pBoxUAV[i] );
+           if ( FAILED(hr) )
+           {
+               ELOG( "Error : ID3D11Device::CreateUnorderedAccessView() Failed." );
+               return false;
+           }
        }
    }
 
+    {
+        hr = m_pDevice->CreateComputeShader(DownsamplePyramidCS, sizeof(DownsamplePyramidCS), nullptr, &m_pPyramidCS);
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11Device::CreateComputeShader() Failed." );
+            return false;
+        }
+
+        if ( !CreatePyramidTexture() )
+        { return false; }
+    }
+
+    if ( !BuildParamTables() )
+    { return false; }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      縮小バッファの全段をミップとして持つテクスチャを生成します.
+//---------------------------------------------------------------------------------------
+bool SampleApplication::CreatePyramidTexture()
+{
+    // ミップのサイズは前段の切り捨てなので，縮小バッファと同じサイズになる.
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width              = m_Width  / 4;
+    desc.Height             = m_Height / 4;
+    desc.MipLevels          = CASCADE_LEVEL_COUNT;
+    desc.ArraySize          = 1;
+    desc.Format             = DXGI_FORMAT_R16G16B16A16_FLOAT;
+    desc.SampleDesc.Count   = 1;
+    desc.SampleDesc.Quality = 0;
+    desc.Usage              = D3D11_USAGE_DEFAULT;
+    desc.BindFlags          = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+    auto hr = m_pDevice->CreateTexture2D( &desc, nullptr, &m_pPyramidTexture );
+    if ( FAILED(hr) )
+    {
+        ELOG( "Error : ID3D11Device::CreateTexture2D() Failed." );
+        return false;
+    }
+
+    for(u32 i=0; i<CASCADE_LEVEL_COUNT; ++i)
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format                      = desc.Format;
+        srvDesc.ViewDimension               = D3D11_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Texture2D.MostDetailedMip   = i;
+        srvDesc.Texture2D.MipLevels         = 1;
+
+        hr = m_pDevice->CreateShaderResourceView( m_pPyramidTexture, &srvDesc, &m_pPyramidSRV[i] );
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11Device::CreateShaderResourceView() Failed." );
+            return false;
+        }
+
+        D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+        uavDesc.Format              = desc.Format;
+        uavDesc.ViewDimension       = D3D11_UAV_DIMENSION_TEXTURE2D;
+        uavDesc.Texture2D.MipSlice  = i;
+
+        hr = m_pDevice->CreateUnorderedAccessView( m_pPyramidTexture, &uavDesc, &m_pPyramidUAV[i] );
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11Device::CreateUnorderedAccessView() Failed." );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      選択中のブラーの方法で縮小バッファを生成します.
+//---------------------------------------------------------------------------------------
+bool SampleApplication::CreateCascadeBuffers()
+{
+    // 段 i の横ブラーがパス 2i, 縦ブラーがパス 2i+1, コンポジットがパス 2L.
+    // 横ブラーの結果は縦ブラーで読み終わり，縦ブラーの結果は次の段の縮小とコンポジットで読む.
+    // 箱型フィルタでは縮小バッファを使わないので宣言せず，実体を解放する.
+    m_TargetPool.Begin();
+
+    if (m_BlurMode != BLUR_MODE_BOX)
+    {
+        RenderTargetDesc desc;
+        desc.Width  = m_Width  / 4;
+        desc.Height = m_Height / 4;
+        desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+
+        for(u32 i=0; i<CASCADE_LEVEL_COUNT; ++i)
+        {
+            m_CascadeTarget[i][0] = m_TargetPool.Request( desc, i * 2 + 0, i * 2 + 1 );
+            m_CascadeTarget[i][1] = m_TargetPool.Request( desc, i * 2 + 1, CASCADE_LEVEL_COUNT * 2 );
+
+            desc.Width  >>= 1;
+            desc.Height >>= 1;
+        }
+    }
+    else
+    {
+        for(u32 i=0; i<CASCADE_LEVEL_COUNT; ++i)
+        {
+            m_CascadeTarget[i][0] = RenderTargetPool::INVALID_HANDLE;
+            m_CascadeTarget[i][1] = RenderTargetPool::INVALID_HANDLE;
+        }
+    }
+
+    if ( !m_TargetPool.Compile() )
+    {
+        ELOG( "Error : RenderTargetPool::Compile() Failed." );
+        return false;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      縮小バッファを取得します.
+//---------------------------------------------------------------------------------------
+asdx::RenderTarget2D* SampleApplication::GetCascadeBuffer( u32 level, u32 dir ) const
+{ return RenderTargetAllocator::GetTarget( m_TargetPool, m_CascadeTarget[level][dir] ); }
+
+//---------------------------------------------------------------------------------------
+//      ブラーのパラメータテーブルを事前に計算します.
+//---------------------------------------------------------------------------------------
+bool SampleApplication::BuildParamTables()
+{
+    // 縮小バッファごとに縦横のテーブルを作る. 以降のフレームでは定数バッファを設定するだけになる.
+    // ピラミッドは各段を独立にぼかすので，カスケードと同じ広がりになる標準偏差のテーブルを別に作る.
+    auto w = m_Width  / 4;
+    auto h = m_Height / 4;
+    auto m = 1.0f;
+    for(u32 i=0; i<CASCADE_LEVEL_COUNT; ++i)
+    {
+        for(auto dir=0; dir<2; ++dir)
+        {
+            BlurTableKey key = {};
+            key.Width     = w;
+            key.Height    = h;
+            key.DirX      = ( dir == 0 ) ? 1.0f : 0.0f;
+            key.DirY      = ( dir == 0 ) ? 0.0f : 1.0f;
+            key.Deviation = CASCADE_DEVIATION;
+            key.Multiply  = m;
+
+            m_BlurTable[i][dir] = m_ParamTable.Acquire<GaussBlurParam>( m_pDevice, key, [&]()
+            { return CalcBlurParam( key.Width, key.Height, asdx::Vector2( key.DirX, key.DirY ), key.Deviation, key.Multiply ); });
+
+            if ( m_BlurTable[i][dir] == ParamTableCache::INVALID_HANDLE )
+            { return false; }
+
+            key.Deviation = CalcPyramidDeviation( i );
+            m_PyramidBlurTable[i][dir] = m_ParamTable.Acquire<GaussBlurParam>( m_pDevice, key, [&]()
+            { return CalcBlurParam( key.Width, key.Height, asdx::Vector2( key.DirX, key.DirY ), key.Deviation, key.Multiply ); });
+
+            if ( m_PyramidBlurTable[i][dir] == ParamTableCache::INVALID_HANDLE )
+            { return false; }
+        }
+
+        w >>= 1;
+        h >>= 1;
+        m *= 2.0f;
+    }
+
+    // 縮小バッファのサイズ. パラメータがそのままキーになる.
+    {
+        PyramidParam param = {};
+        param.SrcWidth  = m_Width;
+        param.SrcHeight = m_Height;
+
+        auto w = m_Width  / 4;
+        auto h = m_Height / 4;
+        for(u32 i=0; i<CASCADE_LEVEL_COUNT; ++i)
+        {
+            param.LevelSize[i][0] = ( w > 0 ) ? w : 1;
+            param.LevelSize[i][1] = ( h > 0 ) ? h : 1;
+            w >>= 1;
+            h >>= 1;
+        }
+
+        m_PyramidTable = m_ParamTable.Register( m_pDevice, &param, sizeof(param), &param, sizeof(param) );
+        if ( m_PyramidTable == ParamTableCache::INVALID_HANDLE )
+        { return false; }
+    }
+
+    // 箱型フィルタは標準偏差・方向・反復ごとにテーブルを作る. パラメータがそのままキーになる.
+    for(u32 i=0; i<BOX_DEVIATION_COUNT; ++i)
+    {
+        s32 radius[BOX_PASS_COUNT];
+        CalcBoxRadius( BOX_DEVIATIONS[i], radius );
+
+        for(auto dir=0; dir<2; ++dir)
+        {
+            for(u32 j=0; j<BOX_PASS_COUNT; ++j)
+            {
+                BoxBlurParam param;
+                param.Width    = m_Width;
+                param.Height   = m_Height;
+                param.Radius   = radius[j];
+                param.Vertical = dir;
+
+                if ( param.Radius > BOX_BLUR_MAX_RADIUS )
+                {
+                    ELOG( "Error : Box Blur Radius Out Of Range. radius = %d", param.Radius );
+                    return false;
+                }
+
+                m_BoxTable[i][dir][j] = m_ParamTable.Register( m_pDevice, &param, sizeof(param), &param, sizeof(param) );
+                if ( m_BoxTable[i][dir][j] == ParamTableCache::INVALID_HANDLE )
+                { return false; }
+            }
+        }
+    }
+
     return true;
 }
 
 void SampleApplication::OnTerm()
 {
-    for(auto i=0; i<12; i++)
-    { m_PingPong[i].Release(); }
+    m_TargetPool.Term();
     m_Font.Term();
     m_InputTexture.Release();
-    m_BlurBuffer.Release();
+    m_ParamTable.Term();
     m_Quad.Term();
     ASDX_RELEASE( m_pOpequeBS );
     ASDX_RELEASE( m_pPointSampler );
@@ -254,6 +587,20 @@ void SampleApplication::OnTerm()
     ASDX_RELEASE( m_pGaussBlurPS );
     ASDX_RELEASE( m_pCopyPS );
     ASDX_RELEASE( m_pFullScreenVS );
+    ASDX_RELEASE( m_pBoxBlurCS );
+    for(auto i=0; i<2; ++i)
+    {
+        ASDX_RELEASE( m_pBoxUAV[i] );
+        ASDX_RELEASE( m_pBoxSRV[i] );
+        ASDX_RELEASE( m_pBoxTexture[i] );
+    }
+    ASDX_RELEASE( m_pPyramidCS );
+    for(u32 i=0; i<CASCADE_LEVEL_COUNT; ++i)
+    {
+        ASDX_RELEASE( m_pPyramidUAV[i] );
+        ASDX_RELEASE( m_pPyramidSRV[i] );
+    }
+    ASDX_RELEASE( m_pPyramidTexture );
 }
 
 //---------------------------------------------------------------------------------------
@@ -272,6 +619,25 @@ void SampleApplication::OnDrawText()
     m_Font.Begin( m_pDeviceContext );
     {
         m_Font.DrawStringArg( 10, 10, "FPS : %.2f", GetFPS() );
+
+        if (m_BlurMode == BLUR_MODE_BOX)
+        {
+            m_Font.DrawStringArg( 10, 30, "Blur : Box x %u, Deviation : %.1f ([B] [S] Key)",
+                BOX_PASS_COUNT, BOX_DEVIATIONS[m_BoxDeviationIndex] );
+        }
+        else if (m_BlurMode == BLUR_MODE_PYRAMID)
+        {
+            auto groupX = ( m_Width  / 4 + PYRAMID_TILE_SIZE - 1 ) / PYRAMID_TILE_SIZE;
+            auto groupY = ( m_Height / 4 + PYRAMID_TILE_SIZE - 1 ) / PYRAMID_TILE_SIZE;
+            m_Font.DrawStringArg( 10, 30, "Blur : Pyramid ([B] Key), Downsample : 1 Dispatch x %u Groups", groupX * groupY );
+        }
+        else
+        { m_Font.DrawStringArg( 10, 30, "Blur : Cascade ([B] Key)" ); }
+
+        m_Font.DrawStringArg( 10, 50, "Targets : %u -> %u (%.1f MB -> %.1f MB)",
+            m_TargetPool.GetVirtualCount(), m_TargetPool.GetPhysicalCount(),
+            m_TargetPool.GetRequestedSize() / ( 1024.0 * 1024.0 ),
+            m_TargetPool.GetAllocatedSize() / ( 1024.0 * 1024.0 ) );
     }
     m_Font.End( m_pDeviceContext );
 }
@@ -282,19 +648,17 @@ void SampleApplication::OnDrawText()
 void SampleApplication::OnFrameRender( double time, double elapsedTime )
 {
     auto pSrcSRV = m_InputTexture.GetSRV();
-    auto pDstRTV = m_PingPong[0].GetRTV();
+    ID3D11RenderTargetView* pDstRTV = nullptr;
 
     auto w = m_Width  / 4;
     auto h = m_Height / 4;
-    auto deviation = 2.5f;
 
-    // 最初のパス.
-    {
-        // クリア処理.
-        m_pDeviceContext->ClearRenderTargetView( pDstRTV, m_ClearColor );
+    ID3D11ShaderResourceView* pBoxResult = nullptr;
 
-        // 出力マネージャに設定.
-        m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
+    if (m_BlurMode == BLUR_MODE_BOX)
+    {
+        // 標準偏差に依存しないコストでフル解像度のブラーを掛ける.
+        pBoxResult = DrawBoxBlur( pSrcSRV, m_BoxDeviationIndex );
 
         float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         UINT sampleMask = D3D11_DEFAULT_SAMPLE_MASK;
@@ -302,158 +666,181 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
         m_pDeviceContext->RSSetState( m_pRasterizerState );
         m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
         m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
+    }
+    else
+    {
+        // 全段の縮小を先に1回のディスパッチで済ませ，各段はミップから読み込む.
+        // 前段のブラー結果を経由しないので，各段はカスケードと同じ広がりになる標準偏差でぼかす.
+        auto pBlurTable = ( m_BlurMode == BLUR_MODE_PYRAMID ) ? m_PyramidBlurTable : m_BlurTable;
+        if (m_BlurMode == BLUR_MODE_PYRAMID)
+        {
+            DispatchPyramid( pSrcSRV );
+            pSrcSRV = m_pPyramidSRV[0];
+        }
 
-        // シェーダの設定.
-        m_pDeviceContext->VSSetShader( m_pFullScreenVS, nullptr, 0 );
-        m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->PSSetShader( m_pGaussBlurPS, nullptr, 0 );
-
-        // シェーダリソースビューを設定.
-        auto pSRV = m_InputTexture.GetSRV();
-        m_pDeviceContext->PSSetShaderResources( 0, 1, &pSrcSRV );
-        m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
-
-        D3D11_VIEWPORT viewport;
-        viewport.TopLeftX   = 0;
-        viewport.TopLeftY   = 0;
-        viewport.Width      = float(w);
-        viewport.Height     = float(h);
-        viewport.MinDepth   = 0.0f;
-        viewport.MaxDepth   = 1.0f;
-
-        m_pDeviceContext->RSSetViewports( 1, &viewport );
-
-        auto pCB = m_BlurBuffer.GetBuffer();
-        GaussBlurParam src = CalcBlurParam(w, h, asdx::Vector2(1.0f, 0.0f), deviation, 1.0f);
-        m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &src, 0, 0 );
-        m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+        pDstRTV = GetCascadeBuffer( 0, 0 )->GetRTV();
 
-        // 描画.
-        m_Quad.Draw(m_pDeviceContext);
+        // 最初のパス.
+        {
+            // クリア処理.
+            m_pDeviceContext->ClearRenderTargetView( pDstRTV, m_ClearColor );
+
+            // 出力マネージャに設定.
+            m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
+
+            float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            UINT sampleMask = D3D11_DEFAULT_SAMPLE_MASK;
+            // ステートを設定.
+            m_pDeviceContext->RSSetState( m_pRasterizerState );
+            m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
+            m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
+
+            // シェーダの設定.
+            m_pDeviceContext->VSSetShader( m_pFullScreenVS, nullptr, 0 );
+            m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
+            m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
+            m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
+            m_pDeviceContext->PSSetShader( m_pGaussBlurPS, nullptr, 0 );
+
+            // シェーダリソースビューを設定.
+            auto pSRV = m_InputTexture.GetSRV();
+            m_pDeviceContext->PSSetShaderResources( 0, 1, &pSrcSRV );
+            m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
+
+            D3D11_VIEWPORT viewport;
+            viewport.TopLeftX   = 0;
+            viewport.TopLeftY   = 0;
+            viewport.Width      = float(w);
+            viewport.Height     = float(h);
+            viewport.MinDepth   = 0.0f;
+            viewport.MaxDepth   = 1.0f;
+
+            m_pDeviceContext->RSSetViewports( 1, &viewport );
+
+            auto pCB = m_ParamTable.GetBuffer( pBlurTable[0][0] );
+            m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+
+            // 描画.
+            m_Quad.Draw(m_pDeviceContext);
 
  
-        pDstRTV = m_PingPong[1].GetRTV();
+            pDstRTV = GetCascadeBuffer( 0, 1 )->GetRTV();
 
-        // クリア処理.
-        m_pDeviceContext->ClearRenderTargetView( pDstRTV, m_ClearColor );
+            // クリア処理.
+            m_pDeviceContext->ClearRenderTargetView( pDstRTV, m_ClearColor );
 
-        // 出力マネージャに設定.
-        m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
-
-        // シェーダリソースビューを設定.
-        pSRV = m_PingPong[0].GetSRV();
-        m_pDeviceContext->PSSetShaderResources( 0, 1, &pSRV );
-        m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
-
-        src = CalcBlurParam(w, h, asdx::Vector2(0.0f, 1.0f), deviation, 1.0f);
-
-        m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &src, 0, 0 );
-        m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
-
-        // ステートを設定.
-        m_pDeviceContext->RSSetState( m_pRasterizerState );
-        m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
-        m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
-
-        // 描画.
-        m_Quad.Draw(m_pDeviceContext);
+            // 出力マネージャに設定.
+            m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
 
-        // シェーダリソースをクリア.
-        ID3D11ShaderResourceView* nullTarget[1] = { nullptr };
-        m_pDeviceContext->PSSetShaderResources( 0, 1, nullTarget );
+            // シェーダリソースビューを設定.
+            pSRV = GetCascadeBuffer( 0, 0 )->GetSRV();
+            m_pDeviceContext->PSSetShaderResources( 0, 1, &pSRV );
+            m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
 
-        w >>= 1;
-        h >>= 1;
+            pCB = m_ParamTable.GetBuffer( pBlurTable[0][1] );
+            m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
 
-        pDstRTV = m_PingPong[2].GetRTV();
-        pSrcSRV = m_PingPong[1].GetSRV();
-    }
-
-    float m = 2.0f;
-    for(auto i=1; i<5; ++i)
-    {
-        // クリア処理.
-        m_pDeviceContext->ClearRenderTargetView( pDstRTV, m_ClearColor );
-
-        // 出力マネージャに設定.
-        m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
-
-        float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        UINT sampleMask = D3D11_DEFAULT_SAMPLE_MASK;
-        // ステートを設定.
-        m_pDeviceContext->RSSetState( m_pRasterizerState );
-        m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
-        m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
-
-        // シェーダの設定.
-        m_pDeviceContext->VSSetShader( m_pFullScreenVS, nullptr, 0 );
-        m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->PSSetShader( m_pGaussBlurPS, nullptr, 0 );
+            // ステートを設定.
+            m_pDeviceContext->RSSetState( m_pRasterizerState );
+            m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
+            m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
 
-        // シェーダリソースビューを設定.
-        auto pSRV = m_InputTexture.GetSRV();
-        m_pDeviceContext->PSSetShaderResources( 0, 1, &pSrcSRV );
-        m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
+            // 描画.
+            m_Quad.Draw(m_pDeviceContext);
 
-        D3D11_VIEWPORT viewport;
-        viewport.TopLeftX   = 0;
-        viewport.TopLeftY   = 0;
-        viewport.Width      = float(w);
-        viewport.Height     = float(h);
-        viewport.MinDepth   = 0.0f;
-        viewport.MaxDepth   = 1.0f;
+            // シェーダリソースをクリア.
+            ID3D11ShaderResourceView* nullTarget[1] = { nullptr };
+            m_pDeviceContext->PSSetShaderResources( 0, 1, nullTarget );
 
-        m_pDeviceContext->RSSetViewports( 1, &viewport );
+            w >>= 1;
+            h >>= 1;
 
-        auto pCB = m_BlurBuffer.GetBuffer();
-        GaussBlurParam src = CalcBlurParam(w, h, asdx::Vector2(1.0f, 0.0f), deviation, m);
-        m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &src, 0, 0 );
-        m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+            pDstRTV = GetCascadeBuffer( 1, 0 )->GetRTV();
+            pSrcSRV = ( m_BlurMode == BLUR_MODE_PYRAMID ) ? m_pPyramidSRV[1] : GetCascadeBuffer( 0, 1 )->GetSRV();
+        }
 
-        // 描画.
-        m_Quad.Draw(m_pDeviceContext);
+        for(u32 i=1; i<CASCADE_LEVEL_COUNT; ++i)
+        {
+            // クリア処理.
+            m_pDeviceContext->ClearRenderTargetView( pDstRTV, m_ClearColor );
+
+            // 出力マネージャに設定.
+            m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
+
+            float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            UINT sampleMask = D3D11_DEFAULT_SAMPLE_MASK;
+            // ステートを設定.
+            m_pDeviceContext->RSSetState( m_pRasterizerState );
+            m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
+            m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
+
+            // シェーダの設定.
+            m_pDeviceContext->VSSetShader( m_pFullScreenVS, nullptr, 0 );
+            m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
+            m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
+            m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
+            m_pDeviceContext->PSSetShader( m_pGaussBlurPS, nullptr, 0 );
+
+            // シェーダリソースビューを設定.
+            auto pSRV = m_InputTexture.GetSRV();
+            m_pDeviceContext->PSSetShaderResources( 0, 1, &pSrcSRV );
+            m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
+
+            D3D11_VIEWPORT viewport;
+            viewport.TopLeftX   = 0;
+            viewport.TopLeftY   = 0;
+            viewport.Width      = float(w);
+            viewport.Height     = float(h);
+            viewport.MinDepth   = 0.0f;
+            viewport.MaxDepth   = 1.0f;
+
+            m_pDeviceContext->RSSetViewports( 1, &viewport );
+
+            auto pCB = m_ParamTable.GetBuffer( pBlurTable[i][0] );
+            m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+
+            // 描画.
+            m_Quad.Draw(m_pDeviceContext);
 
  
-        pDstRTV = m_PingPong[i * 2 + 1].GetRTV();
+            pDstRTV = GetCascadeBuffer( i, 1 )->GetRTV();
 
-       // クリア処理.
-        m_pDeviceContext->ClearRenderTargetView( pDstRTV, m_ClearColor );
+           // クリア処理.
+            m_pDeviceContext->ClearRenderTargetView( pDstRTV, m_ClearColor );
 
-        // 出力マネージャに設定.
-        m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
+            // 出力マネージャに設定.
+            m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
 
-        // シェーダリソースビューを設定.
-        pSRV = m_PingPong[i * 2 + 0].GetSRV();
-        m_pDeviceContext->PSSetShaderResources( 0, 1, &pSRV );
-        m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
+            // シェーダリソースビューを設定.
+            pSRV = GetCascadeBuffer( i, 0 )->GetSRV();
+            m_pDeviceContext->PSSetShaderResources( 0, 1, &pSRV );
+            m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
 
-        src = CalcBlurParam(w, h, asdx::Vector2(0.0f, 1.0f), deviation, m);
+            pCB = m_ParamTable.GetBuffer( pBlurTable[i][1] );
+            m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
 
-        m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &src, 0, 0 );
-        m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
+            // ステートを設定.
+            m_pDeviceContext->RSSetState( m_pRasterizerState );
+            m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
+            m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
 
-        // ステートを設定.
-        m_pDeviceContext->RSSetState( m_pRasterizerState );
-        m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
-        m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
+            // 描画.
+            m_Quad.Draw(m_pDeviceContext);
 
-        // 描画.
-        m_Quad.Draw(m_pDeviceContext);
+            // シェーダリソースをクリア.
+            ID3D11ShaderResourceView* nullTarget[1] = { nullptr };
+            m_pDeviceContext->PSSetShaderResources( 0, 1, nullTarget );
 
-        // シェーダリソースをクリア.
-        ID3D11ShaderResourceView* nullTarget[1] = { nullptr };
-        m_pDeviceContext->PSSetShaderResources( 0, 1, nullTarget );
+            w >>= 1;
+            h >>= 1;
 
-        w >>= 1;
-        h >>= 1;
-        m *= 2.0f;
-
-        pDstRTV = m_PingPong[i * 2 + 2].GetRTV();
-        pSrcSRV = m_PingPong[i * 2 + 1].GetSRV();
+            // 最後の段では次の段の縮小バッファは無い.
+            if ( i + 1 < CASCADE_LEVEL_COUNT )
+            {
+                pDstRTV = GetCascadeBuffer( i + 1, 0 )->GetRTV();
+                pSrcSRV = ( m_BlurMode == BLUR_MODE_PYRAMID ) ? m_pPyramidSRV[i + 1] : GetCascadeBuffer( i, 1 )->GetSRV();
+            }
+        }
     }
 
     {
@@ -484,15 +871,17 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
         m_pDeviceContext->PSSetShader( m_pCopyPS, nullptr, 0 );
 
         // シェーダリソースビューを設定.
-        ID3D11ShaderResourceView* pSRV[] = {
-            m_InputTexture.GetSRV(),
-            m_PingPong[1].GetSRV(),
-            m_PingPong[3].GetSRV(),
-            m_PingPong[5].GetSRV(),
-            m_PingPong[7].GetSRV(),
-            m_PingPong[9].GetSRV(),
-            m_PingPong[11].GetSRV()
-        };
+        // 使わないスロットは nullptr のままにする(0 が読まれる).
+        ID3D11ShaderResourceView* pSRV[7] = { m_InputTexture.GetSRV() };
+
+        // 箱型フィルタの場合は入力画像とブラー結果だけを合成する.
+        if (m_BlurMode == BLUR_MODE_BOX)
+        { pSRV[1] = pBoxResult; }
+        else
+        {
+            for(u32 i=0; i<CASCADE_LEVEL_COUNT; ++i)
+            { pSRV[i + 1] = GetCascadeBuffer( i, 1 )->GetSRV(); }
+        }
         m_pDeviceContext->PSSetShaderResources( 0, 7, pSRV );
         m_pDeviceContext->PSSetSamplers( 0, 1, &m_pLinearSampler );
 
@@ -512,6 +901,74 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
 }
 
 
+//---------------------------------------------------------------------------------------
+//      箱型フィルタを縦横に反復してブラーを掛けます.
+//---------------------------------------------------------------------------------------
+ID3D11ShaderResourceView* SampleApplication::DrawBoxBlur( ID3D11ShaderResourceView* pSrcSRV, u32 deviationIndex )
+{
+    auto pSRV = pSrcSRV;
+    auto index = 0;
+
+    ID3D11ShaderResourceView*  nullSRV = nullptr;
+    ID3D11UnorderedAccessView* nullUAV = nullptr;
+
+    m_pDeviceContext->CSSetShader( m_pBoxBlurCS, nullptr, 0 );
+
+    for(auto dir=0; dir<2; ++dir)
+    {
+        for(u32 i=0; i<BOX_PASS_COUNT; ++i)
+        {
+            auto pCB = m_ParamTable.GetBuffer( m_BoxTable[deviationIndex][dir][i] );
+            m_pDeviceContext->CSSetConstantBuffers( 0, 1, &pCB );
+
+            m_pDeviceContext->CSSetShaderResources( 0, 1, &pSRV );
+            m_pDeviceContext->CSSetUnorderedAccessViews( 0, 1, &m_pBoxUAV[index], nullptr );
+
+            // 1グループが1ラインを担当し，ライン内はグループの累積和で並列に処理する.
+            // 各反復で端をクランプするので，GlareCPU の BoxGaussBlur() とは端から半径の合計以内で結果が異なる.
+            auto lines = ( dir == 0 ) ? m_Height : m_Width;
+            m_pDeviceContext->Dispatch( lines, 1, 1 );
+
+            // 次のパスで読み込めるように解除.
+            m_pDeviceContext->CSSetShaderResources( 0, 1, &nullSRV );
+            m_pDeviceContext->CSSetUnorderedAccessViews( 0, 1, &nullUAV, nullptr );
+
+            pSRV  = m_pBoxSRV[index];
+            index = 1 - index;
+        }
+    }
+
+    m_pDeviceContext->CSSetShader( nullptr, nullptr, 0 );
+
+    return pSRV;
+}
+
+//---------------------------------------------------------------------------------------
+//      縮小バッファの全段を1回のディスパッチで生成します.
+//---------------------------------------------------------------------------------------
+void SampleApplication::DispatchPyramid( ID3D11ShaderResourceView* pSrcSRV )
+{
+    ID3D11ShaderResourceView*  nullSRV = nullptr;
+    ID3D11UnorderedAccessView* nullUAV[CASCADE_LEVEL_COUNT] = {};
+
+    auto pCB = m_ParamTable.GetBuffer( m_PyramidTable );
+    m_pDeviceContext->CSSetShader( m_pPyramidCS, nullptr, 0 );
+    m_pDeviceContext->CSSetConstantBuffers( 0, 1, &pCB );
+    m_pDeviceContext->CSSetShaderResources( 0, 1, &pSrcSRV );
+    m_pDeviceContext->CSSetSamplers( 0, 1, &m_pLinearSampler );
+    m_pDeviceContext->CSSetUnorderedAccessViews( 0, CASCADE_LEVEL_COUNT, m_pPyramidUAV, nullptr );
+
+    // 1グループが1段目の PYRAMID_TILE_SIZE 四方と，それ以降の段の同じ範囲を担当する.
+    auto w = m_Width  / 4;
+    auto h = m_Height / 4;
+    m_pDeviceContext->Dispatch( ( w + PYRAMID_TILE_SIZE - 1 ) / PYRAMID_TILE_SIZE, ( h + PYRAMID_TILE_SIZE - 1 ) / PYRAMID_TILE_SIZE, 1 );
+
+    // 続くブラーでミップを読み込めるように解除.
+    m_pDeviceContext->CSSetShaderResources( 0, 1, &nullSRV );
+    m_pDeviceContext->CSSetUnorderedAccessViews( 0, CASCADE_LEVEL_COUNT, nullUAV, nullptr );
+    m_pDeviceContext->CSSetShader( nullptr, nullptr, 0 );
+}
+
 //---------------------------------------------------------------------------------------
 //      リサイズイベントの処理です.
 //---------------------------------------------------------------------------------------
@@ -524,6 +981,18 @@ void SampleApplication::OnResize( const asdx::ResizeEventParam& param )
 //---------------------------------------------------------------------------------------
 void SampleApplication::OnKey( const asdx::KeyEventParam& param )
 {
+    if ( !param.IsKeyDown )
+    { return; }
+
+    if ( param.KeyCode == 'B' )
+    {
+        // 使う方法の作業バッファだけを持つので作り直す.
+        m_BlurMode = BLUR_MODE( ( m_BlurMode + 1 ) % NUM_BLUR_MODE );
+        CreateCascadeBuffers();
+    }
+
+    if ( param.KeyCode == 'S' )
+    { m_BoxDeviationIndex = ( m_BoxDeviationIndex + 1 ) % _countof(BOX_DEVIATIONS); }
 }
 
 //---------------------------------------------------------------------------------------
@@ -0,0 +1,149 @@
+﻿//------------------------------------------------------------------------------
+// File : ParamTableCache.h
+// Desc : Immutable Parameter Table Cache.
+// Copyright(c) Project Asura. All right reserved.
+//------------------------------------------------------------------------------
+
+#ifndef __PARAM_TABLE_CACHE_H__
+#define __PARAM_TABLE_CACHE_H__
+
+//------------------------------------------------------------------------------
+// Include
+//------------------------------------------------------------------------------
+#include <asdxTypedef.h>
+#include <d3d11.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// ParamTableCache class
+////////////////////////////////////////////////////////////////////////////////////////
+class ParamTableCache
+{
+    //==================================================================================
+    // list of friend classes and methods.
+    //==================================================================================
+    /* NOTHING */
+
+public:
+    //==================================================================================
+    // public variables.
+    //==================================================================================
+    typedef u32 Handle;                                 //!< テーブルのハンドルです.
+    static const Handle INVALID_HANDLE = 0xffffffff;    //!< 無効なハンドルです.
+
+    //==================================================================================
+    // public methods.
+    //==================================================================================
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //----------------------------------------------------------------------------------
+    ParamTableCache();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    ~ParamTableCache();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      全てのテーブルと定数バッファを解放します.
+    //----------------------------------------------------------------------------------
+    void Term();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      キーに対応するテーブルを検索します.
+    //!
+    //! @param [in]     pKey        キーです. パディングを含まない構造体をバイト列として比較します.
+    //! @param [in]     keySize     キーのバイトサイズです.
+    //! @return     登録済みならハンドル，未登録なら INVALID_HANDLE を返却します.
+    //----------------------------------------------------------------------------------
+    Handle Find( const void* pKey, size_t keySize ) const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      テーブルを登録し，IMMUTABLE な定数バッファを生成します.
+    //!
+    //! @param [in]     pDevice     デバイスです.
+    //! @param [in]     pKey        キーです.
+    //! @param [in]     keySize     キーのバイトサイズです.
+    //! @param [in]     pData       定数バッファにそのまま書き込むテーブルです.
+    //! @param [in]     dataSize    テーブルのバイトサイズです. 16の倍数である必要があります.
+    //! @return     登録したハンドルを返却します. 生成に失敗した場合は INVALID_HANDLE を返却します.
+    //! @note       登録済みのキーの場合は，既存のハンドルを返却します.
+    //----------------------------------------------------------------------------------
+    Handle Register
+    (
+        ID3D11Device*   pDevice,
+        const void*     pKey,
+        size_t          keySize,
+        const void*     pData,
+        size_t          dataSize
+    );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      テーブルを取得します. 未登録の場合は計算して登録します.
+    //!
+    //! @param [in]     pDevice     デバイスです.
+    //! @param [in]     key         キーです.
+    //! @param [in]     calc        テーブルを計算する関数です. Param を返却する必要があります.
+    //! @return     ハンドルを返却します.
+    //----------------------------------------------------------------------------------
+    template<typename Param, typename Key, typename Calc>
+    Handle Acquire( ID3D11Device* pDevice, const Key& key, Calc calc )
+    {
+        auto handle = Find( &key, sizeof(key) );
+        if ( handle != INVALID_HANDLE )
+        { return handle; }
+
+        Param param = calc();
+        return Register( pDevice, &key, sizeof(key), &param, sizeof(param) );
+    }
+
+    //----------------------------------------------------------------------------------
+    //! @brief      定数バッファを取得します.
+    //!
+    //! @param [in]     handle      ハンドルです.
+    //! @return     定数バッファを返却します. 無効なハンドルの場合は nullptr を返却します.
+    //----------------------------------------------------------------------------------
+    ID3D11Buffer* GetBuffer( Handle handle ) const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      CPU側のテーブルを取得します.
+    //!
+    //! @param [in]     handle      ハンドルです.
+    //! @return     テーブルを返却します. 無効なハンドルの場合は nullptr を返却します.
+    //----------------------------------------------------------------------------------
+    const void* GetData( Handle handle ) const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      登録済みのテーブル数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetCount() const;
+
+private:
+    //==================================================================================
+    // Entry structure
+    //==================================================================================
+    struct Entry
+    {
+        std::vector<u8>     Data;       //!< テーブルです.
+        ID3D11Buffer*       pBuffer;    //!< IMMUTABLE な定数バッファです.
+    };
+
+    //==================================================================================
+    // private variables.
+    //==================================================================================
+    std::vector<Entry>                          m_Entries;      //!< 登録済みのテーブルです.
+    std::unordered_map<std::string, Handle>     m_Lookup;       //!< キーからハンドルへの対応表です.
+
+    //==================================================================================
+    // private methods.
+    //==================================================================================
+    ParamTableCache ( const ParamTableCache& );     // アクセス禁止.
+    void operator = ( const ParamTableCache& );     // アクセス禁止.
+};
+
+
+#endif//__PARAM_TABLE_CACHE_H__
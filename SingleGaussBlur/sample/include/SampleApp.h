@@ -19,6 +19,7 @@
 #include <asdxFont.h>
 #include <asdxConstantBuffer.h>
 #include <asdxTexture.h>
+#include "ParamTableCache.h"
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +34,20 @@ struct GaussBlurParam
 };
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// TiledBlurParam structure
+//////////////////////////////////////////////////////////////////////////////////////////
+ASDX_ALIGN(16)
+struct TiledBlurParam
+{
+    int             Width;          //!< 出力の横幅です.
+    int             Height;         //!< 出力の縦幅です.
+    int             Radius;         //!< カーネルの半径です.
+    int             Dummy;
+    float           Weight[132];    //!< 重みです(GaussBlurTiled.hlsli の Weights[33] と同じ並び).
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // SampleApplication
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -56,13 +71,26 @@ private:
     ID3D11SamplerState*         m_pLinearSampler = nullptr;      //!< ポイントサンプラー.
     ID3D11BlendState*           m_pOpequeBS     = nullptr;
     asdx::QuadRenderer          m_Quad;
-    asdx::ConstantBuffer        m_BlurBuffer;
+    ParamTableCache             m_ParamTable;                   //!< IMMUTABLE な定数バッファのキャッシュ.
+    ParamTableCache::Handle     m_BlurTable[2];                 //!< 横・縦のブラーテーブル.
     asdx::RenderTarget2D        m_PingPong[2];
+    ID3D11ComputeShader*        m_pTiledBlurCS[2]   = {};       //!< 共有メモリでタイルをキャッシュするブラーシェーダ(横, 縦).
+    ID3D11Texture2D*            m_pTiledTexture[2]  = {};       //!< コンピュートシェーダ用作業テクスチャ.
+    ID3D11ShaderResourceView*   m_pTiledSRV[2]      = {};       //!< 作業テクスチャのシェーダリソースビュー.
+    ID3D11UnorderedAccessView*  m_pTiledUAV[2]      = {};       //!< 作業テクスチャのアンオーダードアクセスビュー.
+    asdx::ConstantBuffer        m_TiledBlurBuffer;              //!< コンピュートシェーダ用ブラーパラメータ.
+    bool                        m_ComputeBlur       = false;    //!< コンピュートシェーダでブラーを掛けるかどうか.
+    int                         m_TiledRadiusIndex  = 0;        //!< コンピュートシェーダ用カーネル半径の番号.
 
     //==================================================================================
     // private methods.
     //==================================================================================
     void OnDrawText();
+    bool BuildParamTables();
+    bool CreateTiledBlurTextures();
+    void UpdateTiledBlurParam();
+    void DrawBlurPS();
+    void DispatchBlurCS();
 
 protected:
     //==================================================================================
@@ -0,0 +1,103 @@
+//-------------------------------------------------------------------------------------------------
+// File : GaussBlurTiled.hlsli
+// Desc : Gauss Blur with Shared Memory Tile Cache.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+#ifndef GAUSS_BLUR_TILED_HLSLI
+#define GAUSS_BLUR_TILED_HLSLI
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+#define THREAD_COUNT    128     // 1O[vSeNZł(glareTiledBlur.h Ɠ).
+#define MAX_RADIUS      64      // LɎ܂ő唼ał(glareTiledBlur.h Ɠ).
+
+#ifndef BLUR_VERTICAL
+#define BLUR_VERTICAL   0
+#endif//BLUR_VERTICAL
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CBuffer structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+cbuffer CbTiledBlur
+{
+    int2    Size        : packoffset(c0);       // o̓TCYł.
+    int     Radius      : packoffset(c0.z);     // J[l̔ał.
+    float4  Weights[33] : packoffset(c1);       // d݂ł. k Ԗڂ̃^bv Weights[k / 4][k % 4].
+};
+
+//-------------------------------------------------------------------------------------------------
+// Textures and Samplers.
+//-------------------------------------------------------------------------------------------------
+Texture2D           ColorBuffer  : register(t0);
+SamplerState        ColorSampler : register(s0);
+RWTexture2D<float4> OutputBuffer : register(u0);
+
+//-------------------------------------------------------------------------------------------------
+// Shared Memory.
+//-------------------------------------------------------------------------------------------------
+groupshared float4  Cache[THREAD_COUNT + MAX_RADIUS * 2];
+
+//-------------------------------------------------------------------------------------------------
+//      o̓ObḧʒũeNZ擾܂.
+//-------------------------------------------------------------------------------------------------
+float4 FetchColor(int2 pos)
+{
+    // ͂̉𑜓xقȂĂĂsNZVF[_łƓeNZE.
+    float2 uv = (float2(pos) + 0.5f) / float2(Size);
+    return ColorBuffer.SampleLevel(ColorSampler, uv, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      CGg[|Cgł.
+//-------------------------------------------------------------------------------------------------
+#if BLUR_VERTICAL
+[numthreads(1, THREAD_COUNT, 1)]
+#else
+[numthreads(THREAD_COUNT, 1, 1)]
+#endif
+void main(uint3 groupId : SV_GroupID, uint3 threadId : SV_GroupThreadID)
+{
+#if BLUR_VERTICAL
+    int  t     = int(threadId.y);
+    int  tile  = int(groupId.y);
+    int  count = Size.y;
+    int2 base  = int2(groupId.x, 0);
+    int2 axis  = int2(0, 1);
+#else
+    int  t     = int(threadId.x);
+    int  tile  = int(groupId.x);
+    int  count = Size.x;
+    int2 base  = int2(0, groupId.y);
+    int2 axis  = int2(1, 0);
+#endif
+
+    int origin    = tile * THREAD_COUNT - Radius;
+    int cacheSize = THREAD_COUNT + Radius * 2;
+
+    // ^Cƃn[Xbh1xǂݍ. ͈͊O͒[̃eNZ𕡐.
+    for(int i=t; i<cacheSize; i+=THREAD_COUNT)
+    {
+        int x = clamp(origin + i, 0, count - 1);
+        Cache[i] = FetchColor(base + axis * x);
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    int x = tile * THREAD_COUNT + t;
+    if (x >= count)
+    { return; }
+
+    // Lŏݍ.
+    float4 result = 0;
+    int tapCount = Radius * 2 + 1;
+    for(int k=0; k<tapCount; ++k)
+    { result += Weights[k >> 2][k & 3] * Cache[t + k]; }
+
+    result.w = 1.0f;
+
+    OutputBuffer[base + axis * x] = result;
+}
+
+#endif//GAUSS_BLUR_TILED_HLSLI
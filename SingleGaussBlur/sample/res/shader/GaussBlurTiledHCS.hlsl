@@ -0,0 +1,8 @@
+//-------------------------------------------------------------------------------------------------
+// File : GaussBlurTiledHCS.hlsl
+// Desc : Horizontal Gauss Blur with Shared Memory Tile Cache.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+#define BLUR_VERTICAL   0
+#include "GaussBlurTiled.hlsli"
@@ -0,0 +1,8 @@
+//-------------------------------------------------------------------------------------------------
+// File : GaussBlurTiledVCS.hlsl
+// Desc : Vertical Gauss Blur with Shared Memory Tile Cache.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+#define BLUR_VERTICAL   1
+#include "GaussBlurTiled.hlsli"
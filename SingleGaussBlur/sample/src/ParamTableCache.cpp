@@ -0,0 +1,136 @@
+﻿//---------------------------------------------------------------------------------------
+// File : ParamTableCache.cpp
+// Desc : Immutable Parameter Table Cache.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "ParamTableCache.h"
+#include <asdxLog.h>
+#include <cstring>
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// ParamTableCache class
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+ParamTableCache::ParamTableCache()
+: m_Entries ()
+, m_Lookup  ()
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      デストラクタです.
+//---------------------------------------------------------------------------------------
+ParamTableCache::~ParamTableCache()
+{ Term(); }
+
+//---------------------------------------------------------------------------------------
+//      全てのテーブルと定数バッファを解放します.
+//---------------------------------------------------------------------------------------
+void ParamTableCache::Term()
+{
+    for(size_t i=0; i<m_Entries.size(); ++i)
+    { ASDX_RELEASE( m_Entries[i].pBuffer ); }
+
+    m_Entries.clear();
+    m_Lookup .clear();
+}
+
+//---------------------------------------------------------------------------------------
+//      キーに対応するテーブルを検索します.
+//---------------------------------------------------------------------------------------
+ParamTableCache::Handle ParamTableCache::Find( const void* pKey, size_t keySize ) const
+{
+    auto itr = m_Lookup.find( std::string( static_cast<const char*>(pKey), keySize ) );
+    if ( itr == m_Lookup.end() )
+    { return INVALID_HANDLE; }
+
+    return itr->second;
+}
+
+//---------------------------------------------------------------------------------------
+//      テーブルを登録し，IMMUTABLE な定数バッファを生成します.
+//---------------------------------------------------------------------------------------
+ParamTableCache::Handle ParamTableCache::Register
+(
+    ID3D11Device*   pDevice,
+    const void*     pKey,
+    size_t          keySize,
+    const void*     pData,
+    size_t          dataSize
+)
+{
+    std::string key( static_cast<const char*>(pKey), keySize );
+
+    auto itr = m_Lookup.find( key );
+    if ( itr != m_Lookup.end() )
+    { return itr->second; }
+
+    if ( pDevice == nullptr || pData == nullptr || dataSize == 0 || ( dataSize % 16 ) != 0 )
+    {
+        ELOG( "Error : Invalid Argument." );
+        return INVALID_HANDLE;
+    }
+
+    // 以降は書き換えないので，初期データ付きの IMMUTABLE バッファとして生成する.
+    D3D11_BUFFER_DESC desc = {};
+    desc.ByteWidth  = UINT(dataSize);
+    desc.Usage      = D3D11_USAGE_IMMUTABLE;
+    desc.BindFlags  = D3D11_BIND_CONSTANT_BUFFER;
+
+    D3D11_SUBRESOURCE_DATA res = {};
+    res.pSysMem = pData;
+
+    Entry entry;
+    entry.pBuffer = nullptr;
+
+    auto hr = pDevice->CreateBuffer( &desc, &res, &entry.pBuffer );
+    if ( FAILED( hr ) )
+    {
+        ELOG( "Error : ID3D11Device::CreateBuffer() Failed." );
+        return INVALID_HANDLE;
+    }
+
+    entry.Data.resize( dataSize );
+    memcpy( entry.Data.data(), pData, dataSize );
+
+    auto handle = Handle( m_Entries.size() );
+    m_Entries.push_back( entry );
+    m_Lookup[key] = handle;
+
+    return handle;
+}
+
+//---------------------------------------------------------------------------------------
+//      定数バッファを取得します.
+//---------------------------------------------------------------------------------------
+ID3D11Buffer* ParamTableCache::GetBuffer( Handle handle ) const
+{
+    if ( handle >= m_Entries.size() )
+    { return nullptr; }
+
+    return m_Entries[handle].pBuffer;
+}
+
+//---------------------------------------------------------------------------------------
+//      CPU側のテーブルを取得します.
+//---------------------------------------------------------------------------------------
+const void* ParamTableCache::GetData( Handle handle ) const
+{
+    if ( handle >= m_Entries.size() )
+    { return nullptr; }
+
+    return m_Entries[handle].Data.data();
+}
+
+//---------------------------------------------------------------------------------------
+//      登録済みのテーブル数を取得します.
+//---------------------------------------------------------------------------------------
+u32 ParamTableCache::GetCount() const
+{ return u32( m_Entries.size() ); }
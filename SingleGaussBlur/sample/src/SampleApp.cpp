@@ -19,6 +19,28 @@ namespace {
 #include "../res/shader/Compiled/GaussBlurPS.inc"
 #include "../res/shader/Compiled/CopyPS.inc"
 #include "../res/shader/Compiled/CompositePS.inc"
+#include "../res/shader/Compiled/GaussBlurTiledHCS.inc"
+#include "../res/shader/Compiled/GaussBlurTiledVCS.inc"
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const int    TILED_THREAD_COUNT  = 128;                  //!< 1グループのスレッド数です(GaussBlurTiled.hlsli と同じ).
+static const int    TILED_BLUR_RADII[]  = { 7, 15, 31, 63 };    //!< コンピュートシェーダ用カーネルの半径です.
+static const float  BLUR_DEVIATION      = 2.5f;                 //!< 15 タップ(半径 7)での標準偏差です.
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// BlurTableKey structure
+//////////////////////////////////////////////////////////////////////////////////////////
+struct BlurTableKey
+{
+    s32     Width;          //!< レンダーターゲットの横幅です.
+    s32     Height;         //!< レンダーターゲットの縦幅です.
+    float   DirX;           //!< ブラー方向のX成分です.
+    float   DirY;           //!< ブラー方向のY成分です.
+    float   Deviation;      //!< 標準偏差です.
+};
 
 //-------------------------------------------------------------------------------------------------
 //      ガウスの重みを計算します.
@@ -66,6 +88,33 @@ inline GaussBlurParam CalcBlurParam( int width, int height, asdx::Vector2 dir, f
     return result;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      コンピュートシェーダ用ブラーパラメータを計算します.
+//-------------------------------------------------------------------------------------------------
+inline TiledBlurParam CalcTiledBlurParam( int width, int height, int radius )
+{
+    // 半径 7 のときにピクセルシェーダ版と同じ重みになるよう，半径に比例させる.
+    auto deviation = BLUR_DEVIATION * float(radius) / 7.0f;
+
+    TiledBlurParam result = {};
+    result.Width  = width;
+    result.Height = height;
+    result.Radius = radius;
+
+    auto total_weight = 0.0f;
+    for(auto i=-radius; i<=radius; ++i)
+    {
+        auto weight = GaussianDistribution( asdx::Vector2( float(i), 0.0f ), deviation );
+        result.Weight[i + radius] = weight;
+        total_weight += weight;
+    }
+
+    for(auto i=0; i<=radius * 2; ++i)
+    { result.Weight[i] /= total_weight; }
+
+    return result;
+}
+
 } // namespace 
 
 
@@ -209,10 +258,35 @@ bool SampleApplication::OnInit()
    }
 
    {
-      if ( !m_BlurBuffer.Create(m_pDevice, sizeof(GaussBlurParam)))
+      if ( !BuildParamTables() )
       { return false; }
    }
 
+   {
+       // コンピュートシェーダを生成.
+       hr = m_pDevice->CreateComputeShader(GaussBlurTiledHCS, sizeof(GaussBlurTiledHCS), nullptr, &m_pTiledBlurCS[0]);
+       if ( FAILED(hr) )
+       {
+           ELOG( "Error : ID3D11Device::CreateComputeShader() Failed." );
+           return false;
+       }
+
+       hr = m_pDevice->CreateComputeShader(GaussBlurTiledVCS, sizeof(GaussBlurTiledVCS), nullptr, &m_pTiledBlurCS[1]);
+       if ( FAILED(hr) )
+       {
+           ELOG( "Error : ID3D11Device::CreateComputeShader() Failed." );
+           return false;
+       }
+
+       if ( !m_TiledBlurBuffer.Create(m_pDevice, sizeof(TiledBlurParam)))
+       { return false; }
+
+       if ( !CreateTiledBlurTextures() )
+       { return false; }
+
+       UpdateTiledBlurParam();
+   }
+
    {
        asdx::RenderTarget2D::Description desc;
        desc.Width               = m_Width  / 4;
@@ -237,10 +311,17 @@ bool SampleApplication::OnInit()
 void SampleApplication::OnTerm()
 {
     for(auto i=0; i<2; i++)
-    { m_PingPong[i].Release(); }
+    {
+        m_PingPong[i].Release();
+        ASDX_RELEASE( m_pTiledUAV[i] );
+        ASDX_RELEASE( m_pTiledSRV[i] );
+        ASDX_RELEASE( m_pTiledTexture[i] );
+        ASDX_RELEASE( m_pTiledBlurCS[i] );
+    }
+    m_TiledBlurBuffer.Release();
     m_Font.Term();
     m_InputTexture.Release();
-    m_BlurBuffer.Release();
+    m_ParamTable.Term();
     m_Quad.Term();
     ASDX_RELEASE( m_pOpequeBS );
     ASDX_RELEASE( m_pPointSampler );
@@ -250,6 +331,85 @@ void SampleApplication::OnTerm()
     ASDX_RELEASE( m_pFullScreenVS );
 }
 
+//---------------------------------------------------------------------------------------
+//      ブラーのパラメータテーブルを生成します.
+//---------------------------------------------------------------------------------------
+bool SampleApplication::BuildParamTables()
+{
+    // 縦横のテーブルを作る. 以降のフレームでは定数バッファを設定するだけになる.
+    for(auto dir=0; dir<2; ++dir)
+    {
+        BlurTableKey key = {};
+        key.Width     = m_Width  / 4;
+        key.Height    = m_Height / 4;
+        key.DirX      = ( dir == 0 ) ? 1.0f : 0.0f;
+        key.DirY      = ( dir == 0 ) ? 0.0f : 1.0f;
+        key.Deviation = BLUR_DEVIATION;
+
+        m_BlurTable[dir] = m_ParamTable.Acquire<GaussBlurParam>( m_pDevice, key, [&]()
+        { return CalcBlurParam( key.Width, key.Height, asdx::Vector2( key.DirX, key.DirY ), key.Deviation ); });
+
+        if ( m_BlurTable[dir] == ParamTableCache::INVALID_HANDLE )
+        { return false; }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      コンピュートシェーダ用作業テクスチャを生成します.
+//---------------------------------------------------------------------------------------
+bool SampleApplication::CreateTiledBlurTextures()
+{
+    // sRGB フォーマットは UAV にできないので浮動小数で持つ.
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width              = m_Width  / 4;
+    desc.Height             = m_Height / 4;
+    desc.MipLevels          = 1;
+    desc.ArraySize          = 1;
+    desc.Format             = DXGI_FORMAT_R16G16B16A16_FLOAT;
+    desc.SampleDesc.Count   = 1;
+    desc.SampleDesc.Quality = 0;
+    desc.Usage              = D3D11_USAGE_DEFAULT;
+    desc.BindFlags          = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+    for(auto i=0; i<2; ++i)
+    {
+        auto hr = m_pDevice->CreateTexture2D( &desc, nullptr, &m_pTiledTexture[i] );
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11Device::CreateTexture2D() Failed." );
+            return false;
+        }
+
+        hr = m_pDevice->CreateShaderResourceView( m_pTiledTexture[i], nullptr, &m_pTiledSRV[i] );
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11Device::CreateShaderResourceView() Failed." );
+            return false;
+        }
+
+        hr = m_pDevice->CreateUnorderedAccessView( m_pTiledTexture[i], nullptr, &m_pTiledUAV[i] );
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11Device::CreateUnorderedAccessView() Failed." );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      コンピュートシェーダ用ブラーパラメータを更新します.
+//---------------------------------------------------------------------------------------
+void SampleApplication::UpdateTiledBlurParam()
+{
+    // 横方向と縦方向で同じ重みを使うので，変更時だけ転送する.
+    auto param = CalcTiledBlurParam( m_Width / 4, m_Height / 4, TILED_BLUR_RADII[m_TiledRadiusIndex] );
+    m_pDeviceContext->UpdateSubresource( m_TiledBlurBuffer.GetBuffer(), 0, nullptr, &param, 0, 0 );
+}
+
 //---------------------------------------------------------------------------------------
 //      フレーム遷移時の処理です.
 //---------------------------------------------------------------------------------------
@@ -266,21 +426,32 @@ void SampleApplication::OnDrawText()
     m_Font.Begin( m_pDeviceContext );
     {
         m_Font.DrawStringArg( 10, 10, "FPS : %.2f", GetFPS() );
+
+        if ( m_ComputeBlur )
+        {
+            // 1 テクセルあたりのテクスチャ読み込み回数(横と縦の合計).
+            auto radius  = TILED_BLUR_RADII[m_TiledRadiusIndex];
+            auto fetches = 2.0f * float( TILED_THREAD_COUNT + radius * 2 ) / float( TILED_THREAD_COUNT );
+            m_Font.DrawStringArg( 10, 30, "Blur : Compute Shader ([C] Key), Taps : %d ([K] Key), Fetches / Texel : %.2f", radius * 2 + 1, fetches );
+        }
+        else
+        {
+            m_Font.DrawStringArg( 10, 30, "Blur : Pixel Shader ([C] Key), Taps : 15, Fetches / Texel : 30.00" );
+        }
     }
     m_Font.End( m_pDeviceContext );
 }
 
 //---------------------------------------------------------------------------------------
-//      描画時の処理です.
+//      ピクセルシェーダでブラーを掛けます.
 //---------------------------------------------------------------------------------------
-void SampleApplication::OnFrameRender( double time, double elapsedTime )
+void SampleApplication::DrawBlurPS()
 {
     auto pSrcSRV = m_InputTexture.GetSRV();
     auto pDstRTV = m_PingPong[0].GetRTV();
 
     auto w = m_Width  / 4;
     auto h = m_Height / 4;
-    auto deviation = 2.5f;
 
     {
         // クリア処理.
@@ -319,9 +490,7 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
 
         m_pDeviceContext->RSSetViewports( 1, &viewport );
 
-        auto pCB = m_BlurBuffer.GetBuffer();
-        GaussBlurParam src = CalcBlurParam(w, h, asdx::Vector2(1.0f, 0.0f), deviation);
-        m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &src, 0, 0 );
+        auto pCB = m_ParamTable.GetBuffer( m_BlurTable[0] );
         m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
 
         // 描画.
@@ -340,8 +509,7 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
         m_pDeviceContext->PSSetShaderResources( 0, 1, &pSRV );
         m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
 
-        src = CalcBlurParam(w, h, asdx::Vector2(0.0f, 1.0f), deviation);
-        m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &src, 0, 0 );
+        pCB = m_ParamTable.GetBuffer( m_BlurTable[1] );
         m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
 
         // ステートを設定.
@@ -357,10 +525,62 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
         m_pDeviceContext->PSSetShaderResources( 0, 1, nullTarget );
 
     }
+}
+
+//---------------------------------------------------------------------------------------
+//      コンピュートシェーダでブラーを掛けます.
+//---------------------------------------------------------------------------------------
+void SampleApplication::DispatchBlurCS()
+{
+    auto w = m_Width  / 4;
+    auto h = m_Height / 4;
+
+    ID3D11ShaderResourceView*  nullSRV[1] = { nullptr };
+    ID3D11UnorderedAccessView* nullUAV[1] = { nullptr };
+
+    auto pCB = m_TiledBlurBuffer.GetBuffer();
+    m_pDeviceContext->CSSetConstantBuffers( 0, 1, &pCB );
+    m_pDeviceContext->CSSetSamplers( 0, 1, &m_pPointSampler );
+
+    // 横方向. 1グループが1行の TILED_THREAD_COUNT テクセルを担当する.
+    {
+        auto pSRV = m_InputTexture.GetSRV();
+        m_pDeviceContext->CSSetShader( m_pTiledBlurCS[0], nullptr, 0 );
+        m_pDeviceContext->CSSetShaderResources( 0, 1, &pSRV );
+        m_pDeviceContext->CSSetUnorderedAccessViews( 0, 1, &m_pTiledUAV[0], nullptr );
+        m_pDeviceContext->Dispatch( ( w + TILED_THREAD_COUNT - 1 ) / TILED_THREAD_COUNT, h, 1 );
+
+        // 次のパスで読み込むので外しておく.
+        m_pDeviceContext->CSSetUnorderedAccessViews( 0, 1, nullUAV, nullptr );
+    }
+
+    // 縦方向. 1グループが1列の TILED_THREAD_COUNT テクセルを担当する.
+    {
+        m_pDeviceContext->CSSetShader( m_pTiledBlurCS[1], nullptr, 0 );
+        m_pDeviceContext->CSSetShaderResources( 0, 1, &m_pTiledSRV[0] );
+        m_pDeviceContext->CSSetUnorderedAccessViews( 0, 1, &m_pTiledUAV[1], nullptr );
+        m_pDeviceContext->Dispatch( w, ( h + TILED_THREAD_COUNT - 1 ) / TILED_THREAD_COUNT, 1 );
+
+        m_pDeviceContext->CSSetUnorderedAccessViews( 0, 1, nullUAV, nullptr );
+        m_pDeviceContext->CSSetShaderResources( 0, 1, nullSRV );
+    }
+
+    m_pDeviceContext->CSSetShader( nullptr, nullptr, 0 );
+}
+
+//---------------------------------------------------------------------------------------
+//      描画時の処理です.
+//---------------------------------------------------------------------------------------
+void SampleApplication::OnFrameRender( double time, double elapsedTime )
+{
+    if ( m_ComputeBlur )
+    { DispatchBlurCS(); }
+    else
+    { DrawBlurPS(); }
 
     {
         // レンダーターゲットビュー・深度ステンシルビューを取得.
-        pDstRTV = m_RenderTarget2D.GetRTV();
+        auto pDstRTV = m_RenderTarget2D.GetRTV();
         ID3D11DepthStencilView* pDSV = m_DepthStencilTarget.GetDSV();
 
         m_pDeviceContext->ClearDepthStencilView( pDSV, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0 );
@@ -388,7 +608,7 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
         // シェーダリソースビューを設定.
         ID3D11ShaderResourceView* pSRV[] = {
             m_InputTexture.GetSRV(),
-            m_PingPong[1].GetSRV(),
+            ( m_ComputeBlur ) ? m_pTiledSRV[1] : m_PingPong[1].GetSRV(),
         };
         m_pDeviceContext->PSSetShaderResources( 0, 2, pSRV );
         m_pDeviceContext->PSSetSamplers( 0, 1, &m_pLinearSampler );
@@ -422,6 +642,17 @@ void SampleApplication::OnResize( const asdx::ResizeEventParam& param )
 //---------------------------------------------------------------------------------------
 void SampleApplication::OnKey( const asdx::KeyEventParam& param )
 {
+    if ( !param.IsKeyDown )
+    { return; }
+
+    if ( param.KeyCode == 'C' )
+    { m_ComputeBlur = !m_ComputeBlur; }
+
+    if ( param.KeyCode == 'K' )
+    {
+        m_TiledRadiusIndex = ( m_TiledRadiusIndex + 1 ) % _countof(TILED_BLUR_RADII);
+        UpdateTiledBlurParam();
+    }
 }
 
 //---------------------------------------------------------------------------------------
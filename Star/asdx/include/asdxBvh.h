@@ -0,0 +1,370 @@
+﻿//-------------------------------------------------------------------------------------
+// File : asdxBvh.h
+// Desc : Bounding Volume Hierarchy Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------
+
+#ifndef __ASDX_BVH_H__
+#define __ASDX_BVH_H__
+
+//-------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------
+#include <asdxGeometry.h>
+#include <vector>
+#include <thread>
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------
+// Forward Declarations
+//-------------------------------------------------------------------------------------
+class MeshBvh;
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// BvhNode structure
+///////////////////////////////////////////////////////////////////////////////////////
+struct BvhNode
+{
+    Vector3     min;        //!< 境界箱の最小値です.
+    u32         offset;     //!< 葉の場合は先頭のプリミティブの位置, 内部ノードの場合は右の子の番号です.
+    Vector3     max;        //!< 境界箱の最大値です.
+    u32         count;      //!< 葉の場合はプリミティブ数です. 内部ノードの場合は0です.
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Bvh class
+///////////////////////////////////////////////////////////////////////////////////////
+class Bvh
+{
+    //=================================================================================
+    // list of friend classes and methods.
+    //=================================================================================
+    friend class MeshBvh;
+
+public:
+    //=================================================================================
+    // public variables.
+    //=================================================================================
+    static const u32 NUM_BIN        = 16;   //!< SAH を評価するビンの数です.
+    static const u32 NUM_MAX_LEAF   = 8;    //!< 葉に格納する最大のプリミティブ数です.
+    static const u32 NUM_MAX_DEPTH  = 64;   //!< 最大の深さです. 走査に使うスタックの大きさと同じです.
+
+    //=================================================================================
+    // public methods.
+    //=================================================================================
+
+    //---------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------
+    Bvh();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------
+    virtual ~Bvh();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      初期化処理です.
+    //!
+    //! @param [in]     pBoxes      プリミティブの境界箱です.
+    //! @param [in]     count       プリミティブ数です.
+    //! @param [in]     threadCount 構築に使用するスレッド数です(呼び出したスレッドを含みます).
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //! @note       ビン分割した SAH で構築します. 上位の階層で左右の部分木を別スレッドで構築し，
+    //!             最後に左の子が親の直後に並ぶように詰め直します. 結果はスレッド数によらず同じです.
+    //---------------------------------------------------------------------------------
+    bool Init( const BoundingBox* pBoxes, u32 count, u32 threadCount = 1 );
+
+    //---------------------------------------------------------------------------------
+    //! @brief      終了処理です.
+    //---------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      レイと最も近いプリミティブの境界箱を求めます.
+    //!
+    //! @param [in]     ray         判定するレイです.
+    //! @param [out]    distance    交差点までの距離です.
+    //! @param [out]    index       交差したプリミティブの番号です.
+    //! @retval true    交差しています.
+    //! @retval false   交差はありません.
+    //---------------------------------------------------------------------------------
+    bool Intersects( const Ray& ray, f32& distance, u32& index ) const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      視錐台と交差するプリミティブの番号を出力します.
+    //!
+    //! @param [in]     frustum     判定する視錐台です.
+    //! @param [out]    pIndices    プリミティブ番号の出力先です. プリミティブ数分の領域が必要です.
+    //! @return     出力したプリミティブ番号の数を返却します.
+    //! @note       完全に内側にある平面は子ノードで判定しません.
+    //!             プリミティブ番号はノードを走査した順に出力します.
+    //---------------------------------------------------------------------------------
+    u32 Intersects( const BoundingFrustum& frustum, u32* pIndices ) const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      境界球と交差するプリミティブの番号を出力します.
+    //!
+    //! @param [in]     sphere      判定する境界球です.
+    //! @param [out]    pIndices    プリミティブ番号の出力先です. プリミティブ数分の領域が必要です.
+    //! @return     出力したプリミティブ番号の数を返却します.
+    //---------------------------------------------------------------------------------
+    u32 Intersects( const BoundingSphere& sphere, u32* pIndices ) const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      レイと交差する葉のプリミティブを近い順に列挙します.
+    //!
+    //! @param [in]     ray         判定するレイです.
+    //! @param [in,out] distance    判定する最大の距離です. 交差した場合は func が更新します.
+    //! @param [in]     anyHit      true の場合は最初に交差したところで走査を打ち切ります.
+    //! @param [in]     func        bool func( u32 position, f32& distance ) の形式の関数です.
+    //!                             position は GetPrimitives() 内の位置です.
+    //!                             distance より近くで交差した場合は distance を更新して true を返却します.
+    //! @retval true    いずれかのプリミティブと交差しています.
+    //! @retval false   交差はありません.
+    //! @note       境界箱は3軸の slab を4要素の SIMD で同時に判定し，2つの子のうち近い方から走査します.
+    //!             遠い方は NUM_MAX_DEPTH 個の固定長のスタックに積み，
+    //!             取り出したときに distance より遠ければ読み飛ばします.
+    //---------------------------------------------------------------------------------
+    template<typename Func>
+    bool Traverse( const Ray& ray, f32& distance, bool anyHit, Func& func ) const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      ノード数を取得します.
+    //---------------------------------------------------------------------------------
+    u32 GetNodeCount() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      ノードを取得します. 先頭が根です.
+    //---------------------------------------------------------------------------------
+    const BvhNode* GetNodes() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      プリミティブ数を取得します.
+    //---------------------------------------------------------------------------------
+    u32 GetPrimitiveCount() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      葉の順に並べたプリミティブを取得します.
+    //!
+    //! @return     offset に元のプリミティブ番号を格納した境界箱の配列を返却します.
+    //---------------------------------------------------------------------------------
+    const BvhNode* GetPrimitives() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      全体の境界箱を取得します.
+    //---------------------------------------------------------------------------------
+    BoundingBox GetBox() const;
+
+protected:
+    //=================================================================================
+    // protected variables.
+    //=================================================================================
+    static const u32 NUM_MIN_PARALLEL = 4096;   //!< 別スレッドで構築する部分木の最小のプリミティブ数です.
+
+    std::vector<BvhNode>    m_Nodes;        //!< ノードです.
+    std::vector<BvhNode>    m_Primitives;   //!< 葉の順に並べたプリミティブです.
+
+    //=================================================================================
+    // protected methods.
+    //=================================================================================
+
+    //---------------------------------------------------------------------------------
+    //! @brief      m_Primitives から構築します.
+    //---------------------------------------------------------------------------------
+    bool Build( u32 threadCount );
+
+    //---------------------------------------------------------------------------------
+    //! @brief      部分木を構築します.
+    //!
+    //! @param [out]    pNodes      作業用のノードです. 部分木は index から 2 * count - 1 個を使用します.
+    //! @param [in]     index       部分木の根の番号です.
+    //! @param [in]     first       先頭のプリミティブの位置です.
+    //! @param [in]     count       プリミティブ数です.
+    //! @param [in]     depth       部分木の根の深さです.
+    //! @param [in]     spawnDepth  この深さより浅い場合は子を別スレッドで構築します.
+    //---------------------------------------------------------------------------------
+    void BuildNode( BvhNode* pNodes, u32 index, u32 first, u32 count, u32 depth, u32 spawnDepth );
+
+    //---------------------------------------------------------------------------------
+    //! @brief      作業用のノードを左の子が親の直後に並ぶように m_Nodes に詰めます.
+    //!
+    //! @return     詰めた後の番号を返却します.
+    //---------------------------------------------------------------------------------
+    u32 CompactNode( const BvhNode* pNodes, u32 index );
+
+private:
+    //=================================================================================
+    // private variables.
+    //=================================================================================
+    /* NOTHING */
+
+    //=================================================================================
+    // private methods.
+    //=================================================================================
+    Bvh             ( const Bvh& value );       // アクセス禁止.
+    void operator = ( const Bvh& value );       // アクセス禁止.
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// MeshBvh class
+///////////////////////////////////////////////////////////////////////////////////////
+class MeshBvh
+{
+    //=================================================================================
+    // list of friend classes and methods.
+    //=================================================================================
+    /* NOTHING */
+
+public:
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Triangle structure
+    ///////////////////////////////////////////////////////////////////////////////////
+    struct Triangle
+    {
+        Vector3     p0;     //!< 三角形を構成する点です.
+        Vector3     p1;     //!< 三角形を構成する点です.
+        Vector3     p2;     //!< 三角形を構成する点です.
+    };
+
+    //=================================================================================
+    // public variables.
+    //=================================================================================
+    /* NOTHING */
+
+    //=================================================================================
+    // public methods.
+    //=================================================================================
+
+    //---------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------
+    MeshBvh();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------
+    virtual ~MeshBvh();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      初期化処理です.
+    //!
+    //! @param [in]     pPositions  先頭の頂点の位置座標です.
+    //! @param [in]     stride      頂点のサイズ(バイト)です.
+    //! @param [in]     vertexCount 頂点数です.
+    //! @param [in]     pIndices    頂点インデックスです.
+    //! @param [in]     indexCount  頂点インデックス数です. 3の倍数である必要があります.
+    //! @param [in]     threadCount 構築に使用するスレッド数です(呼び出したスレッドを含みます).
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //! @note       ResMesh からは次のように構築します.
+    //!             Init( &mesh.GetVertices()->Position, sizeof(ResMesh::Vertex), mesh.GetVertexCount(),
+    //!                   mesh.GetIndices(), mesh.GetIndexCount(), threadCount );
+    //!             三角形は葉の順に複製して保持するので，構築後は元のデータを解放しても構いません.
+    //---------------------------------------------------------------------------------
+    bool Init(
+        const Vector3*  pPositions,
+        u32             stride,
+        u32             vertexCount,
+        const u32*      pIndices,
+        u32             indexCount,
+        u32             threadCount = 1
+    );
+
+    //---------------------------------------------------------------------------------
+    //! @brief      終了処理です.
+    //---------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------
+    //! @brief      レイと最も近い三角形を求めます.
+    //!
+    //! @param [in]     ray             判定するレイです.
+    //! @param [out]    distance        交差点までの距離です.
+    //! @param [out]    triangleIndex   交差した三角形の番号です.
+    //! @retval true    交差しています.
+    //! @retval false   交差はありません.
+    //! @note       三角形は Ray::Intersects() で判定します.
+    //---------------------------------------------------------------------------------
+    bool Intersects( const Ray& ray, f32& distance, u32& triangleIndex ) const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      レイが指定した距離までに三角形と交差するかどうか判定します.
+    //!
+    //! @param [in]     ray         判定するレイです.
+    //! @param [in]     distance    判定する最大の距離です.
+    //! @retval true    交差しています.
+    //! @retval false   交差はありません.
+    //! @note       最初に見つかった交差で走査を打ち切ります.
+    //---------------------------------------------------------------------------------
+    bool IsOccluded( const Ray& ray, f32 distance ) const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      視錐台と境界箱が交差する三角形の番号を出力します.
+    //!
+    //! @param [in]     frustum             判定する視錐台です.
+    //! @param [out]    pTriangleIndices    三角形の番号の出力先です. 三角形数分の領域が必要です.
+    //! @return     出力した三角形の番号の数を返却します.
+    //---------------------------------------------------------------------------------
+    u32 Intersects( const BoundingFrustum& frustum, u32* pTriangleIndices ) const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      境界球と境界箱が交差する三角形の番号を出力します.
+    //!
+    //! @param [in]     sphere              判定する境界球です.
+    //! @param [out]    pTriangleIndices    三角形の番号の出力先です. 三角形数分の領域が必要です.
+    //! @return     出力した三角形の番号の数を返却します.
+    //---------------------------------------------------------------------------------
+    u32 Intersects( const BoundingSphere& sphere, u32* pTriangleIndices ) const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      三角形数を取得します.
+    //---------------------------------------------------------------------------------
+    u32 GetTriangleCount() const;
+
+    //---------------------------------------------------------------------------------
+    //! @brief      BVH を取得します.
+    //---------------------------------------------------------------------------------
+    const Bvh& GetBvh() const;
+
+protected:
+    //=================================================================================
+    // protected variables.
+    //=================================================================================
+    Bvh                     m_Bvh;          //!< 三角形の境界箱の BVH です.
+    std::vector<Triangle>   m_Triangles;    //!< 葉の順に並べた三角形です.
+
+    //=================================================================================
+    // protected methods.
+    //=================================================================================
+    /* NOTHING */
+
+private:
+    //=================================================================================
+    // private variables.
+    //=================================================================================
+    /* NOTHING */
+
+    //=================================================================================
+    // private methods.
+    //=================================================================================
+    MeshBvh         ( const MeshBvh& value );   // アクセス禁止.
+    void operator = ( const MeshBvh& value );   // アクセス禁止.
+};
+
+} // namespace asdx
+
+
+//-------------------------------------------------------------------------------------
+// Inline Files
+//-------------------------------------------------------------------------------------
+#include "asdxBvh.inl"
+
+
+#endif//__ASDX_BVH_H__
@@ -0,0 +1,934 @@
+﻿//-------------------------------------------------------------------------------------
+// File : asdxBvh.inl
+// Desc : Bounding Volume Hierarchy Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------
+
+#ifndef __ASDX_BVH_INL__
+#define __ASDX_BVH_INL__
+
+
+namespace asdx {
+
+namespace simd {
+
+///////////////////////////////////////////////////////////////////////////////////////
+// BvhRay structure
+///////////////////////////////////////////////////////////////////////////////////////
+#if defined(ASDX_USE_SSE) && ASDX_USE_SSE
+struct BvhRay
+{
+    __m128  origin;     //!< 位置です. w は0です.
+    __m128  inverse;    //!< 方向の逆数です. w は0です.
+    __m128  mask;       //!< xyz の全ビットが立ったマスクです.
+};
+#else
+struct BvhRay
+{
+    f32     origin [ 3 ];   //!< 位置です.
+    f32     inverse[ 3 ];   //!< 方向の逆数です.
+};
+#endif//ASDX_USE_SSE
+
+//-------------------------------------------------------------------------------------
+//      方向の逆数を求めます.
+//      0 除算で無限大になると ( min - position ) が 0 のときに NaN になるので，
+//      0 とみなせる成分は有限の最大値に置き換える.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 GetBvhInverse( f32 value )
+{
+    if ( fabs( value ) < F32_MIN )
+    { return ( value < 0.0f ) ? -F32_MAX : F32_MAX; }
+
+    return 1.0f / value;
+}
+
+//-------------------------------------------------------------------------------------
+//      レイを走査用の形式に変換します.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+void SetBvhRay( const Ray& ray, BvhRay& result )
+{
+#if defined(ASDX_USE_SSE) && ASDX_USE_SSE
+    result.origin  = _mm_setr_ps( ray.position.x, ray.position.y, ray.position.z, 0.0f );
+    result.inverse = _mm_setr_ps(
+        GetBvhInverse( ray.direction.x ),
+        GetBvhInverse( ray.direction.y ),
+        GetBvhInverse( ray.direction.z ),
+        0.0f );
+    result.mask    = _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ) );
+#else
+    result.origin [ 0 ] = ray.position.x;
+    result.origin [ 1 ] = ray.position.y;
+    result.origin [ 2 ] = ray.position.z;
+    result.inverse[ 0 ] = GetBvhInverse( ray.direction.x );
+    result.inverse[ 1 ] = GetBvhInverse( ray.direction.y );
+    result.inverse[ 2 ] = GetBvhInverse( ray.direction.z );
+#endif//ASDX_USE_SSE
+}
+
+//-------------------------------------------------------------------------------------
+//      ノードの境界箱とレイの交差判定を行います.
+//      distance より手前で交差していれば入る距離を，そうでなければ F32_MAX を返却します.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 IntersectBvhNode( const BvhRay& ray, const BvhNode& node, f32 distance )
+{
+    // 丸め誤差で三角形を取りこぼさないように，出る距離を少しだけ延ばす.
+    const f32 scale = 1.0f + 4.0f * F32_EPSILON;
+
+#if defined(ASDX_USE_SSE) && ASDX_USE_SSE
+    // w には offset, count が入っているので，非正規化数の演算にならないように落としておく.
+    __m128 mini = _mm_and_ps( _mm_loadu_ps( &node.min.x ), ray.mask );
+    __m128 maxi = _mm_and_ps( _mm_loadu_ps( &node.max.x ), ray.mask );
+    __m128 t1   = _mm_mul_ps( _mm_sub_ps( mini, ray.origin ), ray.inverse );
+    __m128 t2   = _mm_mul_ps( _mm_sub_ps( maxi, ray.origin ), ray.inverse );
+
+    // w は0になるので，入る距離は0以上に切り上げられる. 出る距離は w に x を複製して除外する.
+    __m128 tmin = _mm_min_ps( t1, t2 );
+    __m128 tmax = _mm_max_ps( t1, t2 );
+    tmax = _mm_shuffle_ps( tmax, tmax, _MM_SHUFFLE( 0, 2, 1, 0 ) );
+
+    tmin = _mm_max_ps( tmin, _mm_shuffle_ps( tmin, tmin, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+    tmin = _mm_max_ps( tmin, _mm_shuffle_ps( tmin, tmin, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+    tmax = _mm_min_ps( tmax, _mm_shuffle_ps( tmax, tmax, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+    tmax = _mm_min_ps( tmax, _mm_shuffle_ps( tmax, tmax, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+    f32 tnear = _mm_cvtss_f32( tmin );
+    f32 tfar  = _mm_cvtss_f32( tmax ) * scale;
+#else
+    const f32* pMin = &node.min.x;
+    const f32* pMax = &node.max.x;
+    f32 tnear = 0.0f;
+    f32 tfar  = F32_MAX;
+
+    for( u32 i=0; i<3; ++i )
+    {
+        f32 t1 = ( pMin[ i ] - ray.origin[ i ] ) * ray.inverse[ i ];
+        f32 t2 = ( pMax[ i ] - ray.origin[ i ] ) * ray.inverse[ i ];
+        tnear = asdx::Max<f32>( tnear, asdx::Min<f32>( t1, t2 ) );
+        tfar  = asdx::Min<f32>( tfar,  asdx::Max<f32>( t1, t2 ) );
+    }
+
+    tfar *= scale;
+#endif//ASDX_USE_SSE
+
+    return ( tnear <= tfar && tnear < distance ) ? tnear : F32_MAX;
+}
+
+//-------------------------------------------------------------------------------------
+//      境界箱を残りの平面と判定します. 外側ならば false を返却し，完全に内側にある平面のビットを落とします.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+bool CullBvhNode( const BoundingFrustum& frustum, const BvhNode& node, u32& planeMask )
+{
+    // BoundingFrustum::Contains() と同じ式で判定する.
+    Vector3 center  = ( node.max + node.min ) * 0.5f;
+    Vector3 extents = ( node.max - node.min ) * 0.5f;
+
+    for( u32 i=0; i<6; ++i )
+    {
+        if ( ( planeMask & ( 0x1 << i ) ) == 0 )
+        { continue; }
+
+        const Plane& p = frustum.plane[ i ];
+        f32 dist   = p.DotCoordinate( center );
+        f32 radius = ( fabs( p.normal.x ) * extents.x )
+                   + ( fabs( p.normal.y ) * extents.y )
+                   + ( fabs( p.normal.z ) * extents.z );
+
+        if ( dist < -radius )
+        { return false; }
+
+        if ( dist > radius )
+        { planeMask &= ~( 0x1 << i ); }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+//      境界箱と境界球の交差判定を行います. BoundingSphere::Intersects() と同じ式で判定します.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+bool IntersectBvhNode( const BoundingSphere& sphere, const BvhNode& node )
+{
+    Vector3 vec = Vector3::Clamp( sphere.center, node.min, node.max );
+    return ( Vector3::DistanceSq( sphere.center, vec ) <= ( sphere.radius * sphere.radius ) );
+}
+
+//-------------------------------------------------------------------------------------
+//      境界箱の表面積の半分を求めます.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 GetHalfArea( const Vector3& mini, const Vector3& maxi )
+{
+    Vector3 size = maxi - mini;
+    return ( size.x * size.y ) + ( size.y * size.z ) + ( size.z * size.x );
+}
+
+} // namespace simd
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Bvh class
+///////////////////////////////////////////////////////////////////////////////////////
+
+///------------------------------------------------------------------------------------
+///<summary>コンストラクタです.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Bvh::Bvh()
+{ /* DO_NOTHING */ }
+
+///------------------------------------------------------------------------------------
+///<summary>デストラクタです.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+Bvh::~Bvh()
+{ Term(); }
+
+///------------------------------------------------------------------------------------
+///<summary>初期化処理です.</summary>
+///<param name="pBoxes">プリミティブの境界箱.</param>
+///<param name="count">プリミティブ数.</param>
+///<param name="threadCount">構築に使用するスレッド数.</param>
+///<return>初期化に成功したらtrue, 失敗したらfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool Bvh::Init( const BoundingBox* pBoxes, u32 count, u32 threadCount )
+{
+    Term();
+
+    if ( pBoxes == nullptr || count == 0 )
+    { return false; }
+
+    m_Primitives.resize( count );
+    for( u32 i=0; i<count; ++i )
+    {
+        m_Primitives[ i ].min    = pBoxes[ i ].min;
+        m_Primitives[ i ].offset = i;
+        m_Primitives[ i ].max    = pBoxes[ i ].max;
+        m_Primitives[ i ].count  = 1;
+    }
+
+    return Build( threadCount );
+}
+
+///------------------------------------------------------------------------------------
+///<summary>終了処理です.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+void Bvh::Term()
+{
+    m_Nodes.clear();
+    m_Primitives.clear();
+}
+
+///------------------------------------------------------------------------------------
+///<summary>m_Primitives から構築します.</summary>
+///<param name="threadCount">構築に使用するスレッド数.</param>
+///<return>構築に成功したらtrue, 失敗したらfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool Bvh::Build( u32 threadCount )
+{
+    u32 count = u32( m_Primitives.size() );
+    if ( count == 0 || count > 0x7fffffff )
+    { return false; }
+
+    // 2^spawnDepth が threadCount 以上になる深さまで，子を別スレッドで構築する.
+    u32 spawnDepth = 0;
+    while( ( 1u << spawnDepth ) < threadCount && spawnDepth < 16 )
+    { spawnDepth++; }
+
+    // プリミティブ数 n の部分木は高々 2n - 1 個のノードになるので，
+    // 左右の部分木に重ならない領域を割り当てて，スレッド間で同期せずに書き込む.
+    std::vector<BvhNode> nodes( count * 2 - 1 );
+    BuildNode( &nodes[ 0 ], 0, 0, count, 0, spawnDepth );
+
+    m_Nodes.reserve( count * 2 - 1 );
+    CompactNode( &nodes[ 0 ], 0 );
+
+    return true;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>部分木を構築します.</summary>
+///<param name="pNodes">作業用のノード.</param>
+///<param name="index">部分木の根の番号.</param>
+///<param name="first">先頭のプリミティブの位置.</param>
+///<param name="count">プリミティブ数.</param>
+///<param name="depth">部分木の根の深さ.</param>
+///<param name="spawnDepth">子を別スレッドで構築する深さ.</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+void Bvh::BuildNode( BvhNode* pNodes, u32 index, u32 first, u32 count, u32 depth, u32 spawnDepth )
+{
+    BvhNode* pPrims = &m_Primitives[ first ];
+    BvhNode& node   = pNodes[ index ];
+
+    // 境界箱と，中心の範囲を求める. 中心は2倍した値 ( min + max ) で扱う.
+    Vector3 boxMin   ( F32_MAX, F32_MAX, F32_MAX );
+    Vector3 boxMax   ( -F32_MAX, -F32_MAX, -F32_MAX );
+    Vector3 centerMin( F32_MAX, F32_MAX, F32_MAX );
+    Vector3 centerMax( -F32_MAX, -F32_MAX, -F32_MAX );
+
+    for( u32 i=0; i<count; ++i )
+    {
+        Vector3 center = pPrims[ i ].min + pPrims[ i ].max;
+        boxMin    = Vector3::Min( boxMin, pPrims[ i ].min );
+        boxMax    = Vector3::Max( boxMax, pPrims[ i ].max );
+        centerMin = Vector3::Min( centerMin, center );
+        centerMax = Vector3::Max( centerMax, center );
+    }
+
+    node.min    = boxMin;
+    node.max    = boxMax;
+    node.offset = first;
+    node.count  = count;
+
+    if ( count == 1 || depth + 1 >= NUM_MAX_DEPTH )
+    { return; }
+
+    // 3軸のビンに1回の走査で振り分けて，SAH が最小になる分割面を探す.
+    // 下位のノードはビンの初期化と走査が支配的になるので，ビンの数をプリミティブ数までに抑える.
+    u32 binNum = Min<u32>( count, NUM_BIN );
+    f32 lower[ 3 ];
+    f32 scale[ 3 ];
+    for( u32 axis=0; axis<3; ++axis )
+    {
+        f32 extent = ( &centerMax.x )[ axis ] - ( &centerMin.x )[ axis ];
+        lower[ axis ] = ( &centerMin.x )[ axis ];
+        scale[ axis ] = ( extent > 0.0f ) ? f32( binNum ) / extent : 0.0f;
+    }
+
+    Vector3 binMin  [ 3 ][ NUM_BIN ];
+    Vector3 binMax  [ 3 ][ NUM_BIN ];
+    u32     binCount[ 3 ][ NUM_BIN ];
+    for( u32 axis=0; axis<3; ++axis )
+    {
+        for( u32 i=0; i<binNum; ++i )
+        {
+            binMin  [ axis ][ i ] = Vector3( F32_MAX, F32_MAX, F32_MAX );
+            binMax  [ axis ][ i ] = Vector3( -F32_MAX, -F32_MAX, -F32_MAX );
+            binCount[ axis ][ i ] = 0;
+        }
+    }
+
+    for( u32 i=0; i<count; ++i )
+    {
+        const BvhNode& prim = pPrims[ i ];
+        for( u32 axis=0; axis<3; ++axis )
+        {
+            f32 center = ( &prim.min.x )[ axis ] + ( &prim.max.x )[ axis ];
+            u32 bin    = Min<u32>( u32( ( center - lower[ axis ] ) * scale[ axis ] ), binNum - 1 );
+            binMin  [ axis ][ bin ] = Vector3::Min( binMin[ axis ][ bin ], prim.min );
+            binMax  [ axis ][ bin ] = Vector3::Max( binMax[ axis ][ bin ], prim.max );
+            binCount[ axis ][ bin ]++;
+        }
+    }
+
+    f32 bestCost = F32_MAX;
+    u32 bestAxis = 3;
+    u32 bestBin  = 0;
+
+    for( u32 axis=0; axis<3; ++axis )
+    {
+        if ( scale[ axis ] == 0.0f )
+        { continue; }
+
+        // 左側から累積した SAH の項を求めておき，右側から累積しながら合計する.
+        f32     leftCost[ NUM_BIN ];
+        Vector3 accMin( F32_MAX, F32_MAX, F32_MAX );
+        Vector3 accMax( -F32_MAX, -F32_MAX, -F32_MAX );
+        u32     accCount = 0;
+        for( u32 i=0; i<binNum - 1; ++i )
+        {
+            accMin    = Vector3::Min( accMin, binMin[ axis ][ i ] );
+            accMax    = Vector3::Max( accMax, binMax[ axis ][ i ] );
+            accCount += binCount[ axis ][ i ];
+            leftCost[ i ] = ( accCount > 0 ) ? simd::GetHalfArea( accMin, accMax ) * f32( accCount ) : 0.0f;
+        }
+
+        accMin   = Vector3( F32_MAX, F32_MAX, F32_MAX );
+        accMax   = Vector3( -F32_MAX, -F32_MAX, -F32_MAX );
+        accCount = 0;
+        for( u32 i=binNum - 1; i>0; --i )
+        {
+            accMin    = Vector3::Min( accMin, binMin[ axis ][ i ] );
+            accMax    = Vector3::Max( accMax, binMax[ axis ][ i ] );
+            accCount += binCount[ axis ][ i ];
+
+            f32 rightCost = ( accCount > 0 ) ? simd::GetHalfArea( accMin, accMax ) * f32( accCount ) : 0.0f;
+            f32 cost = leftCost[ i - 1 ] + rightCost;
+            if ( cost < bestCost )
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin  = i;
+            }
+        }
+    }
+
+    u32 leftCount = 0;
+
+    if ( bestAxis < 3 )
+    {
+        // 分割しない場合の SAH の方が小さければ葉にする. 走査のコストは交差判定1回分とする.
+        f32 area = simd::GetHalfArea( boxMin, boxMax );
+        if ( count <= NUM_MAX_LEAF && area + bestCost >= area * f32( count ) )
+        { return; }
+
+        // 集計と同じ式でビンを求めて並べ替える.
+        u32 i = 0;
+        u32 j = count;
+        while( i < j )
+        {
+            f32 center = ( &pPrims[ i ].min.x )[ bestAxis ] + ( &pPrims[ i ].max.x )[ bestAxis ];
+            u32 bin    = Min<u32>( u32( ( center - lower[ bestAxis ] ) * scale[ bestAxis ] ), binNum - 1 );
+            if ( bin < bestBin )
+            { i++; }
+            else
+            {
+                j--;
+                BvhNode tmp = pPrims[ i ];
+                pPrims[ i ] = pPrims[ j ];
+                pPrims[ j ] = tmp;
+            }
+        }
+
+        leftCount = i;
+    }
+
+    if ( leftCount == 0 || leftCount == count )
+    {
+        // 中心が全て同じ場合は分割できないので，数が多ければ半分に分ける.
+        if ( count <= NUM_MAX_LEAF )
+        { return; }
+
+        leftCount = count / 2;
+    }
+
+    u32 rightCount = count - leftCount;
+    u32 left       = index + 1;
+    u32 right      = index + 2 * leftCount;
+
+    node.offset = right;
+    node.count  = 0;
+
+    if ( depth < spawnDepth && count >= NUM_MIN_PARALLEL )
+    {
+        std::thread thread( [ this, pNodes, left, first, leftCount, depth, spawnDepth ]()
+        {
+            BuildNode( pNodes, left, first, leftCount, depth + 1, spawnDepth );
+        } );
+        BuildNode( pNodes, right, first + leftCount, rightCount, depth + 1, spawnDepth );
+        thread.join();
+    }
+    else
+    {
+        BuildNode( pNodes, left,  first, leftCount, depth + 1, spawnDepth );
+        BuildNode( pNodes, right, first + leftCount, rightCount, depth + 1, spawnDepth );
+    }
+}
+
+///------------------------------------------------------------------------------------
+///<summary>作業用のノードを左の子が親の直後に並ぶように詰めます.</summary>
+///<param name="pNodes">作業用のノード.</param>
+///<param name="index">詰める部分木の根の番号.</param>
+///<return>詰めた後の番号を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Bvh::CompactNode( const BvhNode* pNodes, u32 index )
+{
+    u32 result = u32( m_Nodes.size() );
+    m_Nodes.push_back( pNodes[ index ] );
+
+    if ( pNodes[ index ].count == 0 )
+    {
+        CompactNode( pNodes, index + 1 );
+        m_Nodes[ result ].offset = CompactNode( pNodes, pNodes[ index ].offset );
+    }
+
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>レイと交差する葉のプリミティブを近い順に列挙します.</summary>
+///<param name="ray">判定するレイ.</param>
+///<param name="distance">判定する最大の距離.</param>
+///<param name="anyHit">最初に交差したところで打ち切るかどうか.</param>
+///<param name="func">プリミティブの判定関数.</param>
+///<return>いずれかのプリミティブと交差していればtrue, そうでなければfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+template<typename Func>
+ASDX_INLINE
+bool Bvh::Traverse( const Ray& ray, f32& distance, bool anyHit, Func& func ) const
+{
+    if ( m_Nodes.empty() )
+    { return false; }
+
+    simd::BvhRay bvhRay;
+    simd::SetBvhRay( ray, bvhRay );
+
+    const BvhNode* pNodes = &m_Nodes[ 0 ];
+    if ( simd::IntersectBvhNode( bvhRay, pNodes[ 0 ], distance ) == F32_MAX )
+    { return false; }
+
+    u32  stackIndex[ NUM_MAX_DEPTH ];
+    f32  stackDist [ NUM_MAX_DEPTH ];
+    u32  stackCount = 0;
+    u32  index      = 0;
+    bool hit        = false;
+
+    for( ;; )
+    {
+        const BvhNode& node = pNodes[ index ];
+
+        if ( node.count > 0 )
+        {
+            for( u32 i=0; i<node.count; ++i )
+            {
+                if ( func( node.offset + i, distance ) )
+                {
+                    hit = true;
+                    if ( anyHit )
+                    { return true; }
+                }
+            }
+        }
+        else
+        {
+            u32 nearIndex = index + 1;
+            u32 farIndex  = node.offset;
+            f32 nearDist  = simd::IntersectBvhNode( bvhRay, pNodes[ nearIndex ], distance );
+            f32 farDist   = simd::IntersectBvhNode( bvhRay, pNodes[ farIndex  ], distance );
+
+            if ( farDist < nearDist )
+            {
+                u32 tmpIndex = nearIndex; nearIndex = farIndex; farIndex = tmpIndex;
+                f32 tmpDist  = nearDist;  nearDist  = farDist;  farDist  = tmpDist;
+            }
+
+            if ( nearDist != F32_MAX )
+            {
+                // 深さは NUM_MAX_DEPTH 未満なので，積む数も NUM_MAX_DEPTH を超えない.
+                if ( farDist != F32_MAX )
+                {
+                    assert( stackCount < NUM_MAX_DEPTH );
+                    stackIndex[ stackCount ] = farIndex;
+                    stackDist [ stackCount ] = farDist;
+                    stackCount++;
+                }
+
+                index = nearIndex;
+                continue;
+            }
+        }
+
+        // 積んだ後に distance が更新されていれば，遠いノードは読み飛ばす.
+        for( ;; )
+        {
+            if ( stackCount == 0 )
+            { return hit; }
+
+            stackCount--;
+            if ( stackDist[ stackCount ] < distance )
+            {
+                index = stackIndex[ stackCount ];
+                break;
+            }
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------
+///<summary>レイと最も近いプリミティブの境界箱を求めます.</summary>
+///<param name="ray">判定するレイ.</param>
+///<param name="distance">交差点までの距離.</param>
+///<param name="index">交差したプリミティブの番号.</param>
+///<return>交差していればtrue, そうでなければfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool Bvh::Intersects( const Ray& ray, f32& distance, u32& index ) const
+{
+    const BvhNode* pPrims = m_Primitives.empty() ? nullptr : &m_Primitives[ 0 ];
+    u32 position = 0;
+
+    auto func = [ &ray, pPrims, &position ]( u32 i, f32& dist ) -> bool
+    {
+        f32 t;
+        if ( !ray.Intersects( BoundingBox( pPrims[ i ].min, pPrims[ i ].max ), t ) || t >= dist )
+        { return false; }
+
+        dist     = t;
+        position = i;
+        return true;
+    };
+
+    distance = F32_MAX;
+    if ( !Traverse( ray, distance, false, func ) )
+    {
+        distance = 0.0f;
+        return false;
+    }
+
+    index = pPrims[ position ].offset;
+    return true;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>視錐台と交差するプリミティブの番号を出力します.</summary>
+///<param name="frustum">判定する視錐台.</param>
+///<param name="pIndices">プリミティブ番号の出力先.</param>
+///<return>出力したプリミティブ番号の数を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Bvh::Intersects( const BoundingFrustum& frustum, u32* pIndices ) const
+{
+    assert( pIndices != nullptr );
+
+    if ( m_Nodes.empty() )
+    { return 0; }
+
+    const BvhNode* pNodes = &m_Nodes[ 0 ];
+    const BvhNode* pPrims = &m_Primitives[ 0 ];
+
+    u32 stackIndex[ NUM_MAX_DEPTH ];
+    u32 stackMask [ NUM_MAX_DEPTH ];
+    u32 stackCount = 0;
+    u32 index      = 0;
+    u32 planeMask  = 0x3f;
+    u32 result     = 0;
+
+    for( ;; )
+    {
+        const BvhNode& node = pNodes[ index ];
+
+        if ( simd::CullBvhNode( frustum, node, planeMask ) )
+        {
+            if ( node.count > 0 )
+            {
+                for( u32 i=node.offset; i<node.offset + node.count; ++i )
+                {
+                    u32 mask = planeMask;
+                    if ( mask == 0 || simd::CullBvhNode( frustum, pPrims[ i ], mask ) )
+                    { pIndices[ result++ ] = pPrims[ i ].offset; }
+                }
+            }
+            else
+            {
+                assert( stackCount < NUM_MAX_DEPTH );
+                stackIndex[ stackCount ] = node.offset;
+                stackMask [ stackCount ] = planeMask;
+                stackCount++;
+
+                index = index + 1;
+                continue;
+            }
+        }
+
+        if ( stackCount == 0 )
+        { break; }
+
+        stackCount--;
+        index     = stackIndex[ stackCount ];
+        planeMask = stackMask [ stackCount ];
+    }
+
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>境界球と交差するプリミティブの番号を出力します.</summary>
+///<param name="sphere">判定する境界球.</param>
+///<param name="pIndices">プリミティブ番号の出力先.</param>
+///<return>出力したプリミティブ番号の数を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Bvh::Intersects( const BoundingSphere& sphere, u32* pIndices ) const
+{
+    assert( pIndices != nullptr );
+
+    if ( m_Nodes.empty() )
+    { return 0; }
+
+    const BvhNode* pNodes = &m_Nodes[ 0 ];
+    const BvhNode* pPrims = &m_Primitives[ 0 ];
+
+    u32 stack[ NUM_MAX_DEPTH ];
+    u32 stackCount = 0;
+    u32 index      = 0;
+    u32 result     = 0;
+
+    for( ;; )
+    {
+        const BvhNode& node = pNodes[ index ];
+
+        if ( simd::IntersectBvhNode( sphere, node ) )
+        {
+            if ( node.count > 0 )
+            {
+                for( u32 i=node.offset; i<node.offset + node.count; ++i )
+                {
+                    if ( simd::IntersectBvhNode( sphere, pPrims[ i ] ) )
+                    { pIndices[ result++ ] = pPrims[ i ].offset; }
+                }
+            }
+            else
+            {
+                assert( stackCount < NUM_MAX_DEPTH );
+                stack[ stackCount++ ] = node.offset;
+
+                index = index + 1;
+                continue;
+            }
+        }
+
+        if ( stackCount == 0 )
+        { break; }
+
+        index = stack[ --stackCount ];
+    }
+
+    return result;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>ノード数を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Bvh::GetNodeCount() const
+{ return u32( m_Nodes.size() ); }
+
+///------------------------------------------------------------------------------------
+///<summary>ノードを取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const BvhNode* Bvh::GetNodes() const
+{ return m_Nodes.empty() ? nullptr : &m_Nodes[ 0 ]; }
+
+///------------------------------------------------------------------------------------
+///<summary>プリミティブ数を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 Bvh::GetPrimitiveCount() const
+{ return u32( m_Primitives.size() ); }
+
+///------------------------------------------------------------------------------------
+///<summary>葉の順に並べたプリミティブを取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const BvhNode* Bvh::GetPrimitives() const
+{ return m_Primitives.empty() ? nullptr : &m_Primitives[ 0 ]; }
+
+///------------------------------------------------------------------------------------
+///<summary>全体の境界箱を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+BoundingBox Bvh::GetBox() const
+{
+    if ( m_Nodes.empty() )
+    { return BoundingBox( Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 0.0f, 0.0f, 0.0f ) ); }
+
+    return BoundingBox( m_Nodes[ 0 ].min, m_Nodes[ 0 ].max );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// MeshBvh class
+///////////////////////////////////////////////////////////////////////////////////////
+
+///------------------------------------------------------------------------------------
+///<summary>コンストラクタです.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+MeshBvh::MeshBvh()
+{ /* DO_NOTHING */ }
+
+///------------------------------------------------------------------------------------
+///<summary>デストラクタです.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+MeshBvh::~MeshBvh()
+{ Term(); }
+
+///------------------------------------------------------------------------------------
+///<summary>初期化処理です.</summary>
+///<param name="pPositions">先頭の頂点の位置座標.</param>
+///<param name="stride">頂点のサイズ.</param>
+///<param name="vertexCount">頂点数.</param>
+///<param name="pIndices">頂点インデックス.</param>
+///<param name="indexCount">頂点インデックス数.</param>
+///<param name="threadCount">構築に使用するスレッド数.</param>
+///<return>初期化に成功したらtrue, 失敗したらfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool MeshBvh::Init
+(
+    const Vector3*  pPositions,
+    u32             stride,
+    u32             vertexCount,
+    const u32*      pIndices,
+    u32             indexCount,
+    u32             threadCount
+)
+{
+    Term();
+
+    if ( pPositions == nullptr || pIndices == nullptr || stride < sizeof(Vector3) )
+    { return false; }
+
+    if ( indexCount == 0 || ( indexCount % 3 ) != 0 )
+    { return false; }
+
+    const u8* pBase = reinterpret_cast<const u8*>( pPositions );
+    u32 triangleCount = indexCount / 3;
+
+    std::vector<BvhNode>& prims = m_Bvh.m_Primitives;
+    prims.resize( triangleCount );
+
+    for( u32 i=0; i<triangleCount; ++i )
+    {
+        u32 i0 = pIndices[ i * 3 + 0 ];
+        u32 i1 = pIndices[ i * 3 + 1 ];
+        u32 i2 = pIndices[ i * 3 + 2 ];
+        if ( i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount )
+        {
+            Term();
+            return false;
+        }
+
+        const Vector3& p0 = *reinterpret_cast<const Vector3*>( pBase + size_t( i0 ) * stride );
+        const Vector3& p1 = *reinterpret_cast<const Vector3*>( pBase + size_t( i1 ) * stride );
+        const Vector3& p2 = *reinterpret_cast<const Vector3*>( pBase + size_t( i2 ) * stride );
+
+        prims[ i ].min    = Vector3::Min( Vector3::Min( p0, p1 ), p2 );
+        prims[ i ].offset = i;
+        prims[ i ].max    = Vector3::Max( Vector3::Max( p0, p1 ), p2 );
+        prims[ i ].count  = 1;
+    }
+
+    if ( !m_Bvh.Build( threadCount ) )
+    {
+        Term();
+        return false;
+    }
+
+    // 走査中に頂点インデックスを引かずに済むように，三角形を葉の順に複製する.
+    m_Triangles.resize( triangleCount );
+    for( u32 i=0; i<triangleCount; ++i )
+    {
+        u32 id = prims[ i ].offset;
+        m_Triangles[ i ].p0 = *reinterpret_cast<const Vector3*>( pBase + size_t( pIndices[ id * 3 + 0 ] ) * stride );
+        m_Triangles[ i ].p1 = *reinterpret_cast<const Vector3*>( pBase + size_t( pIndices[ id * 3 + 1 ] ) * stride );
+        m_Triangles[ i ].p2 = *reinterpret_cast<const Vector3*>( pBase + size_t( pIndices[ id * 3 + 2 ] ) * stride );
+    }
+
+    return true;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>終了処理です.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+void MeshBvh::Term()
+{
+    m_Bvh.Term();
+    m_Triangles.clear();
+}
+
+///------------------------------------------------------------------------------------
+///<summary>レイと最も近い三角形を求めます.</summary>
+///<param name="ray">判定するレイ.</param>
+///<param name="distance">交差点までの距離.</param>
+///<param name="triangleIndex">交差した三角形の番号.</param>
+///<return>交差していればtrue, そうでなければfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool MeshBvh::Intersects( const Ray& ray, f32& distance, u32& triangleIndex ) const
+{
+    const Triangle* pTriangles = m_Triangles.empty() ? nullptr : &m_Triangles[ 0 ];
+    u32 position = 0;
+
+    auto func = [ &ray, pTriangles, &position ]( u32 i, f32& dist ) -> bool
+    {
+        f32 t;
+        if ( !ray.Intersects( pTriangles[ i ].p0, pTriangles[ i ].p1, pTriangles[ i ].p2, t ) || t >= dist )
+        { return false; }
+
+        dist     = t;
+        position = i;
+        return true;
+    };
+
+    distance = F32_MAX;
+    if ( !m_Bvh.Traverse( ray, distance, false, func ) )
+    {
+        distance = 0.0f;
+        return false;
+    }
+
+    triangleIndex = m_Bvh.m_Primitives[ position ].offset;
+    return true;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>レイが指定した距離までに三角形と交差するかどうか判定します.</summary>
+///<param name="ray">判定するレイ.</param>
+///<param name="distance">判定する最大の距離.</param>
+///<return>交差していればtrue, そうでなければfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool MeshBvh::IsOccluded( const Ray& ray, f32 distance ) const
+{
+    const Triangle* pTriangles = m_Triangles.empty() ? nullptr : &m_Triangles[ 0 ];
+
+    auto func = [ &ray, pTriangles ]( u32 i, f32& dist ) -> bool
+    {
+        f32 t;
+        return ray.Intersects( pTriangles[ i ].p0, pTriangles[ i ].p1, pTriangles[ i ].p2, t ) && t < dist;
+    };
+
+    return m_Bvh.Traverse( ray, distance, true, func );
+}
+
+///------------------------------------------------------------------------------------
+///<summary>視錐台と境界箱が交差する三角形の番号を出力します.</summary>
+///<param name="frustum">判定する視錐台.</param>
+///<param name="pTriangleIndices">三角形の番号の出力先.</param>
+///<return>出力した三角形の番号の数を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 MeshBvh::Intersects( const BoundingFrustum& frustum, u32* pTriangleIndices ) const
+{ return m_Bvh.Intersects( frustum, pTriangleIndices ); }
+
+///------------------------------------------------------------------------------------
+///<summary>境界球と境界箱が交差する三角形の番号を出力します.</summary>
+///<param name="sphere">判定する境界球.</param>
+///<param name="pTriangleIndices">三角形の番号の出力先.</param>
+///<return>出力した三角形の番号の数を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 MeshBvh::Intersects( const BoundingSphere& sphere, u32* pTriangleIndices ) const
+{ return m_Bvh.Intersects( sphere, pTriangleIndices ); }
+
+///------------------------------------------------------------------------------------
+///<summary>三角形数を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 MeshBvh::GetTriangleCount() const
+{ return u32( m_Triangles.size() ); }
+
+///------------------------------------------------------------------------------------
+///<summary>BVH を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const Bvh& MeshBvh::GetBvh() const
+{ return m_Bvh; }
+
+} // namespace asdx
+
+#endif//__ASDX_BVH_INL__
@@ -0,0 +1,477 @@
+﻿//-------------------------------------------------------------------------------------
+// File : asdxCulling.inl
+// Desc : Culling Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------
+
+#ifndef __ASDX_CULLING_INL__
+#define __ASDX_CULLING_INL__
+
+
+namespace asdx {
+
+namespace simd {
+
+///////////////////////////////////////////////////////////////////////////////////////
+// CullingPlanes structure
+///////////////////////////////////////////////////////////////////////////////////////
+struct CullingPlanes
+{
+    f32x8   nx[ 6 ];        //!< 法線のX成分です.
+    f32x8   ny[ 6 ];        //!< 法線のY成分です.
+    f32x8   nz[ 6 ];        //!< 法線のZ成分です.
+    f32x8   d [ 6 ];        //!< 原点からの距離です.
+    f32x8   ax[ 6 ];        //!< 法線のX成分の絶対値です.
+    f32x8   ay[ 6 ];        //!< 法線のY成分の絶対値です.
+    f32x8   az[ 6 ];        //!< 法線のZ成分の絶対値です.
+};
+
+//-------------------------------------------------------------------------------------
+//      視錐台の6平面を各要素に展開します.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+void SetCullingPlanes( const BoundingFrustum& frustum, CullingPlanes& result )
+{
+    for( u32 i=0; i<6; ++i )
+    {
+        const Plane& p = frustum.plane[ i ];
+        result.nx[ i ] = Splat8( p.normal.x );
+        result.ny[ i ] = Splat8( p.normal.y );
+        result.nz[ i ] = Splat8( p.normal.z );
+        result.d [ i ] = Splat8( p.d );
+        result.ax[ i ] = Splat8( fabs( p.normal.x ) );
+        result.ay[ i ] = Splat8( fabs( p.normal.y ) );
+        result.az[ i ] = Splat8( fabs( p.normal.z ) );
+    }
+}
+
+//-------------------------------------------------------------------------------------
+//      index から8個の境界ボリュームを判定し，可視な要素のビットを立てたマスクを返却します.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 CullBounds8( const CullingPlanes& planes, const BoundsArray& bounds, u32 index )
+{
+    f32x8 cx  = Load8( bounds.GetCenterX() + index );
+    f32x8 cy  = Load8( bounds.GetCenterY() + index );
+    f32x8 cz  = Load8( bounds.GetCenterZ() + index );
+    f32x8 ex  = Load8( bounds.GetExtentX() + index );
+    f32x8 ey  = Load8( bounds.GetExtentY() + index );
+    f32x8 ez  = Load8( bounds.GetExtentZ() + index );
+    f32x8 rad = Load8( bounds.GetRadius()  + index );
+    mask8 outside = FromBits( 0 );
+
+    for( u32 i=0; i<6; ++i )
+    {
+        // BoundingFrustum::Contains() と同じ順序で加算する.
+        f32x8 dist = Mul( planes.nx[ i ], cx );
+        dist = Add( dist, Mul( planes.ny[ i ], cy ) );
+        dist = Add( dist, Mul( planes.nz[ i ], cz ) );
+        dist = Add( dist, planes.d[ i ] );
+
+        f32x8 r = Mul( planes.ax[ i ], ex );
+        r = Add( r, Mul( planes.ay[ i ], ey ) );
+        r = Add( r, Mul( planes.az[ i ], ez ) );
+        r = Min( r, rad );
+
+        outside = Or( outside, CmpLt( dist, Neg( r ) ) );
+    }
+
+    return ( ~ToBits( outside ) ) & 0xff;
+}
+
+} // namespace simd
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// BoundsArray class
+///////////////////////////////////////////////////////////////////////////////////////
+
+///------------------------------------------------------------------------------------
+///<summary>コンストラクタです.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+BoundsArray::BoundsArray()
+: m_pData   ( nullptr )
+, m_pCenterX( nullptr )
+, m_pCenterY( nullptr )
+, m_pCenterZ( nullptr )
+, m_pExtentX( nullptr )
+, m_pExtentY( nullptr )
+, m_pExtentZ( nullptr )
+, m_pRadius ( nullptr )
+, m_Count   ( 0 )
+, m_Capacity( 0 )
+{ /* DO_NOTHING */ }
+
+///------------------------------------------------------------------------------------
+///<summary>デストラクタです.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+BoundsArray::~BoundsArray()
+{ Term(); }
+
+///------------------------------------------------------------------------------------
+///<summary>初期化処理です.</summary>
+///<param name="capacity">格納できる境界ボリュームの最大数.</param>
+///<return>初期化に成功したらtrue, 失敗したらfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool BoundsArray::Init( u32 capacity )
+{
+    Term();
+
+    if ( capacity == 0 )
+    { return false; }
+
+    // 16個ずつ読み込んでも範囲外にならないように切り上げる.
+    u32 aligned = ( capacity + NUM_BATCH - 1 ) & ~( NUM_BATCH - 1 );
+    if ( aligned < capacity )
+    { return false; }
+
+    m_pData = new (std::nothrow) f32 [ aligned * NUM_STREAM ];
+    if ( m_pData == nullptr )
+    { return false; }
+
+    // 容量を超えた要素は判定結果から除外するが，不定値を読まないようにゼロで埋めておく.
+    memset( m_pData, 0, sizeof(f32) * aligned * NUM_STREAM );
+
+    m_pCenterX = m_pData + aligned * 0;
+    m_pCenterY = m_pData + aligned * 1;
+    m_pCenterZ = m_pData + aligned * 2;
+    m_pExtentX = m_pData + aligned * 3;
+    m_pExtentY = m_pData + aligned * 4;
+    m_pExtentZ = m_pData + aligned * 5;
+    m_pRadius  = m_pData + aligned * 6;
+    m_Count    = 0;
+    m_Capacity = aligned;
+
+    return true;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>終了処理です.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+void BoundsArray::Term()
+{
+    ASDX_DELETE_ARRAY( m_pData );
+
+    m_pCenterX = nullptr;
+    m_pCenterY = nullptr;
+    m_pCenterZ = nullptr;
+    m_pExtentX = nullptr;
+    m_pExtentY = nullptr;
+    m_pExtentZ = nullptr;
+    m_pRadius  = nullptr;
+    m_Count    = 0;
+    m_Capacity = 0;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>格納した境界ボリュームを全て破棄します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+void BoundsArray::Clear()
+{ m_Count = 0; }
+
+///------------------------------------------------------------------------------------
+///<summary>境界箱を末尾に追加します.</summary>
+///<param name="value">追加する境界箱.</param>
+///<return>追加に成功したらtrue, 容量が足りなければfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool BoundsArray::Add( const BoundingBox& value )
+{
+    if ( m_Count >= m_Capacity )
+    { return false; }
+
+    m_Count++;
+    SetAt( m_Count - 1, value );
+    return true;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>境界球を末尾に追加します.</summary>
+///<param name="value">追加する境界球.</param>
+///<return>追加に成功したらtrue, 容量が足りなければfalseを返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+bool BoundsArray::Add( const BoundingSphere& value )
+{
+    if ( m_Count >= m_Capacity )
+    { return false; }
+
+    m_Count++;
+    SetAt( m_Count - 1, value );
+    return true;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>境界箱を設定します.</summary>
+///<param name="index">設定する要素番号.</param>
+///<param name="value">設定する境界箱.</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+void BoundsArray::SetAt( u32 index, const BoundingBox& value )
+{
+    assert( index < m_Count );
+
+    // BoundingFrustum::Contains() と同じ式で中心と面までの距離を求める.
+    Vector3 center  = ( value.max + value.min ) * 0.5f;
+    Vector3 extents = ( value.max - value.min ) * 0.5f;
+
+    m_pCenterX[ index ] = center.x;
+    m_pCenterY[ index ] = center.y;
+    m_pCenterZ[ index ] = center.z;
+    m_pExtentX[ index ] = extents.x;
+    m_pExtentY[ index ] = extents.y;
+    m_pExtentZ[ index ] = extents.z;
+    m_pRadius [ index ] = extents.Length();
+}
+
+///------------------------------------------------------------------------------------
+///<summary>境界球を設定します.</summary>
+///<param name="index">設定する要素番号.</param>
+///<param name="value">設定する境界球.</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+void BoundsArray::SetAt( u32 index, const BoundingSphere& value )
+{
+    assert( index < m_Count );
+
+    m_pCenterX[ index ] = value.center.x;
+    m_pCenterY[ index ] = value.center.y;
+    m_pCenterZ[ index ] = value.center.z;
+    m_pExtentX[ index ] = value.radius;
+    m_pExtentY[ index ] = value.radius;
+    m_pExtentZ[ index ] = value.radius;
+    m_pRadius [ index ] = value.radius;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>格納数を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 BoundsArray::GetCount() const
+{ return m_Count; }
+
+///------------------------------------------------------------------------------------
+///<summary>容量を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 BoundsArray::GetCapacity() const
+{ return m_Capacity; }
+
+///------------------------------------------------------------------------------------
+///<summary>中心のX成分の配列を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const f32* BoundsArray::GetCenterX() const
+{ return m_pCenterX; }
+
+///------------------------------------------------------------------------------------
+///<summary>中心のY成分の配列を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const f32* BoundsArray::GetCenterY() const
+{ return m_pCenterY; }
+
+///------------------------------------------------------------------------------------
+///<summary>中心のZ成分の配列を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const f32* BoundsArray::GetCenterZ() const
+{ return m_pCenterZ; }
+
+///------------------------------------------------------------------------------------
+///<summary>中心から面までのX方向の距離の配列を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const f32* BoundsArray::GetExtentX() const
+{ return m_pExtentX; }
+
+///------------------------------------------------------------------------------------
+///<summary>中心から面までのY方向の距離の配列を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const f32* BoundsArray::GetExtentY() const
+{ return m_pExtentY; }
+
+///------------------------------------------------------------------------------------
+///<summary>中心から面までのZ方向の距離の配列を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const f32* BoundsArray::GetExtentZ() const
+{ return m_pExtentZ; }
+
+///------------------------------------------------------------------------------------
+///<summary>外接球の半径の配列を取得します.</summary>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+const f32* BoundsArray::GetRadius() const
+{ return m_pRadius; }
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Functions
+///////////////////////////////////////////////////////////////////////////////////////
+
+///------------------------------------------------------------------------------------
+///<summary>視錐台カリングを行い，可視な要素番号を詰めて出力します.</summary>
+///<param name="frustum">視錐台.</param>
+///<param name="bounds">判定する境界ボリューム.</param>
+///<param name="begin">判定を開始する要素番号.</param>
+///<param name="end">判定を終了する要素番号.</param>
+///<param name="pIndices">可視な要素番号の出力先.</param>
+///<return>出力した要素番号の数を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 FrustumCull
+(
+    const BoundingFrustum&  frustum,
+    const BoundsArray&      bounds,
+    u32                     begin,
+    u32                     end,
+    u32*                    pIndices
+)
+{
+    assert( begin <= end && end <= bounds.GetCount() );
+    assert( pIndices != nullptr );
+
+    simd::CullingPlanes planes;
+    simd::SetCullingPlanes( frustum, planes );
+
+    u32 count = 0;
+
+    // 容量は NUM_BATCH の倍数なので，切り捨てた位置から読み込めば範囲外にならない.
+    for( u32 i = begin & ~( BoundsArray::NUM_BATCH - 1 ); i < end; i += BoundsArray::NUM_BATCH )
+    {
+        u32 mask = simd::CullBounds8( planes, bounds, i )
+                 | ( simd::CullBounds8( planes, bounds, i + 8 ) << 8 );
+
+        u32 lo = ( begin > i ) ? begin - i : 0;
+        u32 hi = ( end - i < BoundsArray::NUM_BATCH ) ? end - i : BoundsArray::NUM_BATCH;
+
+        // 分岐せずに書き込み，可視な場合だけ書き込み位置を進める.
+        // 範囲内の要素だけを走査するので，書き込み位置は end - begin を超えない.
+        for( u32 j=lo; j<hi; ++j )
+        {
+            pIndices[ count ] = i + j;
+            count += ( mask >> j ) & 0x1;
+        }
+    }
+
+    return count;
+}
+
+///------------------------------------------------------------------------------------
+///<summary>視錐台カリングを行い，可視な要素のビットを立てたマスクを出力します.</summary>
+///<param name="frustum">視錐台.</param>
+///<param name="bounds">判定する境界ボリューム.</param>
+///<param name="begin">判定を開始する要素番号.</param>
+///<param name="end">判定を終了する要素番号.</param>
+///<param name="pMask">マスクの出力先.</param>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+void FrustumCullMask
+(
+    const BoundingFrustum&  frustum,
+    const BoundsArray&      bounds,
+    u32                     begin,
+    u32                     end,
+    u8*                     pMask
+)
+{
+    assert( begin <= end && end <= bounds.GetCount() );
+    assert( ( begin & 0x7 ) == 0 );
+    assert( pMask != nullptr );
+
+    simd::CullingPlanes planes;
+    simd::SetCullingPlanes( frustum, planes );
+
+    for( u32 i=begin; i<end; i+=8 )
+    {
+        u32 mask = simd::CullBounds8( planes, bounds, i );
+
+        // 範囲外の要素のビットは落とす.
+        if ( end - i < 8 )
+        { mask &= ( 1u << ( end - i ) ) - 1; }
+
+        pMask[ i >> 3 ] = u8( mask );
+    }
+}
+
+///------------------------------------------------------------------------------------
+///<summary>全要素を複数のスレッドに分割して視錐台カリングを行います.</summary>
+///<param name="frustum">視錐台.</param>
+///<param name="bounds">判定する境界ボリューム.</param>
+///<param name="threadCount">使用するスレッド数.</param>
+///<param name="pIndices">可視な要素番号の出力先.</param>
+///<return>出力した要素番号の数を返却します.</return>
+///------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 FrustumCullParallel
+(
+    const BoundingFrustum&  frustum,
+    const BoundsArray&      bounds,
+    u32                     threadCount,
+    u32*                    pIndices
+)
+{
+    // スレッドの起動コストに見合う要素数を1スレッドに割り当てる.
+    const u32 NUM_MIN_ELEMENT_PER_THREAD = 16384;
+
+    u32 count = bounds.GetCount();
+    u32 limit = count / NUM_MIN_ELEMENT_PER_THREAD;
+    if ( threadCount > limit )
+    { threadCount = limit; }
+
+    if ( threadCount <= 1 )
+    { return FrustumCull( frustum, bounds, 0, count, pIndices ); }
+
+    // 各範囲の結果は範囲の先頭位置から書き込むので，スレッド間で出力先が重ならない.
+    u32 chunk = ( count + threadCount - 1 ) / threadCount;
+    chunk = ( chunk + BoundsArray::NUM_BATCH - 1 ) & ~( BoundsArray::NUM_BATCH - 1 );
+
+    std::vector<u32>         visible( threadCount, 0 );
+    std::vector<std::thread> threads;
+    threads.reserve( threadCount - 1 );
+
+    for( u32 i=1; i<threadCount; ++i )
+    {
+        u32 begin = chunk * i;
+        if ( begin >= count )
+        { break; }
+
+        u32 end = ( begin + chunk < count ) ? begin + chunk : count;
+        u32* pResult = &visible[ i ];
+
+        threads.push_back( std::thread( [ &frustum, &bounds, begin, end, pIndices, pResult ]()
+        {
+            *pResult = FrustumCull( frustum, bounds, begin, end, pIndices + begin );
+        } ) );
+    }
+
+    // 先頭の範囲は呼び出したスレッドで処理する.
+    visible[ 0 ] = FrustumCull( frustum, bounds, 0, ( chunk < count ) ? chunk : count, pIndices );
+
+    for( size_t i=0; i<threads.size(); ++i )
+    { threads[ i ].join(); }
+
+    // 範囲の順に詰めるので，要素番号は昇順のままになる.
+    u32 result = visible[ 0 ];
+    for( u32 i=1; i<threadCount; ++i )
+    {
+        if ( visible[ i ] == 0 )
+        { continue; }
+
+        memmove( pIndices + result, pIndices + chunk * i, sizeof(u32) * visible[ i ] );
+        result += visible[ i ];
+    }
+
+    return result;
+}
+
+} // namespace asdx
+
+#endif//__ASDX_CULLING_INL__
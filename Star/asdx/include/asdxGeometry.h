@@ -48,9 +48,9 @@ enum PlaneIntersectionType
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-// Vector3x8 class
+// Float8 class
 ////////////////////////////////////////////////////////////////////////////////
-class Vector3x8
+class ASDX_ALIGN( 32 ) Float8
 {
     //==========================================================================
     // list of friend classes and methods.
@@ -72,8 +72,7 @@ protected:
     //==========================================================================
     // protected variables
     //==========================================================================
-    static const u32 NUM_COUNT = 8; //!< 配列の要素数(=8)です.
-    Vector3 points[ NUM_COUNT ];        //!< 8要素の3次元ベクトルの配列です.
+    /* NOTHING */
 
     //==========================================================================
     // protected methods.
@@ -84,12 +83,251 @@ public:
     //==========================================================================
     // public variables
     //==========================================================================
+    static const u32 NUM_COUNT = 8;     //!< 要素数(=8)です.
+    f32 v[ NUM_COUNT ];                 //!< 8要素の値です.
+
+    //==========================================================================
+    // public methods
+    //==========================================================================
+
+    //--------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //--------------------------------------------------------------------------
+    Float8();
+
+    //--------------------------------------------------------------------------
+    //! @brief      引数付きコンストラクタです.
+    //!
+    //! @param [in]     value       全要素に設定する値.
+    //--------------------------------------------------------------------------
+    Float8( const f32 value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      引数付きコンストラクタです.
+    //!
+    //! @param [in]     pValues     要素数8の配列です.
+    //--------------------------------------------------------------------------
+    Float8( const f32* pValues );
+
+    //--------------------------------------------------------------------------
+    //! @brief      コピーコンストラクタです.
+    //!
+    //! @param [in]     value       コピー元の値.
+    //--------------------------------------------------------------------------
+    Float8( const Float8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      インデクサです.
+    //!
+    //! @param [in]     index       取得する要素番号.
+    //! @return     指定された要素番号の値を返却します.
+    //--------------------------------------------------------------------------
+    f32&        operator [] ( u32 index );
+
+    //--------------------------------------------------------------------------
+    //! @brief      インデクサです(const版).
+    //!
+    //! @param [in]     index       取得する要素番号.
+    //! @return     指定された要素番号の値を返却します.
+    //--------------------------------------------------------------------------
+    f32         operator [] ( u32 index ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに加算します.
+    //--------------------------------------------------------------------------
+    Float8&     operator += ( const Float8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに減算します.
+    //--------------------------------------------------------------------------
+    Float8&     operator -= ( const Float8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに乗算します.
+    //--------------------------------------------------------------------------
+    Float8&     operator *= ( const Float8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに除算します.
+    //--------------------------------------------------------------------------
+    Float8&     operator /= ( const Float8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      正符号演算子です.
+    //--------------------------------------------------------------------------
+    Float8      operator +  () const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      負符号演算子です.
+    //--------------------------------------------------------------------------
+    Float8      operator -  () const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとの加算結果を返却します.
+    //--------------------------------------------------------------------------
+    Float8      operator +  ( const Float8& value ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとの減算結果を返却します.
+    //--------------------------------------------------------------------------
+    Float8      operator -  ( const Float8& value ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとの乗算結果を返却します.
+    //--------------------------------------------------------------------------
+    Float8      operator *  ( const Float8& value ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとの除算結果を返却します.
+    //--------------------------------------------------------------------------
+    Float8      operator /  ( const Float8& value ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      代入演算子です.
+    //!
+    //! @param [in]     value       代入する値.
+    //! @return     代入結果を返却します.
+    //--------------------------------------------------------------------------
+    Float8&     operator =  ( const Float8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      等価比較演算子です.
+    //!
+    //! @param [in]     value       比較する値.
+    //! @retval true    全要素が等価です.
+    //! @retval false   非等価です.
+    //--------------------------------------------------------------------------
+    bool        operator == ( const Float8& value ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      非等価比較演算子です.
+    //!
+    //! @param [in]     value       比較する値.
+    //! @retval true    非等価です.
+    //! @retval false   全要素が等価です.
+    //--------------------------------------------------------------------------
+    bool        operator != ( const Float8& value ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      全要素の最小値を求めます.
+    //--------------------------------------------------------------------------
+    f32         ReduceMin() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      全要素の最大値を求めます.
+    //--------------------------------------------------------------------------
+    f32         ReduceMax() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      全要素の合計を求めます.
+    //--------------------------------------------------------------------------
+    f32         ReduceSum() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに小さい方の値を求めます.
+    //--------------------------------------------------------------------------
+    static Float8   Min( const Float8& a, const Float8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに大きい方の値を求めます.
+    //--------------------------------------------------------------------------
+    static Float8   Max( const Float8& a, const Float8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに絶対値を求めます.
+    //--------------------------------------------------------------------------
+    static Float8   Abs( const Float8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに平方根を求めます.
+    //--------------------------------------------------------------------------
+    static Float8   Sqrt( const Float8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに a < b を判定します.
+    //!
+    //! @return     成り立つ要素のビットを立てたマスク(ビットiが要素i)を返却します.
+    //--------------------------------------------------------------------------
+    static u32      Less( const Float8& a, const Float8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに a <= b を判定します.
+    //!
+    //! @return     成り立つ要素のビットを立てたマスクを返却します.
+    //--------------------------------------------------------------------------
+    static u32      LessEqual( const Float8& a, const Float8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに a > b を判定します.
+    //!
+    //! @return     成り立つ要素のビットを立てたマスクを返却します.
+    //--------------------------------------------------------------------------
+    static u32      Greater( const Float8& a, const Float8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに a >= b を判定します.
+    //!
+    //! @return     成り立つ要素のビットを立てたマスクを返却します.
+    //--------------------------------------------------------------------------
+    static u32      GreaterEqual( const Float8& a, const Float8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに値を選択します.
+    //!
+    //! @param [in]     a           マスクのビットが立っていない要素に使う値.
+    //! @param [in]     b           マスクのビットが立っている要素に使う値.
+    //! @param [in]     mask        選択マスク(ビットiが要素i)です.
+    //! @return     選択した結果を返却します.
+    //--------------------------------------------------------------------------
+    static Float8   Select( const Float8& a, const Float8& b, u32 mask );
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Vector3x8 class
+////////////////////////////////////////////////////////////////////////////////
+class ASDX_ALIGN( 32 ) Vector3x8
+{
+    //==========================================================================
+    // list of friend classes and methods.
+    //==========================================================================
+    /* NOTHING */
+
+private:
+    //==========================================================================
+    // private variables
+    //==========================================================================
+    /* NOTHING */
+
+    //==========================================================================
+    // private methods
+    //==========================================================================
     /* NOTHING */
 
+protected:
+    //==========================================================================
+    // protected variables
+    //==========================================================================
+    /* NOTHING */
+
+    //==========================================================================
+    // protected methods.
+    //==========================================================================
+    /* NOTHING */
+
+public:
+    //==========================================================================
+    // public variables
+    //==========================================================================
+    static const u32 NUM_COUNT = 8;     //!< 要素数(=8)です.
+    Float8 x;                           //!< 8要素のX成分です.
+    Float8 y;                           //!< 8要素のY成分です.
+    Float8 z;                           //!< 8要素のZ成分です.
+
     //==========================================================================
     // public methods
     //==========================================================================
-    
+
     //--------------------------------------------------------------------------
     //! @brief      コンストラクタです.
     //--------------------------------------------------------------------------
@@ -123,33 +361,30 @@ public:
     //!
     //! @param [in]     pValues     要素数8の3次元ベクトル配列です.
     //--------------------------------------------------------------------------
-    Vector3x8( Vector3* pValues );
+    Vector3x8( const Vector3* pValues );
 
     //--------------------------------------------------------------------------
-    //! @brief      コピーコンストラクタです.
+    //! @brief      引数付きコンストラクタです.
     //!
-    //! @param [in]     value       コピー元の値.
-    //--------------------------------------------------------------------------
-    Vector3x8( const Vector3x8& value );
-
+    //! @param [in]     value       全要素に設定する3次元ベクトル.
     //--------------------------------------------------------------------------
-    //! @brief      デストラクタです.
-    //--------------------------------------------------------------------------
-    virtual ~Vector3x8();
+    Vector3x8( const Vector3& value );
 
     //--------------------------------------------------------------------------
-    //! @brief      Vector3*型へのキャストです.
+    //! @brief      引数付きコンストラクタです.
     //!
-    //! @return     最初の要素へのポインタを返却します.
+    //! @param [in]     nx          X成分.
+    //! @param [in]     ny          Y成分.
+    //! @param [in]     nz          Z成分.
     //--------------------------------------------------------------------------
-    operator        Vector3* ();
+    Vector3x8( const Float8& nx, const Float8& ny, const Float8& nz );
 
     //--------------------------------------------------------------------------
-    //! @brief      const Vector3*型へのキャストです.
+    //! @brief      コピーコンストラクタです.
     //!
-    //! @return     最初の要素へのポインタを返却します.
+    //! @param [in]     value       コピー元の値.
     //--------------------------------------------------------------------------
-    operator const  Vector3* () const;
+    Vector3x8( const Vector3x8& value );
 
     //--------------------------------------------------------------------------
     //! @brief      インデクサです.
@@ -157,15 +392,7 @@ public:
     //! @param [in]     index       取得する要素番号.
     //! @return     指定された要素番号の3次元ベクトルを返却します.
     //--------------------------------------------------------------------------
-    Vector3&        operator [] ( u32 index );
-
-    //--------------------------------------------------------------------------
-    //! @brief      インデクサです(const版).
-    //! 
-    //! @param [in]     index       取得する要素番号.
-    //! @return     指定された要素番号の3次元ベクトルを返却します.
-    //--------------------------------------------------------------------------
-    const Vector3&  operator [] ( u32 index ) const;
+    Vector3     operator [] ( u32 index ) const;
 
     //--------------------------------------------------------------------------
     //! @brief      サイズを取得します.
@@ -180,7 +407,7 @@ public:
     //! @param [in]     index       取得する要素番号.
     //! @return     指定された要素番号の3次元ベクトルを返却します.
     //--------------------------------------------------------------------------
-    Vector3&    GetAt   ( u32 index );
+    Vector3     GetAt   ( u32 index ) const;
 
     //--------------------------------------------------------------------------
     //! @brief      指定された要素番号の3次元ベクトルに値を設定します.
@@ -190,6 +417,85 @@ public:
     //--------------------------------------------------------------------------
     void        SetAt   ( u32 index, const Vector3& value );
 
+    //--------------------------------------------------------------------------
+    //! @brief      3次元ベクトルの配列から読み込みます.
+    //!
+    //! @param [in]     pValues     読み込む配列の先頭です.
+    //! @param [in]     stride      要素の間隔(バイト)です. 頂点構造体のメンバーも指定できます.
+    //! @param [in]     count       読み込む要素数です. 8 以下を指定します.
+    //! @note       count 以降の要素はゼロになります.
+    //--------------------------------------------------------------------------
+    void        Gather  ( const Vector3* pValues, u32 stride, u32 count );
+
+    //--------------------------------------------------------------------------
+    //! @brief      3次元ベクトルの配列へ書き込みます.
+    //!
+    //! @param [out]    pValues     書き込む配列の先頭です.
+    //! @param [in]     stride      要素の間隔(バイト)です. 要素の間のデータは書き換えません.
+    //! @param [in]     count       書き込む要素数です. 8 以下を指定します.
+    //--------------------------------------------------------------------------
+    void        Scatter ( Vector3* pValues, u32 stride, u32 count ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      全要素の成分ごとの最小値を求めます.
+    //--------------------------------------------------------------------------
+    Vector3     ReduceMin() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      全要素の成分ごとの最大値を求めます.
+    //--------------------------------------------------------------------------
+    Vector3     ReduceMax() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに加算します.
+    //--------------------------------------------------------------------------
+    Vector3x8&  operator += ( const Vector3x8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに減算します.
+    //--------------------------------------------------------------------------
+    Vector3x8&  operator -= ( const Vector3x8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとにスカラー乗算します.
+    //--------------------------------------------------------------------------
+    Vector3x8&  operator *= ( const Float8& scalar );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとにスカラー除算します.
+    //--------------------------------------------------------------------------
+    Vector3x8&  operator /= ( const Float8& scalar );
+
+    //--------------------------------------------------------------------------
+    //! @brief      正符号演算子です.
+    //--------------------------------------------------------------------------
+    Vector3x8   operator +  () const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      負符号演算子です.
+    //--------------------------------------------------------------------------
+    Vector3x8   operator -  () const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとの加算結果を返却します.
+    //--------------------------------------------------------------------------
+    Vector3x8   operator +  ( const Vector3x8& value ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとの減算結果を返却します.
+    //--------------------------------------------------------------------------
+    Vector3x8   operator -  ( const Vector3x8& value ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとのスカラー乗算結果を返却します.
+    //--------------------------------------------------------------------------
+    Vector3x8   operator *  ( const Float8& scalar ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとのスカラー除算結果を返却します.
+    //--------------------------------------------------------------------------
+    Vector3x8   operator /  ( const Float8& scalar ) const;
+
     //--------------------------------------------------------------------------
     //! @breif      代入演算子です.
     //!
@@ -215,14 +521,60 @@ public:
     //! @retval false   等価です.
     //--------------------------------------------------------------------------
     bool       operator != ( const Vector3x8& value ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに内積を求めます.
+    //--------------------------------------------------------------------------
+    static Float8       Dot( const Vector3x8& a, const Vector3x8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに外積を求めます.
+    //--------------------------------------------------------------------------
+    static Vector3x8    Cross( const Vector3x8& a, const Vector3x8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに長さを求めます.
+    //--------------------------------------------------------------------------
+    static Float8       Length( const Vector3x8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに長さの2乗を求めます.
+    //--------------------------------------------------------------------------
+    static Float8       LengthSq( const Vector3x8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに正規化します.
+    //!
+    //! @note       長さがゼロの要素の結果は不定です.
+    //--------------------------------------------------------------------------
+    static Vector3x8    Normalize( const Vector3x8& value );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに成分の小さい方の値を求めます.
+    //--------------------------------------------------------------------------
+    static Vector3x8    Min( const Vector3x8& a, const Vector3x8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに成分の大きい方の値を求めます.
+    //--------------------------------------------------------------------------
+    static Vector3x8    Max( const Vector3x8& a, const Vector3x8& b );
+
+    //--------------------------------------------------------------------------
+    //! @brief      要素ごとに値を選択します.
+    //!
+    //! @param [in]     a           マスクのビットが立っていない要素に使う値.
+    //! @param [in]     b           マスクのビットが立っている要素に使う値.
+    //! @param [in]     mask        選択マスク(ビットiが要素i)です.
+    //! @return     選択した結果を返却します.
+    //--------------------------------------------------------------------------
+    static Vector3x8    Select( const Vector3x8& a, const Vector3x8& b, u32 mask );
 };
 
 
 ////////////////////////////////////////////////////////////////////////////////
 // Plane class
 ////////////////////////////////////////////////////////////////////////////////
-ASDX_ALIGN( 16 )
-class Plane
+class ASDX_ALIGN( 16 ) Plane
 {
     //==========================================================================
     // list of friend classes and methods.
@@ -409,6 +761,7 @@ public:
     //! @brief      正規化を行います.
     //!
     //! @return     正規化した結果を返却します.
+    //! @note       法線ベクトルの長さが1になるように，法線ベクトルと原点からの距離を割ります.
     //--------------------------------------------------------------------------
     Plane&  Normalize       ();
 
@@ -713,6 +1066,17 @@ public:
     //! @retval false   交差はありません.
     //---------------------------------------------------------------------------
     bool  Intersects( const Vector3& p0, const Vector3& p1, const Vector3& p2, f32& distance ) const;
+
+    //---------------------------------------------------------------------------
+    //! @brief      8個の境界箱との交差判定をまとめて行います.
+    //!
+    //! @param [in]     mins        8個の境界箱の最小値.
+    //! @param [in]     maxs        8個の境界箱の最大値.
+    //! @param [out]    distance    境界箱ごとの交差点までの距離. 交差していない要素はゼロです.
+    //! @return     交差している境界箱のビット(ビットiが要素i)を立てたマスクを返却します.
+    //! @note       要素ごとの結果は Intersects( const BoundingBox&, f32& ) と一致します.
+    //---------------------------------------------------------------------------
+    u32   Intersects( const Vector3x8& mins, const Vector3x8& maxs, Float8& distance ) const;
 };
 
 
@@ -952,6 +1316,7 @@ public:
     //! @param [in]     pPoints         点群データの配列.
     //! @param [in]     offset          配列の先頭からのオフセット.
     //! @param [out]    result          生成した境界箱.
+    //! @note       8点ずつ Vector3x8 に読み込んで，成分ごとの最小値・最大値をまとめて求めます.
     //--------------------------------------------------------------------------
     static void             CreateFromPoints( const u32 numPoints, const Vector3* pPoints, const u32 offset, BoundingBox& result );
 };
@@ -1404,6 +1769,34 @@ public:
     //! @param [out]    result      境界錘台を構成する8角の点.
     //--------------------------------------------------------------------------
     void                    GetCorners( Vector3x8& result )        const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      8個の点との交差判定をまとめて行います.
+    //!
+    //! @param [in]     points      判定する8個の点.
+    //! @return     境界錐台に含まれる点のビット(ビットiが要素i)を立てたマスクを返却します.
+    //--------------------------------------------------------------------------
+    u32                     Intersects( const Vector3x8& points ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      8個の境界球との交差判定をまとめて行います.
+    //!
+    //! @param [in]     centers     8個の境界球の中心.
+    //! @param [in]     radius      8個の境界球の半径.
+    //! @return     交差している境界球のビットを立てたマスクを返却します.
+    //! @note       要素ごとの結果は Intersects( const BoundingSphere& ) と一致します.
+    //--------------------------------------------------------------------------
+    u32                     Intersects( const Vector3x8& centers, const Float8& radius ) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      8個の境界箱との交差判定をまとめて行います.
+    //!
+    //! @param [in]     centers     8個の境界箱の中心.
+    //! @param [in]     extents     8個の境界箱の中心から面までの距離.
+    //! @return     交差している境界箱のビットを立てたマスクを返却します.
+    //! @note       要素ごとの結果は Intersects( const BoundingBox& ) と一致します.
+    //--------------------------------------------------------------------------
+    u32                     Intersects( const Vector3x8& centers, const Vector3x8& extents ) const;
 };
 
 
@@ -9,6 +9,319 @@
 
 namespace asdx {
 
+#if ASDX_USE_SIMD
+///////////////////////////////////////////////////////////////////////////////////////
+// SIMD Functions
+///////////////////////////////////////////////////////////////////////////////////////
+namespace simd {
+
+#if defined(ASDX_USE_SSE) && ASDX_USE_SSE
+typedef __m128          f32x4;
+
+ASDX_INLINE f32x4 Load( const f32* p )                  { return _mm_loadu_ps( p ); }
+ASDX_INLINE void  Store( f32* p, f32x4 v )              { _mm_storeu_ps( p, v ); }
+ASDX_INLINE f32x4 Splat( f32 s )                        { return _mm_set1_ps( s ); }
+ASDX_INLINE f32x4 Set( f32 x, f32 y, f32 z, f32 w )     { return _mm_setr_ps( x, y, z, w ); }
+ASDX_INLINE f32x4 Add( f32x4 a, f32x4 b )               { return _mm_add_ps( a, b ); }
+ASDX_INLINE f32x4 Sub( f32x4 a, f32x4 b )               { return _mm_sub_ps( a, b ); }
+ASDX_INLINE f32x4 Mul( f32x4 a, f32x4 b )               { return _mm_mul_ps( a, b ); }
+ASDX_INLINE f32x4 SwapPair( f32x4 v )                   { return _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) ); }
+ASDX_INLINE f32x4 SwapHalf( f32x4 v )                   { return _mm_shuffle_ps( v, v, _MM_SHUFFLE( 1, 0, 3, 2 ) ); }
+ASDX_INLINE f32   GetX( f32x4 v )                       { return _mm_cvtss_f32( v ); }
+#else
+typedef float32x4_t     f32x4;
+
+ASDX_INLINE f32x4 Load( const f32* p )                  { return vld1q_f32( p ); }
+ASDX_INLINE void  Store( f32* p, f32x4 v )              { vst1q_f32( p, v ); }
+ASDX_INLINE f32x4 Splat( f32 s )                        { return vdupq_n_f32( s ); }
+ASDX_INLINE f32x4 Set( f32 x, f32 y, f32 z, f32 w )     { f32 v[4] = { x, y, z, w }; return vld1q_f32( v ); }
+ASDX_INLINE f32x4 Add( f32x4 a, f32x4 b )               { return vaddq_f32( a, b ); }
+ASDX_INLINE f32x4 Sub( f32x4 a, f32x4 b )               { return vsubq_f32( a, b ); }
+ASDX_INLINE f32x4 Mul( f32x4 a, f32x4 b )               { return vmulq_f32( a, b ); }
+ASDX_INLINE f32x4 SwapPair( f32x4 v )                   { return vrev64q_f32( v ); }
+ASDX_INLINE f32x4 SwapHalf( f32x4 v )                   { return vextq_f32( v, v, 2 ); }
+ASDX_INLINE f32   GetX( f32x4 v )                       { return vgetq_lane_f32( v, 0 ); }
+#endif
+
+//-------------------------------------------------------------------------------------
+//      ( x * 1行目 + y * 2行目 ) + z * 3行目 を求めます.
+//      スカラー実装と同じ順序で加算するので，積和が FMA に縮約されなければ結果は一致します.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+f32x4 CombineRows( f32 x, f32 y, f32 z, const Matrix& matrix )
+{
+    f32x4 result = Mul( Splat( x ), Load( matrix.m[0] ) );
+    result = Add( result, Mul( Splat( y ), Load( matrix.m[1] ) ) );
+    return   Add( result, Mul( Splat( z ), Load( matrix.m[2] ) ) );
+}
+
+//-------------------------------------------------------------------------------------
+//      4要素のベクトルに行列を掛けます.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+f32x4 TransformRow( const f32* pRow, const Matrix& matrix )
+{ return Add( CombineRows( pRow[0], pRow[1], pRow[2], matrix ), Mul( Splat( pRow[3] ), Load( matrix.m[3] ) ) ); }
+
+//-------------------------------------------------------------------------------------
+//      行列を乗算します. 全ての行を求めてから書き込むので，result は a, b と同じでも構いません.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+void MultiplyMatrix( const Matrix& a, const Matrix& b, Matrix& result )
+{
+    f32x4 r0 = TransformRow( a.m[0], b );
+    f32x4 r1 = TransformRow( a.m[1], b );
+    f32x4 r2 = TransformRow( a.m[2], b );
+    f32x4 r3 = TransformRow( a.m[3], b );
+
+    Store( result.m[0], r0 );
+    Store( result.m[1], r1 );
+    Store( result.m[2], r2 );
+    Store( result.m[3], r3 );
+}
+
+//-------------------------------------------------------------------------------------
+//      逆行列を求めます.
+//
+//      Intel の "Streaming SIMD Extensions - Inverse of 4x4 Matrix" と同じ手順で，
+//      2x2 の小行列式を4要素ずつ求めて余因子を組み立てます.
+//      row1, row3 は上下半分を入れ替えた列として読み込みます.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+void InvertMatrix( const Matrix& value, Matrix& result )
+{
+    f32x4 row0 = Set( value._11, value._21, value._31, value._41 );
+    f32x4 row1 = Set( value._32, value._42, value._12, value._22 );
+    f32x4 row2 = Set( value._13, value._23, value._33, value._43 );
+    f32x4 row3 = Set( value._34, value._44, value._14, value._24 );
+    f32x4 minor0, minor1, minor2, minor3, tmp;
+
+    tmp    = SwapPair( Mul( row2, row3 ) );
+    minor0 = Mul( row1, tmp );
+    minor1 = Mul( row0, tmp );
+    tmp    = SwapHalf( tmp );
+    minor0 = Sub( Mul( row1, tmp ), minor0 );
+    minor1 = SwapHalf( Sub( Mul( row0, tmp ), minor1 ) );
+
+    tmp    = SwapPair( Mul( row1, row2 ) );
+    minor0 = Add( Mul( row3, tmp ), minor0 );
+    minor3 = Mul( row0, tmp );
+    tmp    = SwapHalf( tmp );
+    minor0 = Sub( minor0, Mul( row3, tmp ) );
+    minor3 = SwapHalf( Sub( Mul( row0, tmp ), minor3 ) );
+
+    tmp    = SwapPair( Mul( SwapHalf( row1 ), row3 ) );
+    row2   = SwapHalf( row2 );
+    minor0 = Add( Mul( row2, tmp ), minor0 );
+    minor2 = Mul( row0, tmp );
+    tmp    = SwapHalf( tmp );
+    minor0 = Sub( minor0, Mul( row2, tmp ) );
+    minor2 = SwapHalf( Sub( Mul( row0, tmp ), minor2 ) );
+
+    tmp    = SwapPair( Mul( row0, row1 ) );
+    minor2 = Add( Mul( row3, tmp ), minor2 );
+    minor3 = Sub( Mul( row2, tmp ), minor3 );
+    tmp    = SwapHalf( tmp );
+    minor2 = Sub( Mul( row3, tmp ), minor2 );
+    minor3 = Sub( minor3, Mul( row2, tmp ) );
+
+    tmp    = SwapPair( Mul( row0, row3 ) );
+    minor1 = Sub( minor1, Mul( row2, tmp ) );
+    minor2 = Add( Mul( row1, tmp ), minor2 );
+    tmp    = SwapHalf( tmp );
+    minor1 = Add( Mul( row2, tmp ), minor1 );
+    minor2 = Sub( minor2, Mul( row1, tmp ) );
+
+    tmp    = SwapPair( Mul( row0, row2 ) );
+    minor1 = Add( Mul( row3, tmp ), minor1 );
+    minor3 = Sub( minor3, Mul( row1, tmp ) );
+    tmp    = SwapHalf( tmp );
+    minor1 = Sub( minor1, Mul( row3, tmp ) );
+    minor3 = Add( Mul( row1, tmp ), minor3 );
+
+    // 行列式.
+    f32x4 det = Mul( row0, minor0 );
+    det = Add( SwapHalf( det ), det );
+    det = Add( SwapPair( det ), det );
+
+    f32 d = GetX( det );
+    assert( d != 0.0f );
+
+    f32x4 invDet = Splat( 1.0f / d );
+    Store( result.m[0], Mul( minor0, invDet ) );
+    Store( result.m[1], Mul( minor1, invDet ) );
+    Store( result.m[2], Mul( minor2, invDet ) );
+    Store( result.m[3], Mul( minor3, invDet ) );
+}
+
+//-------------------------------------------------------------------------------------
+//      四元数を乗算します.
+//
+//      a.w * b + a.x * (bw, -bz, by, -bx) + a.y * (bz, bw, -bx, -by) + a.z * (-by, bx, bw, -bz)
+//      として，並べ替えと符号の反転だけで求めます.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+void MultiplyQuaternion( const Quaternion& a, const Quaternion& b, Quaternion& result )
+{
+    f32x4 q  = Load( &b.x );
+    f32x4 zw = SwapHalf( q );
+
+    f32x4 r = Mul( Splat( a.w ), q );
+    r = Add( r, Mul( Splat( a.x ), Mul( SwapPair( zw ), Set( 1.0f, -1.0f,  1.0f, -1.0f ) ) ) );
+    r = Add( r, Mul( Splat( a.y ), Mul( zw,             Set( 1.0f,  1.0f, -1.0f, -1.0f ) ) ) );
+    r = Add( r, Mul( Splat( a.z ), Mul( SwapPair( q ),  Set(-1.0f,  1.0f,  1.0f, -1.0f ) ) ) );
+
+    Store( &result.x, r );
+}
+
+#if defined(ASDX_USE_AVX2) && ASDX_USE_AVX2
+//-------------------------------------------------------------------------------------
+//      N要素のベクトルを書き込みます. 要素の後ろは書き換えません.
+//-------------------------------------------------------------------------------------
+template< u32 N >
+ASDX_INLINE
+void StoreN( u8* p, f32x4 v )
+{
+    f32* pf = reinterpret_cast<f32*>( p );
+    if ( N == 4 )
+    {
+        _mm_storeu_ps( pf, v );
+        return;
+    }
+
+    _mm_store_sd( reinterpret_cast<double*>( pf ), _mm_castps_pd( v ) );
+    if ( N == 3 )
+    { _mm_store_ss( pf + 2, _mm_movehl_ps( v, v ) ); }
+}
+
+//-------------------------------------------------------------------------------------
+//      2つのベクトルを256bitレジスタの下位と上位に読み込みます.
+//
+//      16byte ずつ読み込むので，N < 4 の場合は次の要素の先頭まで読み込みます.
+//      読み込んだ余分な成分は変換に使いません.
+//-------------------------------------------------------------------------------------
+ASDX_INLINE
+__m256 LoadPair( const u8* p0, const u8* p1 )
+{
+    __m256 v = _mm256_castps128_ps256( _mm_loadu_ps( reinterpret_cast<const f32*>( p0 ) ) );
+    return _mm256_insertf128_ps( v, _mm_loadu_ps( reinterpret_cast<const f32*>( p1 ) ), 1 );
+}
+
+//-------------------------------------------------------------------------------------
+//      256bitレジスタの上下に読み込んだ2つのベクトルを変換します.
+//
+//      成分は128bitレーン内の並べ替えで上下それぞれに複製するので，レーンをまたぐ命令を使いません.
+//      加算の順序はスカラー実装と同じなので，積和が FMA に縮約されなければ結果は一致します.
+//-------------------------------------------------------------------------------------
+template< u32 N, bool Point, bool Project >
+ASDX_INLINE
+__m256 TransformPair( __m256 v, const __m256* pRows )
+{
+    __m256 result = _mm256_mul_ps( _mm256_permute_ps( v, 0x00 ), pRows[0] );
+    result = _mm256_add_ps( result, _mm256_mul_ps( _mm256_permute_ps( v, 0x55 ), pRows[1] ) );
+
+    if ( N >= 3 )
+    { result = _mm256_add_ps( result, _mm256_mul_ps( _mm256_permute_ps( v, 0xaa ), pRows[2] ) ); }
+
+    if ( N == 4 )
+    { result = _mm256_add_ps( result, _mm256_mul_ps( _mm256_permute_ps( v, 0xff ), pRows[3] ) ); }
+    else if ( Point )
+    { result = _mm256_add_ps( result, pRows[3] ); }
+
+    if ( Project )
+    { result = _mm256_div_ps( result, _mm256_permute_ps( result, 0xff ) ); }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------
+//      ベクトルの配列を4要素ずつ変換します.
+//
+//      4要素を全て変換してから書き込むので，入力と出力が同じ配列でも構いません.
+//      処理した要素数を返却します. 残りは呼び出し側で1要素ずつ処理します.
+//-------------------------------------------------------------------------------------
+template< u32 N, bool Point, bool Project >
+ASDX_INLINE
+u32 TransformStream( const u8* pSrc, u32 srcStride, u8* pDst, u32 dstStride, u32 count, const Matrix& matrix )
+{
+    // N < 4 は次の要素の先頭まで読み込むので，要素が重なる間隔と末尾の要素は扱わない.
+    if ( N < 4 && ( srcStride < sizeof(f32) * N || count == 0 ) )
+    { return 0; }
+
+    const u32 limit = ( N == 4 ) ? count : count - 1;
+
+    __m256 rows[4];
+    rows[0] = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( matrix.m[0] ) );
+    rows[1] = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( matrix.m[1] ) );
+    rows[2] = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( matrix.m[2] ) );
+    rows[3] = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( matrix.m[3] ) );
+
+    const size_t srcStep = size_t( srcStride );
+    const size_t dstStep = size_t( dstStride );
+
+    u32 i = 0;
+    for( ; i + 4 <= limit; i += 4 )
+    {
+        const u8* pIn = pSrc + srcStep * i;
+        u8*      pOut = pDst + dstStep * i;
+
+        __m256 r01 = TransformPair< N, Point, Project >( LoadPair( pIn,               pIn + srcStep     ), rows );
+        __m256 r23 = TransformPair< N, Point, Project >( LoadPair( pIn + srcStep * 2, pIn + srcStep * 3 ), rows );
+
+        StoreN<N>( pOut,               _mm256_castps256_ps128( r01 ) );
+        StoreN<N>( pOut + dstStep,     _mm256_extractf128_ps( r01, 1 ) );
+        StoreN<N>( pOut + dstStep * 2, _mm256_castps256_ps128( r23 ) );
+        StoreN<N>( pOut + dstStep * 3, _mm256_extractf128_ps( r23, 1 ) );
+    }
+
+    return i;
+}
+#endif//ASDX_USE_AVX2
+
+} // namespace simd
+#endif//ASDX_USE_SIMD
+
+namespace simd {
+
+//-------------------------------------------------------------------------------------
+//      ベクトルの配列を一括変換します. Vector2/3/4 の *Stream() から呼び出します.
+//
+//      AVX2 が使える場合は TransformStream() で4要素ずつ変換し，残りを func で1要素ずつ変換します.
+//      1要素ずつ変換する場合も入力を複製してから書き込むので，
+//      入力と出力に同じ配列と間隔を指定すればその場で変換できます.
+//-------------------------------------------------------------------------------------
+template< typename T, u32 N, bool Point, bool Project >
+ASDX_INLINE
+void TransformArray
+(
+    const T*        pInput,
+    u32             inputStride,
+    T*              pOutput,
+    u32             outputStride,
+    u32             count,
+    const Matrix&   matrix,
+    void         (* func)( const T&, const Matrix&, T& )
+)
+{
+    assert( pInput  != 0 || count == 0 );
+    assert( pOutput != 0 || count == 0 );
+
+    const u8* pSrc = reinterpret_cast<const u8*>( pInput );
+    u8*       pDst = reinterpret_cast<u8*>( pOutput );
+    u32 i = 0;
+
+#if defined(ASDX_USE_AVX2) && ASDX_USE_AVX2
+    i = TransformStream< N, Point, Project >( pSrc, inputStride, pDst, outputStride, count, matrix );
+#endif//ASDX_USE_AVX2
+
+    for( ; i < count; ++i )
+    {
+        T value = *reinterpret_cast<const T*>( pSrc + size_t( inputStride ) * i );
+        func( value, matrix, *reinterpret_cast<T*>( pDst + size_t( outputStride ) * i ) );
+    }
+}
+
+} // namespace simd
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // Functions
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -44,7 +357,8 @@ bool IsNan( f32 value )
 ASDX_INLINE
 bool IsInf( f32 value )
 {
-    u32 f = *reinterpret_cast< u32* >( &value );
+    u32 f;
+    memcpy( &f, &value, sizeof(f) );
     if ( ( ( f & 0x7e000000 ) == 0x7e000000 ) && ( value == value ) )
     { return true; }
     return false;
@@ -107,7 +421,8 @@ f16 F32ToF16( f32 value )
     f16 result;
 
     // ビット列を崩さないままu32型に変換.
-    u32 bit = *reinterpret_cast<u32*>( &value );
+    u32 bit;
+    memcpy( &bit, &value, sizeof(bit) );
 
     // f32表現の符号bitを取り出し.
     u32 sign   = ( bit & 0x80000000U) >> 16U;
@@ -179,7 +494,53 @@ f32 F16ToF32( f16 value )
              ( ( exponent + 112 ) << 23) | // 指数部.
              ( mantissa << 13 );           // 仮数部.
 
-    return *reinterpret_cast<f32*>( &result );
+    f32 f;
+    memcpy( &f, &result, sizeof(f) );
+    return f;
+}
+
+ASDX_INLINE
+void F32ToF16Array( const f32* pSrc, f16* pDst, u32 count )
+{
+    assert( pSrc != 0 );
+    assert( pDst != 0 );
+
+    u32 i = 0;
+
+#if defined(ASDX_USE_F16C) && ASDX_USE_F16C
+    // 8要素ずつ最近接偶数丸めで変換.
+    for( ; i + 8 <= count; i += 8 )
+    {
+        __m128i h = _mm256_cvtps_ph( _mm256_loadu_ps( pSrc + i ), _MM_FROUND_TO_NEAREST_INT );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( pDst + i ), h );
+    }
+#endif//ASDX_USE_F16C
+
+    // 端数.
+    for( ; i < count; ++i )
+    { pDst[ i ] = F32ToF16( pSrc[ i ] ); }
+}
+
+ASDX_INLINE
+void F16ToF32Array( const f16* pSrc, f32* pDst, u32 count )
+{
+    assert( pSrc != 0 );
+    assert( pDst != 0 );
+
+    u32 i = 0;
+
+#if defined(ASDX_USE_F16C) && ASDX_USE_F16C
+    // 8要素ずつ変換.
+    for( ; i + 8 <= count; i += 8 )
+    {
+        __m128i h = _mm_loadu_si128( reinterpret_cast<const __m128i*>( pSrc + i ) );
+        _mm256_storeu_ps( pDst + i, _mm256_cvtph_ps( h ) );
+    }
+#endif//ASDX_USE_F16C
+
+    // 端数.
+    for( ; i < count; ++i )
+    { pDst[ i ] = F16ToF32( pSrc[ i ] ); }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -190,6 +551,13 @@ ASDX_INLINE
 Vector2::Vector2()
 { /* DO_NOTHING */ }
 
+ASDX_INLINE
+Vector2::Vector2( const Vector2& value )
+{
+    x = value.x;
+    y = value.y;
+}
+
 ASDX_INLINE
 Vector2::Vector2( const f32* pf )
 {
@@ -784,6 +1152,18 @@ void Vector2::TransformCoord( const Vector2 &coords, const Matrix &matrix, Vecto
     result.y = Y / W;
 }
 
+ASDX_INLINE
+void Vector2::TransformStream( const Vector2* pInput, u32 inputStride, Vector2* pOutput, u32 outputStride, u32 count, const Matrix& matrix )
+{ simd::TransformArray< Vector2, 2, true, false >( pInput, inputStride, pOutput, outputStride, count, matrix, &Vector2::Transform ); }
+
+ASDX_INLINE
+void Vector2::TransformNormalStream( const Vector2* pInput, u32 inputStride, Vector2* pOutput, u32 outputStride, u32 count, const Matrix& matrix )
+{ simd::TransformArray< Vector2, 2, false, false >( pInput, inputStride, pOutput, outputStride, count, matrix, &Vector2::TransformNormal ); }
+
+ASDX_INLINE
+void Vector2::TransformCoordStream( const Vector2* pInput, u32 inputStride, Vector2* pOutput, u32 outputStride, u32 count, const Matrix& matrix )
+{ simd::TransformArray< Vector2, 2, true, true >( pInput, inputStride, pOutput, outputStride, count, matrix, &Vector2::TransformCoord ); }
+
 
 /////////////////////////////////////////////////////////////////////////
 // Vector3 structure
@@ -793,6 +1173,14 @@ ASDX_INLINE
 Vector3::Vector3()
 { /* DO_NOTHING */ }
 
+ASDX_INLINE
+Vector3::Vector3( const Vector3& value )
+{
+    x = value.x;
+    y = value.y;
+    z = value.z;
+}
+
 ASDX_INLINE
 Vector3::Vector3( const f32* pf )
 {
@@ -1149,8 +1537,8 @@ void Vector3::SafeNormalize( const Vector3& value, const Vector3& set, Vector3&
 ASDX_INLINE
 Vector3 Vector3::ComputeNormal( const Vector3& p1, const Vector3& p2, const Vector3& p3 )
 {
-    register Vector3 v1 = p2 - p1;
-    register Vector3 v2 = p3 - p1;
+    Vector3 v1 = p2 - p1;
+    Vector3 v2 = p3 - p1;
     Vector3 result = Vector3::Cross( v1, v2 );
     return result.Normalize();
 }
@@ -1158,8 +1546,8 @@ Vector3 Vector3::ComputeNormal( const Vector3& p1, const Vector3& p2, const Vect
 ASDX_INLINE
 void Vector3::ComputeNormal( const Vector3 &p1, const Vector3 &p2, const Vector3 &p3, Vector3 &result )
 {
-    register Vector3 v1 = p2 - p1;
-    register Vector3 v2 = p3 - p1;
+    Vector3 v1 = p2 - p1;
+    Vector3 v2 = p3 - p1;
     Vector3::Cross( v1, v2, result );
     result.Normalize();
 }
@@ -1472,64 +1860,118 @@ void Vector3::SmoothStep( const Vector3 &a, const Vector3 &b, const f32 amount,
 ASDX_INLINE
 Vector3 Vector3::Transform( const Vector3& position, const Matrix& matrix )
 {
+#if ASDX_USE_SIMD
+    Vector3 result;
+    Transform( position, matrix, result );
+    return result;
+#else
     return Vector3(
         ( ((position.x * matrix._11) + (position.y * matrix._21)) + (position.z * matrix._31)) + matrix._41,
         ( ((position.x * matrix._12) + (position.y * matrix._22)) + (position.z * matrix._32)) + matrix._42,
         ( ((position.x * matrix._13) + (position.y * matrix._23)) + (position.z * matrix._33)) + matrix._43 );
+#endif
 }
 
 ASDX_INLINE
 void Vector3::Transform( const Vector3 &position, const Matrix &matrix, Vector3 &result )
 {
+#if ASDX_USE_SIMD
+    f32 v[4];
+    simd::Store( v, simd::Add( simd::CombineRows( position.x, position.y, position.z, matrix ), simd::Load( matrix.m[3] ) ) );
+    result.x = v[0];
+    result.y = v[1];
+    result.z = v[2];
+#else
     result.x = ( ((position.x * matrix._11) + (position.y * matrix._21)) + (position.z * matrix._31)) + matrix._41;
     result.y = ( ((position.x * matrix._12) + (position.y * matrix._22)) + (position.z * matrix._32)) + matrix._42;
     result.z = ( ((position.x * matrix._13) + (position.y * matrix._23)) + (position.z * matrix._33)) + matrix._43;
+#endif
 }
 
 ASDX_INLINE
 Vector3 Vector3::TransformNormal( const Vector3& normal, const Matrix& matrix )
 {
+#if ASDX_USE_SIMD
+    Vector3 result;
+    TransformNormal( normal, matrix, result );
+    return result;
+#else
     return Vector3(
         ((normal.x * matrix._11) + (normal.y * matrix._21)) + (normal.z * matrix._31),
-        ((normal.y * matrix._12) + (normal.y * matrix._22)) + (normal.z * matrix._32),
-        ((normal.z * matrix._13) + (normal.y * matrix._23)) + (normal.z * matrix._33) );
+        ((normal.x * matrix._12) + (normal.y * matrix._22)) + (normal.z * matrix._32),
+        ((normal.x * matrix._13) + (normal.y * matrix._23)) + (normal.z * matrix._33) );
+#endif
 }
 
 ASDX_INLINE
 void Vector3::TransformNormal( const Vector3 &normal, const Matrix &matrix, Vector3 &result )
 {
+#if ASDX_USE_SIMD
+    f32 v[4];
+    simd::Store( v, simd::CombineRows( normal.x, normal.y, normal.z, matrix ) );
+    result.x = v[0];
+    result.y = v[1];
+    result.z = v[2];
+#else
     result.x = ((normal.x * matrix._11) + (normal.y * matrix._21)) + (normal.z * matrix._31);
-    result.y = ((normal.y * matrix._12) + (normal.y * matrix._22)) + (normal.z * matrix._32);
-    result.z = ((normal.z * matrix._13) + (normal.y * matrix._23)) + (normal.z * matrix._33);
+    result.y = ((normal.x * matrix._12) + (normal.y * matrix._22)) + (normal.z * matrix._32);
+    result.z = ((normal.x * matrix._13) + (normal.y * matrix._23)) + (normal.z * matrix._33);
+#endif
 }
 
 ASDX_INLINE
 Vector3 Vector3::TransformCoord( const Vector3& coords, const Matrix& matrix )
 {
+#if ASDX_USE_SIMD
+    Vector3 result;
+    TransformCoord( coords, matrix, result );
+    return result;
+#else
     register f32 X = ( ( ((coords.x * matrix._11) + (coords.y * matrix._21)) + (coords.z * matrix._31) ) + matrix._41);
     register f32 Y = ( ( ((coords.x * matrix._12) + (coords.y * matrix._22)) + (coords.z * matrix._32) ) + matrix._42);
     register f32 Z = ( ( ((coords.x * matrix._13) + (coords.y * matrix._23)) + (coords.z * matrix._33) ) + matrix._43);
-    register f32 W = ( ( ((coords.x * matrix._14) + (coords.y * matrix._24)) + (coords.z * matrix._43) ) + matrix._44);
+    register f32 W = ( ( ((coords.x * matrix._14) + (coords.y * matrix._24)) + (coords.z * matrix._34) ) + matrix._44);
     return Vector3(
         X / W,
         Y / W,
         Z / W 
     );
+#endif
 }
 
 ASDX_INLINE
 void Vector3::TransformCoord( const Vector3 &coords, const Matrix &matrix, Vector3 &result )
 {
+#if ASDX_USE_SIMD
+    f32 v[4];
+    simd::Store( v, simd::Add( simd::CombineRows( coords.x, coords.y, coords.z, matrix ), simd::Load( matrix.m[3] ) ) );
+    result.x = v[0] / v[3];
+    result.y = v[1] / v[3];
+    result.z = v[2] / v[3];
+#else
     register f32 X = ( ( ((coords.x * matrix._11) + (coords.y * matrix._21)) + (coords.z * matrix._31) ) + matrix._41);
     register f32 Y = ( ( ((coords.x * matrix._12) + (coords.y * matrix._22)) + (coords.z * matrix._32) ) + matrix._42);
     register f32 Z = ( ( ((coords.x * matrix._13) + (coords.y * matrix._23)) + (coords.z * matrix._33) ) + matrix._43);
-    register f32 W = ( ( ((coords.x * matrix._14) + (coords.y * matrix._24)) + (coords.z * matrix._43) ) + matrix._44);
+    register f32 W = ( ( ((coords.x * matrix._14) + (coords.y * matrix._24)) + (coords.z * matrix._34) ) + matrix._44);
 
     result.x = X / W;
     result.y = Y / W;
     result.z = Z / W;
+#endif
 }
 
+ASDX_INLINE
+void Vector3::TransformStream( const Vector3* pInput, u32 inputStride, Vector3* pOutput, u32 outputStride, u32 count, const Matrix& matrix )
+{ simd::TransformArray< Vector3, 3, true, false >( pInput, inputStride, pOutput, outputStride, count, matrix, &Vector3::Transform ); }
+
+ASDX_INLINE
+void Vector3::TransformNormalStream( const Vector3* pInput, u32 inputStride, Vector3* pOutput, u32 outputStride, u32 count, const Matrix& matrix )
+{ simd::TransformArray< Vector3, 3, false, false >( pInput, inputStride, pOutput, outputStride, count, matrix, &Vector3::TransformNormal ); }
+
+ASDX_INLINE
+void Vector3::TransformCoordStream( const Vector3* pInput, u32 inputStride, Vector3* pOutput, u32 outputStride, u32 count, const Matrix& matrix )
+{ simd::TransformArray< Vector3, 3, true, true >( pInput, inputStride, pOutput, outputStride, count, matrix, &Vector3::TransformCoord ); }
+
 
 ASDX_INLINE
 f32 Vector3::ScalarTriple( const Vector3& a, const Vector3& b, const Vector3& c )
@@ -1587,6 +2029,15 @@ ASDX_INLINE
 Vector4::Vector4()
 { /* DO_NOTHING */ }
 
+ASDX_INLINE
+Vector4::Vector4( const Vector4& value )
+{
+    x = value.x;
+    y = value.y;
+    z = value.z;
+    w = value.w;
+}
+
 ASDX_INLINE
 Vector4::Vector4( const f32* pf )
 {
@@ -2193,22 +2644,36 @@ void Vector4::SmoothStep( const Vector4 &a, const Vector4 &b, const f32 amount,
 ASDX_INLINE
 Vector4 Vector4::Transform( const Vector4& position, const Matrix& matrix )
 {
+#if ASDX_USE_SIMD
+    Vector4 result;
+    Transform( position, matrix, result );
+    return result;
+#else
     return Vector4(
         ( ( ((position.x * matrix._11) + (position.y * matrix._21)) + (position.z * matrix._31) ) + (position.w * matrix._41)),
         ( ( ((position.x * matrix._12) + (position.y * matrix._22)) + (position.z * matrix._32) ) + (position.w * matrix._42)),
         ( ( ((position.x * matrix._13) + (position.y * matrix._23)) + (position.z * matrix._33) ) + (position.w * matrix._43)),
-        ( ( ((position.x * matrix._14) + (position.y * matrix._24)) + (position.z * matrix._43) ) + (position.w * matrix._44)) );
+        ( ( ((position.x * matrix._14) + (position.y * matrix._24)) + (position.z * matrix._34) ) + (position.w * matrix._44)) );
+#endif
 }
 
 ASDX_INLINE
 void Vector4::Transform( const Vector4 &position, const Matrix &matrix, Vector4 &result )
 {
+#if ASDX_USE_SIMD
+    simd::Store( &result.x, simd::TransformRow( &position.x, matrix ) );
+#else
     result.x = ( ( ((position.x * matrix._11) + (position.y * matrix._21)) + (position.z * matrix._31) ) + (position.w * matrix._41));
     result.y = ( ( ((position.x * matrix._12) + (position.y * matrix._22)) + (position.z * matrix._32) ) + (position.w * matrix._42));
     result.z = ( ( ((position.x * matrix._13) + (position.y * matrix._23)) + (position.z * matrix._33) ) + (position.w * matrix._43));
-    result.w = ( ( ((position.x * matrix._14) + (position.y * matrix._24)) + (position.z * matrix._43) ) + (position.w * matrix._44));
+    result.w = ( ( ((position.x * matrix._14) + (position.y * matrix._24)) + (position.z * matrix._34) ) + (position.w * matrix._44));
+#endif
 }
 
+ASDX_INLINE
+void Vector4::TransformStream( const Vector4* pInput, u32 inputStride, Vector4* pOutput, u32 outputStride, u32 count, const Matrix& matrix )
+{ simd::TransformArray< Vector4, 4, false, false >( pInput, inputStride, pOutput, outputStride, count, matrix, &Vector4::Transform ); }
+
 
 
 
@@ -2220,6 +2685,10 @@ ASDX_INLINE
 Matrix::Matrix()
 { /* DO_NOTHING */ }
 
+ASDX_INLINE
+Matrix::Matrix( const Matrix& value )
+{ memcpy( &_11, &value._11, sizeof(Matrix) ); }
+
 ASDX_INLINE
 Matrix::Matrix( const f32* pf )
 {
@@ -2332,9 +2801,9 @@ Matrix Matrix::operator - () const
 ASDX_INLINE 
 Matrix Matrix::operator * ( const Matrix& value ) const
 {
-#if 0
-    Matrix tmp = (*this);
-    Matrix result = Multiply( tmp, value );
+#if ASDX_USE_SIMD
+    Matrix result;
+    simd::MultiplyMatrix( (*this), value, result );
     return result;
 #else
     return Matrix(
@@ -2497,7 +2966,7 @@ void Matrix::Transpose( const Matrix &value, Matrix &result )
     result._31 = value._13;
     result._32 = value._23;
     result._33 = value._33;
-    result._34 = value._34;
+    result._34 = value._43;
 
     result._41 = value._14;
     result._42 = value._24;
@@ -2508,14 +2977,9 @@ void Matrix::Transpose( const Matrix &value, Matrix &result )
 ASDX_INLINE
 Matrix Matrix::Multiply( const Matrix& a, const Matrix& b )
 {
-#if 0
+#if ASDX_USE_SIMD
     Matrix tmp;
-    for ( s32 i=0; i<4; i++ )
-        for ( s32 j=0; j<4; j++ )
-            tmp.m[i][j] = a.m[i][0] * b.m[0][j] +
-                          a.m[i][1] * b.m[1][j] +
-                          a.m[i][2] * b.m[2][j] +
-                          a.m[i][3] * b.m[3][j];
+    simd::MultiplyMatrix( a, b, tmp );
     return tmp;
 #else
     return Matrix(
@@ -2545,13 +3009,8 @@ Matrix Matrix::Multiply( const Matrix& a, const Matrix& b )
 ASDX_INLINE
 void Matrix::Multiply( const Matrix &a, const Matrix &b, Matrix &result )
 {
-#if 0
-    for ( s32 i=0; i<4; i++ )
-        for ( s32 j=0; j<4; j++ )
-            result.m[i][j] = a.m[i][0] * b.m[0][j] +
-                             a.m[i][1] * b.m[1][j] +
-                             a.m[i][2] * b.m[2][j] +
-                             a.m[i][3] * b.m[3][j];
+#if ASDX_USE_SIMD
+    simd::MultiplyMatrix( a, b, result );
 #else
     result._11 = ( a._11 * b._11 ) + ( a._12 * b._21 ) + ( a._13 * b._31 ) + ( a._14 * b._41 );
     result._12 = ( a._11 * b._12 ) + ( a._12 * b._22 ) + ( a._13 * b._32 ) + ( a._14 * b._42 );
@@ -2613,31 +3072,30 @@ void Matrix::Multiply( const Matrix &value, const f32 scaleFactor, Matrix &resul
 ASDX_INLINE
 Matrix Matrix::MultiplyTranspose( const Matrix& a, const Matrix& b )
 {
-#if 0
+#if ASDX_USE_SIMD
     Matrix result;
-    result = Multiply( a, b );
-    result = Transpose( result );
-    return result;
+    simd::MultiplyMatrix( a, b, result );
+    return Transpose( result );
 #else
     return Matrix(
         ( a._11 * b._11 ) + ( a._12 * b._21 ) + ( a._13 * b._31 ) + ( a._14 * b._41 ),
-        ( a._11 * b._12 ) + ( a._12 * b._22 ) + ( a._13 * b._32 ) + ( a._14 * b._42 ),
-        ( a._11 * b._13 ) + ( a._12 * b._23 ) + ( a._13 * b._33 ) + ( a._14 * b._43 ),
-        ( a._11 * b._14 ) + ( a._12 * b._24 ) + ( a._13 * b._34 ) + ( a._14 * b._44 ),
-
         ( a._21 * b._11 ) + ( a._22 * b._21 ) + ( a._23 * b._31 ) + ( a._24 * b._41 ),
-        ( a._21 * b._12 ) + ( a._22 * b._22 ) + ( a._23 * b._32 ) + ( a._24 * b._42 ),
-        ( a._21 * b._13 ) + ( a._22 * b._23 ) + ( a._23 * b._33 ) + ( a._24 * b._43 ),
-        ( a._21 * b._14 ) + ( a._22 * b._24 ) + ( a._23 * b._34 ) + ( a._24 * b._44 ),
-
         ( a._31 * b._11 ) + ( a._32 * b._21 ) + ( a._33 * b._31 ) + ( a._34 * b._41 ),
-        ( a._31 * b._12 ) + ( a._32 * b._22 ) + ( a._33 * b._32 ) + ( a._34 * b._42 ),
-        ( a._31 * b._13 ) + ( a._32 * b._23 ) + ( a._33 * b._33 ) + ( a._34 * b._43 ),
-        ( a._31 * b._14 ) + ( a._32 * b._24 ) + ( a._33 * b._34 ) + ( a._34 * b._44 ),
-
         ( a._41 * b._11 ) + ( a._42 * b._21 ) + ( a._43 * b._31 ) + ( a._44 * b._41 ),
+
+        ( a._11 * b._12 ) + ( a._12 * b._22 ) + ( a._13 * b._32 ) + ( a._14 * b._42 ),
+        ( a._21 * b._12 ) + ( a._22 * b._22 ) + ( a._23 * b._32 ) + ( a._24 * b._42 ),
+        ( a._31 * b._12 ) + ( a._32 * b._22 ) + ( a._33 * b._32 ) + ( a._34 * b._42 ),
         ( a._41 * b._12 ) + ( a._42 * b._22 ) + ( a._43 * b._32 ) + ( a._44 * b._42 ),
+
+        ( a._11 * b._13 ) + ( a._12 * b._23 ) + ( a._13 * b._33 ) + ( a._14 * b._43 ),
+        ( a._21 * b._13 ) + ( a._22 * b._23 ) + ( a._23 * b._33 ) + ( a._24 * b._43 ),
+        ( a._31 * b._13 ) + ( a._32 * b._23 ) + ( a._33 * b._33 ) + ( a._34 * b._43 ),
         ( a._41 * b._13 ) + ( a._42 * b._23 ) + ( a._43 * b._33 ) + ( a._44 * b._43 ),
+
+        ( a._11 * b._14 ) + ( a._12 * b._24 ) + ( a._13 * b._34 ) + ( a._14 * b._44 ),
+        ( a._21 * b._14 ) + ( a._22 * b._24 ) + ( a._23 * b._34 ) + ( a._24 * b._44 ),
+        ( a._31 * b._14 ) + ( a._32 * b._24 ) + ( a._33 * b._34 ) + ( a._34 * b._44 ),
         ( a._41 * b._14 ) + ( a._42 * b._24 ) + ( a._43 * b._34 ) + ( a._44 * b._44 )
     );
 #endif
@@ -2646,9 +3104,10 @@ Matrix Matrix::MultiplyTranspose( const Matrix& a, const Matrix& b )
 ASDX_INLINE
 void Matrix::MultiplyTranspose( const Matrix &a, const Matrix &b, Matrix &result )
 {
-#if 0
-    result = Multiply( a, b );
-    result = Transpose( result );
+#if ASDX_USE_SIMD
+    Matrix tmp;
+    simd::MultiplyMatrix( a, b, tmp );
+    Transpose( tmp, result );
 #else
     result._11 = ( a._11 * b._11 ) + ( a._12 * b._21 ) + ( a._13 * b._31 ) + ( a._14 * b._41 );
     result._21 = ( a._11 * b._12 ) + ( a._12 * b._22 ) + ( a._13 * b._32 ) + ( a._14 * b._42 );
@@ -2677,6 +3136,9 @@ ASDX_INLINE
 Matrix Matrix::Invert( const Matrix& value )
 {
     Matrix result;
+#if ASDX_USE_SIMD
+    simd::InvertMatrix( value, result );
+#else
     register f32 det = value.Determinant();
     assert( det != 0.0f );
 
@@ -2719,6 +3181,7 @@ Matrix Matrix::Invert( const Matrix& value )
     result._42 /= det;
     result._43 /= det;
     result._44 /= det;
+#endif
 
     return result;
 }
@@ -2726,6 +3189,9 @@ Matrix Matrix::Invert( const Matrix& value )
 ASDX_INLINE
 void Matrix::Invert( const Matrix &value, Matrix &result )
 { 
+#if ASDX_USE_SIMD
+    simd::InvertMatrix( value, result );
+#else
     register f32 det = value.Determinant();
     assert( det != 0.0f );
 
@@ -2768,6 +3234,7 @@ void Matrix::Invert( const Matrix &value, Matrix &result )
     result._42 /= det;
     result._43 /= det;
     result._44 /= det;
+#endif
 }
 
 ASDX_INLINE
@@ -3708,6 +4175,9 @@ Quaternion& Quaternion::operator -= ( const Quaternion& q )
 ASDX_INLINE
 Quaternion& Quaternion::operator *= ( const Quaternion& q )
 {
+#if ASDX_USE_SIMD
+    simd::MultiplyQuaternion( (*this), q, (*this) );
+#else
     register f32 f12 = ( y * q.z ) - ( z * q.y );
     register f32 f11 = ( z * q.x ) - ( x * q.z );
     register f32 f10 = ( x * q.y ) - ( y * q.x );
@@ -3717,6 +4187,7 @@ Quaternion& Quaternion::operator *= ( const Quaternion& q )
     y = ( y * q.w ) + ( q.y * w ) + f11;
     z = ( z * q.w ) + ( q.z * w ) + f10;
     w = ( w * q.w ) - f09;
+#endif
     return (*this);
 }
 
@@ -3760,6 +4231,11 @@ Quaternion Quaternion::operator - ( const Quaternion& q ) const
 ASDX_INLINE 
 Quaternion Quaternion::operator * ( const Quaternion& q ) const
 { 
+#if ASDX_USE_SIMD
+    Quaternion result;
+    simd::MultiplyQuaternion( (*this), q, result );
+    return result;
+#else
     register f32 f12 = ( y * q.z ) - ( z * q.y );
     register f32 f11 = ( z * q.x ) - ( x * q.z );
     register f32 f10 = ( x * q.y ) - ( y * q.x );
@@ -3767,9 +4243,10 @@ Quaternion Quaternion::operator * ( const Quaternion& q ) const
 
     return Quaternion(
         ( x * q.w ) + ( q.x * w ) + f12,
-        ( y * q.w ) + ( q.x * w ) + f11,
+        ( y * q.w ) + ( q.y * w ) + f11,
         ( z * q.w ) + ( q.z * w ) + f10,
         ( w * q.w ) - f09 );
+#endif
 }
 
 ASDX_INLINE 
@@ -3895,6 +4372,11 @@ bool Quaternion::IsIdentity( const Quaternion& value )
 ASDX_INLINE
 Quaternion Quaternion::Multiply( const Quaternion& a, const Quaternion& b )
 {
+#if ASDX_USE_SIMD
+    Quaternion result;
+    simd::MultiplyQuaternion( a, b, result );
+    return result;
+#else
     register f32 f12 = ( a.y * b.z ) - ( a.z * b.y );
     register f32 f11 = ( a.z * b.x ) - ( a.x * b.z );
     register f32 f10 = ( a.x * b.y ) - ( a.y * b.x );
@@ -3902,23 +4384,28 @@ Quaternion Quaternion::Multiply( const Quaternion& a, const Quaternion& b )
 
     return Quaternion(
         ( a.x * b.w ) + ( b.x * a.w ) + f12,
-        ( a.y * b.w ) + ( b.x * a.w ) + f11,
+        ( a.y * b.w ) + ( b.y * a.w ) + f11,
         ( a.z * b.w ) + ( b.z * a.w ) + f10,
         ( a.w * b.w ) - f09 );
+#endif
 }
 
 ASDX_INLINE
 void Quaternion::Multiply( const Quaternion& a, const Quaternion& b, Quaternion& result )
 {
+#if ASDX_USE_SIMD
+    simd::MultiplyQuaternion( a, b, result );
+#else
     register f32 f12 = ( a.y * b.z ) - ( a.z * b.y );
     register f32 f11 = ( a.z * b.x ) - ( a.x * b.z );
     register f32 f10 = ( a.x * b.y ) - ( a.y * b.x );
     register f32 f09 = ( a.x * b.x ) + ( a.y * b.y ) + ( a.z * b.z );
 
     result.x = ( a.x * b.w ) + ( b.x * a.w ) + f12;
-    result.y = ( a.y * b.w ) + ( b.x * a.w ) + f11;
+    result.y = ( a.y * b.w ) + ( b.y * a.w ) + f11;
     result.z = ( a.z * b.w ) + ( b.z * a.w ) + f10;
     result.w = ( a.w * b.w ) - f09;
+#endif
 }
 
 ASDX_INLINE
@@ -4239,7 +4726,7 @@ Quaternion Quaternion::Slerp( const Quaternion& a, const Quaternion& b, const f3
     if ( cosOmega < 0.0f )
     {
         flag = true;
-        cosOmega -= cosOmega;
+        cosOmega = -cosOmega;
     }
 
     f32 k1, k2;
@@ -4255,12 +4742,18 @@ Quaternion Quaternion::Slerp( const Quaternion& a, const Quaternion& b, const f3
         k1 = sinf( ( 1.0f - amount ) * q5 ) * q6;
         k2 = ( flag ) ? -sinf( amount * q5 ) * q6 : sinf( amount * q5 ) * q6;
     }
+#if ASDX_USE_SIMD
+    Quaternion result;
+    simd::Store( &result.x, simd::Add( simd::Mul( simd::Splat( k1 ), simd::Load( &a.x ) ), simd::Mul( simd::Splat( k2 ), simd::Load( &b.x ) ) ) );
+    return result;
+#else
     return Quaternion( 
-        ( k1 * a.x ) + ( k2 * a.x ),
-        ( k1 * a.y ) + ( k2 * a.y ),
-        ( k1 * a.z ) + ( k2 * a.z ),
-        ( k1 * a.w ) + ( k2 * a.w )
+        ( k1 * a.x ) + ( k2 * b.x ),
+        ( k1 * a.y ) + ( k2 * b.y ),
+        ( k1 * a.z ) + ( k2 * b.z ),
+        ( k1 * a.w ) + ( k2 * b.w )
     );
+#endif
 }
 
 ASDX_INLINE
@@ -4290,7 +4783,7 @@ void Quaternion::Slerp( const Quaternion &a, const Quaternion &b, const f32 amou
     if ( cosOmega < 0.0f )
     {
         flag = true;
-        cosOmega -= cosOmega;
+        cosOmega = -cosOmega;
     }
 
     f32 k1, k2;
@@ -4307,25 +4800,29 @@ void Quaternion::Slerp( const Quaternion &a, const Quaternion &b, const f32 amou
         k2 = ( flag ) ? -sinf( amount * q5 ) * q6 : sinf( amount * q5 ) * q6;
     }
   
-    result.x = ( k1 * a.x ) + ( k2 * a.x );
-    result.y = ( k1 * a.y ) + ( k2 * a.y );
-    result.z = ( k1 * a.z ) + ( k2 * a.z );
-    result.w = ( k1 * a.w ) + ( k2 * a.w );
+#if ASDX_USE_SIMD
+    simd::Store( &result.x, simd::Add( simd::Mul( simd::Splat( k1 ), simd::Load( &a.x ) ), simd::Mul( simd::Splat( k2 ), simd::Load( &b.x ) ) ) );
+#else
+    result.x = ( k1 * a.x ) + ( k2 * b.x );
+    result.y = ( k1 * a.y ) + ( k2 * b.y );
+    result.z = ( k1 * a.z ) + ( k2 * b.z );
+    result.w = ( k1 * a.w ) + ( k2 * b.w );
+#endif
 }
 
 ASDX_INLINE
 Quaternion Quaternion::Squad( const Quaternion& q, const Quaternion& a, const Quaternion& b, const Quaternion& c, const f32 amount )
 {
-    register Quaternion d = Quaternion::Slerp( q, c, amount );
-    register Quaternion e = Quaternion::Slerp( a, b, amount );
+    Quaternion d = Quaternion::Slerp( q, c, amount );
+    Quaternion e = Quaternion::Slerp( a, b, amount );
     return Quaternion::Slerp( d, e, 2.0f * amount * ( 1.0f - amount ) );
 }
 
 ASDX_INLINE
 void Quaternion::Squad( const Quaternion &q, const Quaternion &a, const Quaternion &b, const Quaternion &c, const f32 amount, Quaternion &result )
 {
-    register Quaternion d = Quaternion::Slerp( q, c, amount );
-    register Quaternion e = Quaternion::Slerp( a, b, amount );
+    Quaternion d = Quaternion::Slerp( q, c, amount );
+    Quaternion e = Quaternion::Slerp( a, b, amount );
     Quaternion::Slerp( d, e, 2.0f * amount * ( 1.0f - amount ), result );
 }
 
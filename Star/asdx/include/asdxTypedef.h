@@ -69,7 +69,7 @@
     #if _MSC_VER
         #define ASDX_ALIGN( alignment )    __declspec( align(alignment) )
     #else
-        #define ASDX_ALIGN( alignment )    __attribute__( aligned(alignment) )
+        #define ASDX_ALIGN( alignment )    __attribute__( (aligned(alignment)) )
     #endif
 #endif//ASDX_ALIGN
 
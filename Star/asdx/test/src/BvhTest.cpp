@@ -0,0 +1,438 @@
+﻿//-------------------------------------------------------------------------------------
+// File : BvhTest.cpp
+// Desc : Bounding Volume Hierarchy Module Test.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------
+#include <asdxBvh.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------
+// Macros
+//-------------------------------------------------------------------------------------
+#define CHECK( expr )                                                           \
+    do {                                                                        \
+        if ( !( expr ) )                                                        \
+        {                                                                       \
+            fprintf( stderr, "Error : %s(%d) : %s\n", __FILE__, __LINE__, #expr );  \
+            g_FailCount++;                                                      \
+        }                                                                       \
+    } while( 0 )
+
+#if defined(ASDX_USE_AVX2) && ASDX_USE_AVX2
+#define TEST_USE_AVX2   (1)
+#else
+#define TEST_USE_AVX2   (0)
+#endif
+
+
+//-------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------
+const int   SKIP_CODE       = 77;       // CTest の SKIP_RETURN_CODE です.
+const u32   RAY_COUNT       = 1000;     // 総当たりと比較するレイの数です.
+const u32   QUERY_COUNT     = 5;        // 総当たりと比較する視錐台と境界球の数です.
+const u32   INVALID_INDEX   = 0xffffffff;
+
+
+//-------------------------------------------------------------------------------------
+// Global Variables
+//-------------------------------------------------------------------------------------
+int g_FailCount = 0;
+u32 g_Seed      = 1234567;
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Vertex structure
+///////////////////////////////////////////////////////////////////////////////////////
+struct Vertex
+{
+    asdx::Vector3   Position;   //!< 位置座標です.
+    asdx::Vector3   Normal;     //!< 法線ベクトルです.
+    asdx::Vector3   Tangent;    //!< 接線ベクトルです.
+    asdx::Vector2   TexCoord;   //!< テクスチャ座標です.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Mesh structure
+///////////////////////////////////////////////////////////////////////////////////////
+struct Mesh
+{
+    std::vector<Vertex>     Vertices;   //!< 頂点です. ResMesh::Vertex と同じ並びです.
+    std::vector<u32>        Indices;    //!< 頂点インデックスです.
+
+    u32 GetTriangleCount() const
+    { return u32( Indices.size() / 3 ); }
+
+    const asdx::Vector3& GetPosition( u32 triangle, u32 corner ) const
+    { return Vertices[ Indices[ triangle * 3 + corner ] ].Position; }
+
+    asdx::BoundingBox GetBox( u32 triangle ) const
+    {
+        auto& a = GetPosition( triangle, 0 );
+        auto& b = GetPosition( triangle, 1 );
+        auto& c = GetPosition( triangle, 2 );
+        return asdx::BoundingBox(
+            asdx::Vector3::Min( asdx::Vector3::Min( a, b ), c ),
+            asdx::Vector3::Max( asdx::Vector3::Max( a, b ), c ) );
+    }
+};
+
+
+//-------------------------------------------------------------------------------------
+//      [-1, 1) の乱数を取得します.
+//-------------------------------------------------------------------------------------
+f32 Rand()
+{
+    g_Seed = g_Seed * 1664525u + 1013904223u;
+    return f32( ( g_Seed >> 8 ) & 0xffff ) / 32768.0f - 1.0f;
+}
+
+//-------------------------------------------------------------------------------------
+//      位置座標だけを指定した頂点を取得します.
+//-------------------------------------------------------------------------------------
+Vertex MakeVertex( const asdx::Vector3& position )
+{
+    Vertex vertex;
+    vertex.Position = position;
+    vertex.Normal   = asdx::Vector3( 0.0f, 1.0f, 0.0f );
+    vertex.Tangent  = asdx::Vector3( 1.0f, 0.0f, 0.0f );
+    vertex.TexCoord = asdx::Vector2( 0.0f, 0.0f );
+    return vertex;
+}
+
+//-------------------------------------------------------------------------------------
+//      起伏のある格子状のメッシュを作成します.
+//-------------------------------------------------------------------------------------
+void CreateGrid( u32 w, u32 h, Mesh& mesh )
+{
+    mesh.Vertices.clear();
+    mesh.Indices .clear();
+
+    for(u32 y=0; y<=h; ++y)
+    {
+        for(u32 x=0; x<=w; ++x)
+        {
+            auto fx = f32( x ) / f32( w ) * 100.0f - 50.0f;
+            auto fz = f32( y ) / f32( h ) * 100.0f - 50.0f;
+
+            auto fy = 3.0f * sinf( fx * 0.3f ) * cosf( fz * 0.2f ) + 0.05f * Rand();
+            mesh.Vertices.push_back( MakeVertex( asdx::Vector3( fx, fy, fz ) ) );
+        }
+    }
+
+    for(u32 y=0; y<h; ++y)
+    {
+        for(u32 x=0; x<w; ++x)
+        {
+            u32 a = y * ( w + 1 ) + x;
+            u32 b = a + 1;
+            u32 c = a + w + 1;
+            u32 d = c + 1;
+            u32 quad[] = { a, c, b, b, c, d };
+            mesh.Indices.insert( mesh.Indices.end(), quad, quad + 6 );
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------
+//      重なり合うばらばらの三角形のメッシュを作成します.
+//-------------------------------------------------------------------------------------
+void CreateSoup( u32 count, Mesh& mesh )
+{
+    mesh.Vertices.clear();
+    mesh.Indices .clear();
+
+    for(u32 i=0; i<count; ++i)
+    {
+        asdx::Vector3 center( Rand() * 50.0f, Rand() * 50.0f, Rand() * 50.0f );
+        for(u32 j=0; j<3; ++j)
+        {
+            auto offset = asdx::Vector3( Rand(), Rand(), Rand() ) * 2.0f;
+            mesh.Indices .push_back( u32( mesh.Vertices.size() ) );
+            mesh.Vertices.push_back( MakeVertex( center + offset ) );
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------
+//      メッシュの BVH を構築します.
+//-------------------------------------------------------------------------------------
+bool InitBvh( const Mesh& mesh, u32 threadCount, asdx::MeshBvh& bvh )
+{
+    return bvh.Init(
+        &mesh.Vertices[0].Position,
+        sizeof(Vertex),
+        u32( mesh.Vertices.size() ),
+        mesh.Indices.data(),
+        u32( mesh.Indices.size() ),
+        threadCount );
+}
+
+//-------------------------------------------------------------------------------------
+//      BVH のノードが一致するかチェックします.
+//-------------------------------------------------------------------------------------
+bool IsSame( const asdx::Bvh& a, const asdx::Bvh& b )
+{
+    if ( a.GetNodeCount() != b.GetNodeCount() || a.GetPrimitiveCount() != b.GetPrimitiveCount() )
+    { return false; }
+
+    return memcmp( a.GetNodes(),      b.GetNodes(),      sizeof(asdx::BvhNode) * a.GetNodeCount() ) == 0
+        && memcmp( a.GetPrimitives(), b.GetPrimitives(), sizeof(asdx::BvhNode) * a.GetPrimitiveCount() ) == 0;
+}
+
+//-------------------------------------------------------------------------------------
+//      出力された番号を整列して取得します.
+//-------------------------------------------------------------------------------------
+std::vector<u32> Sorted( const std::vector<u32>& indices, u32 count )
+{
+    std::vector<u32> result( indices.begin(), indices.begin() + count );
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------
+//      不正な入力で初期化に失敗することをテストします.
+//-------------------------------------------------------------------------------------
+void TestInvalidInput()
+{
+    Mesh mesh;
+    CreateSoup( 2, mesh );
+
+    asdx::MeshBvh bvh;
+    CHECK( !bvh.Init( nullptr, sizeof(Vertex), 6, mesh.Indices.data(), 6 ) );
+    CHECK( !bvh.Init( &mesh.Vertices[0].Position, sizeof(Vertex), 6, nullptr, 6 ) );
+    CHECK( !bvh.Init( &mesh.Vertices[0].Position, sizeof(Vertex), 6, mesh.Indices.data(), 0 ) );
+    CHECK( !bvh.Init( &mesh.Vertices[0].Position, sizeof(Vertex), 6, mesh.Indices.data(), 5 ) );
+    CHECK( !bvh.Init( &mesh.Vertices[0].Position, sizeof(Vertex), 5, mesh.Indices.data(), 6 ) );
+    CHECK( !bvh.Init( &mesh.Vertices[0].Position, sizeof(f32), 6, mesh.Indices.data(), 6 ) );
+    CHECK( bvh.Init( &mesh.Vertices[0].Position, sizeof(Vertex), 6, mesh.Indices.data(), 6 ) );
+    CHECK( bvh.GetTriangleCount() == 2 );
+
+    asdx::Bvh boxes;
+    asdx::BoundingBox box;
+    CHECK( !boxes.Init( nullptr, 1 ) );
+    CHECK( !boxes.Init( &box, 0 ) );
+}
+
+//-------------------------------------------------------------------------------------
+//      メッシュの BVH の問い合わせを総当たりと比較します.
+//-------------------------------------------------------------------------------------
+void TestMeshBvh( const char* name, const Mesh& mesh, u32 threadCount )
+{
+    auto triangleCount = mesh.GetTriangleCount();
+
+    asdx::MeshBvh bvh;
+    if ( !InitBvh( mesh, threadCount, bvh ) )
+    {
+        fprintf( stderr, "Error : %s : MeshBvh::Init() Failed.\n", name );
+        g_FailCount++;
+        return;
+    }
+
+    CHECK( bvh.GetTriangleCount() == triangleCount );
+
+    // 構築結果はスレッド数によらない.
+    if ( threadCount > 1 )
+    {
+        asdx::MeshBvh single;
+        CHECK( InitBvh( mesh, 1, single ) );
+        CHECK( IsSame( bvh.GetBvh(), single.GetBvh() ) );
+    }
+
+    // 最も近い三角形と遮蔽判定.
+    u32 hitCount   = 0;
+    u32 rayFailure = 0;
+    for(u32 k=0; k<RAY_COUNT; ++k)
+    {
+        asdx::Vector3 origin( Rand() * 80.0f, 20.0f + Rand() * 10.0f, Rand() * 80.0f );
+        asdx::Vector3 target( Rand() * 50.0f, Rand() * 3.0f, Rand() * 50.0f );
+        asdx::Ray ray( origin, asdx::Vector3::Normalize( target - origin ) );
+
+        // 軸に平行なレイ.
+        if ( k < 16 )
+        { ray.direction = ( k & 0x1 ) ? asdx::Vector3( 1.0f, 0.0f, 0.0f ) : asdx::Vector3( 0.0f, -1.0f, 0.0f ); }
+
+        f32 expectedDistance = F32_MAX;
+        u32 expectedIndex    = INVALID_INDEX;
+        for(u32 i=0; i<triangleCount; ++i)
+        {
+            f32 t;
+            if ( ray.Intersects( mesh.GetPosition( i, 0 ), mesh.GetPosition( i, 1 ), mesh.GetPosition( i, 2 ), t ) && t < expectedDistance )
+            {
+                expectedDistance = t;
+                expectedIndex    = i;
+            }
+        }
+
+        f32 distance = 0.0f;
+        u32 index    = INVALID_INDEX;
+        bool hit      = bvh.Intersects( ray, distance, index );
+        bool expected = ( expectedIndex != INVALID_INDEX );
+        if ( hit != expected )
+        {
+            rayFailure++;
+            continue;
+        }
+
+        if ( !hit )
+        {
+            if ( bvh.IsOccluded( ray, 1e6f ) )
+            { rayFailure++; }
+            continue;
+        }
+
+        hitCount++;
+
+        // 同じ距離の三角形が複数あっても，返した三角形までの距離は一致する.
+        f32 t = 0.0f;
+        ray.Intersects( mesh.GetPosition( index, 0 ), mesh.GetPosition( index, 1 ), mesh.GetPosition( index, 2 ), t );
+        if ( distance != expectedDistance || t != distance )
+        { rayFailure++; }
+
+        // 判定する距離は含まない.
+        if ( !bvh.IsOccluded( ray, expectedDistance * 1.5f ) || bvh.IsOccluded( ray, expectedDistance ) )
+        { rayFailure++; }
+    }
+
+    CHECK( rayFailure == 0 );
+    CHECK( hitCount > 0 );
+
+    // 視錐台と境界球. 三角形の境界箱と交差するものを出力する.
+    std::vector<u32> indices( triangleCount + 1 );
+    for(u32 q=0; q<QUERY_COUNT; ++q)
+    {
+        auto view = asdx::Matrix::CreateLookAt(
+            asdx::Vector3( Rand() * 40.0f, 15.0f, Rand() * 40.0f ),
+            asdx::Vector3( Rand() * 10.0f, 0.0f, Rand() * 10.0f ),
+            asdx::Vector3( 0.0f, 1.0f, 0.0f ) );
+        auto proj = asdx::Matrix::CreatePerspectiveFieldOfView( asdx::F_PIDIV4, 16.0f / 9.0f, 1.0f, 60.0f );
+        asdx::BoundingFrustum frustum( view * proj );
+        asdx::BoundingSphere  sphere( asdx::Vector3( Rand() * 40.0f, 0.0f, Rand() * 40.0f ), 5.0f + Rand() * 3.0f );
+
+        std::vector<u32> expectedFrustum;
+        std::vector<u32> expectedSphere;
+        for(u32 i=0; i<triangleCount; ++i)
+        {
+            auto box = mesh.GetBox( i );
+            if ( frustum.Intersects( box ) )
+            { expectedFrustum.push_back( i ); }
+            if ( sphere.Intersects( box ) )
+            { expectedSphere.push_back( i ); }
+        }
+
+        indices[triangleCount] = INVALID_INDEX;
+        auto count = bvh.Intersects( frustum, indices.data() );
+        CHECK( Sorted( indices, count ) == expectedFrustum );
+
+        count = bvh.Intersects( sphere, indices.data() );
+        CHECK( Sorted( indices, count ) == expectedSphere );
+        CHECK( indices[triangleCount] == INVALID_INDEX );
+    }
+
+    printf( "BvhTest : %-5s : %5u triangles, %5u nodes, %4u / %4u rays hit, %u thread(s)\n",
+        name, triangleCount, bvh.GetBvh().GetNodeCount(), hitCount, RAY_COUNT, threadCount );
+}
+
+//-------------------------------------------------------------------------------------
+//      境界箱の BVH のレイ判定を総当たりと比較します.
+//-------------------------------------------------------------------------------------
+void TestBoxBvh()
+{
+    std::vector<asdx::BoundingBox> boxes( 2000 );
+    for(size_t i=0; i<boxes.size(); ++i)
+    {
+        asdx::Vector3 center ( Rand() * 100.0f, Rand() * 100.0f, Rand() * 100.0f );
+        asdx::Vector3 extents( fabsf( Rand() ) * 3.0f + 0.1f, fabsf( Rand() ) * 3.0f + 0.1f, fabsf( Rand() ) * 3.0f + 0.1f );
+        boxes[i] = asdx::BoundingBox( center - extents, center + extents );
+    }
+
+    asdx::Bvh bvh;
+    CHECK( bvh.Init( boxes.data(), u32( boxes.size() ), 2 ) );
+    CHECK( bvh.GetPrimitiveCount() == boxes.size() );
+
+    asdx::Bvh single;
+    CHECK( single.Init( boxes.data(), u32( boxes.size() ), 1 ) );
+    CHECK( IsSame( bvh, single ) );
+
+    u32 rayFailure = 0;
+    for(u32 k=0; k<RAY_COUNT; ++k)
+    {
+        asdx::Ray ray(
+            asdx::Vector3( Rand() * 120.0f, Rand() * 120.0f, Rand() * 120.0f ),
+            asdx::Vector3::Normalize( asdx::Vector3( Rand(), Rand(), Rand() ) ) );
+        if ( k < 10 )
+        { ray.direction = asdx::Vector3( 0.0f, 0.0f, 1.0f ); }
+
+        f32 expectedDistance = F32_MAX;
+        u32 expectedIndex    = INVALID_INDEX;
+        for(u32 i=0; i<u32( boxes.size() ); ++i)
+        {
+            f32 t;
+            if ( ray.Intersects( boxes[i], t ) && t < expectedDistance )
+            {
+                expectedDistance = t;
+                expectedIndex    = i;
+            }
+        }
+
+        f32 distance = 0.0f;
+        u32 index    = INVALID_INDEX;
+        bool hit = bvh.Intersects( ray, distance, index );
+        if ( hit != ( expectedIndex != INVALID_INDEX ) || ( hit && distance != expectedDistance ) )
+        { rayFailure++; }
+    }
+
+    CHECK( rayFailure == 0 );
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------
+int main()
+{
+#if TEST_USE_AVX2 && ( defined(__GNUC__) || defined(__clang__) )
+    if ( !__builtin_cpu_supports( "avx2" ) )
+    {
+        printf( "BvhTest : AVX2 is not supported, skipped.\n" );
+        return SKIP_CODE;
+    }
+#endif
+
+    printf( "BvhTest : ASDX_USE_SIMD = %d, ASDX_USE_AVX2 = %d\n", ASDX_USE_SIMD, TEST_USE_AVX2 );
+
+    TestInvalidInput();
+
+    Mesh mesh;
+    CreateGrid( 40, 30, mesh );
+    TestMeshBvh( "grid", mesh, 1 );
+
+    CreateSoup( 2000, mesh );
+    TestMeshBvh( "soup", mesh, 4 );
+
+    CreateSoup( 3, mesh );
+    TestMeshBvh( "tiny", mesh, 2 );
+
+    TestBoxBvh();
+
+    if ( g_FailCount != 0 )
+    {
+        fprintf( stderr, "BvhTest : %d check(s) failed.\n", g_FailCount );
+        return -1;
+    }
+
+    printf( "BvhTest : OK\n" );
+    return 0;
+}
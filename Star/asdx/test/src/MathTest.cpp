@@ -0,0 +1,645 @@
+﻿//-------------------------------------------------------------------------------------
+// File : MathTest.cpp
+// Desc : Math Module Test.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------
+#include <asdxMath.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------
+// Macros
+//-------------------------------------------------------------------------------------
+#define CHECK( expr )                                                           \
+    do {                                                                        \
+        if ( !( expr ) )                                                        \
+        {                                                                       \
+            fprintf( stderr, "Error : %s(%d) : %s\n", __FILE__, __LINE__, #expr );  \
+            g_FailCount++;                                                      \
+        }                                                                       \
+    } while( 0 )
+
+#if defined(ASDX_USE_AVX2) && ASDX_USE_AVX2
+#define TEST_USE_AVX2   (1)
+#else
+#define TEST_USE_AVX2   (0)
+#endif
+
+
+//-------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------
+const int   SKIP_CODE       = 77;       // CTest の SKIP_RETURN_CODE です.
+const u32   SAMPLE_COUNT    = 4096;     // 実装間で比較する乱数の組の数です.
+const f32   TOLERANCE       = 1e-5f;    // 演算順序が実装ごとに異なる関数の許容誤差です.
+
+
+//-------------------------------------------------------------------------------------
+// Global Variables
+//-------------------------------------------------------------------------------------
+int g_FailCount = 0;
+u32 g_Seed      = 1234567;
+
+
+///////////////////////////////////////////////////////////////////////////////////////
+// SECTION enum
+///////////////////////////////////////////////////////////////////////////////////////
+enum SECTION
+{
+    SECTION_MULTIPLY = 0,           //!< Matrix::Multiply() です.
+    SECTION_MULTIPLY_TRANSPOSE,     //!< Matrix::MultiplyTranspose() です.
+    SECTION_TRANSFORM,              //!< Vector2/3/4 の Transform(), TransformNormal(), TransformCoord() です.
+    SECTION_SLERP,                  //!< Quaternion::Slerp() です.
+    SECTION_INVERT,                 //!< Matrix::Invert() です.
+    SECTION_QUATERNION_MULTIPLY,    //!< Quaternion::Multiply() です.
+    NUM_SECTION
+};
+
+const char* SECTION_NAMES[NUM_SECTION] = {
+    "Matrix::Multiply",
+    "Matrix::MultiplyTranspose",
+    "Transform",
+    "Quaternion::Slerp",
+    "Matrix::Invert",
+    "Quaternion::Multiply",
+};
+
+// 演算順序がスカラー実装と同じものはビット単位で一致させる.
+const bool SECTION_EXACT[NUM_SECTION] = {
+    true, true, true, true, false, false
+};
+
+
+//-------------------------------------------------------------------------------------
+//      [-1, 1) の乱数を取得します.
+//-------------------------------------------------------------------------------------
+f32 Rand()
+{
+    g_Seed = g_Seed * 1664525u + 1013904223u;
+    return f32( ( g_Seed >> 8 ) & 0xffff ) / 32768.0f - 1.0f;
+}
+
+//-------------------------------------------------------------------------------------
+//      正則な乱数行列を取得します.
+//-------------------------------------------------------------------------------------
+asdx::Matrix RandMatrix()
+{
+    asdx::Matrix m;
+    for(u32 i=0; i<16; ++i)
+    { m.m[i / 4][i % 4] = Rand() * 0.5f; }
+
+    m._11 += 3.0f;
+    m._22 += 3.0f;
+    m._33 += 3.0f;
+    m._44 += 3.0f;
+    return m;
+}
+
+//-------------------------------------------------------------------------------------
+//      正規化した乱数四元数を取得します.
+//-------------------------------------------------------------------------------------
+asdx::Quaternion RandQuaternion()
+{
+    asdx::Quaternion q( Rand(), Rand(), Rand(), Rand() );
+    return asdx::Quaternion::Normalize( q );
+}
+
+//-------------------------------------------------------------------------------------
+//      要素が全て異なる整数の行列を取得します. 小さな整数の積和は丸め誤差が出ません.
+//-------------------------------------------------------------------------------------
+asdx::Matrix IntegerMatrix()
+{
+    return asdx::Matrix(
+         1.0f,  2.0f,  3.0f,  4.0f,
+         5.0f,  6.0f,  7.0f,  8.0f,
+         9.0f, 10.0f, 11.0f, 12.0f,
+        13.0f, 14.0f, 15.0f, 16.0f );
+}
+
+//-------------------------------------------------------------------------------------
+//      四元数が一致するかチェックします.
+//-------------------------------------------------------------------------------------
+bool IsNear( const asdx::Quaternion& a, double x, double y, double z, double w, double tolerance )
+{
+    return fabs( a.x - x ) <= tolerance
+        && fabs( a.y - y ) <= tolerance
+        && fabs( a.z - z ) <= tolerance
+        && fabs( a.w - w ) <= tolerance;
+}
+
+//-------------------------------------------------------------------------------------
+//      行列の転置をテストします.
+//-------------------------------------------------------------------------------------
+void TestTranspose()
+{
+    auto m = IntegerMatrix();
+
+    asdx::Matrix r0 = asdx::Matrix::Transpose( m );
+    asdx::Matrix r1;
+    asdx::Matrix::Transpose( m, r1 );
+
+    for(u32 i=0; i<4; ++i)
+    {
+        for(u32 j=0; j<4; ++j)
+        {
+            CHECK( r0.m[i][j] == m.m[j][i] );
+            CHECK( r1.m[i][j] == m.m[j][i] );
+        }
+    }
+
+    // スカラー実装で _34 と _43 を取り違えていた.
+    CHECK( r1._34 == m._43 );
+    CHECK( r1._43 == m._34 );
+
+    // 乗算結果の転置. m * m は対称行列ではないので転置の有無が区別できる.
+    // スカラー実装の戻り値版は転置していなかった.
+    asdx::Matrix mm = asdx::Matrix::Multiply( m, m );
+    asdx::Matrix t0 = asdx::Matrix::MultiplyTranspose( m, m );
+    asdx::Matrix t1;
+    asdx::Matrix::MultiplyTranspose( m, m, t1 );
+    CHECK( mm._12 != mm._21 );
+    for(u32 i=0; i<4; ++i)
+    {
+        for(u32 j=0; j<4; ++j)
+        {
+            CHECK( t0.m[i][j] == mm.m[j][i] );
+            CHECK( t1.m[i][j] == mm.m[j][i] );
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------
+//      ベクトルの変換をテストします.
+//-------------------------------------------------------------------------------------
+void TestTransform()
+{
+    auto m = IntegerMatrix();
+
+    // 法線は平行移動を含めない. スカラー実装で y, z の列を取り違えていた.
+    asdx::Vector3 n( 1.0f, -2.0f, 3.0f );
+    asdx::Vector3 n0 = asdx::Vector3::TransformNormal( n, m );
+    asdx::Vector3 n1;
+    asdx::Vector3::TransformNormal( n, m, n1 );
+    CHECK( n0.x == 1.0f * 1.0f - 2.0f * 5.0f + 3.0f *  9.0f );
+    CHECK( n0.y == 1.0f * 2.0f - 2.0f * 6.0f + 3.0f * 10.0f );
+    CHECK( n0.z == 1.0f * 3.0f - 2.0f * 7.0f + 3.0f * 11.0f );
+    CHECK( n1.x == n0.x && n1.y == n0.y && n1.z == n0.z );
+
+    // w は行列の4列目で変換する. スカラー実装で w の列を取り違えていた.
+    asdx::Vector4 v( 1.0f, -2.0f, 3.0f, -1.0f );
+    asdx::Vector4 v0 = asdx::Vector4::Transform( v, m );
+    asdx::Vector4 v1;
+    asdx::Vector4::Transform( v, m, v1 );
+    CHECK( v0.x == 1.0f * 1.0f - 2.0f * 5.0f + 3.0f *  9.0f - 13.0f );
+    CHECK( v0.y == 1.0f * 2.0f - 2.0f * 6.0f + 3.0f * 10.0f - 14.0f );
+    CHECK( v0.z == 1.0f * 3.0f - 2.0f * 7.0f + 3.0f * 11.0f - 15.0f );
+    CHECK( v0.w == 1.0f * 4.0f - 2.0f * 8.0f + 3.0f * 12.0f - 16.0f );
+    CHECK( v1.x == v0.x && v1.y == v0.y && v1.z == v0.z && v1.w == v0.w );
+
+    // w = 1 への射影は4列目で割る. w を 2 の累乗にして割り算も丸めないようにする.
+    asdx::Matrix p = m;
+    p._14 = 0.0f;
+    p._24 = 0.0f;
+    p._34 = 1.0f;
+    p._44 = 1.0f;
+
+    asdx::Vector3 c( 1.0f, -2.0f, 3.0f );
+    asdx::Vector3 c0 = asdx::Vector3::TransformCoord( c, p );
+    asdx::Vector3 c1;
+    asdx::Vector3::TransformCoord( c, p, c1 );
+    CHECK( c0.x == ( 1.0f * 1.0f - 2.0f * 5.0f + 3.0f *  9.0f + 13.0f ) / 4.0f );
+    CHECK( c0.y == ( 1.0f * 2.0f - 2.0f * 6.0f + 3.0f * 10.0f + 14.0f ) / 4.0f );
+    CHECK( c0.z == ( 1.0f * 3.0f - 2.0f * 7.0f + 3.0f * 11.0f + 15.0f ) / 4.0f );
+    CHECK( c1.x == c0.x && c1.y == c0.y && c1.z == c0.z );
+}
+
+//-------------------------------------------------------------------------------------
+//      四元数の積をテストします.
+//-------------------------------------------------------------------------------------
+void TestQuaternionMultiply()
+{
+    // ハミルトン積 i * j = k, j * k = i, k * i = j, j * i = -k, i * k = -j.
+    asdx::Quaternion i( 1.0f, 0.0f, 0.0f, 0.0f );
+    asdx::Quaternion j( 0.0f, 1.0f, 0.0f, 0.0f );
+    asdx::Quaternion k( 0.0f, 0.0f, 1.0f, 0.0f );
+    CHECK( IsNear( asdx::Quaternion::Multiply( i, j ), 0.0,  0.0,  1.0, 0.0, 0.0 ) );
+    CHECK( IsNear( asdx::Quaternion::Multiply( j, k ), 1.0,  0.0,  0.0, 0.0, 0.0 ) );
+    CHECK( IsNear( asdx::Quaternion::Multiply( k, i ), 0.0,  1.0,  0.0, 0.0, 0.0 ) );
+    CHECK( IsNear( asdx::Quaternion::Multiply( j, i ), 0.0,  0.0, -1.0, 0.0, 0.0 ) );
+    CHECK( IsNear( asdx::Quaternion::Multiply( i, k ), 0.0, -1.0,  0.0, 0.0, 0.0 ) );
+
+    // 整数の四元数は全ての成分が丸めずに求まる. スカラー実装で y の外積の符号が逆だった.
+    asdx::Quaternion a(  1.0f, 2.0f,  3.0f, 4.0f );
+    asdx::Quaternion b( -5.0f, 6.0f, -7.0f, 8.0f );
+    double x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+    double y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+    double z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+    double w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+
+    asdx::Quaternion r0 = asdx::Quaternion::Multiply( a, b );
+    asdx::Quaternion r1;
+    asdx::Quaternion::Multiply( a, b, r1 );
+    asdx::Quaternion r2 = a * b;
+    asdx::Quaternion r3 = a;
+    r3 *= b;
+    CHECK( IsNear( r0, x, y, z, w, 0.0 ) );
+    CHECK( IsNear( r1, x, y, z, w, 0.0 ) );
+    CHECK( IsNear( r2, x, y, z, w, 0.0 ) );
+    CHECK( IsNear( r3, x, y, z, w, 0.0 ) );
+}
+
+//-------------------------------------------------------------------------------------
+//      四元数の球面線形補間をテストします.
+//-------------------------------------------------------------------------------------
+void TestSlerp()
+{
+    const double tolerance = 1e-6;
+
+    // Z軸周りの 0 度と 90 度の中間は 45 度.
+    auto s = sin( asdx::F_PIDIV4 * 0.5 );
+    auto c = cos( asdx::F_PIDIV4 * 0.5 );
+    asdx::Quaternion a( 0.0f, 0.0f, 0.0f, 1.0f );
+    asdx::Quaternion b( 0.0f, 0.0f, sinf( asdx::F_PIDIV4 ), cosf( asdx::F_PIDIV4 ) );
+    CHECK( IsNear( asdx::Quaternion::Slerp( a, b, 0.5f ), 0.0, 0.0, s, c, tolerance ) );
+
+    asdx::Quaternion r;
+    asdx::Quaternion::Slerp( a, b, 0.5f, r );
+    CHECK( IsNear( r, 0.0, 0.0, s, c, tolerance ) );
+
+    // 符号を反転した四元数は同じ回転なので，短い方の経路で補間する.
+    asdx::Quaternion nb( -b.x, -b.y, -b.z, -b.w );
+    CHECK( IsNear( asdx::Quaternion::Slerp( a, nb, 0.5f ), 0.0, 0.0, s, c, tolerance ) );
+    asdx::Quaternion::Slerp( a, nb, 0.5f, r );
+    CHECK( IsNear( r, 0.0, 0.0, s, c, tolerance ) );
+
+    // 端点.
+    CHECK( IsNear( asdx::Quaternion::Slerp( a, b, 0.0f ), a.x, a.y, a.z, a.w, 0.0 ) );
+    CHECK( IsNear( asdx::Quaternion::Slerp( a, b, 1.0f ), b.x, b.y, b.z, b.w, 0.0 ) );
+
+    // 任意の補間係数で倍精度の参照実装と比較する.
+    g_Seed = 7654321;
+    for(u32 n=0; n<256; ++n)
+    {
+        auto q0 = RandQuaternion();
+        auto q1 = RandQuaternion();
+        auto t  = 0.5f + 0.49f * Rand();
+
+        double dot   = double( q0.x ) * q1.x + double( q0.y ) * q1.y + double( q0.z ) * q1.z + double( q0.w ) * q1.w;
+        double sign  = ( dot < 0.0 ) ? -1.0 : 1.0;
+        double omega = acos( fabs( dot ) );
+        double k0    = sin( ( 1.0 - t ) * omega ) / sin( omega );
+        double k1    = sign * sin( t * omega ) / sin( omega );
+
+        CHECK( IsNear( asdx::Quaternion::Slerp( q0, q1, t ),
+            k0 * q0.x + k1 * q1.x,
+            k0 * q0.y + k1 * q1.y,
+            k0 * q0.z + k1 * q1.z,
+            k0 * q0.w + k1 * q1.w, 1e-4 ) );
+    }
+}
+
+//-------------------------------------------------------------------------------------
+//      逆行列をテストします.
+//-------------------------------------------------------------------------------------
+void TestInvert()
+{
+    g_Seed = 42;
+    f32 maxError = 0.0f;
+    for(u32 n=0; n<256; ++n)
+    {
+        auto m = RandMatrix();
+        auto p = asdx::Matrix::Multiply( m, asdx::Matrix::Invert( m ) );
+
+        for(u32 r=0; r<4; ++r)
+        {
+            for(u32 c=0; c<4; ++c)
+            {
+                auto error = fabsf( p.m[r][c] - ( ( r == c ) ? 1.0f : 0.0f ) );
+                if ( error > maxError )
+                { maxError = error; }
+            }
+        }
+    }
+
+    CHECK( maxError < TOLERANCE );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// StreamVertex structure
+///////////////////////////////////////////////////////////////////////////////////////
+struct StreamVertex
+{
+    asdx::Vector3   Position;   //!< 位置座標です.
+    asdx::Vector3   Normal;     //!< 法線ベクトルです.
+    asdx::Vector3   Tangent;    //!< 接線ベクトルです.
+    asdx::Vector2   TexCoord;   //!< テクスチャ座標です.
+};
+
+//-------------------------------------------------------------------------------------
+//      ベクトルの配列がビット単位で一致するかチェックします.
+//-------------------------------------------------------------------------------------
+template< typename T >
+bool IsSame( const T* pA, u32 strideA, const T* pB, u32 strideB, u32 count )
+{
+    for(u32 i=0; i<count; ++i)
+    {
+        auto a = reinterpret_cast<const T*>( reinterpret_cast<const u8*>( pA ) + size_t( strideA ) * i );
+        auto b = reinterpret_cast<const T*>( reinterpret_cast<const u8*>( pB ) + size_t( strideB ) * i );
+        if ( memcmp( a, b, sizeof(T) ) != 0 )
+        { return false; }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+//      ベクトルの配列の一括変換をテストします.
+//
+//      積和を FMA に縮約しないビルドでは，1要素ずつの変換とビット単位で一致します.
+//-------------------------------------------------------------------------------------
+void TestStream()
+{
+    typedef void (*Func3)( const asdx::Vector3&, const asdx::Matrix&, asdx::Vector3& );
+    typedef void (*Stream3)( const asdx::Vector3*, u32, asdx::Vector3*, u32, u32, const asdx::Matrix& );
+    typedef void (*Func2)( const asdx::Vector2&, const asdx::Matrix&, asdx::Vector2& );
+    typedef void (*Stream2)( const asdx::Vector2*, u32, asdx::Vector2*, u32, u32, const asdx::Matrix& );
+
+    const Func3   func3  [3] = { &asdx::Vector3::Transform,       &asdx::Vector3::TransformNormal,       &asdx::Vector3::TransformCoord };
+    const Stream3 stream3[3] = { &asdx::Vector3::TransformStream, &asdx::Vector3::TransformNormalStream, &asdx::Vector3::TransformCoordStream };
+    const Func2   func2  [3] = { &asdx::Vector2::Transform,       &asdx::Vector2::TransformNormal,       &asdx::Vector2::TransformCoord };
+    const Stream2 stream2[3] = { &asdx::Vector2::TransformStream, &asdx::Vector2::TransformNormalStream, &asdx::Vector2::TransformCoordStream };
+
+    const u32 STRIDE  = sizeof(StreamVertex);
+    const u32 COUNTS[] = { 0, 1, 3, 4, 5, 7, 8, 9, 1001 };
+
+    g_Seed = 99;
+    auto m = RandMatrix();
+
+    for(u32 c=0; c<sizeof(COUNTS) / sizeof(COUNTS[0]); ++c)
+    {
+        auto count = COUNTS[c];
+
+        // 末尾の1要素は書き換えられないことを確認するために使う.
+        std::vector<StreamVertex> vertices( count + 1 );
+        for(size_t i=0; i<vertices.size(); ++i)
+        {
+            vertices[i].Position = asdx::Vector3( Rand(), Rand(), Rand() );
+            vertices[i].Normal   = asdx::Vector3( Rand(), Rand(), Rand() );
+            vertices[i].Tangent  = asdx::Vector3( Rand(), Rand(), Rand() );
+            vertices[i].TexCoord = asdx::Vector2( Rand(), Rand() );
+        }
+
+        for(u32 k=0; k<3; ++k)
+        {
+            std::vector<asdx::Vector3> expected3( count );
+            std::vector<asdx::Vector2> expected2( count );
+            for(u32 i=0; i<count; ++i)
+            {
+                func3[k]( vertices[i].Position, m, expected3[i] );
+                func2[k]( vertices[i].TexCoord, m, expected2[i] );
+            }
+
+            // 詰めた配列への書き出し.
+            std::vector<asdx::Vector3> out3( count );
+            std::vector<asdx::Vector2> out2( count );
+            stream3[k]( &vertices[0].Position, STRIDE, out3.data(), sizeof(asdx::Vector3), count, m );
+            stream2[k]( &vertices[0].TexCoord, STRIDE, out2.data(), sizeof(asdx::Vector2), count, m );
+            CHECK( IsSame( out3.data(), sizeof(asdx::Vector3), expected3.data(), sizeof(asdx::Vector3), count ) );
+            CHECK( IsSame( out2.data(), sizeof(asdx::Vector2), expected2.data(), sizeof(asdx::Vector2), count ) );
+
+            // 頂点の中での変換. 他のメンバーと範囲外の頂点は書き換えない.
+            auto work = vertices;
+            stream3[k]( &work[0].Position, STRIDE, &work[0].Position, STRIDE, count, m );
+            CHECK( IsSame( &work[0].Position, STRIDE, expected3.data(), sizeof(asdx::Vector3), count ) );
+            CHECK( IsSame( &work[0].Normal,   STRIDE, &vertices[0].Normal,   STRIDE, count + 1 ) );
+            CHECK( IsSame( &work[0].Tangent,  STRIDE, &vertices[0].Tangent,  STRIDE, count + 1 ) );
+            CHECK( IsSame( &work[0].TexCoord, STRIDE, &vertices[0].TexCoord, STRIDE, count + 1 ) );
+            CHECK( IsSame( &work[count].Position, STRIDE, &vertices[count].Position, STRIDE, 1 ) );
+
+            work = vertices;
+            stream2[k]( &work[0].TexCoord, STRIDE, &work[0].TexCoord, STRIDE, count, m );
+            CHECK( IsSame( &work[0].TexCoord, STRIDE, expected2.data(), sizeof(asdx::Vector2), count ) );
+            CHECK( IsSame( &work[0].Position, STRIDE, &vertices[0].Position, STRIDE, count + 1 ) );
+            CHECK( IsSame( &work[count].TexCoord, STRIDE, &vertices[count].TexCoord, STRIDE, 1 ) );
+        }
+
+        std::vector<asdx::Vector4> src4( count );
+        std::vector<asdx::Vector4> expected4( count );
+        for(u32 i=0; i<count; ++i)
+        {
+            src4[i] = asdx::Vector4( Rand(), Rand(), Rand(), Rand() );
+            asdx::Vector4::Transform( src4[i], m, expected4[i] );
+        }
+
+        std::vector<asdx::Vector4> out4( count );
+        asdx::Vector4::TransformStream( src4.data(), sizeof(asdx::Vector4), out4.data(), sizeof(asdx::Vector4), count, m );
+        CHECK( IsSame( out4.data(), sizeof(asdx::Vector4), expected4.data(), sizeof(asdx::Vector4), count ) );
+
+        asdx::Vector4::TransformStream( src4.data(), sizeof(asdx::Vector4), src4.data(), sizeof(asdx::Vector4), count, m );
+        CHECK( IsSame( src4.data(), sizeof(asdx::Vector4), expected4.data(), sizeof(asdx::Vector4), count ) );
+    }
+
+    // 間隔 0 の入力は1要素を全ての出力に変換する.
+    {
+        asdx::Vector3 src( Rand(), Rand(), Rand() );
+        asdx::Vector3 expected;
+        asdx::Vector3::TransformCoord( src, m, expected );
+
+        std::vector<asdx::Vector3> out( 9 );
+        asdx::Vector3::TransformCoordStream( &src, 0, out.data(), sizeof(asdx::Vector3), u32( out.size() ), m );
+        CHECK( IsSame( out.data(), sizeof(asdx::Vector3), &expected, 0, u32( out.size() ) ) );
+    }
+}
+
+//-------------------------------------------------------------------------------------
+//      実装間で比較する結果を求めます.
+//-------------------------------------------------------------------------------------
+void Compute( std::vector<f32> ( &results )[NUM_SECTION] )
+{
+    auto append = []( std::vector<f32>& dst, const f32* pSrc, u32 count )
+    { dst.insert( dst.end(), pSrc, pSrc + count ); };
+
+    g_Seed = 1234567;
+    for(u32 n=0; n<SAMPLE_COUNT; ++n)
+    {
+        auto a = RandMatrix();
+        auto b = RandMatrix();
+
+        asdx::Matrix m0 = asdx::Matrix::Multiply( a, b );
+        asdx::Matrix m1;
+        asdx::Matrix::Multiply( a, b, m1 );
+        asdx::Matrix m2 = a * b;
+        asdx::Matrix m3 = a;
+        m3 *= b;
+        append( results[SECTION_MULTIPLY], &m0._11, 16 );
+        append( results[SECTION_MULTIPLY], &m1._11, 16 );
+        append( results[SECTION_MULTIPLY], &m2._11, 16 );
+        append( results[SECTION_MULTIPLY], &m3._11, 16 );
+
+        asdx::Matrix t0 = asdx::Matrix::MultiplyTranspose( a, b );
+        asdx::Matrix t1;
+        asdx::Matrix::MultiplyTranspose( a, b, t1 );
+        append( results[SECTION_MULTIPLY_TRANSPOSE], &t0._11, 16 );
+        append( results[SECTION_MULTIPLY_TRANSPOSE], &t1._11, 16 );
+
+        asdx::Matrix i0 = asdx::Matrix::Invert( a );
+        asdx::Matrix i1;
+        asdx::Matrix::Invert( a, i1 );
+        append( results[SECTION_INVERT], &i0._11, 16 );
+        append( results[SECTION_INVERT], &i1._11, 16 );
+
+        asdx::Vector2 v2( Rand(), Rand() );
+        asdx::Vector3 v3( Rand(), Rand(), Rand() );
+        asdx::Vector4 v4( Rand(), Rand(), Rand(), Rand() );
+        asdx::Vector2 r2[3] = {
+            asdx::Vector2::Transform( v2, a ),
+            asdx::Vector2::TransformNormal( v2, a ),
+            asdx::Vector2::TransformCoord( v2, a ),
+        };
+        asdx::Vector3 r3[3] = {
+            asdx::Vector3::Transform( v3, a ),
+            asdx::Vector3::TransformNormal( v3, a ),
+            asdx::Vector3::TransformCoord( v3, a ),
+        };
+        asdx::Vector4 r4 = asdx::Vector4::Transform( v4, a );
+        for(u32 k=0; k<3; ++k)
+        {
+            append( results[SECTION_TRANSFORM], &r2[k].x, 2 );
+            append( results[SECTION_TRANSFORM], &r3[k].x, 3 );
+        }
+        append( results[SECTION_TRANSFORM], &r4.x, 4 );
+
+        // 半分は内積が負になるようにして，短い経路への反転も比較する.
+        auto q0 = RandQuaternion();
+        auto q1 = RandQuaternion();
+        if ( n & 1 )
+        { q1 = asdx::Quaternion( -q1.x, -q1.y, -q1.z, -q1.w ); }
+
+        asdx::Quaternion s0 = asdx::Quaternion::Slerp( q0, q1, 0.3f );
+        asdx::Quaternion s1;
+        asdx::Quaternion::Slerp( q0, q1, 0.7f, s1 );
+        append( results[SECTION_SLERP], &s0.x, 4 );
+        append( results[SECTION_SLERP], &s1.x, 4 );
+
+        asdx::Quaternion p0 = asdx::Quaternion::Multiply( q0, q1 );
+        asdx::Quaternion p1 = q0 * q1;
+        append( results[SECTION_QUATERNION_MULTIPLY], &p0.x, 4 );
+        append( results[SECTION_QUATERNION_MULTIPLY], &p1.x, 4 );
+    }
+}
+
+//-------------------------------------------------------------------------------------
+//      結果をファイルに書き出します.
+//-------------------------------------------------------------------------------------
+bool Write( const char* path, const std::vector<f32> ( &results )[NUM_SECTION] )
+{
+    FILE* pFile = fopen( path, "wb" );
+    if ( pFile == nullptr )
+    { return false; }
+
+    auto ok = true;
+    for(u32 i=0; i<NUM_SECTION; ++i)
+    { ok &= ( fwrite( results[i].data(), sizeof(f32), results[i].size(), pFile ) == results[i].size() ); }
+
+    fclose( pFile );
+    return ok;
+}
+
+//-------------------------------------------------------------------------------------
+//      ファイルに書き出した結果と比較します.
+//-------------------------------------------------------------------------------------
+bool Compare( const char* path, const std::vector<f32> ( &results )[NUM_SECTION] )
+{
+    FILE* pFile = fopen( path, "rb" );
+    if ( pFile == nullptr )
+    { return false; }
+
+    auto ok = true;
+    for(u32 i=0; i<NUM_SECTION; ++i)
+    {
+        std::vector<f32> expected( results[i].size() );
+        if ( fread( expected.data(), sizeof(f32), expected.size(), pFile ) != expected.size() )
+        {
+            ok = false;
+            break;
+        }
+
+        size_t exact = 0;
+        f32 maxError = 0.0f;
+        for(size_t j=0; j<expected.size(); ++j)
+        {
+            if ( memcmp( &results[i][j], &expected[j], sizeof(f32) ) == 0 )
+            {
+                exact++;
+                continue;
+            }
+
+            auto scale = ( fabsf( expected[j] ) > 1.0f ) ? fabsf( expected[j] ) : 1.0f;
+            auto error = fabsf( results[i][j] - expected[j] ) / scale;
+            if ( !( error <= maxError ) )
+            { maxError = error; }
+        }
+
+        auto passed = ( SECTION_EXACT[i] ) ? ( exact == expected.size() ) : ( maxError <= TOLERANCE );
+        printf( "MathTest : %-26s : bit exact %6zu / %6zu, max relative error = %e, %s\n",
+            SECTION_NAMES[i], exact, expected.size(), maxError, ( passed ) ? "OK" : "NG" );
+        ok &= passed;
+    }
+
+    fclose( pFile );
+    return ok;
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//
+//      MathTest write <path>   : 結果を書き出します. スカラー実装で参照結果を作ります.
+//      MathTest compare <path> : 参照結果と比較します.
+//-------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+#if TEST_USE_AVX2 && ( defined(__GNUC__) || defined(__clang__) )
+    if ( !__builtin_cpu_supports( "avx2" ) )
+    {
+        printf( "MathTest : AVX2 is not supported, skipped.\n" );
+        return SKIP_CODE;
+    }
+#endif
+
+    printf( "MathTest : ASDX_USE_SIMD = %d, ASDX_USE_AVX2 = %d\n", ASDX_USE_SIMD, TEST_USE_AVX2 );
+
+    TestTranspose();
+    TestTransform();
+    TestQuaternionMultiply();
+    TestSlerp();
+    TestInvert();
+    TestStream();
+
+    std::vector<f32> results[NUM_SECTION];
+    Compute( results );
+
+    if ( argc > 2 && strcmp( argv[1], "write" ) == 0 )
+    { CHECK( Write( argv[2], results ) ); }
+    else if ( argc > 2 && strcmp( argv[1], "compare" ) == 0 )
+    { CHECK( Compare( argv[2], results ) ); }
+
+    if ( g_FailCount != 0 )
+    {
+        fprintf( stderr, "MathTest : %d check(s) failed.\n", g_FailCount );
+        return -1;
+    }
+
+    printf( "MathTest : OK\n" );
+    return 0;
+}
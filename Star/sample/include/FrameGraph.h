@@ -0,0 +1,404 @@
+﻿//------------------------------------------------------------------------------
+// File : FrameGraph.h
+// Desc : Post Process Frame Graph.
+// Copyright(c) Project Asura. All right reserved.
+//------------------------------------------------------------------------------
+
+#ifndef __FRAME_GRAPH_H__
+#define __FRAME_GRAPH_H__
+
+//------------------------------------------------------------------------------
+// Include
+//------------------------------------------------------------------------------
+#include "RenderTargetPool.h"
+#include <vector>
+
+
+//-------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------
+static const u32 FRAME_GRAPH_MAX_INPUT_COUNT    = 8;    //!< パスの入力の最大数です.
+static const u32 FRAME_GRAPH_MAX_OUTPUT_COUNT   = 4;    //!< パスの出力の最大数です.
+static const u32 FRAME_GRAPH_MAX_CONSTANT_COUNT = 4;    //!< パスの定数バッファの最大数です.
+static const u32 FRAME_GRAPH_MAX_SAMPLER_COUNT  = 4;    //!< パスのサンプラーの最大数です.
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// FRAME_GRAPH_COMMAND enum
+////////////////////////////////////////////////////////////////////////////////////////
+enum FRAME_GRAPH_COMMAND
+{
+    FRAME_GRAPH_COMMAND_SET_RENDER_TARGETS = 0,     //!< レンダーターゲットと深度ステンシルを設定します.
+    FRAME_GRAPH_COMMAND_CLEAR_RENDER_TARGET,        //!< レンダーターゲットをクリアします.
+    FRAME_GRAPH_COMMAND_CLEAR_DEPTH_STENCIL,        //!< 深度ステンシルをクリアします.
+    FRAME_GRAPH_COMMAND_SET_VIEWPORT,               //!< ビューポートを設定します.
+    FRAME_GRAPH_COMMAND_SET_VERTEX_SHADER,          //!< 頂点シェーダを設定します.
+    FRAME_GRAPH_COMMAND_SET_PIXEL_SHADER,           //!< ピクセルシェーダを設定します.
+    FRAME_GRAPH_COMMAND_SET_BLEND_STATE,            //!< ブレンドステートを設定します.
+    FRAME_GRAPH_COMMAND_SET_RASTERIZER_STATE,       //!< ラスタライザーステートを設定します.
+    FRAME_GRAPH_COMMAND_SET_DEPTH_STENCIL_STATE,    //!< 深度ステンシルステートを設定します.
+    FRAME_GRAPH_COMMAND_SET_SHADER_RESOURCE,        //!< シェーダリソースビューを設定します.
+    FRAME_GRAPH_COMMAND_SET_SAMPLER,                //!< サンプラーを設定します.
+    FRAME_GRAPH_COMMAND_SET_CONSTANT_BUFFER,        //!< 定数バッファを設定します.
+    FRAME_GRAPH_COMMAND_DRAW,                       //!< フルスクリーン矩形を描画します.
+
+    NUM_FRAME_GRAPH_COMMAND
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// FrameGraphCommand structure
+////////////////////////////////////////////////////////////////////////////////////////
+struct FrameGraphCommand
+{
+    FRAME_GRAPH_COMMAND     Type;                                   //!< コマンドの種類です.
+    u32                     Pass;                                   //!< コマンドを発行したパスの番号です.
+    u32                     Slot;                                   //!< スロット番号, または設定するレンダーターゲット数です.
+    void*                   pObject[FRAME_GRAPH_MAX_OUTPUT_COUNT];  //!< 設定するオブジェクトです. pObject[0] 以外はレンダーターゲットの設定で使います.
+    void*                   pDepth;                                 //!< 深度ステンシルビューです.
+    u32                     Value[2];                               //!< ビューポートの縦横, またはステンシル参照値です.
+    float                   Color[4];                               //!< クリアカラーです.
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// IFrameGraphBackend interface
+////////////////////////////////////////////////////////////////////////////////////////
+struct IFrameGraphBackend
+{
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    virtual ~IFrameGraphBackend()
+    { /* DO_NOTHING */ }
+
+    //----------------------------------------------------------------------------------
+    //! @brief      プールが割り当てたレンダーターゲットのレンダーターゲットビューを取得します.
+    //----------------------------------------------------------------------------------
+    virtual void* GetRenderTargetView( void* pTarget ) = 0;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      プールが割り当てたレンダーターゲットのシェーダリソースビューを取得します.
+    //----------------------------------------------------------------------------------
+    virtual void* GetShaderResourceView( void* pTarget ) = 0;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コマンドリストの実行を開始します.
+    //----------------------------------------------------------------------------------
+    virtual void Begin() = 0;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コマンドを実行します.
+    //----------------------------------------------------------------------------------
+    virtual void Execute( const FrameGraphCommand& command ) = 0;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コマンドリストの実行を終了します.
+    //----------------------------------------------------------------------------------
+    virtual void End() = 0;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// RecordingFrameGraphBackend class
+////////////////////////////////////////////////////////////////////////////////////////
+class RecordingFrameGraphBackend : public IFrameGraphBackend
+{
+    //==================================================================================
+    // list of friend classes and methods.
+    //==================================================================================
+    /* NOTHING */
+
+public:
+    //==================================================================================
+    // public variables.
+    //==================================================================================
+    /* NOTHING */
+
+    //==================================================================================
+    // public methods.
+    //==================================================================================
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //----------------------------------------------------------------------------------
+    RecordingFrameGraphBackend();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    ~RecordingFrameGraphBackend();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      レンダーターゲットそのものをビューとして返却します.
+    //----------------------------------------------------------------------------------
+    void* GetRenderTargetView( void* pTarget );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      レンダーターゲットそのものをビューとして返却します.
+    //----------------------------------------------------------------------------------
+    void* GetShaderResourceView( void* pTarget );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      記録済みのコマンドを破棄します.
+    //----------------------------------------------------------------------------------
+    void Begin();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コマンドを記録します.
+    //----------------------------------------------------------------------------------
+    void Execute( const FrameGraphCommand& command );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      記録を終了します.
+    //----------------------------------------------------------------------------------
+    void End();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      記録したコマンドを取得します.
+    //----------------------------------------------------------------------------------
+    const std::vector<FrameGraphCommand>& GetCommands() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      記録したコマンドのうち，指定した種類の数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetCount( FRAME_GRAPH_COMMAND type ) const;
+
+private:
+    //==================================================================================
+    // private variables.
+    //==================================================================================
+    std::vector<FrameGraphCommand>  m_Commands;     //!< 記録したコマンドです.
+
+    //==================================================================================
+    // private methods.
+    //==================================================================================
+    RecordingFrameGraphBackend  ( const RecordingFrameGraphBackend& );  // アクセス禁止.
+    void operator =             ( const RecordingFrameGraphBackend& );  // アクセス禁止.
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// FrameGraph class
+////////////////////////////////////////////////////////////////////////////////////////
+class FrameGraph
+{
+    //==================================================================================
+    // list of friend classes and methods.
+    //==================================================================================
+    /* NOTHING */
+
+public:
+    //==================================================================================
+    // public variables.
+    //==================================================================================
+    typedef u32 Resource;                               //!< リソースのハンドルです.
+    static const Resource INVALID_RESOURCE = 0xffffffff;    //!< 無効なリソースです.
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // PassDesc structure
+    //////////////////////////////////////////////////////////////////////////////////
+    struct PassDesc
+    {
+        const char* Name;                                               //!< パスの名前です.
+        Resource    Input [FRAME_GRAPH_MAX_INPUT_COUNT];                //!< シェーダリソースのスロットごとの入力です.
+        Resource    Output[FRAME_GRAPH_MAX_OUTPUT_COUNT];               //!< レンダーターゲットのスロットごとの出力です.
+        bool        ClearOutput;                                        //!< 描画前に出力をクリアするかどうか. false なら前の内容に描画します.
+        float       ClearColor[4];                                      //!< クリアカラーです.
+        bool        ClearDepth;                                         //!< 描画前に深度ステンシルをクリアするかどうか.
+        void*       pVS;                                                //!< 頂点シェーダです.
+        void*       pPS;                                                //!< ピクセルシェーダです.
+        void*       pConstantBuffer[FRAME_GRAPH_MAX_CONSTANT_COUNT];    //!< スロットごとの定数バッファです.
+        void*       pSampler[FRAME_GRAPH_MAX_SAMPLER_COUNT];            //!< スロットごとのサンプラーです.
+        void*       pBlendState;                                        //!< ブレンドステートです.
+        void*       pRasterizerState;                                   //!< ラスタライザーステートです.
+        void*       pDepthStencilState;                                 //!< 深度ステンシルステートです.
+        u32         StencilRef;                                         //!< ステンシル参照値です.
+
+        //-----------------------------------------------------------------------------
+        //! @brief      コンストラクタです.
+        //-----------------------------------------------------------------------------
+        PassDesc();
+    };
+
+    //==================================================================================
+    // public methods.
+    //==================================================================================
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //----------------------------------------------------------------------------------
+    FrameGraph();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    ~FrameGraph();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      宣言したリソースとパス, コマンドリストを破棄します.
+    //----------------------------------------------------------------------------------
+    void Reset();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      プールから割り当てるレンダーターゲットを宣言します.
+    //!
+    //! @param [in]     desc        構成設定です.
+    //! @return     リソースのハンドルを返却します.
+    //----------------------------------------------------------------------------------
+    Resource CreateTarget( const RenderTargetDesc& desc );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      グラフの外で管理するテクスチャを入力として登録します.
+    //!
+    //! @param [in]     pSRV        シェーダリソースビューです.
+    //! @return     リソースのハンドルを返却します.
+    //----------------------------------------------------------------------------------
+    Resource ImportTexture( void* pSRV );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      グラフの外で管理するレンダーターゲットを出力として登録します.
+    //!
+    //! @param [in]     pRTV        レンダーターゲットビューです.
+    //! @param [in]     pDSV        深度ステンシルビューです. nullptr でも構いません.
+    //! @param [in]     width       横幅です.
+    //! @param [in]     height      縦幅です.
+    //! @return     リソースのハンドルを返却します.
+    //! @note       登録したレンダーターゲットに書き込むパスは削除しません.
+    //----------------------------------------------------------------------------------
+    Resource ImportTarget( void* pRTV, void* pDSV, u32 width, u32 height );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      グラフの結果として残すリソースを指定します.
+    //!
+    //! @param [in]     resource    リソースです.
+    //----------------------------------------------------------------------------------
+    void MarkOutput( Resource resource );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      パスを追加します.
+    //!
+    //! @param [in]     desc        パスの設定です. パスは追加した順に実行します.
+    //----------------------------------------------------------------------------------
+    void AddPass( const PassDesc& desc );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      グラフをコマンドリストにコンパイルします.
+    //!
+    //! @param [in]     pool        レンダーターゲットプールです. 宣言済みの仮想ターゲットは破棄されます.
+    //! @param [in]     pBackend    ビューを取得するバックエンドです.
+    //! @retval true    コンパイルに成功.
+    //! @retval false   レンダーターゲットの生成に失敗した場合や，不正なリソースを参照した場合は失敗.
+    //! @note       結果に寄与しないパスと，後で読まれない出力は削除します.
+    //!             レンダーターゲットの寿命は残ったパスの順番から求め，重ならないものはプールが実体を共有します.
+    //!             直前と同じステートの設定は省き，書き込む前にシェーダリソースの設定を外します.
+    //----------------------------------------------------------------------------------
+    bool Compile( RenderTargetPool& pool, IFrameGraphBackend* pBackend );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンパイルしたコマンドリストを実行します.
+    //!
+    //! @param [in]     pBackend    コマンドを実行するバックエンドです.
+    //----------------------------------------------------------------------------------
+    void Execute( IFrameGraphBackend* pBackend ) const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンパイルしたコマンドリストを取得します.
+    //----------------------------------------------------------------------------------
+    const std::vector<FrameGraphCommand>& GetCommands() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      追加したパス数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetPassCount() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      削除したパス数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetCulledPassCount() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      削除した出力の数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetCulledOutputCount() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      省いたステート設定の数を取得します.
+    //----------------------------------------------------------------------------------
+    u32 GetSkippedStateCount() const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      パスが削除されたかどうかを取得します.
+    //!
+    //! @param [in]     index       追加した順番です.
+    //----------------------------------------------------------------------------------
+    bool IsCulled( u32 index ) const;
+
+    //----------------------------------------------------------------------------------
+    //! @brief      プールの仮想ターゲットのハンドルを取得します.
+    //!
+    //! @param [in]     resource    リソースです.
+    //! @return     仮想ターゲットのハンドルを返却します. 使われないリソースや外部のリソースは INVALID_HANDLE を返却します.
+    //----------------------------------------------------------------------------------
+    RenderTargetPool::Handle GetPoolHandle( Resource resource ) const;
+
+private:
+    //==================================================================================
+    // RESOURCE_KIND enum
+    //==================================================================================
+    enum RESOURCE_KIND
+    {
+        RESOURCE_KIND_TARGET = 0,       //!< プールから割り当てるレンダーターゲットです.
+        RESOURCE_KIND_TEXTURE,          //!< 外部のテクスチャです.
+        RESOURCE_KIND_IMPORTED_TARGET,  //!< 外部のレンダーターゲットです.
+    };
+
+    //==================================================================================
+    // ResourceEntry structure
+    //==================================================================================
+    struct ResourceEntry
+    {
+        RESOURCE_KIND               Kind;       //!< 種類です.
+        RenderTargetDesc            Desc;       //!< 構成設定です.
+        void*                       pRTV;       //!< レンダーターゲットビューです.
+        void*                       pSRV;       //!< シェーダリソースビューです.
+        void*                       pDSV;       //!< 深度ステンシルビューです.
+        void*                       pIdentity;  //!< 読み書きの衝突を判定するための実体です.
+        bool                        Keep;       //!< 結果として残すかどうか.
+        RenderTargetPool::Handle    Handle;     //!< プールの仮想ターゲットのハンドルです.
+    };
+
+    //==================================================================================
+    // PassEntry structure
+    //==================================================================================
+    struct PassEntry
+    {
+        PassDesc    Desc;           //!< パスの設定です.
+        bool        Culled;         //!< 削除したかどうか.
+        bool        UseOutput[FRAME_GRAPH_MAX_OUTPUT_COUNT];   //!< 出力を残すかどうか.
+    };
+
+    //==================================================================================
+    // private variables.
+    //==================================================================================
+    std::vector<ResourceEntry>      m_Resources;        //!< リソースです.
+    std::vector<PassEntry>          m_Passes;           //!< パスです.
+    std::vector<FrameGraphCommand>  m_Commands;         //!< コマンドリストです.
+    u32                             m_CulledPassCount;  //!< 削除したパス数です.
+    u32                             m_CulledOutputCount;//!< 削除した出力の数です.
+    u32                             m_SkippedCount;     //!< 省いたステート設定の数です.
+
+    //==================================================================================
+    // private methods.
+    //==================================================================================
+    FrameGraph          ( const FrameGraph& );      // アクセス禁止.
+    void operator =     ( const FrameGraph& );      // アクセス禁止.
+
+    bool IsValid    ( Resource resource ) const;
+    void CullPasses ();
+    bool AllocateTargets( RenderTargetPool& pool, IFrameGraphBackend* pBackend );
+    void BuildCommands  ();
+};
+
+
+#endif//__FRAME_GRAPH_H__
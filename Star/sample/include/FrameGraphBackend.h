@@ -0,0 +1,99 @@
+﻿//------------------------------------------------------------------------------
+// File : FrameGraphBackend.h
+// Desc : Frame Graph Backend for D3D11.
+// Copyright(c) Project Asura. All right reserved.
+//------------------------------------------------------------------------------
+
+#ifndef __FRAME_GRAPH_BACKEND_H__
+#define __FRAME_GRAPH_BACKEND_H__
+
+//------------------------------------------------------------------------------
+// Include
+//------------------------------------------------------------------------------
+#include <asdxQuadRenderer.h>
+#include "FrameGraph.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// FrameGraphBackend class
+////////////////////////////////////////////////////////////////////////////////////////
+class FrameGraphBackend : public IFrameGraphBackend
+{
+    //==================================================================================
+    // list of friend classes and methods.
+    //==================================================================================
+    /* NOTHING */
+
+public:
+    //==================================================================================
+    // public variables.
+    //==================================================================================
+    /* NOTHING */
+
+    //==================================================================================
+    // public methods.
+    //==================================================================================
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //----------------------------------------------------------------------------------
+    FrameGraphBackend();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------
+    ~FrameGraphBackend();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      初期化処理を行います.
+    //!
+    //! @param [in]     pContext    デバイスコンテキストです.
+    //! @param [in]     pQuad       フルスクリーン矩形の描画に使うレンダラーです.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //----------------------------------------------------------------------------------
+    bool Init( ID3D11DeviceContext* pContext, asdx::QuadRenderer* pQuad );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      asdx::RenderTarget2D のレンダーターゲットビューを取得します.
+    //----------------------------------------------------------------------------------
+    void* GetRenderTargetView( void* pTarget );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      asdx::RenderTarget2D のシェーダリソースビューを取得します.
+    //----------------------------------------------------------------------------------
+    void* GetShaderResourceView( void* pTarget );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コマンドリストの実行を開始します.
+    //!
+    //! @note       グラフは頂点シェーダとピクセルシェーダだけを使うので，他のステージをここで1度だけ外します.
+    //----------------------------------------------------------------------------------
+    void Begin();
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コマンドをデバイスコンテキストに発行します.
+    //----------------------------------------------------------------------------------
+    void Execute( const FrameGraphCommand& command );
+
+    //----------------------------------------------------------------------------------
+    //! @brief      コマンドリストの実行を終了します.
+    //----------------------------------------------------------------------------------
+    void End();
+
+private:
+    //==================================================================================
+    // private variables.
+    //==================================================================================
+    ID3D11DeviceContext*    m_pContext;     //!< デバイスコンテキストです.
+    asdx::QuadRenderer*     m_pQuad;        //!< フルスクリーン矩形のレンダラーです.
+
+    //==================================================================================
+    // private methods.
+    //==================================================================================
+    FrameGraphBackend   ( const FrameGraphBackend& );   // アクセス禁止.
+    void operator =     ( const FrameGraphBackend& );   // アクセス禁止.
+};
+
+
+#endif//__FRAME_GRAPH_BACKEND_H__
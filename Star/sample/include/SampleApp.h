@@ -19,6 +19,16 @@
 #include <asdxFont.h>
 #include <asdxConstantBuffer.h>
 #include <asdxTexture.h>
+#include "ParamTableCache.h"
+#include "RenderTargetAllocator.h"
+#include "FrameGraphBackend.h"
+
+
+//-------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------
+static const u32 MAX_STAR_DIRECTION_COUNT   = 16;   //!< 光芒の最大本数です.
+static const u32 STAR_PASS_COUNT            = 3;    //!< 1方向あたりのパス数です.
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -30,6 +40,17 @@ struct BlurParam
     asdx::Vector4   Offset[16];    //!< オフセットです.
 };
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// BrightPassParam structure
+//////////////////////////////////////////////////////////////////////////////////////////
+ASDX_ALIGN(16)
+struct BrightPassParam
+{
+    asdx::Vector2   Offset;         //!< ブロックの中心からのフェッチ位置のオフセットです.
+    float           Threshold;      //!< 差し引く輝度の閾値です.
+    float           Reserved;       //!< 予約領域です.
+};
+
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // SampleApplication
@@ -51,18 +72,31 @@ private:
     ID3D11PixelShader*          m_pCopyPS        = nullptr;     //!< シングルテクスチャフェッチシェーダ.
     ID3D11PixelShader*          m_pCompositePS   = nullptr;     //!< コンポジットシェーダ.
     ID3D11PixelShader*          m_pStarPS        = nullptr;     //!< スターシェーダ.
+    ID3D11PixelShader*          m_pBrightPassPS  = nullptr;     //!< 縮小と閾値処理のシェーダ.
     ID3D11SamplerState*         m_pPointSampler  = nullptr;     //!< ポイントサンプラー.
     ID3D11SamplerState*         m_pLinearSampler = nullptr;     //!< リニアサンプラー.
     ID3D11BlendState*           m_pOpequeBS      = nullptr;     //!< 不透明.
     ID3D11BlendState*           m_pAdditiveBS    = nullptr;     //!< 加算.
     asdx::QuadRenderer          m_Quad;
-    asdx::ConstantBuffer        m_BlurBuffer;
-    asdx::RenderTarget2D        m_WorkBuffer[4];
+    ParamTableCache             m_ParamTable;                   //!< IMMUTABLE な定数バッファのキャッシュ.
+    ParamTableCache::Handle     m_StarTable[MAX_STAR_DIRECTION_COUNT][STAR_PASS_COUNT];    //!< 方向・パスごとのテーブル.
+    ParamTableCache::Handle     m_BrightPassTable[2][2];        //!< 縮小率・閾値の有無ごとのテーブル.
+    RenderTargetAllocator       m_TargetAllocator;              //!< 作業バッファのアロケータ.
+    RenderTargetPool            m_TargetPool;                   //!< 作業バッファのプール.
+    FrameGraphBackend           m_GraphBackend;                 //!< フレームグラフのバックエンド.
+    FrameGraph                  m_FrameGraph;                   //!< 光芒のパスを宣言したフレームグラフ.
+    u32                         m_DirectionIndex  = 0;          //!< 光芒の本数の番号.
+    u32                         m_ResolutionIndex = 0;          //!< 光芒を描画する解像度の番号.
+    bool                        m_EnableThreshold = false;      //!< 縮小時に閾値を引くかどうか.
+    u32                         m_WorkFormatIndex = 0;          //!< 作業バッファのフォーマットの番号.
 
     //==================================================================================
     // private methods.
     //==================================================================================
     void OnDrawText();
+    bool UpdateStarTable();
+    bool BuildFrameGraph();
+    void ReleaseWorkBuffers();
 
 protected:
     //==================================================================================
@@ -0,0 +1,47 @@
+//-------------------------------------------------------------------------------------------------
+// File : BrightPassPS.hlsl
+// Desc : Downsample And Threshold For Star.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// VSOutput structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct VSOutput
+{
+    float4 Position : SV_POSITION;
+    float2 TexCoord : TEXCOORD;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CbBrightPass buffer
+///////////////////////////////////////////////////////////////////////////////////////////////////
+cbuffer CbBrightPass : register(b0)
+{
+    float2 Offset;      // ͉摜̃eNZPʂ (k / 4) 炵ItZbg.
+    float  Threshold;   // Px臒l.
+    float  Reserved;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Textures and Samplers.
+//-------------------------------------------------------------------------------------------------
+Texture2D       ColorMap : register(t0);
+SamplerState    ColorSmp : register(s0);
+
+
+//-------------------------------------------------------------------------------------------------
+//      CGg[|Cgł.
+//-------------------------------------------------------------------------------------------------
+float4 main(const VSOutput input) : SV_TARGET0
+{
+    // k x k ̃ubN̒S4̃oCjAtFb`ŃubN̕ς߂.
+    float4 result = 0;
+    result += ColorMap.SampleLevel(ColorSmp, input.TexCoord + float2(-Offset.x, -Offset.y), 0);
+    result += ColorMap.SampleLevel(ColorSmp, input.TexCoord + float2( Offset.x, -Offset.y), 0);
+    result += ColorMap.SampleLevel(ColorSmp, input.TexCoord + float2(-Offset.x,  Offset.y), 0);
+    result += ColorMap.SampleLevel(ColorSmp, input.TexCoord + float2( Offset.x,  Offset.y), 0);
+    result *= 0.25f;
+
+    return float4(max(result.rgb - Threshold, 0.0f), result.a);
+}
\ No newline at end of file
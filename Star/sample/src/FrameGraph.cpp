@@ -0,0 +1,693 @@
+﻿//---------------------------------------------------------------------------------------
+// File : FrameGraph.cpp
+// Desc : Post Process Frame Graph.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "FrameGraph.h"
+#include <cstring>
+
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Binding structure
+////////////////////////////////////////////////////////////////////////////////////////
+struct Binding
+{
+    void*   pObject;    //!< 設定済みのオブジェクトです.
+    u32     Value;      //!< 設定済みの値です.
+    bool    Valid;      //!< 設定済みかどうか. 実行開始時のステートは不明として扱います.
+};
+
+//---------------------------------------------------------------------------------------
+//      設定が変わるかどうかチェックし，変わる場合は更新します.
+//---------------------------------------------------------------------------------------
+bool Rebind( Binding& binding, void* pObject, u32 value = 0 )
+{
+    if ( binding.Valid && binding.pObject == pObject && binding.Value == value )
+    { return false; }
+
+    binding.pObject = pObject;
+    binding.Value   = value;
+    binding.Valid   = true;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      コマンドを生成します.
+//---------------------------------------------------------------------------------------
+FrameGraphCommand MakeCommand( FRAME_GRAPH_COMMAND type, u32 pass, u32 slot = 0, void* pObject = nullptr )
+{
+    FrameGraphCommand command;
+    memset( &command, 0, sizeof(command) );
+    command.Type       = type;
+    command.Pass       = pass;
+    command.Slot       = slot;
+    command.pObject[0] = pObject;
+    return command;
+}
+
+} // namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// RecordingFrameGraphBackend class
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+RecordingFrameGraphBackend::RecordingFrameGraphBackend()
+: m_Commands()
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      デストラクタです.
+//---------------------------------------------------------------------------------------
+RecordingFrameGraphBackend::~RecordingFrameGraphBackend()
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      レンダーターゲットそのものをビューとして返却します.
+//---------------------------------------------------------------------------------------
+void* RecordingFrameGraphBackend::GetRenderTargetView( void* pTarget )
+{ return pTarget; }
+
+//---------------------------------------------------------------------------------------
+//      レンダーターゲットそのものをビューとして返却します.
+//---------------------------------------------------------------------------------------
+void* RecordingFrameGraphBackend::GetShaderResourceView( void* pTarget )
+{ return pTarget; }
+
+//---------------------------------------------------------------------------------------
+//      記録済みのコマンドを破棄します.
+//---------------------------------------------------------------------------------------
+void RecordingFrameGraphBackend::Begin()
+{ m_Commands.clear(); }
+
+//---------------------------------------------------------------------------------------
+//      コマンドを記録します.
+//---------------------------------------------------------------------------------------
+void RecordingFrameGraphBackend::Execute( const FrameGraphCommand& command )
+{ m_Commands.push_back( command ); }
+
+//---------------------------------------------------------------------------------------
+//      記録を終了します.
+//---------------------------------------------------------------------------------------
+void RecordingFrameGraphBackend::End()
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      記録したコマンドを取得します.
+//---------------------------------------------------------------------------------------
+const std::vector<FrameGraphCommand>& RecordingFrameGraphBackend::GetCommands() const
+{ return m_Commands; }
+
+//---------------------------------------------------------------------------------------
+//      記録したコマンドのうち，指定した種類の数を取得します.
+//---------------------------------------------------------------------------------------
+u32 RecordingFrameGraphBackend::GetCount( FRAME_GRAPH_COMMAND type ) const
+{
+    u32 count = 0;
+    for(size_t i=0; i<m_Commands.size(); ++i)
+    {
+        if ( m_Commands[i].Type == type )
+        { count++; }
+    }
+
+    return count;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// FrameGraph::PassDesc structure
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+FrameGraph::PassDesc::PassDesc()
+: Name              ( "" )
+, ClearOutput       ( false )
+, ClearDepth        ( false )
+, pVS               ( nullptr )
+, pPS               ( nullptr )
+, pBlendState       ( nullptr )
+, pRasterizerState  ( nullptr )
+, pDepthStencilState( nullptr )
+, StencilRef        ( 0 )
+{
+    for(u32 i=0; i<FRAME_GRAPH_MAX_INPUT_COUNT; ++i)
+    { Input[i] = INVALID_RESOURCE; }
+
+    for(u32 i=0; i<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++i)
+    { Output[i] = INVALID_RESOURCE; }
+
+    for(u32 i=0; i<4; ++i)
+    { ClearColor[i] = 0.0f; }
+
+    for(u32 i=0; i<FRAME_GRAPH_MAX_CONSTANT_COUNT; ++i)
+    { pConstantBuffer[i] = nullptr; }
+
+    for(u32 i=0; i<FRAME_GRAPH_MAX_SAMPLER_COUNT; ++i)
+    { pSampler[i] = nullptr; }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// FrameGraph class
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+FrameGraph::FrameGraph()
+: m_Resources           ()
+, m_Passes              ()
+, m_Commands            ()
+, m_CulledPassCount     ( 0 )
+, m_CulledOutputCount   ( 0 )
+, m_SkippedCount        ( 0 )
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      デストラクタです.
+//---------------------------------------------------------------------------------------
+FrameGraph::~FrameGraph()
+{ Reset(); }
+
+//---------------------------------------------------------------------------------------
+//      宣言したリソースとパス, コマンドリストを破棄します.
+//---------------------------------------------------------------------------------------
+void FrameGraph::Reset()
+{
+    m_Resources.clear();
+    m_Passes   .clear();
+    m_Commands .clear();
+    m_CulledPassCount   = 0;
+    m_CulledOutputCount = 0;
+    m_SkippedCount      = 0;
+}
+
+//---------------------------------------------------------------------------------------
+//      プールから割り当てるレンダーターゲットを宣言します.
+//---------------------------------------------------------------------------------------
+FrameGraph::Resource FrameGraph::CreateTarget( const RenderTargetDesc& desc )
+{
+    ResourceEntry entry = {};
+    entry.Kind   = RESOURCE_KIND_TARGET;
+    entry.Desc   = desc;
+    entry.Handle = RenderTargetPool::INVALID_HANDLE;
+
+    m_Resources.push_back( entry );
+    return Resource( m_Resources.size() - 1 );
+}
+
+//---------------------------------------------------------------------------------------
+//      グラフの外で管理するテクスチャを入力として登録します.
+//---------------------------------------------------------------------------------------
+FrameGraph::Resource FrameGraph::ImportTexture( void* pSRV )
+{
+    ResourceEntry entry = {};
+    entry.Kind      = RESOURCE_KIND_TEXTURE;
+    entry.pSRV      = pSRV;
+    entry.pIdentity = pSRV;
+    entry.Handle    = RenderTargetPool::INVALID_HANDLE;
+
+    m_Resources.push_back( entry );
+    return Resource( m_Resources.size() - 1 );
+}
+
+//---------------------------------------------------------------------------------------
+//      グラフの外で管理するレンダーターゲットを出力として登録します.
+//---------------------------------------------------------------------------------------
+FrameGraph::Resource FrameGraph::ImportTarget( void* pRTV, void* pDSV, u32 width, u32 height )
+{
+    ResourceEntry entry = {};
+    entry.Kind          = RESOURCE_KIND_IMPORTED_TARGET;
+    entry.Desc.Width    = width;
+    entry.Desc.Height   = height;
+    entry.pRTV          = pRTV;
+    entry.pDSV          = pDSV;
+    entry.pIdentity     = pRTV;
+    entry.Keep          = true;
+    entry.Handle        = RenderTargetPool::INVALID_HANDLE;
+
+    m_Resources.push_back( entry );
+    return Resource( m_Resources.size() - 1 );
+}
+
+//---------------------------------------------------------------------------------------
+//      グラフの結果として残すリソースを指定します.
+//---------------------------------------------------------------------------------------
+void FrameGraph::MarkOutput( Resource resource )
+{
+    if ( IsValid( resource ) )
+    { m_Resources[resource].Keep = true; }
+}
+
+//---------------------------------------------------------------------------------------
+//      パスを追加します.
+//---------------------------------------------------------------------------------------
+void FrameGraph::AddPass( const PassDesc& desc )
+{
+    PassEntry entry;
+    entry.Desc   = desc;
+    entry.Culled = false;
+    for(u32 i=0; i<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++i)
+    { entry.UseOutput[i] = false; }
+
+    m_Passes.push_back( entry );
+}
+
+//---------------------------------------------------------------------------------------
+//      グラフをコマンドリストにコンパイルします.
+//---------------------------------------------------------------------------------------
+bool FrameGraph::Compile( RenderTargetPool& pool, IFrameGraphBackend* pBackend )
+{
+    m_Commands.clear();
+
+    if ( pBackend == nullptr )
+    { return false; }
+
+    // 入力はシェーダリソースビューを持つもの，出力はレンダーターゲットビューを持つものに限る.
+    for(size_t i=0; i<m_Passes.size(); ++i)
+    {
+        const auto& desc = m_Passes[i].Desc;
+        for(u32 j=0; j<FRAME_GRAPH_MAX_INPUT_COUNT; ++j)
+        {
+            auto input = desc.Input[j];
+            if ( input == INVALID_RESOURCE )
+            { continue; }
+
+            if ( !IsValid( input ) || m_Resources[input].Kind == RESOURCE_KIND_IMPORTED_TARGET )
+            { return false; }
+        }
+
+        for(u32 j=0; j<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++j)
+        {
+            auto output = desc.Output[j];
+            if ( output == INVALID_RESOURCE )
+            { continue; }
+
+            if ( !IsValid( output ) || m_Resources[output].Kind == RESOURCE_KIND_TEXTURE )
+            { return false; }
+        }
+    }
+
+    CullPasses();
+
+    if ( !AllocateTargets( pool, pBackend ) )
+    { return false; }
+
+    BuildCommands();
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      コンパイルしたコマンドリストを実行します.
+//---------------------------------------------------------------------------------------
+void FrameGraph::Execute( IFrameGraphBackend* pBackend ) const
+{
+    if ( pBackend == nullptr )
+    { return; }
+
+    pBackend->Begin();
+    for(size_t i=0; i<m_Commands.size(); ++i)
+    { pBackend->Execute( m_Commands[i] ); }
+    pBackend->End();
+}
+
+//---------------------------------------------------------------------------------------
+//      コンパイルしたコマンドリストを取得します.
+//---------------------------------------------------------------------------------------
+const std::vector<FrameGraphCommand>& FrameGraph::GetCommands() const
+{ return m_Commands; }
+
+//---------------------------------------------------------------------------------------
+//      追加したパス数を取得します.
+//---------------------------------------------------------------------------------------
+u32 FrameGraph::GetPassCount() const
+{ return u32( m_Passes.size() ); }
+
+//---------------------------------------------------------------------------------------
+//      削除したパス数を取得します.
+//---------------------------------------------------------------------------------------
+u32 FrameGraph::GetCulledPassCount() const
+{ return m_CulledPassCount; }
+
+//---------------------------------------------------------------------------------------
+//      削除した出力の数を取得します.
+//---------------------------------------------------------------------------------------
+u32 FrameGraph::GetCulledOutputCount() const
+{ return m_CulledOutputCount; }
+
+//---------------------------------------------------------------------------------------
+//      省いたステート設定の数を取得します.
+//---------------------------------------------------------------------------------------
+u32 FrameGraph::GetSkippedStateCount() const
+{ return m_SkippedCount; }
+
+//---------------------------------------------------------------------------------------
+//      パスが削除されたかどうかを取得します.
+//---------------------------------------------------------------------------------------
+bool FrameGraph::IsCulled( u32 index ) const
+{
+    if ( index >= m_Passes.size() )
+    { return true; }
+
+    return m_Passes[index].Culled;
+}
+
+//---------------------------------------------------------------------------------------
+//      プールの仮想ターゲットのハンドルを取得します.
+//---------------------------------------------------------------------------------------
+RenderTargetPool::Handle FrameGraph::GetPoolHandle( Resource resource ) const
+{
+    if ( !IsValid( resource ) )
+    { return RenderTargetPool::INVALID_HANDLE; }
+
+    return m_Resources[resource].Handle;
+}
+
+//---------------------------------------------------------------------------------------
+//      リソースのハンドルが有効かどうかチェックします.
+//---------------------------------------------------------------------------------------
+bool FrameGraph::IsValid( Resource resource ) const
+{ return resource < m_Resources.size(); }
+
+//---------------------------------------------------------------------------------------
+//      結果に寄与しないパスと出力を削除します.
+//---------------------------------------------------------------------------------------
+void FrameGraph::CullPasses()
+{
+    m_CulledPassCount   = 0;
+    m_CulledOutputCount = 0;
+
+    // 後ろのパスから，その時点で後で読まれるリソースを追跡する.
+    std::vector<bool> needed( m_Resources.size() );
+    for(size_t i=0; i<m_Resources.size(); ++i)
+    { needed[i] = m_Resources[i].Keep; }
+
+    for(size_t i=m_Passes.size(); i>0; --i)
+    {
+        auto& pass = m_Passes[i - 1];
+        const auto& desc = pass.Desc;
+
+        pass.Culled = true;
+        for(u32 j=0; j<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++j)
+        {
+            auto output = desc.Output[j];
+            pass.UseOutput[j] = ( output != INVALID_RESOURCE && needed[output] );
+            if ( pass.UseOutput[j] )
+            { pass.Culled = false; }
+        }
+
+        if ( pass.Culled )
+        {
+            m_CulledPassCount++;
+            continue;
+        }
+
+        for(u32 j=0; j<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++j)
+        {
+            auto output = desc.Output[j];
+            if ( output == INVALID_RESOURCE )
+            { continue; }
+
+            if ( !pass.UseOutput[j] )
+            {
+                m_CulledOutputCount++;
+                continue;
+            }
+
+            // クリアして書き込む場合は，それより前の内容は要らない.
+            // 外部のレンダーターゲットは常に残す.
+            if ( desc.ClearOutput && m_Resources[output].Kind == RESOURCE_KIND_TARGET )
+            { needed[output] = false; }
+        }
+
+        for(u32 j=0; j<FRAME_GRAPH_MAX_INPUT_COUNT; ++j)
+        {
+            auto input = desc.Input[j];
+            if ( input != INVALID_RESOURCE )
+            { needed[input] = true; }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------
+//      残ったパスの順番から寿命を求めて，レンダーターゲットを割り当てます.
+//---------------------------------------------------------------------------------------
+bool FrameGraph::AllocateTargets( RenderTargetPool& pool, IFrameGraphBackend* pBackend )
+{
+    const u32 NONE = 0xffffffff;
+    std::vector<u32> firstPass( m_Resources.size(), NONE );
+    std::vector<u32> lastPass ( m_Resources.size(), NONE );
+
+    u32 index = 0;
+    for(size_t i=0; i<m_Passes.size(); ++i)
+    {
+        const auto& pass = m_Passes[i];
+        if ( pass.Culled )
+        { continue; }
+
+        auto touch = [&]( Resource resource )
+        {
+            if ( firstPass[resource] == NONE )
+            { firstPass[resource] = index; }
+            lastPass[resource] = index;
+        };
+
+        for(u32 j=0; j<FRAME_GRAPH_MAX_INPUT_COUNT; ++j)
+        {
+            if ( pass.Desc.Input[j] != INVALID_RESOURCE )
+            { touch( pass.Desc.Input[j] ); }
+        }
+
+        for(u32 j=0; j<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++j)
+        {
+            if ( pass.UseOutput[j] )
+            { touch( pass.Desc.Output[j] ); }
+        }
+
+        index++;
+    }
+
+    pool.Begin();
+    for(size_t i=0; i<m_Resources.size(); ++i)
+    {
+        auto& entry = m_Resources[i];
+        if ( entry.Kind != RESOURCE_KIND_TARGET )
+        { continue; }
+
+        // 結果として残すものは最後まで保持する.
+        if ( entry.Keep && firstPass[i] != NONE )
+        { lastPass[i] = index; }
+
+        entry.Handle = ( firstPass[i] != NONE )
+            ? pool.Request( entry.Desc, firstPass[i], lastPass[i] )
+            : RenderTargetPool::INVALID_HANDLE;
+    }
+
+    if ( !pool.Compile() )
+    { return false; }
+
+    for(size_t i=0; i<m_Resources.size(); ++i)
+    {
+        auto& entry = m_Resources[i];
+        if ( entry.Kind != RESOURCE_KIND_TARGET )
+        { continue; }
+
+        auto pTarget = pool.GetTarget( entry.Handle );
+        entry.pIdentity = pTarget;
+        entry.pRTV      = ( pTarget != nullptr ) ? pBackend->GetRenderTargetView  ( pTarget ) : nullptr;
+        entry.pSRV      = ( pTarget != nullptr ) ? pBackend->GetShaderResourceView( pTarget ) : nullptr;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      残ったパスからコマンドリストを生成します.
+//---------------------------------------------------------------------------------------
+void FrameGraph::BuildCommands()
+{
+    m_SkippedCount = 0;
+
+    Binding renderTargets = {};
+    Binding vs            = {};
+    Binding ps            = {};
+    Binding blendState    = {};
+    Binding rasterizer    = {};
+    Binding depthStencil  = {};
+    Binding shaderResource[FRAME_GRAPH_MAX_INPUT_COUNT]    = {};
+    Binding sampler       [FRAME_GRAPH_MAX_SAMPLER_COUNT]  = {};
+    Binding constantBuffer[FRAME_GRAPH_MAX_CONSTANT_COUNT] = {};
+    void*   boundIdentity [FRAME_GRAPH_MAX_INPUT_COUNT]    = {};
+
+    // レンダーターゲットの組とビューポートは内容をまとめて比較する.
+    void* boundTargets[FRAME_GRAPH_MAX_OUTPUT_COUNT] = {};
+    void* boundDepth     = nullptr;
+    bool  viewportValid  = false;
+    u32   viewportWidth  = 0;
+    u32   viewportHeight = 0;
+
+    auto emitState = [&]( Binding& binding, FRAME_GRAPH_COMMAND type, u32 pass, u32 slot, void* pObject, u32 value )
+    {
+        if ( !Rebind( binding, pObject, value ) )
+        {
+            m_SkippedCount++;
+            return;
+        }
+
+        auto command = MakeCommand( type, pass, slot, pObject );
+        command.Value[0] = value;
+        m_Commands.push_back( command );
+    };
+
+    for(size_t i=0; i<m_Passes.size(); ++i)
+    {
+        const auto& pass = m_Passes[i];
+        if ( pass.Culled )
+        { continue; }
+
+        const auto& desc  = pass.Desc;
+        const auto  index = u32( i );
+
+        // 出力を決める. 削除した出力には何も設定しない.
+        void* targets[FRAME_GRAPH_MAX_OUTPUT_COUNT] = {};
+        void* pDSV  = nullptr;
+        u32   count = 0;
+        u32   width = 0, height = 0;
+        for(u32 j=0; j<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++j)
+        {
+            if ( desc.Output[j] != INVALID_RESOURCE )
+            { count = j + 1; }
+
+            if ( !pass.UseOutput[j] )
+            { continue; }
+
+            const auto& entry = m_Resources[desc.Output[j]];
+            targets[j] = entry.pRTV;
+
+            if ( pDSV == nullptr )
+            { pDSV = entry.pDSV; }
+
+            if ( width == 0 )
+            {
+                width  = entry.Desc.Width;
+                height = entry.Desc.Height;
+            }
+
+            // 書き込むリソースがシェーダリソースとして残っていれば外す.
+            for(u32 k=0; k<FRAME_GRAPH_MAX_INPUT_COUNT; ++k)
+            {
+                if ( boundIdentity[k] == nullptr || boundIdentity[k] != entry.pIdentity )
+                { continue; }
+
+                Rebind( shaderResource[k], nullptr );
+                boundIdentity[k] = nullptr;
+                m_Commands.push_back( MakeCommand( FRAME_GRAPH_COMMAND_SET_SHADER_RESOURCE, index, k ) );
+            }
+        }
+
+        auto sameTargets = renderTargets.Valid
+                        && renderTargets.Value == count
+                        && boundDepth == pDSV
+                        && memcmp( boundTargets, targets, sizeof(targets) ) == 0;
+        if ( sameTargets )
+        { m_SkippedCount++; }
+        else
+        {
+            auto command = MakeCommand( FRAME_GRAPH_COMMAND_SET_RENDER_TARGETS, index, count );
+            memcpy( command.pObject, targets, sizeof(targets) );
+            command.pDepth = pDSV;
+            m_Commands.push_back( command );
+
+            renderTargets.Valid = true;
+            renderTargets.Value = count;
+            memcpy( boundTargets, targets, sizeof(targets) );
+            boundDepth = pDSV;
+        }
+
+        if ( desc.ClearOutput )
+        {
+            for(u32 j=0; j<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++j)
+            {
+                if ( targets[j] == nullptr )
+                { continue; }
+
+                auto command = MakeCommand( FRAME_GRAPH_COMMAND_CLEAR_RENDER_TARGET, index, j, targets[j] );
+                memcpy( command.Color, desc.ClearColor, sizeof(command.Color) );
+                m_Commands.push_back( command );
+            }
+        }
+
+        if ( desc.ClearDepth && pDSV != nullptr )
+        {
+            auto command = MakeCommand( FRAME_GRAPH_COMMAND_CLEAR_DEPTH_STENCIL, index, 0, pDSV );
+            m_Commands.push_back( command );
+        }
+
+        // ビューポートは先頭の出力の大きさに合わせる.
+        if ( viewportValid && viewportWidth == width && viewportHeight == height )
+        { m_SkippedCount++; }
+        else
+        {
+            auto command = MakeCommand( FRAME_GRAPH_COMMAND_SET_VIEWPORT, index );
+            command.Value[0] = width;
+            command.Value[1] = height;
+            m_Commands.push_back( command );
+
+            viewportValid  = true;
+            viewportWidth  = width;
+            viewportHeight = height;
+        }
+
+        emitState( vs,           FRAME_GRAPH_COMMAND_SET_VERTEX_SHADER,       index, 0, desc.pVS,                0 );
+        emitState( ps,           FRAME_GRAPH_COMMAND_SET_PIXEL_SHADER,        index, 0, desc.pPS,                0 );
+        emitState( blendState,   FRAME_GRAPH_COMMAND_SET_BLEND_STATE,         index, 0, desc.pBlendState,        0 );
+        emitState( rasterizer,   FRAME_GRAPH_COMMAND_SET_RASTERIZER_STATE,    index, 0, desc.pRasterizerState,   0 );
+        emitState( depthStencil, FRAME_GRAPH_COMMAND_SET_DEPTH_STENCIL_STATE, index, 0, desc.pDepthStencilState, desc.StencilRef );
+
+        for(u32 j=0; j<FRAME_GRAPH_MAX_INPUT_COUNT; ++j)
+        {
+            auto input = desc.Input[j];
+            if ( input == INVALID_RESOURCE )
+            { continue; }
+
+            const auto& entry = m_Resources[input];
+            emitState( shaderResource[j], FRAME_GRAPH_COMMAND_SET_SHADER_RESOURCE, index, j, entry.pSRV, 0 );
+            boundIdentity[j] = entry.pIdentity;
+        }
+
+        for(u32 j=0; j<FRAME_GRAPH_MAX_SAMPLER_COUNT; ++j)
+        {
+            if ( desc.pSampler[j] != nullptr )
+            { emitState( sampler[j], FRAME_GRAPH_COMMAND_SET_SAMPLER, index, j, desc.pSampler[j], 0 ); }
+        }
+
+        for(u32 j=0; j<FRAME_GRAPH_MAX_CONSTANT_COUNT; ++j)
+        {
+            if ( desc.pConstantBuffer[j] != nullptr )
+            { emitState( constantBuffer[j], FRAME_GRAPH_COMMAND_SET_CONSTANT_BUFFER, index, j, desc.pConstantBuffer[j], 0 ); }
+        }
+
+        m_Commands.push_back( MakeCommand( FRAME_GRAPH_COMMAND_DRAW, index ) );
+    }
+
+    // 次のフレームで出力として使えるよう，最後にシェーダリソースを外しておく.
+    for(u32 k=0; k<FRAME_GRAPH_MAX_INPUT_COUNT; ++k)
+    {
+        if ( shaderResource[k].Valid && shaderResource[k].pObject != nullptr )
+        {
+            auto pass = m_Commands.empty() ? 0 : m_Commands.back().Pass;
+            m_Commands.push_back( MakeCommand( FRAME_GRAPH_COMMAND_SET_SHADER_RESOURCE, pass, k ) );
+        }
+    }
+}
@@ -0,0 +1,172 @@
+﻿//---------------------------------------------------------------------------------------
+// File : FrameGraphBackend.cpp
+// Desc : Frame Graph Backend for D3D11.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "FrameGraphBackend.h"
+#include <asdxRenderTarget.h>
+#include <asdxLog.h>
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// FrameGraphBackend class
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//---------------------------------------------------------------------------------------
+//      コンストラクタです.
+//---------------------------------------------------------------------------------------
+FrameGraphBackend::FrameGraphBackend()
+: m_pContext( nullptr )
+, m_pQuad   ( nullptr )
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      デストラクタです.
+//---------------------------------------------------------------------------------------
+FrameGraphBackend::~FrameGraphBackend()
+{ /* DO_NOTHING */ }
+
+//---------------------------------------------------------------------------------------
+//      初期化処理を行います.
+//---------------------------------------------------------------------------------------
+bool FrameGraphBackend::Init( ID3D11DeviceContext* pContext, asdx::QuadRenderer* pQuad )
+{
+    if ( pContext == nullptr || pQuad == nullptr )
+    {
+        ELOG( "Error : Invalid Argument." );
+        return false;
+    }
+
+    m_pContext = pContext;
+    m_pQuad    = pQuad;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      asdx::RenderTarget2D のレンダーターゲットビューを取得します.
+//---------------------------------------------------------------------------------------
+void* FrameGraphBackend::GetRenderTargetView( void* pTarget )
+{ return static_cast<asdx::RenderTarget2D*>( pTarget )->GetRTV(); }
+
+//---------------------------------------------------------------------------------------
+//      asdx::RenderTarget2D のシェーダリソースビューを取得します.
+//---------------------------------------------------------------------------------------
+void* FrameGraphBackend::GetShaderResourceView( void* pTarget )
+{ return static_cast<asdx::RenderTarget2D*>( pTarget )->GetSRV(); }
+
+//---------------------------------------------------------------------------------------
+//      コマンドリストの実行を開始します.
+//---------------------------------------------------------------------------------------
+void FrameGraphBackend::Begin()
+{
+    m_pContext->GSSetShader( nullptr, nullptr, 0 );
+    m_pContext->HSSetShader( nullptr, nullptr, 0 );
+    m_pContext->DSSetShader( nullptr, nullptr, 0 );
+}
+
+//---------------------------------------------------------------------------------------
+//      コマンドをデバイスコンテキストに発行します.
+//---------------------------------------------------------------------------------------
+void FrameGraphBackend::Execute( const FrameGraphCommand& command )
+{
+    switch( command.Type )
+    {
+    case FRAME_GRAPH_COMMAND_SET_RENDER_TARGETS:
+        {
+            ID3D11RenderTargetView* pRTV[FRAME_GRAPH_MAX_OUTPUT_COUNT];
+            for(u32 i=0; i<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++i)
+            { pRTV[i] = static_cast<ID3D11RenderTargetView*>( command.pObject[i] ); }
+
+            m_pContext->OMSetRenderTargets( command.Slot, pRTV, static_cast<ID3D11DepthStencilView*>( command.pDepth ) );
+        }
+        break;
+
+    case FRAME_GRAPH_COMMAND_CLEAR_RENDER_TARGET:
+        { m_pContext->ClearRenderTargetView( static_cast<ID3D11RenderTargetView*>( command.pObject[0] ), command.Color ); }
+        break;
+
+    case FRAME_GRAPH_COMMAND_CLEAR_DEPTH_STENCIL:
+        {
+            m_pContext->ClearDepthStencilView(
+                static_cast<ID3D11DepthStencilView*>( command.pObject[0] ),
+                D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0 );
+        }
+        break;
+
+    case FRAME_GRAPH_COMMAND_SET_VIEWPORT:
+        {
+            D3D11_VIEWPORT viewport;
+            viewport.TopLeftX   = 0;
+            viewport.TopLeftY   = 0;
+            viewport.Width      = float( command.Value[0] );
+            viewport.Height     = float( command.Value[1] );
+            viewport.MinDepth   = 0.0f;
+            viewport.MaxDepth   = 1.0f;
+
+            m_pContext->RSSetViewports( 1, &viewport );
+        }
+        break;
+
+    case FRAME_GRAPH_COMMAND_SET_VERTEX_SHADER:
+        { m_pContext->VSSetShader( static_cast<ID3D11VertexShader*>( command.pObject[0] ), nullptr, 0 ); }
+        break;
+
+    case FRAME_GRAPH_COMMAND_SET_PIXEL_SHADER:
+        { m_pContext->PSSetShader( static_cast<ID3D11PixelShader*>( command.pObject[0] ), nullptr, 0 ); }
+        break;
+
+    case FRAME_GRAPH_COMMAND_SET_BLEND_STATE:
+        {
+            float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            UINT sampleMask = D3D11_DEFAULT_SAMPLE_MASK;
+            m_pContext->OMSetBlendState( static_cast<ID3D11BlendState*>( command.pObject[0] ), blendFactor, sampleMask );
+        }
+        break;
+
+    case FRAME_GRAPH_COMMAND_SET_RASTERIZER_STATE:
+        { m_pContext->RSSetState( static_cast<ID3D11RasterizerState*>( command.pObject[0] ) ); }
+        break;
+
+    case FRAME_GRAPH_COMMAND_SET_DEPTH_STENCIL_STATE:
+        { m_pContext->OMSetDepthStencilState( static_cast<ID3D11DepthStencilState*>( command.pObject[0] ), command.Value[0] ); }
+        break;
+
+    case FRAME_GRAPH_COMMAND_SET_SHADER_RESOURCE:
+        {
+            auto pSRV = static_cast<ID3D11ShaderResourceView*>( command.pObject[0] );
+            m_pContext->PSSetShaderResources( command.Slot, 1, &pSRV );
+        }
+        break;
+
+    case FRAME_GRAPH_COMMAND_SET_SAMPLER:
+        {
+            auto pSampler = static_cast<ID3D11SamplerState*>( command.pObject[0] );
+            m_pContext->PSSetSamplers( command.Slot, 1, &pSampler );
+        }
+        break;
+
+    case FRAME_GRAPH_COMMAND_SET_CONSTANT_BUFFER:
+        {
+            auto pCB = static_cast<ID3D11Buffer*>( command.pObject[0] );
+            m_pContext->PSSetConstantBuffers( command.Slot, 1, &pCB );
+        }
+        break;
+
+    case FRAME_GRAPH_COMMAND_DRAW:
+        { m_pQuad->Draw( m_pContext ); }
+        break;
+
+    default:
+        break;
+    }
+}
+
+//---------------------------------------------------------------------------------------
+//      コマンドリストの実行を終了します.
+//---------------------------------------------------------------------------------------
+void FrameGraphBackend::End()
+{ /* DO_NOTHING */ }
@@ -19,8 +19,94 @@ namespace {
 #include "../res/shader/Compiled/CopyPS.inc"
 #include "../res/shader/Compiled/CompositePS.inc"
 #include "../res/shader/Compiled/StarPS.inc"
+#include "../res/shader/Compiled/BrightPassPS.inc"
 
 
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+
+// [D]キーで切り替える光芒の本数.
+static const u32 STAR_DIRECTION_COUNTS[] = { 4, 6, 8, 16, 2 };
+
+// [R]キーで切り替える光芒を描画する解像度の縮小率.
+static const u32 STAR_DOWNSAMPLE_FACTORS[] = { 1, 2, 4 };
+
+// [T]キーで有効にする縮小時の閾値.
+static const float STAR_THRESHOLD = 0.5f;
+
+// [H]キーで切り替える作業バッファのフォーマット. 浮動小数は1.0を超える高輝度部を光芒まで保持する.
+static const DXGI_FORMAT WORK_BUFFER_FORMATS[] = {
+    DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+    DXGI_FORMAT_R16G16B16A16_FLOAT,
+};
+static const char* WORK_BUFFER_FORMAT_NAMES[] = { "R8G8B8A8_UNORM_SRGB", "R16G16B16A16_FLOAT" };
+
+static const float STAR_ATTENUATION = 0.925f;           //!< 減衰率です. [0.9f, 0.95f]の範囲.
+static const float STAR_ROTATION    = asdx::F_PIDIV4;   //!< 角度オフセットです.
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// StarTableKey structure
+//////////////////////////////////////////////////////////////////////////////////////////
+struct StarTableKey
+{
+    s32     Width;          //!< 入力画像の横幅です.
+    s32     Height;         //!< 入力画像の縦幅です.
+    float   Angle;          //!< 光芒の角度(ラジアン)です.
+    s32     Pass;           //!< パスの番号です.
+    float   Attenuation;    //!< 減衰率です.
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// BrightPassTableKey structure
+//////////////////////////////////////////////////////////////////////////////////////////
+struct BrightPassTableKey
+{
+    s32     Width;          //!< 入力画像の横幅です.
+    s32     Height;         //!< 入力画像の縦幅です.
+    u32     Factor;         //!< 縮小率です.
+    float   Threshold;      //!< 閾値です.
+};
+
+//-------------------------------------------------------------------------------------------------
+//      光芒の1パス分のパラメータを計算します.
+//-------------------------------------------------------------------------------------------------
+inline BlurParam CalcStarParam( const StarTableKey& key )
+{
+    // サンプリング方向.
+    asdx::Vector2 dir( cosf(key.Angle), sinf(key.Angle) );
+
+    // 入力画像サイズの逆数.
+    // 縮小時もテクスチャ座標のオフセットは変えないので，光芒の長さは等倍と同じになる.
+    asdx::Vector2 inv_size(1.0f / key.Width, 1.0f / key.Height);
+
+    BlurParam result = {};
+    auto b = powf(4.0f, float(key.Pass));
+    for(auto s=0; s<16; ++s)
+    {
+        result.Offset[s].x = dir.x * (b * s) * inv_size.x;
+        result.Offset[s].y = dir.y * (b * s) * inv_size.y;
+        result.Offset[s].z = powf(key.Attenuation, (b * s));
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      縮小と閾値処理のパラメータを計算します.
+//-------------------------------------------------------------------------------------------------
+inline BrightPassParam CalcBrightPassParam( const BrightPassTableKey& key )
+{
+    // 縮小率 / 4 テクセルずらした4回のバイリニアフェッチでブロックの平均を求める.
+    BrightPassParam result = {};
+    result.Offset.x  = 0.25f * key.Factor / key.Width;
+    result.Offset.y  = 0.25f * key.Factor / key.Height;
+    result.Threshold = key.Threshold;
+
+    return result;
+}
+
 } // namespace 
 
 
@@ -96,6 +182,15 @@ bool SampleApplication::OnInit()
         }
     }
 
+    {
+        hr = m_pDevice->CreatePixelShader(BrightPassPS, sizeof(BrightPassPS), nullptr, &m_pBrightPassPS);
+        if ( FAILED(hr) )
+        {
+            ELOG( "Error : ID3D11CreatePixelShader() Failed." );
+            return false;
+        }
+    }
+
     {
         if (!m_InputTexture.CreateFromFile( m_pDevice, "../res/texture/star_source.map"))
         {
@@ -191,43 +286,196 @@ bool SampleApplication::OnInit()
    }
 
    {
-      if ( !m_BlurBuffer.Create(m_pDevice, sizeof(BlurParam)))
-      { return false; }
-   }
+       if ( !m_TargetAllocator.Init( m_pDevice ) )
+       { return false; }
 
-   {
-       asdx::RenderTarget2D::Description desc;
-       desc.Width               = m_Width;
-       desc.Height              = m_Height;
-       desc.MipLevels           = 1;
-       desc.ArraySize           = 1;
-       desc.Format              = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
-       desc.SampleDesc.Count    = 1;
-       desc.SampleDesc.Quality  = 0;
-
-       for(auto i=0; i<4; i++)
-       {
-           if (!m_WorkBuffer[i].Create(m_pDevice, desc))
-           { return false; }
-       }
+       if ( !m_TargetPool.Init( &m_TargetAllocator ) )
+       { return false; }
+
+       if ( !m_GraphBackend.Init( m_pDeviceContext, &m_Quad ) )
+       { return false; }
    }
 
+    // 縮小率と閾値の組み合わせごとのテーブル.
+    for(auto j=0; j<2; j++)
+    {
+        for(auto k=0; k<2; k++)
+        {
+            BrightPassTableKey key = {};
+            key.Width     = m_Width;
+            key.Height    = m_Height;
+            key.Factor    = STAR_DOWNSAMPLE_FACTORS[j + 1];
+            key.Threshold = ( k == 0 ) ? 0.0f : STAR_THRESHOLD;
+
+            m_BrightPassTable[j][k] = m_ParamTable.Acquire<BrightPassParam>( m_pDevice, key, [&]()
+            { return CalcBrightPassParam( key ); });
+
+            if ( m_BrightPassTable[j][k] == ParamTableCache::INVALID_HANDLE )
+            { return false; }
+        }
+    }
+
+    if ( !UpdateStarTable() )
+    { return false; }
+
+    // テーブルの定数バッファを参照するので最後に構築する.
+    if ( !BuildFrameGraph() )
+    { return false; }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      選択中の設定でフレームグラフを構築します.
+//---------------------------------------------------------------------------------------
+bool SampleApplication::BuildFrameGraph()
+{
+    auto factor = STAR_DOWNSAMPLE_FACTORS[m_ResolutionIndex];
+
+    RenderTargetDesc desc;
+    desc.Width  = ( m_Width  + factor - 1 ) / factor;
+    desc.Height = ( m_Height + factor - 1 ) / factor;
+    desc.Format = WORK_BUFFER_FORMATS[m_WorkFormatIndex];
+
+    m_FrameGraph.Reset();
+
+    auto input  = m_FrameGraph.ImportTexture( m_InputTexture.GetSRV() );
+    auto output = m_FrameGraph.ImportTarget( m_RenderTarget2D.GetRTV(), m_DepthStencilTarget.GetDSV(), m_Width, m_Height );
+    auto accum  = m_FrameGraph.CreateTarget( desc );
+
+    // 全パスで共通の設定.
+    FrameGraph::PassDesc base;
+    base.pVS                = m_pFullScreenVS;
+    base.pBlendState        = m_pOpequeBS;
+    base.pRasterizerState   = m_pRasterizerState;
+    base.pDepthStencilState = m_pDepthStencilState;
+    base.StencilRef         = m_StencilRef;
+
+    // 縮小時は閾値を引いた縮小画像を1度だけ作る.
+    auto source = input;
+    if ( factor != 1 )
+    {
+        source = m_FrameGraph.CreateTarget( desc );
+
+        auto pass = base;
+        pass.Name               = "BrightPass";
+        pass.Input[0]           = input;
+        pass.Output[0]          = source;
+        pass.pPS                = m_pBrightPassPS;
+        pass.pSampler[0]        = m_pLinearSampler;
+        pass.pConstantBuffer[0] = m_ParamTable.GetBuffer( m_BrightPassTable[m_ResolutionIndex - 1][m_EnableThreshold ? 1 : 0] );
+        m_FrameGraph.AddPass( pass );
+    }
+
+    // 方向ごとに3パスでピンポンブラーし，加算合成する.
+    // 作業バッファは方向・パスごとに宣言し，寿命が重ならないものはプールが実体を共有する.
+    auto count = STAR_DIRECTION_COUNTS[m_DirectionIndex];
+    for(u32 j=0; j<count; ++j)
+    {
+        auto prev = source;
+        for(u32 i=0; i<STAR_PASS_COUNT; ++i)
+        {
+            auto work = m_FrameGraph.CreateTarget( desc );
+
+            auto pass = base;
+            pass.Name               = "Star";
+            pass.Input[0]           = prev;
+            pass.Output[0]          = work;
+            pass.ClearOutput        = true;
+            pass.pPS                = m_pStarPS;
+            pass.pSampler[0]        = m_pPointSampler;
+            pass.pConstantBuffer[0] = m_ParamTable.GetBuffer( m_StarTable[j][i] );
+            memcpy( pass.ClearColor, m_ClearColor, sizeof(pass.ClearColor) );
+            m_FrameGraph.AddPass( pass );
+
+            prev = work;
+        }
+
+        auto pass = base;
+        pass.Name           = "Accumulate";
+        pass.Input[0]       = prev;
+        pass.Output[0]      = accum;
+        pass.ClearOutput    = ( j == 0 );
+        pass.ClearColor[3]  = 1.0f;
+        pass.pPS            = m_pCopyPS;
+        pass.pBlendState    = m_pAdditiveBS;
+        pass.pSampler[0]    = m_pPointSampler;
+        m_FrameGraph.AddPass( pass );
+    }
+
+    // 縮小時はリニアサンプラーで光芒を1度だけ拡大する.
+    {
+        auto pass = base;
+        pass.Name           = "Composite";
+        pass.Input[0]       = input;
+        pass.Input[1]       = accum;
+        pass.Output[0]      = output;
+        pass.ClearDepth     = true;
+        pass.pPS            = m_pCompositePS;
+        pass.pSampler[0]    = m_pLinearSampler;
+        m_FrameGraph.AddPass( pass );
+    }
+
+    if ( !m_FrameGraph.Compile( m_TargetPool, &m_GraphBackend ) )
+    {
+        ELOG( "Error : FrameGraph::Compile() Failed. format = %s", WORK_BUFFER_FORMAT_NAMES[m_WorkFormatIndex] );
+        return false;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      作業バッファを解放します.
+//---------------------------------------------------------------------------------------
+void SampleApplication::ReleaseWorkBuffers()
+{
+    m_FrameGraph.Reset();
+    m_TargetPool.Term();
+}
+
+//---------------------------------------------------------------------------------------
+//      光芒の本数に合わせてパラメータテーブルを取得します.
+//---------------------------------------------------------------------------------------
+bool SampleApplication::UpdateStarTable()
+{
+    // 一度作ったテーブルはキャッシュに残るので，本数を戻したときは検索だけで済む.
+    auto count = STAR_DIRECTION_COUNTS[m_DirectionIndex];
+    for(u32 j=0; j<count; ++j)
+    {
+        for(u32 i=0; i<STAR_PASS_COUNT; ++i)
+        {
+            StarTableKey key = {};
+            key.Width       = m_Width;
+            key.Height      = m_Height;
+            key.Angle       = asdx::F_2PI * j / count + STAR_ROTATION;
+            key.Pass        = i;
+            key.Attenuation = STAR_ATTENUATION;
+
+            m_StarTable[j][i] = m_ParamTable.Acquire<BlurParam>( m_pDevice, key, [&]()
+            { return CalcStarParam( key ); });
+
+            if ( m_StarTable[j][i] == ParamTableCache::INVALID_HANDLE )
+            { return false; }
+        }
+    }
+
     return true;
 }
 
 void SampleApplication::OnTerm()
 {
-    for(auto i=0; i<4; i++)
-    { m_WorkBuffer[i].Release(); }
+    ReleaseWorkBuffers();
     m_Font.Term();
     m_InputTexture.Release();
-    m_BlurBuffer.Release();
+    m_ParamTable.Term();
     m_Quad.Term();
     ASDX_RELEASE( m_pOpequeBS );
     ASDX_RELEASE( m_pAdditiveBS );
     ASDX_RELEASE( m_pPointSampler );
     ASDX_RELEASE( m_pLinearSampler );
     ASDX_RELEASE( m_pStarPS );
+    ASDX_RELEASE( m_pBrightPassPS );
     ASDX_RELEASE( m_pCopyPS );
     ASDX_RELEASE( m_pCompositePS );
     ASDX_RELEASE( m_pFullScreenVS );
@@ -249,6 +497,17 @@ void SampleApplication::OnDrawText()
     m_Font.Begin( m_pDeviceContext );
     {
         m_Font.DrawStringArg( 10, 10, "FPS : %.2f", GetFPS() );
+        m_Font.DrawStringArg( 10, 30, "Directions : %u ([D] Key)", STAR_DIRECTION_COUNTS[m_DirectionIndex] );
+        m_Font.DrawStringArg( 10, 50, "Resolution : 1/%u ([R] Key)", STAR_DOWNSAMPLE_FACTORS[m_ResolutionIndex] );
+        m_Font.DrawStringArg( 10, 70, "Threshold  : %s ([T] Key)", ( m_EnableThreshold ) ? "ON" : "OFF" );
+        m_Font.DrawStringArg( 10, 90, "Format     : %s ([H] Key)", WORK_BUFFER_FORMAT_NAMES[m_WorkFormatIndex] );
+        m_Font.DrawStringArg( 10, 110, "Targets    : %u -> %u (%.1f MB -> %.1f MB)",
+            m_TargetPool.GetVirtualCount(), m_TargetPool.GetPhysicalCount(),
+            m_TargetPool.GetRequestedSize() / ( 1024.0 * 1024.0 ),
+            m_TargetPool.GetAllocatedSize() / ( 1024.0 * 1024.0 ) );
+        m_Font.DrawStringArg( 10, 130, "Passes     : %u, Commands : %u (%u Skipped)",
+            m_FrameGraph.GetPassCount() - m_FrameGraph.GetCulledPassCount(),
+            u32( m_FrameGraph.GetCommands().size() ), m_FrameGraph.GetSkippedStateCount() );
     }
     m_Font.End( m_pDeviceContext );
 }
@@ -258,179 +517,11 @@ void SampleApplication::OnDrawText()
 //---------------------------------------------------------------------------------------
 void SampleApplication::OnFrameRender( double time, double elapsedTime )
 {
-    auto w = m_Width;
-    auto h = m_Height;
-
-    // 減衰率.
-    auto a = 0.925f; // [0.9f, 0.95f]の範囲.
-
-    // 角度オフセット.
-    auto rad_offset = asdx::F_PIDIV4;
+    // 設定を変えたときに構築したコマンドリストを流すだけにする.
+    m_FrameGraph.Execute( &m_GraphBackend );
 
-    // レンダーターゲットサイズの逆数.
-    asdx::Vector2 inv_size(1.0f / w, 1.0f / h);
-
-    float clearColor[4] = { 0, 0, 0, 1 };
-    m_pDeviceContext->ClearRenderTargetView( m_WorkBuffer[3].GetRTV(), clearColor );
-
-    // 実験のため4方向固定.
-    for(auto j=0; j<4; ++j)
-    {
-        // サンプリング方向.
-        asdx::Vector2 dir(
-            cosf(asdx::F_2PI * 0.25f * j + rad_offset),
-            sinf(asdx::F_2PI * 0.25f * j + rad_offset)
-        );
-
-        auto pSRV = m_InputTexture.GetSRV();
-
-        // 3パスでピンポンブラー.
-        for(auto i=0; i<3; ++i)
-        {
-            auto pDstRTV = m_WorkBuffer[i].GetRTV();
-
-            // クリア処理.
-            m_pDeviceContext->ClearRenderTargetView( pDstRTV, m_ClearColor );
-
-            // 出力マネージャに設定.
-            m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
-
-            float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-            UINT sampleMask = D3D11_DEFAULT_SAMPLE_MASK;
-            // ステートを設定.
-            m_pDeviceContext->RSSetState( m_pRasterizerState );
-            m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
-            m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
-
-            D3D11_VIEWPORT viewport;
-            viewport.TopLeftX   = 0;
-            viewport.TopLeftY   = 0;
-            viewport.Width      = float(w);
-            viewport.Height     = float(h);
-            viewport.MinDepth   = 0.0f;
-            viewport.MaxDepth   = 1.0f;
-
-            m_pDeviceContext->RSSetViewports( 1, &viewport );
-
-            BlurParam src = {};
-            for(auto s=0; s<16; ++s)
-            {
-                auto b = powf(4.0f, float(i));
-                src.Offset[s].x = dir.x * (b * s) * inv_size.x;
-                src.Offset[s].y = dir.y * (b * s) * inv_size.y;
-                src.Offset[s].z = powf(a, (b * s));
-            }
-
-            auto pCB = m_BlurBuffer.GetBuffer();
-            m_pDeviceContext->UpdateSubresource( pCB, 0, nullptr, &src, 0, 0 );
-            m_pDeviceContext->PSSetConstantBuffers( 0, 1, &pCB );
-
-            // シェーダリソースビューを設定.
-            m_pDeviceContext->PSSetShaderResources( 0, 1, &pSRV );
-            m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
-
-            // シェーダの設定.
-            m_pDeviceContext->VSSetShader( m_pFullScreenVS, nullptr, 0 );
-            m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
-            m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
-            m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
-            m_pDeviceContext->PSSetShader( m_pStarPS, nullptr, 0 );
-
-            // 描画.
-            m_Quad.Draw(m_pDeviceContext);
-
-            // シェーダリソースをクリア.
-            ID3D11ShaderResourceView* nullTarget[1] = { nullptr };
-            m_pDeviceContext->PSSetShaderResources( 0, 1, nullTarget );
-
-            // 次のパスの入力を更新.
-            pSRV = m_WorkBuffer[i].GetSRV();
-        }
-
-        // WorkBuffer[3]に加算合成.
-        {
-            auto pDstRTV = m_WorkBuffer[3].GetRTV();
-
-            // 出力マネージャに設定.
-            m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, nullptr );
-
-            float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-            UINT sampleMask = D3D11_DEFAULT_SAMPLE_MASK;
-            m_pDeviceContext->OMSetBlendState( m_pAdditiveBS, blendFactor, sampleMask );
-
-            // シェーダの設定.
-            m_pDeviceContext->VSSetShader( m_pFullScreenVS, nullptr, 0 );
-            m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
-            m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
-            m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
-            m_pDeviceContext->PSSetShader( m_pCopyPS, nullptr, 0 );
-
-            pSRV = m_WorkBuffer[2].GetSRV();
-            m_pDeviceContext->PSSetShaderResources( 0, 1, &pSRV );
-            m_pDeviceContext->PSSetSamplers( 0, 1, &m_pPointSampler );
-
-            // 描画.
-            m_Quad.Draw(m_pDeviceContext);
-
-            // シェーダリソースをクリア.
-            ID3D11ShaderResourceView* nullTarget[1] = { nullptr };
-            m_pDeviceContext->PSSetShaderResources( 0, 1, nullTarget );
-        }
-    }
-
-    // コンポジット.
-    {
-        // レンダーターゲットビュー・深度ステンシルビューを取得.
-        auto pDstRTV = m_RenderTarget2D.GetRTV();
-        ID3D11DepthStencilView* pDSV = m_DepthStencilTarget.GetDSV();
-
-        m_pDeviceContext->ClearDepthStencilView( pDSV, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0 );
-
-        // 出力マネージャに設定.
-        m_pDeviceContext->OMSetRenderTargets( 1, &pDstRTV, pDSV );
-
-        D3D11_VIEWPORT viewport;
-        viewport.TopLeftX   = 0;
-        viewport.TopLeftY   = 0;
-        viewport.Width      = float(m_Width);
-        viewport.Height     = float(m_Height);
-        viewport.MinDepth   = 0.0f;
-        viewport.MaxDepth   = 1.0f;
-
-        m_pDeviceContext->RSSetViewports(1, &viewport);
-
-        float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        UINT sampleMask = D3D11_DEFAULT_SAMPLE_MASK;
-        // ステートを設定.
-        m_pDeviceContext->RSSetState( m_pRasterizerState );
-        m_pDeviceContext->OMSetBlendState( m_pOpequeBS, blendFactor, sampleMask );
-        m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState, m_StencilRef );
-
-        // シェーダの設定.
-        m_pDeviceContext->VSSetShader( m_pFullScreenVS, nullptr, 0 );
-        m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
-        m_pDeviceContext->PSSetShader( m_pCompositePS, nullptr, 0 );
-
-        // シェーダリソースビューを設定.
-        ID3D11ShaderResourceView* pSRV[] = {
-            m_InputTexture.GetSRV(),
-            m_WorkBuffer[3].GetSRV(),
-        };
-        m_pDeviceContext->PSSetShaderResources( 0, 2, pSRV );
-        m_pDeviceContext->PSSetSamplers( 0, 1, &m_pLinearSampler );
-
-        // 描画.
-        m_Quad.Draw(m_pDeviceContext);
-
-        // シェーダリソースをクリア.
-        ID3D11ShaderResourceView* nullTarget[] = { nullptr, nullptr, nullptr, nullptr, nullptr };
-        m_pDeviceContext->PSSetShaderResources( 0, 2, nullTarget );
-
-        // テキストを描画.
-        OnDrawText();
-    }
+    // テキストを描画.
+    OnDrawText();
 
     // コマンドを実行して，画面に表示.
     m_pSwapChain->Present( 0, 0 );
@@ -441,6 +532,9 @@ void SampleApplication::OnFrameRender( double time, double elapsedTime )
 //---------------------------------------------------------------------------------------
 void SampleApplication::OnResize( const asdx::ResizeEventParam& param )
 {
+    // バックバッファのビューを取り込み直す.
+    if ( m_FrameGraph.GetPassCount() > 0 )
+    { BuildFrameGraph(); }
 }
 
 //---------------------------------------------------------------------------------------
@@ -448,6 +542,45 @@ void SampleApplication::OnResize( const asdx::ResizeEventParam& param )
 //---------------------------------------------------------------------------------------
 void SampleApplication::OnKey( const asdx::KeyEventParam& param )
 {
+    if ( !param.IsKeyDown )
+    { return; }
+
+    if ( param.KeyCode == 'D' )
+    {
+        m_DirectionIndex = ( m_DirectionIndex + 1 ) % _countof(STAR_DIRECTION_COUNTS);
+        UpdateStarTable();
+        BuildFrameGraph();
+    }
+
+    if ( param.KeyCode == 'R' )
+    {
+        // 使う解像度の作業バッファだけを持つので作り直す.
+        auto prev = m_ResolutionIndex;
+        m_ResolutionIndex = ( m_ResolutionIndex + 1 ) % _countof(STAR_DOWNSAMPLE_FACTORS);
+        if ( !BuildFrameGraph() )
+        {
+            m_ResolutionIndex = prev;
+            BuildFrameGraph();
+        }
+    }
+
+    if ( param.KeyCode == 'T' )
+    {
+        m_EnableThreshold = !m_EnableThreshold;
+        BuildFrameGraph();
+    }
+
+    if ( param.KeyCode == 'H' )
+    {
+        // 生成できないフォーマットの場合は元に戻す.
+        auto prev = m_WorkFormatIndex;
+        m_WorkFormatIndex = ( m_WorkFormatIndex + 1 ) % _countof(WORK_BUFFER_FORMATS);
+        if ( !BuildFrameGraph() )
+        {
+            m_WorkFormatIndex = prev;
+            BuildFrameGraph();
+        }
+    }
 }
 
 //---------------------------------------------------------------------------------------
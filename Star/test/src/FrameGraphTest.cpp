@@ -0,0 +1,506 @@
+﻿//---------------------------------------------------------------------------------------
+// File : FrameGraphTest.cpp
+// Desc : Post Process Frame Graph Test.
+// Copyright(c) Project Asura. All right reserved.
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------------
+#include "FrameGraph.h"
+#include <cstdio>
+#include <string>
+
+
+namespace {
+
+//---------------------------------------------------------------------------------------
+// Macros
+//---------------------------------------------------------------------------------------
+#define CHECK( expr )                                                           \
+    do {                                                                        \
+        if ( !( expr ) )                                                        \
+        {                                                                       \
+            fprintf( stderr, "Error : %s(%d) : %s\n", __FILE__, __LINE__, #expr );  \
+            g_FailCount++;                                                      \
+        }                                                                       \
+    } while( 0 )
+
+
+//---------------------------------------------------------------------------------------
+// Global Variables
+//---------------------------------------------------------------------------------------
+int g_FailCount = 0;
+
+const u32 STAR_PASS_COUNT = 3;      // SampleApp と同じ方向ごとのパス数.
+
+// バックエンドに渡すだけのダミーオブジェクト.
+int g_InputSRV;
+int g_BackBufferRTV;
+int g_DepthDSV;
+int g_FullScreenVS;
+int g_BrightPassPS;
+int g_StarPS;
+int g_CopyPS;
+int g_CompositePS;
+int g_OpaqueBS;
+int g_AdditiveBS;
+int g_RasterizerState;
+int g_DepthStencilState;
+int g_PointSampler;
+int g_LinearSampler;
+int g_BrightPassCB;
+int g_StarCB[16][STAR_PASS_COUNT];
+
+const char* COMMAND_NAMES[NUM_FRAME_GRAPH_COMMAND] = {
+    "RT", "CLR", "CLRD", "VP", "VS", "PS", "BS", "RS", "DSS", "SRV", "SMP", "CB", "DRAW"
+};
+
+//---------------------------------------------------------------------------------------
+//      コマンド列をパスごとに1行の文字列にします.
+//---------------------------------------------------------------------------------------
+std::string ToString( const std::vector<FrameGraphCommand>& commands )
+{
+    std::string result;
+    u32 pass = 0xffffffff;
+    for(size_t i=0; i<commands.size(); ++i)
+    {
+        const auto& command = commands[i];
+        if ( command.Pass != pass )
+        {
+            char buf[32];
+            sprintf( buf, "%s%u:", result.empty() ? "" : "\n", command.Pass );
+            result += buf;
+            pass = command.Pass;
+        }
+
+        result += " ";
+        result += COMMAND_NAMES[command.Type];
+
+        // スロットを持つコマンドは番号を, 外すだけの設定は '-' を付ける.
+        if ( command.Type == FRAME_GRAPH_COMMAND_SET_SHADER_RESOURCE
+          || command.Type == FRAME_GRAPH_COMMAND_SET_SAMPLER
+          || command.Type == FRAME_GRAPH_COMMAND_SET_CONSTANT_BUFFER )
+        {
+            result += char( '0' + command.Slot );
+            if ( command.pObject[0] == nullptr )
+            { result += "-"; }
+        }
+    }
+
+    return result;
+}
+
+//---------------------------------------------------------------------------------------
+//      レンダーターゲットに設定したリソースがシェーダリソースに残っていないかチェックします.
+//---------------------------------------------------------------------------------------
+bool IsHazardFree( const std::vector<FrameGraphCommand>& commands )
+{
+    void* bound[FRAME_GRAPH_MAX_INPUT_COUNT] = {};
+    void* targets[FRAME_GRAPH_MAX_OUTPUT_COUNT] = {};
+
+    for(size_t i=0; i<commands.size(); ++i)
+    {
+        const auto& command = commands[i];
+        if ( command.Type == FRAME_GRAPH_COMMAND_SET_SHADER_RESOURCE )
+        { bound[command.Slot] = command.pObject[0]; }
+        else if ( command.Type == FRAME_GRAPH_COMMAND_SET_RENDER_TARGETS )
+        {
+            for(u32 j=0; j<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++j)
+            { targets[j] = command.pObject[j]; }
+        }
+        else
+        { continue; }
+
+        // RecordingFrameGraphBackend はビューと実体が同じポインタになる.
+        for(u32 j=0; j<FRAME_GRAPH_MAX_OUTPUT_COUNT; ++j)
+        {
+            for(u32 k=0; k<FRAME_GRAPH_MAX_INPUT_COUNT; ++k)
+            {
+                if ( targets[j] != nullptr && targets[j] == bound[k] )
+                { return false; }
+            }
+        }
+    }
+
+    // 最後は全てのシェーダリソースを外しておく.
+    for(u32 k=0; k<FRAME_GRAPH_MAX_INPUT_COUNT; ++k)
+    {
+        if ( bound[k] != nullptr )
+        { return false; }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//      全パスで共通の設定を取得します.
+//---------------------------------------------------------------------------------------
+FrameGraph::PassDesc GetBasePass()
+{
+    FrameGraph::PassDesc base;
+    base.pVS                = &g_FullScreenVS;
+    base.pBlendState        = &g_OpaqueBS;
+    base.pRasterizerState   = &g_RasterizerState;
+    base.pDepthStencilState = &g_DepthStencilState;
+    return base;
+}
+
+//---------------------------------------------------------------------------------------
+//      SampleApplication::BuildFrameGraph() と同じ光芒のグラフを構築します.
+//---------------------------------------------------------------------------------------
+void BuildStarGraph( FrameGraph& graph, u32 width, u32 height, u32 factor, u32 directionCount )
+{
+    RenderTargetDesc desc;
+    desc.Width  = ( width  + factor - 1 ) / factor;
+    desc.Height = ( height + factor - 1 ) / factor;
+    desc.Format = 28;   // DXGI_FORMAT_R8G8B8A8_UNORM
+
+    graph.Reset();
+
+    auto input  = graph.ImportTexture( &g_InputSRV );
+    auto output = graph.ImportTarget( &g_BackBufferRTV, &g_DepthDSV, width, height );
+    auto accum  = graph.CreateTarget( desc );
+    auto base   = GetBasePass();
+
+    auto source = input;
+    if ( factor != 1 )
+    {
+        source = graph.CreateTarget( desc );
+
+        auto pass = base;
+        pass.Name               = "BrightPass";
+        pass.Input[0]           = input;
+        pass.Output[0]          = source;
+        pass.pPS                = &g_BrightPassPS;
+        pass.pSampler[0]        = &g_LinearSampler;
+        pass.pConstantBuffer[0] = &g_BrightPassCB;
+        graph.AddPass( pass );
+    }
+
+    for(u32 j=0; j<directionCount; ++j)
+    {
+        auto prev = source;
+        for(u32 i=0; i<STAR_PASS_COUNT; ++i)
+        {
+            auto work = graph.CreateTarget( desc );
+
+            auto pass = base;
+            pass.Name               = "Star";
+            pass.Input[0]           = prev;
+            pass.Output[0]          = work;
+            pass.ClearOutput        = true;
+            pass.pPS                = &g_StarPS;
+            pass.pSampler[0]        = &g_PointSampler;
+            pass.pConstantBuffer[0] = &g_StarCB[j][i];
+            graph.AddPass( pass );
+
+            prev = work;
+        }
+
+        auto pass = base;
+        pass.Name           = "Accumulate";
+        pass.Input[0]       = prev;
+        pass.Output[0]      = accum;
+        pass.ClearOutput    = ( j == 0 );
+        pass.ClearColor[3]  = 1.0f;
+        pass.pPS            = &g_CopyPS;
+        pass.pBlendState    = &g_AdditiveBS;
+        pass.pSampler[0]    = &g_PointSampler;
+        graph.AddPass( pass );
+    }
+
+    auto pass = base;
+    pass.Name           = "Composite";
+    pass.Input[0]       = input;
+    pass.Input[1]       = accum;
+    pass.Output[0]      = output;
+    pass.ClearDepth     = true;
+    pass.pPS            = &g_CompositePS;
+    pass.pSampler[0]    = &g_LinearSampler;
+    graph.AddPass( pass );
+}
+
+//---------------------------------------------------------------------------------------
+//      結果に寄与しないパスと出力の削除をテストします.
+//---------------------------------------------------------------------------------------
+void TestCulling()
+{
+    NullRenderTargetAllocator allocator( 4 );
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    RecordingFrameGraphBackend backend;
+    FrameGraph graph;
+
+    RenderTargetDesc desc = { 640, 360, 28 };
+    auto input  = graph.ImportTexture( &g_InputSRV );
+    auto output = graph.ImportTarget( &g_BackBufferRTV, nullptr, 640, 360 );
+    auto work   = graph.CreateTarget( desc );
+    auto dead0  = graph.CreateTarget( desc );
+    auto dead1  = graph.CreateTarget( desc );
+    auto unused = graph.CreateTarget( desc );
+    auto kept   = graph.CreateTarget( desc );
+    auto base   = GetBasePass();
+    base.pPS = &g_CopyPS;
+
+    // 0 : 後で読まれる.
+    auto pass = base;
+    pass.Input[0]  = input;
+    pass.Output[0] = work;
+    graph.AddPass( pass );
+
+    // 1, 2 : 削除するパスだけが読む出力の連鎖.
+    pass = base;
+    pass.Input[0]  = input;
+    pass.Output[0] = dead0;
+    graph.AddPass( pass );
+
+    pass = base;
+    pass.Input[0]  = dead0;
+    pass.Output[0] = dead1;
+    graph.AddPass( pass );
+
+    // 3 : MRT の2番目の出力は読まれない.
+    pass = base;
+    pass.Input[0]  = work;
+    pass.Output[0] = output;
+    pass.Output[1] = unused;
+    graph.AddPass( pass );
+
+    // 4 : 読まれないが結果として残す.
+    pass = base;
+    pass.Input[0]  = input;
+    pass.Output[0] = kept;
+    graph.AddPass( pass );
+    graph.MarkOutput( kept );
+
+    CHECK( graph.Compile( pool, &backend ) );
+    CHECK( graph.GetPassCount() == 5 );
+    CHECK( !graph.IsCulled( 0 ) );
+    CHECK( graph.IsCulled( 1 ) );
+    CHECK( graph.IsCulled( 2 ) );
+    CHECK( !graph.IsCulled( 3 ) );
+    CHECK( !graph.IsCulled( 4 ) );
+    CHECK( graph.GetCulledPassCount() == 2 );
+    CHECK( graph.GetCulledOutputCount() == 1 );
+
+    // 削除したものはプールに宣言しない.
+    CHECK( graph.GetPoolHandle( dead0 )  == RenderTargetPool::INVALID_HANDLE );
+    CHECK( graph.GetPoolHandle( dead1 )  == RenderTargetPool::INVALID_HANDLE );
+    CHECK( graph.GetPoolHandle( unused ) == RenderTargetPool::INVALID_HANDLE );
+    CHECK( graph.GetPoolHandle( work )   != RenderTargetPool::INVALID_HANDLE );
+    CHECK( graph.GetPoolHandle( kept )   != RenderTargetPool::INVALID_HANDLE );
+    CHECK( pool.GetVirtualCount() == 2 );
+
+    // MRT は削除した出力のスロットに何も設定しない.
+    graph.Execute( &backend );
+    const auto& commands = backend.GetCommands();
+    CHECK( backend.GetCount( FRAME_GRAPH_COMMAND_DRAW ) == 3 );
+    for(size_t i=0; i<commands.size(); ++i)
+    {
+        if ( commands[i].Type != FRAME_GRAPH_COMMAND_SET_RENDER_TARGETS || commands[i].Pass != 3 )
+        { continue; }
+
+        CHECK( commands[i].Slot == 2 );
+        CHECK( commands[i].pObject[0] == &g_BackBufferRTV );
+        CHECK( commands[i].pObject[1] == nullptr );
+    }
+
+    // 不正なリソースの参照.
+    pass = base;
+    pass.Input[0]  = output;
+    pass.Output[0] = work;
+    graph.AddPass( pass );
+    CHECK( !graph.Compile( pool, &backend ) );
+
+    pool.Term();
+}
+
+//---------------------------------------------------------------------------------------
+//      直前と同じステート設定の省略をテストします.
+//---------------------------------------------------------------------------------------
+void TestRedundantState()
+{
+    NullRenderTargetAllocator allocator( 4 );
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    RecordingFrameGraphBackend backend;
+    FrameGraph graph;
+
+    RenderTargetDesc desc = { 640, 360, 28 };
+    auto input  = graph.ImportTexture( &g_InputSRV );
+    auto output = graph.ImportTarget( &g_BackBufferRTV, nullptr, 640, 360 );
+    auto accum  = graph.CreateTarget( desc );
+    auto base   = GetBasePass();
+
+    // 同じ入力を同じ設定で3回加算する.
+    for(u32 i=0; i<3; ++i)
+    {
+        auto pass = base;
+        pass.Input[0]           = input;
+        pass.Output[0]          = accum;
+        pass.ClearOutput        = ( i == 0 );
+        pass.pPS                = &g_CopyPS;
+        pass.pBlendState        = &g_AdditiveBS;
+        pass.pSampler[0]        = &g_PointSampler;
+        pass.pConstantBuffer[0] = &g_StarCB[0][0];
+        graph.AddPass( pass );
+    }
+
+    // ステンシル参照値だけが異なる.
+    auto pass = base;
+    pass.Input[0]           = accum;
+    pass.Output[0]          = output;
+    pass.pPS                = &g_CopyPS;
+    pass.pBlendState        = &g_AdditiveBS;
+    pass.pSampler[0]        = &g_PointSampler;
+    pass.pConstantBuffer[0] = &g_StarCB[0][0];
+    pass.StencilRef         = 1;
+    graph.AddPass( pass );
+
+    CHECK( graph.Compile( pool, &backend ) );
+    graph.Execute( &backend );
+
+    // 2, 3番目のパスは描画だけになる.
+    CHECK( ToString( backend.GetCommands() ) ==
+        "0: RT CLR VP VS PS BS RS DSS SRV0 SMP0 CB0 DRAW\n"
+        "1: DRAW\n"
+        "2: DRAW\n"
+        "3: RT DSS SRV0 DRAW SRV0-" );
+
+    // RT, VP, VS, PS, BS, RS, DSS, SRV, SMP, CB を2回ずつ, VP, VS, PS, BS, RS, SMP, CB を1回.
+    CHECK( graph.GetSkippedStateCount() == 10 * 2 + 7 );
+    CHECK( backend.GetCount( FRAME_GRAPH_COMMAND_SET_DEPTH_STENCIL_STATE ) == 2 );
+    CHECK( backend.GetCommands().size() == graph.GetCommands().size() );
+
+    pool.Term();
+}
+
+//---------------------------------------------------------------------------------------
+//      書き込む前にシェーダリソースの設定を外すかテストします.
+//---------------------------------------------------------------------------------------
+void TestUnbindBeforeWrite()
+{
+    NullRenderTargetAllocator allocator( 4 );
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    RecordingFrameGraphBackend backend;
+    FrameGraph graph;
+
+    RenderTargetDesc desc = { 640, 360, 28 };
+    auto input  = graph.ImportTexture( &g_InputSRV );
+    auto output = graph.ImportTarget( &g_BackBufferRTV, nullptr, 640, 360 );
+    auto base   = GetBasePass();
+    base.pPS = &g_StarPS;
+
+    // 寿命が重ならない作業バッファはプールが同じ実体を割り当てるので，
+    // 前のパスで読んだ実体に書き込むことになる.
+    auto prev = input;
+    for(u32 i=0; i<4; ++i)
+    {
+        auto work = graph.CreateTarget( desc );
+
+        auto pass = base;
+        pass.Input[0]  = prev;
+        pass.Output[0] = work;
+        graph.AddPass( pass );
+
+        prev = work;
+    }
+
+    auto pass = base;
+    pass.Input[0]  = prev;
+    pass.Output[0] = output;
+    graph.AddPass( pass );
+
+    CHECK( graph.Compile( pool, &backend ) );
+    CHECK( pool.GetPhysicalCount() == 2 );
+    graph.Execute( &backend );
+
+    CHECK( IsHazardFree( backend.GetCommands() ) );
+    CHECK( ToString( backend.GetCommands() ) ==
+        "0: RT VP VS PS BS RS DSS SRV0 DRAW\n"
+        "1: RT SRV0 DRAW\n"
+        "2: SRV0- RT SRV0 DRAW\n"
+        "3: SRV0- RT SRV0 DRAW\n"
+        "4: RT SRV0 DRAW SRV0-" );
+
+    pool.Term();
+}
+
+//---------------------------------------------------------------------------------------
+//      光芒のグラフのコマンド列をテストします.
+//---------------------------------------------------------------------------------------
+void TestStarGraph()
+{
+    NullRenderTargetAllocator allocator( 4 );
+    RenderTargetPool pool;
+    CHECK( pool.Init( &allocator ) );
+
+    RecordingFrameGraphBackend backend;
+    FrameGraph graph;
+
+    BuildStarGraph( graph, 1280, 720, 2, 2 );
+    CHECK( graph.Compile( pool, &backend ) );
+    CHECK( graph.GetPassCount() == 10 );
+    CHECK( graph.GetCulledPassCount() == 0 );
+    CHECK( graph.GetCulledOutputCount() == 0 );
+
+    // 縮小画像とピンポンする作業バッファ2枚. 合成先は最初の加算で使い終わった作業バッファの実体を共有する.
+    CHECK( pool.GetVirtualCount() == 8 );
+    CHECK( pool.GetPhysicalCount() == 3 );
+
+    graph.Execute( &backend );
+    const auto& commands = backend.GetCommands();
+    CHECK( IsHazardFree( commands ) );
+    CHECK( backend.GetCount( FRAME_GRAPH_COMMAND_DRAW ) == 10 );
+
+    // 0 : BrightPass, 1-3 : Star, 4 : Accumulate, 5-7 : Star, 8 : Accumulate, 9 : Composite.
+    auto actual = ToString( commands );
+    CHECK( actual ==
+        "0: RT VP VS PS BS RS DSS SRV0 SMP0 CB0 DRAW\n"
+        "1: RT CLR PS SRV0 SMP0 CB0 DRAW\n"
+        "2: RT CLR SRV0 CB0 DRAW\n"
+        "3: SRV0- RT CLR SRV0 CB0 DRAW\n"
+        "4: SRV0- RT CLR PS BS SRV0 DRAW\n"
+        "5: SRV0- RT CLR PS BS SRV0 CB0 DRAW\n"
+        "6: SRV0- RT CLR SRV0 CB0 DRAW\n"
+        "7: SRV0- RT CLR SRV0 CB0 DRAW\n"
+        "8: RT PS BS SRV0 DRAW\n"
+        "9: RT CLRD VP PS BS SRV0 SRV1 SMP0 DRAW SRV0- SRV1-" );
+
+    // 同じグラフを構築し直しても実体は作り直さない.
+    auto createCount = allocator.GetCreateCount();
+    BuildStarGraph( graph, 1280, 720, 2, 2 );
+    CHECK( graph.Compile( pool, &backend ) );
+    CHECK( allocator.GetCreateCount() == createCount );
+    CHECK( ToString( graph.GetCommands() ) == actual );
+
+    pool.Term();
+}
+
+} // namespace
+
+
+//---------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//---------------------------------------------------------------------------------------
+int main()
+{
+    TestCulling();
+    TestRedundantState();
+    TestUnbindBeforeWrite();
+    TestStarGraph();
+
+    if ( g_FailCount != 0 )
+    {
+        fprintf( stderr, "FrameGraphTest : %d check(s) failed.\n", g_FailCount );
+        return -1;
+    }
+
+    printf( "FrameGraphTest : OK\n" );
+    return 0;
+}